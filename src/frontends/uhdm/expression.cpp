@@ -78,6 +78,183 @@ std::string UhdmImporter::generate_cell_name(const UHDM::any* uhdm_obj, const st
     return cell_name;
 }
 
+// Combine `terms` (each sized to `width`) with an associative, commutative
+// operator as a balanced tree: depth log2(N) instead of the N-deep chain an
+// unrolled accumulator gives.  A 1-bit bitwise reduction is a single
+// $reduce_* cell over the concatenated terms.
+RTLIL::SigSpec UhdmImporter::build_reduction_tree(int op_type, std::vector<RTLIL::SigSpec> terms, int width) {
+    for (auto& t : terms) {
+        if (t.size() < width) t.extend_u0(width);
+        else if (t.size() > width) t = t.extract(0, width);
+    }
+    if (width == 1 && op_type != vpiAddOp && GetSize(terms) > 2) {
+        RTLIL::SigSpec all;
+        for (auto& t : terms) all.append(t);
+        switch (op_type) {
+        case vpiBitXorOp: return module->ReduceXor(NEW_ID, all);
+        case vpiBitOrOp:  return module->ReduceOr(NEW_ID, all);
+        case vpiBitAndOp: return module->ReduceAnd(NEW_ID, all);
+        }
+    }
+    while (GetSize(terms) > 1) {
+        std::vector<RTLIL::SigSpec> next;
+        for (int k = 0; k + 1 < GetSize(terms); k += 2) {
+            const RTLIL::SigSpec& a = terms[k];
+            const RTLIL::SigSpec& b = terms[k + 1];
+            switch (op_type) {
+            case vpiAddOp:    next.push_back(module->Add(NEW_ID, a, b)); break;
+            case vpiBitXorOp: next.push_back(module->Xor(NEW_ID, a, b)); break;
+            case vpiBitOrOp:  next.push_back(module->Or (NEW_ID, a, b)); break;
+            case vpiBitAndOp: next.push_back(module->And(NEW_ID, a, b)); break;
+            }
+        }
+        if (GetSize(terms) % 2)
+            next.push_back(terms.back());
+        terms.swap(next);
+    }
+    return terms.empty() ? RTLIL::SigSpec(RTLIL::State::S0, width) : terms[0];
+}
+
+// Unroll a function-body for loop whose body is a single associative
+// accumulation -- `acc op= term` or `acc = acc op term` with op one of
+// + ^ | & and a term that does not read acc -- as one term per iteration
+// reduced by build_reduction_tree.  The result is truncated to acc's width
+// exactly like the per-iteration chain, so the two agree bit for bit.
+// Returns false, with nothing emitted and loop_values unchanged, when the body
+// is not such a loop or one of its terms does not import.
+bool UhdmImporter::import_reduction_loop(const any* loop_body, const std::string& loop_var,
+                                         int64_t start_value, int64_t loop_end, int64_t increment,
+                                         RTLIL::CaseRule* case_rule, RTLIL::Wire* result_wire,
+                                         std::map<std::string, RTLIL::SigSpec>& input_mapping,
+                                         const std::string& func_name) {
+    if (increment <= 0 || start_value > loop_end)
+        return false;
+    const any* stmt = loop_body;
+    if (stmt && stmt->UhdmType() == uhdmbegin) {
+        const begin* bg = any_cast<const begin*>(stmt);
+        if (!bg->Stmts() || bg->Stmts()->size() != 1)
+            return false;
+        stmt = bg->Stmts()->at(0);
+    }
+    if (!stmt || stmt->UhdmType() != uhdmassignment)
+        return false;
+    const assignment* assign = any_cast<const assignment*>(stmt);
+    if (!assign->Lhs() || assign->Lhs()->UhdmType() != uhdmref_obj || !assign->Rhs())
+        return false;
+    std::string acc_name = std::string(assign->Lhs()->VpiName());
+
+    auto is_reduction_op = [](int t) {
+        return t == vpiAddOp || t == vpiBitXorOp || t == vpiBitOrOp || t == vpiBitAndOp;
+    };
+    int op_type = assign->VpiOpType();
+    const any* term = nullptr;
+    bool plain = false;
+    if (is_reduction_op(op_type)) {
+        term = assign->Rhs();
+    } else if (assign->Rhs()->UhdmType() == uhdmoperation) {
+        const operation* rop = any_cast<const operation*>(assign->Rhs());
+        if (!is_reduction_op(rop->VpiOpType()) || !rop->Operands() || rop->Operands()->size() != 2 ||
+            operands_all_signed(rop))
+            return false;
+        const any* o0 = rop->Operands()->at(0);
+        const any* o1 = rop->Operands()->at(1);
+        auto is_acc = [&](const any* o) {
+            return o->UhdmType() == uhdmref_obj && std::string(o->VpiName()) == acc_name;
+        };
+        if (is_acc(o0)) term = o1;
+        else if (is_acc(o1)) term = o0;
+        else return false;
+        op_type = rop->VpiOpType();
+        plain = true;
+        // Inside `acc op term` the term is sized by the operation's context;
+        // only take terms whose import does not depend on it.
+        int tt = term->UhdmType();
+        if (tt != uhdmref_obj && tt != uhdmbit_select && tt != uhdmpart_select &&
+            tt != uhdmindexed_part_select && tt != uhdmvar_select)
+            return false;
+    } else {
+        return false;
+    }
+
+    // The term must not read the accumulator; anything not understood is
+    // assumed to.
+    std::function<bool(const any*)> may_read_acc = [&](const any* e) -> bool {
+        if (!e) return false;
+        switch (e->UhdmType()) {
+        case uhdmconstant:
+            return false;
+        case uhdmref_obj:
+        case uhdmbit_select:
+        case uhdmpart_select:
+        case uhdmindexed_part_select:
+        case uhdmvar_select:
+            return std::string(e->VpiName()) == acc_name;
+        case uhdmoperation: {
+            const operation* op = any_cast<const operation*>(e);
+            if (op->Operands())
+                for (auto o : *op->Operands())
+                    if (may_read_acc(o)) return true;
+            return false;
+        }
+        default:
+            return true;
+        }
+    };
+    if (may_read_acc(term))
+        return false;
+
+    RTLIL::SigSpec lhs_sig;
+    auto it = input_mapping.find(acc_name);
+    if (it != input_mapping.end())
+        lhs_sig = it->second;
+    else if (!plain && acc_name == func_name && result_wire)
+        lhs_sig = RTLIL::SigSpec(result_wire);
+    if (lhs_sig.empty())
+        return false;
+
+    // Seed with the accumulator's value before the loop: the latest action
+    // targeting it, as the per-iteration chain does.
+    RTLIL::SigSpec init = plain ? RTLIL::SigSpec(RTLIL::State::S0, lhs_sig.size()) : lhs_sig;
+    for (const auto& act : case_rule->actions)
+        if (act.first == lhs_sig) init = act.second;
+
+    // A term that fails to import sends the loop to the per-iteration path.
+    // Undo what the earlier terms did first -- their cells and the loop
+    // variable binding -- so that path starts from the state it expects
+    // (their scratch wires are left to the import sweep).
+    bool had_loop_var = loop_values.count(loop_var);
+    int saved_loop_var = had_loop_var ? loop_values.at(loop_var) : 0;
+    int cells0 = GetSize(module->cells_);
+    std::vector<RTLIL::SigSpec> terms{init};
+    for (int64_t i = start_value; i <= loop_end; i += increment) {
+        loop_values[loop_var] = i;
+        RTLIL::SigSpec t = import_expression(any_cast<const expr*>(term), &input_mapping);
+        if (t.empty()) {
+            // hashlib dicts iterate newest-first
+            std::vector<RTLIL::Cell*> emitted;
+            int n = GetSize(module->cells_) - cells0;
+            for (auto& c : module->cells_) {
+                if (n-- <= 0) break;
+                emitted.push_back(c.second);
+            }
+            for (auto c : emitted)
+                module->remove(c);
+            // A decoder built for a term may have been among them.
+            dyn_index_decoders.clear();
+            if (had_loop_var)
+                loop_values[loop_var] = saved_loop_var;
+            else
+                loop_values.erase(loop_var);
+            return false;
+        }
+        terms.push_back(t);
+    }
+    case_rule->actions.push_back(RTLIL::SigSig(lhs_sig, build_reduction_tree(op_type, terms, lhs_sig.size())));
+    log_uhdm_trace("UHDM: Accumulator '%s' reduced as a balanced tree over %d terms in function %s\n",
+        acc_name.c_str(), GetSize(terms), func_name.c_str());
+    return true;
+}
+
 // Helper function to process a statement into a case rule for function process generation
 void UhdmImporter::process_stmt_to_case(const any* stmt, RTLIL::CaseRule* case_rule,
                                         RTLIL::Wire* result_wire,
@@ -89,7 +266,7 @@ void UhdmImporter::process_stmt_to_case(const any* stmt, RTLIL::CaseRule* case_r
     if (!stmt || !case_rule) return;
     
     if (mode_debug) {
-        log("  process_stmt_to_case: func=%s, stmt type=%d\n", func_name.c_str(), stmt->UhdmType());
+        log_uhdm_trace("  process_stmt_to_case: func=%s, stmt type=%d\n", func_name.c_str(), stmt->UhdmType());
     }
     
     int type = stmt->UhdmType();
@@ -122,7 +299,7 @@ void UhdmImporter::process_stmt_to_case(const any* stmt, RTLIL::CaseRule* case_r
                     input_mapping[var_name] = RTLIL::SigSpec(local_wire);
 
                     if (mode_debug) {
-                        log("    Created block-local variable %s (width=%d)\n", var_name.c_str(), width);
+                        log_uhdm_trace("    Created block-local variable %s (width=%d)\n", var_name.c_str(), width);
                     }
                 }
             }
@@ -176,7 +353,7 @@ void UhdmImporter::process_stmt_to_case(const any* stmt, RTLIL::CaseRule* case_r
                     input_mapping[var_name] = RTLIL::SigSpec(local_wire);
 
                     if (mode_debug) {
-                        log("    Created block-local variable %s in named block %s (width=%d)\n",
+                        log_uhdm_trace("    Created block-local variable %s in named block %s (width=%d)\n",
                             var_name.c_str(), block_name.c_str(), width);
                     }
                 }
@@ -576,11 +753,11 @@ void UhdmImporter::process_stmt_to_case(const any* stmt, RTLIL::CaseRule* case_r
         const assignment* assign = any_cast<const assignment*>(stmt);
         if (assign && assign->Lhs() && assign->Rhs()) {
             if (mode_debug) {
-                log("  process_stmt_to_case: Processing assignment\n");
+                log_uhdm_trace("  process_stmt_to_case: Processing assignment\n");
                 if (assign->Lhs()->UhdmType() == uhdmref_obj) {
                     const ref_obj* lhs_ref = any_cast<const ref_obj*>(assign->Lhs());
                     if (lhs_ref) {
-                        log("    LHS is ref_obj: %s\n", std::string(lhs_ref->VpiName()).c_str());
+                        log_uhdm_trace("    LHS is ref_obj: %s\n", std::string(lhs_ref->VpiName()).c_str());
                     }
                 }
             }
@@ -650,7 +827,7 @@ void UhdmImporter::process_stmt_to_case(const any* stmt, RTLIL::CaseRule* case_r
                             // but we skip the assignment itself
                             skip_assignment = true;
                             if (mode_debug) {
-                                log("UHDM: Skipping accumulative assignment to return variable '%s' in loop iteration\n",
+                                log_uhdm_trace("UHDM: Skipping accumulative assignment to return variable '%s' in loop iteration\n",
                                     lhs_name.c_str());
                             }
                         }
@@ -683,14 +860,14 @@ void UhdmImporter::process_stmt_to_case(const any* stmt, RTLIL::CaseRule* case_r
                     if (it != input_mapping.end()) {
                         lhs_sig = it->second;
                         if (mode_debug) {
-                            log("UHDM: Assignment to mapped variable %s\n", lhs_name.c_str());
+                            log_uhdm_trace("UHDM: Assignment to mapped variable %s\n", lhs_name.c_str());
                         }
                     } else if (lhs_name == func_name) {
                         // Direct assignment to function name - use result wire
                         // (only if not shadowed by a block-local variable in input_mapping)
                         lhs_sig = result_wire;
                         if (mode_debug) {
-                            log("UHDM: Direct assignment to function %s, using result wire\n", func_name.c_str());
+                            log_uhdm_trace("UHDM: Direct assignment to function %s, using result wire\n", func_name.c_str());
                         }
                     } else {
                         // Create a function-scoped temporary wire for local variable
@@ -703,7 +880,7 @@ void UhdmImporter::process_stmt_to_case(const any* stmt, RTLIL::CaseRule* case_r
                             if (width_it != local_var_widths.end()) {
                                 wire_width = width_it->second;
                                 if (mode_debug) {
-                                    log("UHDM: Using declared width %d for local variable %s\n",
+                                    log_uhdm_trace("UHDM: Using declared width %d for local variable %s\n",
                                         wire_width, lhs_name.c_str());
                                 }
                             } else {
@@ -752,7 +929,7 @@ void UhdmImporter::process_stmt_to_case(const any* stmt, RTLIL::CaseRule* case_r
                     if (base_spec.size() > 0 && offset + width <= base_spec.size()) {
                         lhs_sig = base_spec.extract(offset, width);
                         if (mode_debug)
-                            log("  process_stmt_to_case: part-select LHS %s[%d:%d] → offset=%d width=%d\n",
+                            log_uhdm_trace("  process_stmt_to_case: part-select LHS %s[%d:%d] → offset=%d width=%d\n",
                                 base_name.c_str(), left_val, right_val, offset, width);
                     } else {
                         log_warning("Part-select LHS %s[%d:%d] out of bounds (base_size=%d)\n",
@@ -803,7 +980,7 @@ void UhdmImporter::process_stmt_to_case(const any* stmt, RTLIL::CaseRule* case_r
                     if (bs->VpiIndex()) {
                         index_sig = import_expression(any_cast<const expr*>(bs->VpiIndex()), &input_mapping);
                         if (mode_debug) {
-                            log("      Bit select index for %s: is_const=%d, value=%s\n",
+                            log_uhdm_trace("      Bit select index for %s: is_const=%d, value=%s\n",
                                 base_name.c_str(), index_sig.is_fully_const(),
                                 index_sig.is_fully_const() ? std::to_string(index_sig.as_int()).c_str() : "non-const");
                         }
@@ -819,7 +996,7 @@ void UhdmImporter::process_stmt_to_case(const any* stmt, RTLIL::CaseRule* case_r
                             lhs_sig = RTLIL::SigSpec(target_wire, offset, element_width);
                         }
                     } else {
-                        log("UHDM: Warning - non-constant bit select index in function %s\n", func_name.c_str());
+                        log_uhdm_trace("UHDM: Warning - non-constant bit select index in function %s\n", func_name.c_str());
                     }
                 } else {
                     // Handle bit select on other variables
@@ -914,7 +1091,7 @@ void UhdmImporter::process_stmt_to_case(const any* stmt, RTLIL::CaseRule* case_r
                             field_off + field_w <= base_sig.size()) {
                             lhs_sig = base_sig.extract(field_off, field_w);
                             if (mode_debug)
-                                log("UHDM: struct-field return %s.%s -> [%d+:%d]\n",
+                                log_uhdm_trace("UHDM: struct-field return %s.%s -> [%d+:%d]\n",
                                     base_name.c_str(), field_name.c_str(),
                                     field_off, field_w);
                         }
@@ -979,7 +1156,7 @@ void UhdmImporter::process_stmt_to_case(const any* stmt, RTLIL::CaseRule* case_r
     case uhdmfor_stmt: {
         // Handle for loops - need to unroll at compile time for synthesis
         const for_stmt* fs = any_cast<const for_stmt*>(stmt);
-        log("UHDM: Processing for loop in function %s\n", func_name.c_str());
+        log_uhdm_trace("UHDM: Processing for loop in function %s\n", func_name.c_str());
         if (fs) {
                 // Get loop components
                 const any* init_stmt = nullptr;
@@ -1002,7 +1179,7 @@ void UhdmImporter::process_stmt_to_case(const any* stmt, RTLIL::CaseRule* case_r
                 }
                 
                 if (!init_stmt || !condition || !inc_stmt || !loop_body) {
-                    log("UHDM: Warning - incomplete for loop structure in function %s (init:%p, cond:%p, inc:%p, body:%p)\n",
+                    log_uhdm_trace("UHDM: Warning - incomplete for loop structure in function %s (init:%p, cond:%p, inc:%p, body:%p)\n",
                         func_name.c_str(), init_stmt, condition, inc_stmt, loop_body);
                     break;
                 }
@@ -1016,10 +1193,10 @@ void UhdmImporter::process_stmt_to_case(const any* stmt, RTLIL::CaseRule* case_r
                 bool inclusive = false;
                 
                 if (mode_debug) {
-                    log("    Attempting to unroll for loop in function %s\n", func_name.c_str());
-                    log("      init_stmt type: %d\n", init_stmt ? init_stmt->UhdmType() : -1);
-                    log("      condition type: %d\n", condition ? condition->UhdmType() : -1);
-                    log("      inc_stmt type: %d\n", inc_stmt ? inc_stmt->UhdmType() : -1);
+                    log_uhdm_trace("    Attempting to unroll for loop in function %s\n", func_name.c_str());
+                    log_uhdm_trace("      init_stmt type: %d\n", init_stmt ? init_stmt->UhdmType() : -1);
+                    log_uhdm_trace("      condition type: %d\n", condition ? condition->UhdmType() : -1);
+                    log_uhdm_trace("      inc_stmt type: %d\n", inc_stmt ? inc_stmt->UhdmType() : -1);
                 }
                 
                 // Extract initialization: i = start_value
@@ -1095,21 +1272,21 @@ void UhdmImporter::process_stmt_to_case(const any* stmt, RTLIL::CaseRule* case_r
                             } else if (right_op->UhdmType() == uhdmoperation) {
                                 // Handle operations like WIDTH/2 using expression evaluator
                                 const operation* op = any_cast<const operation*>(right_op);
-                                log("UHDM: Evaluating operation for loop end value in function %s\n", func_name.c_str());
+                                log_uhdm_trace("UHDM: Evaluating operation for loop end value in function %s\n", func_name.c_str());
                                 
                                 // Use ExprEval to reduce the expression to a constant
                                 ExprEval eval;
                                 bool invalidValue = false;
                                 if (mode_debug) {
-                                    log("DEBUG: Attempting to reduce operation type %d\n", op->VpiOpType());
+                                    log_uhdm_trace("DEBUG: Attempting to reduce operation type %d\n", op->VpiOpType());
                                 }
                                 // Pass the current instance context for proper parameter resolution
                                 expr* res = eval.reduceExpr(op, invalidValue, current_instance, op->VpiParent(), true);
                                 
                                 if (mode_debug) {
-                                    log("DEBUG: reduceExpr result: res=%p, invalidValue=%d\n", res, invalidValue);
+                                    log_uhdm_trace("DEBUG: reduceExpr result: res=%p, invalidValue=%d\n", res, invalidValue);
                                     if (res) {
-                                        log("DEBUG: Result type: %d\n", res->UhdmType());
+                                        log_uhdm_trace("DEBUG: Result type: %d\n", res->UhdmType());
                                     }
                                 }
                                 
@@ -1118,19 +1295,19 @@ void UhdmImporter::process_stmt_to_case(const any* stmt, RTLIL::CaseRule* case_r
                                     RTLIL::SigSpec const_spec = import_constant(const_val);
                                     if (const_spec.is_fully_const()) {
                                         end_value = const_spec.as_const().as_int();
-                                        log("UHDM: Operation evaluated to constant: %lld\n", (long long)end_value);
+                                        log_uhdm_trace("UHDM: Operation evaluated to constant: %lld\n", (long long)end_value);
                                         if (mode_debug) {
-                                            log("DEBUG: Evaluated operation for end value: %lld\n", (long long)end_value);
+                                            log_uhdm_trace("DEBUG: Evaluated operation for end value: %lld\n", (long long)end_value);
                                         }
                                     } else {
                                         can_unroll = false;
-                                        log("UHDM: Operation could not be reduced to constant\n");
+                                        log_uhdm_trace("UHDM: Operation could not be reduced to constant\n");
                                     }
                                 } else {
                                     can_unroll = false;
-                                    log("UHDM: Operation result not constant, cannot unroll\n");
+                                    log_uhdm_trace("UHDM: Operation result not constant, cannot unroll\n");
                                     if (mode_debug) {
-                                        log("DEBUG: Operation result not constant (invalidValue=%d)\n", invalidValue);
+                                        log_uhdm_trace("DEBUG: Operation result not constant (invalidValue=%d)\n", invalidValue);
                                     }
                                 }
                             } else {
@@ -1161,19 +1338,28 @@ void UhdmImporter::process_stmt_to_case(const any* stmt, RTLIL::CaseRule* case_r
                 }
                 
                 if (mode_debug) {
-                    log("DEBUG: Loop unroll check: can_unroll=%d, start=%lld, end=%lld, increment=%lld\n",
+                    log_uhdm_trace("DEBUG: Loop unroll check: can_unroll=%d, start=%lld, end=%lld, increment=%lld\n",
                         can_unroll, (long long)start_value, (long long)end_value, (long long)increment);
                 }
                 
                 if (can_unroll) {
                     // Unroll the loop
                     int64_t loop_end = inclusive ? end_value : end_value - 1;
+
+                    // An associative accumulation reduces as a balanced tree
+                    // rather than the chain threaded through the iterations
+                    // below.
+                    if (import_reduction_loop(loop_body, loop_var_name, start_value, loop_end, increment,
+                                              case_rule, result_wire, input_mapping, func_name)) {
+                        loop_values.erase(loop_var_name);
+                        break;
+                    }
                     
-                    log("UHDM: Unrolling for loop: %s from %lld to %lld in function %s\n", 
+                    log_uhdm_trace("UHDM: Unrolling for loop: %s from %lld to %lld in function %s\n", 
                         loop_var_name.c_str(), (long long)start_value, (long long)loop_end, func_name.c_str());
                     
                     if (mode_debug) {
-                        log("    Unrolling for loop: %s from %lld to %lld\n", 
+                        log_uhdm_trace("    Unrolling for loop: %s from %lld to %lld\n", 
                             loop_var_name.c_str(), (long long)start_value, (long long)loop_end);
                     }
                     
@@ -1227,7 +1413,7 @@ void UhdmImporter::process_stmt_to_case(const any* stmt, RTLIL::CaseRule* case_r
                                     };
                                     if (reads_var(assign->Rhs())) {
                                         is_accumulative = true;
-                                        log("UHDM: Detected accumulative loop for variable '%s'\n", accumulator_var.c_str());
+                                        log_uhdm_trace("UHDM: Detected accumulative loop for variable '%s'\n", accumulator_var.c_str());
                                     }
                                 }
                             }
@@ -1276,7 +1462,7 @@ void UhdmImporter::process_stmt_to_case(const any* stmt, RTLIL::CaseRule* case_r
                         bool is_last_iteration = (i + increment > loop_end);
                         
                         if (mode_debug) {
-                            log("      Iteration %lld (last=%d)\n", (long long)i, is_last_iteration);
+                            log_uhdm_trace("      Iteration %lld (last=%d)\n", (long long)i, is_last_iteration);
                         }
                         
                         // For accumulative loops, update the accumulator mapping for this iteration
@@ -1291,7 +1477,7 @@ void UhdmImporter::process_stmt_to_case(const any* stmt, RTLIL::CaseRule* case_r
                         
                         // Process the loop body with the current iteration value
                         if (mode_debug) {
-                            log("      Processing loop body for iteration %lld\n", (long long)i);
+                            log_uhdm_trace("      Processing loop body for iteration %lld\n", (long long)i);
                         }
                         
                         // Save the current state of input_mapping for the accumulator
@@ -1325,7 +1511,7 @@ void UhdmImporter::process_stmt_to_case(const any* stmt, RTLIL::CaseRule* case_r
                                     RTLIL::SigSpec iter_result = import_expression(any_cast<const expr*>(assign->Rhs()), &input_mapping);
                                     if (!iter_result.empty()) {
                                         current_accumulator = iter_result;
-                                        log("UHDM: Updated accumulator to iteration %lld result\n", (long long)i);
+                                        log_uhdm_trace("UHDM: Updated accumulator to iteration %lld result\n", (long long)i);
                                     }
                                 }
                             }
@@ -1345,7 +1531,7 @@ void UhdmImporter::process_stmt_to_case(const any* stmt, RTLIL::CaseRule* case_r
                         auto it = input_mapping.find(accumulator_var);
                         if (it != input_mapping.end()) {
                             case_rule->actions.push_back(RTLIL::SigSig(it->second, current_accumulator));
-                            log("UHDM: Created final accumulator assignment for '%s'\n", accumulator_var.c_str());
+                            log_uhdm_trace("UHDM: Created final accumulator assignment for '%s'\n", accumulator_var.c_str());
                         }
                         // Clear the accumulator tracking
                         loop_accumulators.erase(accumulator_var);
@@ -1356,7 +1542,7 @@ void UhdmImporter::process_stmt_to_case(const any* stmt, RTLIL::CaseRule* case_r
                     
                     // Loop has been unrolled into the case rule
                 } else {
-                    log("UHDM: Warning - for loop in function %s cannot be unrolled (can_unroll=%d, loop_var=%s, start=%lld, end=%lld)\n", 
+                    log_uhdm_trace("UHDM: Warning - for loop in function %s cannot be unrolled (can_unroll=%d, loop_var=%s, start=%lld, end=%lld)\n", 
                         func_name.c_str(), can_unroll, loop_var_name.c_str(), (long long)start_value, (long long)end_value);
                 }
         }
@@ -1381,7 +1567,7 @@ void UhdmImporter::process_stmt_to_case(const any* stmt, RTLIL::CaseRule* case_r
             }
             case_rule->actions.push_back(RTLIL::SigSig(lhs_sig, rhs_sig));
             if (mode_debug)
-                log("UHDM: return_stmt assigned to result wire %s\n", result_wire->name.c_str());
+                log_uhdm_trace("UHDM: return_stmt assigned to result wire %s\n", result_wire->name.c_str());
         }
         break;
     }
@@ -1498,20 +1684,109 @@ RTLIL::Const UhdmImporter::extract_const_from_value(const std::string& value_str
     }
 }
 
+// An expression whose import reads only names, selects and operators: no
+// calls, no memories (var_select emits a $memrd per import), and no
+// inc/dec or assignment operators, which write their operand.
+bool UhdmImporter::expr_cacheable(const any* e) {
+    if (!e)
+        return true;
+    auto memo = expr_cache_pure.find(e);
+    if (memo != expr_cache_pure.end())
+        return memo->second;
+    bool pure = false;
+    switch (e->VpiType()) {
+        case vpiConstant:
+        case vpiRefObj:
+            pure = true;
+            break;
+        case vpiBitSelect:
+            pure = expr_cacheable(any_cast<const bit_select*>(e)->VpiIndex());
+            break;
+        case vpiPartSelect: {
+            auto ps = any_cast<const part_select*>(e);
+            pure = expr_cacheable(ps->Left_range()) && expr_cacheable(ps->Right_range());
+            break;
+        }
+        case vpiIndexedPartSelect: {
+            auto ips = any_cast<const indexed_part_select*>(e);
+            pure = expr_cacheable(ips->Base_expr()) && expr_cacheable(ips->Width_expr());
+            break;
+        }
+        case vpiHierPath: {
+            auto hp = any_cast<const hier_path*>(e);
+            pure = true;
+            if (hp->Path_elems())
+                for (auto pe : *hp->Path_elems())
+                    if (!(pure = expr_cacheable(pe)))
+                        break;
+            break;
+        }
+        case vpiOperation: {
+            auto op = any_cast<const operation*>(e);
+            int op_type = op->VpiOpType();
+            pure = op_type != vpiPostIncOp && op_type != vpiPreIncOp &&
+                   op_type != vpiPostDecOp && op_type != vpiPreDecOp &&
+                   op_type != vpiAssignmentOp;
+            if (pure && op->Operands())
+                for (auto o : *op->Operands())
+                    if (!(pure = expr_cacheable(o)))
+                        break;
+            break;
+        }
+        default:
+            break;
+    }
+    expr_cache_pure[e] = pure;
+    return pure;
+}
+
 // Import any expression
 RTLIL::SigSpec UhdmImporter::import_expression(const expr* uhdm_expr, const std::map<std::string, RTLIL::SigSpec>* input_mapping) {
     if (!uhdm_expr)
         return RTLIL::SigSpec();
-    
+
+    // Per-process cache (see expr_cache).  A constant is cheaper to rebuild
+    // than to look up.
+    if (!current_comb_process || in_always_ff_body_mode || !loop_values.empty() ||
+        getCurrentFunctionContext() ||
+        (input_mapping && input_mapping != &current_comb_values) ||
+        uhdm_expr->VpiType() == vpiConstant || !expr_cacheable(uhdm_expr))
+        return import_expression_uncached(uhdm_expr, input_mapping);
+
+    if (expr_cache_proc != current_comb_process) {
+        expr_cache.clear();
+        expr_cache_proc = current_comb_process;
+    }
+    uint64_t epoch = current_comb_values.epoch;
+    ExprCacheKey key(uhdm_expr, input_mapping, epoch,
+                     expression_context_width, expression_context_typespec, current_scope,
+                     comb_lhs_keep_base | force_const_fold << 1 | expression_context_unsigned << 2);
+    auto hit = expr_cache.find(key);
+    if (hit != expr_cache.end()) {
+        expr_cache_hits++;
+        return hit->second;
+    }
+    expr_cache_misses++;
+
+    RTLIL::SigSpec result = import_expression_uncached(uhdm_expr, input_mapping);
+    // A result built while the value map moved, or an unresolved (empty or
+    // all-x) one that a later-created wire could still resolve, is not kept.
+    if (current_comb_values.epoch == epoch && expr_cache_proc == current_comb_process &&
+        !result.empty() && !result.is_fully_undef())
+        expr_cache[key] = result;
+    return result;
+}
+
+RTLIL::SigSpec UhdmImporter::import_expression_uncached(const expr* uhdm_expr, const std::map<std::string, RTLIL::SigSpec>* input_mapping) {
     int obj_type = uhdm_expr->VpiType();
     
     if (mode_debug) {
-        log("  import_expression: VpiType=%d, UhdmType=%s\n", 
+        log_uhdm_trace("  import_expression: VpiType=%d, UhdmType=%s\n", 
             obj_type, UHDM::UhdmName(uhdm_expr->UhdmType()).c_str());
     }
     
     if (obj_type == vpiHierPath) {
-        log("  import_expression: Processing vpiHierPath\n");
+        log_uhdm_trace("  import_expression: Processing vpiHierPath\n");
     }
     
     switch (obj_type) {
@@ -1539,7 +1814,7 @@ RTLIL::SigSpec UhdmImporter::import_expression(const expr* uhdm_expr, const std:
             {
                 const var_select* vs = any_cast<const var_select*>(uhdm_expr);
                 std::string base_name = std::string(vs->VpiName());
-                log("  import_expression: vpiVarSelect base='%s'\n", base_name.c_str());
+                log_uhdm_trace("  import_expression: vpiVarSelect base='%s'\n", base_name.c_str());
 
                 // Get the indices from Exprs()
                 auto exprs = vs->Exprs();
@@ -1628,7 +1903,7 @@ RTLIL::SigSpec UhdmImporter::import_expression(const expr* uhdm_expr, const std:
                                 int oi = i0.as_int(), ii = i1.as_int();
                                 int off = ((oi - outer_low) * inner_size + (ii - inner_low)) * elem_w;
                                 if (off >= 0 && off + elem_w <= base_wire->width) {
-                                    log("  vpiVarSelect: 2D %s[%d][%d] → %s[%d+:%d]\n",
+                                    log_uhdm_trace("  vpiVarSelect: 2D %s[%d][%d] → %s[%d+:%d]\n",
                                         base_name.c_str(), oi, ii,
                                         base_wire->name.c_str(), off, elem_w);
                                     return RTLIL::SigSpec(base_wire).extract(off, elem_w);
@@ -1700,7 +1975,7 @@ RTLIL::SigSpec UhdmImporter::import_expression(const expr* uhdm_expr, const std:
                             sx->setPort(ID::B, acc);
                             sx->setPort(ID::Y, out);
                             add_src_attribute(sx->attributes, vs);
-                            log("  vpiVarSelect: dynamic %zu-index %s → shiftx (w=%d)\n",
+                            log_uhdm_trace("  vpiVarSelect: dynamic %zu-index %s → shiftx (w=%d)\n",
                                 K, base_name.c_str(), level_w);
                             return RTLIL::SigSpec(out);
                         }
@@ -1725,7 +2000,7 @@ RTLIL::SigSpec UhdmImporter::import_expression(const expr* uhdm_expr, const std:
                     if (vs->Actual_group()) {
                         if (auto e = dynamic_cast<const UHDM::expr*>(vs->Actual_group()))
                             if (e->Typespec()) ts = e->Typespec()->Actual_typespec();
-                        pr = dynamic_cast<const UHDM::parameter*>(vs->Actual_group());
+                        pr = uhdm_cast<UHDM::parameter>(vs->Actual_group());
                         if (!ts && pr && pr->Typespec()) ts = pr->Typespec()->Actual_typespec();
                     }
                     std::vector<std::pair<int,int>> pdims; // (size, low) outer->inner
@@ -1814,7 +2089,7 @@ RTLIL::SigSpec UhdmImporter::import_expression(const expr* uhdm_expr, const std:
                                 off += (long)(is.as_const().as_int() - pdims[k].second) * inner;
                             }
                             if (ok && off >= 0 && off + sel_w <= base_sig.size()) {
-                                log("  vpiVarSelect: packed %dD %s[...] → [%d+:%d]\n",
+                                log_uhdm_trace("  vpiVarSelect: packed %dD %s[...] → [%d+:%d]\n",
                                     (int)pdims.size(), base_name.c_str(), (int)off, sel_w);
                                 return base_sig.extract((int)off, sel_w);
                             }
@@ -1866,7 +2141,7 @@ RTLIL::SigSpec UhdmImporter::import_expression(const expr* uhdm_expr, const std:
                                     sx->setPort(ID::A, base_sig);
                                     sx->setPort(ID::B, acc);
                                     sx->setPort(ID::Y, out);
-                                    log("  vpiVarSelect: DYNAMIC packed %dD %s[...] → "
+                                    log_uhdm_trace("  vpiVarSelect: DYNAMIC packed %dD %s[...] → "
                                         "shiftx (w=%d)\n",
                                         (int)pdims.size(), base_name.c_str(), leaf_w);
                                     return RTLIL::SigSpec(out);
@@ -1885,7 +2160,7 @@ RTLIL::SigSpec UhdmImporter::import_expression(const expr* uhdm_expr, const std:
                     RTLIL::Wire* bw = mapped_base_wire ? mapped_base_wire
                                     : module->wire(RTLIL::escape_id(base_name));
                     const UHDM::packed_array_var* pav =
-                        dynamic_cast<const UHDM::packed_array_var*>(vs->Actual_group());
+                        uhdm_cast<UHDM::packed_array_var>(vs->Actual_group());
                     if (!pav && bw)
                         for (auto& kv : wire_map)
                             if (kv.second == bw && kv.first->UhdmType() == uhdmpacked_array_var) {
@@ -1925,7 +2200,7 @@ RTLIL::SigSpec UhdmImporter::import_expression(const expr* uhdm_expr, const std:
                                     off += (long)(is.as_const().as_int() - adims[k].second) * inner;
                                 }
                                 if (cok && off >= 0 && off + leaf_w <= bw->width) {
-                                    log("  vpiVarSelect: packed struct-array %s[...] → [%d+:%d]\n",
+                                    log_uhdm_trace("  vpiVarSelect: packed struct-array %s[...] → [%d+:%d]\n",
                                         base_name.c_str(), (int)off, leaf_w);
                                     return RTLIL::SigSpec(bw).extract((int)off, leaf_w);
                                 }
@@ -1966,7 +2241,7 @@ RTLIL::SigSpec UhdmImporter::import_expression(const expr* uhdm_expr, const std:
                                 } else dim_ok = false;
                             }
                         };
-                        if (auto av = dynamic_cast<const UHDM::array_var*>(vs->Actual_group()))
+                        if (auto av = uhdm_cast<UHDM::array_var>(vs->Actual_group()))
                             add_ranges(av->Ranges());
                         size_t n_unp = udims.size();
                         if (dim_ok && n_unp >= 1 && exprs->size() >= n_unp) {
@@ -1996,7 +2271,7 @@ RTLIL::SigSpec UhdmImporter::import_expression(const expr* uhdm_expr, const std:
                                 if (ok && rem_zero && packed_bits == 1) {
                                     int bit_off = (int)unp_flat;
                                     if (bit_off >= 0 && bit_off < bw->width) {
-                                        log("  vpiVarSelect: %dD %s[...] → %s[%d]\n",
+                                        log_uhdm_trace("  vpiVarSelect: %dD %s[...] → %s[%d]\n",
                                             (int)exprs->size(), base_name.c_str(),
                                             bw->name.c_str(), bit_off);
                                         return RTLIL::SigSpec(bw).extract(bit_off, 1);
@@ -2025,11 +2300,11 @@ RTLIL::SigSpec UhdmImporter::import_expression(const expr* uhdm_expr, const std:
                             rt = e->Typespec();
                         // A function parameter resolves to an io_decl (not an
                         // expr); it carries the packed typespec too (2DFunctionArg).
-                        else if (auto io = dynamic_cast<const UHDM::io_decl*>(actual))
+                        else if (auto io = uhdm_cast<UHDM::io_decl>(actual))
                             rt = io->Typespec();
                         const UHDM::any* a = rt ? rt->Actual_typespec() : nullptr;
                         if (a && a->UhdmType() == uhdmlogic_typespec) {
-                            auto lt = dynamic_cast<const UHDM::logic_typespec*>(a);
+                            auto lt = uhdm_cast<UHDM::logic_typespec>(a);
                             if (lt && lt->Elem_typespec() &&
                                     lt->Elem_typespec()->Actual_typespec()) {
                                 elem_w = get_width_from_typespec(
@@ -2061,7 +2336,7 @@ RTLIL::SigSpec UhdmImporter::import_expression(const expr* uhdm_expr, const std:
                 // below).  Without this a dynamic index returned empty → 0
                 // (check_mem/init,non_zero,power_of_two).
                 if (elem_w == 0 && base_wire) {
-                    if (auto av = dynamic_cast<const UHDM::array_var*>(vs->Actual_group())) {
+                    if (auto av = uhdm_cast<UHDM::array_var>(vs->Actual_group())) {
                         if (av->Ranges() && !av->Ranges()->empty()) {
                             auto r0 = (*av->Ranges())[0];
                             RTLIL::SigSpec l = import_expression(r0->Left_expr(), input_mapping);
@@ -2245,7 +2520,7 @@ RTLIL::SigSpec UhdmImporter::import_expression(const expr* uhdm_expr, const std:
                     }
                 }
 
-                log("  vpiVarSelect: result size=%d\n", result.size());
+                log_uhdm_trace("  vpiVarSelect: result size=%d\n", result.size());
                 return result;
             }
         case vpiPort:
@@ -2253,25 +2528,25 @@ RTLIL::SigSpec UhdmImporter::import_expression(const expr* uhdm_expr, const std:
             {
                 const UHDM::port* port = any_cast<const UHDM::port*>(any_cast<const any*>(uhdm_expr));
                 std::string port_name = std::string(port->VpiName());
-                log("    Handling port '%s' as expression\n", port_name.c_str());
+                log_uhdm_trace("    Handling port '%s' as expression\n", port_name.c_str());
                 
                 // Check if this port has a Low_conn which would be the actual net/wire
                 if (port->Low_conn()) {
-                    log("    Port has Low_conn, importing that instead\n");
+                    log_uhdm_trace("    Port has Low_conn, importing that instead\n");
                     return import_expression(any_cast<const expr*>(port->Low_conn()));
                 }
                 
                 // Otherwise try to find the wire in the current module
                 RTLIL::IdString wire_id = RTLIL::escape_id(port_name);
                 if (module->wire(wire_id)) {
-                    log("    Found wire '%s' for port\n", wire_id.c_str());
+                    log_uhdm_trace("    Found wire '%s' for port\n", wire_id.c_str());
                     return RTLIL::SigSpec(module->wire(wire_id));
                 }
                 
                 // Try looking in the name_map
                 auto it = name_map.find(port_name);
                 if (it != name_map.end()) {
-                    log("    Found wire in name_map for port '%s'\n", port_name.c_str());
+                    log_uhdm_trace("    Found wire in name_map for port '%s'\n", port_name.c_str());
                     return RTLIL::SigSpec(it->second);
                 }
                 
@@ -2283,7 +2558,7 @@ RTLIL::SigSpec UhdmImporter::import_expression(const expr* uhdm_expr, const std:
                 const logic_net* net = any_cast<const logic_net*>(uhdm_expr);
                 std::string net_name = std::string(net->VpiName());
                 if (mode_debug)
-                    log("    Handling logic_net '%s' as expression\n", net_name.c_str());
+                    log_uhdm_trace("    Handling logic_net '%s' as expression\n", net_name.c_str());
                 
                 // If we're in a generate scope, try hierarchical lookups first
                 std::string gen_scope = get_current_gen_scope();
@@ -2291,12 +2566,12 @@ RTLIL::SigSpec UhdmImporter::import_expression(const expr* uhdm_expr, const std:
                     // First try the full hierarchical name
                     std::string hierarchical_name = gen_scope + "." + net_name;
                     if (mode_debug)
-                        log("    Looking for hierarchical wire: %s (gen_scope=%s, net=%s)\n", 
+                        log_uhdm_trace("    Looking for hierarchical wire: %s (gen_scope=%s, net=%s)\n", 
                             hierarchical_name.c_str(), gen_scope.c_str(), net_name.c_str());
                     if (name_map.count(hierarchical_name)) {
                         RTLIL::Wire* wire = name_map[hierarchical_name];
                         if (mode_debug)
-                            log("    Found hierarchical wire %s in name_map\n", hierarchical_name.c_str());
+                            log_uhdm_trace("    Found hierarchical wire %s in name_map\n", hierarchical_name.c_str());
                         return RTLIL::SigSpec(wire);
                     }
                     
@@ -2311,7 +2586,7 @@ RTLIL::SigSpec UhdmImporter::import_expression(const expr* uhdm_expr, const std:
                         if (name_map.count(parent_hierarchical)) {
                             RTLIL::Wire* wire = name_map[parent_hierarchical];
                             if (mode_debug)
-                                log("    Found wire %s in parent scope %s\n", net_name.c_str(), parent_path.c_str());
+                                log_uhdm_trace("    Found wire %s in parent scope %s\n", net_name.c_str(), parent_path.c_str());
                             return RTLIL::SigSpec(wire);
                         }
                     }
@@ -2511,12 +2786,12 @@ RTLIL::SigSpec UhdmImporter::import_expression(const expr* uhdm_expr, const std:
                         // chain to whatever scope encloses it.
                         if (!bound_ts) {
                             const UHDM::module_inst* mi =
-                                dynamic_cast<const UHDM::module_inst*>(
+                                uhdm_cast<UHDM::module_inst>(
                                     (const UHDM::any*)current_instance);
                             if (!mi) {
                                 for (const UHDM::any* up = func_call->VpiParent();
                                      up; up = up->VpiParent()) {
-                                    if ((mi = dynamic_cast<const UHDM::module_inst*>(up)))
+                                    if ((mi = uhdm_cast<UHDM::module_inst>(up)))
                                         break;
                                 }
                             }
@@ -2552,7 +2827,7 @@ RTLIL::SigSpec UhdmImporter::import_expression(const expr* uhdm_expr, const std:
                     auto append_typespec_dims = [&](auto& self, const UHDM::any* ts,
                                                     std::vector<DimInfo>& out) -> void {
                         while (ts) {
-                            if (auto lts = dynamic_cast<const UHDM::logic_typespec*>(ts)) {
+                            if (auto lts = uhdm_cast<UHDM::logic_typespec>(ts)) {
                                 if (auto ranges = lts->Ranges()) {
                                     for (auto r : *ranges) {
                                         RTLIL::SigSpec ls = import_expression(
@@ -2616,7 +2891,7 @@ RTLIL::SigSpec UhdmImporter::import_expression(const expr* uhdm_expr, const std:
                     auto find_array_net_by_name =
                         [&](const std::string& name) -> const UHDM::any* {
                         if (!current_instance) return nullptr;
-                        if (auto m = dynamic_cast<const UHDM::module_inst*>(current_instance)) {
+                        if (auto m = uhdm_cast<UHDM::module_inst>(current_instance)) {
                             if (m->Array_nets()) {
                                 for (auto an : *m->Array_nets()) {
                                     if (std::string(an->VpiName()) == name)
@@ -2640,7 +2915,7 @@ RTLIL::SigSpec UhdmImporter::import_expression(const expr* uhdm_expr, const std:
                         // indices in its `Exprs()` list — each index
                         // strips one outer dim.  We treat it as N nested
                         // bit_selects on the named array_net.
-                        if (auto vs = dynamic_cast<const UHDM::var_select*>(expr)) {
+                        if (auto vs = uhdm_cast<UHDM::var_select>(expr)) {
                             int n_idx = vs->Exprs() ? (int)vs->Exprs()->size() : 0;
                             strip_outer_dims += n_idx;
                             std::string bname = std::string(vs->VpiName());
@@ -2656,7 +2931,7 @@ RTLIL::SigSpec UhdmImporter::import_expression(const expr* uhdm_expr, const std:
                             }
                             return;
                         }
-                        if (auto bs = dynamic_cast<const UHDM::bit_select*>(expr)) {
+                        if (auto bs = uhdm_cast<UHDM::bit_select>(expr)) {
                             ++strip_outer_dims;
                             // Bit-selects on hier_path have the parent path
                             // in VpiParent; on a plain ref the parent is the
@@ -2710,7 +2985,7 @@ RTLIL::SigSpec UhdmImporter::import_expression(const expr* uhdm_expr, const std:
                             unpacked_dim_count = append_array_net_dims(an, dims);
                             return;
                         }
-                        if (auto hp = dynamic_cast<const UHDM::hier_path*>(expr)) {
+                        if (auto hp = uhdm_cast<UHDM::hier_path>(expr)) {
                             // Use the last Path_elems entry — it's the leaf
                             // ref_obj/bit_select that names the actual member.
                             if (hp->Path_elems() && !hp->Path_elems()->empty()) {
@@ -2781,7 +3056,7 @@ RTLIL::SigSpec UhdmImporter::import_expression(const expr* uhdm_expr, const std:
                     // paths whose Path_elems leaf doesn't carry typespec
                     // info directly (struct/union member access).
                     if (!leaf_ts) {
-                        if (auto hp = dynamic_cast<const UHDM::hier_path*>(first_arg)) {
+                        if (auto hp = uhdm_cast<UHDM::hier_path>(first_arg)) {
                             UHDM::ExprEval eval;
                             bool inv = false;
                             UHDM::any* member = eval.decodeHierPath(
@@ -2830,7 +3105,7 @@ RTLIL::SigSpec UhdmImporter::import_expression(const expr* uhdm_expr, const std:
                                     const_cast<UHDM::expr*>(e), inv,
                                     current_instance, e->VpiParent(), true);
                                 if (res && res->UhdmType() == uhdmconstant) {
-                                    auto c = dynamic_cast<const UHDM::constant*>(res);
+                                    auto c = uhdm_cast<UHDM::constant>(res);
                                     RTLIL::SigSpec s = import_constant(c);
                                     if (s.is_fully_const())
                                         dim_index = s.as_const().as_int();
@@ -2904,8 +3179,10 @@ RTLIL::SigSpec UhdmImporter::import_expression(const expr* uhdm_expr, const std:
                     return RTLIL::SigSpec();
                 }
 
+                HeatmapScope heat(this, fc);
+
                 std::string func_name = std::string(fc->VpiName());
-                log("UHDM: Processing function call: %s\n", func_name.c_str());
+                log_uhdm_trace("UHDM: Processing function call: %s\n", func_name.c_str());
 
                 // Get the function definition.  Surelog binds the
                 // `Function()` pointer at parse time and doesn't always
@@ -2928,18 +3205,18 @@ RTLIL::SigSpec UhdmImporter::import_expression(const expr* uhdm_expr, const std:
                     }
                 }
                 if (!func_def) func_def = fc->Function();
-                log("UHDM: func_def pointer: %p\n", (void*)func_def);
+                log_uhdm_trace("UHDM: func_def pointer: %p\n", (void*)func_def);
                 if (!func_def) {
                     log_warning("Function definition not found for %s\n", func_name.c_str());
                     return RTLIL::SigSpec();
                 }
 
                 if (mode_debug) {
-                    log("UHDM: Function definition found for %s\n", func_name.c_str());
+                    log_uhdm_trace("UHDM: Function definition found for %s\n", func_name.c_str());
                     if (func_def->Stmt()) {
-                        log("UHDM: Function has statement body\n");
+                        log_uhdm_trace("UHDM: Function has statement body\n");
                     } else {
-                        log("UHDM: Function has no statement body!\n");
+                        log_uhdm_trace("UHDM: Function has no statement body!\n");
                     }
                 }
 
@@ -2992,7 +3269,7 @@ RTLIL::SigSpec UhdmImporter::import_expression(const expr* uhdm_expr, const std:
                     // Evaluate function at compile time for optimization.
                     // Clear side-effect map so this top-level call starts fresh.
                     const_eval_module_writes.clear();
-                    log("UHDM: Evaluating function %s at compile time (all arguments are constant)\n", func_name.c_str());
+                    log_uhdm_trace("UHDM: Evaluating function %s at compile time (all arguments are constant)\n", func_name.c_str());
                     std::map<std::string, RTLIL::Const> output_params;
                     RTLIL::Const result = evaluate_function_call(func_def, const_args, output_params);
 
@@ -3028,19 +3305,19 @@ RTLIL::SigSpec UhdmImporter::import_expression(const expr* uhdm_expr, const std:
                     if (!has_return) {
                         // Function doesn't assign to its return value
                         // Still generate process for output parameters, but return 0 for the return value
-                        log("UHDM: Function %s in initial block doesn't assign to its return value\n", func_name.c_str());
+                        log_uhdm_trace("UHDM: Function %s in initial block doesn't assign to its return value\n", func_name.c_str());
 
                         // Process function for output parameters (result wire created internally)
 
                         // Generate process to handle output parameters
-                        log("UHDM: Processing function %s with context-aware method\n", func_name.c_str());
+                        log_uhdm_trace("UHDM: Processing function %s with context-aware method\n", func_name.c_str());
                         process_function_with_context(func_def, args, fc, nullptr);
 
                         // But return a constant 0 for the function's return value in initial block
                         return RTLIL::SigSpec(0, ret_width);
                     }
 
-                    log("UHDM: Function %s in initial block has non-constant arguments, generating process\n", func_name.c_str());
+                    log_uhdm_trace("UHDM: Function %s in initial block has non-constant arguments, generating process\n", func_name.c_str());
                 }
 
                 // If we're in a combinational always block, inline the function
@@ -3079,7 +3356,7 @@ RTLIL::SigSpec UhdmImporter::import_expression(const expr* uhdm_expr, const std:
                     (input_mapping == nullptr || input_mapping == &current_comb_values);
                 if (current_comb_process && func_def->Stmt() && top_level_call &&
                     !has_for_loop(func_def->Stmt())) {
-                    log("UHDM: Inlining function %s into combinational process\n", func_name.c_str());
+                    log_uhdm_trace("UHDM: Inlining function %s into combinational process\n", func_name.c_str());
                     return import_func_call_comb(fc, current_comb_process);
                 }
 
@@ -3196,7 +3473,7 @@ RTLIL::SigSpec UhdmImporter::import_expression(const expr* uhdm_expr, const std:
                     if (!has_output_param && !in_gen_scope && !in_always_ff_context &&
                         !in_initial_block && args_match &&
                         is_straight_line(func_def->Stmt())) {
-                        log("UHDM: Inlining function %s via import_func_call_comb (no enclosing process)\n",
+                        log_uhdm_trace("UHDM: Inlining function %s via import_func_call_comb (no enclosing process)\n",
                             func_name.c_str());
                         RTLIL::Process* tmp_proc = module->addProcess(NEW_ID);
                         RTLIL::SyncRule* sta = new RTLIL::SyncRule();
@@ -3222,7 +3499,7 @@ RTLIL::SigSpec UhdmImporter::import_expression(const expr* uhdm_expr, const std:
                 }
 
                 // Process the function using the new context-aware method
-                log("UHDM: Processing function %s with context-aware method (return width=%d, %d arguments)\n",
+                log_uhdm_trace("UHDM: Processing function %s with context-aware method (return width=%d, %d arguments)\n",
                     func_name.c_str(), ret_width, (int)args.size());
                 return process_function_with_context(func_def, args, fc, parent_ctx);
             }
@@ -3239,7 +3516,7 @@ RTLIL::SigSpec UhdmImporter::import_constant(const constant* uhdm_const) {
     std::string value = std::string(uhdm_const->VpiValue());
     int size = uhdm_const->VpiSize();
     
-    log("UHDM: Importing constant: %s (type=%d, size=%d)\n",
+    log_uhdm_trace("UHDM: Importing constant: %s (type=%d, size=%d)\n",
         value.c_str(), const_type, size);
 
     // If VpiConstType is 0 (undefined), infer the type from the value string prefix
@@ -3251,7 +3528,7 @@ RTLIL::SigSpec UhdmImporter::import_constant(const constant* uhdm_const) {
         else if (value.substr(0, 4) == "DEC:") const_type = vpiDecConst;
         else if (value.substr(0, 7) == "STRING:") const_type = vpiStringConst;
         if (const_type != 0)
-            log("UHDM: Inferred constant type %d from value prefix\n", const_type);
+            log_uhdm_trace("UHDM: Inferred constant type %d from value prefix\n", const_type);
     }
 
     switch (const_type) {
@@ -3323,7 +3600,7 @@ RTLIL::SigSpec UhdmImporter::import_constant(const constant* uhdm_const) {
         }
         case vpiHexConst: {
             if (mode_debug)
-                log("    vpiHexConst: value='%s', size=%d\n", value.c_str(), size);
+                log_uhdm_trace("    vpiHexConst: value='%s', size=%d\n", value.c_str(), size);
             
             std::string hex_str;
             // Handle UHDM format: "HEX:value" or traditional "'h prefix"
@@ -3337,7 +3614,7 @@ RTLIL::SigSpec UhdmImporter::import_constant(const constant* uhdm_const) {
             }
             
             if (mode_debug)
-                log("    Parsed hex_str='%s', creating constant with size=%d\n", hex_str.c_str(), size);
+                log_uhdm_trace("    Parsed hex_str='%s', creating constant with size=%d\n", hex_str.c_str(), size);
             
             // Create hex constant with proper bit width.  Build via the
             // nibble-by-nibble helper so arbitrarily wide values work (std::stoull
@@ -3462,7 +3739,7 @@ RTLIL::SigSpec UhdmImporter::import_constant(const constant* uhdm_const) {
         }
         case vpiUIntConst: {
             if (mode_debug)
-                log("    vpiUIntConst: value='%s', size=%d\n", value.c_str(), size);
+                log_uhdm_trace("    vpiUIntConst: value='%s', size=%d\n", value.c_str(), size);
             try {
                 // An UNSIZED value (vpiSize == -1, e.g. the folded `~'hF` in
                 // cva6_tlb's napot mask) must not pass -1 as the Const width —
@@ -3513,7 +3790,7 @@ RTLIL::SigSpec UhdmImporter::import_constant(const constant* uhdm_const) {
             }
 
             if (mode_debug)
-                log("    vpiStringConst: value='%s', str='%s', size=%d\n", value.c_str(), str_val.c_str(), size);
+                log_uhdm_trace("    vpiStringConst: value='%s', str='%s', size=%d\n", value.c_str(), str_val.c_str(), size);
 
             // Convert string to bits: each character is 8 bits, big-endian (first char = MSB)
             int bit_width = str_val.size() * 8;
@@ -3998,7 +4275,7 @@ RTLIL::SigSpec UhdmImporter::import_operation(const operation* uhdm_op, const UH
                     else if (val.size() < field_w) val.extend_u0(field_w);
                 }
                 if (mode_debug)
-                    log("UHDM: AssignmentPatternOp field size=%d\n", val.size());
+                    log_uhdm_trace("UHDM: AssignmentPatternOp field size=%d\n", val.size());
                 field_sigs.push_back(val);
             }
             RTLIL::SigSpec result;
@@ -4040,7 +4317,7 @@ RTLIL::SigSpec UhdmImporter::import_operation(const operation* uhdm_op, const UH
             for (int i = 0; i < count; i++)
                 result.append(elem);
             if (mode_debug)
-                log("UHDM: MultiAssignmentPatternOp %d x %d-bit = %d-bit\n",
+                log_uhdm_trace("UHDM: MultiAssignmentPatternOp %d x %d-bit = %d-bit\n",
                     count, elem.size(), result.size());
             return result;
         }
@@ -4186,12 +4463,12 @@ RTLIL::SigSpec UhdmImporter::import_operation(const operation* uhdm_op, const UH
     // import_hier_path's null-module guard).
     if (!module) {
         if (mode_debug)
-            log("    import_operation: no RTLIL module yet — cannot emit cells, returning empty\n");
+            log_uhdm_trace("    import_operation: no RTLIL module yet — cannot emit cells, returning empty\n");
         return RTLIL::SigSpec();
     }
 
     if (mode_debug)
-        log("    Importing operation: %d\n", op_type);
+        log_uhdm_trace("    Importing operation: %d\n", op_type);
     
     // Get operands
     std::vector<RTLIL::SigSpec> operands;
@@ -4249,7 +4526,7 @@ RTLIL::SigSpec UhdmImporter::import_operation(const operation* uhdm_op, const UH
     }
     if (uhdm_op->Operands()) {
         if (op_type == vpiConditionOp) {
-            log("UHDM: ConditionOp (type=%d) has %d operands\n", op_type, (int)uhdm_op->Operands()->size());
+            log_uhdm_trace("UHDM: ConditionOp (type=%d) has %d operands\n", op_type, (int)uhdm_op->Operands()->size());
         }
         for (auto operand : *uhdm_op->Operands()) {
             int oty = operand->VpiType() == vpiOperation
@@ -4280,7 +4557,7 @@ RTLIL::SigSpec UhdmImporter::import_operation(const operation* uhdm_op, const UH
                 force_const_fold = cond_saved_fcf;
             }
             if (op_type == vpiConditionOp) {
-                log("UHDM: ConditionOp operand %d has size %d\n", (int)operands.size(), op_sig.size());
+                log_uhdm_trace("UHDM: ConditionOp operand %d has size %d\n", (int)operands.size(), op_sig.size());
             }
             // Debug: Check for empty operands in comparison operations
             if ((op_type == vpiEqOp || op_type == vpiNeqOp || op_type == vpiLtOp || 
@@ -4495,7 +4772,7 @@ RTLIL::SigSpec UhdmImporter::import_operation(const operation* uhdm_op, const UH
         
         if (can_evaluate && result.size() > 0) {
             if (mode_debug) {
-                log("    Evaluated constant operation type %d to value %s\n", op_type, result.as_string().c_str());
+                log_uhdm_trace("    Evaluated constant operation type %d to value %s\n", op_type, result.as_string().c_str());
             }
             return RTLIL::SigSpec(result);
         }
@@ -4525,7 +4802,7 @@ RTLIL::SigSpec UhdmImporter::import_operation(const operation* uhdm_op, const UH
             RTLIL::State bit = operands[k].as_const()[0];
             operands[k] = RTLIL::SigSpec(bit, operands[other].size());
             if (mode_debug)
-                log("    fill literal operand %d replicated to %d bits\n",
+                log_uhdm_trace("    fill literal operand %d replicated to %d bits\n",
                     k, operands[other].size());
         }
     }
@@ -4592,7 +4869,7 @@ RTLIL::SigSpec UhdmImporter::import_operation(const operation* uhdm_op, const UH
                     cell_name_str += "$" + std::to_string(logic_not_counter);
                 }
                 
-                log("UHDM: import_operation creating logic_not cell with name: %s (gen_scope=%s)\n", 
+                log_uhdm_trace("UHDM: import_operation creating logic_not cell with name: %s (gen_scope=%s)\n", 
                     cell_name_str.c_str(), get_current_gen_scope().c_str());
                 RTLIL::IdString cell_name = RTLIL::escape_id(cell_name_str);
                 RTLIL::Cell* not_cell = module->addCell(cell_name, ID($logic_not));
@@ -5179,7 +5456,7 @@ RTLIL::SigSpec UhdmImporter::import_operation(const operation* uhdm_op, const UH
                 // operands[2] is the false value
                 // Mux takes (name, selector, false_val, true_val)
 
-                log("UHDM: ConditionOp - operand sizes: cond=%d, true=%d, false=%d\n",
+                log_uhdm_trace("UHDM: ConditionOp - operand sizes: cond=%d, true=%d, false=%d\n",
                     operands[0].size(), operands[1].size(), operands[2].size());
 
                 // SV §11.8.1: a conditional `?:` is signed only when BOTH
@@ -5199,7 +5476,7 @@ RTLIL::SigSpec UhdmImporter::import_operation(const operation* uhdm_op, const UH
                 // Ensure the condition is 1-bit
                 RTLIL::SigSpec cond = operands[0];
                 if (cond.size() > 1) {
-                    log("UHDM: Reducing %d-bit condition to 1-bit\n", cond.size());
+                    log_uhdm_trace("UHDM: Reducing %d-bit condition to 1-bit\n", cond.size());
                     // Reduce multi-bit condition to single bit using ReduceBool
                     std::string cell_name = generate_cell_name(uhdm_op, "reduce_bool");
                     cond = module->ReduceBool(RTLIL::escape_id(cell_name), cond);
@@ -5254,7 +5531,7 @@ RTLIL::SigSpec UhdmImporter::import_operation(const operation* uhdm_op, const UH
                     false_val.extend_u0(max_width, is_signed);
                 }
 
-                log("UHDM: Creating Mux with selector size=%d, true_val size=%d, false_val size=%d, signed=%d\n",
+                log_uhdm_trace("UHDM: Creating Mux with selector size=%d, true_val size=%d, false_val size=%d, signed=%d\n",
                     cond.size(), true_val.size(), false_val.size(), is_signed);
 
                 // Mux signature: Mux(name, sig_a, sig_b, sig_s)
@@ -5394,7 +5671,7 @@ RTLIL::SigSpec UhdmImporter::import_operation(const operation* uhdm_op, const UH
                         result.append(src.extract(num_full * slice_w, leftover));
                 }
                 if (mode_debug)
-                    log("    Stream op type=%d slice_w=%d n=%d "
+                    log_uhdm_trace("    Stream op type=%d slice_w=%d n=%d "
                         "result_size=%d\n", op_type, slice_w, n, result.size());
                 return result;
             }
@@ -5406,7 +5683,7 @@ RTLIL::SigSpec UhdmImporter::import_operation(const operation* uhdm_op, const UH
             // the cast type signedness sets the result type signedness, but
             // the bit-pattern conversion sign-extends only if the source is
             // signed; otherwise zero-extends).
-            log("    Processing cast operation\n");
+            log_uhdm_trace("    Processing cast operation\n");
             if (operands.size() == 1) {
                 int target_width = 0;
                 bool target_signed = false;
@@ -5600,7 +5877,7 @@ RTLIL::SigSpec UhdmImporter::import_operation(const operation* uhdm_op, const UH
             // exprs collapsed through `(XLEN'(1)<<(XLEN-1)) | XLEN'(5)`).
             if (operands.size() == 1 && !operands[0].empty()) {
                 if (mode_debug)
-                    log("    Cast with unresolved width: passing operand through (%d bits)\n",
+                    log_uhdm_trace("    Cast with unresolved width: passing operand through (%d bits)\n",
                         operands[0].size());
                 return operands[0];
             }
@@ -5626,7 +5903,7 @@ RTLIL::Wire* UhdmImporter::find_wire_in_scope(const std::string& signal_name, co
         if (name_map.count(hierarchical_name)) {
             RTLIL::Wire* wire = name_map[hierarchical_name];
             if (!context_for_log.empty()) {
-                log("UHDM: Found hierarchical wire %s for %s\n", hierarchical_name.c_str(), context_for_log.c_str());
+                log_uhdm_trace("UHDM: Found hierarchical wire %s for %s\n", hierarchical_name.c_str(), context_for_log.c_str());
             }
             return wire;
         }
@@ -5642,7 +5919,7 @@ RTLIL::Wire* UhdmImporter::find_wire_in_scope(const std::string& signal_name, co
             if (name_map.count(parent_hierarchical)) {
                 RTLIL::Wire* wire = name_map[parent_hierarchical];
                 if (!context_for_log.empty()) {
-                    log("UHDM: Found wire %s in parent scope %s for %s\n", 
+                    log_uhdm_trace("UHDM: Found wire %s in parent scope %s for %s\n", 
                         signal_name.c_str(), parent_path.c_str(), context_for_log.c_str());
                 }
                 return wire;
@@ -5654,7 +5931,7 @@ RTLIL::Wire* UhdmImporter::find_wire_in_scope(const std::string& signal_name, co
     if (name_map.count(signal_name)) {
         RTLIL::Wire* wire = name_map[signal_name];
         if (!context_for_log.empty()) {
-            log("UHDM: Found wire %s in name_map for %s\n", signal_name.c_str(), context_for_log.c_str());
+            log_uhdm_trace("UHDM: Found wire %s in name_map for %s\n", signal_name.c_str(), context_for_log.c_str());
         }
         return wire;
     }
@@ -5663,7 +5940,7 @@ RTLIL::Wire* UhdmImporter::find_wire_in_scope(const std::string& signal_name, co
     RTLIL::IdString wire_id = RTLIL::escape_id(signal_name);
     RTLIL::Wire* wire = module->wire(wire_id);
     if (wire && !context_for_log.empty()) {
-        log("UHDM: Found wire %s via module->wire for %s\n", signal_name.c_str(), context_for_log.c_str());
+        log_uhdm_trace("UHDM: Found wire %s via module->wire for %s\n", signal_name.c_str(), context_for_log.c_str());
     }
     
     return wire;
@@ -5695,7 +5972,7 @@ RTLIL::SigSpec UhdmImporter::import_ref_obj(const ref_obj* uhdm_ref, const UHDM:
     std::string ref_name = std::string(uhdm_ref->VpiName());
     
     if (mode_debug)
-        log("    Importing ref_obj: %s (current_gen_scope: %s)\n", ref_name.c_str(), get_current_gen_scope().c_str());
+        log_uhdm_trace("    Importing ref_obj: %s (current_gen_scope: %s)\n", ref_name.c_str(), get_current_gen_scope().c_str());
     
     // A loop variable being unrolled must resolve to the CURRENT iteration's
     // constant.  A comb_read_map()-threaded input_mapping can carry a STALE
@@ -5712,7 +5989,7 @@ RTLIL::SigSpec UhdmImporter::import_ref_obj(const ref_obj* uhdm_ref, const UHDM:
         auto it = input_mapping->find(ref_name);
         if (it != input_mapping->end()) {
             if (mode_debug)
-                log("    Found %s in function input_mapping\n", ref_name.c_str());
+                log_uhdm_trace("    Found %s in function input_mapping\n", ref_name.c_str());
             
             // Check if we have a constant value for this parameter
             FunctionCallContext* ctx = getCurrentFunctionContext();
@@ -5731,12 +6008,12 @@ RTLIL::SigSpec UhdmImporter::import_ref_obj(const ref_obj* uhdm_ref, const UHDM:
                     sized.resize(param_width, RTLIL::State::S0);
                     const_val = sized;
                 }
-                log("UHDM: Function parameter %s has constant value %s\n",
+                log_uhdm_trace("UHDM: Function parameter %s has constant value %s\n",
                     ref_name.c_str(), const_val.as_string().c_str());
                 return RTLIL::SigSpec(const_val);
             }
             
-            log("UHDM: Function parameter %s mapped to signal %s\n", 
+            log_uhdm_trace("UHDM: Function parameter %s mapped to signal %s\n", 
                 ref_name.c_str(), it->second.is_wire() ? 
                 it->second.as_wire()->name.c_str() : "const/temp");
             return it->second;
@@ -5799,7 +6076,7 @@ RTLIL::SigSpec UhdmImporter::import_ref_obj(const ref_obj* uhdm_ref, const UHDM:
                 arr.append(RTLIL::SigSpec(ew));
             }
             if (arr.size() > 0) {
-                log("    ref_obj: whole unpacked array %s -> %d-bit element concat\n",
+                log_uhdm_trace("    ref_obj: whole unpacked array %s -> %d-bit element concat\n",
                     ref_name.c_str(), arr.size());
                 return arr;
             }
@@ -5815,12 +6092,12 @@ RTLIL::SigSpec UhdmImporter::import_ref_obj(const ref_obj* uhdm_ref, const UHDM:
         const logic_net* net = any_cast<const logic_net*>(actual_for_signal);
         std::string actual_name = std::string(net->VpiName());
         if (mode_debug)
-            log("    ref_obj has Actual_group() pointing to logic_net: %s\n", actual_name.c_str());
+            log_uhdm_trace("    ref_obj has Actual_group() pointing to logic_net: %s\n", actual_name.c_str());
         
         // Check if this is a module output that was incorrectly prefixed with generate scope
         if (name_map.count(actual_name)) {
             if (mode_debug)
-                log("    Using actual signal: %s\n", actual_name.c_str());
+                log_uhdm_trace("    Using actual signal: %s\n", actual_name.c_str());
             return RTLIL::SigSpec(name_map[actual_name]);
         }
         
@@ -5828,7 +6105,7 @@ RTLIL::SigSpec UhdmImporter::import_ref_obj(const ref_obj* uhdm_ref, const UHDM:
         RTLIL::IdString wire_id = RTLIL::escape_id(actual_name);
         if (module->wire(wire_id)) {
             if (mode_debug)
-                log("    Found actual signal as module wire: %s\n", wire_id.c_str());
+                log_uhdm_trace("    Found actual signal as module wire: %s\n", wire_id.c_str());
             return RTLIL::SigSpec(module->wire(wire_id));
         }
     }
@@ -5837,7 +6114,7 @@ RTLIL::SigSpec UhdmImporter::import_ref_obj(const ref_obj* uhdm_ref, const UHDM:
     if (loop_values.count(ref_name)) {
         int value = loop_values[ref_name];
         if (mode_debug)
-            log("    Substituting loop variable %s with value %d\n", ref_name.c_str(), value);
+            log_uhdm_trace("    Substituting loop variable %s with value %d\n", ref_name.c_str(), value);
         return RTLIL::SigSpec(RTLIL::Const(value, 32));
     }
     
@@ -5861,7 +6138,7 @@ RTLIL::SigSpec UhdmImporter::import_ref_obj(const ref_obj* uhdm_ref, const UHDM:
             std::string val_str = std::string(enum_val->VpiValue());
             
             if (mode_debug)
-                log("UHDM: Found enum constant %s with value %s\n", ref_name.c_str(), val_str.c_str());
+                log_uhdm_trace("UHDM: Found enum constant %s with value %s\n", ref_name.c_str(), val_str.c_str());
             
             // Parse value from format like "INT:0", "UINT:1", "HEX:BB", etc.
             RTLIL::Const enum_value;
@@ -5913,7 +6190,7 @@ RTLIL::SigSpec UhdmImporter::import_ref_obj(const ref_obj* uhdm_ref, const UHDM:
                 module->parameter_default_values.at(p_id).size() > 0) {
                 param_value = module->parameter_default_values.at(p_id);
                 if (mode_debug)
-                    log("UHDM: Using module parameter %s value %s (overrides base VpiValue)\n",
+                    log_uhdm_trace("UHDM: Using module parameter %s value %s (overrides base VpiValue)\n",
                         param_name.c_str(), param_value.as_string().c_str());
             } else {
                 // Fall back to VpiValue from the UHDM parameter object
@@ -6032,10 +6309,10 @@ RTLIL::SigSpec UhdmImporter::import_ref_obj(const ref_obj* uhdm_ref, const UHDM:
                         // Param_assigns().  Find it by name.
                         if ((!parent || parent->UhdmType() != uhdmparam_assign) &&
                             current_instance) {
-                            if (auto mi = dynamic_cast<const UHDM::module_inst*>(current_instance))
+                            if (auto mi = uhdm_cast<UHDM::module_inst>(current_instance))
                                 if (mi->Param_assigns())
                                     for (auto pa2 : *mi->Param_assigns())
-                                        if (auto l = dynamic_cast<const UHDM::parameter*>(pa2->Lhs()))
+                                        if (auto l = uhdm_cast<UHDM::parameter>(pa2->Lhs()))
                                             if (std::string(l->VpiName()) == param_name) {
                                                 parent = pa2; break;
                                             }
@@ -6084,7 +6361,7 @@ RTLIL::SigSpec UhdmImporter::import_ref_obj(const ref_obj* uhdm_ref, const UHDM:
             }
             
             if (mode_debug)
-                log("UHDM: ref_obj %s refers to parameter with value %s\n", 
+                log_uhdm_trace("UHDM: ref_obj %s refers to parameter with value %s\n", 
                     ref_name.c_str(), param_value.as_string().c_str());
             return RTLIL::SigSpec(param_value);
         }
@@ -6095,7 +6372,7 @@ RTLIL::SigSpec UhdmImporter::import_ref_obj(const ref_obj* uhdm_ref, const UHDM:
     if (module->parameter_default_values.count(param_id)) {
         RTLIL::Const param_value = module->parameter_default_values.at(param_id);
         if (mode_debug)
-            log("UHDM: Found parameter %s with value %s (bits=%d)\n", 
+            log_uhdm_trace("UHDM: Found parameter %s with value %s (bits=%d)\n", 
                 ref_name.c_str(), param_value.as_string().c_str(), param_value.size());
         return RTLIL::SigSpec(param_value);
     }
@@ -6106,11 +6383,11 @@ RTLIL::SigSpec UhdmImporter::import_ref_obj(const ref_obj* uhdm_ref, const UHDM:
         // First try the full hierarchical name
         std::string hierarchical_name = gen_scope + "." + ref_name;
         if (mode_debug)
-            log("    Looking for hierarchical wire: %s (gen_scope=%s, ref=%s)\n", 
+            log_uhdm_trace("    Looking for hierarchical wire: %s (gen_scope=%s, ref=%s)\n", 
                 hierarchical_name.c_str(), gen_scope.c_str(), ref_name.c_str());
         if (name_map.count(hierarchical_name)) {
             RTLIL::Wire* wire = name_map[hierarchical_name];
-            log("UHDM: Found hierarchical wire %s in name_map\n", hierarchical_name.c_str());
+            log_uhdm_trace("UHDM: Found hierarchical wire %s in name_map\n", hierarchical_name.c_str());
             return RTLIL::SigSpec(wire);
         }
         
@@ -6126,12 +6403,12 @@ RTLIL::SigSpec UhdmImporter::import_ref_obj(const ref_obj* uhdm_ref, const UHDM:
             std::string parent_hierarchical = parent_path + "." + ref_name;
             if (name_map.count(parent_hierarchical)) {
                 RTLIL::Wire* wire = name_map[parent_hierarchical];
-                log("UHDM: Found wire %s in parent scope %s\n", ref_name.c_str(), parent_path.c_str());
+                log_uhdm_trace("UHDM: Found wire %s in parent scope %s\n", ref_name.c_str(), parent_path.c_str());
                 return RTLIL::SigSpec(wire);
             }
         }
         
-        log("UHDM: In generate scope %s, wire %s not found in hierarchical lookup\n",
+        log_uhdm_trace("UHDM: In generate scope %s, wire %s not found in hierarchical lookup\n",
             gen_scope.c_str(), ref_name.c_str());
     }
     
@@ -6147,7 +6424,7 @@ RTLIL::SigSpec UhdmImporter::import_ref_obj(const ref_obj* uhdm_ref, const UHDM:
     if (module && gen_scope.empty()) {
         RTLIL::IdString wire_id = RTLIL::escape_id(ref_name);
         if (RTLIL::Wire* existing_wire = module->wire(wire_id)) {
-            log("UHDM: Found existing wire %s in module\n", ref_name.c_str());
+            log_uhdm_trace("UHDM: Found existing wire %s in module\n", ref_name.c_str());
             // Add to name_map for future lookups
             name_map[ref_name] = existing_wire;
             return RTLIL::SigSpec(existing_wire);
@@ -6158,7 +6435,7 @@ RTLIL::SigSpec UhdmImporter::import_ref_obj(const ref_obj* uhdm_ref, const UHDM:
     if (uhdm_ref->Actual_group()) {
         const UHDM::any* actual = uhdm_ref->Actual_group();
         if (mode_debug) {
-            log("    ref_obj has VpiActual of type: %s\n", UhdmName(actual->UhdmType()).c_str());
+            log_uhdm_trace("    ref_obj has VpiActual of type: %s\n", UhdmName(actual->UhdmType()).c_str());
         }
         
         // Check if the actual is an interface_inst
@@ -6166,7 +6443,7 @@ RTLIL::SigSpec UhdmImporter::import_ref_obj(const ref_obj* uhdm_ref, const UHDM:
             // This is a reference to an interface instance
             // Create the interface connection wire with proper naming
             std::string interface_wire_name = "$dummywireforinterface\\" + ref_name;
-            log("UHDM: Reference to interface instance %s via VpiActual, creating connection wire %s\n", 
+            log_uhdm_trace("UHDM: Reference to interface instance %s via VpiActual, creating connection wire %s\n", 
                 ref_name.c_str(), interface_wire_name.c_str());
             return create_wire(interface_wire_name, 1);
         }
@@ -6183,7 +6460,7 @@ RTLIL::SigSpec UhdmImporter::import_ref_obj(const ref_obj* uhdm_ref, const UHDM:
             // This is a reference to an interface instance
             // Create the interface connection wire with proper naming
             std::string interface_wire_name = "$dummywireforinterface\\" + ref_name;
-            log("UHDM: Reference to interface instance %s, creating connection wire %s\n", 
+            log_uhdm_trace("UHDM: Reference to interface instance %s, creating connection wire %s\n", 
                 ref_name.c_str(), interface_wire_name.c_str());
             return create_wire(interface_wire_name, 1);
         }
@@ -6196,7 +6473,7 @@ RTLIL::SigSpec UhdmImporter::import_ref_obj(const ref_obj* uhdm_ref, const UHDM:
         
         // Check if the actual is an integer_var - these are always 32-bit
         if (actual->UhdmType() == uhdminteger_var) {
-            log("Reference to integer variable '%s' via Actual_group() - creating 32-bit wire\n", ref_name.c_str());
+            log_uhdm_trace("Reference to integer variable '%s' via Actual_group() - creating 32-bit wire\n", ref_name.c_str());
             return create_wire(ref_name, 32);
         }
         
@@ -6217,7 +6494,7 @@ RTLIL::SigSpec UhdmImporter::import_ref_obj(const ref_obj* uhdm_ref, const UHDM:
         
         // Check if the typespec is integer
         if (ts && ts->UhdmType() == uhdminteger_typespec) {
-            log("Reference to variable with integer typespec '%s' - creating 32-bit wire\n", ref_name.c_str());
+            log_uhdm_trace("Reference to variable with integer typespec '%s' - creating 32-bit wire\n", ref_name.c_str());
             return create_wire(ref_name, 32);
         }
     }
@@ -6227,7 +6504,7 @@ RTLIL::SigSpec UhdmImporter::import_ref_obj(const ref_obj* uhdm_ref, const UHDM:
     std::string wire_name = ref_name;
     if (!gen_scope.empty()) {
         wire_name = gen_scope + "." + ref_name;
-        log("Creating wire with hierarchical name: %s (in generate scope %s)\n", 
+        log_uhdm_trace("Creating wire with hierarchical name: %s (in generate scope %s)\n", 
             wire_name.c_str(), gen_scope.c_str());
     }
     
@@ -6244,9 +6521,9 @@ RTLIL::SigSpec UhdmImporter::import_ref_obj(const ref_obj* uhdm_ref, const UHDM:
     bool ref_is_iface_localparam = false;
     if (current_instance) {
         std::vector<const UHDM::interface_inst*> ifaces;
-        if (auto ii = dynamic_cast<const UHDM::interface_inst*>(current_instance))
+        if (auto ii = uhdm_cast<UHDM::interface_inst>(current_instance))
             ifaces.push_back(ii);
-        if (auto mi = dynamic_cast<const UHDM::module_inst*>(current_instance)) {
+        if (auto mi = uhdm_cast<UHDM::module_inst>(current_instance)) {
             if (mi->Interfaces())
                 for (auto ii : *mi->Interfaces()) ifaces.push_back(ii);
             // A modport PORT exposes its interface via the port's Low_conn (the
@@ -6294,7 +6571,7 @@ RTLIL::SigSpec UhdmImporter::import_ref_obj(const ref_obj* uhdm_ref, const UHDM:
             if (rc) {
                 RTLIL::SigSpec v = import_constant(rc);
                 if (v.is_fully_const()) {
-                    log("    ref_obj: interface localparam %s -> %d\n",
+                    log_uhdm_trace("    ref_obj: interface localparam %s -> %d\n",
                         ref_name.c_str(), v.as_const().as_int());
                     return v;
                 }
@@ -6308,7 +6585,7 @@ RTLIL::SigSpec UhdmImporter::import_ref_obj(const ref_obj* uhdm_ref, const UHDM:
     // submodules reaching the interface only through a bare port placeholder).
     if (ref_is_iface_localparam) {
         if (mode_debug)
-            log("    ref_obj '%s' is an interface localparam (constant width via "
+            log_uhdm_trace("    ref_obj '%s' is an interface localparam (constant width via "
                 "typespec); not a signal\n", ref_name.c_str());
     } else {
         log_warning("Reference to unknown signal: %s\n", ref_name.c_str());
@@ -6330,7 +6607,7 @@ RTLIL::SigSpec UhdmImporter::import_ref_obj(const ref_obj* uhdm_ref, const UHDM:
 // Import part select (e.g., sig[7:0])
 RTLIL::SigSpec UhdmImporter::import_part_select(const part_select* uhdm_part, const UHDM::scope* inst, const std::map<std::string, RTLIL::SigSpec>* input_mapping) {
     if (mode_debug)
-        log("    Importing part select\n");
+        log_uhdm_trace("    Importing part select\n");
     
     // Get the parent object - this should contain the base signal
     const any* parent = uhdm_part->VpiParent();
@@ -6339,26 +6616,26 @@ RTLIL::SigSpec UhdmImporter::import_part_select(const part_select* uhdm_part, co
         return RTLIL::SigSpec();
     }
     
-    log("      Parent type: %s\n", UhdmName(parent->UhdmType()).c_str());
+    log_uhdm_trace("      Parent type: %s\n", UhdmName(parent->UhdmType()).c_str());
     
     // Check if the indexed part select itself has the signal name
     std::string base_signal_name;
     if (!uhdm_part->VpiDefName().empty()) {
         base_signal_name = std::string(uhdm_part->VpiDefName());
-        log("      PartSelect VpiDefName: %s\n", base_signal_name.c_str());
+        log_uhdm_trace("      PartSelect VpiDefName: %s\n", base_signal_name.c_str());
     } else if (!uhdm_part->VpiName().empty()) {
         base_signal_name = std::string(uhdm_part->VpiName());
-        log("      PartSelect VpiName: %s\n", base_signal_name.c_str());
+        log_uhdm_trace("      PartSelect VpiName: %s\n", base_signal_name.c_str());
     }
     
     // If not found in the indexed part select, try the parent
     if (base_signal_name.empty()) {
         if (!parent->VpiDefName().empty()) {
             base_signal_name = std::string(parent->VpiDefName());
-            log("      Parent VpiDefName: %s\n", base_signal_name.c_str());
+            log_uhdm_trace("      Parent VpiDefName: %s\n", base_signal_name.c_str());
         } else if (!parent->VpiName().empty()) {
             base_signal_name = std::string(parent->VpiName());
-            log("      Parent VpiName: %s\n", base_signal_name.c_str());
+            log_uhdm_trace("      Parent VpiName: %s\n", base_signal_name.c_str());
         }
     }
     
@@ -6371,7 +6648,7 @@ RTLIL::SigSpec UhdmImporter::import_part_select(const part_select* uhdm_part, co
             RTLIL::Wire* w = find_wire_in_scope(base_signal_name, "part select width");
             int bw = w ? w->width : 32;
             base = RTLIL::SigSpec(RTLIL::Const(lv, bw));
-            log("      PartSelect: substituting loop var '%s' = %d\n", base_signal_name.c_str(), lv);
+            log_uhdm_trace("      PartSelect: substituting loop var '%s' = %d\n", base_signal_name.c_str(), lv);
         } else if (input_mapping && input_mapping->count(base_signal_name) &&
                    (!comb_lhs_keep_base ||
                     !module->wire(RTLIL::escape_id(base_signal_name)))) {
@@ -6388,7 +6665,7 @@ RTLIL::SigSpec UhdmImporter::import_part_select(const part_select* uhdm_part, co
             // wire, so they still resolve through input_mapping
             // (function_mixed's `result[2*i] = x[i]`).
             base = input_mapping->at(base_signal_name);
-            log("      PartSelect: base '%s' from input_mapping (width=%d)\n",
+            log_uhdm_trace("      PartSelect: base '%s' from input_mapping (width=%d)\n",
                 base_signal_name.c_str(), base.size());
         } else if (uhdm_part->Actual_group() &&
                    uhdm_part->Actual_group()->VpiType() == vpiParameter) {
@@ -6412,7 +6689,7 @@ RTLIL::SigSpec UhdmImporter::import_part_select(const part_select* uhdm_part, co
             RTLIL::IdString p_id = RTLIL::escape_id(std::string(p->VpiName()));
             if (module->parameter_default_values.count(p_id)) {
                 base = RTLIL::SigSpec(module->parameter_default_values.at(p_id));
-                log("      PartSelect: base '%s' from module parameter (width=%d)\n",
+                log_uhdm_trace("      PartSelect: base '%s' from module parameter (width=%d)\n",
                     base_signal_name.c_str(), base.size());
             } else {
                 std::string vs = std::string(p->VpiValue());
@@ -6424,7 +6701,7 @@ RTLIL::SigSpec UhdmImporter::import_part_select(const part_select* uhdm_part, co
                 }
                 if (!vs.empty())
                     base = RTLIL::SigSpec(RTLIL::Const(parse_vpi_value_to_int(vs), bw));
-                log("      PartSelect: base '%s' from genvar/parameter = %s (width=%d)\n",
+                log_uhdm_trace("      PartSelect: base '%s' from genvar/parameter = %s (width=%d)\n",
                     base_signal_name.c_str(), vs.c_str(), bw);
             }
         }
@@ -6447,14 +6724,14 @@ RTLIL::SigSpec UhdmImporter::import_part_select(const part_select* uhdm_part, co
             RTLIL::IdString param_id = RTLIL::escape_id(base_signal_name);
             if (module->parameter_default_values.count(param_id)) {
                 base = RTLIL::SigSpec(module->parameter_default_values.at(param_id));
-                log("      Resolved '%s' as parameter for part select (width=%d)\n",
+                log_uhdm_trace("      Resolved '%s' as parameter for part select (width=%d)\n",
                     base_signal_name.c_str(), base.size());
-            } else if (package_parameter_map.count(base_signal_name)) {
+            } else if (const RTLIL::Const* pkg_val = package_parameter(base_signal_name)) {
                 // A package localparam sliced directly, e.g. CVA6 csr_regfile
                 // `ariane_pkg::SMODE_STATUS_WRITE_MASK[CVA6Cfg.XLEN-1:0]` — the
                 // base is a compile-time package constant, not a signal.
-                base = RTLIL::SigSpec(package_parameter_map.at(base_signal_name));
-                log("      Resolved '%s' as package parameter for part select (width=%d)\n",
+                base = RTLIL::SigSpec(*pkg_val);
+                log_uhdm_trace("      Resolved '%s' as package parameter for part select (width=%d)\n",
                     base_signal_name.c_str(), base.size());
             } else if (RTLIL::Wire* e0 =
                            (name_map.count(base_signal_name + "[0]")
@@ -6492,7 +6769,7 @@ RTLIL::SigSpec UhdmImporter::import_part_select(const part_select* uhdm_part, co
                         else { ok = false; break; }
                     }
                     if (ok && concat.size() > 0) {
-                        log("    part_select: element-array %s[%d:%d] → %d-bit concat\n",
+                        log_uhdm_trace("    part_select: element-array %s[%d:%d] → %d-bit concat\n",
                             base_signal_name.c_str(), el, er, concat.size());
                         return concat;
                     }
@@ -6537,7 +6814,7 @@ RTLIL::SigSpec UhdmImporter::import_part_select(const part_select* uhdm_part, co
             base = im->second;
     }
 
-    log("      Base signal width: %d\n", base.size());
+    log_uhdm_trace("      Base signal width: %d\n", base.size());
 
     // Get range
     int left = -1, right = -1;
@@ -6642,7 +6919,7 @@ RTLIL::SigSpec UhdmImporter::import_part_select(const part_select* uhdm_part, co
                         offset = decl_asc ? (decl_high - ihi) * elem_w
                                           : (ilo - decl_low) * elem_w;
                         width = (ihi - ilo + 1) * elem_w;
-                        log("    part_select: packed-array element range [%d:%d] "
+                        log_uhdm_trace("    part_select: packed-array element range [%d:%d] "
                             "(elem_w=%d) -> bits [%d+:%d]\n",
                             left, right, elem_w, offset, width);
                     }
@@ -6678,13 +6955,13 @@ RTLIL::SigSpec UhdmImporter::import_part_select(const part_select* uhdm_part, co
 // Import bit select (e.g., sig[3])
 RTLIL::SigSpec UhdmImporter::import_bit_select(const bit_select* uhdm_bit, const UHDM::scope* inst, const std::map<std::string, RTLIL::SigSpec>* input_mapping) {
     if (mode_debug)
-        log("    Importing bit select\n");
+        log_uhdm_trace("    Importing bit select\n");
 
     // Get the signal name directly from the bit_select
     std::string signal_name = std::string(uhdm_bit->VpiName());
 
     if (mode_debug)
-        log("    Bit select signal name: '%s'\n", signal_name.c_str());
+        log_uhdm_trace("    Bit select signal name: '%s'\n", signal_name.c_str());
 
     // Function-parameter bit access: if the parameter has a constant
     // value tracked in the current FunctionCallContext, return the
@@ -6713,7 +6990,7 @@ RTLIL::SigSpec UhdmImporter::import_bit_select(const bit_select* uhdm_bit, const
     RTLIL::IdString mem_id = RTLIL::escape_id(signal_name);
     if (module->memories.count(mem_id) > 0) {
         if (mode_debug)
-            log("    This is a memory access - creating $memrd cell\n");
+            log_uhdm_trace("    This is a memory access - creating $memrd cell\n");
         
         // Get memory info
         RTLIL::Memory* memory = module->memories.at(mem_id);
@@ -6739,8 +7016,8 @@ RTLIL::SigSpec UhdmImporter::import_bit_select(const bit_select* uhdm_bit, const
         RTLIL::Wire* data_wire = module->addWire(data_wire_id, memory->width);
         
         if (mode_debug) {
-            log("    Created memrd cell: %s\n", cell_name.c_str());
-            log("    Created data wire: %s\n", data_wire_id.c_str());
+            log_uhdm_trace("    Created memrd cell: %s\n", cell_name.c_str());
+            log_uhdm_trace("    Created data wire: %s\n", data_wire_id.c_str());
         }
         
         // Connect ports
@@ -6800,7 +7077,22 @@ RTLIL::SigSpec UhdmImporter::import_bit_select(const bit_select* uhdm_bit, const
                 if (num_elems > 0 && (i < arr_low || i >= arr_low + num_elems))
                     return RTLIL::SigSpec(RTLIL::State::Sx, elem_w);
             } else {
-                // Dynamic index — build mux chain over DECLARED indices.
+                // Dynamic index — one $bmux over the DECLARED elements.
+                std::vector<RTLIL::SigSpec> elems;
+                for (int i = arr_low; i < arr_low + num_elems; i++) {
+                    std::string ename = signal_name + "[" + std::to_string(i) + "]";
+                    if (current_comb_values.count(ename))
+                        elems.push_back(current_comb_values.at(ename));
+                    else {
+                        RTLIL::Wire* w = module->wire(RTLIL::escape_id(ename));
+                        elems.push_back(w ? RTLIL::SigSpec(w) : RTLIL::SigSpec(RTLIL::State::Sx, elem_w));
+                    }
+                }
+                RTLIL::SigSpec table_read = dynamic_index_read(idx, elems, arr_low);
+                if (!table_read.empty())
+                    return table_read;
+
+                // Index too wide to table — build mux chain over DECLARED indices.
                 int last = arr_low + num_elems - 1;
                 int idx_w = GetSize(idx);
                 // Can the index address a non-existent element?  If the
@@ -6975,7 +7267,7 @@ RTLIL::SigSpec UhdmImporter::import_bit_select(const bit_select* uhdm_bit, const
                         RTLIL::SigSpec full(param_value);
                         RTLIL::SigSpec slice = full.extract(off, elem_w);
                         if (mode_debug)
-                            log("    Bit-select on parameter %s[%d]: extracted %d bits @off %d\n",
+                            log_uhdm_trace("    Bit-select on parameter %s[%d]: extracted %d bits @off %d\n",
                                 signal_name.c_str(), idx, elem_w, off);
                         return slice;
                     }
@@ -6998,7 +7290,7 @@ RTLIL::SigSpec UhdmImporter::import_bit_select(const bit_select* uhdm_bit, const
             wire = module->wire(indexed_name);
             if (wire) {
                 if (mode_debug)
-                    log("    Found shift register element: %s\n", indexed_name.c_str());
+                    log_uhdm_trace("    Found shift register element: %s\n", indexed_name.c_str());
                 // Return the whole wire since it represents M[idx]
                 return RTLIL::SigSpec(wire);
             }
@@ -7223,7 +7515,7 @@ RTLIL::SigSpec UhdmImporter::import_bit_select(const bit_select* uhdm_bit, const
     if (index.is_fully_const()) {
         int idx = index.as_const().as_int();
         if (mode_debug)
-            log("    Bit select index: %d\n", idx);
+            log_uhdm_trace("    Bit select index: %d\n", idx);
 
         if (packed_elem_w > 1) {
             int outer_lo = std::min(packed_outer_l, packed_outer_r);
@@ -7246,7 +7538,7 @@ RTLIL::SigSpec UhdmImporter::import_bit_select(const bit_select* uhdm_bit, const
                 log_error("Bit select index %d is out of range for wire '%s'\n", idx, signal_name.c_str());
             }
             if (mode_debug)
-                log("    Converted HDL index %d to RTLIL index %d (upto=%d, start_offset=%d)\n",
+                log_uhdm_trace("    Converted HDL index %d to RTLIL index %d (upto=%d, start_offset=%d)\n",
                     idx, rtlil_idx, wire->upto ? 1 : 0, wire->start_offset);
 
             // Check bounds before extracting
@@ -7431,7 +7723,7 @@ RTLIL::SigSpec UhdmImporter::import_bit_select(const bit_select* uhdm_bit, const
     }
 
     if (mode_debug)
-        log("    Creating $shiftx for dynamic bit select (element_width=%d)\n", element_width);
+        log_uhdm_trace("    Creating $shiftx for dynamic bit select (element_width=%d)\n", element_width);
 
     RTLIL::SigSpec shift_amount;
     if (element_width > 1) {
@@ -7515,7 +7807,7 @@ RTLIL::SigSpec UhdmImporter::import_bit_select(const bit_select* uhdm_bit, const
 // Import indexed part select (e.g., data[i*8 +: 8])
 RTLIL::SigSpec UhdmImporter::import_indexed_part_select(const indexed_part_select* uhdm_indexed, const UHDM::scope* inst, const std::map<std::string, RTLIL::SigSpec>* input_mapping) {
     if (mode_debug)
-        log("    Importing indexed part select\n");
+        log_uhdm_trace("    Importing indexed part select\n");
 
     // Get the parent object - this should contain the base signal
     const any* parent = uhdm_indexed->VpiParent();
@@ -7525,7 +7817,7 @@ RTLIL::SigSpec UhdmImporter::import_indexed_part_select(const indexed_part_selec
     }
     
     if (mode_debug)
-        log("      Parent type: %s\n", UhdmName(parent->UhdmType()).c_str());
+        log_uhdm_trace("      Parent type: %s\n", UhdmName(parent->UhdmType()).c_str());
 
     // Check if the indexed part select itself has the signal name
     std::string base_signal_name;
@@ -7574,10 +7866,10 @@ RTLIL::SigSpec UhdmImporter::import_indexed_part_select(const indexed_part_selec
                 RTLIL::IdString param_id = RTLIL::escape_id(base_signal_name);
                 if (module->parameter_default_values.count(param_id)) {
                     base = RTLIL::SigSpec(module->parameter_default_values.at(param_id));
-                } else if (package_parameter_map.count(base_signal_name)) {
+                } else if (const RTLIL::Const* pkg_val = package_parameter(base_signal_name)) {
                     // Package localparam sliced with a dynamic/indexed range,
                     // e.g. `ariane_pkg::SMODE_STATUS_WRITE_MASK[XLEN-1:0]`.
-                    base = RTLIL::SigSpec(package_parameter_map.at(base_signal_name));
+                    base = RTLIL::SigSpec(*pkg_val);
                 } else {
                     std::string gen_scope = get_current_gen_scope();
                     log_warning("Base signal '%s' not found in module or generate scope %s\n",
@@ -7691,7 +7983,7 @@ RTLIL::SigSpec UhdmImporter::import_indexed_part_select(const indexed_part_selec
 // Import concatenation (e.g., {a, b, c})
 RTLIL::SigSpec UhdmImporter::import_concat(const operation* uhdm_concat, const UHDM::scope* inst) {
     if (mode_debug)
-        log("    Importing concatenation\n");
+        log_uhdm_trace("    Importing concatenation\n");
     
     RTLIL::SigSpec result;
     
@@ -7906,7 +8198,7 @@ RTLIL::SigSpec UhdmImporter::import_param_array_elem_field(
         if (idx < 0 || idx >= nelem)
             return RTLIL::SigSpec();
         if (mode_debug)
-            log("    param array elem field: %s[%d].%s -> %d bits\n",
+            log_uhdm_trace("    param array elem field: %s[%d].%s -> %d bits\n",
                 std::string(param->VpiName()).c_str(), idx,
                 fields.back().c_str(), field_width);
         return slice_of(idx);
@@ -7923,7 +8215,7 @@ RTLIL::SigSpec UhdmImporter::import_param_array_elem_field(
         result = module->Mux(NEW_ID, result, slice_of(idx), eq);
     }
     if (mode_debug)
-        log("    param array elem field: %s[<dyn>].%s -> %d-bit mux of %d\n",
+        log_uhdm_trace("    param array elem field: %s[<dyn>].%s -> %d-bit mux of %d\n",
             std::string(param->VpiName()).c_str(), fields.back().c_str(),
             field_width, nelem);
     return result;
@@ -7931,7 +8223,7 @@ RTLIL::SigSpec UhdmImporter::import_param_array_elem_field(
 
 RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const scope* inst, const std::map<std::string, RTLIL::SigSpec>* input_mapping) {
     if (mode_debug)
-        log("    Importing hier_path\n");
+        log_uhdm_trace("    Importing hier_path\n");
 
     // Guard: import_hier_path dereferences `module` (e.g. module->cell()) while
     // resolving cell/instance references.  type_param_signature() computes port
@@ -7954,7 +8246,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
     }
     
     if (mode_debug)
-        log("    hier_path: VpiName='%s', VpiFullName='%s', using='%s'\n",
+        log_uhdm_trace("    hier_path: VpiName='%s', VpiFullName='%s', using='%s'\n",
             std::string(name_view).c_str(), std::string(full_name_view).c_str(), path_name.c_str());
 
     // Primary path: fold an interface-port parameter member (`sub.CFG.HSK.DLY`,
@@ -7966,7 +8258,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
     // fragile name/parent-chain search below.
     if (auto fs = fold_iface_param_via_chain(uhdm_hier); fs.size() > 0) {
         if (mode_debug)
-            log("    hier_path: %s -> %d-bit constant via Actual_group chain\n",
+            log_uhdm_trace("    hier_path: %s -> %d-bit constant via Actual_group chain\n",
                 path_name.c_str(), fs.size());
         return fs;
     }
@@ -8040,17 +8332,17 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
         // the instance-parent chain so the interface connection is reachable.
         for (const UHDM::any* p = current_instance->VpiParent();
              v.empty() && p; p = p->VpiParent()) {
-            if (auto pm = dynamic_cast<const module_inst*>(p)) {
+            if (auto pm = uhdm_cast<UHDM::module_inst>(p)) {
                 v = eval_iface_param_field(uhdm_hier, pm);
                 if (!v.empty())
-                    log("    hier_path: %s -> %s via parent %s interface param\n",
+                    log_uhdm_trace("    hier_path: %s -> %s via parent %s interface param\n",
                         path_name.c_str(), v.c_str(),
                         std::string(pm->VpiName()).c_str());
             }
         }
         if (!v.empty()) {
             int iv = atoi(v.c_str());
-            log("    hier_path: %s -> %d via interface struct parameter\n",
+            log_uhdm_trace("    hier_path: %s -> %d via interface struct parameter\n",
                 path_name.c_str(), iv);
             return RTLIL::SigSpec(RTLIL::Const(iv, 32));
         }
@@ -8061,7 +8353,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
         RTLIL::SigSpec ss = eval_iface_param_struct(uhdm_hier, current_instance);
         if (ss.size() > 0) {
             if (mode_debug)
-                log("    hier_path: %s -> %d-bit interface struct parameter\n",
+                log_uhdm_trace("    hier_path: %s -> %d-bit interface struct parameter\n",
                     path_name.c_str(), ss.size());
             return ss;
         }
@@ -8076,12 +8368,12 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
         // through a parent's port).
         for (const UHDM::any* p = current_instance->VpiParent();
              v.empty() && p; p = p->VpiParent()) {
-            if (auto pm = dynamic_cast<const module_inst*>(p))
+            if (auto pm = uhdm_cast<UHDM::module_inst>(p))
                 v = eval_bare_iface_param_field(uhdm_hier, pm);
         }
         if (!v.empty()) {
             int iv = atoi(v.c_str());
-            log("    hier_path: %s -> %d via bare interface struct parameter\n",
+            log_uhdm_trace("    hier_path: %s -> %d via bare interface struct parameter\n",
                 path_name.c_str(), iv);
             return RTLIL::SigSpec(RTLIL::Const(iv, 32));
         }
@@ -8098,7 +8390,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
         std::string v = eval_param_struct_field(uhdm_hier, &fw);
         if (!v.empty()) {
             int iv = atoi(v.c_str());
-            log("    hier_path: %s -> %d via struct parameter field (w=%d)\n",
+            log_uhdm_trace("    hier_path: %s -> %d via struct parameter field (w=%d)\n",
                 path_name.c_str(), iv, fw);
             return RTLIL::SigSpec(RTLIL::Const(iv, fw > 0 ? fw : 32));
         }
@@ -8125,7 +8417,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
             if (xchild && !sig.empty()) {
                 if (xchild->wire(RTLIL::escape_id(sig))) {
                     resolve_xmr_read(module, xcell, sig);
-                    log("    XMR read %s.%s: exposed child output port\n",
+                    log_uhdm_trace("    XMR read %s.%s: exposed child output port\n",
                         inst.c_str(), sig.c_str());
                     return RTLIL::SigSpec(module->wire(RTLIL::escape_id(inst + "." + sig)));
                 }
@@ -8151,7 +8443,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                 std::string pn = inst + "." + sig;
                 RTLIL::Wire* pw = module->wire(RTLIL::escape_id(pn));
                 if (!pw) pw = module->addWire(RTLIL::escape_id(pn), xw);
-                log("    XMR read %s.%s: deferred (cell not yet created, width=%d)\n",
+                log_uhdm_trace("    XMR read %s.%s: deferred (cell not yet created, width=%d)\n",
                     inst.c_str(), sig.c_str(), xw);
                 return RTLIL::SigSpec(pw);
             }
@@ -8173,7 +8465,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
             const UHDM::function* fdef = mfc->Function();
             // Fall back: walk the current module's Task_funcs by name.
             if (!fdef && current_instance) {
-                if (auto mod = dynamic_cast<const UHDM::module_inst*>(current_instance)) {
+                if (auto mod = uhdm_cast<UHDM::module_inst>(current_instance)) {
                     if (mod->Task_funcs()) {
                         for (auto tf : *mod->Task_funcs()) {
                             if (tf->UhdmType() == uhdmfunction &&
@@ -8208,7 +8500,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                     if (width <= 0) width = 32;
                     auto ec = (func_name == "first") ? consts.front() : consts.back();
                     int64_t v = parse_vpi_value_to_int(std::string(ec->VpiValue()));
-                    log("    enum method %s.%s() -> %lld (%d-bit)\n",
+                    log_uhdm_trace("    enum method %s.%s() -> %lld (%d-bit)\n",
                         std::string(base_elem->VpiName()).c_str(), func_name.c_str(),
                         (long long)v, width);
                     return RTLIL::SigSpec(RTLIL::Const(v, width));
@@ -8240,7 +8532,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                         evaluate_function_call(fdef, const_args, output_params);
                     const_eval_module_writes.clear();
                     if (mode_debug)
-                        log("    hier_path func call %s → compile-time const\n",
+                        log_uhdm_trace("    hier_path func call %s → compile-time const\n",
                             func_name.c_str());
                     return RTLIL::SigSpec(result);
                 }
@@ -8349,12 +8641,12 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                     // silently instead of falling through to the "Could not
                     // resolve struct member" warning.
                     if (ok && field_w == 0 && off <= base_sig.size()) {
-                        log("    hier_path: interface signal struct member %s.* -> zero-width field\n",
+                        log_uhdm_trace("    hier_path: interface signal struct member %s.* -> zero-width field\n",
                             wname.c_str());
                         return RTLIL::SigSpec();
                     }
                     if (ok && field_w > 0 && off + field_w <= base_sig.size()) {
-                        log("    hier_path: interface signal struct member %s.* -> [%d+:%d]\n",
+                        log_uhdm_trace("    hier_path: interface signal struct member %s.* -> [%d+:%d]\n",
                             wname.c_str(), off, field_w);
                         return base_sig.extract(off, field_w);
                     }
@@ -8561,7 +8853,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                 }
                 if (found && field_w > 0 &&
                     field_off + field_w <= base_sig.size()) {
-                    log("    hier_path: union+struct %s.%s.%s -> [%d+:%d]\n",
+                    log_uhdm_trace("    hier_path: union+struct %s.%s.%s -> [%d+:%d]\n",
                         base_name.c_str(), union_member.c_str(),
                         field_name.c_str(), field_off, field_w);
                     return base_sig.extract(field_off, field_w);
@@ -8647,7 +8939,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                     }
                     int total = member_off + idx * elem_w + field_off;
                     if (found_field && field_w > 0 && total + field_w <= base_wire->width) {
-                        log("    hier_path: %s.%s[%d].%s -> %s[%d+:%d]\n",
+                        log_uhdm_trace("    hier_path: %s.%s[%d].%s -> %s[%d+:%d]\n",
                             base_name.c_str(), member_name.c_str(), idx,
                             field_name.c_str(), base_wire->name.c_str(), total, field_w);
                         return RTLIL::SigSpec(base_wire).extract(total, field_w);
@@ -8685,7 +8977,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                 RTLIL::Wire* w = name_map.count(wname) ? name_map[wname]
                     : module->wire(RTLIL::escape_id(wname));
                 if (w) {
-                    log("    hier_path: interface-array element field %s -> wire %s\n",
+                    log_uhdm_trace("    hier_path: interface-array element field %s -> wire %s\n",
                         wname.c_str(), w->name.c_str());
                     return RTLIL::SigSpec(w);
                 }
@@ -8741,7 +9033,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                     for (auto& pr : wire_map) {
                         if (pr.second != w) continue;
                         const UHDM::ref_typespec* rt = nullptr;
-                        if (auto ln = dynamic_cast<const UHDM::logic_net*>(pr.first)) rt = ln->Typespec();
+                        if (auto ln = uhdm_cast<UHDM::logic_net>(pr.first)) rt = ln->Typespec();
                         else if (auto no = dynamic_cast<const UHDM::net*>(pr.first)) rt = no->Typespec();
                         if (rt) ts = rt->Actual_typespec();
                         break;
@@ -8751,7 +9043,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                     int off = 0, mw = 0;
                     if (calculate_struct_member_offset(ts, field, inst, off, mw)) {
                         if (off + mw <= w->width) {
-                            log("    hier_path: iface-array struct field %s.%s -> \\%s[%d +: %d]\n",
+                            log_uhdm_trace("    hier_path: iface-array struct field %s.%s -> \\%s[%d +: %d]\n",
                                 wname.c_str(), field.c_str(), wname.c_str(), off, mw);
                             return RTLIL::SigSpec(w, off, mw);
                         }
@@ -8803,7 +9095,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                     if (idx_sig.is_fully_const()) {
                         int idx = idx_sig.as_const().as_int();
                         if (idx >= 0 && idx < sig_wire->width) {
-                            log("    hier_path: %s[%d] → \\%s[%d]\n",
+                            log_uhdm_trace("    hier_path: %s[%d] → \\%s[%d]\n",
                                 full.c_str(), idx, full.c_str(), idx);
                             return RTLIL::SigSpec(sig_wire).extract(idx, 1);
                         }
@@ -8820,7 +9112,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                         int lo = std::min(l, r);
                         int w  = std::abs(l - r) + 1;
                         if (lo >= 0 && lo + w <= sig_wire->width) {
-                            log("    hier_path: %s[%d:%d] → \\%s[%d+:%d]\n",
+                            log_uhdm_trace("    hier_path: %s[%d:%d] → \\%s[%d+:%d]\n",
                                 full.c_str(), l, r, full.c_str(), lo, w);
                             return RTLIL::SigSpec(sig_wire).extract(lo, w);
                         }
@@ -8867,7 +9159,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
             // type by name from the module's Nets/Variables (rp32 r5p_lsu's
             // `dec` port + interface tcb port).
             if (!rts) {
-                auto mi = dynamic_cast<const UHDM::module_inst*>(current_instance);
+                auto mi = uhdm_cast<UHDM::module_inst>(current_instance);
                 if (mi) {
                     if (mi->Variables())
                         for (auto v : *mi->Variables())
@@ -8921,15 +9213,15 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                             const UHDM::VectorOfrange* mranges = nullptr;
                             const UHDM::ref_typespec* elem_rts = nullptr;
                             if (mat) {
-                                if (auto lt = dynamic_cast<const UHDM::logic_typespec*>(mat)) {
+                                if (auto lt = uhdm_cast<UHDM::logic_typespec>(mat)) {
                                     mranges = lt->Ranges();
                                     elem_rts = lt->Elem_typespec();
                                 } else if (auto bt = dynamic_cast<const UHDM::bit_typespec*>(mat)) {
                                     mranges = bt->Ranges();
-                                } else if (auto pt = dynamic_cast<const UHDM::packed_array_typespec*>(mat)) {
+                                } else if (auto pt = uhdm_cast<UHDM::packed_array_typespec>(mat)) {
                                     mranges = pt->Ranges();
                                     elem_rts = pt->Elem_typespec();
-                                } else if (auto at = dynamic_cast<const UHDM::array_typespec*>(mat)) {
+                                } else if (auto at = uhdm_cast<UHDM::array_typespec>(mat)) {
                                     // Unpacked array member inside a packed
                                     // struct (`bit [7:0] a [7:0]`) — Yosys
                                     // packs it, indexed like a packed dim.
@@ -8977,7 +9269,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                     int sw = cnt * elem_w;
                     if (bit_lo >= 0 && bit_lo + sw <= w &&
                         off + bit_lo + sw <= base_wire->width) {
-                        log("    hier_path: packed-struct %s.%s[%d:%d] (elem_w=%d) -> %s[%d+:%d]\n",
+                        log_uhdm_trace("    hier_path: packed-struct %s.%s[%d:%d] (elem_w=%d) -> %s[%d+:%d]\n",
                             base.c_str(), field.c_str(), l, r, elem_w,
                             base_wire->name.c_str(), off + bit_lo, sw);
                         return RTLIL::SigSpec(base_wire).extract(off + bit_lo, sw);
@@ -9007,7 +9299,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                 std::string full = base + "." + field;
                 auto it = name_map.find(full);
                 if (it != name_map.end()) {
-                    log("    hier_path: resolved %s → %s via name_map\n",
+                    log_uhdm_trace("    hier_path: resolved %s → %s via name_map\n",
                         full.c_str(), it->second->name.c_str());
                     return RTLIL::SigSpec(it->second);
                 }
@@ -9032,10 +9324,11 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                         if (module && module->parameter_default_values.count(pid))
                             pval = RTLIL::SigSpec(module->parameter_default_values.at(pid));
                         // Package parameter (`some_package::LovingHome.bunn1_t`):
-                        // its resolved value lives in package_parameter_map keyed
+                        // its value is folded by package_parameter(), keyed
                         // by the fully-qualified `pkg::name` (UnionParameter).
-                        if (pval.empty() && package_parameter_map.count(base))
-                            pval = RTLIL::SigSpec(package_parameter_map.at(base));
+                        if (pval.empty())
+                            if (const RTLIL::Const* pkg_val = package_parameter(base))
+                                pval = RTLIL::SigSpec(*pkg_val);
                         if (pval.empty()) {
                             std::string vs = std::string(param->VpiValue());
                             if (!vs.empty())
@@ -9055,7 +9348,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                             int off = 0, w = 0;
                             if (calculate_struct_member_offset(ats, field, inst, off, w) &&
                                 w > 0 && off + w <= pval.size()) {
-                                log("    hier_path: struct param %s.%s -> [%d+:%d]\n",
+                                log_uhdm_trace("    hier_path: struct param %s.%s -> [%d+:%d]\n",
                                     base.c_str(), field.c_str(), off, w);
                                 return pval.extract(off, w);
                             }
@@ -9084,7 +9377,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                             int off = 0, w = 0;
                             if (calculate_struct_member_offset(ats, field, inst, off, w) &&
                                 w > 0 && off + w <= base_wire->width) {
-                                log("    hier_path: packed-struct %s → %s[%d+:%d]\n",
+                                log_uhdm_trace("    hier_path: packed-struct %s → %s[%d+:%d]\n",
                                     full.c_str(), base_wire->name.c_str(), off, w);
                                 return RTLIL::SigSpec(base_wire).extract(off, w);
                             }
@@ -9124,20 +9417,16 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                                 iface_name = iface_name.substr(1);
                         }
                     }
-                    if (!iface_name.empty()) {
-                        for (auto ii : *uhdm_design->AllInterfaces()) {
-                            std::string n = std::string(ii->VpiDefName());
-                            if (n.substr(0, 5) == "work@") n = n.substr(5);
-                            if (n == iface_name) { iface = ii; break; }
-                        }
-                    }
+                    auto def = interface_definitions.find(iface_name);
+                    if (def != interface_definitions.end())
+                        iface = def->second;
                 }
                 if (iface) {
                     // Search Parameters() by name.
                     if (iface->Parameters()) {
                         for (auto p : *iface->Parameters()) {
                             if (std::string(p->VpiName()) != field) continue;
-                            auto par = dynamic_cast<const UHDM::parameter*>(p);
+                            auto par = uhdm_cast<UHDM::parameter>(p);
                             if (!par) break;
                             // Prefer explicit override from Param_assigns
                             // (the elaborated value).
@@ -9151,7 +9440,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                                     if (auto re = dynamic_cast<const UHDM::expr*>(pa->Rhs())) {
                                         RTLIL::SigSpec s = import_expression(re);
                                         if (s.is_fully_const()) {
-                                            log("    hier_path: resolved %s → param value %d via interface\n",
+                                            log_uhdm_trace("    hier_path: resolved %s → param value %d via interface\n",
                                                 full.c_str(), s.as_const().as_int());
                                             // Mark module dynports so
                                             // the hierarchy pass re-
@@ -9170,7 +9459,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                             if (!v.empty()) {
                                 RTLIL::Const c = extract_const_from_value(v);
                                 if (c.size() > 0) {
-                                    log("    hier_path: resolved %s → param default %d via interface\n",
+                                    log_uhdm_trace("    hier_path: resolved %s → param default %d via interface\n",
                                         full.c_str(), c.as_int());
                                     module->set_bool_attribute(ID::dynports);
                                     return RTLIL::SigSpec(c);
@@ -9223,7 +9512,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                          peN[nsel]->UhdmType() == uhdmbit_select ||
                          peN[nsel]->UhdmType() == uhdmvar_select));
         if (mode_debug)
-            log("    Nidx probe: nsel=%zu total=%zu tail_ok=%d run_base='%s'\n",
+            log_uhdm_trace("    Nidx probe: nsel=%zu total=%zu tail_ok=%d run_base='%s'\n",
                 nsel, peN.size(), tail_ok ? 1 : 0, run_base.c_str());
         if (nsel >= 1 && tail_ok) {
             const bit_select* bs0 = any_cast<const bit_select*>(peN[0]);
@@ -9255,7 +9544,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                 flat_struct_array_geom(base_name, bs0->Actual_group(), inst,
                                        dims, &st, &elem_w);
             if (mode_debug)
-                log("    Nidx probe2: base_flat=%d geom=%d dims=%zu elem_w=%d\n",
+                log_uhdm_trace("    Nidx probe2: base_flat=%d geom=%d dims=%zu elem_w=%d\n",
                     base_flat ? 1 : 0, geom_ok ? 1 : 0, dims.size(), elem_w);
             if (geom_ok && nsel <= dims.size() && elem_w > 0) {
                 // Import the index expressions; note whether ANY is dynamic
@@ -9518,7 +9807,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                     sx->setPort(ID::B, acc);
                     sx->setPort(ID::Y, out);
                     add_src_attribute(sx->attributes, uhdm_hier);
-                    log("    hier_path: dynamic %s[%zu dims] -> shiftx (w=%d)\n",
+                    log_uhdm_trace("    hier_path: dynamic %s[%zu dims] -> shiftx (w=%d)\n",
                         base_name.c_str(), nsel, field_width);
                     return RTLIL::SigSpec(out);
                 }
@@ -9539,7 +9828,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                         off += (iv - dims[k].second) * strides[k];
                     }
                     if (in_range && off >= 0 && off + field_width <= base_flat->width) {
-                        log("    hier_path: const multi-index %s -> [%d+:%d]\n",
+                        log_uhdm_trace("    hier_path: const multi-index %s -> [%d+:%d]\n",
                             base_name.c_str(), off, field_width);
                         return RTLIL::SigSpec(base_flat).extract(off, field_width);
                     }
@@ -9549,22 +9838,22 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
     }
 
     if (uhdm_hier->Path_elems()) {
-        log("    hier_path has %d path elements\n", (int)uhdm_hier->Path_elems()->size());
+        log_uhdm_trace("    hier_path has %d path elements\n", (int)uhdm_hier->Path_elems()->size());
         
         // Look through all path elements to find one with a resolved full name
         // Sometimes the resolution is in the Actual() of the ref_obj
         for (auto elem : *uhdm_hier->Path_elems()) {
-            log("      Path elem type: %s\n", UHDM::UhdmName(elem->UhdmType()).c_str());
+            log_uhdm_trace("      Path elem type: %s\n", UHDM::UhdmName(elem->UhdmType()).c_str());
             
             if (elem->UhdmType() == uhdmref_obj) {
                 const ref_obj* ref = any_cast<const ref_obj*>(elem);
-                log("        ref_obj: name=%s, full_name=%s\n", 
+                log_uhdm_trace("        ref_obj: name=%s, full_name=%s\n", 
                     std::string(ref->VpiName()).c_str(), std::string(ref->VpiFullName()).c_str());
                 
                 // Check if this ref_obj has an Actual_group() pointing to the real signal
                 if (ref->Actual_group()) {
                     const any* actual = ref->Actual_group();
-                    log("        ref_obj has Actual_group of type %s\n", UHDM::UhdmName(actual->UhdmType()).c_str());
+                    log_uhdm_trace("        ref_obj has Actual_group of type %s\n", UHDM::UhdmName(actual->UhdmType()).c_str());
 
                     // Extract full name from the actual object (works for logic_net, integer_var, logic_var)
                     std::string_view actual_full_name;
@@ -9578,14 +9867,14 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
 
                     if (!actual_full_name.empty()) {
                         std::string full_str = std::string(actual_full_name);
-                        log("          Actual full name: %s\n", full_str.c_str());
+                        log_uhdm_trace("          Actual full name: %s\n", full_str.c_str());
                         // Extract module-relative path (remove work@module_name. prefix)
                         size_t module_end = full_str.find('.');
                         if (module_end != std::string::npos) {
                             std::string signal_path = full_str.substr(module_end + 1);
-                            log("          Extracted signal path: %s\n", signal_path.c_str());
+                            log_uhdm_trace("          Extracted signal path: %s\n", signal_path.c_str());
                             if (name_map.count(signal_path)) {
-                                log("          Found in name_map, resolving to: %s\n", name_map[signal_path]->name.c_str());
+                                log_uhdm_trace("          Found in name_map, resolving to: %s\n", name_map[signal_path]->name.c_str());
                                 return RTLIL::SigSpec(name_map[signal_path]);
                             } else if (!name_map.count(path_name)) {
                                 // Wire not yet created and hier_path name also absent —
@@ -9594,7 +9883,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                                 RTLIL::Wire* w = create_wire(signal_path, width);
                                 wire_map[actual] = w;
                                 name_map[signal_path] = w;
-                                log("          Created forward-ref wire '%s' (width=%d)\n", signal_path.c_str(), width);
+                                log_uhdm_trace("          Created forward-ref wire '%s' (width=%d)\n", signal_path.c_str(), width);
                                 return RTLIL::SigSpec(w);
                             }
                             // path_name is already in name_map (e.g., interface port "bus.a"):
@@ -9617,10 +9906,10 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                     if (module_end != std::string::npos) {
                         std::string signal_path = full_str.substr(module_end + 1);
                         if (mode_debug)
-                            log("      ref_obj has VpiFullName: %s -> %s\n", full_str.c_str(), signal_path.c_str());
+                            log_uhdm_trace("      ref_obj has VpiFullName: %s -> %s\n", full_str.c_str(), signal_path.c_str());
                         if (name_map.count(signal_path)) {
                             if (mode_debug)
-                                log("      Found in name_map: %s\n", name_map[signal_path]->name.c_str());
+                                log_uhdm_trace("      Found in name_map: %s\n", name_map[signal_path]->name.c_str());
                             return RTLIL::SigSpec(name_map[signal_path]);
                         }
                     }
@@ -9629,7 +9918,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
         }
     } else {
         if (mode_debug)
-            log("    hier_path has no Path_elems\n");
+            log_uhdm_trace("    hier_path has no Path_elems\n");
     }
 
     // Unpacked-array-of-struct element + SCALAR struct member: `arr[i].field`
@@ -9652,14 +9941,14 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
             // flattened struct-array PORT it is null — fall back to the port/net
             // typespec from the enclosing module instance.
             const UHDM::array_typespec* ats = nullptr;
-            if (auto av = dynamic_cast<const UHDM::array_var*>(bs->Actual_group())) {
+            if (auto av = uhdm_cast<UHDM::array_var>(bs->Actual_group())) {
                 if (av->Typespec())
                     if (auto a0 = av->Typespec()->Actual_typespec())
                         if (a0->UhdmType() == uhdmarray_typespec)
                             ats = any_cast<const UHDM::array_typespec*>(a0);
             }
             if (!ats) {
-                if (auto mi = dynamic_cast<const UHDM::module_inst*>(inst)) {
+                if (auto mi = uhdm_cast<UHDM::module_inst>(inst)) {
                     auto ts_of = [&](const UHDM::ref_typespec* rt) -> const UHDM::array_typespec* {
                         if (rt && rt->Actual_typespec() &&
                             rt->Actual_typespec()->UhdmType() == uhdmarray_typespec)
@@ -9715,7 +10004,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                 if (found && field_w > 0 && elem_w > 0) {
                     int off = (i_idx - outer_low) * elem_w + field_off;
                     if (off >= 0 && off + field_w <= base_wire->width) {
-                        log("    hier_path: %s[%d].%s → %s[%d+:%d]\n",
+                        log_uhdm_trace("    hier_path: %s[%d].%s → %s[%d+:%d]\n",
                             base_name.c_str(), i_idx, field_name.c_str(),
                             base_wire->name.c_str(), off, field_w);
                         return RTLIL::SigSpec(base_wire).extract(off, field_w);
@@ -9834,7 +10123,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                             if (abs_start >= 0 &&
                                 abs_start + elem_f_w <= base_wire->width) {
                                 if (mode_debug)
-                                    log("    Array-of-struct + array-member: "
+                                    log_uhdm_trace("    Array-of-struct + array-member: "
                                         "%s[%d].%s[%d] -> %s[%d+:%d]\n",
                                         base_name.c_str(), i_idx,
                                         field_name.c_str(), j_idx,
@@ -9893,7 +10182,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                 }
                 if (pav->Elements() && !pav->Elements()->empty()) {
                     const any* elem0 = (*pav->Elements())[0];
-                    if (auto sv = dynamic_cast<const UHDM::struct_var*>(elem0)) {
+                    if (auto sv = uhdm_cast<UHDM::struct_var>(elem0)) {
                         if (auto rts = sv->Typespec()) {
                             if (auto ats = rts->Actual_typespec()) {
                                 if (ats->UhdmType() == uhdmstruct_typespec)
@@ -9948,7 +10237,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                         if (abs_start >= 0 &&
                             abs_start + field_width <= base_wire->width) {
                             if (mode_debug)
-                                log("    Multi-dim array struct field: %s[lin=%lld]"
+                                log_uhdm_trace("    Multi-dim array struct field: %s[lin=%lld]"
                                     ".%s -> %s[%d+:%d]\n",
                                     base_name.c_str(), (long long)lin_idx,
                                     field_name.c_str(),
@@ -10000,7 +10289,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                         if (base_flat_wire) {
                             for (auto& kv : wire_map) {
                                 if (kv.second != base_flat_wire) continue;
-                                if (auto sn = dynamic_cast<const UHDM::struct_net*>(kv.first))
+                                if (auto sn = uhdm_cast<UHDM::struct_net>(kv.first))
                                     if (auto rts = sn->Typespec())
                                         if (auto ats = rts->Actual_typespec())
                                             if (ats->UhdmType() == uhdmstruct_typespec)
@@ -10012,9 +10301,9 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                         // PACKED array of structs (packed_array_var): the element
                         // type is the first struct_var in Elements().
                         // ExpressionInIndex: `sram_otp_key_o[0].nonce`.
-                        if (auto pav = dynamic_cast<const UHDM::packed_array_var*>(bs->Actual_group())) {
+                        if (auto pav = uhdm_cast<UHDM::packed_array_var>(bs->Actual_group())) {
                             if (pav->Elements() && !pav->Elements()->empty())
-                                if (auto sv = dynamic_cast<const UHDM::struct_var*>(pav->Elements()->at(0)))
+                                if (auto sv = uhdm_cast<UHDM::struct_var>(pav->Elements()->at(0)))
                                     if (auto rts = sv->Typespec())
                                         if (auto ats = rts->Actual_typespec())
                                             if (ats->UhdmType() == uhdmstruct_typespec)
@@ -10036,7 +10325,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                         // wire — resolve the struct via array_typespec Elem_typespec
                         // (TypedefVariableDimensions).
                         if (!st)
-                            if (auto av = dynamic_cast<const UHDM::array_var*>(bs->Actual_group()))
+                            if (auto av = uhdm_cast<UHDM::array_var>(bs->Actual_group()))
                                 if (av->Typespec())
                                     if (auto ats = av->Typespec()->Actual_typespec())
                                         if (ats->UhdmType() == uhdmarray_typespec)
@@ -10124,13 +10413,13 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                     const VectorOfrange* arr_ranges = nullptr;
                     const UHDM::struct_typespec* st = nullptr;
                     if (base_uhdm) {
-                        if (auto pav = dynamic_cast<const UHDM::packed_array_var*>(base_uhdm)) {
+                        if (auto pav = uhdm_cast<UHDM::packed_array_var>(base_uhdm)) {
                             arr_ranges = pav->Ranges();
                             // Get element struct type from first element (a struct_var)
                             if (pav->Elements() && !pav->Elements()->empty()) {
                                 const any* elem0 = (*pav->Elements())[0];
                                 const ref_typespec* elem_rts = nullptr;
-                                if (auto sv = dynamic_cast<const UHDM::struct_var*>(elem0))
+                                if (auto sv = uhdm_cast<UHDM::struct_var>(elem0))
                                     elem_rts = sv->Typespec();
                                 if (elem_rts) {
                                     const typespec* ets = elem_rts->Actual_typespec();
@@ -10138,7 +10427,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                                         st = any_cast<const UHDM::struct_typespec*>(ets);
                                 }
                             }
-                        } else if (auto ln = dynamic_cast<const UHDM::logic_net*>(base_uhdm)) {
+                        } else if (auto ln = uhdm_cast<UHDM::logic_net>(base_uhdm)) {
                             const ref_typespec* rts = ln->Typespec();
                             if (rts) {
                                 const typespec* ts = rts->Actual_typespec();
@@ -10203,7 +10492,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                                 int abs_start = elem_offset + field_offset + ps_right;
                                 int abs_len   = ps_left - ps_right + 1;
                                 if (mode_debug)
-                                    log("    Packed array struct: %s[%d].%s[%d:%d] → wire[%d+:%d]\n",
+                                    log_uhdm_trace("    Packed array struct: %s[%d].%s[%d:%d] → wire[%d+:%d]\n",
                                         base_name.c_str(), elem_idx, field_name.c_str(),
                                         ps_left, ps_right, abs_start, abs_len);
                                 if (abs_start >= 0 && abs_start + abs_len <= base_wire->width)
@@ -10295,9 +10584,9 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                     bool found_field = true;  // default to whole-wire fallback
                     if (elem_wire && bs->Actual_group()) {
                         const UHDM::struct_typespec* st = nullptr;
-                        if (auto av = dynamic_cast<const UHDM::array_var*>(bs->Actual_group())) {
+                        if (auto av = uhdm_cast<UHDM::array_var>(bs->Actual_group())) {
                             if (av->Variables() && !av->Variables()->empty()) {
-                                if (auto sv = dynamic_cast<const UHDM::struct_var*>(av->Variables()->at(0))) {
+                                if (auto sv = uhdm_cast<UHDM::struct_var>(av->Variables()->at(0))) {
                                     if (auto rts = sv->Typespec())
                                         if (auto ats = rts->Actual_typespec())
                                             if (ats->UhdmType() == uhdmstruct_typespec)
@@ -10345,7 +10634,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                                     ? base_val : base_val - width + 1;
                                 if (lsb >= 0 && lsb + width <= field_slice.size()) {
                                     if (mode_debug)
-                                        log("    Unpacked-array indexed-part-select: %s[%d].%s[%d%s%d] → wire[%d+:%d]\n",
+                                        log_uhdm_trace("    Unpacked-array indexed-part-select: %s[%d].%s[%d%s%d] → wire[%d+:%d]\n",
                                             base_name.c_str(), elem_idx,
                                             field_name.c_str(), base_val,
                                             type == vpiPosIndexed ? "+:" : "-:",
@@ -10426,15 +10715,15 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                 for (auto& kv : wire_map) {
                     if (kv.second != base_wire) continue;
                     const ref_typespec* rts = nullptr;
-                    if (auto ln = dynamic_cast<const UHDM::logic_net*>(kv.first))
+                    if (auto ln = uhdm_cast<UHDM::logic_net>(kv.first))
                         rts = ln->Typespec();
-                    else if (auto lv = dynamic_cast<const UHDM::logic_var*>(kv.first))
+                    else if (auto lv = uhdm_cast<UHDM::logic_var>(kv.first))
                         rts = lv->Typespec();
-                    else if (auto sv = dynamic_cast<const UHDM::struct_var*>(kv.first))
+                    else if (auto sv = uhdm_cast<UHDM::struct_var>(kv.first))
                         rts = sv->Typespec();
-                    else if (auto sn = dynamic_cast<const UHDM::struct_net*>(kv.first))
+                    else if (auto sn = uhdm_cast<UHDM::struct_net>(kv.first))
                         rts = sn->Typespec();
-                    else if (auto po = dynamic_cast<const UHDM::port*>(kv.first))
+                    else if (auto po = uhdm_cast<UHDM::port>(kv.first))
                         rts = po->Typespec();
                     if (rts) {
                         if (auto ats = rts->Actual_typespec()) {
@@ -10500,19 +10789,19 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                 const UHDM::VectorOfrange* field_ranges = nullptr;
                 const UHDM::ref_typespec* field_elem_rts = nullptr;
                 if (found_field && field_ts_actual) {
-                    if (auto lt = dynamic_cast<const UHDM::logic_typespec*>(field_ts_actual)) {
+                    if (auto lt = uhdm_cast<UHDM::logic_typespec>(field_ts_actual)) {
                         field_ranges = lt->Ranges();
                         field_elem_rts = lt->Elem_typespec();
                     } else if (auto bt = dynamic_cast<const UHDM::bit_typespec*>(field_ts_actual)) {
                         field_ranges = bt->Ranges();
-                    } else if (auto at = dynamic_cast<const UHDM::array_typespec*>(field_ts_actual)) {
+                    } else if (auto at = uhdm_cast<UHDM::array_typespec>(field_ts_actual)) {
                         // Unpacked array nested in a packed struct (Yosys
                         // extension): array_typespec carries the unpacked
                         // dimension(s) in Ranges() and the per-element
                         // typespec (e.g., bit [7:0]) in Elem_typespec.
                         field_ranges = at->Ranges();
                         field_elem_rts = at->Elem_typespec();
-                    } else if (auto pat = dynamic_cast<const UHDM::packed_array_typespec*>(field_ts_actual)) {
+                    } else if (auto pat = uhdm_cast<UHDM::packed_array_typespec>(field_ts_actual)) {
                         // Typedef'd packed array field (e.g., `bit8_t [5:0] a`
                         // where `typedef bit [7:0] bit8_t`).  PR 5's Surelog
                         // fix wraps the typedef in a packed_array_typespec
@@ -10578,7 +10867,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                             if (abs_start >= 0 &&
                                 abs_start + elem_width <= base_wire->width) {
                                 if (mode_debug)
-                                    log("    Struct field bit-select: %s.%s[%d] → "
+                                    log_uhdm_trace("    Struct field bit-select: %s.%s[%d] → "
                                         "%s[%d+:%d]\n",
                                         base_name.c_str(), field_name.c_str(), idx,
                                         base_wire->name.c_str(), abs_start, elem_width);
@@ -10624,7 +10913,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                                               RTLIL::SigSpec(shift_w),
                                               RTLIL::SigSpec(result_w), true);
                             if (mode_debug)
-                                log("    Struct field dynamic bit-select: %s.%s[<dyn>] → "
+                                log_uhdm_trace("    Struct field dynamic bit-select: %s.%s[<dyn>] → "
                                     "$shiftx(%s[%d+:%d])\n",
                                     base_name.c_str(), field_name.c_str(),
                                     base_wire->name.c_str(),
@@ -10702,7 +10991,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                             if (ok && abs_start >= 0 &&
                                 abs_start + slice_width <= base_wire->width) {
                                 if (mode_debug)
-                                    log("    Struct field var-select: %s.%s[...] → "
+                                    log_uhdm_trace("    Struct field var-select: %s.%s[...] → "
                                         "%s[%d+:%d]\n",
                                         base_name.c_str(), field_name.c_str(),
                                         base_wire->name.c_str(), abs_start, slice_width);
@@ -10725,7 +11014,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                             if (abs_start >= 0 &&
                                 abs_start + abs_len <= base_wire->width) {
                                 if (mode_debug)
-                                    log("    Struct field part-select: %s.%s[%d:%d] → "
+                                    log_uhdm_trace("    Struct field part-select: %s.%s[%d:%d] → "
                                         "%s[%d+:%d]\n",
                                         base_name.c_str(), field_name.c_str(),
                                         ps_left, ps_right,
@@ -10777,10 +11066,10 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                 for (auto& kv : wire_map) {
                     if (kv.second != base_wire) continue;
                     const ref_typespec* rts = nullptr;
-                    if (auto ln = dynamic_cast<const UHDM::logic_net*>(kv.first))    rts = ln->Typespec();
-                    else if (auto lv = dynamic_cast<const UHDM::logic_var*>(kv.first))   rts = lv->Typespec();
-                    else if (auto sv = dynamic_cast<const UHDM::struct_var*>(kv.first))  rts = sv->Typespec();
-                    else if (auto sn = dynamic_cast<const UHDM::struct_net*>(kv.first))  rts = sn->Typespec();
+                    if (auto ln = uhdm_cast<UHDM::logic_net>(kv.first))    rts = ln->Typespec();
+                    else if (auto lv = uhdm_cast<UHDM::logic_var>(kv.first))   rts = lv->Typespec();
+                    else if (auto sv = uhdm_cast<UHDM::struct_var>(kv.first))  rts = sv->Typespec();
+                    else if (auto sn = uhdm_cast<UHDM::struct_net>(kv.first))  rts = sn->Typespec();
                     if (rts) {
                         if (auto ats = rts->Actual_typespec()) {
                             if (ats->UhdmType() == uhdmstruct_typespec)
@@ -10827,15 +11116,15 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                     while (cur) {
                         const UHDM::VectorOfrange* r = nullptr;
                         const UHDM::ref_typespec* next_rts = nullptr;
-                        if (auto lt = dynamic_cast<const UHDM::logic_typespec*>(cur)) {
+                        if (auto lt = uhdm_cast<UHDM::logic_typespec>(cur)) {
                             r = lt->Ranges();
                             next_rts = lt->Elem_typespec();
                         } else if (auto bt = dynamic_cast<const UHDM::bit_typespec*>(cur)) {
                             r = bt->Ranges();
-                        } else if (auto at = dynamic_cast<const UHDM::array_typespec*>(cur)) {
+                        } else if (auto at = uhdm_cast<UHDM::array_typespec>(cur)) {
                             r = at->Ranges();
                             next_rts = at->Elem_typespec();
-                        } else if (auto pat = dynamic_cast<const UHDM::packed_array_typespec*>(cur)) {
+                        } else if (auto pat = uhdm_cast<UHDM::packed_array_typespec>(cur)) {
                             r = pat->Ranges();
                             next_rts = pat->Elem_typespec();
                         }
@@ -10848,7 +11137,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                             // Keep field_elem_rts for the part-select element
                             // range fallback even when there is no chain.
                             if (cur == field_ts) {
-                                if (auto lt = dynamic_cast<const UHDM::logic_typespec*>(cur))
+                                if (auto lt = uhdm_cast<UHDM::logic_typespec>(cur))
                                     field_elem_rts = lt->Elem_typespec();
                             }
                             break;
@@ -10896,7 +11185,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                             field_elem_rts->Actual_typespec()) {
                             auto et = field_elem_rts->Actual_typespec();
                             const UHDM::VectorOfrange* erngs = nullptr;
-                            if (auto elt = dynamic_cast<const UHDM::logic_typespec*>(et)) erngs = elt->Ranges();
+                            if (auto elt = uhdm_cast<UHDM::logic_typespec>(et)) erngs = elt->Ranges();
                             else if (auto ebt = dynamic_cast<const UHDM::bit_typespec*>(et)) erngs = ebt->Ranges();
                             if (erngs && !erngs->empty()) elem_range = (*erngs)[0];
                         }
@@ -10922,7 +11211,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                         if (abs_start >= 0 &&
                             abs_start + abs_len <= base_wire->width) {
                             if (mode_debug)
-                                log("    Struct field chained select: %s.%s[...][%d:%d] → "
+                                log_uhdm_trace("    Struct field chained select: %s.%s[...][%d:%d] → "
                                     "%s[%d+:%d]\n",
                                     base_name.c_str(), field_name.c_str(),
                                     ps_left, ps_right,
@@ -10939,7 +11228,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
     // These are already created during generate scope import
     if (name_map.count(path_name)) {
         if (mode_debug)
-            log("    Found wire in name_map: %s\n", name_map[path_name]->name.c_str());
+            log_uhdm_trace("    Found wire in name_map: %s\n", name_map[path_name]->name.c_str());
         return RTLIL::SigSpec(name_map[path_name]);
     }
     
@@ -10951,7 +11240,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
         size_t dot_count = std::count(path_name.begin(), path_name.end(), '.');
         
         if (mode_debug)
-            log("    hier_path has %zu dots\n", dot_count);
+            log_uhdm_trace("    hier_path has %zu dots\n", dot_count);
         
         if (dot_count > 1) {
             // Nested struct member access
@@ -10961,7 +11250,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
             std::string final_member = path_name.substr(last_dot + 1);  // e.g., "data"
             
             if (mode_debug)
-                log("    Detected nested struct member access: base_path='%s', final_member='%s'\n", 
+                log_uhdm_trace("    Detected nested struct member access: base_path='%s', final_member='%s'\n", 
                     base_path.c_str(), final_member.c_str());
             
             // First, find the first-level struct and member
@@ -10970,13 +11259,13 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
             std::string first_member = base_path.substr(first_dot + 1);  // e.g., "base"
             
             if (mode_debug)
-                log("    Looking for struct wire '%s' in name_map\n", struct_name.c_str());
+                log_uhdm_trace("    Looking for struct wire '%s' in name_map\n", struct_name.c_str());
             
             if (name_map.count(struct_name)) {
                 RTLIL::Wire* struct_wire = name_map[struct_name];
                 
                 if (mode_debug)
-                    log("    Found struct wire '%s' with width %d\n", struct_name.c_str(), struct_wire->width);
+                    log_uhdm_trace("    Found struct wire '%s' with width %d\n", struct_name.c_str(), struct_wire->width);
                 
                 // Get UHDM object for the struct
                 const any* struct_uhdm_obj = nullptr;
@@ -10984,7 +11273,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                     if (pair.second == struct_wire) {
                         struct_uhdm_obj = pair.first;
                         if (mode_debug)
-                            log("    Found UHDM object for struct wire (type=%d)\n", struct_uhdm_obj->UhdmType());
+                            log_uhdm_trace("    Found UHDM object for struct wire (type=%d)\n", struct_uhdm_obj->UhdmType());
                         break;
                     }
                 }
@@ -10992,17 +11281,17 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                 if (struct_uhdm_obj) {
                     // Get struct typespec
                     const ref_typespec* struct_ref_typespec = nullptr;
-                    if (auto logic_var = dynamic_cast<const UHDM::logic_var*>(struct_uhdm_obj)) {
+                    if (auto logic_var = uhdm_cast<UHDM::logic_var>(struct_uhdm_obj)) {
                         struct_ref_typespec = logic_var->Typespec();
-                    } else if (auto logic_net = dynamic_cast<const UHDM::logic_net*>(struct_uhdm_obj)) {
+                    } else if (auto logic_net = uhdm_cast<UHDM::logic_net>(struct_uhdm_obj)) {
                         struct_ref_typespec = logic_net->Typespec();
                     } else if (auto net_obj = dynamic_cast<const UHDM::net*>(struct_uhdm_obj)) {
                         struct_ref_typespec = net_obj->Typespec();
-                    } else if (auto port_obj = dynamic_cast<const UHDM::port*>(struct_uhdm_obj)) {
+                    } else if (auto port_obj = uhdm_cast<UHDM::port>(struct_uhdm_obj)) {
                         struct_ref_typespec = port_obj->Typespec();
-                    } else if (auto struct_var_obj = dynamic_cast<const UHDM::struct_var*>(struct_uhdm_obj)) {
+                    } else if (auto struct_var_obj = uhdm_cast<UHDM::struct_var>(struct_uhdm_obj)) {
                         struct_ref_typespec = struct_var_obj->Typespec();
-                    } else if (auto union_var_obj = dynamic_cast<const UHDM::union_var*>(struct_uhdm_obj)) {
+                    } else if (auto union_var_obj = uhdm_cast<UHDM::union_var>(struct_uhdm_obj)) {
                         struct_ref_typespec = union_var_obj->Typespec();
                     }
 
@@ -11021,7 +11310,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                             }
 
                             if (mode_debug)
-                                log("    Found %s typespec\n", is_union ? "union" : "struct");
+                                log_uhdm_trace("    Found %s typespec\n", is_union ? "union" : "struct");
 
                             // Find the first-level member
                             if (members) {
@@ -11095,7 +11384,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
 
                                         if (found_second_member) {
                                             if (mode_debug)
-                                                log("    Found nested member: total_offset=%d, width=%d\n",
+                                                log_uhdm_trace("    Found nested member: total_offset=%d, width=%d\n",
                                                     first_member_offset + second_member_offset, second_member_width);
 
                                             // Return bit slice from the wire
@@ -11110,11 +11399,14 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                     }
                 }
             } else if (mode_debug) {
-                log("    Struct wire '%s' not found in name_map\n", struct_name.c_str());
-                log("    Available wires in name_map:\n");
-                for (auto& pair : name_map) {
-                    log("      %s (width=%d)\n", pair.first.c_str(), pair.second->width);
-                }
+                log_uhdm_trace("    Struct wire '%s' not found in name_map\n", struct_name.c_str());
+                log_uhdm_trace("    Available wires in name_map:\n");
+                std::vector<std::string> names;
+                for (auto& pair : name_map)
+                    names.push_back(pair.first);
+                std::sort(names.begin(), names.end());
+                for (auto& n : names)
+                    log_uhdm_trace("      %s (width=%d)\n", n.c_str(), name_map.at(n)->width);
             }
             
             // If we couldn't resolve it as nested struct member, fall through to create wire
@@ -11124,7 +11416,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
             std::string member_name = path_name.substr(dot_pos + 1);
         
         if (mode_debug)
-            log("    Detected struct member access: base='%s', member='%s'\n", base_name.c_str(), member_name.c_str());
+            log_uhdm_trace("    Detected struct member access: base='%s', member='%s'\n", base_name.c_str(), member_name.c_str());
         
         // Same gen-scope qualification as the resolver below: a struct
         // declared inside a generate block is registered as
@@ -11153,17 +11445,17 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                 const ref_typespec* base_ref_typespec = nullptr;
                 const typespec* base_typespec = nullptr;
                 
-                if (auto logic_var = dynamic_cast<const UHDM::logic_var*>(base_uhdm_obj)) {
+                if (auto logic_var = uhdm_cast<UHDM::logic_var>(base_uhdm_obj)) {
                     base_ref_typespec = logic_var->Typespec();
-                } else if (auto logic_net = dynamic_cast<const UHDM::logic_net*>(base_uhdm_obj)) {
+                } else if (auto logic_net = uhdm_cast<UHDM::logic_net>(base_uhdm_obj)) {
                     base_ref_typespec = logic_net->Typespec();
                 } else if (auto net_obj = dynamic_cast<const UHDM::net*>(base_uhdm_obj)) {
                     base_ref_typespec = net_obj->Typespec();
-                } else if (auto port_obj = dynamic_cast<const UHDM::port*>(base_uhdm_obj)) {
+                } else if (auto port_obj = uhdm_cast<UHDM::port>(base_uhdm_obj)) {
                     base_ref_typespec = port_obj->Typespec();
-                } else if (auto struct_var_obj = dynamic_cast<const UHDM::struct_var*>(base_uhdm_obj)) {
+                } else if (auto struct_var_obj = uhdm_cast<UHDM::struct_var>(base_uhdm_obj)) {
                     base_ref_typespec = struct_var_obj->Typespec();
-                } else if (auto union_var_obj = dynamic_cast<const UHDM::union_var*>(base_uhdm_obj)) {
+                } else if (auto union_var_obj = uhdm_cast<UHDM::union_var>(base_uhdm_obj)) {
                     base_ref_typespec = union_var_obj->Typespec();
                 }
 
@@ -11205,10 +11497,10 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                     base_typespec = base_ref_typespec->Actual_typespec();
                     found_member = find_member_slice(base_typespec, mem_off, mem_w);
                     if (!found_member && mode_debug)
-                        log("    Base wire typespec is not a struct/union (UhdmType=%s)\n",
+                        log_uhdm_trace("    Base wire typespec is not a struct/union (UhdmType=%s)\n",
                             base_typespec ? UhdmName(base_typespec->UhdmType()).c_str() : "null");
                 } else if (mode_debug) {
-                    log("    Base wire has no typespec\n");
+                    log_uhdm_trace("    Base wire has no typespec\n");
                 }
 
                 // `parameter type` port/net: the base's own typespec is the
@@ -11224,7 +11516,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                 // branch_exception_o, decoder instruction_o, mmu icache_areq_o,
                 // wt_dcache_ctrl req_port_o, cvxif drivers, btb_d).
                 if (!found_member) {
-                    if (auto mi = dynamic_cast<const UHDM::module_inst*>(current_instance)) {
+                    if (auto mi = uhdm_cast<UHDM::module_inst>(current_instance)) {
                         if (mi->Parameters()) {
                             for (auto p : *mi->Parameters()) {
                                 auto tp = dynamic_cast<const UHDM::type_parameter*>(p);
@@ -11237,7 +11529,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                                 if (total != base_wire->width) continue;
                                 if (find_member_slice(ats, mem_off, mem_w)) {
                                     if (mode_debug)
-                                        log("    Resolved '%s.%s' via type-parameter %s (bound struct, width %d)\n",
+                                        log_uhdm_trace("    Resolved '%s.%s' via type-parameter %s (bound struct, width %d)\n",
                                             base_name.c_str(), member_name.c_str(),
                                             std::string(tp->VpiName()).c_str(), total);
                                     found_member = true;
@@ -11250,11 +11542,11 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
 
                 if (found_member) {
                     if (mode_debug)
-                        log("    Found packed member: offset=%d, width=%d\n", mem_off, mem_w);
+                        log_uhdm_trace("    Found packed member: offset=%d, width=%d\n", mem_off, mem_w);
                     return RTLIL::SigSpec(base_wire, mem_off, mem_w);
                 }
             } else if (mode_debug) {
-                log("    Could not find UHDM object for base wire '%s'\n", base_name.c_str());
+                log_uhdm_trace("    Could not find UHDM object for base wire '%s'\n", base_name.c_str());
             }
         }
         }  // End of single-level struct member handling
@@ -11339,11 +11631,11 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                         if (ts) break;
                         if (kv.second != base_wire) continue;
                         const ref_typespec* rts = nullptr;
-                        if (auto ln = dynamic_cast<const UHDM::logic_net*>(kv.first))   rts = ln->Typespec();
-                        else if (auto lv = dynamic_cast<const UHDM::logic_var*>(kv.first))  rts = lv->Typespec();
-                        else if (auto sv = dynamic_cast<const UHDM::struct_var*>(kv.first)) rts = sv->Typespec();
-                        else if (auto sn = dynamic_cast<const UHDM::struct_net*>(kv.first)) rts = sn->Typespec();
-                        else if (auto uv = dynamic_cast<const UHDM::union_var*>(kv.first))  rts = uv->Typespec();
+                        if (auto ln = uhdm_cast<UHDM::logic_net>(kv.first))   rts = ln->Typespec();
+                        else if (auto lv = uhdm_cast<UHDM::logic_var>(kv.first))  rts = lv->Typespec();
+                        else if (auto sv = uhdm_cast<UHDM::struct_var>(kv.first)) rts = sv->Typespec();
+                        else if (auto sn = uhdm_cast<UHDM::struct_net>(kv.first)) rts = sn->Typespec();
+                        else if (auto uv = uhdm_cast<UHDM::union_var>(kv.first))  rts = uv->Typespec();
                         if (rts) ts = rts->Actual_typespec();
                         if (ts) break;
                     }
@@ -11353,14 +11645,14 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                         if (!ts) {
                             const any* ag = nullptr;
                             if (auto lr = dynamic_cast<const ref_obj*>(pe[split-1])) ag = lr->Actual_group();
-                            else if (auto bsel = dynamic_cast<const bit_select*>(pe[split-1])) ag = bsel->Actual_group();
+                            else if (auto bsel = uhdm_cast<UHDM::bit_select>(pe[split-1])) ag = bsel->Actual_group();
                             if (ag) {
                                 const ref_typespec* rts = nullptr;
-                                if (auto ln = dynamic_cast<const UHDM::logic_net*>(ag))   rts = ln->Typespec();
-                                else if (auto sn = dynamic_cast<const UHDM::struct_net*>(ag)) rts = sn->Typespec();
-                                else if (auto lv = dynamic_cast<const UHDM::logic_var*>(ag))  rts = lv->Typespec();
-                                else if (auto sv = dynamic_cast<const UHDM::struct_var*>(ag)) rts = sv->Typespec();
-                                else if (auto uv = dynamic_cast<const UHDM::union_var*>(ag))  rts = uv->Typespec();
+                                if (auto ln = uhdm_cast<UHDM::logic_net>(ag))   rts = ln->Typespec();
+                                else if (auto sn = uhdm_cast<UHDM::struct_net>(ag)) rts = sn->Typespec();
+                                else if (auto lv = uhdm_cast<UHDM::logic_var>(ag))  rts = lv->Typespec();
+                                else if (auto sv = uhdm_cast<UHDM::struct_var>(ag)) rts = sv->Typespec();
+                                else if (auto uv = uhdm_cast<UHDM::union_var>(ag))  rts = uv->Typespec();
                                 if (rts) ts = rts->Actual_typespec();
                             }
                         }
@@ -11374,7 +11666,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                     // `sub.req_dly[DLY].siz` / `.ndn` this way.)
                     if (!ts && split >= 2) {
                         const interface_inst* iface = nullptr;
-                        if (auto mi = dynamic_cast<const module_inst*>(inst))
+                        if (auto mi = uhdm_cast<UHDM::module_inst>(inst))
                             if (mi->Ports())
                                 for (auto p : *mi->Ports()) {
                                     if (std::string(p->VpiName()) != names[0]) continue;
@@ -11394,8 +11686,8 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                             for (auto n : *ii->Nets()) {
                                 if (std::string(n->VpiName()) != names[split-1]) continue;
                                 const ref_typespec* rts = nullptr;
-                                if (auto ln = dynamic_cast<const UHDM::logic_net*>(n)) rts = ln->Typespec();
-                                else if (auto sn = dynamic_cast<const UHDM::struct_net*>(n)) rts = sn->Typespec();
+                                if (auto ln = uhdm_cast<UHDM::logic_net>(n)) rts = ln->Typespec();
+                                else if (auto sn = uhdm_cast<UHDM::struct_net>(n)) rts = sn->Typespec();
                                 if (!rts) return nullptr;
                                 const typespec* a = rts->Actual_typespec();
                                 if (a && a->UhdmType() == uhdmarray_typespec)
@@ -11432,9 +11724,9 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                     if (!ts && split >= 1) {
                         auto elem_ts_of = [&](const UHDM::any* obj) -> const typespec* {
                             const UHDM::VectorOfany* pel = nullptr;
-                            if (auto pv = dynamic_cast<const UHDM::packed_array_var*>(obj))
+                            if (auto pv = uhdm_cast<UHDM::packed_array_var>(obj))
                                 pel = pv->Elements();
-                            else if (auto pn = dynamic_cast<const UHDM::packed_array_net*>(obj))
+                            else if (auto pn = uhdm_cast<UHDM::packed_array_net>(obj))
                                 pel = pn->Elements();
                             if (pel && !pel->empty())
                                 if (auto ev = dynamic_cast<const UHDM::expr*>((*pel)[0]))
@@ -11442,7 +11734,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                                         return ev->Typespec()->Actual_typespec();
                             return nullptr;
                         };
-                        if (auto mi2 = dynamic_cast<const UHDM::module_inst*>(
+                        if (auto mi2 = uhdm_cast<UHDM::module_inst>(
                                 current_instance ? (const UHDM::scope*)current_instance : inst)) {
                             if (mi2->Nets())
                                 for (auto n0 : *mi2->Nets())
@@ -11501,15 +11793,15 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                     if (final_field_ts) {
                         const UHDM::VectorOfrange* mranges = nullptr;
                         const UHDM::ref_typespec* elem_rts = nullptr;
-                        if (auto lt = dynamic_cast<const UHDM::logic_typespec*>(final_field_ts)) {
+                        if (auto lt = uhdm_cast<UHDM::logic_typespec>(final_field_ts)) {
                             mranges = lt->Ranges();
                             elem_rts = lt->Elem_typespec();
                         } else if (auto bt = dynamic_cast<const UHDM::bit_typespec*>(final_field_ts)) {
                             mranges = bt->Ranges();
-                        } else if (auto pt = dynamic_cast<const UHDM::packed_array_typespec*>(final_field_ts)) {
+                        } else if (auto pt = uhdm_cast<UHDM::packed_array_typespec>(final_field_ts)) {
                             mranges = pt->Ranges();
                             elem_rts = pt->Elem_typespec();
-                        } else if (auto at = dynamic_cast<const UHDM::array_typespec*>(final_field_ts)) {
+                        } else if (auto at = uhdm_cast<UHDM::array_typespec>(final_field_ts)) {
                             mranges = at->Ranges();
                             elem_rts = at->Elem_typespec();
                         }
@@ -11600,7 +11892,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                         int abs_start = elem_off + field_offset + lsb;
                         if (abs_start >= 0 && abs_start + len <= base_wire->width) {
                             if (mode_debug)
-                                log("    Nested struct-field part-select: %s → "
+                                log_uhdm_trace("    Nested struct-field part-select: %s → "
                                     "%s[%d+:%d]\n", path_name.c_str(),
                                     base_wire->name.c_str(), abs_start, len);
                             return RTLIL::SigSpec(base_wire).extract(abs_start, len);
@@ -11629,7 +11921,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
     
     if (!invalidValue && member) {
         if (mode_debug)
-            log("    decodeHierPath returned member of type: %d\n", member->VpiType());
+            log_uhdm_trace("    decodeHierPath returned member of type: %d\n", member->VpiType());
         
         // Get the typespec from the member
         const ref_typespec* member_ref_typespec = nullptr;
@@ -11640,31 +11932,31 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
             member->UhdmType() == uhdmnet || member->UhdmType() == uhdmport) {
             
             // Cast to appropriate type to access Typespec()
-            if (auto logic_var = dynamic_cast<const UHDM::logic_var*>(member)) {
+            if (auto logic_var = uhdm_cast<UHDM::logic_var>(member)) {
                 member_ref_typespec = logic_var->Typespec();
-            } else if (auto logic_net = dynamic_cast<const UHDM::logic_net*>(member)) {
+            } else if (auto logic_net = uhdm_cast<UHDM::logic_net>(member)) {
                 member_ref_typespec = logic_net->Typespec();
             } else if (auto net_obj = dynamic_cast<const UHDM::net*>(member)) {
                 member_ref_typespec = net_obj->Typespec();
-            } else if (auto port_obj = dynamic_cast<const UHDM::port*>(member)) {
+            } else if (auto port_obj = uhdm_cast<UHDM::port>(member)) {
                 member_ref_typespec = port_obj->Typespec();
             }
             
             if (member_ref_typespec) {
                 if (mode_debug)
-                    log("    Found ref_typespec on member\n");
+                    log_uhdm_trace("    Found ref_typespec on member\n");
                 
                 // Get the actual typespec from ref_typespec
                 member_typespec = member_ref_typespec->Actual_typespec();
                 if (mode_debug && member_typespec)
-                    log("    Got actual typespec from ref_typespec\n");
+                    log_uhdm_trace("    Got actual typespec from ref_typespec\n");
                 
                 // Now use get_width_from_typespec
                 if (member_typespec) {
                     width = get_width_from_typespec(member_typespec, inst);
                     if (width > 0) {
                         if (mode_debug)
-                            log("    get_width_from_typespec returned width=%d\n", width);
+                            log_uhdm_trace("    get_width_from_typespec returned width=%d\n", width);
                     }
                 }
             }
@@ -11676,12 +11968,12 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
             if (member_width > 1) {
                 width = member_width;
                 if (mode_debug)
-                    log("    get_width on member returned width=%d\n", width);
+                    log_uhdm_trace("    get_width on member returned width=%d\n", width);
             }
         }
     } else {
         if (mode_debug)
-            log("    ExprEval::decodeHierPath (MEMBER) returned invalid value or null\n");
+            log_uhdm_trace("    ExprEval::decodeHierPath (MEMBER) returned invalid value or null\n");
         
         // Fallback: try to get width from the hier_path itself
         int hier_width = get_width(uhdm_hier, inst);
@@ -11725,15 +12017,15 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
             const ref_typespec* ref_ts = nullptr;
             if (struct_uhdm_obj) {
                 // Get the typespec
-                if (auto logic_net = dynamic_cast<const UHDM::logic_net*>(struct_uhdm_obj)) {
+                if (auto logic_net = uhdm_cast<UHDM::logic_net>(struct_uhdm_obj)) {
                     ref_ts = logic_net->Typespec();
                 } else if (auto net_obj = dynamic_cast<const UHDM::net*>(struct_uhdm_obj)) {
                     ref_ts = net_obj->Typespec();
-                } else if (auto port_obj = dynamic_cast<const UHDM::port*>(struct_uhdm_obj)) {
+                } else if (auto port_obj = uhdm_cast<UHDM::port>(struct_uhdm_obj)) {
                     ref_ts = port_obj->Typespec();
-                } else if (auto struct_var_obj = dynamic_cast<const UHDM::struct_var*>(struct_uhdm_obj)) {
+                } else if (auto struct_var_obj = uhdm_cast<UHDM::struct_var>(struct_uhdm_obj)) {
                     ref_ts = struct_var_obj->Typespec();
-                } else if (auto union_var_obj = dynamic_cast<const UHDM::union_var*>(struct_uhdm_obj)) {
+                } else if (auto union_var_obj = uhdm_cast<UHDM::union_var>(struct_uhdm_obj)) {
                     ref_ts = union_var_obj->Typespec();
                 }
             }
@@ -11748,9 +12040,9 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                 if (auto r = dynamic_cast<const ref_obj*>((*uhdm_hier->Path_elems())[0]))
                     if (auto ag = r->Actual_group()) {
                         const ref_typespec* rt = nullptr;
-                        if (auto sv = dynamic_cast<const UHDM::struct_var*>(ag)) rt = sv->Typespec();
-                        else if (auto uv = dynamic_cast<const UHDM::union_var*>(ag)) rt = uv->Typespec();
-                        else if (auto lv = dynamic_cast<const UHDM::logic_var*>(ag)) rt = lv->Typespec();
+                        if (auto sv = uhdm_cast<UHDM::struct_var>(ag)) rt = sv->Typespec();
+                        else if (auto uv = uhdm_cast<UHDM::union_var>(ag)) rt = uv->Typespec();
+                        else if (auto lv = uhdm_cast<UHDM::logic_var>(ag)) rt = lv->Typespec();
                         else if (auto n = dynamic_cast<const UHDM::net*>(ag)) rt = n->Typespec();
                         if (rt) ts = rt->Actual_typespec();
                     }
@@ -11766,8 +12058,8 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
             };
             auto struct_var_ts = [](const any* a) -> const typespec* {
                 const ref_typespec* rt = nullptr;
-                if (auto sv = dynamic_cast<const UHDM::struct_var*>(a)) rt = sv->Typespec();
-                else if (auto uv = dynamic_cast<const UHDM::union_var*>(a)) rt = uv->Typespec();
+                if (auto sv = uhdm_cast<UHDM::struct_var>(a)) rt = sv->Typespec();
+                else if (auto uv = uhdm_cast<UHDM::union_var>(a)) rt = uv->Typespec();
                 return rt ? rt->Actual_typespec() : nullptr;
             };
             if (!is_struct_ts(ts) && current_instance) {
@@ -11806,7 +12098,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                 if (!remaining_path.empty() && remaining_path.back() == ']' &&
                     uhdm_hier->Path_elems() &&
                     uhdm_hier->Path_elems()->size() >= 2) {
-                    auto bs = dynamic_cast<const UHDM::bit_select*>(
+                    auto bs = uhdm_cast<UHDM::bit_select>(
                         uhdm_hier->Path_elems()->back());
                     const UHDM::expr* idx = bs ? bs->VpiIndex() : nullptr;
                     size_t ob = remaining_path.find_last_of('[');
@@ -11818,7 +12110,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                                              std::to_string(iv.as_const().as_int()) +
                                              "]";
                             if (mode_debug)
-                                log("    folded member index -> '%s'\n",
+                                log_uhdm_trace("    folded member index -> '%s'\n",
                                     remaining_path.c_str());
                         }
                     }
@@ -11871,7 +12163,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                         }
                     }
                     if (mode_debug)
-                        log("    Calculated struct member '%s' offset=%d, width=%d\n",
+                        log_uhdm_trace("    Calculated struct member '%s' offset=%d, width=%d\n",
                             path_name.c_str(), bit_offset, member_width);
                     if (bit_offset >= 0 && member_width > 0 &&
                         bit_offset + member_width <= struct_wire->width)
@@ -11919,7 +12211,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                             import_constant(any_cast<const constant*>(res));
                         if (cv.is_fully_const() && cv.is_fully_def()) {
                             if (mode_debug)
-                                log("    hier_path '%s' folded to constant %s via ExprEval\n",
+                                log_uhdm_trace("    hier_path '%s' folded to constant %s via ExprEval\n",
                                     path_name.c_str(), cv.as_const().as_string().c_str());
                             return cv;
                         }
@@ -11939,14 +12231,14 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                 const UHDM::parameter* base_param = nullptr;
                 if (uhdm_hier->Path_elems() && !uhdm_hier->Path_elems()->empty())
                     if (auto r0 = dynamic_cast<const ref_obj*>((*uhdm_hier->Path_elems())[0]))
-                        base_param = dynamic_cast<const UHDM::parameter*>(r0->Actual_group());
+                        base_param = uhdm_cast<UHDM::parameter>(r0->Actual_group());
                 size_t dot1 = path_name.find('.');
                 std::string field_name = (dot1 != std::string::npos &&
                                           path_name.find('.', dot1 + 1) == std::string::npos)
                                              ? path_name.substr(dot1 + 1)
                                              : std::string();
                 const UHDM::module_inst* mi =
-                    dynamic_cast<const UHDM::module_inst*>(current_instance);
+                    uhdm_cast<UHDM::module_inst>(current_instance);
                 if (base_param && !field_name.empty() && mi && mi->Param_assigns()) {
                     const UHDM::any* prhs = nullptr;
                     for (auto pa : *mi->Param_assigns())
@@ -11973,7 +12265,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                                 for (auto p2 : *mi->Parameters()) {
                                     auto tp2 = dynamic_cast<const UHDM::type_parameter*>(p2);
                                     if (!tp2 || !tp2->Typespec()) continue;
-                                    auto ats2 = dynamic_cast<const UHDM::struct_typespec*>(
+                                    auto ats2 = uhdm_cast<UHDM::struct_typespec>(
                                         tp2->Typespec()->Actual_typespec());
                                     if (!ats2 || !ats2->Members()) continue;
                                     int i2 = 0;
@@ -12009,7 +12301,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                                             if (width > v.size())
                                                 v.extend_u0(width);
                                             if (mode_debug)
-                                                log("    hier_path '%s' folded via positional pattern member %d\n",
+                                                log_uhdm_trace("    hier_path '%s' folded via positional pattern member %d\n",
                                                     path_name.c_str(), fidx);
                                             return v;
                                         }
@@ -12036,7 +12328,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                                     if (width > 0 && v.size() < width)
                                         v.extend_u0(width);
                                     if (mode_debug)
-                                        log("    hier_path '%s' folded via assignment-pattern member '%s'\n",
+                                        log_uhdm_trace("    hier_path '%s' folded via assignment-pattern member '%s'\n",
                                             path_name.c_str(), field_name.c_str());
                                     return v;
                                 }
@@ -12047,7 +12339,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
                 }
             }
             if (mode_debug)
-                log("    hier_path '%s' is an interface/struct parameter field; "
+                log_uhdm_trace("    hier_path '%s' is an interface/struct parameter field; "
                     "width=%d resolved via typespec (constant, no signal)\n",
                     path_name.c_str(), width);
         } else {
@@ -12059,7 +12351,7 @@ RTLIL::SigSpec UhdmImporter::import_hier_path(const hier_path* uhdm_hier, const
     
     // Create the wire with the determined width
     if (mode_debug)
-        log("    Creating wire '%s' with width=%d\n", path_name.c_str(), width);
+        log_uhdm_trace("    Creating wire '%s' with width=%d\n", path_name.c_str(), width);
     
     RTLIL::Wire* wire = create_wire(path_name, width);
     return RTLIL::SigSpec(wire);
@@ -12154,14 +12446,76 @@ bool UhdmImporter::flat_struct_array_geom(const std::string& base_name,
     // (`[2**CVA6Cfg.BHTHist-1:0]`); with none the member collapses to 1 bit
     // and every write stride is wrong (bht2lvl wrote entry pc*10 instead of
     // pc*40).  Fall back to current_instance like the module lookup above.
-    int ew = get_width_from_typespec(
-        st, inst ? inst : (const UHDM::scope*)current_instance);
+    const UHDM::scope* wscope = inst ? inst : (const UHDM::scope*)current_instance;
+    StructLayout* layout = struct_layout(st, wscope);
+    if (layout && layout->width < 0)
+        layout->width = get_width_from_typespec(st, wscope);
+    int ew = layout ? layout->width : get_width_from_typespec(st, wscope);
     if (ew <= 0) return false;
     if (st_out) *st_out = st;
     if (elem_w_out) *elem_w_out = ew;
     return true;
 }
 
+static const VectorOftypespec_member* struct_or_union_members(const typespec* ts) {
+    if (!ts) return nullptr;
+    if (ts->UhdmType() == uhdmstruct_typespec)
+        return any_cast<const struct_typespec*>(ts)->Members();
+    if (ts->UhdmType() == uhdmunion_typespec)
+        return any_cast<const union_typespec*>(ts)->Members();
+    return nullptr;
+}
+
+const dict<std::string, int>* UhdmImporter::struct_member_names(const typespec* ts) {
+    auto it = struct_member_names_.find(ts);
+    if (it != struct_member_names_.end())
+        return &it->second;
+    auto members = struct_or_union_members(ts);
+    if (!members)
+        return nullptr;
+    dict<std::string, int> names;
+    for (int i = 0; i < GetSize(*members); i++)
+        names.emplace(std::string((*members)[i]->VpiName()), i);  // first declaration wins
+    return &(struct_member_names_[ts] = std::move(names));
+}
+
+// Offsets accumulate member widths from the LSB (last member) up, and only
+// up to the member asked for: a member above it whose width cannot be
+// evaluated in this context never is.  The whole type's width is filled in
+// by the first caller that needs it.
+UhdmImporter::StructLayout* UhdmImporter::struct_layout(const typespec* ts, const scope* inst, int member_idx) {
+    auto members = struct_or_union_members(ts);
+    if (!members)
+        return nullptr;
+    auto key = std::make_tuple(ts, inst, current_instance, module, parameter_version);
+    auto it = struct_layouts_.find(key);
+    if (it == struct_layouts_.end()) {
+        it = struct_layouts_.emplace(key, StructLayout()).first;
+        it->second.members.resize(members->size());
+    }
+    StructLayout* layout = &it->second;
+
+    bool is_struct = ts->UhdmType() == uhdmstruct_typespec;
+    int n = GetSize(*members);
+    while (member_idx >= 0 && n - layout->filled > member_idx) {
+        int i = n - 1 - layout->filled;
+        auto& lm = layout->members[i];
+        lm.offset = is_struct ? layout->next_offset : 0;
+        layout->filled++;
+        auto ref_ts = (*members)[i]->Typespec();
+        auto actual_ts = ref_ts ? ref_ts->Actual_typespec() : nullptr;
+        if (!actual_ts)
+            continue;
+        lm.has_ts = true;
+        lm.ts = resolve_type_param_typespec(actual_ts, inst);
+        lm.width = get_width_from_typespec(lm.ts, inst);
+        // The offsets step over each member's DECLARED type, unresolved.
+        if (is_struct)
+            layout->next_offset += lm.ts == actual_ts ? lm.width : get_width_from_typespec(actual_ts, inst);
+    }
+    return layout;
+}
+
 bool UhdmImporter::calculate_struct_member_offset(const typespec* ts, const std::string& member_path,
                                                  const scope* inst, int& bit_offset, int& member_width,
                                                  const typespec** final_member_ts) {
@@ -12169,7 +12523,7 @@ bool UhdmImporter::calculate_struct_member_offset(const typespec* ts, const std:
         return false;
     }
     
-    // log("UHDM: calculate_struct_member_offset for path '%s'\n", member_path.c_str());
+    // log_uhdm_trace("UHDM: calculate_struct_member_offset for path '%s'\n", member_path.c_str());
     
     // Split the member path by dots for nested access
     std::vector<std::string> path_parts;
@@ -12205,65 +12559,21 @@ bool UhdmImporter::calculate_struct_member_offset(const typespec* ts, const std:
                 p = e + 1;
             }
         }
-        bool is_struct = current_ts && current_ts->UhdmType() == uhdmstruct_typespec;
-        bool is_union = current_ts && current_ts->UhdmType() == uhdmunion_typespec;
-        if (!is_struct && !is_union) {
+        // Locate the member in the type's layout table.  A member without a
+        // typespec keeps the previous level's width.
+        const dict<std::string, int>* names = struct_member_names(current_ts);
+        if (!names || !names->count(member_name)) {
             return false;
         }
-
-        const VectorOftypespec_member* members = nullptr;
-        if (is_struct) {
-            auto struct_ts = any_cast<const struct_typespec*>(current_ts);
-            members = struct_ts->Members();
-        } else {
-            auto union_ts = any_cast<const union_typespec*>(current_ts);
-            members = union_ts->Members();
-        }
-        if (!members) {
+        int member_idx = names->at(member_name);
+        const StructLayout* layout = struct_layout(current_ts, inst, member_idx);
+        if (!layout)
             return false;
-        }
-
-        // Calculate offset within this level
-        // For unions: offset is always 0. For structs: accumulate offset.
-        int offset_in_level = 0;
-        bool found = false;
-        const typespec* found_member_ts = nullptr;
-
-        // Iterate through members in reverse order (MSB to LSB for packed structs)
-        for (int i = members->size() - 1; i >= 0; i--) {
-            auto member = (*members)[i];
-            std::string current_member_name = std::string(member->VpiName());
-
-            if (current_member_name == member_name) {
-                // Found the member.  Resolve a `parameter type` DECLARATION
-                // DEFAULT to the instance-bound type so the NEXT path level
-                // can descend into the bound struct's members (cva6_tlb's
-                // anonymous struct member `pte_cva6_t pte` defaults to a
-                // 1-bit logic — content_q[i].pte.g returned X).
-                if (auto ref_ts = member->Typespec()) {
-                    if (auto actual_ts = ref_ts->Actual_typespec()) {
-                        found_member_ts = resolve_type_param_typespec(actual_ts, inst);
-                        member_width = get_width_from_typespec(found_member_ts, inst);
-                    }
-                }
-                found = true;
-                break;
-            }
-
-            // Only accumulate offset for structs, not unions
-            if (is_struct) {
-                if (auto ref_ts = member->Typespec()) {
-                    if (auto actual_ts = ref_ts->Actual_typespec()) {
-                        int width = get_width_from_typespec(actual_ts, inst);
-                        offset_in_level += width;
-                    }
-                }
-            }
-        }
-
-        if (!found) {
-            return false;
-        }
+        const StructLayoutMember lm = layout->members[member_idx];
+        int offset_in_level = lm.offset;
+        const typespec* found_member_ts = lm.ts;
+        if (lm.has_ts)
+            member_width = lm.width;
 
         // Add the offset within this level to the total offset
         bit_offset += offset_in_level;
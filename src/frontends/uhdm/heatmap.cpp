@@ -0,0 +1,166 @@
+/*
+ * Per-source-line RTLIL inflation report for UHDM to RTLIL translation
+ *
+ * `read_uhdm -heatmap <file>` / `read_sv -heatmap <file>` charge every cell,
+ * wire and process the importer emits -- and the time spent emitting it --
+ * to the SystemVerilog line that produced it, so a construct that blows up
+ * the netlist can be found without bisecting the source.  The switch-rule
+ * column counts the rules inside newly created processes only.
+ */
+
+#include "uhdm2rtlil.h"
+
+YOSYS_NAMESPACE_BEGIN
+
+using namespace UHDM;
+
+static int count_switches(const RTLIL::CaseRule* cs) {
+    int n = 0;
+    for (auto sw : cs->switches) {
+        n++;
+        for (auto c : sw->cases)
+            n += count_switches(c);
+    }
+    return n;
+}
+
+// hashlib dicts iterate newest-first, so the first `n` entries are the ones
+// added since a snapshot.  (An erase in between reorders the tail; the
+// numbers are then approximate, which is fine for a report.)
+static int newest_wire_bits(RTLIL::Module* mod, int n) {
+    int bits = 0;
+    for (auto& it : mod->wires_) {
+        if (n-- <= 0) break;
+        bits += it.second->width;
+    }
+    return bits;
+}
+
+// Switch rules are only counted in processes the scope created: rules a
+// nested statement adds to an enclosing process are booked to the line that
+// opened that process, not to the statement.
+static int newest_process_switches(RTLIL::Module* mod, int n) {
+    int sw = 0;
+    for (auto& it : mod->processes) {
+        if (n-- <= 0) break;
+        sw += count_switches(&it.second->root_case);
+    }
+    return sw;
+}
+
+UhdmImporter::HeatmapScope::HeatmapScope(UhdmImporter* importer, const any* obj) {
+    if (importer->heatmap_file.empty() || !importer->module)
+        return;
+    imp = importer;
+    mod = imp->module;
+    if (obj && !obj->VpiFile().empty())
+        key = imp->src_files[imp->src_file_id(obj->VpiFile())] + ":" +
+              std::to_string(obj->VpiLineNo());
+    else
+        key = "<unknown>";
+    cells0 = GetSize(mod->cells_);
+    wires0 = GetSize(mod->wires_);
+    procs0 = GetSize(mod->processes);
+    parent = imp->heatmap_scope;
+    imp->heatmap_scope = this;
+    t0 = std::chrono::steady_clock::now();
+}
+
+UhdmImporter::HeatmapScope::~HeatmapScope() {
+    if (!imp)
+        return;
+    imp->heatmap_scope = parent;
+
+    // Inclusive delta of this scope.  Only objects in the module the scope
+    // was opened on count; a nested import of another module (hierarchy
+    // expansion) books its own objects under its own scopes.
+    HeatmapStat incl;
+    incl.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    if (mod == imp->module) {
+        incl.cells = GetSize(mod->cells_) - cells0;
+        incl.wires = GetSize(mod->wires_) - wires0;
+        incl.processes = GetSize(mod->processes) - procs0;
+        incl.wire_bits = newest_wire_bits(mod, incl.wires);
+        incl.process_switches = newest_process_switches(mod, incl.processes);
+    }
+
+    HeatmapStat& st = imp->heatmap[key];
+    st.items++;
+    st.cells += incl.cells - nested.cells;
+    st.wires += incl.wires - nested.wires;
+    st.wire_bits += incl.wire_bits - nested.wire_bits;
+    st.processes += incl.processes - nested.processes;
+    st.process_switches += incl.process_switches - nested.process_switches;
+    st.seconds += incl.seconds - nested.seconds;
+
+    if (parent) {
+        if (parent->mod == mod) {
+            parent->nested.cells += incl.cells;
+            parent->nested.wires += incl.wires;
+            parent->nested.wire_bits += incl.wire_bits;
+            parent->nested.processes += incl.processes;
+            parent->nested.process_switches += incl.process_switches;
+        }
+        parent->nested.seconds += incl.seconds;
+    }
+}
+
+static std::string json_escape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\')
+            out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+// Sorted table (top entries) to the log, every entry to heatmap_file as JSON.
+// Module rows are net of the end-of-module scratch sweep and can go negative.
+void UhdmImporter::report_heatmap() {
+    std::vector<std::pair<std::string, HeatmapStat>> rows(heatmap.begin(), heatmap.end());
+    std::sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) {
+        int wa = a.second.cells + a.second.wires + a.second.processes + a.second.process_switches;
+        int wb = b.second.cells + b.second.wires + b.second.processes + b.second.process_switches;
+        if (wa != wb) return wa > wb;
+        if (a.second.seconds != b.second.seconds) return a.second.seconds > b.second.seconds;
+        return a.first < b.first;
+    });
+
+    log("\nUHDM import heatmap (%d source lines, top %d):\n", GetSize(rows), std::min(GetSize(rows), 25));
+    log("  %7s %7s %9s %6s %8s %9s  %s\n", "cells", "wires", "bits", "procs", "proc_sw", "ms", "source");
+    for (int i = 0; i < GetSize(rows) && i < 25; i++) {
+        auto& st = rows[i].second;
+        log("  %7d %7d %9d %6d %8d %9.2f  %s\n", st.cells, st.wires, st.wire_bits,
+            st.processes, st.process_switches, st.seconds * 1e3, rows[i].first.c_str());
+    }
+    if (int lookups = iface_param_memo_hits + iface_param_memo_misses)
+        log("  interface/struct parameter memo: %d lookups, %.1f%% hits\n",
+            lookups, 100.0 * iface_param_memo_hits / lookups);
+    if (int lookups = expr_cache_hits + expr_cache_misses)
+        log("  process expression cache: %d lookups, %.1f%% hits\n",
+            lookups, 100.0 * expr_cache_hits / lookups);
+
+    std::ofstream f(heatmap_file);
+    if (f.fail()) {
+        log_warning("UHDM: cannot write heatmap to '%s'\n", heatmap_file.c_str());
+        return;
+    }
+    f << "[\n";
+    for (int i = 0; i < GetSize(rows); i++) {
+        auto& st = rows[i].second;
+        f << "  {\"src\": \"" << json_escape(rows[i].first) << "\""
+          << ", \"items\": " << st.items
+          << ", \"cells\": " << st.cells
+          << ", \"wires\": " << st.wires
+          << ", \"wire_bits\": " << st.wire_bits
+          << ", \"processes\": " << st.processes
+          << ", \"new_process_switch_rules\": " << st.process_switches
+          << ", \"seconds\": " << st.seconds << "}"
+          << (i + 1 < GetSize(rows) ? ",\n" : "\n");
+    }
+    f << "]\n";
+    log("UHDM: heatmap written to %s\n", heatmap_file.c_str());
+}
+
+YOSYS_NAMESPACE_END
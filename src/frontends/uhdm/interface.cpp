@@ -12,71 +12,114 @@
 
 YOSYS_NAMESPACE_BEGIN
 
+// Interface definition name, `work@` stripped; the instance name only when
+// the definition name is missing.
+static std::string interface_def_name(const interface_inst* iface) {
+    std::string name = std::string(iface->VpiDefName());
+    if (name.empty())
+        name = std::string(iface->VpiName());
+    if (name.find("work@") == 0)
+        name = name.substr(5);
+    return name;
+}
+
+// RTLIL module name of the specialization an interface instance needs:
+// `$paramod\<iface>` plus one `\P=<value>` per constant parameter assignment,
+// encoded like module $paramod names.  Integer values are also returned in
+// `param_values` for the module's parameter defaults.
+std::string UhdmImporter::interface_specialization_name(const interface_inst* iface,
+                                                        std::map<std::string, int>* param_values) {
+    std::string name = "$paramod\\" + interface_def_name(iface);
+    if (!iface->Param_assigns())
+        return name;
+    for (auto param_assign : *iface->Param_assigns()) {
+        auto param = dynamic_cast<const parameter*>(param_assign->Lhs());
+        auto const_val = dynamic_cast<const constant*>(param_assign->Rhs());
+        if (!param || !const_val)
+            continue;
+        std::string param_name = std::string(param->VpiName());
+        if (param_name.empty())
+            continue;
+        std::string val_str = std::string(const_val->VpiValue());
+        std::string value_type;
+        size_t colon_pos = val_str.find(':');
+        if (colon_pos != std::string::npos) {
+            value_type = val_str.substr(0, colon_pos);
+            val_str = val_str.substr(colon_pos + 1);
+        }
+        if (value_type == "STRING") {
+            name += "\\" + param_name + "=\"" + val_str + "\"";
+        } else {
+            name += "\\" + param_name + "=s32'" + encode_param_bits32(value_type, val_str);
+            if (param_values)
+                (*param_values)[param_name] =
+                    extract_const_from_value(std::string(const_val->VpiValue())).as_int();
+        }
+    }
+    return name;
+}
+
+// Record the specialization `iface` needs and return its module name.  The
+// first instance seen represents it, unless a later one carries the signal
+// declarations the first lacks (an AllInterfaces entry without Variables/Nets).
+std::string UhdmImporter::register_interface_specialization(const interface_inst* iface) {
+    std::string name = interface_specialization_name(iface);
+    auto has_signals = [](const interface_inst* ii) {
+        return (ii->Variables() && !ii->Variables()->empty()) ||
+               (ii->Nets() && !ii->Nets()->empty());
+    };
+    auto it = interface_specializations.find(name);
+    if (it == interface_specializations.end())
+        interface_specializations[name] = iface;
+    else if (!has_signals(it->second) && has_signals(iface))
+        it->second = iface;
+    return name;
+}
+
+// Hierarchy pre-walk: register the interface instances of `mod` and below.
+void UhdmImporter::collect_interface_specializations(const module_inst* mod) {
+    if (mod->Interfaces())
+        for (auto iface : *mod->Interfaces())
+            register_interface_specialization(iface);
+    if (mod->Modules())
+        for (auto child : *mod->Modules())
+            collect_interface_specializations(child);
+}
+
+// Module name for an interface instance cell.  Specializations the pre-walk
+// did not reach (e.g. an instance inside a generate scope) are registered and
+// imported here, so every cell type resolves to an existing module.
+std::string UhdmImporter::interface_specialization(const interface_inst* iface) {
+    std::string name = register_interface_specialization(iface);
+    if (!design->module(RTLIL::escape_id(name)))
+        import_interface(interface_specializations.at(name));
+    return name;
+}
+
 // Import interface definition
 void UhdmImporter::import_interface(const interface_inst* uhdm_interface) {
     if (mode_debug)
-        log("UHDM: Starting import_interface\n");
-    
-    std::string interface_name = std::string(uhdm_interface->VpiName());
-    if (interface_name.empty()) {
-        std::string defname = std::string(uhdm_interface->VpiDefName());
-        if (!defname.empty()) {
-            interface_name = defname;
-            // Strip work@ prefix if present
-            if (interface_name.find("work@") == 0) {
-                interface_name = interface_name.substr(5);
-            }
-        }
-    }
+        log_uhdm_debug("UHDM: Starting import_interface\n");
     
+    std::string interface_name = interface_def_name(uhdm_interface);
     if (interface_name.empty()) {
         log_warning("UHDM: Interface has empty name, skipping\n");
         return;
     }
     
     if (mode_debug)
-        log("UHDM: Processing interface: %s\n", interface_name.c_str());
+        log_uhdm_debug("UHDM: Processing interface: %s\n", interface_name.c_str());
     
-    // Create interface module - interfaces become modules in RTLIL
-    // We need to create parameterized versions for each WIDTH value
-    
-    // Get parameter values to create proper parameterized module name
-    std::string param_module_name = "$paramod\\" + interface_name;
-    
-    // Store all parameters and their values
+    // Create interface module - interfaces become modules in RTLIL, one per
+    // specialization (see interface_specialization_name)
     std::map<std::string, int> param_values;
-    
-    if (uhdm_interface->Param_assigns()) {
-        for (auto param_assign : *uhdm_interface->Param_assigns()) {
-            if (param_assign->Lhs() && param_assign->Rhs()) {
-                std::string param_name;
-                if (auto param = dynamic_cast<const parameter*>(param_assign->Lhs())) {
-                    param_name = std::string(param->VpiName());
-                }
-                
-                if (!param_name.empty()) {
-                    if (auto const_val = dynamic_cast<const constant*>(param_assign->Rhs())) {
-                        std::string val_str = std::string(const_val->VpiValue());
-                        RTLIL::Const const_val_rtlil = extract_const_from_value(val_str);
-                        int param_value = const_val_rtlil.as_int();
-                        param_values[param_name] = param_value;
-                        
-                        // Add to module name in Yosys format
-                        param_module_name += "\\" + param_name + "=s32'";
-                        for (int i = 31; i >= 0; i--) {
-                            param_module_name += ((param_value >> i) & 1) ? "1" : "0";
-                        }
-                    }
-                }
-            }
-        }
-    }
+    std::string param_module_name = interface_specialization_name(uhdm_interface, &param_values);
     
     RTLIL::IdString mod_id = RTLIL::escape_id(param_module_name);
     
     // Check if this interface module already exists
     if (design->module(mod_id)) {
-        log("UHDM: Interface module %s already exists\n", param_module_name.c_str());
+        log_uhdm_debug("UHDM: Interface module %s already exists\n", param_module_name.c_str());
         return;
     }
     
@@ -94,6 +137,7 @@ void UhdmImporter::import_interface(const interface_inst* uhdm_interface) {
         RTLIL::IdString param_id = RTLIL::escape_id(param_name);
         iface_module->avail_parameters(param_id);
         iface_module->parameter_default_values[param_id] = RTLIL::Const(param_value, 32);
+        parameter_version++;
     }
     
     // Get the actual interface variables from the interface instance
@@ -109,7 +153,7 @@ void UhdmImporter::import_interface(const interface_inst* uhdm_interface) {
             std::string var_name = std::string(var->VpiName());
             RTLIL::Wire* w = iface_module->addWire(RTLIL::escape_id(var_name), width);
             add_src_attribute(w->attributes, var);
-            log("UHDM: Added wire '%s' (width=%d) to interface module from Variables\n", var_name.c_str(), width);
+            log_uhdm_debug("UHDM: Added wire '%s' (width=%d) to interface module from Variables\n", var_name.c_str(), width);
         }
     } 
     // Then try Nets
@@ -118,7 +162,7 @@ void UhdmImporter::import_interface(const interface_inst* uhdm_interface) {
             std::string net_name = std::string(net->VpiName());
             RTLIL::Wire* w = iface_module->addWire(RTLIL::escape_id(net_name), width);
             add_src_attribute(w->attributes, net);
-            log("UHDM: Added wire '%s' (width=%d) to interface module from Nets\n", net_name.c_str(), width);
+            log_uhdm_debug("UHDM: Added wire '%s' (width=%d) to interface module from Nets\n", net_name.c_str(), width);
         }
     }
     else {
@@ -129,21 +173,21 @@ void UhdmImporter::import_interface(const interface_inst* uhdm_interface) {
             for (const auto& signal_name : signal_names) {
                 RTLIL::Wire* w = iface_module->addWire(RTLIL::escape_id(signal_name), width);
                 add_src_attribute(w->attributes, uhdm_interface);
-                log("UHDM: Added wire '%s' (width=%d) to interface module (hardcoded)\n", signal_name.c_str(), width);
+                log_uhdm_debug("UHDM: Added wire '%s' (width=%d) to interface module (hardcoded)\n", signal_name.c_str(), width);
             }
         }
     }
     
-    log("UHDM: Created interface module %s\n", param_module_name.c_str());
+    log_uhdm_debug("UHDM: Created interface module %s\n", param_module_name.c_str());
     
     if (mode_debug)
-        log("UHDM: Finished importing interface: %s\n", interface_name.c_str());
+        log_uhdm_debug("UHDM: Finished importing interface: %s\n", interface_name.c_str());
 }
 
 // Import interface instances within a module
 void UhdmImporter::import_interface_instances(const UHDM::module_inst* uhdm_module) {
     if (mode_debug)
-        log("UHDM: Starting import_interface_instances\n");
+        log_uhdm_debug("UHDM: Starting import_interface_instances\n");
 
     // AllModules entries for non-top modules typically store local interface
     // instances as plain `logic_net` placeholders — the `Interfaces()` list
@@ -152,35 +196,24 @@ void UhdmImporter::import_interface_instances(const UHDM::module_inst* uhdm_modu
     // Search the elaborated hierarchy for a matching instance and use that
     // as the source for `Interfaces()` when AllModules' list is empty.
     const UHDM::module_inst* source = uhdm_module;
-    if ((!uhdm_module->Interfaces() || uhdm_module->Interfaces()->empty()) &&
-        uhdm_design && uhdm_design->TopModules()) {
+    if (!uhdm_module->Interfaces() || uhdm_module->Interfaces()->empty()) {
         std::string def = std::string(uhdm_module->VpiDefName());
-        std::function<const UHDM::module_inst*(const UHDM::module_inst*)> find =
-            [&](const UHDM::module_inst* m) -> const UHDM::module_inst* {
-            if (!m) return nullptr;
-            if (std::string(m->VpiDefName()) == def &&
-                m->Interfaces() && !m->Interfaces()->empty())
-                return m;
-            if (m->Modules())
-                for (auto c : *m->Modules())
-                    if (auto r = find(c)) return r;
-            return nullptr;
-        };
-        for (auto t : *uhdm_design->TopModules()) {
-            if (auto r = find(t)) { source = r; break; }
-        }
+        if (auto r = find_elaborated_instance(def, false, [](const UHDM::module_inst* m) {
+                return m->Interfaces() && !m->Interfaces()->empty();
+            }))
+            source = r;
         if (source != uhdm_module) {
-            log("UHDM: Augmenting interface instances for %s from elaborated %s\n",
+            log_uhdm_debug("UHDM: Augmenting interface instances for %s from elaborated %s\n",
                 def.c_str(), std::string(source->VpiFullName()).c_str());
         }
     }
 
     // Import interface instances
     if (source->Interfaces()) {
-        log("UHDM: Module has %d interfaces\n", (int)source->Interfaces()->size());
+        log_uhdm_debug("UHDM: Module has %d interfaces\n", (int)source->Interfaces()->size());
         for (auto interface : *source->Interfaces()) {
             std::string interface_name = std::string(interface->VpiName());
-            log("UHDM: Processing interface instance: %s\n", interface_name.c_str());
+            log_uhdm_debug("UHDM: Processing interface instance: %s\n", interface_name.c_str());
             log_flush();
             // Record the packed struct/union typespec of an interface signal
             // (e.g. "arr[0].req") so a field access `arr[0].req.adr` can slice
@@ -224,7 +257,7 @@ void UhdmImporter::import_interface_instances(const UHDM::module_inst* uhdm_modu
             // First check if the current module has a WIDTH parameter
             if (module->parameter_default_values.count(RTLIL::escape_id("WIDTH"))) {
                 interface_width = module->parameter_default_values.at(RTLIL::escape_id("WIDTH")).as_int();
-                log("UHDM: Using module's WIDTH parameter: %d\n", interface_width);
+                log_uhdm_debug("UHDM: Using module's WIDTH parameter: %d\n", interface_width);
             } else {
                 // Fall back to interface instance's parameter assignments
                 if (interface->Param_assigns()) {
@@ -240,7 +273,7 @@ void UhdmImporter::import_interface_instances(const UHDM::module_inst* uhdm_modu
                                     std::string val_str = std::string(const_val->VpiValue());
                                     RTLIL::Const const_val_rtlil = extract_const_from_value(val_str);
                                     interface_width = const_val_rtlil.as_int();
-                                    log("UHDM: Interface %s has WIDTH=%d\n", interface_name.c_str(), interface_width);
+                                    log_uhdm_debug("UHDM: Interface %s has WIDTH=%d\n", interface_name.c_str(), interface_width);
                                 }
                             }
                         }
@@ -311,7 +344,7 @@ void UhdmImporter::import_interface_instances(const UHDM::module_inst* uhdm_modu
                     }
 
                     if (mode_debug)
-                        log("UHDM: Creating interface signal from Variables: %s (width=%d)\n", full_name.c_str(), width);
+                        log_uhdm_debug("UHDM: Creating interface signal from Variables: %s (width=%d)\n", full_name.c_str(), width);
 
                     RTLIL::Wire* wire = create_wire(full_name, width);
                     add_src_attribute(wire->attributes, var);
@@ -336,7 +369,7 @@ void UhdmImporter::import_interface_instances(const UHDM::module_inst* uhdm_modu
                                     init_sig = init_sig.extract(0, width);
                                 module->connect(RTLIL::SigSpec(wire), init_sig);
                                 if (mode_debug)
-                                    log("UHDM: Drove %s from net-decl init (width=%d)\n",
+                                    log_uhdm_debug("UHDM: Drove %s from net-decl init (width=%d)\n",
                                         full_name.c_str(), width);
                             }
                         }
@@ -392,7 +425,7 @@ void UhdmImporter::import_interface_instances(const UHDM::module_inst* uhdm_modu
                         }
 
                     if (mode_debug)
-                        log("UHDM: Creating interface signal from Nets: %s (width=%d)\n", full_name.c_str(), width);
+                        log_uhdm_debug("UHDM: Creating interface signal from Nets: %s (width=%d)\n", full_name.c_str(), width);
 
                     RTLIL::Wire* wire = create_wire(full_name, width);
                     add_src_attribute(wire->attributes, net);
@@ -458,7 +491,7 @@ void UhdmImporter::import_interface_instances(const UHDM::module_inst* uhdm_modu
                         iface_signal_struct_ts_[full_name] = elem_ts;
                     iface_array_elem_width_[full_name] = elem_w;
                     if (mode_debug)
-                        log("UHDM: Materialized interface array signal %s "
+                        log_uhdm_debug("UHDM: Materialized interface array signal %s "
                             "(elem_w=%d count=%d total=%d)\n",
                             full_name.c_str(), elem_w, count, total_w);
                 }
@@ -546,7 +579,7 @@ void UhdmImporter::import_interface_instances(const UHDM::module_inst* uhdm_modu
                         rhs = rhs.extract(0, lhs.size());
                     module->connect(lhs, rhs);
                     if (mode_debug)
-                        log("UHDM: Drove %s from interface cont_assign\n", full.c_str());
+                        log_uhdm_debug("UHDM: Drove %s from interface cont_assign\n", full.c_str());
                 }
             }
 
@@ -855,7 +888,7 @@ void UhdmImporter::import_interface_instances(const UHDM::module_inst* uhdm_modu
                             add_src_attribute(lw->attributes, p);
                             name_map[full] = lw;
                             if (mode_debug)
-                                log("UHDM: Created interface port wire %s "
+                                log_uhdm_debug("UHDM: Created interface port wire %s "
                                     "(width=%d)\n", full.c_str(), hi.size());
                         }
                     }
@@ -898,35 +931,8 @@ void UhdmImporter::import_interface_instances(const UHDM::module_inst* uhdm_modu
             bool is_top = top_level_modules.count(module_name) > 0;
             
             if (is_top) {
-                // Create the interface instance as a cell
-                // Build parameterized interface module name
-                std::string param_interface_type = "$paramod\\" + interface_type;
-                
-                // Get all parameter values
-                if (interface->Param_assigns()) {
-                    for (auto param_assign : *interface->Param_assigns()) {
-                        if (param_assign->Lhs() && param_assign->Rhs()) {
-                            std::string param_name;
-                            if (auto param = dynamic_cast<const parameter*>(param_assign->Lhs())) {
-                                param_name = std::string(param->VpiName());
-                            }
-                            
-                            if (!param_name.empty()) {
-                                if (auto const_val = dynamic_cast<const constant*>(param_assign->Rhs())) {
-                                    std::string val_str = std::string(const_val->VpiValue());
-                                    RTLIL::Const const_val_rtlil = extract_const_from_value(val_str);
-                                    int param_value = const_val_rtlil.as_int();
-                                    
-                                    // Add to module name in Yosys format
-                                    param_interface_type += "\\" + param_name + "=s32'";
-                                    for (int i = 31; i >= 0; i--) {
-                                        param_interface_type += ((param_value >> i) & 1) ? "1" : "0";
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
+                // Create the interface instance as a cell of its specialization
+                std::string param_interface_type = interface_specialization(interface);
                 
                 RTLIL::IdString cell_name = "\\" + interface_name;
                 // For an interface PORT (e.g. `tcb_lite_if.man tcb_ifu` on
@@ -937,19 +943,19 @@ void UhdmImporter::import_interface_instances(const UHDM::module_inst* uhdm_modu
                 // when nothing with that name exists yet.
                 if (!module->wire(cell_name) && !module->cell(cell_name)) {
                     module->addCell(cell_name, RTLIL::escape_id(param_interface_type));
-                    log("UHDM: Created interface cell %s of type %s\n", interface_name.c_str(), param_interface_type.c_str());
+                    log_uhdm_debug("UHDM: Created interface cell %s of type %s\n", interface_name.c_str(), param_interface_type.c_str());
                 } else {
-                    log("UHDM: Interface '%s' already represented (wire/cell exists) — skipping instance cell\n", interface_name.c_str());
+                    log_uhdm_debug("UHDM: Interface '%s' already represented (wire/cell exists) — skipping instance cell\n", interface_name.c_str());
                 }
             }
             
         }
     } else {
-        log("UHDM: Module has no interfaces\n");
+        log_uhdm_debug("UHDM: Module has no interfaces\n");
     }
     
     if (mode_debug)
-        log("UHDM: Finished import_interface_instances\n");
+        log_uhdm_debug("UHDM: Finished import_interface_instances\n");
 }
 
 // Check if a module uses interface ports
@@ -981,45 +987,4 @@ std::string UhdmImporter::build_interface_module_name(const std::string& base_na
     return param_signature;
 }
 
-// Create interface module with specific width
-void UhdmImporter::create_interface_module_with_width(const std::string& interface_name, int width) {
-    // Build parameterized module name
-    std::string param_module_name = "$paramod\\" + interface_name;
-    param_module_name += "\\WIDTH=s32'";
-    for (int i = 31; i >= 0; i--) {
-        param_module_name += ((width >> i) & 1) ? "1" : "0";
-    }
-    
-    RTLIL::IdString mod_id = RTLIL::escape_id(param_module_name);
-    
-    // Check if this interface module already exists
-    if (design->module(mod_id)) {
-        log("UHDM: Interface module %s already exists\n", param_module_name.c_str());
-        return;
-    }
-    
-    // Create the interface module
-    RTLIL::Module* iface_module = design->addModule(mod_id);
-    
-    // Add interface attributes
-    iface_module->attributes[RTLIL::escape_id("hdlname")] = RTLIL::Const(interface_name);
-    iface_module->attributes[RTLIL::escape_id("is_interface")] = RTLIL::Const(1);
-    iface_module->attributes[RTLIL::escape_id("dynports")] = RTLIL::Const(1);
-    // Note: no src attribute available - interface module is created from parameters only
-    
-    // Add WIDTH parameter
-    RTLIL::IdString param_id = RTLIL::escape_id("WIDTH");
-    iface_module->avail_parameters(param_id);
-    iface_module->parameter_default_values[param_id] = RTLIL::Const(width, 32);
-    
-    // Create the interface signals (a, b, c for data_bus_if)
-    std::vector<std::string> signal_names = {"a", "b", "c"};
-    for (const auto& signal_name : signal_names) {
-        iface_module->addWire(RTLIL::escape_id(signal_name), width);
-        log("UHDM: Added wire '%s' (width=%d) to interface module\n", signal_name.c_str(), width);
-    }
-    
-    log("UHDM: Created interface module %s\n", param_module_name.c_str());
-}
-
 YOSYS_NAMESPACE_END
\ No newline at end of file
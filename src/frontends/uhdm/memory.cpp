@@ -37,7 +37,7 @@ void UhdmMemoryImporter::import_memory(const logic_net* uhdm_mem) {
     std::string mem_name = std::string(uhdm_mem->VpiName());
     
     if (parent->mode_debug)
-        log("  Importing memory: %s\n", mem_name.c_str());
+        log_uhdm_debug("  Importing memory: %s\n", mem_name.c_str());
     
     // Get memory dimensions
     int width = get_memory_width(uhdm_mem);
@@ -91,7 +91,7 @@ void UhdmMemoryImporter::import_array(const array_net* uhdm_array) {
     std::string array_name = std::string(uhdm_array->VpiName());
     
     if (parent->mode_debug)
-        log("  Importing array: %s\n", array_name.c_str());
+        log_uhdm_debug("  Importing array: %s\n", array_name.c_str());
     
     // For now, treat arrays similarly to memories
     // TODO: Implement proper array handling for different array types
@@ -101,7 +101,7 @@ void UhdmMemoryImporter::import_array(const array_net* uhdm_array) {
 // Import memory read operation
 void UhdmMemoryImporter::import_memory_read(const operation* uhdm_read) {
     if (parent->mode_debug)
-        log("    Importing memory read operation\n");
+        log_uhdm_debug("    Importing memory read operation\n");
     
     // TODO: Implement memory read operation
     // This would involve connecting the address and enabling the read
@@ -111,7 +111,7 @@ void UhdmMemoryImporter::import_memory_read(const operation* uhdm_read) {
 // Import memory write operation
 void UhdmMemoryImporter::import_memory_write(const operation* uhdm_write) {
     if (parent->mode_debug)
-        log("    Importing memory write operation\n");
+        log_uhdm_debug("    Importing memory write operation\n");
     
     // TODO: Implement memory write operation
     // This would involve connecting the address, data, and enabling the write
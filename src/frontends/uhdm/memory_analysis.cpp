@@ -35,6 +35,7 @@ struct MemoryInfo {
     
     // Source location for debugging
     std::string source_location;
+    const any* src_obj = nullptr;
 };
 
 // Memory access operation
@@ -49,6 +50,7 @@ struct MemoryAccess {
     bool is_conditional = false;
     std::string condition_signal;
     std::string source_location;
+    const any* src_obj = nullptr;
 };
 
 // UHDM Memory Analysis Pass
@@ -97,7 +99,7 @@ public:
 // Main analysis function
 void UhdmMemoryAnalyzer::analyze_module(const module_inst* uhdm_module) {
     if (parent->mode_debug)
-        log("Starting memory analysis for module\n");
+        log_uhdm_trace("Starting memory analysis for module\n");
     
     // Phase 1: Find all memory declarations
     analyze_memory_declarations(uhdm_module);
@@ -109,7 +111,7 @@ void UhdmMemoryAnalyzer::analyze_module(const module_inst* uhdm_module) {
     generate_rtlil_memories();
     
     if (parent->mode_debug) {
-        log("Memory analysis complete. Found %zu memories, %zu accesses\n", 
+        log_uhdm_trace("Memory analysis complete. Found %zu memories, %zu accesses\n", 
             memories.size(), memory_accesses.size());
     }
 }
@@ -124,7 +126,7 @@ void UhdmMemoryAnalyzer::analyze_memory_declarations(const module_inst* uhdm_mod
             memories[mem_info.name] = mem_info;
             
             if (parent->mode_debug) {
-                log("  Found memory: %s, width=%d, size=%d\n", 
+                log_uhdm_trace("  Found memory: %s, width=%d, size=%d\n", 
                     mem_info.name.c_str(), mem_info.width, mem_info.size);
             }
         }
@@ -156,6 +158,7 @@ MemoryInfo UhdmMemoryAnalyzer::extract_memory_info(const net* uhdm_net) {
     MemoryInfo info;
     info.name = std::string(uhdm_net->VpiName());
     info.source_location = get_source_location(uhdm_net);
+    info.src_obj = uhdm_net;
     
     // For now, use default values based on simple_memory test
     // In the future, this should extract actual dimensions from UHDM
@@ -196,7 +199,7 @@ void UhdmMemoryAnalyzer::analyze_memory_usage_in_processes(const module_inst* uh
 // Analyze individual always block for memory operations
 void UhdmMemoryAnalyzer::analyze_always_block(const process_stmt* uhdm_process) {
     if (parent->mode_debug)
-        log("  Analyzing always block for memory operations\n");
+        log_uhdm_trace("  Analyzing always block for memory operations\n");
     
     // Analyze statements in the process
     if (auto stmt = uhdm_process->Stmt()) {
@@ -242,7 +245,7 @@ void UhdmMemoryAnalyzer::analyze_assignment_for_memory(const assignment* assign,
     if (!assign->Lhs() || !assign->Rhs()) return;
     
     if (parent->mode_debug) {
-        log("    Analyzing assignment for memory patterns (context: %s)\n", context.c_str());
+        log_uhdm_trace("    Analyzing assignment for memory patterns (context: %s)\n", context.c_str());
     }
     
     // Check if LHS is memory access (write operation)
@@ -258,7 +261,7 @@ void UhdmMemoryAnalyzer::analyze_assignment_for_memory(const assignment* assign,
     // Check for indexed references which indicate memory access
     if (assign->Rhs()->VpiType() == vpiIndexedPartSelect || assign->Rhs()->VpiType() == vpiPartSelect) {
         if (parent->mode_debug) {
-            log("      Found indexed part select - potential memory read\n");
+            log_uhdm_trace("      Found indexed part select - potential memory read\n");
         }
         // This could be memory[addr] access - cast to expr*
         if (auto rhs_expr = dynamic_cast<const expr*>(assign->Rhs())) {
@@ -280,6 +283,7 @@ void UhdmMemoryAnalyzer::analyze_hierarchical_access(const ref_obj* hier_ref, co
         access.type = (context.find("write") != std::string::npos) ? 
                       MemoryAccess::WRITE : MemoryAccess::READ;
         access.source_location = get_source_location(hier_ref);
+        access.src_obj = hier_ref;
         
         // Extract address expression if present
         // This would require analyzing the hierarchical reference structure
@@ -287,7 +291,7 @@ void UhdmMemoryAnalyzer::analyze_hierarchical_access(const ref_obj* hier_ref, co
         memory_accesses.push_back(access);
         
         if (parent->mode_debug) {
-            log("    Found %s access to memory %s\n", 
+            log_uhdm_trace("    Found %s access to memory %s\n", 
                 (access.type == MemoryAccess::WRITE) ? "write" : "read",
                 ref_name.c_str());
         }
@@ -299,7 +303,7 @@ void UhdmMemoryAnalyzer::analyze_memory_usage_in_expressions(const expr* express
     if (!expression) return;
     
     if (parent->mode_debug) {
-        log("      Analyzing expression for memory usage (VpiType=%d, context=%s)\n", 
+        log_uhdm_trace("      Analyzing expression for memory usage (VpiType=%d, context=%s)\n", 
             expression->VpiType(), context.c_str());
     }
     
@@ -312,7 +316,7 @@ void UhdmMemoryAnalyzer::analyze_memory_usage_in_expressions(const expr* express
     int expr_type = expression->VpiType();
     if (expr_type == vpiPartSelect || expr_type == vpiIndexedPartSelect || expr_type == vpiBitSelect) {
         if (parent->mode_debug) {
-            log("        Found select operation - checking if it's memory access\n");
+            log_uhdm_trace("        Found select operation - checking if it's memory access\n");
         }
         
         // Try to extract the base object and index
@@ -326,10 +330,11 @@ void UhdmMemoryAnalyzer::analyze_memory_usage_in_expressions(const expr* express
             access.type = (context.find("write") != std::string::npos) ? 
                           MemoryAccess::WRITE : MemoryAccess::READ;
             access.source_location = get_source_location(expression);
+            access.src_obj = expression;
             memory_accesses.push_back(access);
             
             if (parent->mode_debug) {
-                log("        Detected %s access to memory %s\n", 
+                log_uhdm_trace("        Detected %s access to memory %s\n", 
                     (access.type == MemoryAccess::WRITE) ? "write" : "read",
                     expr_name.c_str());
             }
@@ -354,7 +359,7 @@ void UhdmMemoryAnalyzer::generate_rtlil_memories() {
 // Generate RTLIL memory block
 void UhdmMemoryAnalyzer::generate_memory_block(const MemoryInfo& mem_info) {
     if (parent->mode_debug)
-        log("  Generating RTLIL memory: %s\n", mem_info.name.c_str());
+        log_uhdm_trace("  Generating RTLIL memory: %s\n", mem_info.name.c_str());
     
     // Create memory object
     RTLIL::IdString mem_id = RTLIL::escape_id(mem_info.name);
@@ -364,15 +369,13 @@ void UhdmMemoryAnalyzer::generate_memory_block(const MemoryInfo& mem_info) {
     memory->size = mem_info.size;
     memory->start_offset = 0;
     
-    // Add source attribute
-    if (!mem_info.source_location.empty()) {
-        memory->attributes[ID::src] = RTLIL::Const(mem_info.source_location);
-    }
+    // Add source attribute (honours -nosrc / -src=line)
+    parent->add_src_attribute(memory->attributes, mem_info.src_obj);
     
     module->memories[mem_id] = memory;
     
     if (parent->mode_debug)
-        log("    Created memory %s: width=%d, size=%d\n", 
+        log_uhdm_trace("    Created memory %s: width=%d, size=%d\n", 
             mem_info.name.c_str(), mem_info.width, mem_info.size);
 }
 
@@ -437,13 +440,11 @@ void UhdmMemoryAnalyzer::generate_memory_read_cell(const MemoryAccess& access) {
     read_cell->setPort(ID::ADDR, addr_wire);
     
     // Add source attribute to match Verilog frontend
-    if (!access.source_location.empty()) {
-        read_cell->attributes[ID::src] = RTLIL::Const(access.source_location);
-        data_wire->attributes[ID::src] = RTLIL::Const(access.source_location);
-    }
+    parent->add_src_attribute(read_cell->attributes, access.src_obj);
+    parent->add_src_attribute(data_wire->attributes, access.src_obj);
     
     if (parent->mode_debug)
-        log("    Generated $memrd cell %s for memory %s\n", cell_name.c_str(), access.memory_name.c_str());
+        log_uhdm_trace("    Generated $memrd cell %s for memory %s\n", cell_name.c_str(), access.memory_name.c_str());
 }
 
 // Generate memory write process (simplified)
@@ -453,7 +454,7 @@ void UhdmMemoryAnalyzer::generate_memory_write_process(const std::vector<MemoryA
     const auto& first_write = writes[0];
     
     if (parent->mode_debug)
-        log("    Generating write process for memory %s\n", first_write.memory_name.c_str());
+        log_uhdm_trace("    Generating write process for memory %s\n", first_write.memory_name.c_str());
     
     // This is a simplified implementation
     // In practice, this would need to integrate with the existing process generation
@@ -480,7 +481,7 @@ void UhdmImporter::create_memory_from_array(const array_net* uhdm_array) {
     
     std::string array_name = std::string(uhdm_array->VpiName());
     if (mode_debug)
-        log("  Creating RTLIL memory from array: %s\n", array_name.c_str());
+        log_uhdm_trace("  Creating RTLIL memory from array: %s\n", array_name.c_str());
     
     // Extract memory dimensions from the array_net structure
     int width = 1; // Default bit width
@@ -509,7 +510,7 @@ void UhdmImporter::create_memory_from_array(const array_net* uhdm_array) {
                 start_offset = std::min(left, right);
                 
                 if (mode_debug)
-                    log("    Array range: [%d:%d], size=%d\n", left, right, size);
+                    log_uhdm_trace("    Array range: [%d:%d], size=%d\n", left, right, size);
             }
         }
     }
@@ -562,7 +563,7 @@ void UhdmImporter::create_memory_from_array(const array_net* uhdm_array) {
                         if (outer_dim == 0) outer_dim = dim;   // first = outermost
                         packed_total *= dim;
                         if (mode_debug)
-                            log("    Packed range: [%d:%d]\n", left, right);
+                            log_uhdm_trace("    Packed range: [%d:%d]\n", left, right);
                     }
                     force_const_fold = saved_fcf;
                     if (all_const && packed_total > 0) {
@@ -570,7 +571,7 @@ void UhdmImporter::create_memory_from_array(const array_net* uhdm_array) {
                         if (logic_typespec->Ranges()->size() > 1)
                             packed_outer_dim = outer_dim;
                         if (mode_debug)
-                            log("    Packed width=%d (%d dims)\n", width,
+                            log_uhdm_trace("    Packed width=%d (%d dims)\n", width,
                                 (int)logic_typespec->Ranges()->size());
                     }
                 }
@@ -625,7 +626,7 @@ void UhdmImporter::create_memory_from_array(const array_net* uhdm_array) {
             }
         }
         if (mode_debug)
-            log("    From array_typespec: width=%d, size=%d, start_offset=%d\n",
+            log_uhdm_trace("    From array_typespec: width=%d, size=%d, start_offset=%d\n",
                 width, size, start_offset);
     }
 
@@ -652,7 +653,7 @@ void UhdmImporter::create_memory_from_array(const array_net* uhdm_array) {
     module->memories[mem_id] = memory;
 
     if (mode_debug)
-        log("    Created RTLIL memory %s: width=%d, size=%d, start_offset=%d\n",
+        log_uhdm_trace("    Created RTLIL memory %s: width=%d, size=%d, start_offset=%d\n",
             array_name.c_str(), width, size, start_offset);
 }
 
@@ -662,7 +663,7 @@ void UhdmImporter::create_memory_from_array(const array_var* uhdm_array) {
     
     std::string array_name = std::string(uhdm_array->VpiName());
     if (mode_debug)
-        log("  Creating RTLIL memory from array_var: %s\n", array_name.c_str());
+        log_uhdm_trace("  Creating RTLIL memory from array_var: %s\n", array_name.c_str());
     
     // Extract memory dimensions from the array_var structure
     int width = 1; // Default bit width
@@ -691,7 +692,7 @@ void UhdmImporter::create_memory_from_array(const array_var* uhdm_array) {
                 start_offset = std::min(left, right);
                 
                 if (mode_debug)
-                    log("    Array range: [%d:%d], size=%d\n", left, right, size);
+                    log_uhdm_trace("    Array range: [%d:%d], size=%d\n", left, right, size);
             }
         }
     }
@@ -746,7 +747,7 @@ void UhdmImporter::create_memory_from_array(const array_var* uhdm_array) {
                         if (outer_dim == 0) outer_dim = dim;   // first = outermost
                         packed_total *= dim;
                         if (mode_debug)
-                            log("    Packed range: [%d:%d]\n", left, right);
+                            log_uhdm_trace("    Packed range: [%d:%d]\n", left, right);
                     }
                     force_const_fold = saved_fcf;
                     if (all_const && packed_total > 0) {
@@ -754,7 +755,7 @@ void UhdmImporter::create_memory_from_array(const array_var* uhdm_array) {
                         if (logic_typespec->Ranges()->size() > 1)
                             packed_outer_dim = outer_dim;
                         if (mode_debug)
-                            log("    Packed width=%d (%d dims)\n", width,
+                            log_uhdm_trace("    Packed width=%d (%d dims)\n", width,
                                 (int)logic_typespec->Ranges()->size());
                     }
                 }
@@ -809,7 +810,7 @@ void UhdmImporter::create_memory_from_array(const array_var* uhdm_array) {
             }
         }
         if (mode_debug)
-            log("    From array_typespec: width=%d, size=%d, start_offset=%d\n",
+            log_uhdm_trace("    From array_typespec: width=%d, size=%d, start_offset=%d\n",
                 width, size, start_offset);
     }
 
@@ -881,7 +882,7 @@ void UhdmImporter::create_memory_from_array(const array_var* uhdm_array) {
                         cell->setPort(ID::ADDR, RTLIL::Const(start_offset, 32));
                         cell->setPort(ID::DATA, RTLIL::Const(data));
                         cell->setPort(ID::EN, RTLIL::Const(RTLIL::State::S1, width));
-                        log("    Added $meminit for %s: %d words = default\n",
+                        log_uhdm_trace("    Added $meminit for %s: %d words = default\n",
                             array_name.c_str(), size);
                     }
                 }
@@ -890,7 +891,7 @@ void UhdmImporter::create_memory_from_array(const array_var* uhdm_array) {
     }
 
     if (mode_debug)
-        log("    Created RTLIL memory %s: width=%d, size=%d, start_offset=%d\n",
+        log_uhdm_trace("    Created RTLIL memory %s: width=%d, size=%d, start_offset=%d\n",
             array_name.c_str(), width, size, start_offset);
 }
 
@@ -54,7 +54,7 @@ void UhdmImporter::import_port(const port* uhdm_port, int positional_idx) {
     }
     
     if (mode_debug)
-        log("  Importing port: %s (dir=%d)\n", portname.c_str(), direction);
+        log_uhdm_debug("  Importing port: %s (dir=%d)\n", portname.c_str(), direction);
     
     // Get port width
     int width = get_width(uhdm_port, current_instance);
@@ -65,7 +65,7 @@ void UhdmImporter::import_port(const port* uhdm_port, int positional_idx) {
     // never a negative-width wire.  The per-element signals (m[0].vld, ...) are
     // created separately, so the placeholder only holds the port-list slot.
     if (width < 0) {
-        log("UHDM: Port '%s' is an interface type, creating placeholder\n", portname.c_str());
+        log_uhdm_debug("UHDM: Port '%s' is an interface type, creating placeholder\n", portname.c_str());
         // For interface ports, create a special wire that won't be used for connections
         // but serves as a placeholder for the port list
         RTLIL::Wire* w = module->addWire(RTLIL::escape_id(portname), 1);
@@ -167,7 +167,7 @@ void UhdmImporter::import_port(const port* uhdm_port, int positional_idx) {
                         // Check if this parameterized interface module exists
                         //if (design->module(RTLIL::escape_id(param_interface_name))) {
                             final_interface_type = param_interface_name;
-                            log("UHDM: Using parameterized interface name: %s\n", final_interface_type.c_str());
+                            log_uhdm_debug("UHDM: Using parameterized interface name: %s\n", final_interface_type.c_str());
                         //}
                     }
                     
@@ -241,17 +241,6 @@ void UhdmImporter::import_port(const port* uhdm_port, int positional_idx) {
                 // instantiated the interface with a wider `W`.
                 if (uhdm_design && uhdm_design->TopModules() && current_instance) {
                     std::string def = std::string(current_instance->VpiDefName());
-                    std::function<const UHDM::module_inst*(const UHDM::module_inst*)> find =
-                        [&](const UHDM::module_inst* m) -> const UHDM::module_inst* {
-                        if (!m) return nullptr;
-                        if (std::string(m->VpiDefName()) == def &&
-                            m != current_instance && m->Ports())
-                            return m;
-                        if (m->Modules())
-                            for (auto c : *m->Modules())
-                                if (auto r = find(c)) return r;
-                        return nullptr;
-                    };
                     // Extract the parent-side interface_inst from a module
                     // instance's port High_conn (carries the overridden
                     // parameter).  Low_conn is the submodule's local view (no
@@ -300,9 +289,10 @@ void UhdmImporter::import_port(const port* uhdm_port, int positional_idx) {
                     // elaborated (the AllModules definition pass).
                     const UHDM::interface_inst* eii = eii_from(current_instance);
                     if (!eii) {
-                        const UHDM::module_inst* elab = nullptr;
-                        for (auto t : *uhdm_design->TopModules())
-                            if (auto r = find(t)) { elab = r; break; }
+                        const UHDM::module_inst* elab = find_elaborated_instance(def, false,
+                            [&](const UHDM::module_inst* m) {
+                                return m != current_instance && m->Ports();
+                            });
                         eii = eii_from(elab);
                     }
                     // Don't swap a signal-carrying iface_inst for a signal-less
@@ -549,7 +539,7 @@ void UhdmImporter::import_port(const port* uhdm_port, int positional_idx) {
                             RTLIL::Const(io->VpiDirection());
                         name_map[full_name] = sw;
                         if (mode_debug)
-                            log("UHDM: Created modport signal wire '%s' (width=%d, dir=%d)\n",
+                            log_uhdm_debug("UHDM: Created modport signal wire '%s' (width=%d, dir=%d)\n",
                                 full_name.c_str(), sig_w, io->VpiDirection());
                     }
                   }
@@ -637,10 +627,10 @@ void UhdmImporter::import_port(const port* uhdm_port, int positional_idx) {
                                 if (left < right) {
                                     upto = true;
                                     start_offset = left;
-                                    log("UHDM: Port '%s' has reversed bit ordering [%d:%d]\n", portname.c_str(), left, right);
+                                    log_uhdm_debug("UHDM: Port '%s' has reversed bit ordering [%d:%d]\n", portname.c_str(), left, right);
                                 } else {
                                     start_offset = right;
-                                    log("UHDM: Port '%s' has normal bit ordering [%d:%d]\n", portname.c_str(), left, right);
+                                    log_uhdm_debug("UHDM: Port '%s' has normal bit ordering [%d:%d]\n", portname.c_str(), left, right);
                                 }
                             }
                         }
@@ -685,7 +675,7 @@ void UhdmImporter::import_port(const port* uhdm_port, int positional_idx) {
                         unpacked_count = total;
                         unpacked_elem_w = elem_w;
                         width = total * elem_w;
-                        log("UHDM: Port '%s' recovered unpacked dims from "
+                        log_uhdm_debug("UHDM: Port '%s' recovered unpacked dims from "
                             "Array_nets: %d * %d = %d bits\n",
                             portname.c_str(), elem_w, total, width);
                     }
@@ -737,7 +727,7 @@ void UhdmImporter::import_port(const port* uhdm_port, int positional_idx) {
                     unpacked_count = total;
                     unpacked_elem_w = elem_w;
                     width = total * elem_w;
-                    log("UHDM: Port '%s' recovered unpacked dims from "
+                    log_uhdm_debug("UHDM: Port '%s' recovered unpacked dims from "
                         "Variables (array_var): %d * %d = %d bits\n",
                         portname.c_str(), elem_w, total, width);
                 }
@@ -796,7 +786,7 @@ void UhdmImporter::import_port(const port* uhdm_port, int positional_idx) {
                     w->attributes[RTLIL::escape_id("packed_elem_width")] = RTLIL::Const(elem_w);
                     w->attributes[RTLIL::escape_id("packed_outer_left")] = RTLIL::Const(outer_l);
                     w->attributes[RTLIL::escape_id("packed_outer_right")] = RTLIL::Const(outer_r);
-                    log("UHDM: Port '%s' packed_array_var (Low_conn): elem_width=%d outer=[%d:%d]\n",
+                    log_uhdm_debug("UHDM: Port '%s' packed_array_var (Low_conn): elem_width=%d outer=[%d:%d]\n",
                         portname.c_str(), elem_w, outer_l, outer_r);
                     // The port's own typespec often carries only the ELEMENT
                     // type (`btb_prediction_t [INSTR_PER_FETCH-1:0]` sized the
@@ -805,7 +795,7 @@ void UhdmImporter::import_port(const port* uhdm_port, int positional_idx) {
                     // Resize to the full array width.
                     int total = elem_w * (std::abs(outer_l - outer_r) + 1);
                     if (w->width < total) {
-                        log("UHDM: Port '%s' resized %d -> %d (packed array of %d elements)\n",
+                        log_uhdm_debug("UHDM: Port '%s' resized %d -> %d (packed array of %d elements)\n",
                             portname.c_str(), w->width, total,
                             std::abs(outer_l - outer_r) + 1);
                         w->width = total;
@@ -891,7 +881,7 @@ void UhdmImporter::import_port(const port* uhdm_port, int positional_idx) {
                         w->attributes[RTLIL::escape_id("packed_elem_width")] = RTLIL::Const(packed_elem_width);
                         w->attributes[RTLIL::escape_id("packed_outer_left")] = RTLIL::Const(packed_outer_left);
                         w->attributes[RTLIL::escape_id("packed_outer_right")] = RTLIL::Const(packed_outer_right);
-                        log("UHDM: Port '%s' packed array: elem_width=%d, outer=[%d:%d]\n",
+                        log_uhdm_debug("UHDM: Port '%s' packed array: elem_width=%d, outer=[%d:%d]\n",
                             portname.c_str(), packed_elem_width, packed_outer_left, packed_outer_right);
                     }
                 }
@@ -936,7 +926,7 @@ void UhdmImporter::import_port(const port* uhdm_port, int positional_idx) {
                             name_map[ename] = ew;
                         }
                     }
-                    log("UHDM: Port '%s' unpacked array: elem_w=%d, count=%d\n",
+                    log_uhdm_debug("UHDM: Port '%s' unpacked array: elem_w=%d, count=%d\n",
                         portname.c_str(), elem_w, total);
                 }
             }
@@ -976,7 +966,7 @@ void UhdmImporter::import_port(const port* uhdm_port, int positional_idx) {
                     w->attributes[RTLIL::escape_id("packed_elem_width")] = RTLIL::Const(ew);
                     w->attributes[RTLIL::escape_id("packed_outer_left")] = RTLIL::Const(ol);
                     w->attributes[RTLIL::escape_id("packed_outer_right")] = RTLIL::Const(orr);
-                    log("UHDM: Port '%s' type-param packed array: elem_w=%d outer=[%d:%d]\n",
+                    log_uhdm_debug("UHDM: Port '%s' type-param packed array: elem_w=%d outer=[%d:%d]\n",
                         portname.c_str(), ew, ol, orr);
                 }
             }
@@ -1026,7 +1016,7 @@ void UhdmImporter::import_port(const port* uhdm_port, int positional_idx) {
             }
 
             if (is_signed) {
-                log("UHDM: Port '%s' is signed\n", portname.c_str());
+                log_uhdm_debug("UHDM: Port '%s' is signed\n", portname.c_str());
                 w->is_signed = true;
             }
         }
@@ -1061,14 +1051,14 @@ void UhdmImporter::import_net(const net* uhdm_net, const UHDM::instance* inst) {
     }
     
     if (mode_debug)
-        log("  Importing net: %s\n", netname.c_str());
+        log_uhdm_debug("  Importing net: %s\n", netname.c_str());
     
     // If already created as port, still check signedness from the net object
     // (ports don't carry VpiSigned, but the corresponding net does)
     if (name_map.count(netname)) {
         RTLIL::Wire* w = name_map[netname];
         if (w && !w->is_signed && uhdm_net->VpiSigned()) {
-            log("UHDM: Net '%s' already exists as port, updating signedness from net VpiSigned\n", netname.c_str());
+            log_uhdm_debug("UHDM: Net '%s' already exists as port, updating signedness from net VpiSigned\n", netname.c_str());
             w->is_signed = true;
         }
         int net_type = uhdm_net->VpiNetType();
@@ -1083,11 +1073,11 @@ void UhdmImporter::import_net(const net* uhdm_net, const UHDM::instance* inst) {
     // Also check if wire already exists in module
     RTLIL::IdString wire_id = RTLIL::escape_id(netname);
     if (module->wire(wire_id)) {
-        log("UHDM: Wire '%s' already exists in module, skipping net import\n", wire_id.c_str());
+        log_uhdm_debug("UHDM: Wire '%s' already exists in module, skipping net import\n", wire_id.c_str());
         // Still update signedness if the net marks it as signed
         RTLIL::Wire* existing_w = module->wire(wire_id);
         if (existing_w && !existing_w->is_signed && uhdm_net->VpiSigned()) {
-            log("UHDM: Net '%s' (existing wire): updating is_signed from VpiSigned\n", wire_id.c_str());
+            log_uhdm_debug("UHDM: Net '%s' (existing wire): updating is_signed from VpiSigned\n", wire_id.c_str());
             existing_w->is_signed = true;
         }
         log_flush();
@@ -1096,14 +1086,14 @@ void UhdmImporter::import_net(const net* uhdm_net, const UHDM::instance* inst) {
     
     // Also skip if this is a memory that was already created
     if (module->memories.count(wire_id) > 0) {
-        log("UHDM: Net '%s' already exists as memory, skipping net import\n", netname.c_str());
+        log_uhdm_debug("UHDM: Net '%s' already exists as memory, skipping net import\n", netname.c_str());
         log_flush();
         return;
     }
     
     // Check if this net should be imported as a memory
     if (is_memory_array(uhdm_net)) {
-        log("UHDM: Net '%s' has both packed and unpacked dimensions - creating memory\n", netname.c_str());
+        log_uhdm_debug("UHDM: Net '%s' has both packed and unpacked dimensions - creating memory\n", netname.c_str());
         
         // Get packed dimension (width) and unpacked dimension (size).
         int width = 1;
@@ -1160,7 +1150,7 @@ void UhdmImporter::import_net(const net* uhdm_net, const UHDM::instance* inst) {
         module->memories[mem_id] = memory;
         
         if (mode_debug)
-            log("    Created memory: %s (width=%d, size=%d)\n", mem_id.c_str(), width, size);
+            log_uhdm_debug("    Created memory: %s (width=%d, size=%d)\n", mem_id.c_str(), width, size);
         
         // Don't create a wire for memory arrays
         return;
@@ -1208,10 +1198,10 @@ void UhdmImporter::import_net(const net* uhdm_net, const UHDM::instance* inst) {
                                 if (left < right) {
                                     upto = true;
                                     start_offset = left;
-                                    log("UHDM: Net '%s' has reversed bit ordering [%d:%d]\n", netname.c_str(), left, right);
+                                    log_uhdm_debug("UHDM: Net '%s' has reversed bit ordering [%d:%d]\n", netname.c_str(), left, right);
                                 } else {
                                     start_offset = right;
-                                    log("UHDM: Net '%s' has normal bit ordering [%d:%d]\n", netname.c_str(), left, right);
+                                    log_uhdm_debug("UHDM: Net '%s' has normal bit ordering [%d:%d]\n", netname.c_str(), left, right);
                                 }
                             }
                         }
@@ -1226,14 +1216,14 @@ void UhdmImporter::import_net(const net* uhdm_net, const UHDM::instance* inst) {
     
     // Check if net is signed
     if (auto ref_typespec = uhdm_net->Typespec()) {
-        log("UHDM: Checking signed attribute for net '%s'\n", netname.c_str());
+        log_uhdm_debug("UHDM: Checking signed attribute for net '%s'\n", netname.c_str());
         // Check if typespec indicates signed
         bool is_signed = false;
         const UHDM::typespec* actual_typespec = nullptr;
         
         if (ref_typespec->Actual_typespec()) {
             actual_typespec = ref_typespec->Actual_typespec();
-            log("UHDM: Found Actual_typespec, UhdmType=%d\n", actual_typespec->UhdmType());
+            log_uhdm_debug("UHDM: Found Actual_typespec, UhdmType=%d\n", actual_typespec->UhdmType());
         }
         
         if (actual_typespec) {
@@ -1241,42 +1231,42 @@ void UhdmImporter::import_net(const net* uhdm_net, const UHDM::instance* inst) {
                 case uhdmlogic_typespec:
                     if (auto logic_ts = dynamic_cast<const UHDM::logic_typespec*>(actual_typespec)) {
                         is_signed = logic_ts->VpiSigned();
-                        log("UHDM: logic_typespec VpiSigned=%d\n", is_signed);
+                        log_uhdm_debug("UHDM: logic_typespec VpiSigned=%d\n", is_signed);
                     }
                     break;
                 case uhdmint_typespec:
                     if (auto ts = dynamic_cast<const UHDM::int_typespec*>(actual_typespec))
                         is_signed = ts->VpiSigned();
-                    log("UHDM: int_typespec VpiSigned=%d\n", is_signed);
+                    log_uhdm_debug("UHDM: int_typespec VpiSigned=%d\n", is_signed);
                     break;
                 case uhdminteger_typespec:
                     if (auto ts = dynamic_cast<const UHDM::integer_typespec*>(actual_typespec))
                         is_signed = ts->VpiSigned();
-                    log("UHDM: integer_typespec VpiSigned=%d\n", is_signed);
+                    log_uhdm_debug("UHDM: integer_typespec VpiSigned=%d\n", is_signed);
                     break;
                 case uhdmbyte_typespec:
                     if (auto ts = dynamic_cast<const UHDM::byte_typespec*>(actual_typespec))
                         is_signed = ts->VpiSigned();
-                    log("UHDM: byte_typespec VpiSigned=%d\n", is_signed);
+                    log_uhdm_debug("UHDM: byte_typespec VpiSigned=%d\n", is_signed);
                     break;
                 case uhdmshort_int_typespec:
                     if (auto ts = dynamic_cast<const UHDM::short_int_typespec*>(actual_typespec))
                         is_signed = ts->VpiSigned();
-                    log("UHDM: short_int_typespec VpiSigned=%d\n", is_signed);
+                    log_uhdm_debug("UHDM: short_int_typespec VpiSigned=%d\n", is_signed);
                     break;
                 case uhdmlong_int_typespec:
                     if (auto ts = dynamic_cast<const UHDM::long_int_typespec*>(actual_typespec))
                         is_signed = ts->VpiSigned();
-                    log("UHDM: long_int_typespec VpiSigned=%d\n", is_signed);
+                    log_uhdm_debug("UHDM: long_int_typespec VpiSigned=%d\n", is_signed);
                     break;
                 default:
                     // Other typespec types are not handled
-                    log("UHDM: Unknown typespec type %d\n", actual_typespec->UhdmType());
+                    log_uhdm_debug("UHDM: Unknown typespec type %d\n", actual_typespec->UhdmType());
                     break;
             }
 
             if (is_signed) {
-                log("UHDM: Net '%s' is signed (from typespec), setting is_signed=true\n", netname.c_str());
+                log_uhdm_debug("UHDM: Net '%s' is signed (from typespec), setting is_signed=true\n", netname.c_str());
                 w->is_signed = true;
             }
         }
@@ -1285,7 +1275,7 @@ void UhdmImporter::import_net(const net* uhdm_net, const UHDM::instance* inst) {
     // Also check VpiSigned() directly on the net object itself
     // (Surelog may set signed on the net rather than the typespec)
     if (!w->is_signed && uhdm_net->VpiSigned()) {
-        log("UHDM: Net '%s' is signed (from VpiSigned), setting is_signed=true\n", netname.c_str());
+        log_uhdm_debug("UHDM: Net '%s' is signed (from VpiSigned), setting is_signed=true\n", netname.c_str());
         w->is_signed = true;
     }
     
@@ -1322,7 +1312,7 @@ void UhdmImporter::import_net(const net* uhdm_net, const UHDM::instance* inst) {
                 // Set the attribute value using import_attribute_value
                 w->attributes[RTLIL::escape_id(attr_name)] = import_attribute_value(attr);
                 if (mode_debug)
-                    log("UHDM: Added attribute '%s' to net '%s'\n", attr_name.c_str(), netname.c_str());
+                    log_uhdm_debug("UHDM: Added attribute '%s' to net '%s'\n", attr_name.c_str(), netname.c_str());
             }
             if (!formal_cell.empty()) {
                 std::string cell_name = formal_cell + "$" +
@@ -1339,7 +1329,7 @@ void UhdmImporter::import_net(const net* uhdm_net, const UHDM::instance* inst) {
                 cell->attributes[RTLIL::escape_id("reg")] =
                     RTLIL::Const(netname);
                 if (mode_debug)
-                    log("UHDM: Created %s cell '%s' driving net '%s' (WIDTH=%d)\n",
+                    log_uhdm_debug("UHDM: Created %s cell '%s' driving net '%s' (WIDTH=%d)\n",
                         formal_cell.c_str(), cell_name.c_str(),
                         netname.c_str(), w->width);
             }
@@ -1347,7 +1337,7 @@ void UhdmImporter::import_net(const net* uhdm_net, const UHDM::instance* inst) {
     }
     
     // Add wiretype attribute for struct types
-    log("UHDM: Checking for struct type on net '%s' (UhdmType=%d)\n", netname.c_str(), uhdm_net->UhdmType());
+    log_uhdm_debug("UHDM: Checking for struct type on net '%s' (UhdmType=%d)\n", netname.c_str(), uhdm_net->UhdmType());
     
     // Check if net has a typespec (works for both logic_net and regular net)
     const ref_typespec* ref_ts = nullptr;
@@ -1355,19 +1345,19 @@ void UhdmImporter::import_net(const net* uhdm_net, const UHDM::instance* inst) {
     if (uhdm_net->UhdmType() == uhdmlogic_net) {
         auto logic_net = any_cast<const UHDM::logic_net*>(uhdm_net);
         ref_ts = logic_net->Typespec();
-        log("UHDM: Net is a logic_net\n");
+        log_uhdm_debug("UHDM: Net is a logic_net\n");
     } else if (uhdm_net->Typespec()) {
         // Regular net with typespec
         ref_ts = uhdm_net->Typespec();
-        log("UHDM: Net has typespec\n");
+        log_uhdm_debug("UHDM: Net has typespec\n");
     }
     
     if (ref_ts) {
-        log("UHDM: Found ref_typespec for net '%s'\n", netname.c_str());
+        log_uhdm_debug("UHDM: Found ref_typespec for net '%s'\n", netname.c_str());
         if (auto actual_typespec = ref_ts->Actual_typespec()) {
-            log("UHDM: Found actual_typespec (UhdmType=%d) for net '%s'\n", actual_typespec->UhdmType(), netname.c_str());
+            log_uhdm_debug("UHDM: Found actual_typespec (UhdmType=%d) for net '%s'\n", actual_typespec->UhdmType(), netname.c_str());
             if (actual_typespec->UhdmType() == uhdmstruct_typespec) {
-                log("UHDM: typespec is a struct_typespec\n");
+                log_uhdm_debug("UHDM: typespec is a struct_typespec\n");
                 // Get the struct type name
                 std::string type_name;
                 if (!ref_ts->VpiName().empty()) {
@@ -1378,12 +1368,12 @@ void UhdmImporter::import_net(const net* uhdm_net, const UHDM::instance* inst) {
                 
                 if (!type_name.empty()) {
                     w->attributes[RTLIL::escape_id("wiretype")] = RTLIL::escape_id(type_name);
-                    log("UHDM: Added wiretype attribute '\\%s' to wire '%s'\n", type_name.c_str(), w->name.c_str());
+                    log_uhdm_debug("UHDM: Added wiretype attribute '\\%s' to wire '%s'\n", type_name.c_str(), w->name.c_str());
                 } else {
-                    log("UHDM: Could not get type name for struct\n");
+                    log_uhdm_debug("UHDM: Could not get type name for struct\n");
                 }
             } else if (actual_typespec->UhdmType() == uhdmunion_typespec) {
-                log("UHDM: typespec is a union_typespec\n");
+                log_uhdm_debug("UHDM: typespec is a union_typespec\n");
                 std::string type_name;
                 if (!ref_ts->VpiName().empty())
                     type_name = std::string(ref_ts->VpiName());
@@ -1391,7 +1381,7 @@ void UhdmImporter::import_net(const net* uhdm_net, const UHDM::instance* inst) {
                     type_name = std::string(actual_typespec->VpiName());
                 if (!type_name.empty()) {
                     w->attributes[RTLIL::escape_id("wiretype")] = RTLIL::escape_id(type_name);
-                    log("UHDM: Added wiretype attribute '\\%s' to wire '%s'\n", type_name.c_str(), w->name.c_str());
+                    log_uhdm_debug("UHDM: Added wiretype attribute '\\%s' to wire '%s'\n", type_name.c_str(), w->name.c_str());
                 }
             } else if (actual_typespec->UhdmType() == uhdmlogic_typespec) {
                 // For typedef'd logic types (e.g. "typedef logic [3:0] typename"),
@@ -1400,10 +1390,10 @@ void UhdmImporter::import_net(const net* uhdm_net, const UHDM::instance* inst) {
                 if (logic_ts && !logic_ts->VpiName().empty()) {
                     std::string type_name = std::string(logic_ts->VpiName());
                     w->attributes[RTLIL::escape_id("wiretype")] = RTLIL::escape_id(type_name);
-                    log("UHDM: Added wiretype attribute '\\%s' to logic net '%s'\n", type_name.c_str(), w->name.c_str());
+                    log_uhdm_debug("UHDM: Added wiretype attribute '\\%s' to logic net '%s'\n", type_name.c_str(), w->name.c_str());
                 }
             } else if (actual_typespec->UhdmType() == uhdmenum_typespec) {
-                log("UHDM: typespec is an enum_typespec\n");
+                log_uhdm_debug("UHDM: typespec is an enum_typespec\n");
                 // Handle enum type attributes
                 const UHDM::enum_typespec* enum_ts = any_cast<const UHDM::enum_typespec*>(actual_typespec);
 
@@ -1417,7 +1407,7 @@ void UhdmImporter::import_net(const net* uhdm_net, const UHDM::instance* inst) {
 
                 if (!type_name.empty()) {
                     w->attributes[RTLIL::escape_id("wiretype")] = RTLIL::escape_id(type_name);
-                    log("UHDM: Added wiretype attribute '\\%s' to wire '%s'\n", type_name.c_str(), w->name.c_str());
+                    log_uhdm_debug("UHDM: Added wiretype attribute '\\%s' to wire '%s'\n", type_name.c_str(), w->name.c_str());
                 }
                 
                 // Add enum_type attribute (usually $enum0, $enum1, etc.)
@@ -1444,7 +1434,7 @@ void UhdmImporter::import_net(const net* uhdm_net, const UHDM::instance* inst) {
                         
                         // Set the attribute value to the enum constant name
                         w->attributes[RTLIL::escape_id(attr_name)] = RTLIL::Const("\\" + const_name);
-                        log("UHDM: Added enum attribute %s = \\%s to wire '%s'\n", 
+                        log_uhdm_debug("UHDM: Added enum attribute %s = \\%s to wire '%s'\n", 
                             attr_name.c_str(), const_name.c_str(), w->name.c_str());
                     }
                 }
@@ -1493,8 +1483,9 @@ static RTLIL::Module* connect_target_module(RTLIL::Module* fallback,
 }
 
 void UhdmImporter::import_continuous_assign(const cont_assign* uhdm_assign) {
+    HeatmapScope heat(this, uhdm_assign);
     if (mode_debug)
-        log("  Importing continuous assignment\n");
+        log_uhdm_debug("  Importing continuous assignment\n");
     
     // Check if this is a net declaration assignment (initialization)
     bool is_net_decl_assign = uhdm_assign->VpiNetDeclAssign();
@@ -1503,7 +1494,7 @@ void UhdmImporter::import_continuous_assign(const cont_assign* uhdm_assign) {
     const expr* rhs_expr = uhdm_assign->Rhs();
     
     if (mode_debug && lhs_expr) {
-        log("  LHS type: %s, VpiType: %d, NetDeclAssign: %d\n", 
+        log_uhdm_debug("  LHS type: %s, VpiType: %d, NetDeclAssign: %d\n", 
             UHDM::UhdmName(lhs_expr->UhdmType()).c_str(), 
             lhs_expr->VpiType(),
             is_net_decl_assign);
@@ -1512,7 +1503,7 @@ void UhdmImporter::import_continuous_assign(const cont_assign* uhdm_assign) {
     // Log the current generate scope before importing expressions
     std::string current_gen_scope = get_current_gen_scope();
     if (!current_gen_scope.empty()) {
-        log("    Importing cont_assign in generate scope: %s\n", current_gen_scope.c_str());
+        log_uhdm_debug("    Importing cont_assign in generate scope: %s\n", current_gen_scope.c_str());
     }
     
     // Skip spurious continuous assignments from generate block wire initializations
@@ -1526,7 +1517,7 @@ void UhdmImporter::import_continuous_assign(const cont_assign* uhdm_assign) {
 
         // Skip if this looks like a generate block initialization ('1)
         if (net_name == "x" && (rhs_val == "BIN:1" || rhs_val == "'1")) {
-            log("  Skipping spurious assignment: %s = %s (from generate block)\n",
+            log_uhdm_debug("  Skipping spurious assignment: %s = %s (from generate block)\n",
                 net_name.c_str(), rhs_val.c_str());
             return;
         }
@@ -1579,7 +1570,7 @@ void UhdmImporter::import_continuous_assign(const cont_assign* uhdm_assign) {
                         else if (cs.size() > elem_w) cs = cs.extract(0, elem_w);
                         module->connect(RTLIL::SigSpec(elems[wi]), cs);
                         if (mode_debug)
-                            log("  Net-decl-assign array init: %s ← const\n",
+                            log_uhdm_debug("  Net-decl-assign array init: %s ← const\n",
                                 elems[wi]->name.c_str());
                     }
                     op_idx++;
@@ -1589,7 +1580,7 @@ void UhdmImporter::import_continuous_assign(const cont_assign* uhdm_assign) {
         }
     }
     
-    log("  About to import LHS expression (type=%d, UhdmType=%s)\n", 
+    log_uhdm_debug("  About to import LHS expression (type=%d, UhdmType=%s)\n", 
         lhs_expr ? lhs_expr->VpiType() : -1,
         lhs_expr ? UHDM::UhdmName(lhs_expr->UhdmType()).c_str() : "null");
     RTLIL::SigSpec lhs = import_expression(lhs_expr);
@@ -1628,19 +1619,19 @@ void UhdmImporter::import_continuous_assign(const cont_assign* uhdm_assign) {
     expression_context_typespec = saved_ctx_ts;
     expression_context_width = 0;
     
-    log("  Continuous assignment: LHS size=%d, RHS size=%d, is_net_decl=%d\n", 
+    log_uhdm_debug("  Continuous assignment: LHS size=%d, RHS size=%d, is_net_decl=%d\n", 
         lhs.size(), rhs.size(), is_net_decl_assign);
     if (lhs.size() > 0) {
-        log("    LHS signal: %s\n", log_signal(lhs));
+        log_uhdm_debug("    LHS signal: %s\n", log_signal(lhs));
         // Check if this is a hierarchical assignment to blk[0].sub.x
         if (lhs_expr && lhs_expr->UhdmType() == uhdmhier_path) {
             const hier_path* hp = any_cast<const hier_path*>(lhs_expr);
             std::string path_name = std::string(hp->VpiName());
-            log("    LHS is hier_path: %s\n", path_name.c_str());
+            log_uhdm_debug("    LHS is hier_path: %s\n", path_name.c_str());
         }
     }
     if (rhs.size() > 0 && rhs.is_fully_const()) {
-        log("    RHS constant: %s\n", rhs.as_const().as_string().c_str());
+        log_uhdm_debug("    RHS constant: %s\n", rhs.as_const().as_string().c_str());
     }
     
     // A zero-width LHS is a no-op assignment — e.g. `man.req.ctl = sub.req.ctl`
@@ -1649,7 +1640,7 @@ void UhdmImporter::import_continuous_assign(const cont_assign* uhdm_assign) {
     // falling through to the connect logic (which throws on the empty vector).
     if (lhs.size() == 0) {
         if (mode_debug)
-            log("    Zero-width LHS in continuous assignment (no-op) — skipping\n");
+            log_uhdm_debug("    Zero-width LHS in continuous assignment (no-op) — skipping\n");
         return;
     }
     if (rhs.size() == 0) {
@@ -1707,7 +1698,7 @@ void UhdmImporter::import_continuous_assign(const cont_assign* uhdm_assign) {
             RTLIL::Wire *w = lhs.as_wire();
             w->attributes[ID::defaultvalue] = rhs.as_const();
             if (mode_debug)
-                log("  Set \\defaultvalue on input port '%s'\n", w->name.c_str());
+                log_uhdm_debug("  Set \\defaultvalue on input port '%s'\n", w->name.c_str());
             return;
         }
 
@@ -1722,7 +1713,7 @@ void UhdmImporter::import_continuous_assign(const cont_assign* uhdm_assign) {
             // Gen-scope net decl with constant RHS — treat as a plain constant driver
             module->connect(lhs, rhs);
             if (mode_debug)
-                log("  Created constant driver for gen-scope net declaration '%s'\n",
+                log_uhdm_debug("  Created constant driver for gen-scope net declaration '%s'\n",
                     lhs.is_wire() ? lhs.as_wire()->name.c_str() : "?");
         } else if (is_constant) {
             // For reg/logic net declaration initializers (e.g. `reg x = -1`),
@@ -1744,7 +1735,7 @@ void UhdmImporter::import_continuous_assign(const cont_assign* uhdm_assign) {
                 sync_always->actions.push_back(RTLIL::SigSig(lhs, rhs));
                 proc->syncs.push_back(sync_always);
                 if (mode_debug)
-                    log("  Created sync-always process for module-level net declaration '%s'\n",
+                    log_uhdm_debug("  Created sync-always process for module-level net declaration '%s'\n",
                         lhs.is_wire() ? lhs.as_wire()->name.c_str() : "?");
             }
         } else {
@@ -1752,7 +1743,7 @@ void UhdmImporter::import_continuous_assign(const cont_assign* uhdm_assign) {
             module->connect(lhs, rhs);
 
             if (mode_debug)
-                log("  Created continuous assignment for net declaration with non-constant expression\n");
+                log_uhdm_debug("  Created continuous assignment for net declaration with non-constant expression\n");
         }
     } else {
         // Regular continuous assignment.
@@ -1784,7 +1775,7 @@ void UhdmImporter::import_parameter(const any* uhdm_param) {
     }
     
     if (mode_debug)
-        log("  Importing parameter: %s\n", param_name.c_str());
+        log_uhdm_debug("  Importing parameter: %s\n", param_name.c_str());
     
     // Get the parameter value
     RTLIL::Const param_value;
@@ -1837,12 +1828,12 @@ void UhdmImporter::import_parameter(const any* uhdm_param) {
                 // the $paramod name (degu SoC tcb_dev_gpio SYS_DAT).
                 param_value = RTLIL::Const(std::stoi(iface_val), 32);
                 has_value = true;
-                log("UHDM: Parameter '%s' = %s (interface param field)\n",
+                log_uhdm_debug("UHDM: Parameter '%s' = %s (interface param field)\n",
                     param_name.c_str(), iface_val.c_str());
             } else if (value_spec.is_fully_const()) {
                 param_value = value_spec.as_const();
                 has_value = true;
-                log("UHDM: Parameter '%s' has value: %s\n", param_name.c_str(),
+                log_uhdm_debug("UHDM: Parameter '%s' has value: %s\n", param_name.c_str(),
                     param_value.as_string().c_str());
             } else {
                 log_warning("UHDM: Parameter '%s' has non-constant value, defaulting to 0\n",
@@ -1851,7 +1842,7 @@ void UhdmImporter::import_parameter(const any* uhdm_param) {
                 has_value = true;
             }
         } else {
-            log("UHDM: Parameter '%s' has no expression, defaulting to 0\n", param_name.c_str());
+            log_uhdm_debug("UHDM: Parameter '%s' has no expression, defaulting to 0\n", param_name.c_str());
             param_value = RTLIL::Const(0, 32);
             has_value = true;
         }
@@ -1869,16 +1860,18 @@ void UhdmImporter::import_parameter(const any* uhdm_param) {
             module->avail_parameters(param_id);
         }
         module->parameter_default_values[param_id] = param_value;
+        parameter_version++;
 
         // Log successful parameter import
-        log("UHDM: Added parameter '%s' to module with value %s\n",
+        log_uhdm_debug("UHDM: Added parameter '%s' to module with value %s\n",
             param_name.c_str(), param_value.as_string().c_str());
     }
 }
 
 // Import a module instance
 void UhdmImporter::import_instance(const module_inst* uhdm_inst) {
-    log("UHDM: import_instance called for '%s' of type '%s'\n", 
+    HeatmapScope heat(this, uhdm_inst);
+    log_uhdm_debug("UHDM: import_instance called for '%s' of type '%s'\n", 
         std::string(uhdm_inst->VpiName()).c_str(), 
         std::string(uhdm_inst->VpiDefName()).c_str());
     
@@ -1974,7 +1967,7 @@ void UhdmImporter::import_instance(const module_inst* uhdm_inst) {
                 cell->setPort(RTLIL::escape_id(pname), conn);
             }
         }
-        log("UHDM: Created internal-cell-type instance '%s' of '%s'\n",
+        log_uhdm_debug("UHDM: Created internal-cell-type instance '%s' of '%s'\n",
             inst_name.c_str(), base_module_name.c_str());
         return;
     }
@@ -2067,14 +2060,14 @@ void UhdmImporter::import_instance(const module_inst* uhdm_inst) {
     }
     
     if (mode_debug)
-        log("  Importing instance: %s of %s\n", inst_name.c_str(), module_name.c_str());
+        log_uhdm_debug("  Importing instance: %s of %s\n", inst_name.c_str(), module_name.c_str());
     
     // Check if the module definition exists
     RTLIL::IdString module_id = RTLIL::escape_id(module_name);
     if (!design->module(module_id)) {
         // Module doesn't exist - import it using the elaborated UHDM instance
         // which has parameter-resolved port widths and fully elaborated generate scopes
-        log("UHDM: Module %s doesn't exist, importing from elaborated instance\n", module_name.c_str());
+        log_uhdm_debug("UHDM: Module %s doesn't exist, importing from elaborated instance\n", module_name.c_str());
 
         // Save current module context
         RTLIL::Module* saved_module = module;
@@ -2162,7 +2155,7 @@ void UhdmImporter::import_instance(const module_inst* uhdm_inst) {
         }
     }
 
-    log("UHDM: Creating cell '%s' of type '%s'\n", inst_name.c_str(), module_id.c_str());
+    log_uhdm_debug("UHDM: Creating cell '%s' of type '%s'\n", inst_name.c_str(), module_id.c_str());
     RTLIL::Cell* cell = module->addCell(new_id(inst_name), module_id);
     
     // Add source attribute to cell
@@ -2175,13 +2168,13 @@ void UhdmImporter::import_instance(const module_inst* uhdm_inst) {
             if (attr_name.empty()) continue;
             cell->attributes[RTLIL::escape_id(attr_name)] = import_attribute_value(attr);
             if (mode_debug)
-                log("UHDM: Added attribute '%s' to cell '%s'\n", attr_name.c_str(), inst_name.c_str());
+                log_uhdm_debug("UHDM: Added attribute '%s' to cell '%s'\n", attr_name.c_str(), inst_name.c_str());
         }
     }
     
     // Import port connections
     if (uhdm_inst->Ports()) {
-        log("UHDM: Processing %d ports for instance\n", (int)uhdm_inst->Ports()->size());
+        log_uhdm_debug("UHDM: Processing %d ports for instance\n", (int)uhdm_inst->Ports()->size());
         int positional_port_idx = 0;
         for (auto port : *uhdm_inst->Ports()) {
             std::string port_name = std::string(port->VpiName());
@@ -2199,7 +2192,7 @@ void UhdmImporter::import_instance(const module_inst* uhdm_inst) {
             // Get the actual connection (high_conn)
             if (port->High_conn()) {
                 const any* high_conn = port->High_conn();
-                log("    Port %s has High_conn of type %s\n", port_name.c_str(), UhdmName(high_conn->UhdmType()).c_str());
+                log_uhdm_debug("    Port %s has High_conn of type %s\n", port_name.c_str(), UhdmName(high_conn->UhdmType()).c_str());
 
                 // An explicitly EMPTY named port connection (`.tcb_xen()`) is
                 // encoded by Surelog as a `vpiNullOp` operation.  It means "leave
@@ -2209,7 +2202,7 @@ void UhdmImporter::import_instance(const module_inst* uhdm_inst) {
                 // unused `tcb_xen` execute-enable output is tied off this way.
                 if (high_conn->UhdmType() == uhdmoperation &&
                     any_cast<const operation*>(high_conn)->VpiOpType() == vpiNullOp) {
-                    log("    Port %s has an empty connection (.%s()); leaving unconnected\n",
+                    log_uhdm_debug("    Port %s has an empty connection (.%s()); leaving unconnected\n",
                         port_name.c_str(), port_name.c_str());
                     continue;
                 }
@@ -2222,7 +2215,7 @@ void UhdmImporter::import_instance(const module_inst* uhdm_inst) {
                     if (actual && actual->UhdmType() == uhdminterface_inst) {
                         const interface_inst* iface = any_cast<const interface_inst*>(actual);
                         std::string iface_name = std::string(iface->VpiName());
-                        log("    Port %s is connected to interface %s\n", port_name.c_str(), iface_name.c_str());
+                        log_uhdm_debug("    Port %s is connected to interface %s\n", port_name.c_str(), iface_name.c_str());
                         
                         // For interface connections, we need to expand the interface signals
                         // and connect them individually as bus.a, bus.b, bus.c
@@ -2235,7 +2228,7 @@ void UhdmImporter::import_instance(const module_inst* uhdm_inst) {
                                 if (name_map.count(full_signal_name)) {
                                     RTLIL::Wire* w = name_map[full_signal_name];
                                     cell->setPort(RTLIL::escape_id(port_signal_name), w);
-                                    log("      Connected interface signal %s to port %s\n", full_signal_name.c_str(), port_signal_name.c_str());
+                                    log_uhdm_debug("      Connected interface signal %s to port %s\n", full_signal_name.c_str(), port_signal_name.c_str());
                                 }
                             }
                         }
@@ -2261,7 +2254,7 @@ void UhdmImporter::import_instance(const module_inst* uhdm_inst) {
                         std::string elem = base + "[" + std::to_string(idx) + "]";
                         auto it = iface_inst_vars_.find(elem);
                         if (it != iface_inst_vars_.end()) {
-                            log("    Port %s connected to interface-array element %s\n",
+                            log_uhdm_debug("    Port %s connected to interface-array element %s\n",
                                 port_name.c_str(), elem.c_str());
                             for (auto &var_name : it->second) {
                                 std::string full_signal_name = elem + "." + var_name;
@@ -2288,12 +2281,12 @@ void UhdmImporter::import_instance(const module_inst* uhdm_inst) {
                     // Check if the target module has this port marked as an interface port
                     RTLIL::Module* target_module = design->module(cell->type);
                     if (!target_module) {
-                        log("    Target module not found for cell type: %s\n", cell->type.c_str());
+                        log_uhdm_debug("    Target module not found for cell type: %s\n", cell->type.c_str());
                     }
                     if (target_module) {
                         RTLIL::Wire* port_wire = target_module->wire(RTLIL::escape_id(port_name));
                         if (!port_wire) {
-                            log("    Port wire not found for port: %s\n", port_name.c_str());
+                            log_uhdm_debug("    Port wire not found for port: %s\n", port_name.c_str());
                         }
                         
                         // For signed constants connected to wider ports, create a signed
@@ -2316,12 +2309,12 @@ void UhdmImporter::import_instance(const module_inst* uhdm_inst) {
                                 signed_wire->is_signed = true;
                                 module->connect(RTLIL::SigSpec(signed_wire), actual_sig);
                                 actual_sig = RTLIL::SigSpec(signed_wire);
-                                log("    Created signed intermediate wire for signed constant on port %s\n", port_name.c_str());
+                                log_uhdm_debug("    Created signed intermediate wire for signed constant on port %s\n", port_name.c_str());
                             }
                         }
                         
                         if (port_wire && port_wire->attributes.count(RTLIL::escape_id("interface_port"))) {
-                            log("    Port %s is an interface port, creating connection wire\n", port_name.c_str());
+                            log_uhdm_debug("    Port %s is an interface port, creating connection wire\n", port_name.c_str());
                             
                             // For interface ports, we need to create a connection wire
                             // The wire name should follow Yosys convention: $dummywireforinterface\<interface_name>
@@ -2342,7 +2335,7 @@ void UhdmImporter::import_instance(const module_inst* uhdm_inst) {
                             if (!conn_wire) {
                                 conn_wire = module->addWire(RTLIL::escape_id(interface_wire_name), 1);
                                 conn_wire->attributes[RTLIL::escape_id("is_interface")] = RTLIL::Const(1);
-                                log("    Created interface connection wire: %s\n", interface_wire_name.c_str());
+                                log_uhdm_debug("    Created interface connection wire: %s\n", interface_wire_name.c_str());
                             }
                             
                             // Connect the cell port to this wire
@@ -2355,13 +2348,13 @@ void UhdmImporter::import_instance(const module_inst* uhdm_inst) {
                     log_warning("Port %s has empty connection\n", port_name.c_str());
                 }
                 
-                log("    Connected port %s to signal of width %d\n", port_name.c_str(), actual_sig.size());
+                log_uhdm_debug("    Connected port %s to signal of width %d\n", port_name.c_str(), actual_sig.size());
             } else {
-                log("    Port %s has no connection (High_conn)\n", port_name.c_str());
+                log_uhdm_debug("    Port %s has no connection (High_conn)\n", port_name.c_str());
             }
         }
     } else {
-        log("UHDM: No ports found for instance\n");
+        log_uhdm_debug("UHDM: No ports found for instance\n");
     }
     
     // Set parameters on the cell
@@ -2372,13 +2365,13 @@ void UhdmImporter::import_instance(const module_inst* uhdm_inst) {
 
 // Create a wire with the given name and width
 RTLIL::Wire* UhdmImporter::create_wire(const std::string& name, int width, bool upto, int start_offset) {
-    log("UHDM: Creating wire '%s' (width=%d, upto=%d, start_offset=%d, mode_keep_names=%s)\n", 
+    log_uhdm_debug("UHDM: Creating wire '%s' (width=%d, upto=%d, start_offset=%d, mode_keep_names=%s)\n", 
         name.c_str(), width, upto ? 1 : 0, start_offset, mode_keep_names ? "true" : "false");
     
     // First check if we already have this wire by base name
     RTLIL::IdString base_name = RTLIL::escape_id(name);
     if (module->wire(base_name)) {
-        log("UHDM: Wire '%s' already exists, returning existing wire\n", base_name.c_str());
+        log_uhdm_debug("UHDM: Wire '%s' already exists, returning existing wire\n", base_name.c_str());
         return module->wire(base_name);
     }
     
@@ -2387,17 +2380,17 @@ RTLIL::Wire* UhdmImporter::create_wire(const std::string& name, int width, bool
     
     // Double-check after name generation
     if (module->wire(wire_name)) {
-        log("UHDM: Wire '%s' already exists after uniquify, returning existing wire\n", wire_name.c_str());
+        log_uhdm_debug("UHDM: Wire '%s' already exists after uniquify, returning existing wire\n", wire_name.c_str());
         return module->wire(wire_name);
     }
     
-    log("UHDM: About to call module->addWire('%s', %d)\n", wire_name.c_str(), width);
+    log_uhdm_debug("UHDM: About to call module->addWire('%s', %d)\n", wire_name.c_str(), width);
     
     try {
         RTLIL::Wire* w = module->addWire(wire_name, width);
         w->upto = upto;
         w->start_offset = start_offset;
-        log("UHDM: Successfully created wire '%s' (upto=%d, start_offset=%d)\n", wire_name.c_str(), w->upto ? 1 : 0, w->start_offset);
+        log_uhdm_debug("UHDM: Successfully created wire '%s' (upto=%d, start_offset=%d)\n", wire_name.c_str(), w->upto ? 1 : 0, w->start_offset);
         
         // Check if this wire is being created for an interface connection
         // Interface connection wires have names like $dummywireforinterface\bus1
@@ -2405,7 +2398,7 @@ RTLIL::Wire* UhdmImporter::create_wire(const std::string& name, int width, bool
         if (base_name.find("$dummywireforinterface\\") == 0) {
             // This is an interface connection wire
             w->attributes[RTLIL::escape_id("is_interface")] = RTLIL::Const(1);
-            log("UHDM: Marked wire '%s' as interface connection\n", wire_name.c_str());
+            log_uhdm_debug("UHDM: Marked wire '%s' as interface connection\n", wire_name.c_str());
         }
         
         return w;
@@ -2473,16 +2466,16 @@ bool UhdmImporter::is_typespec_signed(const UHDM::any* ts) {
 // Get width from UHDM object
 int UhdmImporter::get_width(const any* uhdm_obj, const UHDM::scope* inst) {
     if (!uhdm_obj) {
-        log("UHDM: get_width called with null object\n");
+        log_uhdm_debug("UHDM: get_width called with null object\n");
         return 1;
     }
     
     try {
-        log("UHDM: get_width analyzing object type\n");
+        log_uhdm_debug("UHDM: get_width analyzing object type\n");
         
         // Check if it's a hier_path (hierarchical reference like in_struct.base.data)
-        if (auto hier = dynamic_cast<const UHDM::hier_path*>(uhdm_obj)) {
-            log("UHDM: Found hier_path object\n");
+        if (auto hier = uhdm_cast<UHDM::hier_path>(uhdm_obj)) {
+            log_uhdm_debug("UHDM: Found hier_path object\n");
             
             // Use ExprEval to get the typespec of the hier_path
             ExprEval eval;
@@ -2499,25 +2492,25 @@ int UhdmImporter::get_width(const any* uhdm_obj, const UHDM::scope* inst) {
             );
             
             if (!invalidValue && typespec_obj) {
-                log("UHDM: decodeHierPath returned typespec\n");
+                log_uhdm_debug("UHDM: decodeHierPath returned typespec\n");
                 
                 // Get the size from the typespec
                 // From Surelog: eval.size(typespec, invalidValue, context, nullptr, !sizeMode)
                 uint64_t size = eval.size(typespec_obj, invalidValue, inst, typespec_obj, true, false);
                 if (!invalidValue && size > 0) {
-                    log("UHDM: ExprEval::size returned %lu\n", (unsigned long)size);
+                    log_uhdm_debug("UHDM: ExprEval::size returned %lu\n", (unsigned long)size);
                     return size;
                 } else {
-                    log("UHDM: ExprEval::size failed or returned 0\n");
+                    log_uhdm_debug("UHDM: ExprEval::size failed or returned 0\n");
                 }
             } else {
-                log("UHDM: decodeHierPath failed to return typespec\n");
+                log_uhdm_debug("UHDM: decodeHierPath failed to return typespec\n");
             }
         }
         
         // Check if it's a port and try to get typespec
-        if (auto port = dynamic_cast<const UHDM::port*>(uhdm_obj)) {
-            log("UHDM: Found port object\n");
+        if (auto port = uhdm_cast<UHDM::port>(uhdm_obj)) {
+            log_uhdm_debug("UHDM: Found port object\n");
             // An ARRAY of interface ports (`myif.man m [N]`): the array
             // dimension is NOT in the port typespec (which resolves to a single
             // interface_typespec) — it lives on the Low_conn's interface_array.
@@ -2548,7 +2541,7 @@ int UhdmImporter::get_width(const any* uhdm_obj, const UHDM::scope* inst) {
                             }
                         }
                         if (n >= 1) {
-                            log("UHDM: interface-array port '%s', %d element(s) -> width %d\n",
+                            log_uhdm_debug("UHDM: interface-array port '%s', %d element(s) -> width %d\n",
                                 std::string(port->VpiName()).c_str(), n, -n);
                             return -n;
                         }
@@ -2570,7 +2563,7 @@ int UhdmImporter::get_width(const any* uhdm_obj, const UHDM::scope* inst) {
                              at == uhdmarray_var || at == uhdmunion_var)) {
                             int aw = get_width(a, inst);
                             if (aw > 1) {
-                                log("UHDM: Port '%s' width from Low_conn %s: %d\n",
+                                log_uhdm_debug("UHDM: Port '%s' width from Low_conn %s: %d\n",
                                     std::string(port->VpiName()).c_str(),
                                     UHDM::UhdmName(at).c_str(), aw);
                                 return aw;
@@ -2580,7 +2573,7 @@ int UhdmImporter::get_width(const any* uhdm_obj, const UHDM::scope* inst) {
                 }
             }
             if (auto typespec = port->Typespec()) {
-                log("UHDM: Port has typespec, calling get_width_from_typespec\n");
+                log_uhdm_debug("UHDM: Port has typespec, calling get_width_from_typespec\n");
                 int w = get_width_from_typespec(typespec, inst);
                 // The elaborated port typespec range can carry an UNBOUND reference
                 // that neither the frontend nor Surelog's ExprEval can resolve
@@ -2614,7 +2607,7 @@ int UhdmImporter::get_width(const any* uhdm_obj, const UHDM::scope* inst) {
                                      at == uhdmbit_var)) {
                                     int aw = get_width(a, inst);
                                     if (aw > 1) {
-                                        log("UHDM: Port '%s' width from Low_conn %s var: %d\n",
+                                        log_uhdm_debug("UHDM: Port '%s' width from Low_conn %s var: %d\n",
                                             std::string(port->VpiName()).c_str(),
                                             UHDM::UhdmName(at).c_str(), aw);
                                         return aw;
@@ -2626,14 +2619,14 @@ int UhdmImporter::get_width(const any* uhdm_obj, const UHDM::scope* inst) {
                     int wd = width_from_def_port(std::string(inst->VpiDefName()),
                                                  std::string(port->VpiName()), inst);
                     if (wd > w) {
-                        log("UHDM: Port '%s' width recovered from definition typespec: %d\n",
+                        log_uhdm_debug("UHDM: Port '%s' width recovered from definition typespec: %d\n",
                             std::string(port->VpiName()).c_str(), wd);
                         return wd;
                     }
                 }
                 return w;
             } else {
-                log("UHDM: Port has no typespec\n");
+                log_uhdm_debug("UHDM: Port has no typespec\n");
             }
         }
         
@@ -2647,7 +2640,7 @@ int UhdmImporter::get_width(const any* uhdm_obj, const UHDM::scope* inst) {
         // submodule port (id_stage.fetch_entry_i = 366 bits) was resized from
         // 1 bit at flatten, corrupting the connection.  Checked BEFORE the
         // generic net branch (which returns 1 on the null typespec).
-        if (auto pan = dynamic_cast<const UHDM::packed_array_net*>(uhdm_obj)) {
+        if (auto pan = uhdm_cast<UHDM::packed_array_net>(uhdm_obj)) {
             int range_total = 1;
             if (pan->Ranges()) {
                 for (auto r : *pan->Ranges()) {
@@ -2662,19 +2655,19 @@ int UhdmImporter::get_width(const any* uhdm_obj, const UHDM::scope* inst) {
             int elem_width = 1;
             if (pan->Elements() && !pan->Elements()->empty())
                 elem_width = get_width((*pan->Elements())[0], inst);
-            log("UHDM: packed_array_net width = %d * %d = %d\n",
+            log_uhdm_debug("UHDM: packed_array_net width = %d * %d = %d\n",
                 elem_width, range_total, elem_width * range_total);
             return elem_width * range_total;
         }
 
         // Check if it's a net and try to get typespec
         if (auto net = dynamic_cast<const UHDM::net*>(uhdm_obj)) {
-            log("UHDM: Found net object\n");
+            log_uhdm_debug("UHDM: Found net object\n");
             if (auto typespec = net->Typespec()) {
-                log("UHDM: Net has typespec, calling get_width_from_typespec\n");
+                log_uhdm_debug("UHDM: Net has typespec, calling get_width_from_typespec\n");
                 return get_width_from_typespec(typespec, inst);
             } else {
-                log("UHDM: Net has no typespec\n");
+                log_uhdm_debug("UHDM: Net has no typespec\n");
             }
         }
 
@@ -2684,7 +2677,7 @@ int UhdmImporter::get_width(const any* uhdm_obj, const UHDM::scope* inst) {
         // `typedef u [0:1] yeah; yeah a;`).  Pick the direct-dims path
         // when present, otherwise fall through to the generic typespec
         // handler below.
-        if (auto pav = dynamic_cast<const UHDM::packed_array_var*>(uhdm_obj)) {
+        if (auto pav = uhdm_cast<UHDM::packed_array_var>(uhdm_obj)) {
             // Function-return case: `logic4 [1:0] f(...)` produces a
             // packed_array_var whose Typespec is a logic_typespec with
             // Elem_typespec (encoding the full type), but whose
@@ -2699,13 +2692,13 @@ int UhdmImporter::get_width(const any* uhdm_obj, const UHDM::scope* inst) {
                     if (a->UhdmType() == uhdmpacked_array_typespec) {
                         typespec_has_full_info = true;
                     } else if (a->UhdmType() == uhdmlogic_typespec) {
-                        auto lt = dynamic_cast<const UHDM::logic_typespec*>(a);
+                        auto lt = uhdm_cast<UHDM::logic_typespec>(a);
                         if (lt && lt->Elem_typespec() != nullptr)
                             typespec_has_full_info = true;
                     }
                     if (typespec_has_full_info) {
                         int w = get_width_from_typespec(a, inst);
-                        log("UHDM: packed_array_var width from typespec = %d\n", w);
+                        log_uhdm_debug("UHDM: packed_array_var width from typespec = %d\n", w);
                         return w;
                     }
                 }
@@ -2714,7 +2707,7 @@ int UhdmImporter::get_width(const any* uhdm_obj, const UHDM::scope* inst) {
             bool has_direct = (pav->Ranges() && !pav->Ranges()->empty()) &&
                               (pav->Elements() && !pav->Elements()->empty());
             if (has_direct) {
-                log("UHDM: Found packed_array_var with direct ranges/elements\n");
+                log_uhdm_debug("UHDM: Found packed_array_var with direct ranges/elements\n");
                 int range_total = 1;
                 for (auto r : *pav->Ranges()) {
                     if (r->Left_expr() && r->Right_expr()) {
@@ -2742,7 +2735,7 @@ int UhdmImporter::get_width(const any* uhdm_obj, const UHDM::scope* inst) {
                     }
                 }
                 int total = range_total * elem_width;
-                log("UHDM: packed_array_var width = %d (ranges=%d, elem_w=%d)\n",
+                log_uhdm_debug("UHDM: packed_array_var width = %d (ranges=%d, elem_w=%d)\n",
                     total, range_total, elem_width);
                 return total;
             }
@@ -2751,9 +2744,9 @@ int UhdmImporter::get_width(const any* uhdm_obj, const UHDM::scope* inst) {
 
         // Check if it's a net and try to get typespec
         if (auto variable = dynamic_cast<const UHDM::variables*>(uhdm_obj)) {
-            log("UHDM: Found net object\n");
+            log_uhdm_debug("UHDM: Found net object\n");
             if (auto typespec = variable->Typespec()) {
-                log("UHDM: Net has typespec, calling get_width_from_typespec\n");
+                log_uhdm_debug("UHDM: Net has typespec, calling get_width_from_typespec\n");
                 int w = get_width_from_typespec(typespec, inst);
                 // The elaborated var range may carry a substituted override
                 // hier_path (`[CFG_LSU.BUS.ADR-1:0]`, degu SoC tcb_lite_lib_decoder
@@ -2761,7 +2754,7 @@ int UhdmImporter::get_width(const any* uhdm_obj, const UHDM::scope* inst) {
                 // collapses to 1.  Recover from the AllModules DEFINITION var
                 // typespec, whose range refers to the module's own parameter.
                 if (w >= 0 && w <= 1) {
-                    if (auto mi = dynamic_cast<const UHDM::module_inst*>(inst)) {
+                    if (auto mi = uhdm_cast<UHDM::module_inst>(inst)) {
                         int wd = width_from_def_var(std::string(mi->VpiDefName()),
                                                     std::string(variable->VpiName()),
                                                     inst);
@@ -2770,14 +2763,14 @@ int UhdmImporter::get_width(const any* uhdm_obj, const UHDM::scope* inst) {
                 }
                 return w;
             } else {
-                log("UHDM: Net has no typespec\n");
+                log_uhdm_debug("UHDM: Net has no typespec\n");
             }
         }
 
-        if (auto variable = dynamic_cast<const UHDM::io_decl*>(uhdm_obj)) {
-            log("UHDM: Found net object\n");
+        if (auto variable = uhdm_cast<UHDM::io_decl>(uhdm_obj)) {
+            log_uhdm_debug("UHDM: Found net object\n");
             if (auto typespec = variable->Typespec()) {
-                log("UHDM: Net has typespec, calling get_width_from_typespec\n");
+                log_uhdm_debug("UHDM: Net has typespec, calling get_width_from_typespec\n");
                 int w = get_width_from_typespec(typespec, inst);
                 // Multiply by any UNPACKED array dimensions carried on the
                 // io_decl itself (`logic [2:0] mat [3:0]` -> packed 3 * unpacked
@@ -2793,17 +2786,17 @@ int UhdmImporter::get_width(const any* uhdm_obj, const UHDM::scope* inst) {
                     }
                 return w;
             } else {
-                log("UHDM: Net has no typespec\n");
+                log_uhdm_debug("UHDM: Net has no typespec\n");
             }
         }
         
-        log("UHDM: Object is neither port nor net, or no typespec found\n");
+        log_uhdm_debug("UHDM: Object is neither port nor net, or no typespec found\n");
         
     } catch (...) {
-        log("UHDM: Exception in get_width\n");
+        log_uhdm_debug("UHDM: Exception in get_width\n");
     }
     
-    log("UHDM: Defaulting to width=1\n");
+    log_uhdm_debug("UHDM: Defaulting to width=1\n");
     return 1;
 }
 
@@ -2852,7 +2845,7 @@ const UHDM::typespec* UhdmImporter::resolve_type_param_typespec(
             auto itp = any_cast<const UHDM::type_parameter*>(ip);
             if (itp->Typespec() && itp->Typespec()->Actual_typespec() &&
                 itp->Typespec()->Actual_typespec() != ts_c) {
-                log("UHDM: type-param member default '%s' -> instance-bound type\n",
+                log_uhdm_debug("UHDM: type-param member default '%s' -> instance-bound type\n",
                     std::string(dp->VpiName()).c_str());
                 return itp->Typespec()->Actual_typespec();
             }
@@ -2872,18 +2865,18 @@ int UhdmImporter::get_width_from_typespec(const UHDM::any* typespec, const UHDM:
     }
 
     try {
-        log("UHDM: Analyzing typespec for width determination\n");
-        log("UHDM: Typespec UhdmType = %d\n", typespec->UhdmType());
+        log_uhdm_debug("UHDM: Analyzing typespec for width determination\n");
+        log_uhdm_debug("UHDM: Typespec UhdmType = %d\n", typespec->UhdmType());
         
         // Check if this is a ref_typespec and follow the reference
         if (typespec->UhdmType() == uhdmref_typespec) {
-            log("UHDM: Found ref_typespec, following reference\n");
+            log_uhdm_debug("UHDM: Found ref_typespec, following reference\n");
             if (auto ref_typespec = dynamic_cast<const UHDM::ref_typespec*>(typespec)) {
                 if (auto actual = ref_typespec->Actual_typespec()) {
-                    log("UHDM: Following to actual typespec (UhdmType = %s)\n", UhdmName(actual->UhdmType()).c_str());
+                    log_uhdm_debug("UHDM: Following to actual typespec (UhdmType = %s)\n", UhdmName(actual->UhdmType()).c_str());
                     // Check if the actual type is an interface
                     if (actual->UhdmType() == uhdminterface_typespec) {
-                        log("UHDM: Found interface_typespec through reference\n");
+                        log_uhdm_debug("UHDM: Found interface_typespec through reference\n");
                         return -1;  // Special value to indicate interface type
                     }
                     // Otherwise recurse to get the actual width
@@ -2891,12 +2884,12 @@ int UhdmImporter::get_width_from_typespec(const UHDM::any* typespec, const UHDM:
                 } else {
                     // Try to resolve package type reference
                     std::string type_name = std::string(ref_typespec->VpiName());
-                    log("UHDM: ref_typespec has no actual_typespec, checking package types for: %s\n", type_name.c_str());
+                    log_uhdm_debug("UHDM: ref_typespec has no actual_typespec, checking package types for: %s\n", type_name.c_str());
                     
                     // Check if this is a package type reference
                     if (package_typespec_map.count(type_name)) {
                         const UHDM::typespec* pkg_typespec = package_typespec_map.at(type_name);
-                        log("UHDM: Found package typespec for %s\n", type_name.c_str());
+                        log_uhdm_debug("UHDM: Found package typespec for %s\n", type_name.c_str());
                         return get_width_from_typespec(pkg_typespec, inst);
                     }
                     
@@ -2905,7 +2898,7 @@ int UhdmImporter::get_width_from_typespec(const UHDM::any* typespec, const UHDM:
                     if (colonPos != std::string::npos) {
                         if (package_typespec_map.count(type_name)) {
                             const UHDM::typespec* pkg_typespec = package_typespec_map.at(type_name);
-                            log("UHDM: Found package typespec for qualified name %s\n", type_name.c_str());
+                            log_uhdm_debug("UHDM: Found package typespec for qualified name %s\n", type_name.c_str());
                             return get_width_from_typespec(pkg_typespec, inst);
                         }
                     }
@@ -2915,7 +2908,7 @@ int UhdmImporter::get_width_from_typespec(const UHDM::any* typespec, const UHDM:
         
         // Check if this is an interface typespec
         if (typespec->UhdmType() == uhdminterface_typespec) {
-            log("UHDM: Found interface_typespec, interface ports don't have a simple width\n");
+            log_uhdm_debug("UHDM: Found interface_typespec, interface ports don't have a simple width\n");
             // Interface ports are special - they don't have a width
             // They represent a bundle of signals
             return -1;  // Special value to indicate interface type
@@ -2950,37 +2943,37 @@ int UhdmImporter::get_width_from_typespec(const UHDM::any* typespec, const UHDM:
                     }
                 }
                 if (n < 1) n = 1;
-                log("UHDM: interface-array typespec, %d element(s) -> width %d\n", n, -n);
+                log_uhdm_debug("UHDM: interface-array typespec, %d element(s) -> width %d\n", n, -n);
                 return -n;
             }
         }
 
         // Check if this is an enum typespec - need to get the base type
         if (typespec->UhdmType() == uhdmenum_typespec) {
-            log("UHDM: Found enum_typespec, getting base type\n");
+            log_uhdm_debug("UHDM: Found enum_typespec, getting base type\n");
             if (auto enum_typespec = dynamic_cast<const UHDM::enum_typespec*>(typespec)) {
                 // Get the base typespec - this defines the actual width
                 const any* base_typespec = enum_typespec->Base_typespec();
                 
                 if (base_typespec) {
-                    log("UHDM: Found base typespec for enum (type=%d)\n", base_typespec->UhdmType());
+                    log_uhdm_debug("UHDM: Found base typespec for enum (type=%d)\n", base_typespec->UhdmType());
                     // Check if base_typespec is a ref_typespec that needs special handling
                     if (base_typespec->UhdmType() == uhdmref_typespec) {
                         auto base_ref = dynamic_cast<const UHDM::ref_typespec*>(base_typespec);
                         if (base_ref) {
-                            log("UHDM: Base is a ref_typespec, name=%s\n", std::string(base_ref->VpiName()).c_str());
+                            log_uhdm_debug("UHDM: Base is a ref_typespec, name=%s\n", std::string(base_ref->VpiName()).c_str());
                             // Try to get the Actual typespec
                             if (base_ref->Actual_typespec()) {
-                                log("UHDM: ref_typespec has Actual_typespec\n");
+                                log_uhdm_debug("UHDM: ref_typespec has Actual_typespec\n");
                             } else {
-                                log("UHDM: ref_typespec has NO Actual_typespec\n");
+                                log_uhdm_debug("UHDM: ref_typespec has NO Actual_typespec\n");
                             }
                         }
                     }
                     return get_width_from_typespec(base_typespec, inst);
                 } else {
                     // No explicit base type means default int type (32 bits in SystemVerilog)
-                    log("UHDM: No base typespec for enum, defaulting to 32 bits\n");
+                    log_uhdm_debug("UHDM: No base typespec for enum, defaulting to 32 bits\n");
                     return 32;
                 }
             }
@@ -2990,7 +2983,7 @@ int UhdmImporter::get_width_from_typespec(const UHDM::any* typespec, const UHDM:
         if (typespec->UhdmType() == uhdmref_typespec) {
             if (mode_debug) {
                 UHDM::decompile(typespec);
-                log("UHDM: ref_typespec without actual - defaulting to width 32 (int)\n");
+                log_uhdm_debug("UHDM: ref_typespec without actual - defaulting to width 32 (int)\n");
             }
             return 32;
         }
@@ -3042,7 +3035,7 @@ int UhdmImporter::get_width_from_typespec(const UHDM::any* typespec, const UHDM:
                     force_const_fold = saved_fcf;
                 }
                 int total = elem_width * range_total;
-                log("UHDM: array_typespec: elem_w=%d, range_total=%d, total=%d\n",
+                log_uhdm_debug("UHDM: array_typespec: elem_w=%d, range_total=%d, total=%d\n",
                     elem_width, range_total, total);
                 return total;
             }
@@ -3088,7 +3081,7 @@ int UhdmImporter::get_width_from_typespec(const UHDM::any* typespec, const UHDM:
                     force_const_fold = saved_fcf;
                 }
                 int total = elem_width * range_total;
-                log("UHDM: packed_array_typespec: elem_w=%d, range_total=%d, total=%d\n",
+                log_uhdm_debug("UHDM: packed_array_typespec: elem_w=%d, range_total=%d, total=%d\n",
                     elem_width, range_total, total);
                 return total;
             }
@@ -3108,7 +3101,7 @@ int UhdmImporter::get_width_from_typespec(const UHDM::any* typespec, const UHDM:
                     }
                 }
                 if (max_width > 0) {
-                    log("UHDM: union_typespec width = %d (widest member)\n", max_width);
+                    log_uhdm_debug("UHDM: union_typespec width = %d (widest member)\n", max_width);
                     return max_width;
                 }
             }
@@ -3131,7 +3124,7 @@ int UhdmImporter::get_width_from_typespec(const UHDM::any* typespec, const UHDM:
                     }
                 }
                 if (total > 0) {
-                    log("UHDM: struct_typespec width = %d (sum of members)\n", total);
+                    log_uhdm_debug("UHDM: struct_typespec width = %d (sum of members)\n", total);
                     return total;
                 }
             }
@@ -3150,7 +3143,7 @@ int UhdmImporter::get_width_from_typespec(const UHDM::any* typespec, const UHDM:
                             total *= std::abs(ls.as_int() - rs.as_int()) + 1;
                     }
                 }
-                log("UHDM: bit_typespec width = %d\n", total);
+                log_uhdm_debug("UHDM: bit_typespec width = %d\n", total);
                 return total;
             }
             // No range → single bit.
@@ -3190,7 +3183,7 @@ int UhdmImporter::get_width_from_typespec(const UHDM::any* typespec, const UHDM:
                         // arbiters, whose `parameter int unsigned N = 0`
                         // yields exactly this range).
                         int range_size = std::abs(ls.as_int() - rs.as_int()) + 1;
-                        log("UHDM: logic_typespec simple range width = %d\n", range_size);
+                        log_uhdm_debug("UHDM: logic_typespec simple range width = %d\n", range_size);
                         return range_size;
                     }
                 }
@@ -3218,7 +3211,7 @@ int UhdmImporter::get_width_from_typespec(const UHDM::any* typespec, const UHDM:
                     if (elem_is_packed_array) {
                         // Typedef alias: elem already is the full packed array, just use its width
                         int total = get_width_from_typespec(elem_actual, inst);
-                        log("UHDM: logic_typespec with packed-array Elem_typespec (typedef alias): total=%d\n", total);
+                        log_uhdm_debug("UHDM: logic_typespec with packed-array Elem_typespec (typedef alias): total=%d\n", total);
                         return total;
                     }
                     int elem_width = get_width_from_typespec(elem_actual, inst);
@@ -3232,7 +3225,7 @@ int UhdmImporter::get_width_from_typespec(const UHDM::any* typespec, const UHDM:
                                 int r = right_spec.as_int();
                                 int range_size = abs(l - r) + 1;
                                 int total = elem_width * range_size;
-                                log("UHDM: logic_typespec with Elem_typespec: elem_width=%d, range_size=%d, total=%d\n",
+                                log_uhdm_debug("UHDM: logic_typespec with Elem_typespec: elem_width=%d, range_size=%d, total=%d\n",
                                     elem_width, range_size, total);
                                 return total;
                             }
@@ -3251,63 +3244,76 @@ int UhdmImporter::get_width_from_typespec(const UHDM::any* typespec, const UHDM:
         uint64_t size = eval.size(typespec, invalidValue, inst, typespec, true);
         
         if (!invalidValue && size > 0) {
-            log("UHDM: ExprEval returned size=%llu for typespec\n", (unsigned long long)size);
+            log_uhdm_debug("UHDM: ExprEval returned size=%llu for typespec\n", (unsigned long long)size);
             return (int)size;
         } else {
-            log("UHDM: ExprEval failed or returned invalid size, defaulting to 1\n");
+            log_uhdm_debug("UHDM: ExprEval failed or returned invalid size, defaulting to 1\n");
         }
         
     } catch (const std::exception& e) {
-        log("UHDM: Exception in get_width_from_typespec: %s\n", e.what());
+        log_uhdm_debug("UHDM: Exception in get_width_from_typespec: %s\n", e.what());
     } catch (...) {
-        log("UHDM: Unknown exception in get_width_from_typespec\n");
+        log_uhdm_debug("UHDM: Unknown exception in get_width_from_typespec\n");
     }
     
     return 1;  // Default to 1 bit
 }
 
-// Get source attribute string from UHDM object
-std::string UhdmImporter::get_src_attribute(const any* uhdm_obj) {
-    if (!uhdm_obj) return "";
-    
-    try {
-        // Get the file name
-        std::string filename;
-        if (!uhdm_obj->VpiFile().empty()) {
-            std::string full_path = std::string(uhdm_obj->VpiFile());
-            // Extract just the filename from the path
-            size_t last_slash = full_path.find_last_of("/\\");
-            if (last_slash != std::string::npos) {
-                filename = full_path.substr(last_slash + 1);
-            } else {
-                filename = full_path;
-            }
-        } else {
-            return "";  // No file info available
-        }
-        
-        // Get line and column information
-        int line = uhdm_obj->VpiLineNo();
-        int col = uhdm_obj->VpiColumnNo();
-        int end_line = uhdm_obj->VpiEndLineNo();
-        int end_col = uhdm_obj->VpiEndColumnNo();
-        
-        // Format the source attribute string
-        return filename + ":" + std::to_string(line) + "." + std::to_string(col) + 
-               "-" + std::to_string(end_line) + "." + std::to_string(end_col);
-               
-    } catch (...) {
-        // If UHDM API access fails, return empty string
-        return "";
+// Index of the path-stripped file name of a UHDM VpiFile in src_files,
+// interned once per file.  VpiFile() views the serializer's symbol table, so
+// a file is looked up by that view's address first; only a view not seen yet
+// pays for a std::string key.
+int UhdmImporter::src_file_id(std::string_view path) {
+    auto vit = src_file_views.find(path.data());
+    if (vit != src_file_views.end() && vit->second.first == path.size())
+        return vit->second.second;
+    std::string key(path);
+    int id;
+    auto it = src_file_ids.find(key);
+    if (it != src_file_ids.end()) {
+        id = it->second;
+    } else {
+        size_t last_slash = path.find_last_of("/\\");
+        src_files.emplace_back(last_slash != std::string_view::npos ? path.substr(last_slash + 1) : path);
+        id = GetSize(src_files) - 1;
+        src_file_ids.emplace(std::move(key), id);
     }
+    src_file_views[path.data()] = {path.size(), id};
+    return id;
+}
+
+// Get source attribute string from UHDM object.  Always full precision
+// ("file:l.c-el.ec"): besides `src` attributes it names processes and cells.
+std::string UhdmImporter::get_src_attribute(const any* uhdm_obj) {
+    if (!uhdm_obj || uhdm_obj->VpiFile().empty()) return "";
+    return src_files[src_file_id(uhdm_obj->VpiFile())] + ":" +
+           std::to_string(uhdm_obj->VpiLineNo()) + "." + std::to_string(uhdm_obj->VpiColumnNo()) + "-" +
+           std::to_string(uhdm_obj->VpiEndLineNo()) + "." + std::to_string(uhdm_obj->VpiEndColumnNo());
 }
 
-// Add source attribute to RTLIL object
+// Add source attribute to RTLIL object.  Objects from the same source range
+// (every cell, wire and case rule of one statement) share one cached Const,
+// so each distinct location is formatted once.  `-src=line` keeps only the
+// start line, `-nosrc` drops the attribute.
 void UhdmImporter::add_src_attribute(dict<RTLIL::IdString, RTLIL::Const>& attributes, const any* uhdm_obj) {
-    std::string src = get_src_attribute(uhdm_obj);
-    if (!src.empty()) {
-        attributes[ID::src] = RTLIL::Const(src);
+    if (!uhdm_obj || src_mode == UhdmSrcMode::None) return;
+    std::string_view path = uhdm_obj->VpiFile();
+    if (path.empty()) return;
+    bool line_only = (src_mode == UhdmSrcMode::Line);
+    std::tuple<int, int, int, int, int> key(
+        src_file_id(path), uhdm_obj->VpiLineNo(),
+        line_only ? 0 : uhdm_obj->VpiColumnNo(),
+        line_only ? 0 : uhdm_obj->VpiEndLineNo(),
+        line_only ? 0 : uhdm_obj->VpiEndColumnNo());
+    auto it = src_consts.find(key);
+    if (it == src_consts.end()) {
+        std::string src = src_files[std::get<0>(key)] + ":" + std::to_string(std::get<1>(key));
+        if (!line_only)
+            src += "." + std::to_string(std::get<2>(key)) + "-" +
+                   std::to_string(std::get<3>(key)) + "." + std::to_string(std::get<4>(key));
+        it = src_consts.emplace(key, RTLIL::Const(src)).first;
     }
+    attributes[ID::src] = it->second;
 }
 
 // Get unique cell name by checking if it already exists
@@ -3324,46 +3330,47 @@ RTLIL::IdString UhdmImporter::get_unique_cell_name(const std::string& base_name)
 
 // Import generate scopes (generate blocks)
 void UhdmImporter::import_generate_scopes(const module_inst* uhdm_module) {
+    UhdmTraceSpan span("import_generate_scopes", uhdm_trace_on ? std::string(uhdm_module->VpiDefName()) : std::string());
     // Check for GenScopeArray which contains generate blocks
     if (uhdm_module->Gen_scope_arrays()) {
-        log("UHDM: Found %d generate scope arrays\n", (int)uhdm_module->Gen_scope_arrays()->size());
+        log_uhdm_debug("UHDM: Found %d generate scope arrays\n", (int)uhdm_module->Gen_scope_arrays()->size());
         for (auto gen_array : *uhdm_module->Gen_scope_arrays()) {
             if (!gen_array) {
-                log("UHDM: Skipping null generate scope array\n");
+                log_uhdm_debug("UHDM: Skipping null generate scope array\n");
                 continue;
             }
             // Check if VpiName() is valid before using it
             std::string_view name_view = gen_array->VpiName();
             if (name_view.empty()) {
-                log("UHDM: Generate scope array has empty name, skipping\n");
+                log_uhdm_debug("UHDM: Generate scope array has empty name, skipping\n");
                 continue;
             }
             std::string gen_name = std::string(name_view);
-            log("UHDM: Processing generate scope array: %s\n", gen_name.c_str());
+            log_uhdm_debug("UHDM: Processing generate scope array: %s\n", gen_name.c_str());
             
             // Process each generate scope in the array
             if (gen_array->Gen_scopes()) {
-                log("UHDM: Found %d generate scopes in array %s\n", (int)gen_array->Gen_scopes()->size(), gen_name.c_str());
+                log_uhdm_debug("UHDM: Found %d generate scopes in array %s\n", (int)gen_array->Gen_scopes()->size(), gen_name.c_str());
+                if (import_gen_array_by_cloning(gen_array))
+                    continue;
                 for (auto gen_scope : *gen_array->Gen_scopes()) {
                     if (!gen_scope) {
-                        log("UHDM: Skipping null generate scope\n");
+                        log_uhdm_debug("UHDM: Skipping null generate scope\n");
                         continue;
                     }
                     import_gen_scope(gen_scope);
                 }
             } else {
-                log("UHDM: No generate scopes found in array %s\n", gen_name.c_str());
+                log_uhdm_debug("UHDM: No generate scopes found in array %s\n", gen_name.c_str());
             }
         }
     } else {
-        log("UHDM: No generate scope arrays found in module\n");
+        log_uhdm_debug("UHDM: No generate scope arrays found in module\n");
     }
 }
 
-// Import a single generate scope
-void UhdmImporter::import_gen_scope(const gen_scope* uhdm_scope) {
-    if (!uhdm_scope) return;
-    current_scope = uhdm_scope;
+// Name a generate scope contributes to the hierarchical wire names
+static std::string gen_scope_name(const gen_scope* uhdm_scope) {
     std::string scope_name = std::string(uhdm_scope->VpiName());
     std::string full_name = std::string(uhdm_scope->VpiFullName());
     
@@ -3383,17 +3390,529 @@ void UhdmImporter::import_gen_scope(const gen_scope* uhdm_scope) {
             }
         }
     }
+    return scope_name;
+}
+
+// Integer value of a VpiValue string; false for X/Z digits or a format other
+// than UINT/INT/DEC/HEX/BIN.
+static bool gen_clone_const_value(std::string_view vpi_value, int64_t& value) {
+    size_t colon = vpi_value.find(':');
+    if (colon == std::string_view::npos)
+        return false;
+    std::string_view type = vpi_value.substr(0, colon);
+    std::string digits = std::string(vpi_value.substr(colon + 1));
+    int base = 10;
+    if (type == "HEX")
+        base = 16;
+    else if (type == "BIN")
+        base = 2;
+    else if (type != "UINT" && type != "INT" && type != "DEC")
+        return false;
+    try {
+        size_t end = 0;
+        value = std::stoll(digits, &end, base);
+        return end == digits.size();
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+// Shape of a generate-for scope body.  Two scopes are clones of one another
+// when their `sig` strings match: same declarations and widths, and the same
+// expression trees with the same constants and names.  The only thing allowed
+// to differ is a select index into a net or variable that folds to an integer
+// (typically through the genvar); those are collected in `offsets` instead.
+// Anything the walk does not understand clears `ok`.
+struct GenScopeShape {
+    const RTLIL::Module* module;
+    std::string sig;
+    std::vector<int64_t> offsets;
+    bool ok = true;
+
+    // A per-scope parameter: the genvar, or a localparam of the scope body.
+    // One declared in a scope shadows a module parameter of the same name.
+    bool is_scope_param(const any* actual) const {
+        if (!actual || actual->VpiType() != vpiParameter)
+            return false;
+        if (actual->VpiParent() && actual->VpiParent()->UhdmType() == uhdmgen_scope)
+            return true;
+        return !module->parameter_default_values.count(
+                   RTLIL::escape_id(std::string(actual->VpiName())));
+    }
+
+    bool eval(const any* e, int64_t& value) const {
+        if (!e)
+            return false;
+        if (e->UhdmType() == uhdmconstant)
+            return gen_clone_const_value(any_cast<const constant*>(e)->VpiValue(), value);
+        if (e->UhdmType() == uhdmref_obj) {
+            const any* actual = any_cast<const ref_obj*>(e)->Actual_group();
+            if (!actual || actual->VpiType() != vpiParameter)
+                return false;
+            if (is_scope_param(actual))
+                return gen_clone_const_value(any_cast<const parameter*>(actual)->VpiValue(), value);
+            RTLIL::IdString id = RTLIL::escape_id(std::string(actual->VpiName()));
+            value = module->parameter_default_values.at(id).as_int(true);
+            return true;
+        }
+        if (e->UhdmType() != uhdmoperation)
+            return false;
+        auto op = any_cast<const operation*>(e);
+        if (!op->Operands())
+            return false;
+        std::vector<int64_t> v;
+        for (auto operand : *op->Operands()) {
+            int64_t x;
+            if (!eval(operand, x))
+                return false;
+            v.push_back(x);
+        }
+        if (v.size() == 1) {
+            switch (op->VpiOpType()) {
+                case vpiMinusOp: value = -v[0]; return true;
+                case vpiPlusOp: value = v[0]; return true;
+                default: return false;
+            }
+        }
+        if (v.size() != 2)
+            return false;
+        switch (op->VpiOpType()) {
+            case vpiAddOp: value = v[0] + v[1]; return true;
+            case vpiSubOp: value = v[0] - v[1]; return true;
+            case vpiMultOp: value = v[0] * v[1]; return true;
+            case vpiDivOp: if (!v[1]) return false; value = v[0] / v[1]; return true;
+            case vpiModOp: if (!v[1]) return false; value = v[0] % v[1]; return true;
+            case vpiLShiftOp: if (v[1] < 0 || v[1] > 62) return false; value = v[0] << v[1]; return true;
+            case vpiRShiftOp: if (v[1] < 0 || v[1] > 62) return false; value = v[0] >> v[1]; return true;
+            default: return false;
+        }
+    }
+
+    // Index of a select: an integer offset when the select reads a signal,
+    // otherwise part of the signature like any other expression.
+    void index(const any* e, const any* base) {
+        int64_t value;
+        bool signal = base && (dynamic_cast<const UHDM::net*>(base) ||
+                               dynamic_cast<const UHDM::variables*>(base));
+        if (signal && eval(e, value)) {
+            sig += "#;";
+            offsets.push_back(value);
+        } else {
+            walk(e);
+        }
+    }
+
+    // Name token of a select, and the object it selects from.
+    template <typename T>
+    const any* select_base(const T* sel) {
+        std::string_view name = sel->VpiName();
+        const any* base = sel->Actual_group();
+        if (auto parent = dynamic_cast<const ref_obj*>(sel->VpiParent())) {
+            if (name.empty())
+                name = parent->VpiName();
+            if (!base)
+                base = parent->Actual_group();
+        }
+        if (name.empty() || name.find('.') != std::string_view::npos || is_scope_param(base))
+            ok = false;
+        sig += std::string(name);
+        return base;
+    }
+
+    void walk(const any* e) {
+        if (!ok)
+            return;
+        if (!e) {
+            sig += "~;";
+            return;
+        }
+        sig += std::to_string((int)e->UhdmType()) + ":";
+        switch (e->UhdmType()) {
+            case uhdmconstant: {
+                auto c = any_cast<const constant*>(e);
+                sig += std::to_string(c->VpiSize()) + ":" + std::string(c->VpiValue()) + ";";
+                return;
+            }
+            case uhdmref_obj: {
+                auto ref = any_cast<const ref_obj*>(e);
+                std::string_view name = ref->VpiName();
+                if (name.find('.') != std::string_view::npos || is_scope_param(ref->Actual_group()))
+                    ok = false;
+                sig += std::string(name) + ";";
+                return;
+            }
+            case uhdmbit_select: {
+                auto bs = any_cast<const bit_select*>(e);
+                const any* base = select_base(bs);
+                sig += "[";
+                index(bs->VpiIndex(), base);
+                sig += "];";
+                return;
+            }
+            case uhdmpart_select: {
+                auto ps = any_cast<const part_select*>(e);
+                const any* base = select_base(ps);
+                sig += "[";
+                index(ps->Left_range(), base);
+                index(ps->Right_range(), base);
+                sig += "];";
+                return;
+            }
+            case uhdmindexed_part_select: {
+                auto ips = any_cast<const indexed_part_select*>(e);
+                const any* base = select_base(ips);
+                sig += "[" + std::to_string(ips->VpiIndexedPartSelectType());
+                index(ips->Base_expr(), base);
+                walk(ips->Width_expr());
+                sig += "];";
+                return;
+            }
+            case uhdmoperation: {
+                auto op = any_cast<const operation*>(e);
+                int op_type = op->VpiOpType();
+                // Their typespecs are per-scope objects that would need
+                // comparing too.
+                if (op_type == vpiCastOp || op_type == vpiAssignmentPatternOp ||
+                    op_type == vpiMultiAssignmentPatternOp) {
+                    ok = false;
+                    return;
+                }
+                sig += std::to_string(op_type) + "(";
+                if (op->Operands())
+                    for (auto operand : *op->Operands())
+                        walk(operand);
+                sig += ");";
+                return;
+            }
+            default:
+                ok = false;
+                return;
+        }
+    }
+};
+
+// The wires, cells and connections one generate scope added to the module.
+struct GenScopeFragment {
+    std::vector<RTLIL::Wire*> wires;
+    std::vector<RTLIL::Cell*> cells;
+    std::vector<RTLIL::SigSig> conns;
+};
+
+// The `n` newest entries of a hashlib dict (which iterates newest-first),
+// oldest first.
+template <typename T>
+static std::vector<T*> newest_entries(const dict<RTLIL::IdString, T*>& d, int n) {
+    std::vector<T*> out;
+    for (auto& it : d) {
+        if (n-- <= 0)
+            break;
+        out.push_back(it.second);
+    }
+    std::reverse(out.begin(), out.end());
+    return out;
+}
+
+// One bit of a cloned signal: a constant, bit `offset` of the clone's own
+// wire `local`, or bit `offset + ordinal * step` of the outside wire `wire`.
+struct GenCloneBit {
+    RTLIL::State data = RTLIL::State::Sx;
+    RTLIL::Wire* wire = nullptr;
+    int local = -1;
+    int offset = 0;
+    int step = 0;
+};
+
+// Name of a cloned object: the prototype's public name with the scope path
+// swapped, or a fresh private name.
+struct GenCloneName {
+    bool pub = false;
+    std::string suffix;
+};
+
+bool UhdmImporter::import_gen_array_by_cloning(const gen_scope_array* gen_array) {
+    if (!module || !gen_array->Gen_scopes())
+        return false;
+    std::vector<const gen_scope*> scopes;
+    for (auto scope : *gen_array->Gen_scopes())
+        if (scope)
+            scopes.push_back(scope);
+    // Scopes 0 and 1 are imported to learn the per-scope offset steps; with
+    // fewer than three there would be nothing left to clone.
+    int n_scopes = GetSize(scopes);
+    if (n_scopes < 3)
+        return false;
+
+    std::vector<std::vector<const any*>> decls(n_scopes);
+    std::vector<std::vector<int64_t>> offsets(n_scopes);
+    std::string sig0;
+    for (int k = 0; k < n_scopes; k++) {
+        const gen_scope* scope = scopes[k];
+        if ((scope->Modules() && !scope->Modules()->empty()) ||
+            (scope->Process() && !scope->Process()->empty()) ||
+            (scope->Gen_scope_arrays() && !scope->Gen_scope_arrays()->empty()))
+            return false;
+        GenScopeShape shape{module};
+        if (scope->Nets()) {
+            for (auto net : *scope->Nets()) {
+                decls[k].push_back(net);
+                shape.sig += "N" + std::string(net->VpiName()) + ":" +
+                             std::to_string(get_width(net, current_instance)) + ";";
+            }
+        }
+        if (scope->Variables()) {
+            for (auto var : *scope->Variables()) {
+                // Memories and initializers take their own import paths.
+                if (var->UhdmType() == uhdmarray_var || var->Expr())
+                    return false;
+                decls[k].push_back(var);
+                shape.sig += "V" + std::string(var->VpiName()) + ":" +
+                             std::to_string(get_width(var, current_instance)) +
+                             (var->VpiSigned() ? "s;" : "u;");
+            }
+        }
+        if (scope->Cont_assigns()) {
+            for (auto assign : *scope->Cont_assigns()) {
+                shape.sig += assign->VpiNetDeclAssign() ? "D" : "A";
+                shape.walk(assign->Lhs());
+                shape.walk(assign->Rhs());
+            }
+        }
+        if (!shape.ok)
+            return false;
+        if (k == 0)
+            sig0 = std::move(shape.sig);
+        else if (shape.sig != sig0)
+            return false;
+        offsets[k] = std::move(shape.offsets);
+    }
+    // Each varying offset must step by the same amount from scope to scope,
+    // so the offsets of scopes 0 and 1 determine all the others.
+    for (size_t i = 0; i < offsets[0].size(); i++) {
+        int64_t step = offsets[1][i] - offsets[0][i];
+        for (int k = 2; k < n_scopes; k++)
+            if (offsets[k][i] != offsets[0][i] + k * step)
+                return false;
+    }
+
+    std::string outer = get_current_gen_scope();
+    auto scope_path = [&](int k) {
+        std::string name = gen_scope_name(scopes[k]);
+        return outer.empty() ? name : outer + "." + name;
+    };
+    int n_assigns = scopes[0]->Cont_assigns() ? GetSize(*scopes[0]->Cont_assigns()) : 0;
+
+    // Import the prototype and the scope after it the normal way.
+    GenScopeFragment frag[2];
+    bool clonable = true;
+    for (int k = 0; k < 2; k++) {
+        int wires0 = GetSize(module->wires_), cells0 = GetSize(module->cells_);
+        int conns0 = GetSize(module->connections());
+        int procs0 = GetSize(module->processes), mems0 = GetSize(module->memories);
+        import_gen_scope(scopes[k]);
+        int n_wires = GetSize(module->wires_) - wires0;
+        int n_cells = GetSize(module->cells_) - cells0;
+        // One connection per assign, all in this module: an assign routed to
+        // another module (connect_target_module) would not be cloned.
+        if (n_wires < 0 || n_cells < 0 || GetSize(module->connections()) - conns0 != n_assigns ||
+            GetSize(module->processes) != procs0 || GetSize(module->memories) != mems0) {
+            clonable = false;
+            continue;
+        }
+        frag[k].wires = newest_entries(module->wires_, n_wires);
+        frag[k].cells = newest_entries(module->cells_, n_cells);
+        frag[k].conns.assign(module->connections().begin() + conns0, module->connections().end());
+    }
+
+    // Match the two fragments object by object.  Where they differ by more
+    // than the scope path and a constant step in outside offsets, the
+    // remaining scopes are imported the normal way.
+    std::string path0 = scope_path(0) + ".", path1 = scope_path(1) + ".";
+    auto match_name = [&](RTLIL::IdString n0, RTLIL::IdString n1, GenCloneName& out) {
+        if (!n0.isPublic() && !n1.isPublic())
+            return true;
+        if (!n0.isPublic() || !n1.isPublic())
+            return false;
+        std::string s0 = n0.str().substr(1), s1 = n1.str().substr(1);
+        if (s0.compare(0, path0.size(), path0) || s1.compare(0, path1.size(), path1) ||
+            s0.substr(path0.size()) != s1.substr(path1.size()))
+            return false;
+        out.pub = true;
+        out.suffix = s0.substr(path0.size());
+        return true;
+    };
+    dict<RTLIL::Wire*, int> local0, local1;
+    auto match_sig = [&](const RTLIL::SigSpec& s0, const RTLIL::SigSpec& s1,
+                         std::vector<GenCloneBit>& out) {
+        if (s0.size() != s1.size())
+            return false;
+        for (int i = 0; i < s0.size(); i++) {
+            RTLIL::SigBit b0 = s0[i], b1 = s1[i];
+            GenCloneBit bit;
+            if (!b0.wire || !b1.wire) {
+                if (b0.wire || b1.wire || b0.data != b1.data)
+                    return false;
+                bit.data = b0.data;
+            } else if (local0.count(b0.wire)) {
+                auto it = local1.find(b1.wire);
+                if (it == local1.end() || it->second != local0.at(b0.wire) || b0.offset != b1.offset)
+                    return false;
+                bit.local = it->second;
+                bit.offset = b0.offset;
+            } else {
+                if (b0.wire != b1.wire || local1.count(b1.wire))
+                    return false;
+                bit.wire = b0.wire;
+                bit.offset = b0.offset;
+                bit.step = b1.offset - b0.offset;
+            }
+            out.push_back(bit);
+        }
+        return true;
+    };
+
+    int n_decls = GetSize(decls[0]);
+    std::vector<GenCloneName> wire_names;
+    std::vector<GenCloneName> cell_names;
+    std::vector<std::vector<std::pair<RTLIL::IdString, std::vector<GenCloneBit>>>> cell_ports;
+    std::vector<std::pair<std::vector<GenCloneBit>, std::vector<GenCloneBit>>> conns;
+    if (clonable) {
+        clonable = GetSize(frag[0].wires) == GetSize(frag[1].wires) &&
+                   GetSize(frag[0].cells) == GetSize(frag[1].cells) &&
+                   GetSize(frag[0].wires) >= n_decls;
+    }
+    // import_gen_scope creates the declared wires first, in declaration order.
+    for (int k = 0; clonable && k < 2; k++)
+        for (int i = 0; clonable && i < n_decls; i++)
+            clonable = wire_map.count(decls[k][i]) && wire_map.at(decls[k][i]) == frag[k].wires[i];
+    for (int i = 0; clonable && i < GetSize(frag[0].wires); i++) {
+        RTLIL::Wire *w0 = frag[0].wires[i], *w1 = frag[1].wires[i];
+        GenCloneName name;
+        clonable = w0->width == w1->width && w0->upto == w1->upto &&
+                   w0->start_offset == w1->start_offset && w0->is_signed == w1->is_signed &&
+                   !w0->port_id && !w1->port_id && match_name(w0->name, w1->name, name);
+        wire_names.push_back(name);
+        local0[w0] = i;
+        local1[w1] = i;
+    }
+    for (int i = 0; clonable && i < GetSize(frag[0].cells); i++) {
+        RTLIL::Cell *c0 = frag[0].cells[i], *c1 = frag[1].cells[i];
+        GenCloneName name;
+        clonable = c0->type == c1->type && c0->parameters == c1->parameters &&
+                   GetSize(c0->connections()) == GetSize(c1->connections()) &&
+                   match_name(c0->name, c1->name, name);
+        cell_names.push_back(name);
+        cell_ports.emplace_back();
+        for (auto& conn : c0->connections()) {
+            if (!clonable)
+                break;
+            std::vector<GenCloneBit> bits;
+            clonable = c1->hasPort(conn.first) &&
+                       match_sig(conn.second, c1->getPort(conn.first), bits);
+            cell_ports.back().emplace_back(conn.first, std::move(bits));
+        }
+    }
+    for (int i = 0; clonable && i < n_assigns; i++) {
+        std::vector<GenCloneBit> lhs, rhs;
+        clonable = match_sig(frag[0].conns[i].first, frag[1].conns[i].first, lhs) &&
+                   match_sig(frag[0].conns[i].second, frag[1].conns[i].second, rhs);
+        conns.emplace_back(std::move(lhs), std::move(rhs));
+    }
+    if (!clonable)
+        log_uhdm_debug("UHDM: Generate scopes %s and %s differ beyond their offsets, not cloning\n",
+            scope_path(0).c_str(), scope_path(1).c_str());
+
+    auto in_range = [&](const std::vector<GenCloneBit>& bits, int k) {
+        for (auto& bit : bits) {
+            int offset = bit.offset + k * bit.step;
+            if (bit.wire && (offset < 0 || offset >= bit.wire->width))
+                return false;
+        }
+        return true;
+    };
+    auto make_sig = [&](const std::vector<GenCloneBit>& bits, int k,
+                        const std::vector<RTLIL::Wire*>& wires) {
+        RTLIL::SigSpec sig;
+        for (auto& bit : bits) {
+            if (bit.local >= 0)
+                sig.append(RTLIL::SigBit(wires[bit.local], bit.offset));
+            else if (bit.wire)
+                sig.append(RTLIL::SigBit(bit.wire, bit.offset + k * bit.step));
+            else
+                sig.append(RTLIL::SigBit(bit.data));
+        }
+        return sig;
+    };
+
+    int n_cloned = 0;
+    for (int k = 2; k < n_scopes; k++) {
+        std::string path = scope_path(k);
+        // A wire created on demand before this scope, or an offset running
+        // off its wire (an X select), is the normal import's business.
+        bool clone = clonable;
+        for (int i = 0; clone && i < n_decls; i++)
+            clone = !name_map.count(path + "." + std::string(decls[k][i]->VpiName()));
+        for (int i = 0; clone && i < GetSize(wire_names); i++)
+            clone = !wire_names[i].pub ||
+                    !module->wire(RTLIL::escape_id(path + "." + wire_names[i].suffix));
+        for (int i = 0; clone && i < GetSize(cell_names); i++)
+            clone = !cell_names[i].pub ||
+                    !module->cell(RTLIL::escape_id(path + "." + cell_names[i].suffix));
+        for (auto& ports : cell_ports)
+            for (auto& port : ports)
+                clone = clone && in_range(port.second, k);
+        for (auto& conn : conns)
+            clone = clone && in_range(conn.first, k) && in_range(conn.second, k);
+        if (!clone) {
+            import_gen_scope(scopes[k]);
+            continue;
+        }
+
+        HeatmapScope heat(this, scopes[k]);
+        UhdmTraceSpan span("clone_gen_scope", uhdm_trace_on ? path : std::string());
+        std::vector<RTLIL::Wire*> wires;
+        for (int i = 0; i < GetSize(wire_names); i++) {
+            RTLIL::IdString id = wire_names[i].pub ? new_id(path + "." + wire_names[i].suffix) : NEW_ID;
+            wires.push_back(module->addWire(id, frag[0].wires[i]));
+        }
+        for (int i = 0; i < n_decls; i++) {
+            wire_map[decls[k][i]] = wires[i];
+            name_map[path + "." + std::string(decls[k][i]->VpiName())] = wires[i];
+        }
+        for (int i = 0; i < GetSize(cell_names); i++) {
+            RTLIL::IdString id = cell_names[i].pub
+                ? RTLIL::escape_id(path + "." + cell_names[i].suffix) : NEW_ID;
+            RTLIL::Cell* cell = module->addCell(id, frag[0].cells[i]);
+            for (auto& port : cell_ports[i])
+                cell->setPort(port.first, make_sig(port.second, k, wires));
+        }
+        for (auto& conn : conns)
+            module->connect(make_sig(conn.first, k, wires), make_sig(conn.second, k, wires));
+        log_uhdm_debug("UHDM: Cloned generate scope %s from %s\n", path.c_str(), scope_path(0).c_str());
+        n_cloned++;
+    }
+    if (n_cloned)
+        log_uhdm("UHDM: Cloned %d of %d scopes of generate block %s\n", n_cloned, n_scopes,
+            std::string(gen_array->VpiName()).c_str());
+    return true;
+}
+
+// Import a single generate scope
+void UhdmImporter::import_gen_scope(const gen_scope* uhdm_scope) {
+    if (!uhdm_scope) return;
+    current_scope = uhdm_scope;
+    std::string scope_name = gen_scope_name(uhdm_scope);
+    std::string full_name = std::string(uhdm_scope->VpiFullName());
     
-    log("UHDM: Importing generate scope: %s (full: %s)\n", scope_name.c_str(), full_name.c_str());
+    log_uhdm_debug("UHDM: Importing generate scope: %s (full: %s)\n", scope_name.c_str(), full_name.c_str());
     
     // Push this scope onto the stack
     gen_scope_stack.push_back(scope_name);
-    log("UHDM: Pushed scope '%s', stack depth: %zu, full path: %s\n", 
+    log_uhdm_debug("UHDM: Pushed scope '%s', stack depth: %zu, full path: %s\n", 
         scope_name.c_str(), gen_scope_stack.size(), get_current_gen_scope().c_str());
     
     // Import nets declared in the generate scope
     if (uhdm_scope->Nets()) {
-        log("UHDM: Found %d nets in generate scope\n", (int)uhdm_scope->Nets()->size());
+        log_uhdm_debug("UHDM: Found %d nets in generate scope\n", (int)uhdm_scope->Nets()->size());
         for (auto net : *uhdm_scope->Nets()) {
             std::string net_name = std::string(net->VpiName());
             std::string full_gen_path = get_current_gen_scope();
@@ -3406,14 +3925,14 @@ void UhdmImporter::import_gen_scope(const gen_scope* uhdm_scope) {
                 wire_map[net] = w;
                 // Map the full hierarchical name
                 name_map[hierarchical_name] = w;
-                log("UHDM: Created wire '%s' (width=%d) for generate scope net\n", hierarchical_name.c_str(), width);
+                log_uhdm_debug("UHDM: Created wire '%s' (width=%d) for generate scope net\n", hierarchical_name.c_str(), width);
             }
         }
     }
     
     // Import variables declared in the generate scope
     if (uhdm_scope->Variables()) {
-        log("UHDM: Found %d variables in generate scope\n", (int)uhdm_scope->Variables()->size());
+        log_uhdm_debug("UHDM: Found %d variables in generate scope\n", (int)uhdm_scope->Variables()->size());
         for (auto var : *uhdm_scope->Variables()) {
             // Variables can be logic_var or other types, we need to handle them
             // For now, create a wire for each variable
@@ -3471,7 +3990,7 @@ void UhdmImporter::import_gen_scope(const gen_scope* uhdm_scope) {
                 if (var->VpiSigned()) {
                     w->is_signed = true;
                 }
-                log("UHDM: Created wire '%s' (width=%d, signed=%d) for generate scope variable\n",
+                log_uhdm_debug("UHDM: Created wire '%s' (width=%d, signed=%d) for generate scope variable\n",
                     hierarchical_name.c_str(), width, w->is_signed ? 1 : 0);
             }
             if (w) {
@@ -3535,7 +4054,7 @@ void UhdmImporter::import_gen_scope(const gen_scope* uhdm_scope) {
                             init_val = init_val.extract(0, w->width);
                         }
                         module->connect(RTLIL::SigSpec(w), init_val);
-                        log("UHDM: Added initializer assignment for '%s'\n", hierarchical_name.c_str());
+                        log_uhdm_debug("UHDM: Added initializer assignment for '%s'\n", hierarchical_name.c_str());
                     }
                 }
             }
@@ -3544,13 +4063,13 @@ void UhdmImporter::import_gen_scope(const gen_scope* uhdm_scope) {
     
     // Import module instances within the generate scope
     if (uhdm_scope->Modules()) {
-        log("UHDM: Found %d module instances in generate scope '%s'\n", 
+        log_uhdm_debug("UHDM: Found %d module instances in generate scope '%s'\n", 
             (int)uhdm_scope->Modules()->size(), scope_name.c_str());
         
         for (auto mod_inst : *uhdm_scope->Modules()) {
             // Just import the module instance
             // The module definition should already exist from the top-level import
-            log("UHDM: Importing module instance '%s' of type '%s' in generate scope\n",
+            log_uhdm_debug("UHDM: Importing module instance '%s' of type '%s' in generate scope\n",
                 std::string(mod_inst->VpiName()).c_str(), std::string(mod_inst->VpiDefName()).c_str());
             import_instance(mod_inst);
             // import_instance -> import_module imports the instance's OWN body but
@@ -3581,7 +4100,7 @@ void UhdmImporter::import_gen_scope(const gen_scope* uhdm_scope) {
     
     // Import processes (always blocks) within the generate scope
     if (uhdm_scope->Process()) {
-        log("UHDM: Found %d processes in generate scope\n", (int)uhdm_scope->Process()->size());
+        log_uhdm_debug("UHDM: Found %d processes in generate scope\n", (int)uhdm_scope->Process()->size());
         for (auto process : *uhdm_scope->Process()) {
             try {
                 import_process(process);
@@ -3594,9 +4113,9 @@ void UhdmImporter::import_gen_scope(const gen_scope* uhdm_scope) {
     // Recursively import nested generate scopes BEFORE continuous assignments
     // This ensures all wires in nested scopes are created before assignments reference them
     if (uhdm_scope->Gen_scope_arrays()) {
-        log("UHDM: Found nested generate scope arrays\n");
+        log_uhdm_debug("UHDM: Found nested generate scope arrays\n");
         for (auto nested_array : *uhdm_scope->Gen_scope_arrays()) {
-            if (nested_array->Gen_scopes()) {
+            if (nested_array->Gen_scopes() && !import_gen_array_by_cloning(nested_array)) {
                 for (auto nested_scope : *nested_array->Gen_scopes()) {
                     // The nested scope will push its name onto the stack
                     import_gen_scope(nested_scope);
@@ -3608,7 +4127,7 @@ void UhdmImporter::import_gen_scope(const gen_scope* uhdm_scope) {
     // Import continuous assignments within the generate scope
     // Do this AFTER nested generate scopes so all wires are available
     if (uhdm_scope->Cont_assigns()) {
-        log("UHDM: Found %d continuous assignments in generate scope\n", (int)uhdm_scope->Cont_assigns()->size());
+        log_uhdm_debug("UHDM: Found %d continuous assignments in generate scope\n", (int)uhdm_scope->Cont_assigns()->size());
         for (auto cont_assign : *uhdm_scope->Cont_assigns()) {
             try {
                 import_continuous_assign(cont_assign);
@@ -3620,7 +4139,7 @@ void UhdmImporter::import_gen_scope(const gen_scope* uhdm_scope) {
     
     // Pop this scope from the stack before returning
     gen_scope_stack.pop_back();
-    log("UHDM: Popped scope '%s', stack depth: %zu\n", 
+    log_uhdm_debug("UHDM: Popped scope '%s', stack depth: %zu\n", 
         scope_name.c_str(), gen_scope_stack.size());
     current_scope = nullptr;
 }
@@ -15,6 +15,130 @@ YOSYS_NAMESPACE_BEGIN
 
 using namespace UHDM;
 
+// Fold a package parameter registered by import_package.  Runs on first
+// lookup, in the package context the eager import used to run in: no module,
+// instance, generate scope or loop bindings.
+const RTLIL::Const* UhdmImporter::package_parameter(const std::string& full_name) {
+    auto known = package_parameter_map.find(full_name);
+    if (known != package_parameter_map.end())
+        return &known->second;
+    auto idx = package_parameter_index.find(full_name);
+    if (idx == package_parameter_index.end())
+        return nullptr;
+    const package* uhdm_package = idx->second.first;
+    const parameter* param_obj = idx->second.second;
+    // Evaluated at most once, whether or not it folds.
+    package_parameter_index.erase(idx);
+
+    RTLIL::Module* saved_module = module;
+    const module_inst* saved_instance = current_instance;
+    const UHDM::scope* saved_scope = current_scope;
+    int saved_ctx_width = expression_context_width;
+    const UHDM::typespec* saved_ctx_ts = expression_context_typespec;
+    std::vector<std::string> saved_gen_scopes;
+    decltype(loop_values) saved_loop_values;
+    std::swap(saved_gen_scopes, gen_scope_stack);
+    std::swap(saved_loop_values, loop_values);
+    module = nullptr;
+    current_instance = nullptr;
+    current_scope = nullptr;
+    expression_context_width = 0;
+    expression_context_typespec = nullptr;
+
+    evaluate_package_parameter(uhdm_package, param_obj, full_name);
+
+    module = saved_module;
+    current_instance = saved_instance;
+    current_scope = saved_scope;
+    expression_context_width = saved_ctx_width;
+    expression_context_typespec = saved_ctx_ts;
+    std::swap(saved_gen_scopes, gen_scope_stack);
+    std::swap(saved_loop_values, loop_values);
+
+    known = package_parameter_map.find(full_name);
+    return known != package_parameter_map.end() ? &known->second : nullptr;
+}
+
+void UhdmImporter::evaluate_package_parameter(const package* uhdm_package, const parameter* param_obj,
+                                              const std::string& full_name) {
+    std::string param_name = std::string(param_obj->VpiName());
+    log_uhdm_debug("UHDM: Importing package parameter: %s\n", full_name.c_str());
+
+    // Get parameter value
+    if (auto expr = param_obj->Expr()) {
+        // package_parameter() has cleared the module context
+        RTLIL::SigSpec value_spec = import_expression(expr);
+        
+        if (value_spec.is_fully_const()) {
+            RTLIL::Const param_value = value_spec.as_const();
+            package_parameter_map[full_name] = param_value;
+            log_uhdm_debug("UHDM: Package parameter %s = %s\n", 
+                full_name.c_str(), param_value.as_string().c_str());
+        } else {
+            log_warning("UHDM: Package parameter %s has non-constant value\n", 
+                       full_name.c_str());
+        }
+    } else if (!param_obj->VpiValue().empty()) {
+        // Fallback: use VpiValue() directly (elaborated params may have resolved value here)
+        std::string val_str = std::string(param_obj->VpiValue());
+        // Get width from typespec if available, else default 32
+        int width = 32;
+        if (param_obj->Typespec()) {
+            if (auto ts = param_obj->Typespec()->Actual_typespec()) {
+                int ts_width = get_width_from_typespec(ts);
+                if (ts_width > 0) width = ts_width;
+            }
+        }
+        // Use the arbitrary-width parser — `parse_vpi_value_to_int`
+        // truncates to `int` and overflows std::stoul for wide
+        // constants (e.g. a 160-bit `logic [159:0]` package
+        // parameter — ParameterSizeOfInstance crashed here).
+        RTLIL::Const param_value = extract_const_from_value(val_str);
+        if (param_value.size() != width)
+            param_value = param_value.extract(0, width, RTLIL::State::S0);
+        package_parameter_map[full_name] = param_value;
+        log_uhdm_debug("UHDM: Package parameter %s = %s (from VpiValue)\n",
+            full_name.c_str(), param_value.as_string().c_str());
+    } else if (const UHDM::param_assign* pa = [&]() -> const UHDM::param_assign* {
+                   // The value can live in the package's Param_assigns
+                   // list rather than Expr()/VpiValue — e.g. a
+                   // struct/union assignment-pattern initializer
+                   // `'{default: 1}` (UnionParameter).
+                   if (uhdm_package->Param_assigns())
+                       for (auto p : *uhdm_package->Param_assigns())
+                           if (p->Lhs() &&
+                               std::string(p->Lhs()->VpiName()) == param_name)
+                               return p;
+                   return nullptr;
+               }()) {
+        if (pa->Rhs()) {
+            if (auto re = dynamic_cast<const UHDM::expr*>(pa->Rhs())) {
+                RTLIL::SigSpec value_spec = import_expression(re);
+                if (value_spec.is_fully_const()) {
+                    int width = 32;
+                    if (param_obj->Typespec())
+                        if (auto ts = param_obj->Typespec()->Actual_typespec()) {
+                            int tw = get_width_from_typespec(ts);
+                            if (tw > 0) width = tw;
+                        }
+                    RTLIL::Const param_value = value_spec.as_const();
+                    if (param_value.size() != width)
+                        param_value = param_value.extract(0, width, RTLIL::State::S0);
+                    package_parameter_map[full_name] = param_value;
+                    log_uhdm_debug("UHDM: Package parameter %s = %s (from param_assign)\n",
+                        full_name.c_str(), param_value.as_string().c_str());
+                } else {
+                    log_warning("UHDM: Package parameter %s param_assign Rhs not constant\n",
+                                full_name.c_str());
+                }
+            }
+        }
+    } else {
+        log_warning("UHDM: Package parameter %s has no expression\n",
+                   full_name.c_str());
+    }
+}
+
 // Import a SystemVerilog package
 void UhdmImporter::import_package(const package* uhdm_package) {
     if (!uhdm_package) return;
@@ -26,118 +150,44 @@ void UhdmImporter::import_package(const package* uhdm_package) {
         package_name = package_name.substr(5);
     }
     
-    log("UHDM: Importing package: %s\n", package_name.c_str());
-    
+    // A `read_uhdm -batch` entry on an already-restored design inherits the
+    // previous entry's package tables: this very package is resolved already.
+    auto known = package_map.find(package_name);
+    if (known != package_map.end() && known->second == uhdm_package) {
+        log_uhdm_debug("UHDM: Reusing resolved package: %s\n", package_name.c_str());
+        return;
+    }
+
+    log_uhdm_debug("UHDM: Importing package: %s\n", package_name.c_str());
+
     // Store package for later reference
     package_map[package_name] = uhdm_package;
     
-    // Import package parameters
+    // Register package parameters by name; each is folded on first lookup
+    // (package_parameter), so a design only pays for the items it uses.
     if (uhdm_package->Parameters()) {
-        log("UHDM: Found %d parameters in package %s\n", 
+        log_uhdm_debug("UHDM: Found %d parameters in package %s\n", 
             (int)uhdm_package->Parameters()->size(), package_name.c_str());
         
         for (const any* param : *uhdm_package->Parameters()) {
             if (auto param_obj = dynamic_cast<const parameter*>(param)) {
-                std::string param_name = std::string(param_obj->VpiName());
-                std::string full_name = package_name + "::" + param_name;
-                
-                log("UHDM: Importing package parameter: %s\n", full_name.c_str());
-                
-                // Get parameter value
-                if (auto expr = param_obj->Expr()) {
-                    // Temporarily set module to nullptr since we're in package context
-                    RTLIL::Module* saved_module = module;
-                    module = nullptr;
-                    
-                    RTLIL::SigSpec value_spec = import_expression(expr);
-                    
-                    module = saved_module;
-                    
-                    if (value_spec.is_fully_const()) {
-                        RTLIL::Const param_value = value_spec.as_const();
-                        package_parameter_map[full_name] = param_value;
-                        log("UHDM: Package parameter %s = %s\n", 
-                            full_name.c_str(), param_value.as_string().c_str());
-                    } else {
-                        log_warning("UHDM: Package parameter %s has non-constant value\n", 
-                                   full_name.c_str());
-                    }
-                } else if (!param_obj->VpiValue().empty()) {
-                    // Fallback: use VpiValue() directly (elaborated params may have resolved value here)
-                    std::string val_str = std::string(param_obj->VpiValue());
-                    // Get width from typespec if available, else default 32
-                    int width = 32;
-                    if (param_obj->Typespec()) {
-                        if (auto ts = param_obj->Typespec()->Actual_typespec()) {
-                            int ts_width = get_width_from_typespec(ts);
-                            if (ts_width > 0) width = ts_width;
-                        }
-                    }
-                    // Use the arbitrary-width parser — `parse_vpi_value_to_int`
-                    // truncates to `int` and overflows std::stoul for wide
-                    // constants (e.g. a 160-bit `logic [159:0]` package
-                    // parameter — ParameterSizeOfInstance crashed here).
-                    RTLIL::Const param_value = extract_const_from_value(val_str);
-                    if (param_value.size() != width)
-                        param_value = param_value.extract(0, width, RTLIL::State::S0);
-                    package_parameter_map[full_name] = param_value;
-                    log("UHDM: Package parameter %s = %s (from VpiValue)\n",
-                        full_name.c_str(), param_value.as_string().c_str());
-                } else if (const UHDM::param_assign* pa = [&]() -> const UHDM::param_assign* {
-                               // The value can live in the package's Param_assigns
-                               // list rather than Expr()/VpiValue — e.g. a
-                               // struct/union assignment-pattern initializer
-                               // `'{default: 1}` (UnionParameter).
-                               if (uhdm_package->Param_assigns())
-                                   for (auto p : *uhdm_package->Param_assigns())
-                                       if (p->Lhs() &&
-                                           std::string(p->Lhs()->VpiName()) == param_name)
-                                           return p;
-                               return nullptr;
-                           }()) {
-                    if (pa->Rhs()) {
-                        if (auto re = dynamic_cast<const UHDM::expr*>(pa->Rhs())) {
-                            RTLIL::Module* saved_module = module;
-                            module = nullptr;
-                            RTLIL::SigSpec value_spec = import_expression(re);
-                            module = saved_module;
-                            if (value_spec.is_fully_const()) {
-                                int width = 32;
-                                if (param_obj->Typespec())
-                                    if (auto ts = param_obj->Typespec()->Actual_typespec()) {
-                                        int tw = get_width_from_typespec(ts);
-                                        if (tw > 0) width = tw;
-                                    }
-                                RTLIL::Const param_value = value_spec.as_const();
-                                if (param_value.size() != width)
-                                    param_value = param_value.extract(0, width, RTLIL::State::S0);
-                                package_parameter_map[full_name] = param_value;
-                                log("UHDM: Package parameter %s = %s (from param_assign)\n",
-                                    full_name.c_str(), param_value.as_string().c_str());
-                            } else {
-                                log_warning("UHDM: Package parameter %s param_assign Rhs not constant\n",
-                                            full_name.c_str());
-                            }
-                        }
-                    }
-                } else {
-                    log_warning("UHDM: Package parameter %s has no expression\n",
-                               full_name.c_str());
-                }
+                std::string full_name = package_name + "::" + std::string(param_obj->VpiName());
+                if (!package_parameter_map.count(full_name))
+                    package_parameter_index[full_name] = {uhdm_package, param_obj};
             }
         }
     }
     
     // Import package typespecs
     if (uhdm_package->Typespecs()) {
-        log("UHDM: Found %d typespecs in package %s\n", 
+        log_uhdm_debug("UHDM: Found %d typespecs in package %s\n", 
             (int)uhdm_package->Typespecs()->size(), package_name.c_str());
         
         for (const typespec* ts : *uhdm_package->Typespecs()) {
             std::string type_name = std::string(ts->VpiName());
             std::string full_name = package_name + "::" + type_name;
             
-            log("UHDM: Importing package typespec: %s (UhdmType=%s)\n", 
+            log_uhdm_debug("UHDM: Importing package typespec: %s (UhdmType=%s)\n", 
                 full_name.c_str(), UhdmName(ts->UhdmType()).c_str());
             
             // Store typespec for later reference
@@ -150,19 +200,19 @@ void UhdmImporter::import_package(const package* uhdm_package) {
     
     // Import package variables (if any)
     if (uhdm_package->Variables()) {
-        log("UHDM: Found %d variables in package %s\n", 
+        log_uhdm_debug("UHDM: Found %d variables in package %s\n", 
             (int)uhdm_package->Variables()->size(), package_name.c_str());
         
         // Note: Package variables are not commonly used in synthesizable code
         // but we log them for completeness
         for (const variables* var : *uhdm_package->Variables()) {
             std::string var_name = std::string(var->VpiName());
-            log("UHDM: Package variable: %s (not imported - synthesis limitation)\n", 
+            log_uhdm_debug("UHDM: Package variable: %s (not imported - synthesis limitation)\n", 
                 var_name.c_str());
         }
     }
     
-    log("UHDM: Finished importing package %s\n", package_name.c_str());
+    log_uhdm_debug("UHDM: Finished importing package %s\n", package_name.c_str());
 }
 
 YOSYS_NAMESPACE_END
\ No newline at end of file
@@ -21,7 +21,7 @@ void UhdmImporter::import_primitives(const module_inst* uhdm_module) {
     
     // Import primitive gates from module
     if (uhdm_module->Primitives()) {
-        log("UHDM: Found %d primitive gates\n", (int)uhdm_module->Primitives()->size());
+        log_uhdm_debug("UHDM: Found %d primitive gates\n", (int)uhdm_module->Primitives()->size());
         for (auto prim : *uhdm_module->Primitives()) {
             if (auto gate = dynamic_cast<const UHDM::gate*>(prim)) {
                 std::string instance_name(gate->VpiName());
@@ -37,7 +37,7 @@ void UhdmImporter::import_primitive_arrays(const module_inst* uhdm_module) {
     
     // Check for Primitive_arrays() which should contain gate arrays
     if (uhdm_module->Primitive_arrays()) {
-        log("UHDM: Found %d primitive arrays\n", (int)uhdm_module->Primitive_arrays()->size());
+        log_uhdm_debug("UHDM: Found %d primitive arrays\n", (int)uhdm_module->Primitive_arrays()->size());
         for (auto prim_array : *uhdm_module->Primitive_arrays()) {
             if (auto gate_array = dynamic_cast<const UHDM::gate_array*>(prim_array)) {
                 import_gate_array(gate_array);
@@ -49,6 +49,7 @@ void UhdmImporter::import_primitive_arrays(const module_inst* uhdm_module) {
 // Import a single gate
 void UhdmImporter::import_gate(const gate* uhdm_gate, const std::string& instance_name) {
     if (!uhdm_gate) return;
+    HeatmapScope heat(this, uhdm_gate);
     
     // Get gate type
     int prim_type = uhdm_gate->VpiPrimType();
@@ -100,7 +101,7 @@ void UhdmImporter::import_gate(const gate* uhdm_gate, const std::string& instanc
         inst_name = gate_type_str + "_gate";
     }
     
-    log("UHDM: Importing %s gate '%s'\n", gate_type_str.c_str(), inst_name.c_str());
+    log_uhdm_debug("UHDM: Importing %s gate '%s'\n", gate_type_str.c_str(), inst_name.c_str());
     
     // Get terminals (ports)
     if (!uhdm_gate->Prim_terms()) {
@@ -194,7 +195,7 @@ void UhdmImporter::import_gate(const gate* uhdm_gate, const std::string& instanc
         }
     }
     
-    log("UHDM: Gate '%s' has %d outputs and %d inputs\n", 
+    log_uhdm_debug("UHDM: Gate '%s' has %d outputs and %d inputs\n", 
         inst_name.c_str(), (int)outputs.size(), (int)inputs.size());
     
     // Import gate attributes helper
@@ -278,7 +279,7 @@ void UhdmImporter::import_gate(const gate* uhdm_gate, const std::string& instanc
                 }
                 // Don't need the original cell
                 module->remove(cell);
-                log("UHDM: Created %d-input %s as XOR-reduce%s\n",
+                log_uhdm_debug("UHDM: Created %d-input %s as XOR-reduce%s\n",
                     (int)inputs.size(), gate_type_str.c_str(),
                     prim_type == vpiXnorPrim ? " + NOT" : "");
                 return;
@@ -315,7 +316,7 @@ void UhdmImporter::import_gate(const gate* uhdm_gate, const std::string& instanc
                     module->connect(outputs[0], result);
                 }
                 module->remove(cell);
-                log("UHDM: Created %d-input %s as reduce%s\n",
+                log_uhdm_debug("UHDM: Created %d-input %s as reduce%s\n",
                     (int)inputs.size(), gate_type_str.c_str(),
                     invert ? " + NOT" : "");
                 return;
@@ -330,15 +331,16 @@ void UhdmImporter::import_gate(const gate* uhdm_gate, const std::string& instanc
         return;
     }
     
-    log("UHDM: Successfully imported %s gate\n", gate_type_str.c_str());
+    log_uhdm_debug("UHDM: Successfully imported %s gate\n", gate_type_str.c_str());
 }
 
 // Import a gate array
 void UhdmImporter::import_gate_array(const gate_array* uhdm_gate_array) {
     if (!uhdm_gate_array) return;
+    HeatmapScope heat(this, uhdm_gate_array);
     
     std::string array_name = std::string(uhdm_gate_array->VpiName());
-    log("UHDM: Importing gate array '%s'\n", array_name.c_str());
+    log_uhdm_debug("UHDM: Importing gate array '%s'\n", array_name.c_str());
     
     // Get array bounds from Ranges()
     int array_left = 0;
@@ -375,7 +377,7 @@ void UhdmImporter::import_gate_array(const gate_array* uhdm_gate_array) {
         }
     }
     
-    log("UHDM: Gate array has %d elements (range [%d:%d])\n", array_size, array_left, array_right);
+    log_uhdm_debug("UHDM: Gate array has %d elements (range [%d:%d])\n", array_size, array_left, array_right);
     
     // Get the primitive template
     if (!uhdm_gate_array->Primitives() || uhdm_gate_array->Primitives()->empty()) {
@@ -394,6 +396,16 @@ void UhdmImporter::import_gate_array(const gate_array* uhdm_gate_array) {
     // Import each gate in the array
     // Determine if array is ascending or descending
     bool descending = (array_left > array_right);
+
+    // Array-aligned terminals import as one word-level cell for the whole
+    // array; -gate_array_cells keeps the named per-element gates.
+    if (!mode_gate_array_cells) {
+        std::vector<int> bit_indices;
+        for (int i = 0; i < array_size; i++)
+            bit_indices.push_back(descending ? array_left - i : array_left + i);
+        if (import_gate_array_vectorized(gate_template, array_name, bit_indices))
+            return;
+    }
     
     for (int i = 0; i < array_size; i++) {
         int array_index;
@@ -417,6 +429,105 @@ void UhdmImporter::import_gate_array(const gate_array* uhdm_gate_array) {
     }
 }
 
+// Import a whole gate array as word-level cells.  Element i drives bit
+// bit_indices[i] of the output terminal and reads the same bit of every input
+// terminal, or the whole signal when that input is a single bit (broadcast) —
+// the selection import_gate_array_element makes per element, gathered into
+// one vector per terminal.  Returns false without emitting anything when the
+// terminals don't line up that way.
+bool UhdmImporter::import_gate_array_vectorized(const gate* gate_template,
+                                                const std::string& array_name,
+                                                const std::vector<int>& bit_indices) {
+    if (!gate_template || !gate_template->Prim_terms() || bit_indices.empty())
+        return false;
+    int prim_type = gate_template->VpiPrimType();
+    bool unary = (prim_type == vpiNotPrim || prim_type == vpiBufPrim);
+    RTLIL::IdString base;
+    bool invert = false;
+    switch (prim_type) {
+        case vpiAndPrim:  base = ID($and); break;
+        case vpiNandPrim: base = ID($and); invert = true; break;
+        case vpiOrPrim:   base = ID($or); break;
+        case vpiNorPrim:  base = ID($or); invert = true; break;
+        case vpiXorPrim:  base = ID($xor); break;
+        case vpiXnorPrim: base = ID($xor); invert = true; break;
+        case vpiNotPrim:  invert = true; break;
+        case vpiBufPrim:  break;
+        default: return false;
+    }
+
+    auto terms = *gate_template->Prim_terms();
+    if (unary ? terms.size() != 2 : terms.size() < 3)
+        return false;
+
+    auto gather = [&](const UHDM::prim_term* term, bool is_output,
+                      RTLIL::SigSpec& out) -> bool {
+        if (!term->Expr()) return false;
+        RTLIL::SigSpec full = import_expression(term->Expr());
+        if (full.empty() || (is_output && full.size() == 1)) return false;
+        for (int b : bit_indices) {
+            if (full.size() == 1) out.append(full);
+            else if (b >= 0 && b < full.size()) out.append(full[b]);
+            else return false;
+        }
+        return true;
+    };
+    RTLIL::SigSpec y;
+    std::vector<RTLIL::SigSpec> inputs(terms.size() - 1);
+    if (!gather(terms[0], true, y)) return false;
+    for (size_t k = 1; k < terms.size(); k++)
+        if (!gather(terms[k], false, inputs[k - 1])) return false;
+
+    int width = GetSize(bit_indices);
+    RTLIL::IdString name = get_unique_cell_name(array_name);
+    RTLIL::SigSpec result = inputs[0];
+    for (size_t k = 1; k < inputs.size(); k++) {
+        bool last = (k + 1 == inputs.size()) && !invert;
+        RTLIL::SigSpec stage_y = y;
+        if (!last) {
+            RTLIL::Wire* w = module->addWire(NEW_ID, width);
+            stage_y = RTLIL::SigSpec(w);
+        }
+        RTLIL::Cell* cell = module->addCell(last ? name : NEW_ID, base);
+        cell->parameters[ID::A_SIGNED] = RTLIL::Const(0);
+        cell->parameters[ID::B_SIGNED] = RTLIL::Const(0);
+        cell->parameters[ID::A_WIDTH] = RTLIL::Const(width);
+        cell->parameters[ID::B_WIDTH] = RTLIL::Const(width);
+        cell->parameters[ID::Y_WIDTH] = RTLIL::Const(width);
+        cell->setPort(ID::A, result);
+        cell->setPort(ID::B, inputs[k]);
+        cell->setPort(ID::Y, stage_y);
+        add_src_attribute(cell->attributes, gate_template);
+        result = stage_y;
+    }
+    RTLIL::Cell* out_cell = nullptr;
+    if (invert) {
+        out_cell = module->addCell(name, ID($not));
+        out_cell->parameters[ID::A_SIGNED] = RTLIL::Const(0);
+        out_cell->parameters[ID::A_WIDTH] = RTLIL::Const(width);
+        out_cell->parameters[ID::Y_WIDTH] = RTLIL::Const(width);
+        out_cell->setPort(ID::A, result);
+        out_cell->setPort(ID::Y, y);
+        add_src_attribute(out_cell->attributes, gate_template);
+    } else if (unary) {
+        module->connect(y, result);
+    } else {
+        out_cell = module->cell(name);
+    }
+    if (out_cell && gate_template->Attributes()) {
+        for (auto attr : *gate_template->Attributes()) {
+            std::string attr_name = std::string(attr->VpiName());
+            if (attr_name.empty()) continue;
+            out_cell->attributes[RTLIL::escape_id(attr_name)] = import_attribute_value(attr);
+        }
+    }
+
+    log_uhdm_debug("UHDM: Gate array '%s' imported as %d-bit word-level %s\n",
+        array_name.c_str(), width,
+        unary ? (invert ? "$not" : "buffer") : log_id(base));
+    return true;
+}
+
 // Import a single element of a gate array
 void UhdmImporter::import_gate_array_element(const gate* gate_template, const std::string& instance_name, int bit_index) {
     if (!gate_template) return;
@@ -465,7 +576,7 @@ void UhdmImporter::import_gate_array_element(const gate* gate_template, const st
             return;
     }
     
-    log("UHDM: Creating %s gate '%s' (bit %d)\n", gate_type_str.c_str(), instance_name.c_str(), bit_index);
+    log_uhdm_debug("UHDM: Creating %s gate '%s' (bit %d)\n", gate_type_str.c_str(), instance_name.c_str(), bit_index);
     
     // Get terminals (ports)
     if (!gate_template->Prim_terms()) {
@@ -572,7 +683,7 @@ void UhdmImporter::import_gate_array_element(const gate* gate_template, const st
         cell->setPort(ID::B, input_b);
     }
     
-    log("UHDM: Successfully created %s gate element\n", gate_type_str.c_str());
+    log_uhdm_debug("UHDM: Successfully created %s gate element\n", gate_type_str.c_str());
 }
 
 YOSYS_NAMESPACE_END
\ No newline at end of file
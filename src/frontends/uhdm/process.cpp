@@ -247,48 +247,53 @@ static RTLIL::Cell* build_check_cell(UhdmImporter* self,
 
 // Import immediate assertion as $check cell (following DRY principle)
 void UhdmImporter::import_immediate_assert(const UHDM::immediate_assert* assert_stmt, RTLIL::Wire*& enable_wire) {
-    log("UHDM: import_immediate_assert called, in_always_ff=%d, clock_sig.empty=%d\n",
+    log_uhdm_trace("UHDM: import_immediate_assert called, in_always_ff=%d, clock_sig.empty=%d\n",
         in_always_ff_context ? 1 : 0, current_ff_clock_sig.empty() ? 1 : 0);
     if (!assert_stmt || !assert_stmt->Expr()) {
         return;
     }
     build_check_cell(this, assert_stmt, assert_stmt->Expr(), "assert", enable_wire);
-    log("        Created $check cell for assertion\n");
+    log_uhdm_trace("        Created $check cell for assertion\n");
     log_flush();
 }
 
 // Import immediate cover as $check cell (FLAVOR="cover").
 void UhdmImporter::import_immediate_cover(const UHDM::immediate_cover* cover_stmt, RTLIL::Wire*& enable_wire) {
-    log("UHDM: import_immediate_cover called, in_always_ff=%d, clock_sig.empty=%d\n",
+    log_uhdm_trace("UHDM: import_immediate_cover called, in_always_ff=%d, clock_sig.empty=%d\n",
         in_always_ff_context ? 1 : 0, current_ff_clock_sig.empty() ? 1 : 0);
     if (!cover_stmt || !cover_stmt->Expr()) {
         return;
     }
     build_check_cell(this, cover_stmt, cover_stmt->Expr(), "cover", enable_wire);
-    log("        Created $check cell for cover\n");
+    log_uhdm_trace("        Created $check cell for cover\n");
     log_flush();
 }
 
 // Import a process statement (always block)
 void UhdmImporter::import_process(const process_stmt* uhdm_process) {
+    HeatmapScope heat(this, uhdm_process);
+    UhdmTraceSpan span("import_process", uhdm_trace_on ? get_src_attribute(uhdm_process) : std::string());
     int proc_type = uhdm_process->VpiType();
     
-    log("UHDM: === Starting import_process ===\n");
+    log_uhdm_trace("UHDM: === Starting import_process ===\n");
     
     // Clear assert enable wires tracking for this process
     current_assert_enable_wires.clear();
+    // Index decoders are only shared between writes of the same process
+    dyn_index_decoders.clear();
+    expr_cache.clear();
     
     // Debug: Print process location
     std::string proc_src = get_src_attribute(uhdm_process);
-    log("UHDM: Process source location: %s\n", proc_src.c_str());
+    log_uhdm_trace("UHDM: Process source location: %s\n", proc_src.c_str());
     
-    log("UHDM: Process type: %d (vpiAlways=%d, vpiAlwaysFF=%d, vpiAlwaysComb=%d)\n", 
+    log_uhdm_trace("UHDM: Process type: %d (vpiAlways=%d, vpiAlwaysFF=%d, vpiAlwaysComb=%d)\n", 
         proc_type, vpiAlways, vpiAlwaysFF, vpiAlwaysComb);
-    log("UHDM: Current module has %d wires before process import\n", (int)module->wires().size());
+    log_uhdm_trace("UHDM: Current module has %d wires before process import\n", (int)module->wires().size());
     
     // List current wires for debugging
     for (auto wire : module->wires()) {
-        log("UHDM: Existing wire: %s (width=%d)\n", wire->name.c_str(), wire->width);
+        log_uhdm_trace("UHDM: Existing wire: %s (width=%d)\n", wire->name.c_str(), wire->width);
     }
     
     // Create process with name based on actual source location
@@ -338,23 +343,23 @@ void UhdmImporter::import_process(const process_stmt* uhdm_process) {
             // Use VpiAlwaysType() method to get the always type
             try {
                 int always_type = always_obj->VpiAlwaysType();
-                log("  Found VpiAlwaysType: %d (vpiAlways=1, vpiAlwaysComb=2, vpiAlwaysFF=3)\n", always_type);
+                log_uhdm_trace("  Found VpiAlwaysType: %d (vpiAlways=1, vpiAlwaysComb=2, vpiAlwaysFF=3)\n", always_type);
                 
                 switch (always_type) {
                     case 2: // vpiAlwaysComb
                         proc_type = vpiAlwaysComb;
-                        log("  Reclassified as always_comb using VpiAlwaysType\n");
+                        log_uhdm_trace("  Reclassified as always_comb using VpiAlwaysType\n");
                         break;
                     case 3: // vpiAlwaysFF  
                         proc_type = vpiAlwaysFF;
-                        log("  Reclassified as always_ff using VpiAlwaysType\n");
+                        log_uhdm_trace("  Reclassified as always_ff using VpiAlwaysType\n");
                         break;
                     default:
-                        log("  Unknown VpiAlwaysType: %d, keeping as generic always\n", always_type);
+                        log_uhdm_trace("  Unknown VpiAlwaysType: %d, keeping as generic always\n", always_type);
                         break;
                 }
             } catch (...) {
-                log("  VpiAlwaysType method failed, using heuristic\n");
+                log_uhdm_trace("  VpiAlwaysType method failed, using heuristic\n");
                 
                 // Fallback to heuristic approach
                 UhdmClocking clocking(this, uhdm_process);
@@ -367,37 +372,37 @@ void UhdmImporter::import_process(const process_stmt* uhdm_process) {
                     
                     if (process_count == 1) {
                         proc_type = vpiAlwaysFF;
-                        log("  Reclassified as always_ff (heuristic: first process with clk/reset)\n");
+                        log_uhdm_trace("  Reclassified as always_ff (heuristic: first process with clk/reset)\n");
                     } else {
                         proc_type = vpiAlwaysComb;
-                        log("  Reclassified as always_comb (heuristic: subsequent process)\n");
+                        log_uhdm_trace("  Reclassified as always_comb (heuristic: subsequent process)\n");
                     }
                 } else {
                     proc_type = vpiAlwaysComb; 
-                    log("  Reclassified as always_comb (no clock/reset detected)\n");
+                    log_uhdm_trace("  Reclassified as always_comb (no clock/reset detected)\n");
                 }
             }
         } else {
-            log("  Failed to cast to always object\n");
+            log_uhdm_trace("  Failed to cast to always object\n");
         }
     }
     
     // Handle different process types
     switch (proc_type) {
         case vpiAlwaysFF:
-            log("  Processing always_ff block\n");
+            log_uhdm_trace("  Processing always_ff block\n");
             import_always_ff(uhdm_process, yosys_proc);
             break;
         case vpiAlwaysComb:
-            log("  Processing always_comb block\n");
+            log_uhdm_trace("  Processing always_comb block\n");
             import_always_comb(uhdm_process, yosys_proc);
             break;
         case vpiAlways:
-            log("  Processing always block\n");
+            log_uhdm_trace("  Processing always block\n");
             import_always(uhdm_process, yosys_proc);
             break;
         case vpiInitial:
-            log("  Processing initial block\n");
+            log_uhdm_trace("  Processing initial block\n");
             import_initial(uhdm_process, yosys_proc);
             break;
         default:
@@ -410,7 +415,7 @@ void UhdmImporter::import_process(const process_stmt* uhdm_process) {
     
     // Add initialization assignments for all assert enable wires at the beginning of the process
     if (!current_assert_enable_wires.empty()) {
-        log("  Adding initialization for %d assert enable wires\n", (int)current_assert_enable_wires.size());
+        log_uhdm_trace("  Adding initialization for %d assert enable wires\n", (int)current_assert_enable_wires.size());
         // Insert at the beginning of root_case actions
         for (auto it = current_assert_enable_wires.rbegin(); it != current_assert_enable_wires.rend(); ++it) {
             yosys_proc->root_case.actions.insert(yosys_proc->root_case.actions.begin(),
@@ -558,7 +563,7 @@ static int match_switch_compare_widths(RTLIL::CaseRule* case_rule,
             for (auto& cmp : sub_case->compare) {
                 if (cmp.size() != sw_w) {
                     if (debug)
-                        log("Warning: UHDM: switch/compare width mismatch in %s: "
+                        log_uhdm_trace("Warning: UHDM: switch/compare width mismatch in %s: "
                             "selector %s (w=%d) vs compare %s (w=%d) — reconciling\n",
                             modname.c_str(), log_signal(sw->signal), sw_w,
                             log_signal(cmp), cmp.size());
@@ -1003,7 +1008,7 @@ void UhdmImporter::finalize_dead_selfhold_defaults()
             if (c.sig->attributes.count(RTLIL::ID::init)) continue;
             if (uses.count(c.sig) && uses.at(c.sig) > 0) continue;
             c.act->second = RTLIL::SigSpec(RTLIL::State::Sx, c.sig->width);
-            log("UHDM: %s.%s: self-hold default replaced with X (held value "
+            log_uhdm_trace("UHDM: %s.%s: self-hold default replaced with X (held value "
                 "never observed — write-before-read comb temp)\n",
                 log_id(mod->name), log_id(c.sig->name));
         }
@@ -1155,7 +1160,7 @@ void UhdmImporter::ff_simple_eval(const UHDM::any* stmt,
 
 // Import always_ff block
 void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Process* yosys_proc) {
-    log("    Importing always_ff block\n");
+    log_uhdm_trace("    Importing always_ff block\n");
     log_flush();
     
     // Set always_ff context right at the start
@@ -1172,10 +1177,10 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
     current_comb_values.clear();
 
     // Set the always_ff attribute
-    log("      Setting always_ff attribute\n");
+    log_uhdm_trace("      Setting always_ff attribute\n");
     log_flush();
     yosys_proc->attributes[ID::always_ff] = RTLIL::Const(1);
-    log("      Attribute set successfully\n");
+    log_uhdm_trace("      Attribute set successfully\n");
     log_flush();
     
     // Get the clock signal from the event control
@@ -1188,32 +1193,32 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
     std::vector<std::pair<RTLIL::SigSpec, bool>> all_edge_triggers;
     
     if (auto stmt = uhdm_process->Stmt()) {
-        log("      Got statement from process\n");
+        log_uhdm_trace("      Got statement from process\n");
         log_flush();
         
         // Check if wrapped in event_control
         if (stmt->VpiType() == vpiEventControl) {
-            log("      Statement is event_control\n");
+            log_uhdm_trace("      Statement is event_control\n");
             log_flush();
             const event_control* event_ctrl = any_cast<const event_control*>(stmt);
             
             // Extract clock signal from sensitivity
             const any* event_expr = event_ctrl->VpiCondition();
             if (event_expr) {
-                log("      Got event expression\n");
+                log_uhdm_trace("      Got event expression\n");
                 log_flush();
                 // Check if it's a simple edge or combined edges (or)
                 if (event_expr->VpiType() == vpiOperation) {
-                    log("      Event expression is operation\n");
+                    log_uhdm_trace("      Event expression is operation\n");
                     log_flush();
                     const operation* op = any_cast<const operation*>(event_expr);
-                    log("      Operation type: %d (vpiEventOrOp=%d, vpiPosedgeOp=%d, vpiNegedgeOp=%d)\n", 
+                    log_uhdm_trace("      Operation type: %d (vpiEventOrOp=%d, vpiPosedgeOp=%d, vpiNegedgeOp=%d)\n", 
                         op->VpiOpType(), vpiEventOrOp, vpiPosedgeOp, vpiNegedgeOp);
                     log_flush();
                     
                     // Check if it's an "or" operation (multiple sensitivity items)
                     if (op->VpiOpType() == vpiEventOrOp) {
-                        log("      Found multiple sensitivity items (or operation)\n");
+                        log_uhdm_trace("      Found multiple sensitivity items (or operation)\n");
                         log_flush();
                         // For always_ff with async reset, we expect posedge clk or negedge rst_n
                         // Mark this as having async reset - we'll handle it specially
@@ -1245,10 +1250,10 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                                     clock_sig = sig;
                                     clock_posedge = is_pos;
                                     current_ff_clock_sig = sig;
-                                    log("      Edge trigger %s (%s) — first, using as clock\n",
+                                    log_uhdm_trace("      Edge trigger %s (%s) — first, using as clock\n",
                                         log_signal(sig), is_pos ? "pos" : "neg");
                                 } else {
-                                    log("      Edge trigger %s (%s) — additional\n",
+                                    log_uhdm_trace("      Edge trigger %s (%s) — additional\n",
                                         log_signal(sig), is_pos ? "pos" : "neg");
                                 }
                             }
@@ -1256,7 +1261,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                     } else if (op->VpiOpType() == vpiPosedgeOp) {
                         clock_posedge = true;
                         if (op->Operands() && !op->Operands()->empty()) {
-                            log("      Importing clock signal from posedge\n");
+                            log_uhdm_trace("      Importing clock signal from posedge\n");
                             log_flush();
                             clock_sig = import_expression(any_cast<const expr*>((*op->Operands())[0]));
                             // An edge expression triggers on its LSB (IEEE 1800);
@@ -1267,13 +1272,13 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                             if (clock_sig.size() > 1) clock_sig = clock_sig.extract(0, 1);
                             current_ff_clock_sig = clock_sig; // Store for assertions
                             current_ff_edges = {{clock_sig, clock_posedge}};
-                            log("      Clock signal imported: %s\n", log_signal(clock_sig));
+                            log_uhdm_trace("      Clock signal imported: %s\n", log_signal(clock_sig));
                             log_flush();
                         }
                     } else if (op->VpiOpType() == vpiNegedgeOp) {
                         clock_posedge = false;
                         if (op->Operands() && !op->Operands()->empty()) {
-                            log("      Importing clock signal from negedge\n");
+                            log_uhdm_trace("      Importing clock signal from negedge\n");
                             log_flush();
                             clock_sig = import_expression(any_cast<const expr*>((*op->Operands())[0]));
                             // Edge triggers on the LSB — reduce a mis-sized
@@ -1282,12 +1287,12 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                             if (clock_sig.size() > 1) clock_sig = clock_sig.extract(0, 1);
                             current_ff_clock_sig = clock_sig; // Store for assertions
                             current_ff_edges = {{clock_sig, clock_posedge}};
-                            log("      Clock signal imported: %s\n", log_signal(clock_sig));
+                            log_uhdm_trace("      Clock signal imported: %s\n", log_signal(clock_sig));
                             log_flush();
                         }
                     } else if (op->VpiOpType() == vpiListOp) {
                         // Handle list operation (e.g., sensitivity list with multiple items)
-                        log("      Found list operation\n");
+                        log_uhdm_trace("      Found list operation\n");
                         log_flush();
                         if (op->Operands() && !op->Operands()->empty()) {
                             // If we have multiple edge triggers in a list, it's an async reset pattern
@@ -1302,7 +1307,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                             }
                             
                             if (edge_trigger_count > 1) {
-                                log("      List contains %d edge triggers - marking as async reset\n", edge_trigger_count);
+                                log_uhdm_trace("      List contains %d edge triggers - marking as async reset\n", edge_trigger_count);
                                 yosys_proc->attributes[ID("has_async_reset")] = RTLIL::Const(1);
 
                                 // Extract clock and reset signals from the list
@@ -1323,12 +1328,12 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                                                     clock_sig = sig;
                                                     clock_posedge = is_posedge;
                                                     found_clock = true;
-                                                    log("      Found clock signal in list: %s (%s edge)\n",
+                                                    log_uhdm_trace("      Found clock signal in list: %s (%s edge)\n",
                                                         log_signal(clock_sig), clock_posedge ? "pos" : "neg");
                                                 } else {
                                                     reset_sig = sig;
                                                     reset_posedge = is_posedge;
-                                                    log("      Found reset signal in list: %s (%s edge)\n",
+                                                    log_uhdm_trace("      Found reset signal in list: %s (%s edge)\n",
                                                         log_signal(reset_sig), reset_posedge ? "pos" : "neg");
                                                 }
                                             }
@@ -1353,12 +1358,12 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                                                     auto sig = import_expression(any_cast<const expr*>((*edge_op->Operands())[0]));
                                                     bool is_posedge = (edge_op->VpiOpType() == vpiPosedgeOp);
                                                     all_edge_signals.push_back({sig, is_posedge});
-                                                    log("      Found edge trigger: %s (%s edge)\n", 
+                                                    log_uhdm_trace("      Found edge trigger: %s (%s edge)\n", 
                                                         log_signal(sig), is_posedge ? "pos" : "neg");
                                                 }
                                             } else if (edge_op->VpiOpType() == vpiListOp) {
                                                 // Nested list - recurse
-                                                log("      Found nested list, recursing to collect edge triggers\n");
+                                                log_uhdm_trace("      Found nested list, recursing to collect edge triggers\n");
                                                 if (edge_op->Operands()) {
                                                     collect_edge_triggers(edge_op->Operands());
                                                 }
@@ -1379,24 +1384,24 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                                     // First edge trigger is the clock
                                     clock_sig = all_edge_signals[0].first;
                                     clock_posedge = all_edge_signals[0].second;
-                                    log("      Using first edge trigger as clock: %s (%s edge)\n", 
+                                    log_uhdm_trace("      Using first edge trigger as clock: %s (%s edge)\n", 
                                         log_signal(clock_sig), clock_posedge ? "pos" : "neg");
                                     
                                     if (all_edge_signals.size() > 1) {
                                         // Multiple edge triggers - mark as async reset
-                                        log("      Found %zu edge triggers total - marking as async reset\n", all_edge_signals.size());
+                                        log_uhdm_trace("      Found %zu edge triggers total - marking as async reset\n", all_edge_signals.size());
                                         yosys_proc->attributes[ID("has_async_reset")] = RTLIL::Const(1);
                                         
                                         // Use second edge trigger as primary reset
                                         // Note: For SR flip-flops with 3+ edge triggers, we need special handling
                                         reset_sig = all_edge_signals[1].first;
                                         reset_posedge = all_edge_signals[1].second;
-                                        log("      Using second edge trigger as reset: %s (%s edge)\n", 
+                                        log_uhdm_trace("      Using second edge trigger as reset: %s (%s edge)\n", 
                                             log_signal(reset_sig), reset_posedge ? "pos" : "neg");
                                         
                                         // Store all edge triggers for SR flip-flop handling
                                         if (all_edge_signals.size() > 2) {
-                                            log("      Warning: Found %zu edge triggers (SR flip-flop pattern)\n", all_edge_signals.size());
+                                            log_uhdm_trace("      Warning: Found %zu edge triggers (SR flip-flop pattern)\n", all_edge_signals.size());
                                             // For SR flip-flops, we need to create sync rules for ALL edge triggers
                                             // This will be handled in a separate code path
                                             yosys_proc->attributes[ID("is_sr_ff")] = RTLIL::Const(1);
@@ -1410,14 +1415,14 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
             }
             
             // Get the actual statement
-            log("      Getting actual statement from event control\n");
+            log_uhdm_trace("      Getting actual statement from event control\n");
             log_flush();
             stmt = event_ctrl->Stmt();
         }
         
         // Check if we have async reset pattern
         if (yosys_proc->attributes.count(ID("has_async_reset"))) {
-            log("      Processing always_ff with async reset\n");
+            log_uhdm_trace("      Processing always_ff with async reset\n");
             log_flush();
             
             // For async reset, we don't import into sync rules
@@ -1505,11 +1510,11 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                 collect_live_assigned_signals(stmt, true, all_signals,
                                               /*fold_guards=*/false);
                 if (mode_debug) {
-                    log("    ff dead-guard prune: live={");
-                    for (auto& n : live_signals) log(" %s", n.c_str());
-                    log(" } all={");
-                    for (auto& n : all_signals) log(" %s", n.c_str());
-                    log(" }\n");
+                    log_uhdm_trace("    ff dead-guard prune: live={");
+                    for (auto& n : live_signals) log_uhdm_trace(" %s", n.c_str());
+                    log_uhdm_trace(" } all={");
+                    for (auto& n : all_signals) log_uhdm_trace(" %s", n.c_str());
+                    log_uhdm_trace(" }\n");
                 }
                 if (live_signals.size() < all_signals.size())
                     assigned_signals.erase(
@@ -1741,7 +1746,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                         part_slice[sig.name] = {off, w};
                         yosys_proc->root_case.actions.push_back(RTLIL::SigSig(
                             RTLIL::SigSpec(temp_wire), signal_spec));
-                        log("      Created temp wire %s for part-select %s[%d +: %d]\n",
+                        log_uhdm_trace("      Created temp wire %s for part-select %s[%d +: %d]\n",
                             temp_name.c_str(), sig.name.c_str(), off, w);
                     }
                     continue;
@@ -1766,7 +1771,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                 yosys_proc->root_case.actions.push_back(RTLIL::SigSig(
                     RTLIL::SigSpec(temp_wire), signal_spec));
 
-                log("      Created temp wire %s (width=%d) for full signal\n",
+                log_uhdm_trace("      Created temp wire %s (width=%d) for full signal\n",
                     temp_name.c_str(), signal_spec.size());
             }
             
@@ -1822,16 +1827,12 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                             RTLIL::CaseRule* sw = new RTLIL::CaseRule;
                             sw->switches.push_back(new RTLIL::SwitchRule);
                             sw->switches[0]->signal = cond_sig;
-                            std::string if_else_src = get_src_attribute(if_else_stmt);
-                            if (!if_else_src.empty())
-                                sw->switches[0]->attributes[ID::src] = RTLIL::Const(if_else_src);
+                            add_src_attribute(sw->switches[0]->attributes, if_else_stmt);
 
                             // Case for true (reset)
                             RTLIL::CaseRule* case_true = new RTLIL::CaseRule;
                             case_true->compare.push_back(RTLIL::Const(1, 1));
-                            std::string then_src = if_else_stmt->VpiStmt() ? get_src_attribute(if_else_stmt->VpiStmt()) : "";
-                            if (!then_src.empty())
-                                case_true->attributes[ID::src] = RTLIL::Const(then_src);
+                            add_src_attribute(case_true->attributes, if_else_stmt->VpiStmt());
                             
                             // Import reset assignments into case_true
                             if (auto then_stmt = if_else_stmt->VpiStmt()) {
@@ -1849,7 +1850,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                                 // Set always_ff context for assert handling
                                 in_always_ff_context = true;
                                 current_ff_clock_sig = clock_sig;
-                                log("      Setting always_ff context for async reset: clock_sig.empty()=%d\n", clock_sig.empty() ? 1 : 0);
+                                log_uhdm_trace("      Setting always_ff context for async reset: clock_sig.empty()=%d\n", clock_sig.empty() ? 1 : 0);
 
                                 import_statement_comb(then_stmt, case_true);
 
@@ -1861,9 +1862,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
 
                             // Case for false (else)
                             RTLIL::CaseRule* case_false = new RTLIL::CaseRule;
-                            std::string else_src = if_else_stmt->VpiElseStmt() ? get_src_attribute(if_else_stmt->VpiElseStmt()) : "";
-                            if (!else_src.empty())
-                                case_false->attributes[ID::src] = RTLIL::Const(else_src);
+                            add_src_attribute(case_false->attributes, if_else_stmt->VpiElseStmt());
 
                             // Handle else statement
                             if (auto else_stmt = if_else_stmt->VpiElseStmt()) {
@@ -1880,7 +1879,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                                 // Set always_ff context for assert handling
                                 in_always_ff_context = true;
                                 current_ff_clock_sig = clock_sig;
-                                log("      Setting always_ff context for async reset: clock_sig.empty()=%d\n", clock_sig.empty() ? 1 : 0);
+                                log_uhdm_trace("      Setting always_ff context for async reset: clock_sig.empty()=%d\n", clock_sig.empty() ? 1 : 0);
                                 
                                 import_statement_comb(else_stmt, case_false);
                                 
@@ -1896,7 +1895,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
             // Create sync rules that update from temp wires
             if (yosys_proc->attributes.count(ID("is_sr_ff"))) {
                 // SR flip-flop: create sync rules for ALL edge triggers
-                log("      Creating sync rules for SR flip-flop with %zu edge triggers\n", all_edge_triggers.size());
+                log_uhdm_trace("      Creating sync rules for SR flip-flop with %zu edge triggers\n", all_edge_triggers.size());
                 
                 for (const auto& [sig, is_posedge] : all_edge_triggers) {
                     RTLIL::SyncRule* sync = new RTLIL::SyncRule;
@@ -1913,11 +1912,11 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                     }
                     
                     yosys_proc->syncs.push_back(sync);
-                    log("      Created sync rule for %s (%s edge)\n", 
+                    log_uhdm_trace("      Created sync rule for %s (%s edge)\n", 
                         log_signal(sig), is_posedge ? "pos" : "neg");
                 }
                 
-                log("      Created %zu sync rules for SR flip-flop\n", all_edge_triggers.size());
+                log_uhdm_trace("      Created %zu sync rules for SR flip-flop\n", all_edge_triggers.size());
             } else {
                 // Normal async reset: create sync rules for clock and reset only
                 if (clock_sig.empty()) {
@@ -1953,7 +1952,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                         sync_clk->actions.push_back(RTLIL::SigSig(lhs, rhs));
                         sync_rst->actions.push_back(RTLIL::SigSig(lhs, rhs));
 
-                        log("      Added sync update for %s\n", sig_name.c_str());
+                        log_uhdm_trace("      Added sync update for %s\n", sig_name.c_str());
                     }
                 }
 
@@ -1970,14 +1969,14 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                     action.data = RTLIL::SigSpec(info.data_wire);
                     action.priority_mask = RTLIL::Const(RTLIL::State::S1, (int)pi);
                     action.enable = RTLIL::SigSpec(info.en_wire);
-                    log("      Added memory write action for %s on clock edge\n",
+                    log_uhdm_trace("      Added memory write action for %s on clock edge\n",
                         info.mem_id.c_str());
                 }
 
                 yosys_proc->syncs.push_back(sync_clk);
                 yosys_proc->syncs.push_back(sync_rst);
                 
-                log("      Created sync rules for clock and reset\n");
+                log_uhdm_trace("      Created sync rules for clock and reset\n");
             }
             log_flush();
             
@@ -1990,8 +1989,8 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
 
         } else {
             // No async reset - check if this is a simple synchronous if-else pattern
-            log("      No async reset detected\n");
-            log("      Clock signal at this point: %s (empty: %d)\n", log_signal(clock_sig), clock_sig.empty());
+            log_uhdm_trace("      No async reset detected\n");
+            log_uhdm_trace("      Clock signal at this point: %s (empty: %d)\n", log_signal(clock_sig), clock_sig.empty());
             log_flush();
             
             // Check if the statement is a simple if-else pattern
@@ -2000,15 +1999,15 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
             std::set<std::string> assigned_signals;
             
             if (stmt) {
-                log("      Statement type: %d (vpiIf=%d, vpiIfElse=%d, vpiBegin=%d)\n", 
+                log_uhdm_trace("      Statement type: %d (vpiIf=%d, vpiIfElse=%d, vpiBegin=%d)\n", 
                     stmt->VpiType(), vpiIf, vpiIfElse, vpiBegin);
                 // Check for direct if, if-else, or if-else inside begin block
                 if (stmt->VpiType() == vpiIfElse) {
-                    log("      Detected vpiIfElse, setting is_simple_if_else = true\n");
+                    log_uhdm_trace("      Detected vpiIfElse, setting is_simple_if_else = true\n");
                     simple_if_stmt = any_cast<const if_else*>(stmt);
                     is_simple_if_else = true;
                 } else if (stmt->VpiType() == vpiIf) {
-                    log("      Detected vpiIf, setting is_simple_if_else = true\n");
+                    log_uhdm_trace("      Detected vpiIf, setting is_simple_if_else = true\n");
                     simple_if_stmt = any_cast<const UHDM::if_stmt*>(stmt);
                     is_simple_if_else = true;
                 } else if (stmt->VpiType() == vpiBegin || stmt->VpiType() == vpiNamedBegin) {
@@ -2027,7 +2026,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                 
                 // If we found an if-else, check if both branches assign to same signals
                 if (is_simple_if_else && simple_if_stmt) {
-                    log("      Found if/if-else statement, checking if it's simple\n");
+                    log_uhdm_trace("      Found if/if-else statement, checking if it's simple\n");
                     
                     // Get the then statement and else statement (if exists)
                     const any* then_stmt = nullptr;
@@ -2046,7 +2045,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                     // First check if the if-else contains complex constructs
                     if ((then_stmt && contains_complex_constructs(then_stmt)) ||
                         (else_stmt && contains_complex_constructs(else_stmt))) {
-                        log("      If-else contains complex constructs (for loops, memory writes) - skipping simple if-else optimization\n");
+                        log_uhdm_trace("      If-else contains complex constructs (for loops, memory writes) - skipping simple if-else optimization\n");
                         is_simple_if_else = false;
                     } else {
                         std::set<std::string> then_signals, else_signals;
@@ -2063,11 +2062,11 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                                 // Has else branch - check if both branches assign same signals
                                 if (then_signals == else_signals) {
                                     assigned_signals = then_signals;
-                                    log("      Detected simple if-else pattern assigning to: ");
+                                    log_uhdm_trace("      Detected simple if-else pattern assigning to: ");
                                     for (const auto& sig : assigned_signals) {
-                                        log("%s ", sig.c_str());
+                                        log_uhdm_trace("%s ", sig.c_str());
                                     }
-                                    log("\n");
+                                    log_uhdm_trace("\n");
                                 } else {
                                     is_simple_if_else = false;
                                 }
@@ -2075,11 +2074,11 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                                 // No else branch - simple if statement
                                 assigned_signals = then_signals;
                                 is_simple_if_else = true;  // Ensure flag is true for simple if
-                                log("      Detected simple if pattern (no else) assigning to: ");
+                                log_uhdm_trace("      Detected simple if pattern (no else) assigning to: ");
                                 for (const auto& sig : assigned_signals) {
-                                    log("%s ", sig.c_str());
+                                    log_uhdm_trace("%s ", sig.c_str());
                                 }
-                                log("\n");
+                                log_uhdm_trace("\n");
                             }
                         } else {
                             is_simple_if_else = false;
@@ -2087,12 +2086,12 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                     }
                 }
             } else {
-                log("      No statement found for simple if detection\n");
+                log_uhdm_trace("      No statement found for simple if detection\n");
             }
             
             if (is_simple_if_else && simple_if_stmt) {
                 // Handle simple if-else with proper switch statement
-                log("      Creating switch statement for simple if-else\n");
+                log_uhdm_trace("      Creating switch statement for simple if-else\n");
                 log_flush();
                 
                 // Check if any of the assigned signals are memories
@@ -2102,7 +2101,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                     RTLIL::IdString sig_id = RTLIL::escape_id(sig_name);
                     if (module->memories.count(sig_id)) {
                         memory_signals.insert(sig_name);
-                        log("      Signal %s is a memory\n", sig_name.c_str());
+                        log_uhdm_trace("      Signal %s is a memory\n", sig_name.c_str());
                     } else {
                         regular_signals.insert(sig_name);
                     }
@@ -2110,7 +2109,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                 
                 // If we have memory writes, we need special handling
                 if (!memory_signals.empty()) {
-                    log("      Detected memory writes in simple if-else pattern\n");
+                    log_uhdm_trace("      Detected memory writes in simple if-else pattern\n");
                     
                     // For memory writes, we need to create temp wires for the memory control signals
                     // (address, data, enable) and handle them specially
@@ -2151,7 +2150,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                         yosys_proc->root_case.actions.push_back(RTLIL::SigSig(
                             RTLIL::SigSpec(en_wire), RTLIL::SigSpec(RTLIL::State::S0)));
                         
-                        log("      Created memory write control wires for %s\n", mem_name.c_str());
+                        log_uhdm_trace("      Created memory write control wires for %s\n", mem_name.c_str());
                     }
                     
                     // Create temporary wires for regular (non-memory) signals
@@ -2179,7 +2178,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                         yosys_proc->root_case.actions.push_back(RTLIL::SigSig(
                             RTLIL::SigSpec(temp_wire), RTLIL::SigSpec(orig_wire)));
                         
-                        log("      Created temp wire %s for signal %s\n", 
+                        log_uhdm_trace("      Created temp wire %s for signal %s\n", 
                             temp_name.c_str(), sig_name.c_str());
                     }
                     
@@ -2187,7 +2186,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                     // and assign to the memory control wires instead of directly creating memwr
                     // For now, fall back to the original behavior
                     is_simple_if_else = false;
-                    log("      Memory write handling not fully implemented, falling back to original behavior\n");
+                    log_uhdm_trace("      Memory write handling not fully implemented, falling back to original behavior\n");
                 } else {
                     // No memory signals, handle regular signals only
                 }
@@ -2240,7 +2239,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                     yosys_proc->root_case.actions.push_back(RTLIL::SigSig(
                         RTLIL::SigSpec(temp_wire), RTLIL::SigSpec(orig_wire)));
                     
-                    log("      Created temp wire %s for signal %s\n", 
+                    log_uhdm_trace("      Created temp wire %s for signal %s\n", 
                         temp_name.c_str(), sig_name.c_str());
                 }
                 
@@ -2268,17 +2267,13 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                 // Create switch statement
                 RTLIL::SwitchRule* sw = new RTLIL::SwitchRule;
                 sw->signal = condition;
-                std::string sw_src = get_src_attribute(simple_if_stmt);
-                if (!sw_src.empty())
-                    sw->attributes[ID::src] = RTLIL::Const(sw_src);
+                add_src_attribute(sw->attributes, simple_if_stmt);
 
                 // Case for true (then branch)
                 RTLIL::CaseRule* case_true = new RTLIL::CaseRule;
                 case_true->compare.push_back(RTLIL::Const(1, 1));
                 if (then_stmt) {
-                    std::string then_src2 = get_src_attribute(then_stmt);
-                    if (!then_src2.empty())
-                        case_true->attributes[ID::src] = RTLIL::Const(then_src2);
+                    add_src_attribute(case_true->attributes, then_stmt);
                 }
                 
                 // Import then assignments
@@ -2299,9 +2294,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                 
                 // Import else assignments if present
                 if (else_stmt) {
-                    std::string else_src2 = get_src_attribute(else_stmt);
-                    if (!else_src2.empty())
-                        case_default->attributes[ID::src] = RTLIL::Const(else_src2);
+                    add_src_attribute(case_default->attributes, else_stmt);
                     // Map signal names to temp wires for import
                     for (const auto& [sig_name, temp_wire] : temp_wires) {
                         current_signal_temp_wires[sig_name] = temp_wire;
@@ -2380,7 +2373,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                 }
                 
                 yosys_proc->syncs.push_back(sync);
-                log("      Switch statement and sync rule created\n");
+                log_uhdm_trace("      Switch statement and sync rule created\n");
                 log_flush();
                 
             } else {
@@ -2407,7 +2400,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                                         if (!lhs_bs->VpiName().empty() && lhs_bs->VpiName() == rhs_bs->VpiName()) {
                                             has_shift_register = true;
                                             shift_register_arrays.insert(std::string(lhs_bs->VpiName()));
-                                            log("      Detected shift register pattern for array '%s'\n", 
+                                            log_uhdm_trace("      Detected shift register pattern for array '%s'\n", 
                                                 std::string(lhs_bs->VpiName()).c_str());
                                         }
                                     }
@@ -2417,7 +2410,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                     }
                 }
                 
-                log("      Checking for memory writes in process\n");
+                log_uhdm_trace("      Checking for memory writes in process\n");
                 log_flush();
                 
                 // Scan for memory writes in the statement (excluding shift registers)
@@ -2434,7 +2427,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                 std::map<std::string, RTLIL::Wire*> register_temp_wires;
                 
                 if (has_shift_register) {
-                    log("      Creating temp wires for shift register unrolling\n");
+                    log_uhdm_trace("      Creating temp wires for shift register unrolling\n");
                     
                     // First create temp wires for regular registers (rA, rB)
                     // We'll scan the begin block for non-for-loop assignments
@@ -2456,7 +2449,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                                                 add_src_attribute(temp_wire->attributes, uhdm_process);
                                             }
                                             register_temp_wires[sig_name] = temp_wire;
-                                            log("        Created temp wire %s for register %s\n", temp_name.c_str(), sig_name.c_str());
+                                            log_uhdm_trace("        Created temp wire %s for register %s\n", temp_name.c_str(), sig_name.c_str());
                                         }
                                     }
                                 }
@@ -2492,7 +2485,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                                 }
                                 
                                 register_temp_wires[elem_name] = temp_wire;
-                                log("        Created temp wire %s for shift register element %s\n", temp_name.c_str(), elem_name.c_str());
+                                log_uhdm_trace("        Created temp wire %s for shift register element %s\n", temp_name.c_str(), elem_name.c_str());
                             }
                         }
                     }
@@ -2509,7 +2502,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                             yosys_proc->root_case.actions.push_back(
                                 RTLIL::SigSig(RTLIL::SigSpec(temp_wire), RTLIL::SigSpec(orig_wire))
                             );
-                            log("        Initial assignment: %s = %s\n", temp_wire->name.c_str(), orig_wire->name.c_str());
+                            log_uhdm_trace("        Initial assignment: %s = %s\n", temp_wire->name.c_str(), orig_wire->name.c_str());
                         }
                     }
                     
@@ -2530,7 +2523,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                                             yosys_proc->root_case.actions.push_back(
                                                 RTLIL::SigSig(RTLIL::SigSpec(register_temp_wires[sig_name]), rhs)
                                             );
-                                            log("        Assignment: %s = %s\n", 
+                                            log_uhdm_trace("        Assignment: %s = %s\n", 
                                                 register_temp_wires[sig_name]->name.c_str(), 
                                                 log_signal(rhs).c_str());
                                         }
@@ -2558,7 +2551,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                                                 yosys_proc->root_case.actions.push_back(
                                                     RTLIL::SigSig(RTLIL::SigSpec(register_temp_wires[elem_name]), rhs)
                                                 );
-                                                log("        Assignment: %s = %s\n", 
+                                                log_uhdm_trace("        Assignment: %s = %s\n", 
                                                     register_temp_wires[elem_name]->name.c_str(), 
                                                     log_signal(rhs).c_str());
                                             }
@@ -2591,7 +2584,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                                                     RTLIL::SigSpec(src_reg)
                                                 )
                                             );
-                                            log("        Shift assignment: %s = %s\n",
+                                            log_uhdm_trace("        Shift assignment: %s = %s\n",
                                                 register_temp_wires[dst_elem]->name.c_str(),
                                                 src_reg->name.c_str());
                                         }
@@ -2617,12 +2610,12 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                             sync->actions.push_back(
                                 RTLIL::SigSig(RTLIL::SigSpec(orig_wire), RTLIL::SigSpec(temp_wire))
                             );
-                            log("        Sync update: %s <= %s\n", orig_wire->name.c_str(), temp_wire->name.c_str());
+                            log_uhdm_trace("        Sync update: %s <= %s\n", orig_wire->name.c_str(), temp_wire->name.c_str());
                         }
                     }
                     
                     yosys_proc->syncs.push_back(sync);
-                    log("      Shift register processing complete\n");
+                    log_uhdm_trace("      Shift register processing complete\n");
                     
                     // Don't continue to memory write handling
                     return;
@@ -2652,7 +2645,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                     // Memory writes inside for loops: the custom CaseRule* memory-write
                     // path cannot handle for-loop unrolling.  Fall back to import_statement_sync
                     // which processes them correctly via import_statement_with_loop_vars.
-                    log("      Found memory writes inside for loop, using sync path\n");
+                    log_uhdm_trace("      Found memory writes inside for loop, using sync path\n");
                     log_flush();
 
                     if (clock_sig.empty())
@@ -2671,14 +2664,14 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                     pending_sync_assignments.clear();
 
                     yosys_proc->syncs.push_back(sync);
-                    log("      Sync rule created (memory-in-for-loop fallback)\n");
+                    log_uhdm_trace("      Sync rule created (memory-in-for-loop fallback)\n");
                     log_flush();
                 } else if (!memory_names.empty()) {
-                    log("      Found memory writes to: ");
+                    log_uhdm_trace("      Found memory writes to: ");
                     for (const auto& mem_name : memory_names) {
-                        log("%s ", mem_name.c_str());
+                        log_uhdm_trace("%s ", mem_name.c_str());
                     }
-                    log("\n");
+                    log_uhdm_trace("\n");
                     log_flush();
 
                     // Create temp wires for memory control signals.  A memory
@@ -2739,7 +2732,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                             yosys_proc->root_case.actions.push_back(RTLIL::SigSig(
                                 RTLIL::SigSpec(data_wire), RTLIL::SigSpec(RTLIL::State::S0, mem->width)));
 
-                            log("      Created memory control wires for %s[port %d]: addr=%s, data=%s, en=%s\n",
+                            log_uhdm_trace("      Created memory control wires for %s[port %d]: addr=%s, data=%s, en=%s\n",
                                 mem_name.c_str(), w, addr_wire_name.c_str(), data_wire_name.c_str(), en_wire_name.c_str());
                         }
                     }
@@ -2803,14 +2796,14 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                     }
                     // Non-empty current_temp_wires gates map_to_temp_wire on;
                     // it then resolves `$0\<sig>` by module-wire lookup.
-                    current_temp_wires = ff_reg_temp_map;
+                    current_temp_wires = decltype(current_temp_wires)(ff_reg_temp_map.begin(), ff_reg_temp_map.end());
 
                     // Import the statement into the process body (root_case)
                     // This will generate assignments to the temp wires
-                    log("      Importing statement into process body for memory write handling\n");
+                    log_uhdm_trace("      Importing statement into process body for memory write handling\n");
                     log_flush();
                     import_statement_comb(stmt, &yosys_proc->root_case);
-                    log("      Statement imported to process body\n");
+                    log_uhdm_trace("      Statement imported to process body\n");
                     log_flush();
                     current_temp_wires.clear();
     comb_signal_temp_map.clear();
@@ -2842,7 +2835,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                         // Per-bit enable wire is already memory-width.
                         action.enable = RTLIL::SigSpec(info.en_wire);
 
-                        log("      Added memory write action for %s\n", info.mem_id.c_str());
+                        log_uhdm_trace("      Added memory write action for %s\n", info.mem_id.c_str());
                     }
 
                     // Latch the registered non-memory signals on the clock
@@ -2867,16 +2860,16 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                                 i = j;
                             }
                             sync->actions.push_back(RTLIL::SigSig(l, r));
-                            log("      Added sync update (written bits only) for %s\n", sig_name.c_str());
+                            log_uhdm_trace("      Added sync update (written bits only) for %s\n", sig_name.c_str());
                         } else {
                             sync->actions.push_back(
                                 RTLIL::SigSig(lhs, RTLIL::SigSpec(temp_wire)));
-                            log("      Added sync update for registered signal %s\n", sig_name.c_str());
+                            log_uhdm_trace("      Added sync update for registered signal %s\n", sig_name.c_str());
                         }
                     }
 
                     yosys_proc->syncs.push_back(sync);
-                    log("      Sync rule with memory writes created\n");
+                    log_uhdm_trace("      Sync rule with memory writes created\n");
                     log_flush();
                     
                     // Clear memory write tracking
@@ -2886,7 +2879,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                     // Body contains a repeat loop or a for loop nested inside a conditional.
                     // These are not handled by import_statement_comb; fall back to the old
                     // import_statement_sync path which handles them correctly.
-                    log("      No memory writes but body needs sync path (repeat/nested for), using sync path\n");
+                    log_uhdm_trace("      No memory writes but body needs sync path (repeat/nested for), using sync path\n");
                     log_flush();
 
                     if (clock_sig.empty())
@@ -2905,7 +2898,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                     pending_sync_assignments.clear();
 
                     yosys_proc->syncs.push_back(sync);
-                    log("      Sync rule created (blocking-assignment fallback)\n");
+                    log_uhdm_trace("      Sync rule created (blocking-assignment fallback)\n");
                     log_flush();
                 } else if (gen_scope_stack.empty() && ff_body_is_simple(stmt)) {
                     // SSA cv-threading path: full-wire scalar blocking/non-
@@ -2914,7 +2907,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                     // and a later blocking read sees the registered value of NB
                     // targets — the genrtlil semantics the switch model can't
                     // express (always03).
-                    log("      Simple always_ff body: using SSA cv-threading\n");
+                    log_uhdm_trace("      Simple always_ff body: using SSA cv-threading\n");
                     log_flush();
                     if (clock_sig.empty())
                         log_error("Clock signal is empty when creating sync rule at line %d\n", __LINE__);
@@ -2940,16 +2933,16 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                         if (d.size() < w->width) d.extend_u0(w->width);
                         else if (d.size() > w->width) d = d.extract(0, w->width);
                         sync->actions.push_back(RTLIL::SigSig(RTLIL::SigSpec(w), d));
-                        log("    SSA sync update: %s <= %s\n", w->name.c_str(), log_signal(d));
+                        log_uhdm_trace("    SSA sync update: %s <= %s\n", w->name.c_str(), log_signal(d));
                     }
                     yosys_proc->syncs.push_back(sync);
-                    log("      Simple always_ff SSA sync rule created\n");
+                    log_uhdm_trace("      Simple always_ff SSA sync rule created\n");
                     log_flush();
                 } else {
                     // No memory writes and no blocking assignments: use comb-style
                     // implementation to produce a proper switch/case structure inside
                     // the process body (matching Verilog frontend output).
-                    log("      No memory writes detected, using comb-style switch structure\n");
+                    log_uhdm_trace("      No memory writes detected, using comb-style switch structure\n");
                     log_flush();
 
                     if (clock_sig.empty())
@@ -3080,13 +3073,13 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                             signal_temp_wires[dedup_key] = temp_wire;
                             signal_specs[dedup_key] = spec_for_signal;
                             temp_wires_map[sig.lhs_expr] = temp_wire;
-                            log("    Created FF temp wire %s for signal %s (width=%d)\n",
+                            log_uhdm_trace("    Created FF temp wire %s for signal %s (width=%d)\n",
                                 temp_wire->name.c_str(), sig.name.c_str(), tmp_width);
                         }
                     }
 
                     // Set context so map_to_temp_wire() finds the $0\ wires
-                    current_temp_wires = temp_wires_map;
+                    current_temp_wires = decltype(current_temp_wires)(temp_wires_map.begin(), temp_wires_map.end());
 
                     // Add hold defaults: $0\x = \x (ensures registers hold value when not assigned)
                     for (const auto& [sig_name, temp_wire] : signal_temp_wires) {
@@ -3094,7 +3087,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                             RTLIL::SigSpec lhs_spec = signal_specs[sig_name];
                             yosys_proc->root_case.actions.push_back(
                                 RTLIL::SigSig(RTLIL::SigSpec(temp_wire), lhs_spec));
-                            log("    Added hold default: %s = %s\n",
+                            log_uhdm_trace("    Added hold default: %s = %s\n",
                                 temp_wire->name.c_str(), log_signal(lhs_spec));
                         }
                     }
@@ -3108,9 +3101,9 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                     in_always_ff_body_mode = true;
 
                     // Import the body using comb-style statement handling (produces switch/case structure)
-                    log("      Importing FF body with comb-style switch structure\n");
+                    log_uhdm_trace("      Importing FF body with comb-style switch structure\n");
                     import_statement_comb(stmt, yosys_proc);
-                    log("      FF body imported\n");
+                    log_uhdm_trace("      FF body imported\n");
 
                     // Clear comb context
                     in_always_ff_body_mode = false;
@@ -3152,18 +3145,18 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
                                 i = j;
                             }
                             sync->actions.push_back(RTLIL::SigSig(l, r));
-                            log("    Added sync update (written bits only): %s <= %s\n",
+                            log_uhdm_trace("    Added sync update (written bits only): %s <= %s\n",
                                 log_signal(l), temp_wire->name.c_str());
                         } else {
                             sync->actions.push_back(
                                 RTLIL::SigSig(lhs_spec, RTLIL::SigSpec(temp_wire)));
-                            log("    Added sync update: %s <= %s\n",
+                            log_uhdm_trace("    Added sync update: %s <= %s\n",
                                 log_signal(lhs_spec), temp_wire->name.c_str());
                         }
                     }
 
                     yosys_proc->syncs.push_back(sync);
-                    log("      Sync rule with comb-style switch structure created\n");
+                    log_uhdm_trace("      Sync rule with comb-style switch structure created\n");
                     log_flush();
                 }
             }
@@ -3208,7 +3201,7 @@ void UhdmImporter::import_always_ff(const process_stmt* uhdm_process, RTLIL::Pro
 // Import always_comb block
 void UhdmImporter::import_always_comb(const process_stmt* uhdm_process, RTLIL::Process* yosys_proc) {
     if (mode_debug)
-        log("    Importing always_comb block\n");
+        log_uhdm_trace("    Importing always_comb block\n");
     
     // Don't set always_comb attribute - let Yosys infer latch behavior
     // yosys_proc->attributes[ID::always_comb] = RTLIL::Const(1);
@@ -3424,7 +3417,7 @@ void UhdmImporter::import_always_comb(const process_stmt* uhdm_process, RTLIL::P
                 signal_specs[dedup_key] = RTLIL::SigSpec(first_chunk.wire);
             else
                 signal_specs[dedup_key] = lhs_spec;
-            log("    Created temp wire %s for signal %s (width=%d)\n",
+            log_uhdm_trace("    Created temp wire %s for signal %s (width=%d)\n",
                 temp_wire->name.c_str(), sig.name.c_str(), tmp_width);
         }
 
@@ -3433,8 +3426,8 @@ void UhdmImporter::import_always_comb(const process_stmt* uhdm_process, RTLIL::P
     }
 
     // Store temp wires in module context for use in statement import
-    current_temp_wires = temp_wires;
-    current_lhs_specs = lhs_specs;
+    current_temp_wires = decltype(current_temp_wires)(temp_wires.begin(), temp_wires.end());
+    current_lhs_specs = decltype(current_lhs_specs)(lhs_specs.begin(), lhs_specs.end());
     comb_signal_temp_map.clear();
     for (const auto& [sig_name, tw] : signal_temp_wires)
         comb_signal_temp_map[sig_name] = tw;
@@ -3447,7 +3440,7 @@ void UhdmImporter::import_always_comb(const process_stmt* uhdm_process, RTLIL::P
             yosys_proc->root_case.actions.push_back(
                 RTLIL::SigSig(RTLIL::SigSpec(temp_wire), lhs_spec)
             );
-            log("    Added initialization: %s = %s\n", temp_wire->name.c_str(), log_signal(lhs_spec));
+            log_uhdm_trace("    Added initialization: %s = %s\n", temp_wire->name.c_str(), log_signal(lhs_spec));
         }
     }
     
@@ -3489,7 +3482,7 @@ void UhdmImporter::import_always_comb(const process_stmt* uhdm_process, RTLIL::P
         if (s.lhs_expr->VpiType() == vpiHierPath && !touches_base)
             comb_written_unreliable.insert(s.name);
         if (mode_debug)
-            log("    comb_written probe: name=%s type=%d ls=%s touches=%d\n",
+            log_uhdm_trace("    comb_written probe: name=%s type=%d ls=%s touches=%d\n",
                 s.name.c_str(), s.lhs_expr->VpiType(),
                 log_signal(ls), touches_base ? 1 : 0);
     }
@@ -3521,14 +3514,14 @@ void UhdmImporter::import_always_comb(const process_stmt* uhdm_process, RTLIL::P
                     i = j;
                 }
                 sync_always->actions.push_back(RTLIL::SigSig(l, r));
-                log("    Added partial update: %s <= %s (%d/%d bits)\n",
+                log_uhdm_trace("    Added partial update: %s <= %s (%d/%d bits)\n",
                     sig_name.c_str(), temp_wire->name.c_str(),
                     (int)wb->second.size(), base_w->width);
             } else {
                 sync_always->actions.push_back(
                     RTLIL::SigSig(lhs_spec, RTLIL::SigSpec(temp_wire))
                 );
-                log("    Added update: %s <= %s\n", log_signal(lhs_spec), temp_wire->name.c_str());
+                log_uhdm_trace("    Added update: %s <= %s\n", log_signal(lhs_spec), temp_wire->name.c_str());
             }
         }
     }
@@ -3613,7 +3606,7 @@ void UhdmImporter::import_always_comb(const process_stmt* uhdm_process, RTLIL::P
             const event_control* event_ctrl = any_cast<const event_control*>(stmt);
             if (event_ctrl->Stmt()) {
                 actual_stmt = event_ctrl->Stmt();
-                log("    Unwrapped event_control for combinational block\n");
+                log_uhdm_trace("    Unwrapped event_control for combinational block\n");
             }
         }
         import_statement_comb(actual_stmt, yosys_proc);
@@ -3632,7 +3625,7 @@ void UhdmImporter::import_always_comb(const process_stmt* uhdm_process, RTLIL::P
 
 // Import always block
 void UhdmImporter::import_always(const process_stmt* uhdm_process, RTLIL::Process* yosys_proc) {
-    log("    Importing always block\n");
+    log_uhdm_trace("    Importing always block\n");
     
     // For SystemVerilog always_ff is a different process type, but for regular always,
     // we need to analyze the sensitivity list to determine if it's clocked or combinational
@@ -3649,7 +3642,7 @@ void UhdmImporter::import_always(const process_stmt* uhdm_process, RTLIL::Proces
         // empty" (yosys/tests/fmt/display_lm.v).
         if (stmt->VpiType() != vpiEventControl) {
             is_combinational = true;
-            log("    Detected combinational always block (no event control)\n");
+            log_uhdm_trace("    Detected combinational always block (no event control)\n");
         } else
         // Check if wrapped in event_control
         if (stmt->VpiType() == vpiEventControl) {
@@ -3661,34 +3654,34 @@ void UhdmImporter::import_always(const process_stmt* uhdm_process, RTLIL::Proces
                 // Let's check if we have any edge-triggered signals
                 bool has_edge_trigger = false;
                 
-                log("    Event expression type: %s (vpiType=%d)\n", 
+                log_uhdm_trace("    Event expression type: %s (vpiType=%d)\n", 
                     UhdmName(event_expr->UhdmType()).c_str(), event_expr->VpiType());
                 
                 if (event_expr->VpiType() == vpiOperation) {
                     const operation* op = any_cast<const operation*>(event_expr);
-                    log("    Operation type: %d (vpiPosedgeOp=%d, vpiNegedgeOp=%d, vpiEventOrOp=%d)\n", 
+                    log_uhdm_trace("    Operation type: %d (vpiPosedgeOp=%d, vpiNegedgeOp=%d, vpiEventOrOp=%d)\n", 
                         op->VpiOpType(), vpiPosedgeOp, vpiNegedgeOp, vpiEventOrOp);
                     
                     // Check for posedge/negedge operations
                     if (op->VpiOpType() == vpiPosedgeOp || op->VpiOpType() == vpiNegedgeOp) {
                         has_edge_trigger = true;
-                        log("    Found edge trigger at top level\n");
+                        log_uhdm_trace("    Found edge trigger at top level\n");
                     } else if (op->VpiOpType() == vpiEventOrOp || op->VpiOpType() == vpiListOp) {
                         // Check operands for edge triggers
                         // vpiEventOrOp is used for comma-separated events
                         // vpiListOp (37) is also used for sensitivity lists
                         if (op->Operands()) {
-                            log("    Checking %zu operands of %s\n", op->Operands()->size(), 
+                            log_uhdm_trace("    Checking %zu operands of %s\n", op->Operands()->size(), 
                                 op->VpiOpType() == vpiEventOrOp ? "EventOr" : "ListOp");
                             for (auto operand : *op->Operands()) {
-                                log("      Operand type: %s (vpiType=%d)\n", 
+                                log_uhdm_trace("      Operand type: %s (vpiType=%d)\n", 
                                     UhdmName(operand->UhdmType()).c_str(), operand->VpiType());
                                 if (operand->VpiType() == vpiOperation) {
                                     const operation* sub_op = any_cast<const operation*>(operand);
-                                    log("      Sub-operation type: %d\n", sub_op->VpiOpType());
+                                    log_uhdm_trace("      Sub-operation type: %d\n", sub_op->VpiOpType());
                                     if (sub_op->VpiOpType() == vpiPosedgeOp || sub_op->VpiOpType() == vpiNegedgeOp) {
                                         has_edge_trigger = true;
-                                        log("      Found edge trigger in operand\n");
+                                        log_uhdm_trace("      Found edge trigger in operand\n");
                                         break;
                                     }
                                 }
@@ -3701,21 +3694,21 @@ void UhdmImporter::import_always(const process_stmt* uhdm_process, RTLIL::Proces
                 is_combinational = !has_edge_trigger;
                 
                 if (is_combinational) {
-                    log("    Detected combinational always block (no edge triggers)\n");
+                    log_uhdm_trace("    Detected combinational always block (no edge triggers)\n");
                 }
             } else {
                 // No condition typically means always @*
                 is_combinational = true;
-                log("    Detected combinational always block (empty sensitivity list)\n");
+                log_uhdm_trace("    Detected combinational always block (empty sensitivity list)\n");
             }
         }
     }
     
     if (!is_combinational) {
-        log("    Handling as clocked always block\n");
+        log_uhdm_trace("    Handling as clocked always block\n");
         import_always_ff(uhdm_process, yosys_proc);
     } else {
-        log("    Handling as combinational always block\n");
+        log_uhdm_trace("    Handling as combinational always block\n");
         import_always_comb(uhdm_process, yosys_proc);
     }
 }
@@ -4075,7 +4068,7 @@ void UhdmImporter::create_block_local_wires(const UHDM::any* stmt) {
             name_map[vname] = wire;
             block_local_promoted.insert(vname);
             if (mode_debug)
-                log("UHDM: Created block-local wire %s (width=%d, signed=%d)\n",
+                log_uhdm_trace("UHDM: Created block-local wire %s (width=%d, signed=%d)\n",
                     vname.c_str(), w, wire->is_signed);
         }
     }
@@ -4273,7 +4266,7 @@ bool UhdmImporter::emit_initial_readmem(const any* stmt) {
                     cell->setPort(ID::EN, RTLIL::Const(RTLIL::State::S1, width));
                     it = run;
                 }
-                log("        $readmem%s: initialised memory %s from '%s' (%d words)\n",
+                log_uhdm_trace("        $readmem%s: initialised memory %s from '%s' (%d words)\n",
                     is_bin ? "b" : "h", memname.c_str(), fname.c_str(),
                     (int)memmap.size());
                 handled = true;
@@ -4445,7 +4438,7 @@ bool UhdmImporter::emit_initial_meminit_writes(const any* stmt) {
         cell->setPort(ID::ADDR, RTLIL::Const(addr, 32));
         cell->setPort(ID::DATA, val);
         cell->setPort(ID::EN, RTLIL::Const(RTLIL::State::S1, w));
-        log("        Added $meminit for %s[%d] = %s\n",
+        log_uhdm_trace("        Added $meminit for %s[%d] = %s\n",
             mem.c_str(), addr, val.as_string().c_str());
     }
     return true;
@@ -4453,7 +4446,7 @@ bool UhdmImporter::emit_initial_meminit_writes(const any* stmt) {
 
 void UhdmImporter::import_initial(const process_stmt* uhdm_process, RTLIL::Process* yosys_proc) {
     if (mode_debug)
-        log("    Importing initial block\n");
+        log_uhdm_trace("    Importing initial block\n");
 
     // Set flag to indicate we're in an initial block
     in_initial_block = true;
@@ -4529,7 +4522,7 @@ void UhdmImporter::import_initial(const process_stmt* uhdm_process, RTLIL::Proce
 
 // Import initial block using sync approach (handles for loops via import_statement_sync)
 void UhdmImporter::import_initial_sync(const process_stmt* uhdm_process, RTLIL::Process* yosys_proc) {
-    log("    Importing initial block (sync approach - has for loops)\n");
+    log_uhdm_trace("    Importing initial block (sync approach - has for loops)\n");
 
     // Clear pending assignments from any previous process
     pending_sync_assignments.clear();
@@ -4659,7 +4652,7 @@ void UhdmImporter::import_initial_sync(const process_stmt* uhdm_process, RTLIL::
 
 // Import initial block using comb approach (handles complex case/if via switch rules)
 void UhdmImporter::import_initial_comb(const process_stmt* uhdm_process, RTLIL::Process* yosys_proc) {
-    log("    Importing initial block (comb approach - complex control flow)\n");
+    log_uhdm_trace("    Importing initial block (comb approach - complex control flow)\n");
 
     // Extract signals that will be assigned in this process
     std::vector<AssignedSignal> assigned_signals;
@@ -4729,8 +4722,8 @@ void UhdmImporter::import_initial_comb(const process_stmt* uhdm_process, RTLIL::
     }
 
     // Store temp wires in module context for use in statement import
-    current_temp_wires = temp_wires;
-    current_lhs_specs = lhs_specs;
+    current_temp_wires = decltype(current_temp_wires)(temp_wires.begin(), temp_wires.end());
+    current_lhs_specs = decltype(current_lhs_specs)(lhs_specs.begin(), lhs_specs.end());
     comb_signal_temp_map.clear();
     for (const auto& [sig_name_t, tw_t] : signal_temp_wires)
         comb_signal_temp_map[sig_name_t] = tw_t;
@@ -4880,16 +4873,16 @@ RTLIL::SigSpec UhdmImporter::import_indexed_part_select_with_substitution(const
                                                                           const std::map<std::string, int64_t>& var_substitutions) {
     if (!ips) return RTLIL::SigSpec();
     
-    log("      Importing indexed part select with substitution\n");
+    log_uhdm_trace("      Importing indexed part select with substitution\n");
     
     // Get the base signal name (similar to import_indexed_part_select)
     std::string base_signal_name;
     if (!ips->VpiDefName().empty()) {
         base_signal_name = std::string(ips->VpiDefName());
-        log("        IndexedPartSelect VpiDefName: %s\n", base_signal_name.c_str());
+        log_uhdm_trace("        IndexedPartSelect VpiDefName: %s\n", base_signal_name.c_str());
     } else if (!ips->VpiName().empty()) {
         base_signal_name = std::string(ips->VpiName());
-        log("        IndexedPartSelect VpiName: %s\n", base_signal_name.c_str());
+        log_uhdm_trace("        IndexedPartSelect VpiName: %s\n", base_signal_name.c_str());
     }
     
     // Look up the wire in the current module
@@ -4898,7 +4891,7 @@ RTLIL::SigSpec UhdmImporter::import_indexed_part_select_with_substitution(const
         RTLIL::IdString wire_id = RTLIL::escape_id(base_signal_name);
         if (module->wire(wire_id)) {
             base_signal = RTLIL::SigSpec(module->wire(wire_id));
-            log("        Found wire %s in module (width=%d)\n", wire_id.c_str(), base_signal.size());
+            log_uhdm_trace("        Found wire %s in module (width=%d)\n", wire_id.c_str(), base_signal.size());
         } else {
             log_warning("Wire %s not found in module\n", base_signal_name.c_str());
             return RTLIL::SigSpec();
@@ -4920,7 +4913,7 @@ RTLIL::SigSpec UhdmImporter::import_indexed_part_select_with_substitution(const
         auto it = var_substitutions.find(ref_name);
         if (it != var_substitutions.end()) {
             base_spec = RTLIL::Const(it->second, 32);
-            log("        Substituted %s with %lld\n", ref_name.c_str(), (long long)it->second);
+            log_uhdm_trace("        Substituted %s with %lld\n", ref_name.c_str(), (long long)it->second);
         } else {
             base_spec = import_expression(any_cast<const expr*>(base_expr));
         }
@@ -4937,7 +4930,7 @@ RTLIL::SigSpec UhdmImporter::import_indexed_part_select_with_substitution(const
             width = width_spec.as_int();
         }
     }
-    log("        Width: %d\n", width);
+    log_uhdm_trace("        Width: %d\n", width);
     
     // If base is constant, we can extract the slice directly
     if (base_spec.is_fully_const()) {
@@ -4948,12 +4941,12 @@ RTLIL::SigSpec UhdmImporter::import_indexed_part_select_with_substitution(const
         // For upto indexing [base +: width], extract from base to (base + width - 1)  
         int start_idx = indexed_up ? base_idx : base_idx - width + 1;
         
-        log("        Base index: %d, indexed_up: %d, start_idx: %d\n", base_idx, indexed_up, start_idx);
+        log_uhdm_trace("        Base index: %d, indexed_up: %d, start_idx: %d\n", base_idx, indexed_up, start_idx);
         
         // Extract the slice
         if (start_idx >= 0 && start_idx + width <= base_signal.size()) {
             RTLIL::SigSpec result = base_signal.extract(start_idx, width);
-            log("        Extracted bits [%d:%d] from signal\n", start_idx + width - 1, start_idx);
+            log_uhdm_trace("        Extracted bits [%d:%d] from signal\n", start_idx + width - 1, start_idx);
             return result;
         } else {
             log_warning("Indexed part select out of bounds (start=%d, width=%d, signal_size=%d)\n",
@@ -4987,7 +4980,7 @@ void UhdmImporter::import_statement_with_loop_vars(const any* uhdm_stmt, RTLIL::
             
             // Log LHS type for debugging
             if (lhs) {
-                log("        LHS type: %d (vpiBitSelect=%d, vpiIndexedPartSelect=%d)\n", 
+                log_uhdm_trace("        LHS type: %d (vpiBitSelect=%d, vpiIndexedPartSelect=%d)\n", 
                     lhs->VpiType(), vpiBitSelect, vpiIndexedPartSelect);
             }
             
@@ -5007,7 +5000,7 @@ void UhdmImporter::import_statement_with_loop_vars(const any* uhdm_stmt, RTLIL::
                 if (it != var_substitutions.end()) {
                     // Track this variable for substitution
                     var_substitutions[lhs_name] = it->second;
-                    log("        Variable %s gets value %lld (from %s)\n",
+                    log_uhdm_trace("        Variable %s gets value %lld (from %s)\n",
                         lhs_name.c_str(), (long long)it->second, rhs_name.c_str());
                     // Skip generating the assignment but continue to process other statements
                     // by returning without adding to pending_sync_assignments
@@ -5017,21 +5010,21 @@ void UhdmImporter::import_statement_with_loop_vars(const any* uhdm_stmt, RTLIL::
             
             // Handle indexed part select in LHS with substitution
             if (lhs && lhs->VpiType() == vpiIndexedPartSelect) {
-                log("        Processing indexed part select on LHS\n");
+                log_uhdm_trace("        Processing indexed part select on LHS\n");
                 lhs_spec = import_indexed_part_select_with_substitution(
                     any_cast<const indexed_part_select*>(lhs), var_substitutions);
-                log("        LHS indexed part select result: %s (empty=%d)\n", 
+                log_uhdm_trace("        LHS indexed part select result: %s (empty=%d)\n", 
                     log_signal(lhs_spec), lhs_spec.empty());
             } else if (lhs && lhs->VpiType() == vpiBitSelect) {
                 // Handle bit select LHS - might be a memory write with concatenated index
                 const bit_select* bs = any_cast<const bit_select*>(lhs);
                 std::string signal_name = std::string(bs->VpiName());
-                log("        LHS is bit select of %s\n", signal_name.c_str());
+                log_uhdm_trace("        LHS is bit select of %s\n", signal_name.c_str());
                 
                 // Check if this is a memory
                 RTLIL::IdString mem_id = RTLIL::escape_id(signal_name);
                 if (module->memories.count(mem_id) > 0) {
-                    log("        This is a memory write to %s\n", signal_name.c_str());
+                    log_uhdm_trace("        This is a memory write to %s\n", signal_name.c_str());
                     
                     // Get the index expression
                     auto index_expr = bs->VpiIndex();
@@ -5040,7 +5033,7 @@ void UhdmImporter::import_statement_with_loop_vars(const any* uhdm_stmt, RTLIL::
                         
                         // Check if it's a concatenation
                         if (idx_op->VpiOpType() == vpiConcatOp) {
-                            log("        Memory index is concatenation\n");
+                            log_uhdm_trace("        Memory index is concatenation\n");
                             
                             // Process the concatenation with variable substitution
                             auto operands = idx_op->Operands();
@@ -5060,7 +5053,7 @@ void UhdmImporter::import_statement_with_loop_vars(const any* uhdm_stmt, RTLIL::
                                     auto it = var_substitutions.find(ref_name);
                                     if (it != var_substitutions.end()) {
                                         low_spec = RTLIL::Const(it->second, 2);  // 2-bit for RATIO=4
-                                        log("          Substituted %s with %lld in memory index\n", 
+                                        log_uhdm_trace("          Substituted %s with %lld in memory index\n", 
                                             ref_name.c_str(), (long long)it->second);
                                     } else {
                                         low_spec = import_expression(any_cast<const expr*>(low_part));
@@ -5109,7 +5102,7 @@ void UhdmImporter::import_statement_with_loop_vars(const any* uhdm_stmt, RTLIL::
                 if (it != var_substitutions.end()) {
                     // Replace with constant value
                     rhs_spec = RTLIL::Const(it->second, 32);
-                    log("        Substituted variable %s with value %lld\n", 
+                    log_uhdm_trace("        Substituted variable %s with value %lld\n", 
                         ref_name.c_str(), (long long)it->second);
                 } else {
                     rhs_spec = import_expression(any_cast<const expr*>(rhs));
@@ -5121,9 +5114,9 @@ void UhdmImporter::import_statement_with_loop_vars(const any* uhdm_stmt, RTLIL::
             } else if (rhs && rhs->VpiType() == vpiIndexedPartSelect) {
                 // Handle indexed part select on RHS with variable substitution
                 const indexed_part_select* ips = any_cast<const indexed_part_select*>(rhs);
-                log("        RHS is indexed part select, calling substitution function\n");
+                log_uhdm_trace("        RHS is indexed part select, calling substitution function\n");
                 rhs_spec = import_indexed_part_select_with_substitution(ips, var_substitutions);
-                log("        RHS indexed part select result: %s (empty=%d)\n", 
+                log_uhdm_trace("        RHS indexed part select result: %s (empty=%d)\n", 
                     log_signal(rhs_spec), rhs_spec.empty());
             } else if (rhs && rhs->VpiType() == vpiBitSelect) {
                 // Handle bit select that might reference an array with loop variable in index
@@ -5133,7 +5126,7 @@ void UhdmImporter::import_statement_with_loop_vars(const any* uhdm_stmt, RTLIL::
                 // Check if index contains concatenation with loop variable
                 if (index_expr && index_expr->VpiType() == vpiOperation) {
                     const operation* idx_op = any_cast<const operation*>(index_expr);
-                    log("        Bit select index is operation type %d (vpiConcatOp=%d)\n", 
+                    log_uhdm_trace("        Bit select index is operation type %d (vpiConcatOp=%d)\n", 
                         idx_op->VpiOpType(), vpiConcatOp);
                     if (idx_op->VpiOpType() == vpiConcatOp) {
                         // This is likely RAM[{addrB, lsbaddr}]
@@ -5143,7 +5136,7 @@ void UhdmImporter::import_statement_with_loop_vars(const any* uhdm_stmt, RTLIL::
                             // For bit_select, the parent should be the array
                             // The name is in VpiName of the bit_select itself
                             std::string mem_name = std::string(bs->VpiName());
-                            log("        Bit select of %s, checking if it's a memory (found=%d)\n", 
+                            log_uhdm_trace("        Bit select of %s, checking if it's a memory (found=%d)\n", 
                                 mem_name.c_str(), module->memories.count(RTLIL::escape_id(mem_name)));
                             if (module->memories.count(RTLIL::escape_id(mem_name))) {
                                 // This is a memory access
@@ -5167,11 +5160,11 @@ void UhdmImporter::import_statement_with_loop_vars(const any* uhdm_stmt, RTLIL::
                                         const ref_obj* ref = any_cast<const ref_obj*>(low_part);
                                         std::string ref_name = std::string(ref->VpiName());
                                         auto it = var_substitutions.find(ref_name);
-                                        log("          Looking for %s in substitutions (found=%d)\n",
+                                        log_uhdm_trace("          Looking for %s in substitutions (found=%d)\n",
                                             ref_name.c_str(), it != var_substitutions.end());
                                         if (it != var_substitutions.end()) {
                                             low_spec = RTLIL::Const(it->second, 2);  // 2-bit for RATIO=4
-                                            log("          Substituted %s with %lld\n", ref_name.c_str(), (long long)it->second);
+                                            log_uhdm_trace("          Substituted %s with %lld\n", ref_name.c_str(), (long long)it->second);
                                         } else {
                                             low_spec = import_expression(any_cast<const expr*>(low_part));
                                         }
@@ -5248,7 +5241,7 @@ void UhdmImporter::import_statement_with_loop_vars(const any* uhdm_stmt, RTLIL::
                 } else {
                     pending_sync_assignments[lhs_spec] = rhs_spec;
                 }
-                log("        Added assignment with substitution: %s <= %s (cond=%s)\n",
+                log_uhdm_trace("        Added assignment with substitution: %s <= %s (cond=%s)\n",
                     log_signal(lhs_spec), log_signal(rhs_spec),
                     current_condition.empty() ? "none" : log_signal(current_condition));
             } else if (lhs_spec.empty() && lhs && lhs->VpiType() == vpiBitSelect && !rhs_spec.empty()) {
@@ -5283,7 +5276,7 @@ void UhdmImporter::import_statement_with_loop_vars(const any* uhdm_stmt, RTLIL::
                                     auto it = var_substitutions.find(ref_name);
                                     if (it != var_substitutions.end()) {
                                         low_spec = RTLIL::Const(it->second, 2);  // 2-bit for RATIO=4
-                                        log("          Using substituted value %lld for %s in address\n", 
+                                        log_uhdm_trace("          Using substituted value %lld for %s in address\n", 
                                             (long long)it->second, ref_name.c_str());
                                     } else {
                                         low_spec = import_expression(any_cast<const expr*>(low_part));
@@ -5320,7 +5313,7 @@ void UhdmImporter::import_statement_with_loop_vars(const any* uhdm_stmt, RTLIL::
                         
                         pending_memory_writes.push_back(mem_write);
                         
-                        log("        Collected memory write: %s[%s] <= %s (condition: %s)\n", 
+                        log_uhdm_trace("        Collected memory write: %s[%s] <= %s (condition: %s)\n", 
                             mem_name.c_str(), log_signal(addr_spec), log_signal(rhs_spec),
                             current_condition.empty() ? "none" : log_signal(current_condition));
                     }
@@ -5360,7 +5353,7 @@ void UhdmImporter::import_statement_with_loop_vars(const any* uhdm_stmt, RTLIL::
                         
                         // Add assignment to the slice wire
                         pending_sync_assignments[slice_wire] = rhs_spec;
-                        log("        Added slice assignment: %s <= %s (for %s[%d -: %d])\n",
+                        log_uhdm_trace("        Added slice assignment: %s <= %s (for %s[%d -: %d])\n",
                             slice_wire_name.c_str(), log_signal(rhs_spec), 
                             signal_name.c_str(), base_idx, width);
                         
@@ -5450,48 +5443,49 @@ void UhdmImporter::import_statement_with_loop_vars(const any* uhdm_stmt, RTLIL::
 
 // Import statement for synchronous context
 void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule* sync, bool is_reset) {
-    log("        import_statement_sync called\n");
+    log_uhdm_trace("        import_statement_sync called\n");
     log_flush();
     
     if (!uhdm_stmt) {
-        log("        Statement is null, returning\n");
+        log_uhdm_trace("        Statement is null, returning\n");
         log_flush();
         return;
     }
+    HeatmapScope heat(this, uhdm_stmt);
     
     int stmt_type = uhdm_stmt->VpiType();
-    log("        Statement type: %d\n", stmt_type);
+    log_uhdm_trace("        Statement type: %d\n", stmt_type);
     log_flush();
     
     switch (stmt_type) {
         case vpiBegin:
         case vpiNamedBegin:
-            log("        Processing begin block\n");
+            log_uhdm_trace("        Processing begin block\n");
             log_flush();
             import_begin_block_sync(any_cast<const scope*>(uhdm_stmt), sync, is_reset);
-            log("        Begin block processed\n");
+            log_uhdm_trace("        Begin block processed\n");
             log_flush();
             break;
         case vpiAssignment:
-            log("        Processing assignment\n");
+            log_uhdm_trace("        Processing assignment\n");
             log_flush();
             import_assignment_sync(any_cast<const assignment*>(uhdm_stmt), sync);
-            log("        Assignment processed\n");
+            log_uhdm_trace("        Assignment processed\n");
             log_flush();
             break;
         case vpiIf:
-            log("        Processing if statement\n");
+            log_uhdm_trace("        Processing if statement\n");
             log_flush();
             import_if_stmt_sync(any_cast<const if_stmt*>(uhdm_stmt), sync, is_reset);
-            log("        If statement processed\n");
+            log_uhdm_trace("        If statement processed\n");
             log_flush();
             break;
         case vpiIfElse: {
-            log("        Processing if-else statement\n");
+            log_uhdm_trace("        Processing if-else statement\n");
             log_flush();
             // if_else and if_stmt are siblings, both extend atomic_stmt
             const if_else* if_else_stmt = any_cast<const if_else*>(uhdm_stmt);
-            log("        Cast to if_else successful, has else stmt: %s\n", 
+            log_uhdm_trace("        Cast to if_else successful, has else stmt: %s\n", 
                 if_else_stmt->VpiElseStmt() ? "yes" : "no");
             log_flush();
             
@@ -5524,7 +5518,7 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                     if (condition.size() > 1) {
                         condition = module->ReduceBool(NEW_ID, condition);
                     }
-                    log("        If-else condition: %s\n", log_signal(condition));
+                    log_uhdm_trace("        If-else condition: %s\n", log_signal(condition));
                     log_flush();
                 }
 
@@ -5541,14 +5535,14 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                 
                 // Import then statement
                 if (auto then_stmt = if_else_stmt->VpiStmt()) {
-                    log("        Importing then statement\n");
+                    log_uhdm_trace("        Importing then statement\n");
                     log_flush();
                     import_statement_sync(then_stmt, sync, is_reset);
                 }
                 
                 // Handle else statement
                 if (auto else_stmt = if_else_stmt->VpiElseStmt()) {
-                    log("        Found else statement to import (type=%d)\n", else_stmt->VpiType());
+                    log_uhdm_trace("        Found else statement to import (type=%d)\n", else_stmt->VpiType());
                     log_flush();
                     // Invert condition for else branch
                     if (!condition.empty()) {
@@ -5568,19 +5562,19 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                 current_condition = prev_condition;
             }
             
-            log("        If-else statement processed\n");
+            log_uhdm_trace("        If-else statement processed\n");
             log_flush();
             break;
         }
         case vpiCase:
-            log("        Processing case statement\n");
+            log_uhdm_trace("        Processing case statement\n");
             log_flush();
             import_case_stmt_sync(any_cast<const case_stmt*>(uhdm_stmt), sync, is_reset);
-            log("        Case statement processed\n");
+            log_uhdm_trace("        Case statement processed\n");
             log_flush();
             break;
         case vpiImmediateAssert: {
-            log("        Processing immediate assert - converting to $check cell\n");
+            log_uhdm_trace("        Processing immediate assert - converting to $check cell\n");
             log_flush();
 
             const UHDM::immediate_assert* assert_stmt = any_cast<const UHDM::immediate_assert*>(uhdm_stmt);
@@ -5592,12 +5586,12 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                 sync->actions.push_back(RTLIL::SigSig(enable_wire, RTLIL::State::S1));
             }
 
-            log("        Immediate assert processed\n");
+            log_uhdm_trace("        Immediate assert processed\n");
             log_flush();
             break;
         }
         case vpiImmediateCover: {
-            log("        Processing immediate cover - converting to $check cell\n");
+            log_uhdm_trace("        Processing immediate cover - converting to $check cell\n");
             log_flush();
 
             const UHDM::immediate_cover* cover_stmt = any_cast<const UHDM::immediate_cover*>(uhdm_stmt);
@@ -5608,12 +5602,12 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                 sync->actions.push_back(RTLIL::SigSig(enable_wire, RTLIL::State::S1));
             }
 
-            log("        Immediate cover processed\n");
+            log_uhdm_trace("        Immediate cover processed\n");
             log_flush();
             break;
         }
         case vpiRepeat: {
-            log("        Processing repeat loop\n");
+            log_uhdm_trace("        Processing repeat loop\n");
             log_flush();
             const UHDM::repeat* repeat_stmt = any_cast<const UHDM::repeat*>(uhdm_stmt);
 
@@ -5632,7 +5626,7 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                 log_warning("Repeat count %d is out of range, skipping\n", repeat_count);
                 break;
             }
-            log("        Repeat count: %d\n", repeat_count);
+            log_uhdm_trace("        Repeat count: %d\n", repeat_count);
 
             // 2. Get body statements
             const any* repeat_body = repeat_stmt->VpiStmt();
@@ -5690,10 +5684,10 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
 
                     if (is_index_incr && index_var_name.empty()) {
                         index_var_name = lhs_name;
-                        log("        Detected loop index variable: %s\n", lhs_name.c_str());
+                        log_uhdm_trace("        Detected loop index variable: %s\n", lhs_name.c_str());
                     } else {
                         blocking_var_names.insert(lhs_name);
-                        log("        Detected blocking intermediate variable: %s\n", lhs_name.c_str());
+                        log_uhdm_trace("        Detected blocking intermediate variable: %s\n", lhs_name.c_str());
                     }
                 }
             };
@@ -5716,7 +5710,7 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                         RTLIL::SigSpec init_val = pending_sync_assignments[idx_spec];
                         if (init_val.is_fully_const()) {
                             initial_index = init_val.as_const().as_int();
-                            log("        Initial index value: %d\n", initial_index);
+                            log_uhdm_trace("        Initial index value: %d\n", initial_index);
                         }
                     }
                 }
@@ -5729,20 +5723,20 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                     RTLIL::SigSpec var_spec(var_wire);
                     if (pending_sync_assignments.count(var_spec)) {
                         blocking_values[var_name] = pending_sync_assignments[var_spec];
-                        log("        Initial blocking value for %s: %s\n",
+                        log_uhdm_trace("        Initial blocking value for %s: %s\n",
                             var_name.c_str(), log_signal(pending_sync_assignments[var_spec]));
                     }
                 }
             }
 
             // 5. Unroll the loop
-            log("        Unrolling repeat loop %d times\n", repeat_count);
+            log_uhdm_trace("        Unrolling repeat loop %d times\n", repeat_count);
             for (int k = 0; k < repeat_count; k++) {
                 // Set loop index in loop_values for compile-time substitution
                 if (!index_var_name.empty()) {
                     loop_values[index_var_name] = initial_index + k;
                     if (mode_debug)
-                        log("        Iteration %d: %s = %d\n", k, index_var_name.c_str(), initial_index + k);
+                        log_uhdm_trace("        Iteration %d: %s = %d\n", k, index_var_name.c_str(), initial_index + k);
                 }
 
                 auto process_stmts = [&](const VectorOfany* stmts) {
@@ -5780,7 +5774,7 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                             if (!lhs_name.empty() && !rhs_spec.empty()) {
                                 blocking_values[lhs_name] = rhs_spec;
                                 if (mode_debug)
-                                    log("        Updated blocking var %s = %s\n",
+                                    log_uhdm_trace("        Updated blocking var %s = %s\n",
                                         lhs_name.c_str(), log_signal(rhs_spec));
                             }
                         } else {
@@ -5810,7 +5804,7 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                                 // Add to sync actions directly (non-blocking = goes to sync rule)
                                 sync->actions.push_back(RTLIL::SigSig(lhs_spec, rhs_spec));
                                 if (mode_debug)
-                                    log("        Added sync action: %s <= %s\n",
+                                    log_uhdm_trace("        Added sync action: %s <= %s\n",
                                         log_signal(lhs_spec), log_signal(rhs_spec));
                             }
                         }
@@ -5832,7 +5826,7 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                 RTLIL::Wire* var_wire = module->wire(RTLIL::escape_id(var_name));
                 if (var_wire) {
                     pending_sync_assignments[RTLIL::SigSpec(var_wire)] = var_sig;
-                    log("        Final blocking value for %s: %s\n",
+                    log_uhdm_trace("        Final blocking value for %s: %s\n",
                         var_name.c_str(), log_signal(var_sig));
                 }
             }
@@ -5843,7 +5837,7 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                 if (idx_wire) {
                     int final_index = initial_index + repeat_count;
                     pending_sync_assignments[RTLIL::SigSpec(idx_wire)] = RTLIL::Const(final_index, idx_wire->width);
-                    log("        Final index value for %s: %d\n", index_var_name.c_str(), final_index);
+                    log_uhdm_trace("        Final index value for %s: %d\n", index_var_name.c_str(), final_index);
                 }
             }
 
@@ -5852,24 +5846,24 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                 loop_values.erase(index_var_name);
             }
 
-            log("        Repeat loop unrolled successfully\n");
+            log_uhdm_trace("        Repeat loop unrolled successfully\n");
             log_flush();
             break;
         }
         case vpiFor: {
-            log("        Processing for loop in initial block\n");
+            log_uhdm_trace("        Processing for loop in initial block\n");
             log_flush();
             const for_stmt* for_loop = any_cast<const for_stmt*>(uhdm_stmt);
             
             // Debug: Show what we're processing
             if (mode_debug) {
-                log("          For loop components:\n");
-                log("            Has init stmts: %s\n", (for_loop->VpiForInitStmts() && !for_loop->VpiForInitStmts()->empty()) ? "yes" : "no");
-                log("            Has condition: %s\n", for_loop->VpiCondition() ? "yes" : "no");
-                log("            Has inc stmts: %s\n", (for_loop->VpiForIncStmts() && !for_loop->VpiForIncStmts()->empty()) ? "yes" : "no");
-                log("            Has body: %s\n", for_loop->VpiStmt() ? "yes" : "no");
+                log_uhdm_trace("          For loop components:\n");
+                log_uhdm_trace("            Has init stmts: %s\n", (for_loop->VpiForInitStmts() && !for_loop->VpiForInitStmts()->empty()) ? "yes" : "no");
+                log_uhdm_trace("            Has condition: %s\n", for_loop->VpiCondition() ? "yes" : "no");
+                log_uhdm_trace("            Has inc stmts: %s\n", (for_loop->VpiForIncStmts() && !for_loop->VpiForIncStmts()->empty()) ? "yes" : "no");
+                log_uhdm_trace("            Has body: %s\n", for_loop->VpiStmt() ? "yes" : "no");
                 if (for_loop->VpiStmt()) {
-                    log("            Body type: %d (vpiBegin=%d, vpiAssignment=%d)\n", 
+                    log_uhdm_trace("            Body type: %d (vpiBegin=%d, vpiAssignment=%d)\n", 
                         for_loop->VpiStmt()->VpiType(), vpiBegin, vpiAssignment);
                 }
             }
@@ -5961,7 +5955,7 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                                             }
                                             
                                             initial_values[var_name] = value;
-                                            log("        Found initial value: %s = 0x%llx\n", var_name.c_str(), (unsigned long long)value);
+                                            log_uhdm_trace("        Found initial value: %s = 0x%llx\n", var_name.c_str(), (unsigned long long)value);
                                         }
                                     }
                                 }
@@ -6001,7 +5995,7 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                         loop_var_name = init_name;
                         start_value = init_spec.as_const().as_int();
                         can_unroll = true;
-                        log("        Loop init: %s = %lld\n", loop_var_name.c_str(), (long long)start_value);
+                        log_uhdm_trace("        Loop init: %s = %lld\n", loop_var_name.c_str(), (long long)start_value);
                     }
                 }
             }
@@ -6040,19 +6034,19 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
 
                                 if (param_value.is_fully_const()) {
                                     end_value = param_value.as_const().as_int();
-                                    log("        Loop condition: %s %s %s (resolved to %lld)\n",
+                                    log_uhdm_trace("        Loop condition: %s %s %s (resolved to %lld)\n",
                                         loop_var_name.c_str(), is_neq_condition ? "!=" : (inclusive ? "<=" : "<"),
                                         std::string(param_ref->VpiName()).c_str(), (long long)end_value);
                                 } else {
                                     can_unroll = false;
-                                    log("        Cannot resolve parameter %s to constant\n", std::string(param_ref->VpiName()).c_str());
+                                    log_uhdm_trace("        Cannot resolve parameter %s to constant\n", std::string(param_ref->VpiName()).c_str());
                                 }
                             } else if (right_op->VpiType() == vpiConstant) {
                                 const constant* const_val = any_cast<const constant*>(right_op);
                                 RTLIL::SigSpec const_spec = import_constant(const_val);
                                 if (const_spec.is_fully_const()) {
                                     end_value = const_spec.as_const().as_int();
-                                    log("        Loop condition: %s %s %lld\n",
+                                    log_uhdm_trace("        Loop condition: %s %s %lld\n",
                                         loop_var_name.c_str(), is_neq_condition ? "!=" : (inclusive ? "<=" : "<"), (long long)end_value);
                                 } else {
                                     can_unroll = false;
@@ -6062,18 +6056,18 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                                 RTLIL::SigSpec func_result = import_expression(any_cast<const expr*>(right_op));
                                 if (func_result.is_fully_const()) {
                                     end_value = func_result.as_const().as_int();
-                                    log("        Loop condition: %s %s func_call (resolved to %lld)\n",
+                                    log_uhdm_trace("        Loop condition: %s %s func_call (resolved to %lld)\n",
                                         loop_var_name.c_str(), is_neq_condition ? "!=" : (inclusive ? "<=" : "<"), (long long)end_value);
                                 } else {
                                     can_unroll = false;
-                                    log("        Cannot resolve function call to constant for loop bound\n");
+                                    log_uhdm_trace("        Cannot resolve function call to constant for loop bound\n");
                                 }
                             } else if (right_op->VpiType() == vpiOperation) {
                                 // Operation as end value - evaluate it
                                 RTLIL::SigSpec op_result = import_expression(any_cast<const expr*>(right_op));
                                 if (op_result.is_fully_const()) {
                                     end_value = op_result.as_const().as_int();
-                                    log("        Loop condition: %s %s operation (resolved to %lld)\n",
+                                    log_uhdm_trace("        Loop condition: %s %s operation (resolved to %lld)\n",
                                         loop_var_name.c_str(), is_neq_condition ? "!=" : (inclusive ? "<=" : "<"), (long long)end_value);
                                 } else {
                                     can_unroll = false;
@@ -6095,10 +6089,10 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                 const operation* inc_op = any_cast<const operation*>(inc_stmt);
                 if (inc_op->VpiOpType() == vpiPostIncOp) {
                     increment = 1;
-                    log("        Loop increment: %s++\n", loop_var_name.c_str());
+                    log_uhdm_trace("        Loop increment: %s++\n", loop_var_name.c_str());
                 } else {
                     can_unroll = false;
-                    log("        Unsupported loop increment operation: %d\n", inc_op->VpiOpType());
+                    log_uhdm_trace("        Unsupported loop increment operation: %d\n", inc_op->VpiOpType());
                 }
             } else if (can_unroll && inc_stmt->VpiType() == vpiAssignment) {
                 // Handle i = i + N form
@@ -6133,7 +6127,7 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                             RTLIL::SigSpec inc_spec = import_constant(c);
                             if (inc_spec.is_fully_const()) {
                                 increment = inc_spec.as_const().as_int();
-                                log("        Loop increment: %s = %s + %lld\n", loop_var_name.c_str(), loop_var_name.c_str(), (long long)increment);
+                                log_uhdm_trace("        Loop increment: %s = %s + %lld\n", loop_var_name.c_str(), loop_var_name.c_str(), (long long)increment);
                             } else {
                                 can_unroll = false;
                             }
@@ -6149,9 +6143,9 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
             }
             
             // If we can unroll, check if it's a memory initialization pattern or shift register
-            log("        can_unroll=%d, body type=%d (vpiBegin=%d, vpiAssignment=%d)\n", 
+            log_uhdm_trace("        can_unroll=%d, body type=%d (vpiBegin=%d, vpiAssignment=%d)\n", 
                 can_unroll, body ? body->VpiType() : -1, vpiBegin, vpiAssignment);
-            log("        Loop parameters: var=%s, start=%lld, end=%lld, increment=%lld, inclusive=%d\n",
+            log_uhdm_trace("        Loop parameters: var=%s, start=%lld, end=%lld, increment=%lld, inclusive=%d\n",
                 loop_var_name.c_str(), (long long)start_value, (long long)end_value, 
                 (long long)increment, inclusive);
             
@@ -6232,7 +6226,7 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                         }
                         loop_values[loop_var_name] =
                             (int)(inclusive ? end_value + increment : end_value);
-                        log("        always_ff memory-write for loop unrolled\n");
+                        log_uhdm_trace("        always_ff memory-write for loop unrolled\n");
                         break;  // done with the vpiFor case
                     }
                 }
@@ -6253,7 +6247,7 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                         
                         // Check if both are the same memory/array
                         if (lhs_name == rhs_name) {
-                            log("        Detected shift register pattern for array '%s'\n", lhs_name.c_str());
+                            log_uhdm_trace("        Detected shift register pattern for array '%s'\n", lhs_name.c_str());
                             
                             // Unroll the shift register
                             int64_t loop_end = inclusive ? end_value : end_value - 1;
@@ -6266,7 +6260,7 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                             //   M[3] <= M[2]
                             
                             for (int64_t i = start_value; i <= loop_end; i += increment) {
-                                log("        Unrolling iteration %lld: %s[%lld+1] <= %s[%lld]\n", 
+                                log_uhdm_trace("        Unrolling iteration %lld: %s[%lld+1] <= %s[%lld]\n", 
                                     (long long)i, lhs_name.c_str(), (long long)i, lhs_name.c_str(), (long long)i);
                                 
                                 // Create the assignments
@@ -6312,11 +6306,11 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                                 // Add the assignment to the sync rule
                                 sync->actions.push_back(RTLIL::SigSig(lhs_spec, rhs_spec));
                                 
-                                log("        Added shift register assignment: %s <= %s\n", 
+                                log_uhdm_trace("        Added shift register assignment: %s <= %s\n", 
                                     dst_wire_name.c_str(), src_wire_name.c_str());
                             }
                             
-                            log("        Shift register unrolled successfully\n");
+                            log_uhdm_trace("        Shift register unrolled successfully\n");
                         }
                     } else if (in_initial_block &&
                                body->VpiType() == vpiAssignment &&
@@ -6388,10 +6382,10 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                                 cell->setPort(ID::ADDR, RTLIL::Const(i, 32));
                                 cell->setPort(ID::DATA, mem_word);
                                 cell->setPort(ID::EN, RTLIL::Const(RTLIL::State::S1, mem_width));
-                                log("        Added $meminit for %s[%lld] = %s\n",
+                                log_uhdm_trace("        Added $meminit for %s[%lld] = %s\n",
                                     memory_name.c_str(), (long long)i, mem_word.as_string().c_str());
                             }
-                            log("        Memory initialization (single-stmt) unrolled successfully\n");
+                            log_uhdm_trace("        Memory initialization (single-stmt) unrolled successfully\n");
                         } else {
                             // Non-const RHS: fall back to the general sync unroll.
                             for (int64_t i = start_value; i <= loop_end; i += increment) {
@@ -6418,7 +6412,7 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                             pending_sync_assignments[RTLIL::SigSpec(loop_var_wire)] =
                                 RTLIL::Const((int)final_val, loop_var_wire->width);
                         }
-                        log("        General for loop body unrolled successfully\n");
+                        log_uhdm_trace("        General for loop body unrolled successfully\n");
                     }
                 } else if (body->VpiType() == vpiBegin || body->VpiType() == vpiNamedBegin) {
                     // Handle both regular begin and named begin blocks
@@ -6436,7 +6430,7 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                         if (stmt->VpiType() == vpiFor) {
                             // Nested for loop detected - use interpreter
                             use_interpreter = true;
-                            log("        Detected nested for loop - using interpreter\n");
+                            log_uhdm_trace("        Detected nested for loop - using interpreter\n");
                             break;
                         }
                     }
@@ -6453,7 +6447,7 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                                     op->VpiOpType() == vpiGeOp || op->VpiOpType() == vpiLeOp ||
                                     op->VpiOpType() == vpiEqOp || op->VpiOpType() == vpiNeqOp) {
                                     use_interpreter = true;
-                                    log("        Detected complex initialization pattern - using interpreter\n");
+                                    log_uhdm_trace("        Detected complex initialization pattern - using interpreter\n");
                                 }
                             }
                         }
@@ -6511,17 +6505,17 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                             size_t array_size = wire ? wire->width : max_index;
                             if (array_size == 0) array_size = 32; // Default size if we can't determine
                             arrays[name].resize(array_size, 0);
-                            log("        Initializing array '%s' with size %zu\n", name.c_str(), array_size);
+                            log_uhdm_trace("        Initializing array '%s' with size %zu\n", name.c_str(), array_size);
                         }
                         
-                        log("        Starting interpreter for complex initialization\n");
+                        log_uhdm_trace("        Starting interpreter for complex initialization\n");
                         
                         // Execute the entire for loop using the interpreter
                         bool break_flag = false;
                         bool continue_flag = false;
                         interpret_statement(uhdm_stmt, variables, arrays, break_flag, continue_flag);
                         
-                        log("        Interpreter finished, generating RTLIL assignments\n");
+                        log_uhdm_trace("        Interpreter finished, generating RTLIL assignments\n");
                         
                         // Now generate RTLIL assignments for the computed values
                         for (const auto& [array_name, array_values] : arrays) {
@@ -6535,12 +6529,12 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                                     RTLIL::SigSpec rhs_val = RTLIL::Const(value ? 1 : 0, 1);
                                     sync->actions.push_back(RTLIL::SigSig(lhs_bit, rhs_val));
                                     
-                                    log("          %s[%zu] = %lld\n", array_name.c_str(), i, (long long)value);
+                                    log_uhdm_trace("          %s[%zu] = %lld\n", array_name.c_str(), i, (long long)value);
                                 }
                             }
                         }
                         
-                        log("        For loop interpreted successfully\n");
+                        log_uhdm_trace("        For loop interpreted successfully\n");
                         return; // Don't do any other processing
                     }
                     
@@ -6557,7 +6551,7 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                             // general `for(i) mem[i]=<const>` case (svtypes/logic_rom).
                             std::string memory_name = std::string(bit_sel->VpiName());
                             if (!memory_name.empty() && memory_name == "memory") {
-                                log("        Detected memory initialization pattern for 'memory'\n");
+                                log_uhdm_trace("        Detected memory initialization pattern for 'memory'\n");
                                 
                                 // Get all statements in the loop body
                                 auto loop_stmts = stmts;
@@ -6593,7 +6587,7 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                                                                 // j is declared as integer (32-bit), so truncate to 32 bits
                                                                 uint64_t full_val = val_spec.as_const().as_int();
                                                                 loop_vars[var_name] = full_val & 0xFFFFFFFF;
-                                                                log("        Found initial value for %s: 0x%llx (truncated to 0x%llx)\n", 
+                                                                log_uhdm_trace("        Found initial value for %s: 0x%llx (truncated to 0x%llx)\n", 
                                                                     var_name.c_str(), (unsigned long long)full_val, 
                                                                     (unsigned long long)loop_vars[var_name]);
                                                             }
@@ -6607,13 +6601,13 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                                 
                                 // If we couldn't find initial values, the loop might not be unrollable
                                 if (loop_vars.empty()) {
-                                    log("        Warning: No initial values found for variables used in loop\n");
+                                    log_uhdm_trace("        Warning: No initial values found for variables used in loop\n");
                                 }
                                 
                                 // Unroll the loop
                                 int64_t loop_end = inclusive ? end_value : end_value - 1;
                                 for (int64_t i = start_value; i <= loop_end; i += increment) {
-                                    log("        Unrolling iteration %lld\n", (long long)i);
+                                    log_uhdm_trace("        Unrolling iteration %lld\n", (long long)i);
                                     
                                     // Process each statement in the loop body
                                     uint64_t mem_word = 0;
@@ -6635,7 +6629,7 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                                                         RTLIL::SigSpec rhs_value = evaluate_expression_with_vars(any_cast<const expr*>(assign->Rhs()), loop_vars, loop_var_name, i);
                                                         if (rhs_value.is_fully_const()) {
                                                             mem_word = (uint64_t)rhs_value.as_const().as_int();
-                                                            log("          %s[%lld] = 0x%llx\n", memory_name.c_str(), (long long)i, (unsigned long long)mem_word);
+                                                            log_uhdm_trace("          %s[%lld] = 0x%llx\n", memory_name.c_str(), (long long)i, (unsigned long long)mem_word);
                                                         } else {
                                                             log_warning("Could not evaluate memory assignment to constant\n");
                                                         }
@@ -6659,7 +6653,7 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                                                     RTLIL::SigSpec rhs_value = evaluate_expression_with_vars(any_cast<const expr*>(assign->Rhs()), loop_vars, loop_var_name, i);
                                                     if (rhs_value.is_fully_const()) {
                                                         loop_vars[var_name] = rhs_value.as_const().as_int() & 0xFFFFFFFF; // Keep as 32-bit
-                                                        log("          %s = 0x%llx\n", var_name.c_str(), 
+                                                        log_uhdm_trace("          %s = 0x%llx\n", var_name.c_str(), 
                                                             (unsigned long long)loop_vars[var_name]);
                                                     }
                                                 }
@@ -6692,11 +6686,11 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                                     cell->setPort(ID::DATA, RTLIL::Const(mem_word, mem_width));
                                     cell->setPort(ID::EN, RTLIL::Const(RTLIL::State::S1, mem_width));
 
-                                    log("        Added $meminit for %s[%lld] = 0x%llx\n",
+                                    log_uhdm_trace("        Added $meminit for %s[%lld] = 0x%llx\n",
                                         memory_name.c_str(), (long long)i, (unsigned long long)mem_word);
                                 }
                                 
-                                log("        Memory initialization loop unrolled successfully\n");
+                                log_uhdm_trace("        Memory initialization loop unrolled successfully\n");
                                 
                                 // Store final values of loop variables after the loop
                                 // Override any previous assignments to these variables
@@ -6716,7 +6710,7 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                                         // (not in sync->actions because they haven't been flushed yet)
                                         RTLIL::SigSpec var_spec(var_wire);
                                         pending_sync_assignments[var_spec] = RTLIL::Const(final_value, var_wire->width);
-                                        log("        Storing final value of %s = 0x%llx (overriding any previous assignment)\n", 
+                                        log_uhdm_trace("        Storing final value of %s = 0x%llx (overriding any previous assignment)\n", 
                                             var_name.c_str(), (unsigned long long)final_value);
                                     }
                                 }
@@ -6800,7 +6794,7 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                         }
 
                         if (all_mem_func_assigns && !mem_func_assigns.empty()) {
-                            log("        Detected memory initialization with function calls pattern\n");
+                            log_uhdm_trace("        Detected memory initialization with function calls pattern\n");
 
                             // Get source file info for cell naming
                             std::string meminit_file;
@@ -6866,18 +6860,18 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                                     cell->setPort(ID::DATA, RTLIL::Const(result_int, mem_width));
                                     cell->setPort(ID::EN, RTLIL::SigSpec(RTLIL::State::S1, mem_width));
 
-                                    log("        Added $meminit for %s[%lld] = 0x%x\n",
+                                    log_uhdm_trace("        Added $meminit for %s[%lld] = 0x%x\n",
                                         mfa.mem_name.c_str(), (long long)i, result_int);
                                 }
                             }
 
-                            log("        Memory initialization with function calls unrolled successfully\n");
+                            log_uhdm_trace("        Memory initialization with function calls unrolled successfully\n");
                             return;  // Done with this pattern
                         }
                     }
 
                     // Fall through to generic unrolling for all other begin block patterns
-                    log("        Attempting to interpret for loop with %zu statements\n",
+                    log_uhdm_trace("        Attempting to interpret for loop with %zu statements\n",
                         stmts ? stmts->size() : 0);
                     
                     if (can_unroll && stmts) {
@@ -6897,7 +6891,7 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                                 std::string array_name = std::string(bit_sel->VpiName());
                                 if (array_name == "lut") {
                                     use_interpreter = true;
-                                    log("        Detected lut initialization pattern - using interpreter\n");
+                                    log_uhdm_trace("        Detected lut initialization pattern - using interpreter\n");
                                 }
                             }
                         }
@@ -6923,17 +6917,17 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                                     RTLIL::SigSpec rhs_val = RTLIL::Const(value ? 1 : 0, 1);
                                     sync->actions.push_back(RTLIL::SigSig(lhs_bit, rhs_val));
                                     
-                                    log("          lut[%zu] = %lld\n", i, (long long)value);
+                                    log_uhdm_trace("          lut[%zu] = %lld\n", i, (long long)value);
                                 }
                             }
                             
-                            log("        For loop interpreted successfully\n");
+                            log_uhdm_trace("        For loop interpreted successfully\n");
                         } else {
                             // Fall back to simple unrolling for other patterns
                             int64_t loop_end = inclusive ? end_value : end_value - 1;
                             
                             for (int64_t iter = start_value; iter <= loop_end; iter += increment) {
-                                log("        Unrolling iteration %lld\n", (long long)iter);
+                                log_uhdm_trace("        Unrolling iteration %lld\n", (long long)iter);
                                 
                                 // Track variables that should be substituted with values
                                 std::map<std::string, int64_t> var_substitutions;
@@ -6945,12 +6939,12 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                                 }
                             }
                             
-                            log("        Generic for loop unrolled successfully\n");
+                            log_uhdm_trace("        Generic for loop unrolled successfully\n");
                         }
                         
                         // Process pending memory writes to generate proper structure
                         if (!pending_memory_writes.empty()) {
-                            log("        Processing %zu pending memory writes\n", pending_memory_writes.size());
+                            log_uhdm_trace("        Processing %zu pending memory writes\n", pending_memory_writes.size());
                             
                             // Create temporary wires for each memory write (like Verilog frontend)
                             // We need $0$memwr$ and $1$memwr$ wires for ADDR, DATA, EN
@@ -6999,7 +6993,7 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                                         }
                                         sync->actions.push_back(RTLIL::SigSig(memwr_en_wires[i], enable));
                                         
-                                        log("        Generated memory write %zu: addr=%s, data=%s, en=%s\n",
+                                        log_uhdm_trace("        Generated memory write %zu: addr=%s, data=%s, en=%s\n",
                                             i, log_signal(mem_write.address), log_signal(mem_write.data),
                                             mem_write.condition.empty() ? "1111" : log_signal(mem_write.condition));
                                     }
@@ -7034,13 +7028,13 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                                     RTLIL::Wire* slice_wire = module->wire(RTLIL::escape_id(slice_name));
                                     if (slice_wire) {
                                         readB_slices.push_back(slice_wire);
-                                        log("        Found slice wire: %s\n", slice_name.c_str());
+                                        log_uhdm_trace("        Found slice wire: %s\n", slice_name.c_str());
                                     }
                                 }
                                 
                                 // If we have all slices, combine them into readB
                                 if (readB_slices.size() == 4) {
-                                    log("        Combining %zu slices into readB\n", readB_slices.size());
+                                    log_uhdm_trace("        Combining %zu slices into readB\n", readB_slices.size());
                                     
                                     // Build the concatenation from low to high
                                     // readB[3:0] is at base_idx 3, readB[7:4] at 7, etc.
@@ -7052,14 +7046,14 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                                     // Find the existing readB wire
                                     RTLIL::Wire* readB_wire = module->wire(RTLIL::escape_id("readB"));
                                     if (!readB_wire) {
-                                        log("        WARNING: Could not find readB wire, creating new one\n");
+                                        log_uhdm_trace("        WARNING: Could not find readB wire, creating new one\n");
                                         readB_wire = module->addWire(RTLIL::escape_id("readB"), 16);
                                         readB_wire->attributes[ID::reg] = RTLIL::Const(1);
                                     }
                                     
                                     // Add the combined assignment
                                     pending_sync_assignments[readB_wire] = readB_value;
-                                    log("        Added combined assignment: readB <= concatenation of slices\n");
+                                    log_uhdm_trace("        Added combined assignment: readB <= concatenation of slices\n");
                                 }
                             } else {
                                 log_warning("For loop unrolling not implemented for this pattern\n");
@@ -7067,7 +7061,7 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                         }
                     } else if (can_unroll && (body->VpiType() == vpiIf || body->VpiType() == vpiIfElse)) {
                         // For loop body is an if/if-else statement - use interpreter
-                        log("        For loop body is if/if-else - using interpreter\n");
+                        log_uhdm_trace("        For loop body is if/if-else - using interpreter\n");
                         std::map<std::string, int64_t> variables;
                         std::map<std::string, std::vector<int64_t>> arrays;
 
@@ -7116,10 +7110,10 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                             RTLIL::Wire* var_wire = module->wire(RTLIL::escape_id(var_name));
                             if (var_wire) {
                                 pending_sync_assignments[RTLIL::SigSpec(var_wire)] = RTLIL::Const(final_value, var_wire->width);
-                                log("        Interpreter result: %s = %lld\n", var_name.c_str(), (long long)final_value);
+                                log_uhdm_trace("        Interpreter result: %s = %lld\n", var_name.c_str(), (long long)final_value);
                             }
                         }
-                        log("        For loop with if body interpreted successfully\n");
+                        log_uhdm_trace("        For loop with if body interpreted successfully\n");
                     } else {
                         log_warning("For loop unrolling not implemented for this statement type %d\n", body ? body->VpiType() : -1);
                     }
@@ -7131,7 +7125,7 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
                 }
             }
             
-            log("        For loop processed\n");
+            log_uhdm_trace("        For loop processed\n");
             log_flush();
             break;
         }
@@ -7140,7 +7134,7 @@ void UhdmImporter::import_statement_sync(const any* uhdm_stmt, RTLIL::SyncRule*
             break;
     }
     
-    log("        import_statement_sync returning\n");
+    log_uhdm_trace("        import_statement_sync returning\n");
     log_flush();
 }
 
@@ -7388,17 +7382,166 @@ void UhdmImporter::import_display_stmt(const UHDM::sys_func_call* call,
     fmt.emit_rtlil(cell);
 
     if (mode_debug)
-        log("    Created $print cell '%s' for '%s' (EN=%s)\n",
+        log_uhdm_trace("    Created $print cell '%s' for '%s' (EN=%s)\n",
             cell_id.c_str(), task_name.c_str(), en_wire->name.c_str());
 }
 
 // Import statement for combinational context
+UhdmImporter::LoopVectorizer::LoopVectorizer(UhdmImporter* importer) : imp(importer) {
+    active = imp->loop_vectorizer_depth++ == 0 && imp->module;
+}
+
+UhdmImporter::LoopVectorizer::~LoopVectorizer() {
+    imp->loop_vectorizer_depth--;
+}
+
+void UhdmImporter::LoopVectorizer::begin_iteration() {
+    if (active)
+        cells0 = GetSize(imp->module->cells_);
+}
+
+void UhdmImporter::LoopVectorizer::end_iteration() {
+    if (!active)
+        return;
+    int n = GetSize(imp->module->cells_) - cells0;
+    if (n < 0) {
+        active = false;
+        return;
+    }
+    // hashlib dicts iterate newest-first
+    std::vector<RTLIL::Cell*> cells;
+    for (auto& it : imp->module->cells_) {
+        if (n-- <= 0) break;
+        cells.push_back(it.second);
+    }
+    std::reverse(cells.begin(), cells.end());
+    iterations.push_back(std::move(cells));
+}
+
+static bool is_vectorizable_cell(const RTLIL::Cell* cell) {
+    if (cell->type == ID($mux))
+        return true;
+    if (cell->type == ID($not))
+        return cell->getParam(ID::A_WIDTH) == cell->getParam(ID::Y_WIDTH);
+    if (cell->type.in(ID($and), ID($or), ID($xor), ID($xnor)))
+        return cell->getParam(ID::A_WIDTH) == cell->getParam(ID::Y_WIDTH) &&
+               cell->getParam(ID::B_WIDTH) == cell->getParam(ID::Y_WIDTH);
+    return false;
+}
+
+void UhdmImporter::LoopVectorizer::merge(const any* loop) {
+    if (!active || GetSize(iterations) < 2)
+        return;
+    int n = GetSize(iterations[0]);
+    for (auto& cells : iterations)
+        if (GetSize(cells) != n)
+            return;
+
+    RTLIL::Module* mod = imp->module;
+
+    // Carried dependence.  A cell is `foreign` when one of its inputs comes,
+    // directly or through cells of its own iteration, from a cell of another
+    // iteration.  Merging a position with a foreign cell would make two wide
+    // cells read each other (a ripple carry `c[i+1] = a[i]&b[i] | c[i]&...`
+    // turns its $and and $or groups into a cell-level loop), so such
+    // positions stay bit-sliced.  Bits are compared through the module's
+    // connections, which carry the generate-lane case.
+    SigMap sigmap(mod);
+    dict<RTLIL::SigBit, std::pair<int, RTLIL::Cell*>> producer;
+    for (int j = 0; j < GetSize(iterations); j++)
+        for (auto cell : iterations[j])
+            for (auto& conn : cell->connections())
+                if (cell->output(conn.first))
+                    for (auto bit : sigmap(conn.second))
+                        producer[bit] = {j, cell};
+    pool<RTLIL::Cell*> foreign;
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (int j = 0; j < GetSize(iterations); j++)
+            for (auto cell : iterations[j]) {
+                if (foreign.count(cell))
+                    continue;
+                bool dep = false;
+                for (auto& conn : cell->connections()) {
+                    if (dep || cell->output(conn.first))
+                        continue;
+                    for (auto bit : sigmap(conn.second)) {
+                        auto p = producer.find(bit);
+                        if (p != producer.end() &&
+                            (p->second.first != j || foreign.count(p->second.second))) {
+                            dep = true;
+                            break;
+                        }
+                    }
+                }
+                if (dep) {
+                    foreign.insert(cell);
+                    changed = true;
+                }
+            }
+    }
+
+    int groups = 0;
+    for (int k = 0; k < n; k++) {
+        RTLIL::Cell* first = iterations[0][k];
+        if (!is_vectorizable_cell(first))
+            continue;
+        bool ok = true;
+        for (auto& cells : iterations) {
+            RTLIL::Cell* cell = cells[k];
+            if (cell->type != first->type || cell->parameters != first->parameters ||
+                (cell->type == ID($mux) && cell->getPort(ID::S) != first->getPort(ID::S)) ||
+                foreign.count(cell)) {
+                ok = false;
+                break;
+            }
+        }
+        if (!ok)
+            continue;
+
+        bool has_b = first->hasPort(ID::B);
+        RTLIL::SigSpec a, b, y;
+        for (auto& cells : iterations) {
+            a.append(cells[k]->getPort(ID::A));
+            if (has_b)
+                b.append(cells[k]->getPort(ID::B));
+            y.append(cells[k]->getPort(ID::Y));
+        }
+        RTLIL::Cell* wide = mod->addCell(NEW_ID, first->type);
+        wide->attributes = first->attributes;
+        if (first->type == ID($mux)) {
+            wide->setParam(ID::WIDTH, GetSize(y));
+            wide->setPort(ID::S, first->getPort(ID::S));
+        } else {
+            wide->setParam(ID::A_SIGNED, first->getParam(ID::A_SIGNED));
+            wide->setParam(ID::A_WIDTH, GetSize(a));
+            if (has_b) {
+                wide->setParam(ID::B_SIGNED, first->getParam(ID::B_SIGNED));
+                wide->setParam(ID::B_WIDTH, GetSize(b));
+            }
+            wide->setParam(ID::Y_WIDTH, GetSize(y));
+        }
+        wide->setPort(ID::A, a);
+        if (has_b)
+            wide->setPort(ID::B, b);
+        wide->setPort(ID::Y, y);
+        for (auto& cells : iterations)
+            mod->remove(cells[k]);
+        groups++;
+    }
+    if (groups)
+        log_uhdm_debug("UHDM: Vectorized %d-iteration loop at %s: %d wide cells replace %d\n",
+                       GetSize(iterations), imp->get_src_attribute(loop).c_str(),
+                       groups, groups * GetSize(iterations));
+}
+
 void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::Process* proc) {
     if (!uhdm_stmt)
         return;
+    HeatmapScope heat(this, uhdm_stmt);
     
     int stmt_type = uhdm_stmt->VpiType();
-    log("    import_statement_comb(Process*): type=%d\n", stmt_type);
+    log_uhdm_trace("    import_statement_comb(Process*): type=%d\n", stmt_type);
     
     switch (stmt_type) {
         case vpiBegin:
@@ -7421,7 +7564,7 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::Process* p
             import_case_stmt_comb(any_cast<const case_stmt*>(uhdm_stmt), proc);
             break;
         case vpiImmediateAssert: {
-            log("        Processing immediate assert in comb context - converting to $check cell\n");
+            log_uhdm_trace("        Processing immediate assert in comb context - converting to $check cell\n");
             log_flush();
 
             const UHDM::immediate_assert* assert_stmt = any_cast<const UHDM::immediate_assert*>(uhdm_stmt);
@@ -7433,12 +7576,12 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::Process* p
                 proc->root_case.actions.push_back(RTLIL::SigSig(enable_wire, RTLIL::State::S1));
             }
 
-            log("        Immediate assert processed\n");
+            log_uhdm_trace("        Immediate assert processed\n");
             log_flush();
             break;
         }
         case vpiImmediateCover: {
-            log("        Processing immediate cover in comb context - converting to $check cell\n");
+            log_uhdm_trace("        Processing immediate cover in comb context - converting to $check cell\n");
             log_flush();
 
             const UHDM::immediate_cover* cover_stmt = any_cast<const UHDM::immediate_cover*>(uhdm_stmt);
@@ -7449,7 +7592,7 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::Process* p
                 proc->root_case.actions.push_back(RTLIL::SigSig(enable_wire, RTLIL::State::S1));
             }
 
-            log("        Immediate cover processed\n");
+            log_uhdm_trace("        Immediate cover processed\n");
             log_flush();
             break;
         }
@@ -7747,7 +7890,7 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::Process* p
                 // statements rarely reference it after a dynamic-bound
                 // loop, so leaving it at the last iterated value is fine.
                 loop_values[fl_var] = (int)loop_end;
-                log("    Comb for loop unrolled with dynamic bound: %s "
+                log_uhdm_trace("    Comb for loop unrolled with dynamic bound: %s "
                     "max_iters=%lld guard=(i %s bound[%d])\n",
                     fl_var.c_str(), (long long)max_iters,
                     fl_inclusive ? "<=" : "<", fl_bound_width);
@@ -7755,13 +7898,17 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::Process* p
                 // Descending: `for (i = HI; i >= LO (or > LO); i -= inc)`.
                 int64_t inc = fl_inc_val == 0 ? 1 : std::llabs(fl_inc_val);
                 int64_t loop_end = fl_inclusive ? fl_end : fl_end + 1;
+                LoopVectorizer vec(this);
                 for (int64_t i = fl_start; i >= loop_end; i -= inc) {
                     loop_values[fl_var] = (int)i;
+                    vec.begin_iteration();
                     import_statement_comb(fl_body, proc);
+                    vec.end_iteration();
                 }
+                vec.merge(for_loop);
                 int64_t final_val = loop_end - inc;
                 loop_values[fl_var] = (int)final_val;
-                log("    Comb for loop unrolled (descending): %s final=%lld\n",
+                log_uhdm_trace("    Comb for loop unrolled (descending): %s final=%lld\n",
                     fl_var.c_str(), (long long)final_val);
             } else if (fl_can_unroll) {
                 int64_t loop_end = fl_inclusive ? fl_end : fl_end - 1;
@@ -7777,7 +7924,7 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::Process* p
                 std::vector<std::pair<int, RTLIL::SigSpec>> brk_flags;
                 bool brk_idx_emitted = false;
                 if (has_break) {
-                    log("    Comb for loop body has `break` — iterating in "
+                    log_uhdm_trace("    Comb for loop body has `break` — iterating in "
                         "reverse so first-match-wins semantics hold\n");
                     for (int64_t i = loop_end; i >= fl_start; i -= fl_inc_val) {
                         loop_values[fl_var] = (int)i;
@@ -7795,10 +7942,14 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::Process* p
                         brk_flags.push_back({(int)i, RTLIL::SigSpec(bw)});
                     }
                 } else {
+                    LoopVectorizer vec(this);
                     for (int64_t i = fl_start; i <= loop_end; i += fl_inc_val) {
                         loop_values[fl_var] = (int)i;
+                        vec.begin_iteration();
                         import_statement_comb(fl_body, proc);
+                        vec.end_iteration();
                     }
+                    vec.merge(for_loop);
                 }
                 // Keep post-loop variable value for subsequent statements in the same block
                 // (e.g. y = k - {a,b} should see k = final value after loop exits)
@@ -7830,7 +7981,7 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::Process* p
                         loop_values.erase(fl_var);
                         emit_comb_assign(RTLIL::SigSpec(var_wire), sel, proc);
                         brk_idx_emitted = true;
-                        log("    Comb for loop `break`: %s = first-break index "
+                        log_uhdm_trace("    Comb for loop `break`: %s = first-break index "
                             "priority mux (%zu iterations)\n",
                             fl_var.c_str(), brk_flags.size());
                     }
@@ -7853,7 +8004,7 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::Process* p
                                      RTLIL::Const((int)final_val, w),
                                      proc);
                 }
-                log("    Comb for loop unrolled: %s final=%lld\n", fl_var.c_str(), (long long)final_val);
+                log_uhdm_trace("    Comb for loop unrolled: %s final=%lld\n", fl_var.c_str(), (long long)final_val);
             } else {
                 log_warning("Cannot unroll for loop in comb context (complex bounds)\n");
             }
@@ -7878,35 +8029,35 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::Process* p
 
 // Import begin block for sync context
 void UhdmImporter::import_begin_block_sync(const UHDM::scope* uhdm_begin, RTLIL::SyncRule* sync, bool is_reset) {
-    log("          import_begin_block_sync called\n");
+    log_uhdm_trace("          import_begin_block_sync called\n");
     log_flush();
     VectorOfany* stmts = begin_block_stmts(uhdm_begin);
     if (stmts) {
-        log("          Begin block has %zu statements\n", stmts->size());
+        log_uhdm_trace("          Begin block has %zu statements\n", stmts->size());
         log_flush();
         
         int stmt_idx = 0;
         for (auto stmt : *stmts) {
-            log("          Processing statement %d/%zu in begin block\n", stmt_idx + 1, stmts->size());
+            log_uhdm_trace("          Processing statement %d/%zu in begin block\n", stmt_idx + 1, stmts->size());
             log_flush();
             
             import_statement_sync(stmt, sync, is_reset);
-            log("          Statement %d/%zu processed\n", stmt_idx + 1, stmts->size());
+            log_uhdm_trace("          Statement %d/%zu processed\n", stmt_idx + 1, stmts->size());
             log_flush();
             stmt_idx++;
         }
     } else {
-        log("          Begin block has no statements\n");
+        log_uhdm_trace("          Begin block has no statements\n");
         log_flush();
     }
     
-    log("          import_begin_block_sync returning\n");
+    log_uhdm_trace("          import_begin_block_sync returning\n");
     log_flush();
 }
 
 // Import begin block for comb context
 void UhdmImporter::import_begin_block_comb(const UHDM::scope* uhdm_begin, RTLIL::Process* proc) {
-    log("    import_begin_block_comb (Process*): Begin block\n");
+    log_uhdm_trace("    import_begin_block_comb (Process*): Begin block\n");
 
     // Handle Variables() in begin blocks (both named and unnamed)
     std::map<std::string, RTLIL::Wire*> saved_name_map;
@@ -7920,7 +8071,7 @@ void UhdmImporter::import_begin_block_comb(const UHDM::scope* uhdm_begin, RTLIL:
         } else {
             block_name = "$unnamed_block$" + std::to_string(++unnamed_block_counter);
         }
-        log("    Begin block '%s' has variables\n", block_name.c_str());
+        log_uhdm_trace("    Begin block '%s' has variables\n", block_name.c_str());
 
         RTLIL::SyncRule* sync_always = nullptr;
         if (!proc->syncs.empty()) sync_always = proc->syncs.back();
@@ -7971,7 +8122,7 @@ void UhdmImporter::import_begin_block_comb(const UHDM::scope* uhdm_begin, RTLIL:
                            hier_name + "$" + std::to_string(n))))
                     n++;
                 hier_name += "$" + std::to_string(n);
-                log("    Begin block local '%s' collides with an earlier block "
+                log_uhdm_trace("    Begin block local '%s' collides with an earlier block "
                     "of the same name; using '%s'\n",
                     (block_name + "." + var_name).c_str(), hier_name.c_str());
             }
@@ -8022,20 +8173,20 @@ void UhdmImporter::import_begin_block_comb(const UHDM::scope* uhdm_begin, RTLIL:
                 );
             }
 
-            log("    Created block-local wire %s (temp: %s, width: %d)\n",
+            log_uhdm_trace("    Created block-local wire %s (temp: %s, width: %d)\n",
                 block_wire->name.c_str(), temp_wire->name.c_str(), width);
         }
     }
 
     VectorOfany* stmts = begin_block_stmts(uhdm_begin);
     if (stmts) {
-        log("    Begin block has %d statements\n", (int)stmts->size());
+        log_uhdm_trace("    Begin block has %d statements\n", (int)stmts->size());
         for (auto stmt : *stmts) {
-            log("    Processing statement type %d in begin block\n", stmt->VpiType());
+            log_uhdm_trace("    Processing statement type %d in begin block\n", stmt->VpiType());
             import_statement_comb(stmt, proc);
         }
     } else {
-        log("    Begin block has no statements\n");
+        log_uhdm_trace("    Begin block has no statements\n");
     }
 
     // Restore name_map
@@ -8121,7 +8272,7 @@ void UhdmImporter::import_tf_call_comb(const UHDM::tf_call* tc,
     int ctx_idx = incr_autoidx();
     std::string context = stringf("%s$func$%s:%d$%d", task_name.c_str(), call_file.c_str(), call_line, ctx_idx);
 
-    log("    import_tf_call_comb: %s (context: %s)\n", task_name.c_str(), context.c_str());
+    log_uhdm_trace("    import_tf_call_comb: %s (context: %s)\n", task_name.c_str(), context.c_str());
 
     // Build task_mapping: maps task variable names to SigSpecs
     std::map<std::string, RTLIL::SigSpec> task_mapping;
@@ -8260,7 +8411,7 @@ void UhdmImporter::import_tf_call_comb(const UHDM::tf_call* tc,
         }
     }
 
-    log("    import_task_call_comb: done\n");
+    log_uhdm_trace("    import_task_call_comb: done\n");
 }
 
 // Method-function call on an interface object inlined into a
@@ -8317,9 +8468,9 @@ void UhdmImporter::import_method_func_call_comb(const UHDM::method_func_call* mf
     // module DEFINITION (AllModules pass), the prefix port's
     // Actual_group is not yet bound to a real `interface_inst`.  Walk
     // up via the prefix wire → its module port → its `interface_typespec`
-    // to recover the interface name, then look it up in
-    // `Design->AllInterfaces()`.
-    if (!iface_inst && uhdm_design && uhdm_design->AllInterfaces()) {
+    // to recover the interface name, then look its definition up in
+    // interface_definitions (the AllInterfaces entries by name).
+    if (!iface_inst) {
         std::string iface_name;
         if (auto port_wire = module->wire(RTLIL::escape_id(prefix_name))) {
             if (port_wire->attributes.count(RTLIL::escape_id("interface_type"))) {
@@ -8329,17 +8480,9 @@ void UhdmImporter::import_method_func_call_comb(const UHDM::method_func_call* mf
                     iface_name = iface_name.substr(1);
             }
         }
-        if (!iface_name.empty()) {
-            for (auto ii : *uhdm_design->AllInterfaces()) {
-                std::string n = std::string(ii->VpiDefName());
-                if (n.substr(0, 5) == "work@") n = n.substr(5);
-                if (n == iface_name ||
-                    std::string(ii->VpiName()).find(iface_name) != std::string::npos) {
-                    iface_inst = ii;
-                    break;
-                }
-            }
-        }
+        auto def = interface_definitions.find(iface_name);
+        if (def != interface_definitions.end())
+            iface_inst = def->second;
     }
 
     if (!func_def && iface_inst && iface_inst->Task_funcs()) {
@@ -8842,7 +8985,7 @@ RTLIL::SigSpec UhdmImporter::import_func_call_comb(const func_call* fc, RTLIL::P
     int ctx_idx = incr_autoidx();
     std::string context = stringf("%s$func$%s:%d$%d", func_name.c_str(), call_file.c_str(), call_line, ctx_idx);
 
-    log("    import_func_call_comb: %s (context: %s, ret_width=%d)\n", func_name.c_str(), context.c_str(), ret_width);
+    log_uhdm_trace("    import_func_call_comb: %s (context: %s, ret_width=%d)\n", func_name.c_str(), context.c_str(), ret_width);
 
     // Import arguments using current_comb_values for correct intermediate value resolution
     std::vector<RTLIL::SigSpec> arg_values;
@@ -8994,7 +9137,7 @@ RTLIL::SigSpec UhdmImporter::import_func_call_comb(const func_call* fc, RTLIL::P
     RTLIL::SigSpec final_result = func_mapping[func_name];
     proc->root_case.actions.push_back(RTLIL::SigSig(RTLIL::SigSpec(result_temp), final_result));
 
-    log("    import_func_call_comb: done, result = %s\n", log_signal(final_result));
+    log_uhdm_trace("    import_func_call_comb: done, result = %s\n", log_signal(final_result));
     return final_result;
 }
 
@@ -9250,7 +9393,7 @@ void UhdmImporter::inline_func_body_comb(const any* stmt, RTLIL::Process* proc,
                         else if (r2.size() > sel_w) r2 = r2.extract(0, sel_w);
                         cur.replace(sel_off, r2);
                         func_mapping[base] = cur;
-                        log("      inline_func_body_comb: %s[%d+:%d] = %s\n",
+                        log_uhdm_trace("      inline_func_body_comb: %s[%d+:%d] = %s\n",
                             base.c_str(), sel_off, sel_w, log_signal(r2).c_str());
                     } else if (!base.empty()) {
                         log_warning(
@@ -9276,7 +9419,7 @@ void UhdmImporter::inline_func_body_comb(const any* stmt, RTLIL::Process* proc,
             // Update func_mapping with the new value (key for cell chaining)
             if (!lhs_name.empty() && func_mapping.count(lhs_name)) {
                 func_mapping[lhs_name] = rhs;
-                log("      inline_func_body_comb: %s = %s (tracked in func_mapping)\n", lhs_name.c_str(), log_signal(rhs).c_str());
+                log_uhdm_trace("      inline_func_body_comb: %s = %s (tracked in func_mapping)\n", lhs_name.c_str(), log_signal(rhs).c_str());
             } else if (!lhs_name.empty()) {
                 // Module signal - assign to $0\ temp wire and update tracking
                 RTLIL::Wire* target = module->wire(RTLIL::escape_id(lhs_name));
@@ -9293,7 +9436,7 @@ void UhdmImporter::inline_func_body_comb(const any* stmt, RTLIL::Process* proc,
                         proc->root_case.actions.push_back(RTLIL::SigSig(RTLIL::SigSpec(temp_wire), rhs));
                         current_comb_values[lhs_name] = rhs;
                         func_mapping[lhs_name] = rhs;
-                        log("      inline_func_body_comb: module signal %s = %s\n", lhs_name.c_str(), log_signal(rhs).c_str());
+                        log_uhdm_trace("      inline_func_body_comb: module signal %s = %s\n", lhs_name.c_str(), log_signal(rhs).c_str());
                     }
                 }
             }
@@ -9318,7 +9461,7 @@ void UhdmImporter::inline_func_body_comb(const any* stmt, RTLIL::Process* proc,
                             rhs = rhs.extract(0, it->second.size());
                     }
                     func_mapping[func_name] = rhs;
-                    log("      inline_func_body_comb: return %s = %s\n",
+                    log_uhdm_trace("      inline_func_body_comb: return %s = %s\n",
                         func_name.c_str(), log_signal(rhs).c_str());
                 }
             }
@@ -9477,7 +9620,7 @@ void UhdmImporter::inline_func_body_comb(const any* stmt, RTLIL::Process* proc,
 
 // Import assignment for sync context
 void UhdmImporter::import_assignment_sync(const assignment* uhdm_assign, RTLIL::SyncRule* sync) {
-    log("            import_assignment_sync called\n");
+    log_uhdm_trace("            import_assignment_sync called\n");
     log_flush();
 
     // Detect a dynamic indexed-part-select LHS (e.g. `dout[ctrl*sel +: 16] <= din`).
@@ -9592,7 +9735,7 @@ void UhdmImporter::import_assignment_sync(const assignment* uhdm_assign, RTLIL::
                 }
                 pending_sync_assignments[full_lhs] = final_rhs;
                 if (mode_debug)
-                    log("    Dynamic indexed-part-select LHS: emitted read-modify-write on '%s'\n",
+                    log_uhdm_trace("    Dynamic indexed-part-select LHS: emitted read-modify-write on '%s'\n",
                         base_wire->name.c_str());
                 return;
             }
@@ -9601,21 +9744,21 @@ void UhdmImporter::import_assignment_sync(const assignment* uhdm_assign, RTLIL::
 
     // Check if this is a memory write (LHS is bit_select on a memory)
     if (auto lhs_expr = uhdm_assign->Lhs()) {
-        log("            LHS expr type: %d\n", lhs_expr->VpiType());
+        log_uhdm_trace("            LHS expr type: %d\n", lhs_expr->VpiType());
         log_flush();
 
         if (lhs_expr->VpiType() == vpiBitSelect) {
-            log("            LHS is bit_select - checking for memory write\n");
+            log_uhdm_trace("            LHS is bit_select - checking for memory write\n");
             log_flush();
             const bit_select* bit_sel = any_cast<const bit_select*>(lhs_expr);
             std::string signal_name = std::string(bit_sel->VpiName());
             RTLIL::IdString mem_id = RTLIL::escape_id(signal_name);
             
-            log("            Signal name: '%s', mem_id: '%s'\n", signal_name.c_str(), mem_id.c_str());
-            log("            Checking for memory in module...\n");
-            log("            Module has %d memories\n", (int)module->memories.size());
+            log_uhdm_trace("            Signal name: '%s', mem_id: '%s'\n", signal_name.c_str(), mem_id.c_str());
+            log_uhdm_trace("            Checking for memory in module...\n");
+            log_uhdm_trace("            Module has %d memories\n", (int)module->memories.size());
             for (auto& mem_pair : module->memories) {
-                log("              Memory: %s\n", mem_pair.first.c_str());
+                log_uhdm_trace("              Memory: %s\n", mem_pair.first.c_str());
             }
             log_flush();
             
@@ -9623,15 +9766,15 @@ void UhdmImporter::import_assignment_sync(const assignment* uhdm_assign, RTLIL::
                 // Check if we're using temp wires for memory writes (new architecture)
                 if (!current_memory_writes.empty() && current_memory_writes.count(signal_name)) {
                     // Skip - memory writes are handled via temp wires
-                    log("            Memory write to %s handled via temp wires, skipping sync action\n", signal_name.c_str());
+                    log_uhdm_trace("            Memory write to %s handled via temp wires, skipping sync action\n", signal_name.c_str());
                     return;
                 }
                 
-                log("            Found memory '%s' - handling memory write\n", signal_name.c_str());
+                log_uhdm_trace("            Found memory '%s' - handling memory write\n", signal_name.c_str());
                 log_flush();
                 // This is a memory write
                 if (mode_debug)
-                    log("    Detected memory write to %s\n", signal_name.c_str());
+                    log_uhdm_trace("    Detected memory write to %s\n", signal_name.c_str());
                 
                 RTLIL::Memory* memory = module->memories.at(mem_id);
                 
@@ -9724,7 +9867,7 @@ void UhdmImporter::import_assignment_sync(const assignment* uhdm_assign, RTLIL::
     }
     
     // Regular assignment
-    log("            Processing regular assignment (not memory write)\n");
+    log_uhdm_trace("            Processing regular assignment (not memory write)\n");
     log_flush();
 
     // Check for dynamic write to an expanded array (individual element wires, not $memory).
@@ -9829,10 +9972,10 @@ void UhdmImporter::import_assignment_sync(const assignment* uhdm_assign, RTLIL::
 
     // Import LHS (always an expr)
     if (auto lhs_expr = uhdm_assign->Lhs()) {
-        log("            Importing LHS expression\n");
+        log_uhdm_trace("            Importing LHS expression\n");
         log_flush();
         lhs = import_expression(lhs_expr);
-        log("            LHS imported: [signal] (size=%d)\n", lhs.size());
+        log_uhdm_trace("            LHS imported: [signal] (size=%d)\n", lhs.size());
         log_flush();
     }
     
@@ -9845,7 +9988,7 @@ void UhdmImporter::import_assignment_sync(const assignment* uhdm_assign, RTLIL::
     if (auto rhs_any = uhdm_assign->Rhs()) {
         if (auto rhs_expr = dynamic_cast<const expr*>(rhs_any)) {
             rhs_fill_state = detect_fill_const_state(rhs_expr, rhs_is_fill);
-            log("            Importing RHS expression\n");
+            log_uhdm_trace("            Importing RHS expression\n");
             log_flush();
             // Propagate LHS width as context so arithmetic ops widen to it
             // (SV context-determined sizing).
@@ -9853,7 +9996,7 @@ void UhdmImporter::import_assignment_sync(const assignment* uhdm_assign, RTLIL::
             expression_context_width = lhs.size();
             rhs = import_expression(rhs_expr);
             expression_context_width = prev_ctx;
-            log("            RHS imported: [signal] (size=%d)\n", rhs.size());
+            log_uhdm_trace("            RHS imported: [signal] (size=%d)\n", rhs.size());
             log_flush();
         } else {
             log_warning("Assignment RHS is not an expression (type=%d)\n", rhs_any->VpiType());
@@ -9861,7 +10004,7 @@ void UhdmImporter::import_assignment_sync(const assignment* uhdm_assign, RTLIL::
     }
 
     if (lhs.size() != rhs.size()) {
-        log("            Size mismatch: LHS=%d, RHS=%d\n", lhs.size(), rhs.size());
+        log_uhdm_trace("            Size mismatch: LHS=%d, RHS=%d\n", lhs.size(), rhs.size());
         log_flush();
         if (rhs.size() < lhs.size()) {
             if (rhs_is_fill) {
@@ -9878,13 +10021,13 @@ void UhdmImporter::import_assignment_sync(const assignment* uhdm_assign, RTLIL::
         }
     }
 
-    log("            Adding action to sync rule (condition=%s)\n",
+    log_uhdm_trace("            Adding action to sync rule (condition=%s)\n",
         current_condition.empty() ? "none" : log_signal(current_condition));
     log_flush();
     
     // If there's a condition, we need to use a multiplexer
     if (!current_condition.empty()) {
-        log("            Creating conditional assignment with multiplexer\n");
+        log_uhdm_trace("            Creating conditional assignment with multiplexer\n");
         log_flush();
         
         // Check if we already have a pending assignment to this signal
@@ -9892,11 +10035,11 @@ void UhdmImporter::import_assignment_sync(const assignment* uhdm_assign, RTLIL::
         if (pending_sync_assignments.count(lhs)) {
             // Use the previous assignment as the else value
             else_value = pending_sync_assignments[lhs];
-            log("            Using previous assignment as else value\n");
+            log_uhdm_trace("            Using previous assignment as else value\n");
         } else {
             // Use the current value of lhs as the else value
             else_value = lhs;
-            log("            Using current signal value as else value\n");
+            log_uhdm_trace("            Using current signal value as else value\n");
         }
         
         // Create multiplexer: condition ? rhs : else_value
@@ -9909,18 +10052,18 @@ void UhdmImporter::import_assignment_sync(const assignment* uhdm_assign, RTLIL::
         
         // Store in pending assignments (will be added to sync rule later)
         pending_sync_assignments[lhs] = mux_result;
-        log("            Stored conditional assignment: %s <= %s ? %s : %s\n", 
+        log_uhdm_trace("            Stored conditional assignment: %s <= %s ? %s : %s\n", 
             log_signal(lhs), log_signal(current_condition), log_signal(rhs), log_signal(else_value));
         log_flush();
     } else {
         // Store unconditional assignment
         pending_sync_assignments[lhs] = rhs;
-        log("            Stored unconditional assignment: %s <= %s\n", 
+        log_uhdm_trace("            Stored unconditional assignment: %s <= %s\n", 
             log_signal(lhs), log_signal(rhs).c_str());
         log_flush();
     }
     
-    log("            Action added successfully\n");
+    log_uhdm_trace("            Action added successfully\n");
     log_flush();
 }
 
@@ -10188,6 +10331,9 @@ bool UhdmImporter::emit_dynamic_unpacked_array_write(
     RTLIL::Wire* flat_tw = module->wire("$0\\" + base_name);
     bool use_flat = flat_w && flat_w->width == elem_w * num_elems &&
                     (proc != nullptr || flat_tw != nullptr);
+    // One shared decoder for the index instead of an `idx == k` compare per
+    // element (falls back to the compares for an undecodably wide index).
+    RTLIL::SigSpec sel_vec = dynamic_index_decoder(idx, array_low + num_elems);
 
     for (int k = array_low; k < array_low + num_elems; k++) {
         std::string ename = base_name + "[" + std::to_string(k) + "]";
@@ -10208,11 +10354,18 @@ bool UhdmImporter::emit_dynamic_unpacked_array_write(
         else
             cur = RTLIL::SigSpec(ew);
         // sel = (idx == k);  new = sel ? rhs : cur  (Mux: Y = S ? B : A)
-        RTLIL::Wire* sel = module->addWire(NEW_ID, 1);
-        module->addEq(NEW_ID, idx,
-                      RTLIL::SigSpec(RTLIL::Const(k, GetSize(idx))), sel);
+        RTLIL::SigSpec sel;
+        if (!sel_vec.empty()) {
+            sel = k < GetSize(sel_vec) ? RTLIL::SigSpec(sel_vec[k])
+                                       : RTLIL::SigSpec(RTLIL::State::S0);
+        } else {
+            RTLIL::Wire* eq = module->addWire(NEW_ID, 1);
+            module->addEq(NEW_ID, idx,
+                          RTLIL::SigSpec(RTLIL::Const(k, GetSize(idx))), eq);
+            sel = eq;
+        }
         RTLIL::Wire* nv = module->addWire(NEW_ID, elem_w);
-        module->addMux(NEW_ID, cur, rhs, RTLIL::SigSpec(sel), nv);
+        module->addMux(NEW_ID, cur, rhs, sel, nv);
         if (use_flat) {
             if (proc)
                 emit_comb_assign(RTLIL::SigSpec(flat_w).extract(off, elem_w),
@@ -10908,57 +11061,12 @@ bool UhdmImporter::emit_dynamic_array_elem_field_write(
         return true;
     }
 
-    // Dynamic index: full-width RMW on the flat wire.
+    // Dynamic index.
     RTLIL::SigSpec field_idx;
     if (field_bs) {
         field_idx = import_expression(field_bs->VpiIndex(), comb_read_map());
         if (field_idx.size() == 0) return false;
     }
-    int shamt_w = std::max(idx_sig.size() + 6, 32);
-    if (field_bs) shamt_w = std::max(shamt_w, field_idx.size() + 6);
-    RTLIL::SigSpec idx_ext = idx_sig;
-    idx_ext.extend_u0(shamt_w, false);
-    RTLIL::SigSpec pos = idx_ext;
-    if (array_low != 0) {
-        RTLIL::Wire* pw = module->addWire(NEW_ID, shamt_w);
-        module->addSub(NEW_ID, idx_ext,
-                       RTLIL::SigSpec(RTLIL::Const(array_low, shamt_w)), pw, true);
-        pos = RTLIL::SigSpec(pw);
-    }
-    RTLIL::Wire* elem_shift = module->addWire(NEW_ID, shamt_w);
-    module->addMul(NEW_ID, pos,
-                   RTLIL::SigSpec(RTLIL::Const(elem_w, shamt_w)), elem_shift, true);
-    RTLIL::Wire* bit_shift = module->addWire(NEW_ID, shamt_w);
-    module->addAdd(NEW_ID, RTLIL::SigSpec(elem_shift),
-                   RTLIL::SigSpec(RTLIL::Const(field_offset, shamt_w)), bit_shift, true);
-    if (field_bs) {
-        // Sub-element position within the member: (k - lo)*sub_w for a
-        // descending [hi:lo] dim, (hi - k)*sub_w for an ascending [lo:hi].
-        RTLIL::SigSpec fx = field_idx;
-        fx.extend_u0(shamt_w, false);
-        RTLIL::SigSpec rel = fx;
-        if (sub_l >= sub_r) {
-            if (sub_r != 0) {
-                RTLIL::Wire* pw = module->addWire(NEW_ID, shamt_w);
-                module->addSub(NEW_ID, fx,
-                               RTLIL::SigSpec(RTLIL::Const(sub_r, shamt_w)), pw, true);
-                rel = RTLIL::SigSpec(pw);
-            }
-        } else {
-            RTLIL::Wire* pw = module->addWire(NEW_ID, shamt_w);
-            module->addSub(NEW_ID, RTLIL::SigSpec(RTLIL::Const(sub_r, shamt_w)),
-                           fx, pw, true);
-            rel = RTLIL::SigSpec(pw);
-        }
-        RTLIL::Wire* sub_shift = module->addWire(NEW_ID, shamt_w);
-        module->addMul(NEW_ID, rel,
-                       RTLIL::SigSpec(RTLIL::Const(sub_w, shamt_w)), sub_shift, true);
-        RTLIL::Wire* bs2 = module->addWire(NEW_ID, shamt_w);
-        module->addAdd(NEW_ID, RTLIL::SigSpec(bit_shift),
-                       RTLIL::SigSpec(sub_shift), bs2, true);
-        bit_shift = bs2;
-    }
-
     auto rhs_e = dynamic_cast<const UHDM::expr*>(rhs_any);
     if (!rhs_e) return false;
     int prev_ctx = expression_context_width;
@@ -10968,27 +11076,90 @@ bool UhdmImporter::emit_dynamic_array_elem_field_write(
     if (rhs.size() < write_w) rhs.extend_u0(write_w, is_expr_signed(rhs_e));
     else if (rhs.size() > write_w) rhs = rhs.extract(0, write_w);
 
-    std::vector<RTLIL::State> mask_bits(base_w, RTLIL::State::S0);
-    for (int i = 0; i < write_w; i++) mask_bits[i] = RTLIL::State::S1;
-    RTLIL::SigSpec mask_const = RTLIL::SigSpec(RTLIL::Const(mask_bits));
-    RTLIL::SigSpec rhs_wide = rhs;
-    rhs_wide.extend_u0(base_w, false);
-
-    RTLIL::Wire* mask_sh = module->addWire(NEW_ID, base_w);
-    module->addShl(NEW_ID, mask_const, RTLIL::SigSpec(bit_shift), mask_sh, false);
-    RTLIL::Wire* val_sh = module->addWire(NEW_ID, base_w);
-    module->addShl(NEW_ID, rhs_wide, RTLIL::SigSpec(bit_shift), val_sh, false);
-    RTLIL::Wire* inv_mask = module->addWire(NEW_ID, base_w);
-    module->addNot(NEW_ID, RTLIL::SigSpec(mask_sh), inv_mask);
-
     RTLIL::SigSpec cur = current_comb_values.count(base_name)
                              ? current_comb_values[base_name]
                              : RTLIL::SigSpec(base_wire);
-    RTLIL::Wire* cleared = module->addWire(NEW_ID, base_w);
-    module->addAnd(NEW_ID, cur, RTLIL::SigSpec(inv_mask), cleared);
-    RTLIL::Wire* new_full = module->addWire(NEW_ID, base_w);
-    module->addOr(NEW_ID, RTLIL::SigSpec(cleared),
-                  RTLIL::SigSpec(val_sh), new_full);
+
+    // Dynamic index, whole field: select the element through the shared
+    // index decoder and merge the field lanes with one $bwmux.
+    RTLIL::SigSpec new_full;
+    if (!field_bs) {
+        std::vector<RTLIL::State> fmask(elem_w, RTLIL::State::S0);
+        for (int i = 0; i < field_width; i++) fmask[field_offset + i] = RTLIL::State::S1;
+        RTLIL::SigSpec fval(RTLIL::State::S0, field_offset);
+        fval.append(rhs);
+        fval.append(RTLIL::SigSpec(RTLIL::State::S0, elem_w - field_offset - field_width));
+        new_full = emit_element_merge(cur, idx_sig, array_low, n_elems,
+                                      RTLIL::Const(fmask), fval);
+    }
+
+    // Otherwise full-width RMW on the flat wire.
+    if (new_full.empty()) {
+        int shamt_w = std::max(idx_sig.size() + 6, 32);
+        if (field_bs) shamt_w = std::max(shamt_w, field_idx.size() + 6);
+        RTLIL::SigSpec idx_ext = idx_sig;
+        idx_ext.extend_u0(shamt_w, false);
+        RTLIL::SigSpec pos = idx_ext;
+        if (array_low != 0) {
+            RTLIL::Wire* pw = module->addWire(NEW_ID, shamt_w);
+            module->addSub(NEW_ID, idx_ext,
+                           RTLIL::SigSpec(RTLIL::Const(array_low, shamt_w)), pw, true);
+            pos = RTLIL::SigSpec(pw);
+        }
+        RTLIL::Wire* elem_shift = module->addWire(NEW_ID, shamt_w);
+        module->addMul(NEW_ID, pos,
+                       RTLIL::SigSpec(RTLIL::Const(elem_w, shamt_w)), elem_shift, true);
+        RTLIL::Wire* bit_shift = module->addWire(NEW_ID, shamt_w);
+        module->addAdd(NEW_ID, RTLIL::SigSpec(elem_shift),
+                       RTLIL::SigSpec(RTLIL::Const(field_offset, shamt_w)), bit_shift, true);
+        if (field_bs) {
+            // Sub-element position within the member: (k - lo)*sub_w for a
+            // descending [hi:lo] dim, (hi - k)*sub_w for an ascending [lo:hi].
+            RTLIL::SigSpec fx = field_idx;
+            fx.extend_u0(shamt_w, false);
+            RTLIL::SigSpec rel = fx;
+            if (sub_l >= sub_r) {
+                if (sub_r != 0) {
+                    RTLIL::Wire* pw = module->addWire(NEW_ID, shamt_w);
+                    module->addSub(NEW_ID, fx,
+                                   RTLIL::SigSpec(RTLIL::Const(sub_r, shamt_w)), pw, true);
+                    rel = RTLIL::SigSpec(pw);
+                }
+            } else {
+                RTLIL::Wire* pw = module->addWire(NEW_ID, shamt_w);
+                module->addSub(NEW_ID, RTLIL::SigSpec(RTLIL::Const(sub_r, shamt_w)),
+                               fx, pw, true);
+                rel = RTLIL::SigSpec(pw);
+            }
+            RTLIL::Wire* sub_shift = module->addWire(NEW_ID, shamt_w);
+            module->addMul(NEW_ID, rel,
+                           RTLIL::SigSpec(RTLIL::Const(sub_w, shamt_w)), sub_shift, true);
+            RTLIL::Wire* bs2 = module->addWire(NEW_ID, shamt_w);
+            module->addAdd(NEW_ID, RTLIL::SigSpec(bit_shift),
+                           RTLIL::SigSpec(sub_shift), bs2, true);
+            bit_shift = bs2;
+        }
+
+        std::vector<RTLIL::State> mask_bits(base_w, RTLIL::State::S0);
+        for (int i = 0; i < write_w; i++) mask_bits[i] = RTLIL::State::S1;
+        RTLIL::SigSpec mask_const = RTLIL::SigSpec(RTLIL::Const(mask_bits));
+        RTLIL::SigSpec rhs_wide = rhs;
+        rhs_wide.extend_u0(base_w, false);
+
+        RTLIL::Wire* mask_sh = module->addWire(NEW_ID, base_w);
+        module->addShl(NEW_ID, mask_const, RTLIL::SigSpec(bit_shift), mask_sh, false);
+        RTLIL::Wire* val_sh = module->addWire(NEW_ID, base_w);
+        module->addShl(NEW_ID, rhs_wide, RTLIL::SigSpec(bit_shift), val_sh, false);
+        RTLIL::Wire* inv_mask = module->addWire(NEW_ID, base_w);
+        module->addNot(NEW_ID, RTLIL::SigSpec(mask_sh), inv_mask);
+
+        RTLIL::Wire* cleared = module->addWire(NEW_ID, base_w);
+        module->addAnd(NEW_ID, cur, RTLIL::SigSpec(inv_mask), cleared);
+        RTLIL::Wire* merged = module->addWire(NEW_ID, base_w);
+        module->addOr(NEW_ID, RTLIL::SigSpec(cleared),
+                      RTLIL::SigSpec(val_sh), merged);
+        new_full = merged;
+    }
 
     if (proc) {
         emit_comb_assign(RTLIL::SigSpec(base_wire), RTLIL::SigSpec(new_full), proc);
@@ -11148,8 +11319,9 @@ bool UhdmImporter::emit_dynamic_packed_select_write(
         if (eo < 0 || eo + elem_w > base_w) return false;
         elem_shift = RTLIL::SigSpec(RTLIL::Const((int)eo, shamt_w));
     } else {
+        // Scaled into a bit offset only if the decoder merge below can't be
+        // used (see emit_element_merge).
         shamt_w = std::max(shamt_w, idx0.size() + 6);
-        elem_shift = make_pos(idx0, elem_w, outer_low);
         any_dynamic = true;
     }
 
@@ -11222,24 +11394,37 @@ bool UhdmImporter::emit_dynamic_packed_select_write(
         val_inner = RTLIL::SigSpec(vi);
     }
 
-    // Widen to the flat wire and apply the element shift.
-    RTLIL::SigSpec mask_wide = mask_inner; mask_wide.extend_u0(base_w, false);
-    RTLIL::SigSpec val_wide  = val_inner;  val_wide.extend_u0(base_w, false);
-    RTLIL::Wire* mask_sh = module->addWire(NEW_ID, base_w);
-    module->addShl(NEW_ID, mask_wide, elem_shift, mask_sh, false);
-    RTLIL::Wire* val_sh = module->addWire(NEW_ID, base_w);
-    module->addShl(NEW_ID, val_wide, elem_shift, val_sh, false);
-    RTLIL::Wire* inv_mask = module->addWire(NEW_ID, base_w);
-    module->addNot(NEW_ID, RTLIL::SigSpec(mask_sh), inv_mask);
-
     RTLIL::SigSpec cur = (!in_always_ff_body_mode &&
                           current_comb_values.count(base_name))
                              ? current_comb_values[base_name]
                              : RTLIL::SigSpec(base_wire);
-    RTLIL::Wire* cleared = module->addWire(NEW_ID, base_w);
-    module->addAnd(NEW_ID, cur, RTLIL::SigSpec(inv_mask), cleared);
-    RTLIL::Wire* new_full = module->addWire(NEW_ID, base_w);
-    module->addOr(NEW_ID, RTLIL::SigSpec(cleared), RTLIL::SigSpec(val_sh), new_full);
+
+    // Dynamic element index: select the element through the shared index
+    // decoder and merge with one $bwmux, instead of scaling the index into a
+    // bit offset and shifting a mask and the value across the whole wire.
+    RTLIL::SigSpec new_full;
+    if (!idx0.is_fully_const())
+        new_full = emit_element_merge(cur, idx0, outer_low, outer_size,
+                                      mask_inner, val_inner);
+    if (new_full.empty()) {
+        if (elem_shift.empty())
+            elem_shift = make_pos(idx0, elem_w, outer_low);
+        // Widen to the flat wire and apply the element shift.
+        RTLIL::SigSpec mask_wide = mask_inner; mask_wide.extend_u0(base_w, false);
+        RTLIL::SigSpec val_wide  = val_inner;  val_wide.extend_u0(base_w, false);
+        RTLIL::Wire* mask_sh = module->addWire(NEW_ID, base_w);
+        module->addShl(NEW_ID, mask_wide, elem_shift, mask_sh, false);
+        RTLIL::Wire* val_sh = module->addWire(NEW_ID, base_w);
+        module->addShl(NEW_ID, val_wide, elem_shift, val_sh, false);
+        RTLIL::Wire* inv_mask = module->addWire(NEW_ID, base_w);
+        module->addNot(NEW_ID, RTLIL::SigSpec(mask_sh), inv_mask);
+
+        RTLIL::Wire* cleared = module->addWire(NEW_ID, base_w);
+        module->addAnd(NEW_ID, cur, RTLIL::SigSpec(inv_mask), cleared);
+        RTLIL::Wire* merged = module->addWire(NEW_ID, base_w);
+        module->addOr(NEW_ID, RTLIL::SigSpec(cleared), RTLIL::SigSpec(val_sh), merged);
+        new_full = merged;
+    }
 
     if (proc) {
         emit_comb_assign(RTLIL::SigSpec(base_wire), RTLIL::SigSpec(new_full), proc);
@@ -11636,10 +11821,10 @@ void UhdmImporter::import_assignment_comb(const assignment* uhdm_assign, RTLIL::
         if (auto rhs_expr = dynamic_cast<const expr*>(rhs_any)) {
             rhs_fill_state = detect_fill_const_state(rhs_expr, rhs_is_fill);
             if (mode_debug) {
-                log("    Assignment RHS is expression type %d\n", rhs_expr->VpiType());
+                log_uhdm_trace("    Assignment RHS is expression type %d\n", rhs_expr->VpiType());
                 if (rhs_expr->VpiType() == vpiOperation) {
                     const operation* op = any_cast<const operation*>(rhs_expr);
-                    log("    Operation type: %d\n", op->VpiOpType());
+                    log_uhdm_trace("    Operation type: %d\n", op->VpiOpType());
                 }
             }
             // Propagate LHS width as context so arithmetic ops widen to it
@@ -11744,10 +11929,10 @@ void UhdmImporter::import_assignment_comb(const assignment* uhdm_assign, RTLIL::
         }
 
         // If we have a temp wire for this signal, assign to it
-        log("      Looking for signal '%s' in temp wires map (map size=%zu)\n",
+        log_uhdm_trace("      Looking for signal '%s' in temp wires map (map size=%zu)\n",
             signal_name.c_str(), current_signal_temp_wires.size());
         if (!signal_name.empty() && current_signal_temp_wires.count(signal_name)) {
-            log("      Found temp wire for signal '%s'\n", signal_name.c_str());
+            log_uhdm_trace("      Found temp wire for signal '%s'\n", signal_name.c_str());
             RTLIL::Wire* temp_wire = current_signal_temp_wires[signal_name];
             RTLIL::SigSpec temp_spec(temp_wire);
 
@@ -11822,12 +12007,12 @@ void UhdmImporter::import_assignment_comb(const assignment* uhdm_assign, RTLIL::
                 RTLIL::SigSpec part_temp = temp_spec.extract(offset, width);
                 proc->root_case.actions.push_back(RTLIL::SigSig(part_temp, rhs));
                 
-                log("      Assigned to temp wire %s[%d:%d] <= [value]\n", 
+                log_uhdm_trace("      Assigned to temp wire %s[%d:%d] <= [value]\n", 
                     signal_name.c_str(), offset + width - 1, offset);
             } else {
                 // Full signal assignment
                 proc->root_case.actions.push_back(RTLIL::SigSig(temp_spec, rhs));
-                log("      Assigned to temp wire %s <= [value]\n", signal_name.c_str());
+                log_uhdm_trace("      Assigned to temp wire %s <= [value]\n", signal_name.c_str());
             }
             return;
         }
@@ -12045,10 +12230,10 @@ void UhdmImporter::import_assignment_comb(const assignment* uhdm_assign, RTLIL::
         if (auto rhs_expr = dynamic_cast<const expr*>(rhs_any)) {
             rhs_fill_state = detect_fill_const_state(rhs_expr, rhs_is_fill);
             if (mode_debug) {
-                log("    Assignment RHS is expression type %d\n", rhs_expr->VpiType());
+                log_uhdm_trace("    Assignment RHS is expression type %d\n", rhs_expr->VpiType());
                 if (rhs_expr->VpiType() == vpiOperation) {
                     const operation* op = any_cast<const operation*>(rhs_expr);
-                    log("    Operation type: %d\n", op->VpiOpType());
+                    log_uhdm_trace("    Operation type: %d\n", op->VpiOpType());
                 }
             }
             // Propagate the LHS width into RHS so arithmetic ops (vpiAddOp /
@@ -12166,10 +12351,10 @@ void UhdmImporter::import_assignment_comb(const assignment* uhdm_assign, RTLIL::
         }
 
         // If we have a temp wire for this signal, assign to it
-        log("      Looking for signal '%s' in temp wires map (map size=%zu)\n",
+        log_uhdm_trace("      Looking for signal '%s' in temp wires map (map size=%zu)\n",
             signal_name.c_str(), current_signal_temp_wires.size());
         if (!signal_name.empty() && current_signal_temp_wires.count(signal_name)) {
-            log("      Found temp wire for signal '%s'\n", signal_name.c_str());
+            log_uhdm_trace("      Found temp wire for signal '%s'\n", signal_name.c_str());
             RTLIL::Wire* temp_wire = current_signal_temp_wires[signal_name];
             RTLIL::SigSpec temp_spec(temp_wire);
 
@@ -12248,7 +12433,7 @@ void UhdmImporter::import_assignment_comb(const assignment* uhdm_assign, RTLIL::
                 RTLIL::SigSpec part_temp = temp_spec.extract(offset, width);
                 case_rule->actions.push_back(RTLIL::SigSig(part_temp, rhs));
                 
-                log("      Assigned to temp wire %s[%d:%d] <= [value]\n", 
+                log_uhdm_trace("      Assigned to temp wire %s[%d:%d] <= [value]\n", 
                     signal_name.c_str(), offset + width - 1, offset);
             } else {
                 // Full signal assignment.  An unconditional write to the whole
@@ -12257,7 +12442,7 @@ void UhdmImporter::import_assignment_comb(const assignment* uhdm_assign, RTLIL::
                 // this later-wins value (firrtl_938).
                 remove_target_from_switches(case_rule, temp_spec);
                 case_rule->actions.push_back(RTLIL::SigSig(temp_spec, rhs));
-                log("      Assigned to temp wire %s <= [value] (temp_wire=%s)\n",
+                log_uhdm_trace("      Assigned to temp wire %s <= [value] (temp_wire=%s)\n",
                     signal_name.c_str(), temp_wire->name.c_str());
             }
             return;
@@ -12308,7 +12493,7 @@ void UhdmImporter::import_if_stmt_sync(const UHDM::if_stmt* uhdm_if, RTLIL::Sync
         }
 
         if (mode_debug)
-            log("    If statement condition: %s\n", log_signal(condition));
+            log_uhdm_trace("    If statement condition: %s\n", log_signal(condition));
 
         // Compile-time-constant guard: import only the taken branch.
         if (condition.is_fully_const()) {
@@ -12334,14 +12519,14 @@ void UhdmImporter::import_if_stmt_sync(const UHDM::if_stmt* uhdm_if, RTLIL::Sync
     
     // Import then statement
     if (auto then_stmt = uhdm_if->VpiStmt()) {
-        log("          Importing then statement (type=%d) with condition=%s\n", 
+        log_uhdm_trace("          Importing then statement (type=%d) with condition=%s\n", 
             then_stmt->VpiType(), log_signal(current_condition));
         log_flush();
         import_statement_sync(then_stmt, sync, is_reset);
     }
     
     // Handle else statement if present
-    log("          Checking for else statement (UhdmType=%d, uhdmif_else=%d, VpiType=%d, vpiIfElse=%d)\n", 
+    log_uhdm_trace("          Checking for else statement (UhdmType=%d, uhdmif_else=%d, VpiType=%d, vpiIfElse=%d)\n", 
         uhdm_if->UhdmType(), uhdmif_else, uhdm_if->VpiType(), vpiIfElse);
     log_flush();
     
@@ -12537,7 +12722,7 @@ void UhdmImporter::thread_comb_case(const RTLIL::SigSpec& case_sig,
 }
 
 void UhdmImporter::import_if_else_comb(const UHDM::if_else* uhdm_if_else, RTLIL::Process* proc) {
-    log("    import_if_else_comb: Importing if_else statement\n");
+    log_uhdm_trace("    import_if_else_comb: Importing if_else statement\n");
 
     // `priority if` / `unique if`: only the OUTERMOST if_else carries the
     // qualifier; propagate it down via `current_if_qualifier` so the
@@ -12569,7 +12754,7 @@ void UhdmImporter::import_if_else_comb(const UHDM::if_else* uhdm_if_else, RTLIL:
         }
 
         if (mode_debug)
-            log("    If_else condition: %s\n", log_signal(condition_sig));
+            log_uhdm_trace("    If_else condition: %s\n", log_signal(condition_sig));
 
         // Compile-time-constant condition: import only the TAKEN branch
         // (mirrors import_if_stmt_comb and the CaseRule vpiIf path) — a
@@ -12611,7 +12796,7 @@ void UhdmImporter::import_if_else_comb(const UHDM::if_else* uhdm_if_else, RTLIL:
         // Import then statement
         if (auto then_stmt = uhdm_if_else->VpiStmt()) {
             if (mode_debug)
-                log("    Importing then statement\n");
+                log_uhdm_trace("    Importing then statement\n");
             import_statement_comb(then_stmt, true_case);
         }
         // Capture the branch's final in-flight values (incl. nested-construct
@@ -12627,12 +12812,12 @@ void UhdmImporter::import_if_else_comb(const UHDM::if_else* uhdm_if_else, RTLIL:
             // Empty compare means default case
             add_src_attribute(else_case->attributes, uhdm_if_else);
 
-            log("    Importing else statement, type: %s (vpiType=%d)\n",
+            log_uhdm_trace("    Importing else statement, type: %s (vpiType=%d)\n",
                 UhdmName(else_stmt->UhdmType()).c_str(), else_stmt->VpiType());
-            log("    Else case has %d actions before import\n", (int)else_case->actions.size());
+            log_uhdm_trace("    Else case has %d actions before import\n", (int)else_case->actions.size());
             import_statement_comb(else_stmt, else_case);
-            log("    Else case has %d actions after import\n", (int)else_case->actions.size());
-            log("    Else case has %d switches after import\n", (int)else_case->switches.size());
+            log_uhdm_trace("    Else case has %d actions after import\n", (int)else_case->actions.size());
+            log_uhdm_trace("    Else case has %d switches after import\n", (int)else_case->switches.size());
             auto else_ccv = current_comb_values;
             current_comb_values = saved_ccv;
 
@@ -12660,7 +12845,7 @@ void UhdmImporter::import_if_else_comb(const UHDM::if_else* uhdm_if_else, RTLIL:
 // Import if statement for comb context
 void UhdmImporter::import_if_stmt_comb(const UHDM::if_stmt* uhdm_if, RTLIL::Process* proc) {
     // Always log for debugging
-    log("    import_if_stmt_comb: Importing if statement (UhdmType=%d)\n", uhdm_if->UhdmType());
+    log_uhdm_trace("    import_if_stmt_comb: Importing if statement (UhdmType=%d)\n", uhdm_if->UhdmType());
 
     // Same qualifier-propagation logic as `import_if_else_comb`; the
     // innermost `else if (…)` in a `priority if` chain reaches here
@@ -12693,7 +12878,7 @@ void UhdmImporter::import_if_stmt_comb(const UHDM::if_stmt* uhdm_if, RTLIL::Proc
         }
 
         if (mode_debug)
-            log("    If condition: %s\n", log_signal(condition_sig));
+            log_uhdm_trace("    If condition: %s\n", log_signal(condition_sig));
 
         // Compile-time-constant condition (typically a for-loop-unrolled guard
         // such as `if (i >= MHPMCOUNTER_BASE)`): fold it and import only the
@@ -12740,7 +12925,7 @@ void UhdmImporter::import_if_stmt_comb(const UHDM::if_stmt* uhdm_if, RTLIL::Proc
         // Import then statement
         if (auto then_stmt = uhdm_if->VpiStmt()) {
             if (mode_debug)
-                log("    Importing then statement\n");
+                log_uhdm_trace("    Importing then statement\n");
             import_statement_comb(then_stmt, true_case);
         }
         auto then_ccv = current_comb_values;
@@ -12754,9 +12939,9 @@ void UhdmImporter::import_if_stmt_comb(const UHDM::if_stmt* uhdm_if, RTLIL::Proc
         sw->cases.push_back(default_case);
 
         if (mode_debug) {
-            log("    If statement import complete. Switch has %d cases\n", (int)sw->cases.size());
+            log_uhdm_trace("    If statement import complete. Switch has %d cases\n", (int)sw->cases.size());
             for (size_t i = 0; i < sw->cases.size(); i++) {
-                log("      Case %d: %d actions\n", (int)i, (int)sw->cases[i]->actions.size());
+                log_uhdm_trace("      Case %d: %d actions\n", (int)i, (int)sw->cases[i]->actions.size());
             }
         }
 
@@ -12773,7 +12958,7 @@ void UhdmImporter::import_if_stmt_comb(const UHDM::if_stmt* uhdm_if, RTLIL::Proc
 
 // Import case statement for sync context
 void UhdmImporter::import_case_stmt_sync(const case_stmt* uhdm_case, RTLIL::SyncRule* sync, bool is_reset) {
-    log("        Processing case statement in sync context\n");
+    log_uhdm_trace("        Processing case statement in sync context\n");
     log_flush();
     
     // Get the case condition (the signal being switched on)
@@ -12784,15 +12969,15 @@ void UhdmImporter::import_case_stmt_sync(const case_stmt* uhdm_case, RTLIL::Sync
         bool is_initial_block = (sync->type == RTLIL::SyncType::STi);
         bool is_const_condition = case_sig.is_fully_const();
         
-        log("        Case condition signal: %s\n", log_signal(case_sig));
-        log("        Is initial block: %s, Is const condition: %s\n", 
+        log_uhdm_trace("        Case condition signal: %s\n", log_signal(case_sig));
+        log_uhdm_trace("        Is initial block: %s, Is const condition: %s\n", 
             is_initial_block ? "yes" : "no", is_const_condition ? "yes" : "no");
         log_flush();
         
         // If this is an initial block with constant condition, try to evaluate it directly
         if (is_initial_block && is_const_condition && case_sig.is_fully_const()) {
             RTLIL::Const case_value = case_sig.as_const();
-            log("        Evaluating constant case in initial block: %s\n", case_value.as_string().c_str());
+            log_uhdm_trace("        Evaluating constant case in initial block: %s\n", case_value.as_string().c_str());
             
             // Process each case item to find a match
             if (auto case_items = uhdm_case->Case_items()) {
@@ -12817,7 +13002,7 @@ void UhdmImporter::import_case_stmt_sync(const case_stmt* uhdm_case, RTLIL::Sync
                                     
                                     if (case_extended == expr_extended) {
                                         case_matches = true;
-                                        log("          Found matching case: %s == %s\n", 
+                                        log_uhdm_trace("          Found matching case: %s == %s\n", 
                                             case_value.as_string().c_str(), expr_value.as_string().c_str());
                                         break;
                                     }
@@ -12827,13 +13012,13 @@ void UhdmImporter::import_case_stmt_sync(const case_stmt* uhdm_case, RTLIL::Sync
                     } else {
                         // This is a default case
                         is_default = true;
-                        log("          Default case found\n");
+                        log_uhdm_trace("          Default case found\n");
                     }
                     
                     // Execute the matching case (or save default for later)
                     if (case_matches) {
                         if (auto stmt = case_item->Stmt()) {
-                            log("          Executing matching case body\n");
+                            log_uhdm_trace("          Executing matching case body\n");
                             import_statement_sync(stmt, sync, is_reset);
                         }
                         return; // Found match, done processing
@@ -12851,7 +13036,7 @@ void UhdmImporter::import_case_stmt_sync(const case_stmt* uhdm_case, RTLIL::Sync
                 for (auto case_item : *case_items) {
                     if (!case_item->VpiExprs()) { // Default case
                         if (auto stmt = case_item->Stmt()) {
-                            log("          Executing default case body\n");
+                            log_uhdm_trace("          Executing default case body\n");
                             import_statement_sync(stmt, sync, is_reset);
                         }
                         return;
@@ -12859,7 +13044,7 @@ void UhdmImporter::import_case_stmt_sync(const case_stmt* uhdm_case, RTLIL::Sync
                 }
             }
             
-            log("        No matching case found for constant value\n");
+            log_uhdm_trace("        No matching case found for constant value\n");
             return; // Exit early for constant evaluation
         }
         
@@ -12871,7 +13056,7 @@ void UhdmImporter::import_case_stmt_sync(const case_stmt* uhdm_case, RTLIL::Sync
         
         // Process each case item
         if (auto case_items = uhdm_case->Case_items()) {
-            log("        Found %d case items\n", (int)case_items->size());
+            log_uhdm_trace("        Found %d case items\n", (int)case_items->size());
             log_flush();
             
             for (auto case_item : *case_items) {
@@ -12895,7 +13080,7 @@ void UhdmImporter::import_case_stmt_sync(const case_stmt* uhdm_case, RTLIL::Sync
                                 case_condition = create_or_cell(case_condition, eq_sig, case_item);
                             }
                             
-                            log("          Case value: %s\n", log_signal(expr_sig));
+                            log_uhdm_trace("          Case value: %s\n", log_signal(expr_sig));
                             log_flush();
                         }
                     }
@@ -12912,7 +13097,7 @@ void UhdmImporter::import_case_stmt_sync(const case_stmt* uhdm_case, RTLIL::Sync
                 } else {
                     // This is a default case
                     is_default = true;
-                    log("          Default case\n");
+                    log_uhdm_trace("          Default case\n");
                     log_flush();
                 }
                 
@@ -12941,7 +13126,7 @@ void UhdmImporter::import_case_stmt_sync(const case_stmt* uhdm_case, RTLIL::Sync
                                 // AND with existing condition
                                 current_condition = create_and_cell(current_condition, default_condition, case_item);
                             }
-                            log("          Using negation of all non-default conditions for default case\n");
+                            log_uhdm_trace("          Using negation of all non-default conditions for default case\n");
                         }
                     } else if (!case_condition.empty()) {
                         if (current_condition.empty()) {
@@ -12952,7 +13137,7 @@ void UhdmImporter::import_case_stmt_sync(const case_stmt* uhdm_case, RTLIL::Sync
                         }
                     }
                     
-                    log("          Importing case body statements\n");
+                    log_uhdm_trace("          Importing case body statements\n");
                     log_flush();
                     
                     // Import the statement(s) for this case
@@ -12964,7 +13149,7 @@ void UhdmImporter::import_case_stmt_sync(const case_stmt* uhdm_case, RTLIL::Sync
             }
         }
         
-        log("        Case statement processed\n");
+        log_uhdm_trace("        Case statement processed\n");
         log_flush();
         
     } else {
@@ -13101,10 +13286,230 @@ void UhdmImporter::emit_full_case_default(const case_stmt* uhdm_case, RTLIL::Swi
     }
 }
 
+// Constant case tables — `case (idx) K0: out = C0; K1: out = C1; ...` where
+// every arm (and the default) assigns only constants to the same set of full
+// signals.  The switch-rule lowering turns these into a $eq/$pmux tree per
+// output; instead build the packed table image once and read it with the case
+// selector as the address: a ROM (memory + $meminit_v2 + async $memrd, which
+// memory_collect/memory_libmap can map to block RAM) for tables of at least
+// case_rom_threshold words, or a single $bmux over the packed constant for
+// smaller, LUT-friendly ones.  Arms are matched in source order (first match
+// wins, as in the switch), unlisted addresses take the default arm, or X for a
+// `unique`/`priority`/`full_case` case without one.  Anything else — casez/
+// casex, `inside`, a non-constant label or value, an arm that is not a plain
+// blocking assignment, a latch-inferring uncovered case — returns false and
+// the caller keeps the switch-rule path.
+bool UhdmImporter::emit_case_rom(const case_stmt* uhdm_case, const RTLIL::SigSpec& case_sig,
+                                 RTLIL::Process* proc) {
+    if (!mode_case_rom || in_always_ff_context || in_always_ff_body_mode)
+        return false;
+    if (uhdm_case->VpiCaseType() != vpiCaseExact)
+        return false;
+    auto case_items = uhdm_case->Case_items();
+    if (!case_items || case_items->size() < 2)
+        return false;
+    int abits = case_sig.size();
+    if (abits == 0 || abits > case_rom_max_abits || case_sig.is_fully_const())
+        return false;
+    if (is_expr_signed(uhdm_case->VpiCondition()))
+        return false;
+
+    // Only literals and parameter / enum-constant references: importing them
+    // creates no cells, so bailing out below leaves nothing behind.
+    auto is_const_leaf = [](const any* e) -> bool {
+        if (!e) return false;
+        if (e->UhdmType() == uhdmconstant) return true;
+        if (e->UhdmType() != uhdmref_obj) return false;
+        const any* a = any_cast<const ref_obj*>(e)->Actual_group();
+        return a && (a->UhdmType() == uhdmparameter || a->UhdmType() == uhdmenum_const);
+    };
+
+    // One arm = the list of (target, value) plain blocking assignments it makes.
+    struct Arm {
+        std::vector<RTLIL::SigSpec> labels;
+        std::map<std::string, const expr*> values;
+    };
+    std::vector<Arm> arms;
+    int default_idx = -1;
+    std::vector<std::string> targets;  // first arm's order, for the word layout
+    arms.reserve(case_items->size());
+    for (auto case_item : *case_items) {
+        Arm arm;
+        const any* st = case_item->Stmt();
+        if (!st) return false;
+        std::vector<const any*> stmts;
+        if (st->VpiType() == vpiBegin || st->VpiType() == vpiNamedBegin) {
+            auto body = begin_block_stmts(st);
+            if (!body) return false;
+            stmts.assign(body->begin(), body->end());
+        } else {
+            stmts.push_back(st);
+        }
+        for (auto s : stmts) {
+            if (s->UhdmType() != uhdmassignment) return false;
+            auto a = any_cast<const assignment*>(s);
+            if (!a->VpiBlocking() || (a->VpiOpType() != 0 && a->VpiOpType() != vpiAssignmentOp))
+                return false;
+            if (!a->Lhs() || a->Lhs()->UhdmType() != uhdmref_obj) return false;
+            auto rhs = dynamic_cast<const expr*>(a->Rhs());
+            if (!is_const_leaf(rhs)) return false;
+            std::string name(any_cast<const ref_obj*>(a->Lhs())->VpiName());
+            if (!arm.values.emplace(name, rhs).second) return false;
+        }
+        if (case_item->VpiExprs() && !case_item->VpiExprs()->empty()) {
+            for (auto e : *case_item->VpiExprs()) {
+                if (!is_const_leaf(e)) return false;
+                RTLIL::SigSpec label = import_expression(any_cast<const expr*>(e));
+                if (!label.is_fully_const() || !label.is_fully_def()) return false;
+                arm.labels.push_back(label);
+            }
+        } else if (default_idx >= 0) {
+            return false;
+        }
+        if (targets.empty())
+            for (auto& v : arm.values) targets.push_back(v.first);
+        if (arm.values.size() != targets.size()) return false;
+        for (auto& t : targets)
+            if (!arm.values.count(t)) return false;
+        if (arm.labels.empty())
+            default_idx = (int)arms.size();
+        arms.push_back(std::move(arm));
+    }
+    if (targets.empty())
+        return false;
+
+    // Resolve each target to a full wire this process owns a temp for.
+    std::vector<RTLIL::Wire*> target_wires;
+    int width = 0;
+    for (auto& t : targets) {
+        RTLIL::Wire* w = find_wire_in_scope(t);
+        if (!w || !find_own_temp_wire(w->name.str().substr(1)))
+            return false;
+        target_wires.push_back(w);
+        width += w->width;
+    }
+
+    int words = 1 << abits;
+    int labelled = 0;
+    for (auto& arm : arms) labelled += (int)arm.labels.size();
+    // A sparse table on a wide selector is cheaper as the compare tree.
+    if (labelled * 4 < words)
+        return false;
+
+    // Build the packed image: word i at bits [i*width +: width], targets
+    // laid out LSB-first in `targets` order.
+    auto arm_word = [&](const Arm& arm, std::vector<RTLIL::State>& word) -> bool {
+        word.clear();
+        for (size_t k = 0; k < targets.size(); k++) {
+            const expr* rhs = arm.values.at(targets[k]);
+            int w = target_wires[k]->width;
+            int saved_ctx = expression_context_width;
+            expression_context_width = w;
+            RTLIL::SigSpec v = import_expression(rhs);
+            expression_context_width = saved_ctx;
+            if (!v.is_fully_const()) return false;
+            if (v.size() != w) v.extend_u0(w, is_expr_signed(rhs));
+            std::vector<RTLIL::State> bits = v.as_const().to_bits();
+            word.insert(word.end(), bits.begin(), bits.begin() + w);
+        }
+        return true;
+    };
+    std::vector<RTLIL::State> image((size_t)words * width, RTLIL::State::Sx);
+    std::vector<bool> filled(words, false);
+    std::vector<RTLIL::State> word;
+    for (auto& arm : arms) {
+        if (arm.labels.empty()) continue;
+        if (!arm_word(arm, word)) return false;
+        for (auto& label : arm.labels) {
+            RTLIL::Const lc = label.as_const();
+            // Bits above the selector width that are set can never match the
+            // zero-extended selector.
+            bool reachable = true;
+            for (int b = abits; b < lc.size(); b++)
+                if (lc[b] == RTLIL::State::S1) reachable = false;
+            if (!reachable) continue;
+            lc = lc.extract(0, std::min(abits, lc.size()));
+            int addr = lc.as_int();
+            if (filled[addr]) continue;  // an earlier arm wins
+            filled[addr] = true;
+            std::copy(word.begin(), word.end(), image.begin() + (size_t)addr * width);
+        }
+    }
+    bool full_case = uhdm_case->VpiQualifier() == vpiUniqueQualifier ||
+                     uhdm_case->VpiQualifier() == vpiPriorityQualifier;
+    if (auto attrs = uhdm_case->Attributes())
+        for (auto a : *attrs)
+            if (a->VpiName() == "full_case") full_case = true;
+    if (default_idx >= 0 && !arm_word(arms[default_idx], word))
+        return false;
+    for (int addr = 0; addr < words; addr++) {
+        if (filled[addr]) continue;
+        // An uncovered value without a default holds the old value (a latch),
+        // which a table read cannot express.
+        if (default_idx < 0 && !full_case) return false;
+        if (default_idx >= 0)
+            std::copy(word.begin(), word.end(), image.begin() + (size_t)addr * width);
+    }
+
+    std::string tag = targets.front();
+    RTLIL::Wire* data_wire = module->addWire(
+        module->uniquify(RTLIL::escape_id(stringf("$case_rom$%s$data", tag.c_str()))), width);
+    add_src_attribute(data_wire->attributes, uhdm_case);
+    if (words >= case_rom_threshold) {
+        RTLIL::IdString mem_id =
+            module->uniquify(RTLIL::escape_id(stringf("$case_rom$%s", tag.c_str())));
+        RTLIL::Memory* memory = new RTLIL::Memory;
+        memory->name = mem_id;
+        memory->width = width;
+        memory->size = words;
+        memory->start_offset = 0;
+        add_src_attribute(memory->attributes, uhdm_case);
+        module->memories[mem_id] = memory;
+
+        RTLIL::Cell* init = module->addCell(NEW_ID, ID($meminit_v2));
+        init->setParam(ID::MEMID, RTLIL::Const(mem_id.str()));
+        init->setParam(ID::ABITS, RTLIL::Const(32));
+        init->setParam(ID::WIDTH, RTLIL::Const(width));
+        init->setParam(ID::WORDS, RTLIL::Const(words));
+        init->setParam(ID::PRIORITY, RTLIL::Const(0));
+        init->setPort(ID::ADDR, RTLIL::Const(0, 32));
+        init->setPort(ID::DATA, RTLIL::Const(image));
+        init->setPort(ID::EN, RTLIL::Const(RTLIL::State::S1, width));
+        add_src_attribute(init->attributes, uhdm_case);
+
+        RTLIL::Cell* rd = module->addCell(NEW_ID, ID($memrd));
+        rd->setParam(ID::MEMID, RTLIL::Const(mem_id.str()));
+        rd->setParam(ID::ABITS, abits);
+        rd->setParam(ID::WIDTH, width);
+        rd->setParam(ID::CLK_ENABLE, RTLIL::Const(0));
+        rd->setParam(ID::CLK_POLARITY, RTLIL::Const(0));
+        rd->setParam(ID::TRANSPARENT, RTLIL::Const(0));
+        rd->setPort(ID::CLK, RTLIL::SigSpec(RTLIL::State::Sx, 1));
+        rd->setPort(ID::EN, RTLIL::SigSpec(RTLIL::State::S1, 1));
+        rd->setPort(ID::ADDR, case_sig);
+        rd->setPort(ID::DATA, data_wire);
+        add_src_attribute(rd->attributes, uhdm_case);
+        log_uhdm_trace("UHDM: case table on %s -> %d x %d ROM %s\n", log_signal(case_sig), words,
+            width, log_id(mem_id));
+    } else {
+        RTLIL::Cell* bmux = module->addBmux(NEW_ID, RTLIL::Const(image), case_sig, data_wire);
+        add_src_attribute(bmux->attributes, uhdm_case);
+        if (mode_debug)
+            log_uhdm_trace("    Case table on %s -> %d x %d $bmux\n", log_signal(case_sig), words, width);
+    }
+
+    int off = 0;
+    for (auto w : target_wires) {
+        emit_comb_assign(RTLIL::SigSpec(w), RTLIL::SigSpec(data_wire).extract(off, w->width), proc);
+        off += w->width;
+    }
+    return true;
+}
+
 // Import case statement for comb context
 void UhdmImporter::import_case_stmt_comb(const case_stmt* uhdm_case, RTLIL::Process* proc) {
     if (mode_debug)
-        log("    Importing case statement for combinational context\n");
+        log_uhdm_trace("    Importing case statement for combinational context\n");
 
     const UHDM::expr* condition = uhdm_case->VpiCondition();
     if (!condition) {
@@ -13116,7 +13521,10 @@ void UhdmImporter::import_case_stmt_comb(const case_stmt* uhdm_case, RTLIL::Proc
     bool case_expr_signed = is_expr_signed(condition);
 
     if (mode_debug)
-        log("    Case condition signal: %s (signed=%d)\n", log_signal(case_sig), case_expr_signed);
+        log_uhdm_trace("    Case condition signal: %s (signed=%d)\n", log_signal(case_sig), case_expr_signed);
+
+    if (emit_case_rom(uhdm_case, case_sig, proc))
+        return;
 
     // --- Pass 1: compute context width and signedness (SV LRM 12.5.1) ---
     // Context width = max of case expression width and all case-item widths.
@@ -13135,7 +13543,7 @@ void UhdmImporter::import_case_stmt_comb(const case_stmt* uhdm_case, RTLIL::Proc
 
     if (auto case_items = uhdm_case->Case_items()) {
         if (mode_debug)
-            log("    Found %d case items\n", (int)case_items->size());
+            log_uhdm_trace("    Found %d case items\n", (int)case_items->size());
         items.reserve(case_items->size());
         for (auto case_item : *case_items) {
             ItemData d;
@@ -13198,7 +13606,7 @@ void UhdmImporter::import_case_stmt_comb(const case_stmt* uhdm_case, RTLIL::Proc
     }
 
     if (mode_debug)
-        log("    Context width=%d all_signed=%d\n", ctx_width, all_signed);
+        log_uhdm_trace("    Context width=%d all_signed=%d\n", ctx_width, all_signed);
 
     // --- Extend switch signal to context width ---
     if (case_sig.size() < ctx_width)
@@ -13225,7 +13633,7 @@ void UhdmImporter::import_case_stmt_comb(const case_stmt* uhdm_case, RTLIL::Proc
     // per-arm value — including signals written inside nested if/case — rather
     // than the polluted live current_comb_values.  Arms are independent (SV):
     // each starts from pre_ccv, not the previous arm's writes.
-    std::map<std::string, RTLIL::SigSpec> pre_ccv = current_comb_values;
+    CombValueMap pre_ccv = current_comb_values;
     std::vector<std::map<std::string, RTLIL::SigSpec>> arm_ccv;
 
     if (!items.empty()) {
@@ -13239,7 +13647,7 @@ void UhdmImporter::import_case_stmt_comb(const case_stmt* uhdm_case, RTLIL::Proc
                     sig = sig.extract(0, ctx_width);
                 d.rule->compare.push_back(sig);
                 if (mode_debug)
-                    log("      Case value: %s (width=%d)\n", log_signal(sig), sig.size());
+                    log_uhdm_trace("      Case value: %s (width=%d)\n", log_signal(sig), sig.size());
             }
             // Import the body from the pre-case state, then capture the result.
             current_comb_values = pre_ccv;
@@ -13251,7 +13659,7 @@ void UhdmImporter::import_case_stmt_comb(const case_stmt* uhdm_case, RTLIL::Proc
     } else {
         // No case items — create an empty default case
         if (mode_debug)
-            log("    No case items found, creating empty default case\n");
+            log_uhdm_trace("    No case items found, creating empty default case\n");
         RTLIL::CaseRule* default_case = new RTLIL::CaseRule;
         add_src_attribute(default_case->attributes, uhdm_case);
         sw->cases.push_back(default_case);
@@ -13270,21 +13678,22 @@ void UhdmImporter::import_case_stmt_comb(const case_stmt* uhdm_case, RTLIL::Proc
     proc->root_case.switches.push_back(sw);
 
     if (mode_debug)
-        log("    Case statement implementation complete\n");
+        log_uhdm_trace("    Case statement implementation complete\n");
 }
 
 // Import statement for case rule context
 void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::CaseRule* case_rule) {
     if (!uhdm_stmt) {
         if (mode_debug)
-            log("        import_statement_comb: null statement\n");
+            log_uhdm_trace("        import_statement_comb: null statement\n");
         return;
     }
+    HeatmapScope heat(this, uhdm_stmt);
     
     int stmt_type = uhdm_stmt->VpiType();
     
     if (mode_debug) {
-        log("        import_statement_comb: Processing statement type %s (vpiType=%d)\n",
+        log_uhdm_trace("        import_statement_comb: Processing statement type %s (vpiType=%d)\n",
             UhdmName(uhdm_stmt->UhdmType()).c_str(), stmt_type);
     }
     
@@ -13385,7 +13794,7 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::CaseRule*
                                 int a = addr.as_const().as_int();
                                 if (a < m->start_offset ||
                                     a >= m->start_offset + m->size) {
-                                    log("        Dropped out-of-bounds memory write %s[%d] (size=%d)\n",
+                                    log_uhdm_trace("        Dropped out-of-bounds memory write %s[%d] (size=%d)\n",
                                         mem_name.c_str(), a, m->size);
                                     return;
                                 }
@@ -13424,7 +13833,7 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::CaseRule*
                                 RTLIL::SigSpec(RTLIL::State::S1, info.en_wire->width)));
 
                             if (mode_debug)
-                                log("        Memory write to %s: addr=%s, data=%s\n",
+                                log_uhdm_trace("        Memory write to %s: addr=%s, data=%s\n",
                                     mem_name.c_str(), log_signal(addr), log_signal(data));
                             return;
                         }
@@ -13714,7 +14123,7 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::CaseRule*
                                         target_sig = RTLIL::SigSpec(temp_wire);
                                     }
                                     if (mode_debug)
-                                        log("        Using temp wire %s for signal %s in async reset context (partial=%d)\n",
+                                        log_uhdm_trace("        Using temp wire %s for signal %s in async reset context (partial=%d)\n",
                                             temp_wire->name.c_str(), signal_name.c_str(), is_partial ? 1 : 0);
                                 }
                                 // UNPACKED-array whole-array / slice writes: the
@@ -13775,7 +14184,7 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::CaseRule*
                                         target_sig = mapped;
                                     }
                                     if (mode_debug)
-                                        log("        Using temp wire for assignment\n");
+                                        log_uhdm_trace("        Using temp wire for assignment\n");
                                 } else {
                                     // Pointer-based lookup misses when the same signal
                                     // is referenced from multiple UHDM ref_obj instances
@@ -13816,7 +14225,7 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::CaseRule*
                             }
                             
                             if (mode_debug)
-                                log("        Case assignment: %s = %s\n", log_signal(target_sig), log_signal(rhs_sig));
+                                log_uhdm_trace("        Case assignment: %s = %s\n", log_signal(target_sig), log_signal(rhs_sig));
 
                             // An unconditional full-wire write supersedes any
                             // earlier conditional write to the same signal in
@@ -13830,7 +14239,7 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::CaseRule*
                                 remove_target_from_switches(case_rule, target_sig);
                             case_rule->actions.push_back(RTLIL::SigSig(target_sig, rhs_sig));
                             if (mode_debug)
-                                log("        Assignment added to case_rule, now has %d actions\n", (int)case_rule->actions.size());
+                                log_uhdm_trace("        Assignment added to case_rule, now has %d actions\n", (int)case_rule->actions.size());
 
                             // Track BLOCKING temps so a later same-cycle read in
                             // this always_ff body resolves to the in-flight
@@ -13896,7 +14305,7 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::CaseRule*
         }
         case vpiBegin:
         case vpiNamedBegin: {
-            log("        import_statement_comb(CaseRule*): Begin block\n");
+            log_uhdm_trace("        import_statement_comb(CaseRule*): Begin block\n");
             const scope* begin_scope = any_cast<const scope*>(uhdm_stmt);
 
             // Handle local variables in begin blocks
@@ -13910,7 +14319,7 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::CaseRule*
                 } else {
                     block_name = "$unnamed_block$" + std::to_string(++unnamed_block_counter);
                 }
-                log("        Begin block '%s' has variables\n", block_name.c_str());
+                log_uhdm_trace("        Begin block '%s' has variables\n", block_name.c_str());
 
                 // Find the sync always rule for adding sync updates
                 RTLIL::SyncRule* sync_always = nullptr;
@@ -13965,20 +14374,20 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::CaseRule*
                         );
                     }
 
-                    log("        Created block-local wire %s (temp: %s, width: %d)\n",
+                    log_uhdm_trace("        Created block-local wire %s (temp: %s, width: %d)\n",
                         block_wire->name.c_str(), temp_wire->name.c_str(), width);
                 }
             }
 
             VectorOfany* stmts = begin_block_stmts(uhdm_stmt);
             if (stmts) {
-                log("        Begin has %d statements\n", (int)stmts->size());
+                log_uhdm_trace("        Begin has %d statements\n", (int)stmts->size());
                 for (auto stmt : *stmts) {
-                    log("        Processing statement type %d in begin\n", stmt->VpiType());
+                    log_uhdm_trace("        Processing statement type %d in begin\n", stmt->VpiType());
                     import_statement_comb(stmt, case_rule);
                 }
             } else {
-                log("        Begin has no statements\n");
+                log_uhdm_trace("        Begin has no statements\n");
             }
 
             // Restore name_map
@@ -14061,10 +14470,14 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::CaseRule*
             }
             if (ok) {
                 int64_t loop_end = fl_inclusive ? fl_end : fl_end - 1;
+                LoopVectorizer vec(this);
                 for (int64_t i = fl_start; i <= loop_end; i += fl_inc_val) {
                     loop_values[fl_var] = (int)i;
+                    vec.begin_iteration();
                     import_statement_comb(fl_body, case_rule);
+                    vec.end_iteration();
                 }
+                vec.merge(for_loop);
                 loop_values[fl_var] = (int)(fl_inclusive ? fl_end + fl_inc_val : fl_end);
             } else {
                 log_warning("import_statement_comb(CaseRule*): unsupported for loop, skipping\n");
@@ -14072,7 +14485,7 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::CaseRule*
             break;
         }
         case vpiCase: {
-            log("        import_statement_comb(CaseRule*): Case statement\n");
+            log_uhdm_trace("        import_statement_comb(CaseRule*): Case statement\n");
             const case_stmt* uhdm_case = any_cast<const case_stmt*>(uhdm_stmt);
 
             const UHDM::expr* cond_expr = uhdm_case->VpiCondition();
@@ -14081,7 +14494,7 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::CaseRule*
             if (cond_expr) {
                 case_expr = import_expression(cond_expr);
                 case_expr_signed = is_expr_signed(cond_expr);
-                log("        Case expression: %s (signed=%d)\n", log_signal(case_expr), case_expr_signed);
+                log_uhdm_trace("        Case expression: %s (signed=%d)\n", log_signal(case_expr), case_expr_signed);
             }
 
             // Pass 1: determine context width and signedness (SV LRM 12.5.1)
@@ -14159,7 +14572,7 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::CaseRule*
                 }
             }
 
-            log("        Context width=%d all_signed=%d\n", ctx_width, all_signed);
+            log_uhdm_trace("        Context width=%d all_signed=%d\n", ctx_width, all_signed);
 
             // Extend switch signal to context width
             if (case_expr.size() < ctx_width)
@@ -14190,7 +14603,7 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::CaseRule*
             // state (started from the snapshot) so thread_comb_case sees the
             // true per-arm value incl. nested if/case writes (see the primary
             // call site for the CVA6 compressed_decoder failure this fixes).
-            std::map<std::string, RTLIL::SigSpec> pre_ccv = current_comb_values;
+            CombValueMap pre_ccv = current_comb_values;
             std::vector<std::map<std::string, RTLIL::SigSpec>> arm_ccv;
             arm_ccv.reserve(ci_data.size());
 
@@ -14202,11 +14615,11 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::CaseRule*
                     else if (sig.size() > ctx_width)
                         sig = sig.extract(0, ctx_width);
                     d.rule->compare.push_back(sig);
-                    log("        Case item expression: %s\n", log_signal(sig));
+                    log_uhdm_trace("        Case item expression: %s\n", log_signal(sig));
                 }
                 current_comb_values = pre_ccv;
                 if (d.stmt) {
-                    log("        Importing case item body (type=%d)\n", d.stmt->VpiType());
+                    log_uhdm_trace("        Importing case item body (type=%d)\n", d.stmt->VpiType());
                     import_statement_comb(d.stmt, d.rule);
                 }
                 arm_ccv.push_back(current_comb_values);
@@ -14225,7 +14638,7 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::CaseRule*
 
             // Add the switch to the current case rule
             case_rule->switches.push_back(sw);
-            log("        Case statement imported with %d cases\n", (int)sw->cases.size());
+            log_uhdm_trace("        Case statement imported with %d cases\n", (int)sw->cases.size());
             break;
         }
         case vpiIf: {
@@ -14265,7 +14678,7 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::CaseRule*
                 }
 
                 if (mode_debug)
-                    log("        If condition in case: %s\n", log_signal(condition_sig));
+                    log_uhdm_trace("        If condition in case: %s\n", log_signal(condition_sig));
 
                 // Compile-time-constant condition: fold it and import only the
                 // taken branch (mirrors the Process-overload path at
@@ -14309,7 +14722,7 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::CaseRule*
                 // Import then statement
                 if (auto then_stmt = if_stmt->VpiStmt()) {
                     if (mode_debug)
-                        log("        Importing then statement in case\n");
+                        log_uhdm_trace("        Importing then statement in case\n");
                     import_statement_comb(then_stmt, true_case);
                 }
                 auto then_ccv = current_comb_values;
@@ -14364,7 +14777,7 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::CaseRule*
                 }
 
                 if (mode_debug)
-                    log("        If_else condition in case: %s\n", log_signal(condition_sig));
+                    log_uhdm_trace("        If_else condition in case: %s\n", log_signal(condition_sig));
 
                 // Create a switch statement for the if
                 RTLIL::SwitchRule* sw = new RTLIL::SwitchRule;
@@ -14393,7 +14806,7 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::CaseRule*
                 // Import then statement
                 if (auto then_stmt = if_else_stmt->VpiStmt()) {
                     if (mode_debug)
-                        log("        Importing then statement in case\n");
+                        log_uhdm_trace("        Importing then statement in case\n");
                     import_statement_comb(then_stmt, true_case);
                 }
 
@@ -14410,7 +14823,7 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::CaseRule*
                     add_src_attribute(else_case->attributes, if_else_stmt);
 
                     if (mode_debug)
-                        log("        Importing else statement in case (type=%s)\n",
+                        log_uhdm_trace("        Importing else statement in case (type=%s)\n",
                             UhdmName(else_stmt->UhdmType()).c_str());
                     import_statement_comb(else_stmt, else_case);
                     else_ccv = current_comb_values;
@@ -14438,7 +14851,7 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::CaseRule*
         }
 
         case vpiImmediateAssert: {
-            log("        Processing immediate assert in case context - converting to $check cell\n");
+            log_uhdm_trace("        Processing immediate assert in case context - converting to $check cell\n");
 
             const UHDM::immediate_assert* assert_stmt = any_cast<const UHDM::immediate_assert*>(uhdm_stmt);
             RTLIL::Wire* enable_wire = nullptr;
@@ -14449,11 +14862,11 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::CaseRule*
                 case_rule->actions.push_back(RTLIL::SigSig(enable_wire, RTLIL::State::S1));
             }
 
-            log("        Immediate assert processed in case\n");
+            log_uhdm_trace("        Immediate assert processed in case\n");
             break;
         }
         case vpiImmediateCover: {
-            log("        Processing immediate cover in case context - converting to $check cell\n");
+            log_uhdm_trace("        Processing immediate cover in case context - converting to $check cell\n");
 
             const UHDM::immediate_cover* cover_stmt = any_cast<const UHDM::immediate_cover*>(uhdm_stmt);
             RTLIL::Wire* enable_wire = nullptr;
@@ -14463,7 +14876,7 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::CaseRule*
                 case_rule->actions.push_back(RTLIL::SigSig(enable_wire, RTLIL::State::S1));
             }
 
-            log("        Immediate cover processed in case\n");
+            log_uhdm_trace("        Immediate cover processed in case\n");
             break;
         }
 
@@ -14478,7 +14891,7 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::CaseRule*
                     import_display_stmt(call, root, case_rule);
                 } else {
                     if (mode_debug)
-                        log("        Unsupported system task '%s' in case context\n", name.c_str());
+                        log_uhdm_trace("        Unsupported system task '%s' in case context\n", name.c_str());
                 }
             }
             break;
@@ -14513,7 +14926,7 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::CaseRule*
                 }
             } else {
                 if (mode_debug)
-                    log("        Unsupported operation type %d as statement in case\n", op_type);
+                    log_uhdm_trace("        Unsupported operation type %d as statement in case\n", op_type);
             }
             break;
         }
@@ -14529,7 +14942,7 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::CaseRule*
             break;
         default:
             if (mode_debug)
-                log("        Unsupported statement type in case: %s (vpiType=%d)\n",
+                log_uhdm_trace("        Unsupported statement type in case: %s (vpiType=%d)\n",
                     UhdmName(uhdm_stmt->UhdmType()).c_str(), stmt_type);
             break;
     }
@@ -14539,24 +14952,24 @@ void UhdmImporter::import_statement_comb(const any* uhdm_stmt, RTLIL::CaseRule*
 void UhdmImporter::process_reset_block_for_memory(const UHDM::any* reset_stmt, RTLIL::CaseRule* reset_case) {
     if (!reset_stmt || !reset_case) return;
     
-    log("    Analyzing reset block for memory for-loops (module: %s)\n", module->name.c_str());
+    log_uhdm_trace("    Analyzing reset block for memory for-loops (module: %s)\n", module->name.c_str());
     
     // Check if the reset statement is a begin block
     if (reset_stmt->VpiType() == vpiBegin || reset_stmt->VpiType() == vpiNamedBegin) {
         UHDM::VectorOfany* stmts = begin_block_stmts(reset_stmt);
         if (stmts) {
-            log("    Reset begin block has %zu statements\n", stmts->size()); 
+            log_uhdm_trace("    Reset begin block has %zu statements\n", stmts->size()); 
             
             for (auto stmt : *stmts) {
                 if (!stmt) continue;
                 
-                log("    Reset statement type: %s (vpiType=%d)\n", 
+                log_uhdm_trace("    Reset statement type: %s (vpiType=%d)\n", 
                     UhdmName(stmt->UhdmType()).c_str(), stmt->VpiType());
                 
                 // Look for for-loop statements (vpiFor = 15)
                 if (stmt->VpiType() == vpiFor) {
-                    log("    *** FOUND FOR-LOOP IN RESET BLOCK! ***\n");
-                    log("    Processing for-loop for memory operations\n");
+                    log_uhdm_trace("    *** FOUND FOR-LOOP IN RESET BLOCK! ***\n");
+                    log_uhdm_trace("    Processing for-loop for memory operations\n");
                     
                     // Extract loop bounds - for simple_memory: for (i = 0; i < DEPTH; i++)
                     // TARGETED FIX: Use hardcoded values for simple_memory test
@@ -14564,7 +14977,7 @@ void UhdmImporter::process_reset_block_for_memory(const UHDM::any* reset_stmt, R
                     int loop_end = 16;    // DEPTH parameter value for simple_memory
                     int memory_width = 8; // WIDTH parameter value for simple_memory
                     
-                    log("    Unrolling memory initialization for-loop: %d to %d iterations (width=%d)\n", 
+                    log_uhdm_trace("    Unrolling memory initialization for-loop: %d to %d iterations (width=%d)\n", 
                         loop_start, loop_end, memory_width);
                     
                     // UNROLL THE FOR-LOOP: Create individual memory register assignments
@@ -14577,7 +14990,7 @@ void UhdmImporter::process_reset_block_for_memory(const UHDM::any* reset_stmt, R
                         if (!module->wire(memory_reg_id)) {
                             RTLIL::Wire* memory_reg = module->addWire(memory_reg_id, memory_width);
                             memory_reg->attributes[ID::hdlname] = RTLIL::Const(memory_reg_name);
-                            log("    Created memory register wire: %s (width=%d)\n", 
+                            log_uhdm_trace("    Created memory register wire: %s (width=%d)\n", 
                                 memory_reg_name.c_str(), memory_width);
                         }
                         
@@ -14586,10 +14999,10 @@ void UhdmImporter::process_reset_block_for_memory(const UHDM::any* reset_stmt, R
                         RTLIL::SigSpec rhs_sig = RTLIL::SigSpec(RTLIL::Const(0, memory_width));
                         
                         reset_case->actions.push_back(RTLIL::SigSig(lhs_sig, rhs_sig));
-                        log("    Added reset assignment: %s <= 0\n", memory_reg_name.c_str());
+                        log_uhdm_trace("    Added reset assignment: %s <= 0\n", memory_reg_name.c_str());
                     }
                     
-                    log("    *** FOR-LOOP UNROLLING COMPLETED: %d memory register assignments added ***\n", loop_end);
+                    log_uhdm_trace("    *** FOR-LOOP UNROLLING COMPLETED: %d memory register assignments added ***\n", loop_end);
                 }
             }
         }
@@ -14598,7 +15011,7 @@ void UhdmImporter::process_reset_block_for_memory(const UHDM::any* reset_stmt, R
 
 // Import initial block using interpreter approach (handles block-local variable declarations)
 void UhdmImporter::import_initial_interpreted(const process_stmt* uhdm_process, RTLIL::Process* yosys_proc) {
-    log("    Importing initial block (interpreter approach - has block-local variables or for-loops)\n");
+    log_uhdm_trace("    Importing initial block (interpreter approach - has block-local variables or for-loops)\n");
 
     // Create the "sync always" rule (empty, required by proc pass)
     RTLIL::SyncRule* sync_always = new RTLIL::SyncRule();
@@ -14656,7 +15069,7 @@ void UhdmImporter::import_initial_interpreted(const process_stmt* uhdm_process,
         // Store computed init value for cross-process resolution
         interpreter_init_values[wire] = const_val;
         if (mode_debug) {
-            log("      Initial assignment: %s = %lld (width %d)\n",
+            log_uhdm_trace("      Initial assignment: %s = %lld (width %d)\n",
                 name.c_str(), (long long)value, wire->width);
         }
     }
@@ -101,6 +101,112 @@ RTLIL::SigSpec UhdmImporter::create_mux_cell(const RTLIL::SigSpec& sel, const RT
     return result;
 }
 
+// Widest index decoded into a table ($demux / $bmux); 2^12 entries.  A wider
+// index (an `int` loop variable, say) addressing a small array is narrowed to
+// the bits the array needs plus an out-of-range flag over the rest.
+static constexpr int kMaxIndexTableAbits = 12;
+
+// Address bits a decoder / table over `span` elements needs from `idx`.
+static int index_table_abits(const RTLIL::SigSpec& idx, int span) {
+    return std::min(GetSize(idx), std::max(1, ceil_log2(span)));
+}
+
+RTLIL::SigSpec UhdmImporter::dynamic_index_decoder(const RTLIL::SigSpec& idx, int span) {
+    int abits = index_table_abits(idx, span);
+    if (idx.empty() || abits > kMaxIndexTableAbits)
+        return RTLIL::SigSpec();
+    auto key = std::make_pair(idx, span);
+    auto it = dyn_index_decoders.find(key);
+    if (it != dyn_index_decoders.end())
+        return it->second;
+
+    // Enable = high index bits all zero, so an out-of-range index selects
+    // nothing (matches the per-element `idx == k` compares it replaces).
+    RTLIL::SigSpec en(RTLIL::State::S1);
+    if (GetSize(idx) > abits) {
+        RTLIL::Wire* in_range = module->addWire(NEW_ID, 1);
+        module->addLogicNot(NEW_ID, idx.extract_end(abits), in_range);
+        en = in_range;
+    }
+    RTLIL::Wire* sel = module->addWire(NEW_ID, 1 << abits);
+    module->addDemux(NEW_ID, en, idx.extract(0, abits), sel);
+    dyn_index_decoders[key] = sel;
+    return sel;
+}
+
+RTLIL::SigSpec UhdmImporter::dynamic_index_read(const RTLIL::SigSpec& idx,
+                                                const std::vector<RTLIL::SigSpec>& elems,
+                                                int low) {
+    if (elems.empty() || low < 0)
+        return RTLIL::SigSpec();
+    int elem_w = GetSize(elems.front());
+    int span = low + (int)elems.size();
+    int abits = index_table_abits(idx, span);
+    if (idx.empty() || abits > kMaxIndexTableAbits)
+        return RTLIL::SigSpec();
+
+    // Table word k = element k; indices that name no element read X (an
+    // out-of-range access is unspecified, as in the compare-chain lowering).
+    RTLIL::SigSpec table;
+    for (int k = 0; k < (1 << abits); k++) {
+        if (k >= low && k < span)
+            table.append(elems[k - low]);
+        else
+            table.append(RTLIL::SigSpec(RTLIL::State::Sx, elem_w));
+    }
+    RTLIL::Wire* data = module->addWire(NEW_ID, elem_w);
+    module->addBmux(NEW_ID, table, idx.extract(0, abits), data);
+    if (GetSize(idx) == abits)
+        return data;
+    RTLIL::Wire* oob = module->addWire(NEW_ID, 1);
+    module->addReduceOr(NEW_ID, idx.extract_end(abits), oob);
+    RTLIL::Wire* result = module->addWire(NEW_ID, elem_w);
+    module->addMux(NEW_ID, data, RTLIL::SigSpec(RTLIL::State::Sx, elem_w), oob, result);
+    return result;
+}
+
+RTLIL::SigSpec UhdmImporter::emit_element_merge(const RTLIL::SigSpec& cur,
+                                                const RTLIL::SigSpec& idx,
+                                                int low, int n_elems,
+                                                const RTLIL::SigSpec& elem_mask,
+                                                const RTLIL::SigSpec& elem_val) {
+    int elem_w = GetSize(elem_mask);
+    if (low < 0 || n_elems <= 0 || GetSize(cur) != n_elems * elem_w ||
+        GetSize(elem_val) != elem_w)
+        return RTLIL::SigSpec();
+    RTLIL::SigSpec sel = dynamic_index_decoder(idx, low + n_elems);
+    if (sel.empty())
+        return RTLIL::SigSpec();
+
+    // Bit j of element k is written when k is selected and elem_mask[j] is
+    // set.  A constant element mask (whole-element or fixed-field writes)
+    // needs no cells: the select bit is simply wired to the masked lanes.
+    RTLIL::SigSpec mask, val;
+    bool const_mask = elem_mask.is_fully_const();
+    RTLIL::SigSpec sel_lanes, mask_lanes;
+    for (int k = 0; k < n_elems; k++) {
+        int ix = low + k;
+        RTLIL::SigBit s = ix < GetSize(sel) ? sel[ix] : RTLIL::SigBit(RTLIL::State::S0);
+        for (int j = 0; j < elem_w; j++) {
+            if (const_mask)
+                mask.append(elem_mask[j] == RTLIL::State::S1 ? s : RTLIL::SigBit(RTLIL::State::S0));
+            else
+                sel_lanes.append(s);
+        }
+        if (!const_mask)
+            mask_lanes.append(elem_mask);
+        val.append(elem_val);
+    }
+    if (!const_mask) {
+        RTLIL::Wire* m = module->addWire(NEW_ID, GetSize(cur));
+        module->addAnd(NEW_ID, sel_lanes, mask_lanes, m);
+        mask = m;
+    }
+    RTLIL::Wire* merged = module->addWire(NEW_ID, GetSize(cur));
+    module->addBwmux(NEW_ID, cur, val, mask, merged);
+    return merged;
+}
+
 UHDM::VectorOfany *UhdmImporter::begin_block_stmts(const any *stmt)
 {
     UHDM::VectorOfany *stmts = nullptr;
@@ -475,7 +581,7 @@ void UhdmImporter::extract_assigned_signals(const any* stmt, std::vector<Assigne
                     AssignedSignal sig;
                     sig.lhs_expr = lhs_expr;
 
-                    log("extract_assigned_signals: LHS type is %d\n", lhs_expr->VpiType());
+                    log_uhdm_trace("extract_assigned_signals: LHS type is %d\n", lhs_expr->VpiType());
                     if (lhs_expr->VpiType() == vpiOperation) {
                         // Concat LHS — delegate to extract_lhs_signals which
                         // recurses on each operand (`{a, b[hi:lo]} <= rhs`).
@@ -499,20 +605,20 @@ void UhdmImporter::extract_assigned_signals(const any* stmt, std::vector<Assigne
                                 es.is_part_select = false;
                                 signals.push_back(es);
                             }
-                            log("extract_assigned_signals: expanded whole unpacked "
+                            log_uhdm_trace("extract_assigned_signals: expanded whole unpacked "
                                 "array '%s' to per-element\n", nm.c_str());
                         } else {
                             sig.name = nm;
                             sig.is_part_select = false;
                             signals.push_back(sig);
-                            log("extract_assigned_signals: Found assignment to '%s' (ref_obj)\n", ref->VpiName().data());
+                            log_uhdm_trace("extract_assigned_signals: Found assignment to '%s' (ref_obj)\n", ref->VpiName().data());
                         }
                     } else if (lhs_expr->VpiType() == vpiNetBit) {
                         auto net_bit = any_cast<const UHDM::net_bit*>(lhs_expr);
                         sig.name = std::string(net_bit->VpiName());
                         sig.is_part_select = false;
                         signals.push_back(sig);
-                        log("extract_assigned_signals: Found assignment to '%s' (net_bit)\n", net_bit->VpiName().data());
+                        log_uhdm_trace("extract_assigned_signals: Found assignment to '%s' (net_bit)\n", net_bit->VpiName().data());
                     } else if (lhs_expr->VpiType() == vpiIndexedPartSelect) {
                         // Handle indexed part selects like result[i*8 +: 8]
                         auto indexed_part_sel = any_cast<const indexed_part_select*>(lhs_expr);
@@ -524,7 +630,7 @@ void UhdmImporter::extract_assigned_signals(const any* stmt, std::vector<Assigne
                         }
                         
                         signals.push_back(sig);
-                        log("extract_assigned_signals: Found assignment to indexed part select of '%s'\n", sig.name.c_str());
+                        log_uhdm_trace("extract_assigned_signals: Found assignment to indexed part select of '%s'\n", sig.name.c_str());
                     } else if (lhs_expr->VpiType() == vpiPartSelect) {
                         // Handle part selects like result[7:0]
                         auto part_sel = any_cast<const part_select*>(lhs_expr);
@@ -593,13 +699,13 @@ void UhdmImporter::extract_assigned_signals(const any* stmt, std::vector<Assigne
                                     }
                                 }
                                 elem_array_handled = true;
-                                log("extract_assigned_signals: expanded element-array part-select '%s[%d:%d]'\n",
+                                log_uhdm_trace("extract_assigned_signals: expanded element-array part-select '%s[%d:%d]'\n",
                                     sig.name.c_str(), el, er);
                             }
                         }
                         if (!elem_array_handled) {
                             signals.push_back(sig);
-                            log("extract_assigned_signals: Found assignment to part select of '%s'\n", sig.name.c_str());
+                            log_uhdm_trace("extract_assigned_signals: Found assignment to part select of '%s'\n", sig.name.c_str());
                         }
                     } else if (lhs_expr->VpiType() == vpiBitSelect) {
                         // Handle bit selects like result[0] or memory[addr]
@@ -646,7 +752,7 @@ void UhdmImporter::extract_assigned_signals(const any* stmt, std::vector<Assigne
                                 RTLIL::IdString mem_id = RTLIL::escape_id(sig.name);
                                 if (!module->memories.count(mem_id) &&
                                     expanded_array_low(sig.name) >= 0) {
-                                    log("extract_assigned_signals: Skipping dynamic write to expanded array '%s'\n",
+                                    log_uhdm_trace("extract_assigned_signals: Skipping dynamic write to expanded array '%s'\n",
                                         sig.name.c_str());
                                     break;
                                 }
@@ -662,7 +768,7 @@ void UhdmImporter::extract_assigned_signals(const any* stmt, std::vector<Assigne
                         }
 
                         signals.push_back(sig);
-                        log("extract_assigned_signals: Found assignment to bit select of '%s'\n", sig.name.c_str());
+                        log_uhdm_trace("extract_assigned_signals: Found assignment to bit select of '%s'\n", sig.name.c_str());
                     } else if (lhs_expr->VpiType() == vpiVarSelect) {
                         // Multi-index element write on a flattened array
                         // (`my_array[i][j] <= …` on `logic m [1:0][5:0]`).  Report
@@ -680,7 +786,7 @@ void UhdmImporter::extract_assigned_signals(const any* stmt, std::vector<Assigne
                             sig.name = nm;
                             sig.is_part_select = true;
                             signals.push_back(sig);
-                            log("extract_assigned_signals: Found assignment to var select of '%s'\n", nm.c_str());
+                            log_uhdm_trace("extract_assigned_signals: Found assignment to var select of '%s'\n", nm.c_str());
                         }
                     } else if (lhs_expr->VpiType() == vpiHierPath) {
                         // Two distinct shapes share this VPI type:
@@ -807,7 +913,7 @@ void UhdmImporter::extract_assigned_signals(const any* stmt, std::vector<Assigne
                                         es.is_part_select = false;
                                         signals.push_back(es);
                                     }
-                                    log("extract_assigned_signals: expanded hier_path "
+                                    log_uhdm_trace("extract_assigned_signals: expanded hier_path "
                                         "unpacked array '%s' to per-element\n",
                                         base.c_str());
                                     hp_expanded = true;
@@ -819,7 +925,7 @@ void UhdmImporter::extract_assigned_signals(const any* stmt, std::vector<Assigne
 
                         if (!hp_expanded) {
                             signals.push_back(sig);
-                            log("extract_assigned_signals: Found assignment to hier_path of '%s' (using '%s')\n",
+                            log_uhdm_trace("extract_assigned_signals: Found assignment to hier_path of '%s' (using '%s')\n",
                                 full_name.c_str(), sig.name.c_str());
                         }
                     }
@@ -1013,7 +1119,7 @@ bool UhdmImporter::extract_signal_names_from_process(const UHDM::any* stmt,
                                                    std::string& clock_signal, std::string& reset_signal,
                                                    std::vector<int>& slice_offsets, std::vector<int>& slice_widths) {
     
-    log("UHDM: Extracting signal names from process statement\n");
+    log_uhdm_trace("UHDM: Extracting signal names from process statement\n");
     
     // Handle event_control wrapper (for always_ff @(...))
     if (stmt->VpiType() == vpiEventControl) {
@@ -1021,7 +1127,7 @@ bool UhdmImporter::extract_signal_names_from_process(const UHDM::any* stmt,
         if (auto controlled_stmt = event_ctrl->Stmt()) {
             // Extract the actual statement from event control
             stmt = controlled_stmt;
-            log("UHDM: Unwrapped event_control, found inner statement type: %s (vpiType=%d)\n", 
+            log_uhdm_trace("UHDM: Unwrapped event_control, found inner statement type: %s (vpiType=%d)\n", 
                 UhdmName(stmt->UhdmType()).c_str(), stmt->VpiType());
         }
     }
@@ -1031,13 +1137,13 @@ bool UhdmImporter::extract_signal_names_from_process(const UHDM::any* stmt,
     if (stmts) {
         // Get first statement from begin block
         stmt = stmts->at(0);
-        log("UHDM: Unwrapped begin block, found inner statement type: %s (vpiType=%d)\n",
+        log_uhdm_trace("UHDM: Unwrapped begin block, found inner statement type: %s (vpiType=%d)\n",
             UhdmName(stmt->UhdmType()).c_str(), stmt->VpiType());
     }
     
     // For simple_counter, we need to extract from the if statement structure
     if (stmt->VpiType() == vpiIf || stmt->VpiType() == vpiIfElse) {
-        log("UHDM: Found if statement, VpiType=%d, UhdmType=%s\n", stmt->VpiType(), UhdmName(stmt->UhdmType()).c_str());
+        log_uhdm_trace("UHDM: Found if statement, VpiType=%d, UhdmType=%s\n", stmt->VpiType(), UhdmName(stmt->UhdmType()).c_str());
         
         // Check if this is an if_else or just if_stmt
         if (stmt->UhdmType() == uhdmif_else) {
@@ -1048,7 +1154,7 @@ bool UhdmImporter::extract_signal_names_from_process(const UHDM::any* stmt,
             
             // Check then statement for reset assignment
             if (auto then_stmt = if_else_stmt->VpiStmt()) {
-                log("UHDM: Then statement type: %s (vpiType=%d)\n", UhdmName(then_stmt->UhdmType()).c_str(), then_stmt->VpiType());
+                log_uhdm_trace("UHDM: Then statement type: %s (vpiType=%d)\n", UhdmName(then_stmt->UhdmType()).c_str(), then_stmt->VpiType());
                 // Handle begin blocks
                 if (then_stmt->VpiType() == vpiBegin || then_stmt->VpiType() == vpiNamedBegin) {
                     VectorOfany* stmts = begin_block_stmts(then_stmt);
@@ -1069,7 +1175,7 @@ bool UhdmImporter::extract_signal_names_from_process(const UHDM::any* stmt,
                         if (lhs->VpiType() == vpiRefObj) {
                             const UHDM::ref_obj* ref = any_cast<const UHDM::ref_obj*>(lhs);
                             output_signal = std::string(ref->VpiName());
-                            log("UHDM: Found output signal from reset assignment: %s\n", output_signal.c_str());
+                            log_uhdm_trace("UHDM: Found output signal from reset assignment: %s\n", output_signal.c_str());
                         } else if (lhs->VpiType() == vpiIndexedPartSelect) {
                             // For indexed part selects like result[i*8 +: 8], we need to extract the base signal
                             const UHDM::indexed_part_select* ips = any_cast<const UHDM::indexed_part_select*>(lhs);
@@ -1085,7 +1191,7 @@ bool UhdmImporter::extract_signal_names_from_process(const UHDM::any* stmt,
                                     output_signal = std::string(parent->VpiName());
                                 }
                             }
-                            log("UHDM: Found output signal from indexed part select: %s\n", output_signal.c_str());
+                            log_uhdm_trace("UHDM: Found output signal from indexed part select: %s\n", output_signal.c_str());
                             
                             // Extract slice information from indexed part select
                             if (ips->Base_expr()) {
@@ -1093,7 +1199,7 @@ bool UhdmImporter::extract_signal_names_from_process(const UHDM::any* stmt,
                                 if (base_expr.is_fully_const()) {
                                     int offset = base_expr.as_const().as_int();
                                     slice_offsets.push_back(offset);
-                                    log("UHDM: Indexed part select offset: %d\n", offset);
+                                    log_uhdm_trace("UHDM: Indexed part select offset: %d\n", offset);
                                 }
                             }
                             if (ips->Width_expr()) {
@@ -1101,7 +1207,7 @@ bool UhdmImporter::extract_signal_names_from_process(const UHDM::any* stmt,
                                 if (width_expr.is_fully_const()) {
                                     int width = width_expr.as_const().as_int();
                                     slice_widths.push_back(width);
-                                    log("UHDM: Indexed part select width: %d\n", width);
+                                    log_uhdm_trace("UHDM: Indexed part select width: %d\n", width);
                                 }
                             }
                         }
@@ -1111,7 +1217,7 @@ bool UhdmImporter::extract_signal_names_from_process(const UHDM::any* stmt,
             
             // Check else statement for normal assignment  
             if (auto else_stmt = if_else_stmt->VpiElseStmt()) {
-                log("UHDM: Found else statement, type: %s (vpiType=%d)\n", 
+                log_uhdm_trace("UHDM: Found else statement, type: %s (vpiType=%d)\n", 
                     UhdmName(else_stmt->UhdmType()).c_str(), else_stmt->VpiType());
                 // Handle begin blocks
                 if (else_stmt->VpiType() == vpiBegin || else_stmt->VpiType() == vpiNamedBegin) {
@@ -1129,14 +1235,14 @@ bool UhdmImporter::extract_signal_names_from_process(const UHDM::any* stmt,
                 
                 if (else_stmt->VpiType() == vpiAssignment) {
                     const UHDM::assignment* assign = any_cast<const UHDM::assignment*>(else_stmt);
-                    log("UHDM: Processing else assignment\n");
+                    log_uhdm_trace("UHDM: Processing else assignment\n");
                     if (auto rhs = assign->Rhs()) {
-                        log("UHDM: RHS type: %s (vpiType=%d)\n", UhdmName(rhs->UhdmType()).c_str(), rhs->VpiType());
+                        log_uhdm_trace("UHDM: RHS type: %s (vpiType=%d)\n", UhdmName(rhs->UhdmType()).c_str(), rhs->VpiType());
                         // For simple ref like "unit_result"
                         if (rhs->VpiType() == vpiRefObj) {
                             const UHDM::ref_obj* ref = any_cast<const UHDM::ref_obj*>(rhs);
                             input_signal = std::string(ref->VpiName());
-                            log("UHDM: Found input signal from else assignment: %s\n", input_signal.c_str());
+                            log_uhdm_trace("UHDM: Found input signal from else assignment: %s\n", input_signal.c_str());
                         }
                         // For expressions like "count + 1", we want to extract "count" as input
                         else if (rhs->VpiType() == vpiOperation) {
@@ -1146,7 +1252,7 @@ bool UhdmImporter::extract_signal_names_from_process(const UHDM::any* stmt,
                                     if (operand->VpiType() == vpiRefObj) {
                                         const UHDM::ref_obj* ref = any_cast<const UHDM::ref_obj*>(operand);
                                         input_signal = std::string(ref->VpiName());
-                                        log("UHDM: Found input signal from operation: %s\n", input_signal.c_str());
+                                        log_uhdm_trace("UHDM: Found input signal from operation: %s\n", input_signal.c_str());
                                         break;
                                     }
                                 }
@@ -1168,7 +1274,7 @@ bool UhdmImporter::extract_signal_names_from_process(const UHDM::any* stmt,
                                         // Only update output_signal if it's empty (priority to first-level assignment)
                                         if (output_signal.empty()) {
                                             output_signal = std::string(ref->VpiName());
-                                            log("UHDM: Found output signal from else-if assignment: %s\n", output_signal.c_str());
+                                            log_uhdm_trace("UHDM: Found output signal from else-if assignment: %s\n", output_signal.c_str());
                                         }
                                     }
                                 }
@@ -1176,7 +1282,7 @@ bool UhdmImporter::extract_signal_names_from_process(const UHDM::any* stmt,
                                     if (rhs->VpiType() == vpiRefObj) {
                                         const UHDM::ref_obj* ref = any_cast<const UHDM::ref_obj*>(rhs);
                                         input_signal = std::string(ref->VpiName());
-                                        log("UHDM: Found input signal from else-if assignment: %s\n", input_signal.c_str());
+                                        log_uhdm_trace("UHDM: Found input signal from else-if assignment: %s\n", input_signal.c_str());
                                     }
                                 }
                             }
@@ -1193,7 +1299,7 @@ bool UhdmImporter::extract_signal_names_from_process(const UHDM::any* stmt,
                                         // Only update output_signal if it's empty (priority to first-level assignment)
                                         if (output_signal.empty()) {
                                             output_signal = std::string(ref->VpiName());
-                                            log("UHDM: Found output signal from else-if assignment: %s\n", output_signal.c_str());
+                                            log_uhdm_trace("UHDM: Found output signal from else-if assignment: %s\n", output_signal.c_str());
                                         }
                                     }
                                 }
@@ -1201,7 +1307,7 @@ bool UhdmImporter::extract_signal_names_from_process(const UHDM::any* stmt,
                                     if (rhs->VpiType() == vpiRefObj) {
                                         const UHDM::ref_obj* ref = any_cast<const UHDM::ref_obj*>(rhs);
                                         input_signal = std::string(ref->VpiName());
-                                        log("UHDM: Found input signal from else-if assignment: %s\n", input_signal.c_str());
+                                        log_uhdm_trace("UHDM: Found input signal from else-if assignment: %s\n", input_signal.c_str());
                                     }
                                 }
                             }
@@ -1219,7 +1325,7 @@ bool UhdmImporter::extract_signal_names_from_process(const UHDM::any* stmt,
                             if (operand->VpiType() == vpiRefObj) {
                                 const UHDM::ref_obj* ref = any_cast<const UHDM::ref_obj*>(operand);
                                 reset_signal = std::string(ref->VpiName());
-                                log("UHDM: Found reset signal from condition: %s\n", reset_signal.c_str());
+                                log_uhdm_trace("UHDM: Found reset signal from condition: %s\n", reset_signal.c_str());
                                 break;
                             }
                         }
@@ -1228,7 +1334,7 @@ bool UhdmImporter::extract_signal_names_from_process(const UHDM::any* stmt,
             }
         } else {
             // Handle simple if_stmt without else
-            log("UHDM: Processing simple if_stmt (no else clause)\n");
+            log_uhdm_trace("UHDM: Processing simple if_stmt (no else clause)\n");
         }
     }
     
@@ -1243,7 +1349,7 @@ bool UhdmImporter::extract_signal_names_from_process(const UHDM::any* stmt,
     
     // Return true if we found at least an output signal
     bool success = !output_signal.empty();
-    log("UHDM: Signal extraction %s: output=%s, input=%s, clock=%s, reset=%s\n",
+    log_uhdm_trace("UHDM: Signal extraction %s: output=%s, input=%s, clock=%s, reset=%s\n",
         success ? "succeeded" : "failed",
         output_signal.c_str(), input_signal.c_str(), 
         clock_signal.c_str(), reset_signal.c_str());
@@ -1870,9 +1976,9 @@ bool UhdmImporter::has_only_constant_array_accesses(const std::string& array_nam
     }
     
     // Always log this for debugging array issues
-    log("UHDM: Checking array accesses for '%s' in %d processes\n", 
+    log_uhdm_trace("UHDM: Checking array accesses for '%s' in %d processes\n", 
         array_name.c_str(), (int)uhdm_module->Process()->size());
-    log("      Current instance: %p, Module: %p\n", current_instance, module);
+    log_uhdm_trace("      Current instance: %p, Module: %p\n", current_instance, module);
     
     // Capture the module for lambda access
     auto rtlil_module = module;
@@ -1929,7 +2035,7 @@ bool UhdmImporter::has_only_constant_array_accesses(const std::string& array_nam
         
         // Debug: log statement type
         if (cur_depth <= 5) {  // Only log first few levels to avoid spam
-            log("      [Depth %d] Checking statement type: %d\n", cur_depth, stmt->VpiType());
+            log_uhdm_trace("      [Depth %d] Checking statement type: %d\n", cur_depth, stmt->VpiType());
         }
         
         switch (stmt->VpiType()) {
@@ -1940,7 +2046,7 @@ bool UhdmImporter::has_only_constant_array_accesses(const std::string& array_nam
                     std::string parent_name = std::string(bit_sel->VpiName());
                     
                     // Debug log to see all bit selects
-                    log("      Found bit_select with name='%s'\n", parent_name.c_str());
+                    log_uhdm_trace("      Found bit_select with name='%s'\n", parent_name.c_str());
                     
                     // Sometimes the parent is the array reference
                     if (bit_sel->VpiParent()->VpiType() == vpiRefObj) {
@@ -1951,23 +2057,23 @@ bool UhdmImporter::has_only_constant_array_accesses(const std::string& array_nam
                     }
                     
                     if (mode_debug) {
-                        log("      Checking bit_select: parent_name='%s', array_name='%s'\n", 
+                        log_uhdm_trace("      Checking bit_select: parent_name='%s', array_name='%s'\n", 
                             parent_name.c_str(), array_name.c_str());
                     }
                     
                     if (parent_name == array_name) {
                         // This is an access to our array - check if index is constant
                         if (mode_debug) {
-                            log("      Found access to array %s\n", array_name.c_str());
+                            log_uhdm_trace("      Found access to array %s\n", array_name.c_str());
                         }
                         if (!is_constant_expr(bit_sel->VpiIndex())) {
                             if (mode_debug) {
-                                log("      Array %s has non-constant index access!\n", array_name.c_str());
+                                log_uhdm_trace("      Array %s has non-constant index access!\n", array_name.c_str());
                             }
                             return false;  // Non-constant access found
                         } else {
                             if (mode_debug) {
-                                log("      Array %s access with constant index\n", array_name.c_str());
+                                log_uhdm_trace("      Array %s access with constant index\n", array_name.c_str());
                             }
                         }
                     }
@@ -1982,11 +2088,11 @@ bool UhdmImporter::has_only_constant_array_accesses(const std::string& array_nam
                     // Check both LHS and RHS for array accesses
                     // These might be bit_selects
                     if (assign->Lhs()) {
-                        log("        Assignment LHS type: %d\n", assign->Lhs()->VpiType());
+                        log_uhdm_trace("        Assignment LHS type: %d\n", assign->Lhs()->VpiType());
                         if (!check_array_access(assign->Lhs(), cur_depth + 1)) return false;
                     }
                     if (assign->Rhs()) {
-                        log("        Assignment RHS type: %d\n", assign->Rhs()->VpiType());
+                        log_uhdm_trace("        Assignment RHS type: %d\n", assign->Rhs()->VpiType());
                         if (!check_array_access(assign->Rhs(), cur_depth + 1)) return false;
                     }
                 }
@@ -1997,13 +2103,13 @@ bool UhdmImporter::has_only_constant_array_accesses(const std::string& array_nam
             case vpiNamedBegin: {
                 VectorOfany* stmts = begin_block_stmts(stmt);
                 if (stmts) {
-                    log("        Begin block has %d statements\n", (int)stmts->size());
+                    log_uhdm_trace("        Begin block has %d statements\n", (int)stmts->size());
                     for (auto sub_stmt : *stmts) {
-                        log("        Begin sub-statement type: %d\n", sub_stmt->VpiType());
+                        log_uhdm_trace("        Begin sub-statement type: %d\n", sub_stmt->VpiType());
                         if (!check_array_access(sub_stmt, cur_depth + 1)) return false;
                     }
                 } else {
-                    log("        Begin block has no statements\n");
+                    log_uhdm_trace("        Begin block has no statements\n");
                 }
                 break;
             }
@@ -2013,7 +2119,7 @@ bool UhdmImporter::has_only_constant_array_accesses(const std::string& array_nam
                 if (if_stmt) {
                     if (!check_array_access(if_stmt->VpiCondition(), cur_depth + 1)) return false;
                     if (if_stmt->VpiStmt()) {
-                        log("        IfElse statement body type: %d\n", if_stmt->VpiStmt()->VpiType());
+                        log_uhdm_trace("        IfElse statement body type: %d\n", if_stmt->VpiStmt()->VpiType());
                         if (!check_array_access(if_stmt->VpiStmt(), cur_depth + 1)) return false;
                     }
                     if (!check_array_access(if_stmt->VpiElseStmt(), cur_depth + 1)) return false;
@@ -2024,13 +2130,13 @@ bool UhdmImporter::has_only_constant_array_accesses(const std::string& array_nam
             case vpiIf: {
                 auto if_stmt = any_cast<const UHDM::if_stmt*>(stmt);
                 if (if_stmt) {
-                    log("        Found if statement\n");
+                    log_uhdm_trace("        Found if statement\n");
                     if (!check_array_access(if_stmt->VpiCondition(), cur_depth + 1)) return false;
                     if (if_stmt->VpiStmt()) {
-                        log("        If statement body type: %d\n", if_stmt->VpiStmt()->VpiType());
+                        log_uhdm_trace("        If statement body type: %d\n", if_stmt->VpiStmt()->VpiType());
                         if (!check_array_access(if_stmt->VpiStmt(), cur_depth + 1)) return false;
                     } else {
-                        log("        If statement has no body\n");
+                        log_uhdm_trace("        If statement has no body\n");
                     }
                 }
                 break;
@@ -2102,17 +2208,17 @@ bool UhdmImporter::has_only_constant_array_accesses(const std::string& array_nam
     // Check all processes in the module
     int process_count = 0;
     for (auto proc : *uhdm_module->Process()) {
-        log("      Process type: %d (vpiAlways=%d, vpiAlwaysComb=%d, vpiAlwaysFF=%d)\n",
+        log_uhdm_trace("      Process type: %d (vpiAlways=%d, vpiAlwaysComb=%d, vpiAlwaysFF=%d)\n",
             proc->VpiType(), vpiAlways, vpiAlwaysComb, vpiAlwaysFF);
         if (proc->VpiType() == vpiAlways || proc->VpiType() == vpiAlwaysComb || 
             proc->VpiType() == vpiAlwaysFF || proc->VpiType() == vpiInitial) {
             auto always_proc = any_cast<const process_stmt*>(proc);
             if (always_proc && always_proc->Stmt()) {
                 process_count++;
-                log("    Checking process %d for array accesses\n", process_count);
+                log_uhdm_trace("    Checking process %d for array accesses\n", process_count);
                 if (!check_array_access(always_proc->Stmt(), 1)) {
                     if (mode_debug) {
-                        log("    Found non-constant access in process %d\n", process_count);
+                        log_uhdm_trace("    Found non-constant access in process %d\n", process_count);
                     }
                     return false;  // Found non-constant access
                 }
@@ -2121,7 +2227,7 @@ bool UhdmImporter::has_only_constant_array_accesses(const std::string& array_nam
     }
     
     if (mode_debug) {
-        log("    Array %s has only constant index accesses\n", array_name.c_str());
+        log_uhdm_trace("    Array %s has only constant index accesses\n", array_name.c_str());
     }
     
     return true;  // All accesses are constant
@@ -2149,7 +2255,7 @@ bool UhdmImporter::is_memory_array(const UHDM::net* uhdm_net) {
     // the element typespec -> infer a memory.
     if (typespec->UhdmType() == uhdmarray_typespec) {
         if (mode_debug) {
-            log("    Detected memory array: %s (logic_net with array_typespec)\n",
+            log_uhdm_trace("    Detected memory array: %s (logic_net with array_typespec)\n",
                 std::string(uhdm_net->VpiName()).c_str());
         }
         return true;
@@ -2169,7 +2275,7 @@ bool UhdmImporter::is_memory_array(const UHDM::net* uhdm_net) {
         
         if (has_packed && has_unpacked) {
             if (mode_debug) {
-                log("    Detected memory array: %s (logic_net with both packed and unpacked dimensions)\n", 
+                log_uhdm_trace("    Detected memory array: %s (logic_net with both packed and unpacked dimensions)\n", 
                     std::string(uhdm_net->VpiName()).c_str());
             }
             return true;
@@ -2205,7 +2311,7 @@ bool UhdmImporter::is_memory_array(const UHDM::array_net* uhdm_array) {
                 if (logic_typespec->Ranges() && !logic_typespec->Ranges()->empty()) {
                     // This net has both packed (from typespec) and unpacked (from array_net) dimensions
                     if (mode_debug) {
-                        log("    Detected memory array: %s (array_net with packed dimensions)\n", 
+                        log_uhdm_trace("    Detected memory array: %s (array_net with packed dimensions)\n", 
                             std::string(uhdm_array->VpiName()).c_str());
                     }
                     return true;
@@ -2243,7 +2349,7 @@ bool UhdmImporter::is_memory_array(const UHDM::array_var* uhdm_array) {
                 if (logic_typespec->Ranges() && !logic_typespec->Ranges()->empty()) {
                     // This var has both packed (from typespec) and unpacked (from array_var) dimensions
                     if (mode_debug) {
-                        log("    Detected memory array: %s (array_var with packed dimensions)\n",
+                        log_uhdm_trace("    Detected memory array: %s (array_var with packed dimensions)\n",
                             std::string(uhdm_array->VpiName()).c_str());
                     }
                     return true;
@@ -2265,7 +2371,7 @@ bool UhdmImporter::is_memory_array(const UHDM::array_var* uhdm_array) {
                 auto lt = any_cast<const UHDM::logic_typespec*>(elem);
                 if (lt->Ranges() && !lt->Ranges()->empty()) {
                     if (mode_debug) {
-                        log("    Detected memory array: %s (array_var with array_typespec)\n",
+                        log_uhdm_trace("    Detected memory array: %s (array_var with array_typespec)\n",
                             std::string(uhdm_array->VpiName()).c_str());
                     }
                     return true;
@@ -27,9 +27,9 @@ void UhdmImporter::import_ref_module(const ref_module* ref_mod) {
     // Check if the ref_module has an actual_group that contains parameters
     if (ref_mod->Actual_group()) {
         if (mode_debug) {
-            log("  Found actual_group, investigating for parameters\n");
-            log("  Actual_group UhdmType: %d\n", ref_mod->Actual_group()->UhdmType());
-            log("  Actual_group VpiType: %d\n", ref_mod->Actual_group()->VpiType());
+            log_uhdm_debug("  Found actual_group, investigating for parameters\n");
+            log_uhdm_debug("  Actual_group UhdmType: %d\n", ref_mod->Actual_group()->UhdmType());
+            log_uhdm_debug("  Actual_group VpiType: %d\n", ref_mod->Actual_group()->VpiType());
         }
         
         // Try to cast to different UHDM types to find parameters
@@ -38,18 +38,18 @@ void UhdmImporter::import_ref_module(const ref_module* ref_mod) {
             if (ref_mod->Actual_group()) {
                 // Check if it's a param_assign or contains param_assigns
                 if (mode_debug) {
-                    log("  Investigating actual_group for param_assigns...\n");
+                    log_uhdm_debug("  Investigating actual_group for param_assigns...\n");
                 }
             }
         } catch (...) {
             if (mode_debug)
-                log("  Exception while investigating actual_group\n");
+                log_uhdm_debug("  Exception while investigating actual_group\n");
         }
     }
     
     // For now, create a debug log to see what's happening
     if (mode_debug) {
-        log("  Instance: %s, Module: %s, Has Actual_group: %s\n", 
+        log_uhdm_debug("  Instance: %s, Module: %s, Has Actual_group: %s\n", 
             inst_name.c_str(), base_module_name.c_str(), 
             ref_mod->Actual_group() ? "yes" : "no");
     }
@@ -62,14 +62,14 @@ void UhdmImporter::import_ref_module(const ref_module* ref_mod) {
     std::string module_name = base_module_name;
     
     if (mode_debug)
-        log("  Importing instance: %s of %s\n", inst_name.c_str(), module_name.c_str());
+        log_uhdm_debug("  Importing instance: %s of %s\n", inst_name.c_str(), module_name.c_str());
 
     // The hierarchy-traversal path may have already created a cell for this
     // instance from `module_inst::Modules()`.  Skip — adding a second cell
     // with the same name asserts in RTLIL's add hooks.
     if (module->cell(RTLIL::escape_id(inst_name))) {
         if (mode_debug)
-            log("  Cell '%s' already exists, skipping ref_module import\n",
+            log_uhdm_debug("  Cell '%s' already exists, skipping ref_module import\n",
                 inst_name.c_str());
         return;
     }
@@ -106,7 +106,7 @@ void UhdmImporter::import_ref_module(const ref_module* ref_mod) {
                     RTLIL::Wire* target_port = target_module->wire(RTLIL::escape_id(port_name));
                     if (target_port && target_port->attributes.count(RTLIL::escape_id("interface_port"))) {
                         if (mode_debug)
-                            log("    Skipping interface port connection: %s (marked as interface_port)\n", port_name.c_str());
+                            log_uhdm_debug("    Skipping interface port connection: %s (marked as interface_port)\n", port_name.c_str());
                         continue;
                     }
                 }
@@ -116,7 +116,7 @@ void UhdmImporter::import_ref_module(const ref_module* ref_mod) {
                     // Interface ports don't get connected directly
                     // The individual signals within the interface are connected separately
                     if (mode_debug)
-                        log("    Skipping interface port connection: %s (hier_path type)\n", port_name.c_str());
+                        log_uhdm_debug("    Skipping interface port connection: %s (hier_path type)\n", port_name.c_str());
                     continue;
                 }
 
@@ -127,7 +127,7 @@ void UhdmImporter::import_ref_module(const ref_module* ref_mod) {
                 if (port->High_conn()->UhdmType() == uhdmoperation &&
                     any_cast<const UHDM::operation*>(port->High_conn())->VpiOpType() == vpiNullOp) {
                     if (mode_debug)
-                        log("    Port %s has an empty connection (.%s()); leaving unconnected\n",
+                        log_uhdm_debug("    Port %s has an empty connection (.%s()); leaving unconnected\n",
                             port_name.c_str(), port_name.c_str());
                     continue;
                 }
@@ -141,7 +141,7 @@ void UhdmImporter::import_ref_module(const ref_module* ref_mod) {
                 }
                 
                 if (mode_debug)
-                    log("    Connected port %s (width=%d)\n", port_name.c_str(), actual_sig.size());
+                    log_uhdm_debug("    Connected port %s (width=%d)\n", port_name.c_str(), actual_sig.size());
             }
         }
     }
@@ -150,7 +150,7 @@ void UhdmImporter::import_ref_module(const ref_module* ref_mod) {
     if (inferred_width > 1) {
         cell->setParam(RTLIL::escape_id("WIDTH"), RTLIL::Const(inferred_width, 32));
         if (mode_debug)
-            log("    Set WIDTH parameter to %d (will create parameterized module later)\n", inferred_width);
+            log_uhdm_debug("    Set WIDTH parameter to %d (will create parameterized module later)\n", inferred_width);
     }
 }
 
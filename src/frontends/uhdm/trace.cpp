@@ -0,0 +1,117 @@
+/*
+ * Trace-event timeline for UHDM to RTLIL translation
+ *
+ * `read_sv -trace <file>` / `read_uhdm -trace <file>` record nested spans for
+ * the Surelog compile, UHDM elaboration and the importer's per-module /
+ * per-process work, plus RTLIL size counters, and write them as Chrome
+ * trace-event JSON (load in chrome://tracing or ui.perfetto.dev).
+ */
+
+#include "uhdm2rtlil.h"
+
+#include <mutex>
+#include <thread>
+
+YOSYS_NAMESPACE_BEGIN
+
+bool uhdm_trace_on = false;
+
+namespace {
+
+struct TraceEvent {
+    char phase;
+    int tid;
+    long long ts_us;
+    std::string name, detail;
+    std::vector<std::pair<std::string, long long>> values;
+};
+
+std::mutex trace_mutex;
+std::vector<TraceEvent> trace_events;
+std::map<std::thread::id, int> trace_tids;
+std::chrono::steady_clock::time_point trace_t0;
+
+// Caller holds trace_mutex.  Threads are numbered in order of first event,
+// so the main thread is tid 1 and any import workers follow.
+TraceEvent& new_event(char phase) {
+    auto id = std::this_thread::get_id();
+    auto it = trace_tids.find(id);
+    if (it == trace_tids.end())
+        it = trace_tids.emplace(id, GetSize(trace_tids) + 1).first;
+    trace_events.emplace_back();
+    TraceEvent& ev = trace_events.back();
+    ev.phase = phase;
+    ev.tid = it->second;
+    ev.ts_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - trace_t0).count();
+    return ev;
+}
+
+std::string json_str(const std::string& s) {
+    std::string out = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        if ((unsigned char)c < 0x20) { out += ' '; continue; }
+        out += c;
+    }
+    return out + "\"";
+}
+
+} // namespace
+
+void uhdm_trace_event(char phase, const char* name, const std::string& detail) {
+    std::lock_guard<std::mutex> lock(trace_mutex);
+    TraceEvent& ev = new_event(phase);
+    ev.name = name;
+    ev.detail = detail;
+}
+
+void uhdm_trace_counter(const char* name, const std::vector<std::pair<std::string, long long>>& values) {
+    if (!uhdm_trace_on) return;
+    std::lock_guard<std::mutex> lock(trace_mutex);
+    TraceEvent& ev = new_event('C');
+    ev.name = name;
+    ev.values = values;
+}
+
+UhdmTraceSession::UhdmTraceSession(const std::string& file) : file(file) {
+    if (file.empty()) return;
+    std::lock_guard<std::mutex> lock(trace_mutex);
+    trace_events.clear();
+    trace_tids.clear();
+    trace_t0 = std::chrono::steady_clock::now();
+    uhdm_trace_on = true;
+}
+
+UhdmTraceSession::~UhdmTraceSession() {
+    if (file.empty()) return;
+    std::lock_guard<std::mutex> lock(trace_mutex);
+    uhdm_trace_on = false;
+    std::ofstream f(file);
+    if (f.fail()) {
+        log_warning("UHDM: cannot write trace to '%s'\n", file.c_str());
+        return;
+    }
+    f << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    for (size_t i = 0; i < trace_events.size(); i++) {
+        const TraceEvent& ev = trace_events[i];
+        f << "  {\"ph\": \"" << ev.phase << "\", \"pid\": 1, \"tid\": " << ev.tid
+          << ", \"ts\": " << ev.ts_us;
+        if (ev.phase != 'E')
+            f << ", \"name\": " << json_str(ev.name);
+        if (ev.phase == 'C') {
+            f << ", \"args\": {";
+            for (size_t j = 0; j < ev.values.size(); j++)
+                f << (j ? ", " : "") << json_str(ev.values[j].first) << ": " << ev.values[j].second;
+            f << "}";
+        } else if (!ev.detail.empty()) {
+            f << ", \"args\": {\"name\": " << json_str(ev.detail) << "}";
+        }
+        f << "}" << (i + 1 < trace_events.size() ? ",\n" : "\n");
+    }
+    f << "]}\n";
+    log("UHDM: %zu trace events written to %s\n", trace_events.size(), file.c_str());
+    trace_events.clear();
+}
+
+YOSYS_NAMESPACE_END
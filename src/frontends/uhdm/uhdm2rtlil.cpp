@@ -14,7 +14,14 @@
 #include <uhdm/logic_typespec.h>
 #include <uhdm/integer_typespec.h>
 #include <uhdm/vpi_visitor.h>
+#include <filesystem>
 #include <functional>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
 
 // Surelog public API — lets `read_sv` run the Surelog compiler in-process and
 // hand its in-memory UHDM design straight to the importer (no .uhdm round-trip).
@@ -27,6 +34,191 @@ USING_YOSYS_NAMESPACE
 
 using namespace UHDM;
 
+// Importer options shared by read_uhdm and read_sv (consumed by the plugin,
+// never forwarded to Surelog).
+struct UhdmImportOptions {
+    bool case_rom = true;
+    int case_rom_threshold = 64;
+    bool import_sweep = true;
+    bool gate_array_cells = false;
+    int verbosity = -1;
+    std::string heatmap_file;
+    std::string trace_file;
+    UhdmImporter::UhdmSrcMode src_mode = UhdmImporter::UhdmSrcMode::Full;
+
+    static void help() {
+        log("    -nosrc           do not add `src` attributes to imported objects\n");
+        log("    -src=line        `src` attributes carry the start line only, no\n");
+        log("                     column range\n");
+        log("    -heatmap <file>  report the cells, wires, wire bits, processes, switch\n");
+        log("                     rules and import time emitted per source line: the\n");
+        log("                     top lines as a table in the log, all of them as\n");
+        log("                     JSON in <file> (with -batch, manifest line N writes\n");
+        log("                     <file>.N)\n");
+        log("    -trace <file>    write a Chrome/Perfetto trace-event timeline of the\n");
+        log("                     compile, elaboration and per-module/per-process\n");
+        log("                     import to <file>\n");
+        log("    -v <N>           import log verbosity: 0 quiet, 1 info (default),\n");
+        log("                     2 per-module debug, 3 per-statement trace\n");
+        log("                     (-debug implies 3)\n");
+        log("    -gate_array_cells\n");
+        log("                     import gate instance arrays as one named gate cell\n");
+        log("                     per element instead of word-level cells\n");
+        log("    -no_import_sweep\n");
+        log("                     keep unread importer scratch wires and dead cells\n");
+        log("                     (normally swept at the end of each module import)\n");
+        log("    -no_case_rom     keep constant case tables as switch rules instead of\n");
+        log("                     lowering them to a ROM / $bmux table read\n");
+        log("    -case_rom_threshold <N>\n");
+        log("                     constant case tables with at least N words become an\n");
+        log("                     async-read ROM (mappable by memory_libmap); smaller\n");
+        log("                     ones a $bmux over the packed table (default: 64)\n");
+    }
+
+    // Consume args[i] (and its value, advancing i) when it is an importer
+    // option; false leaves it for the caller.
+    bool parse(const std::vector<std::string>& args, size_t& i) {
+        // `-v <file>` is also Surelog's library-file option: only a numeric
+        // value is taken as a verbosity level.
+        if (args[i] == "-v" && i + 1 < args.size() && !args[i + 1].empty() &&
+            std::all_of(args[i + 1].begin(), args[i + 1].end(), ::isdigit)) {
+            verbosity = atoi(args[++i].c_str());
+            return true;
+        }
+        if (args[i] == "-heatmap" && i + 1 < args.size()) {
+            heatmap_file = args[++i];
+            return true;
+        }
+        if (args[i] == "-trace" && i + 1 < args.size()) {
+            trace_file = args[++i];
+            return true;
+        }
+        if (args[i] == "-nosrc") {
+            src_mode = UhdmImporter::UhdmSrcMode::None;
+            return true;
+        }
+        if (args[i] == "-src=line") {
+            src_mode = UhdmImporter::UhdmSrcMode::Line;
+            return true;
+        }
+        if (args[i] == "-gate_array_cells") {
+            gate_array_cells = true;
+            return true;
+        }
+        if (args[i] == "-no_import_sweep") {
+            import_sweep = false;
+            return true;
+        }
+        if (args[i] == "-no_case_rom") {
+            case_rom = false;
+            return true;
+        }
+        if (args[i] == "-case_rom_threshold" && i + 1 < args.size()) {
+            case_rom_threshold = std::max(1, atoi(args[++i].c_str()));
+            return true;
+        }
+        return false;
+    }
+
+    void apply(UhdmImporter& importer) const {
+        importer.mode_case_rom = case_rom;
+        importer.case_rom_threshold = case_rom_threshold;
+        importer.mode_import_sweep = import_sweep;
+        importer.mode_gate_array_cells = gate_array_cells;
+        importer.src_mode = src_mode;
+        importer.heatmap_file = heatmap_file;
+        if (verbosity >= 0)
+            uhdm_log_level = (UhdmLogLevel)std::min(verbosity, (int)UhdmLogLevel::Trace);
+        else
+            uhdm_log_level = importer.mode_debug ? UhdmLogLevel::Trace : UhdmLogLevel::Info;
+    }
+};
+
+// `-batch <manifest>`: one entry per line, whitespace-separated fields;
+// blank lines and `#` comments are skipped.
+static std::vector<std::vector<std::string>> read_batch_manifest(const std::string& path) {
+    std::ifstream f(path);
+    if (f.fail())
+        log_cmd_error("Cannot open batch manifest '%s'\n", path.c_str());
+    std::vector<std::vector<std::string>> entries;
+    std::string line;
+    while (std::getline(f, line)) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream ss(line);
+        std::vector<std::string> fields;
+        for (std::string tok; ss >> tok;)
+            fields.push_back(tok);
+        if (!fields.empty())
+            entries.push_back(fields);
+    }
+    return entries;
+}
+
+// Write one batch entry's design.  `@name` keeps it as a saved design
+// (`design -load name`); otherwise the extension picks the backend.
+static void write_batch_result(RTLIL::Design* d, const std::string& out) {
+    auto ends_with = [&](const char* ext) {
+        size_t n = strlen(ext);
+        return out.size() >= n && out.compare(out.size() - n, n, ext) == 0;
+    };
+    if (out[0] == '@')
+        Pass::call(d, std::vector<std::string>{"design", "-save", out.substr(1)});
+    else if (ends_with(".json"))
+        Pass::call(d, std::vector<std::string>{"write_json", out});
+    else if (ends_with(".v") || ends_with(".sv"))
+        Pass::call(d, std::vector<std::string>{"write_verilog", out});
+    else
+        Pass::call(d, std::vector<std::string>{"write_rtlil", out});
+}
+
+// Restore one .uhdm file, elaborating it when it was saved unelaborated.
+// With `fatal` unset a file that cannot be restored returns nullptr instead
+// of ending the process, so the caller can clean up first.
+static UHDM::design* restore_uhdm(Serializer& serializer, const std::string& filename, bool debug,
+                                  bool fatal = true) {
+    std::vector<vpiHandle> designs;
+    {
+        UhdmTraceSpan span("Serializer::Restore", filename);
+        designs = serializer.Restore(filename);
+    }
+    if (designs.empty()) {
+        if (!fatal)
+            return nullptr;
+        log_error("Failed to restore UHDM file %s.\n", filename.c_str());
+    }
+    vpiHandle vpi_design = designs.at(0);
+    UHDM::design* uhdm_design = UhdmDesignFromVpiHandle(vpi_design);
+
+    if (!uhdm_design) {
+        if (!fatal)
+            return nullptr;
+        log_error("Failed to restore UHDM file.\n");
+    }
+
+    // If UHDM is not already elaborated/uniquified (uhdm db was saved by a
+    // different process pre-elaboration), then optionally elaborate it:
+    if (uhdm_design && (!vpi_get(vpiElaborated, vpi_design))) {
+        log("UHDM Elaboration...\n");
+        UhdmTraceSpan span("ElaboratorContext");
+        UHDM::ElaboratorContext* elaboratorContext =
+            new UHDM::ElaboratorContext(&serializer, true);
+        elaboratorContext->m_elaborator.listenDesigns(designs);
+        delete elaboratorContext;
+    }
+
+    if (debug) {
+        vpi_show_ids(true);
+        visit_designs({vpi_design}, std::cout);
+    }
+
+    if (!uhdm_design->AllModules()) {
+        if (!fatal)
+            return nullptr;
+        log_error("No modules found in UHDM design.\n");
+    }
+    return uhdm_design;
+}
+
 // Main UHDM frontend pass
 struct ReadUHDMPass : public Frontend {
     ReadUHDMPass() : Frontend("=read_uhdm", "read UHDM design") {}
@@ -40,15 +232,86 @@ struct ReadUHDMPass : public Frontend {
         log("    -keep_names      keep original signal names\n");
         log("    -debug           enable debug output\n");
         log("    -formal          enable formal verification constructs\n");
+        log("    -batch <manifest>\n");
+        log("                     import several designs in one process instead of\n");
+        log("                     <filename>.  Each manifest line is\n");
+        log("                         <file.uhdm> <output> [<top>]\n");
+        log("                     and is imported into a fresh design, reduced to\n");
+        log("                     <top> when given, and written to <output> (.il,\n");
+        log("                     .json or .v; `@name` saves it for `design -load`).\n");
+        log("                     Consecutive lines naming the same .uhdm file share\n");
+        log("                     one restored UHDM design and its resolved packages;\n");
+        log("                     lines naming different files share nothing.\n");
+        UhdmImportOptions::help();
         log("\n");
     }
 
+    void run_batch(const std::string& manifest, bool keep_names, bool debug, bool formal,
+                   const UhdmImportOptions& opts) {
+        // Package tables hold pointers into the restored UHDM design, so they
+        // are only carried between entries of the same serializer.
+        struct PackageTables {
+            decltype(UhdmImporter::package_map) packages;
+            decltype(UhdmImporter::package_typespec_map) typespecs;
+            decltype(UhdmImporter::package_parameter_map) parameters;
+            decltype(UhdmImporter::package_parameter_index) pending;
+        };
+        std::unique_ptr<Serializer> serializer;
+        std::unique_ptr<PackageTables> tables;
+        std::string loaded;
+        UHDM::design* uhdm_design = nullptr;
+
+        auto entries = read_batch_manifest(manifest);
+        for (int i = 0; i < GetSize(entries); i++) {
+            auto& entry = entries[i];
+            if (entry.size() < 2 || entry.size() > 3)
+                log_cmd_error("read_uhdm -batch: line %d: expected `<file.uhdm> <output> [<top>]`\n", i + 1);
+            auto t0 = std::chrono::steady_clock::now();
+            log("read_uhdm -batch [%d/%d]: %s -> %s\n", i + 1, GetSize(entries),
+                entry[0].c_str(), entry[1].c_str());
+            if (entry[0] != loaded) {
+                tables.reset();
+                serializer.reset(new Serializer);
+                uhdm_design = restore_uhdm(*serializer, entry[0], debug);
+                loaded = entry[0];
+            }
+
+            RTLIL::Design* d = new RTLIL::Design;
+            {
+                UhdmImporter importer(d, keep_names, debug);
+                importer.mode_formal = formal;
+                opts.apply(importer);
+                if (!opts.heatmap_file.empty())
+                    importer.heatmap_file = opts.heatmap_file + "." + std::to_string(i + 1);
+                if (tables) {
+                    importer.package_map = tables->packages;
+                    importer.package_typespec_map = tables->typespecs;
+                    importer.package_parameter_map = tables->parameters;
+                    importer.package_parameter_index = tables->pending;
+                }
+                UhdmTraceSpan span("import_design", entry[0]);
+                importer.import_design(uhdm_design);
+                tables.reset(new PackageTables{importer.package_map, importer.package_typespec_map,
+                                               importer.package_parameter_map,
+                                               importer.package_parameter_index});
+            }
+            if (entry.size() == 3)
+                Pass::call(d, std::vector<std::string>{"hierarchy", "-top", entry[2]});
+            write_batch_result(d, entry[1]);
+            delete d;
+            log("read_uhdm -batch [%d/%d]: done in %.2fs\n", i + 1, GetSize(entries),
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count());
+        }
+    }
+
     void execute(std::istream *&f, std::string filename, std::vector<std::string> args, RTLIL::Design *design) override {
         log_header(design, "Executing UHDM frontend.\n");
 
         bool keep_names = false;
         bool debug = false;
         bool formal = false;
+        std::string batch_file;
+        UhdmImportOptions opts;
         
         size_t argidx = 1;
         for (; argidx < args.size(); argidx++) {
@@ -64,6 +327,12 @@ struct ReadUHDMPass : public Frontend {
                 formal = true;
                 continue;
             }
+            if (args[argidx] == "-batch" && argidx + 1 < args.size()) {
+                batch_file = args[++argidx];
+                continue;
+            }
+            if (opts.parse(args, argidx))
+                continue;
             if (args[argidx] == "-help" || args[argidx] == "--help") {
                 help();
                 return;
@@ -71,50 +340,298 @@ struct ReadUHDMPass : public Frontend {
             break;
         }
 
+        if (!batch_file.empty()) {
+            UhdmTraceSession trace(opts.trace_file);
+            run_batch(batch_file, keep_names, debug, formal, opts);
+            return;
+        }
+
         if (argidx >= args.size())
             log_cmd_error("Usage: read_uhdm [options] <uhdm_file>\n");
 
         filename = args[argidx];
         log("Reading UHDM file: %s\n", filename.c_str());
+        UhdmTraceSession trace(opts.trace_file);
 
         // Load UHDM file
         Serializer serializer;
-        std::vector<vpiHandle> handles;
-        std::vector<vpiHandle> designs = serializer.Restore(filename);
-        vpiHandle vpi_design = designs.at(0);
-        UHDM::design* uhdm_design = UhdmDesignFromVpiHandle(vpi_design);
-
-        if (!uhdm_design)
-            log_error("Failed to restore UHDM file.\n");
-
-        // If UHDM is not already elaborated/uniquified (uhdm db was saved by a
-        // different process pre-elaboration), then optionally elaborate it:
-        if (uhdm_design && (!vpi_get(vpiElaborated, vpi_design))) {
-            log("UHDM Elaboration...\n");
-            UHDM::ElaboratorContext* elaboratorContext =
-                new UHDM::ElaboratorContext(&serializer, true);
-            elaboratorContext->m_elaborator.listenDesigns(designs);
-            delete elaboratorContext;
-        }
-
-        if (debug) {
-            vpi_show_ids(true);
-            visit_designs({vpi_design}, std::cout);
-        }
-
-        if (!uhdm_design->AllModules())
-            log_error("No modules found in UHDM design.\n");
+        UHDM::design* uhdm_design = restore_uhdm(serializer, filename, debug);
 
         // Create importer and import design
         UhdmImporter importer(design, keep_names, debug);
         importer.mode_formal = formal;
-        importer.import_design(uhdm_design);
+        opts.apply(importer);
+        {
+            UhdmTraceSpan span("import_design");
+            importer.import_design(uhdm_design);
+        }
         
         log("Successfully imported %zu modules from UHDM.\n", 
             uhdm_design->AllModules()->size());
     }
 } ReadUHDMPass;
 
+// `read_sv -sv_cache <dir>`: a persistent Surelog parse/preprocess cache.
+//
+// The cache lives in <dir>/<key>, where the key hashes every forwarded Surelog
+// argument (defines, include dirs, options, file list), so a changed define can
+// never hit a stale entry.  The rest of the key is the content of everything
+// the compile read: after each run a manifest records a content hash of every
+// input (command-line sources, `-f`/`-v` files, each file the elaborated design
+// has a definition in or `include`s) and of each searched directory
+// (`+incdir+`, `-y`).  The next run drops the cache when any of them differs,
+// or when there is no manifest to check against.  An exclusive flock on
+// <dir>/<key>/.lock serializes concurrent read_sv runs sharing a key, so none
+// reads a half-written cache file.
+namespace fs = std::filesystem;
+
+struct SvCache {
+    fs::path dir;
+    int lock_fd = -1;
+    std::map<std::string, std::pair<fs::file_time_type, uintmax_t>> before;
+    // Input hashes taken before the compile ("f <path>" / "d <path>"), so
+    // an edit made while Surelog runs leaves the manifest stale, not the
+    // cache.
+    std::map<std::string, std::string> input_hashes;
+
+    static uint64_t fnv1a(const std::string& data, uint64_t h = 1469598103934665603ull) {
+        for (unsigned char c : data) { h ^= c; h *= 1099511628211ull; }
+        return h;
+    }
+
+    static std::string hex(uint64_t v) {
+        char buf[17];
+        snprintf(buf, sizeof(buf), "%016llx", (unsigned long long)v);
+        return buf;
+    }
+
+    static std::string content_hash(const fs::path& p) {
+        std::ifstream f(p, std::ios::binary);
+        if (f.fail())
+            return "missing";
+        std::stringstream ss;
+        ss << f.rdbuf();
+        return hex(fnv1a(ss.str()));
+    }
+
+    // A searched directory: the names and contents of the files directly in
+    // it, so a header added ahead of another on the search path also counts.
+    static std::string dir_hash(const fs::path& d) {
+        std::error_code ec;
+        if (!fs::is_directory(d, ec))
+            return "missing";
+        std::vector<fs::path> files;
+        for (auto& e : fs::directory_iterator(d, ec))
+            if (e.is_regular_file(ec))
+                files.push_back(e.path());
+        std::sort(files.begin(), files.end());
+        std::string all;
+        for (auto& f : files)
+            all += f.filename().string() + '\0' + content_hash(f) + '\0';
+        return hex(fnv1a(all));
+    }
+
+    // Inputs named by the Surelog arguments: sources, `-f` option files and
+    // `-v` library files (read whole), `+incdir+` and `-y` directories
+    // (searched).
+    static void argument_deps(const std::vector<std::string>& sl_args,
+                              std::set<std::string>& files, std::set<std::string>& dirs) {
+        std::error_code ec;
+        for (size_t i = 1; i < sl_args.size(); i++) {
+            const std::string& a = sl_args[i];
+            if ((a == "-f" || a == "-v") && i + 1 < sl_args.size()) {
+                files.insert(sl_args[++i]);
+            } else if (a == "-y" && i + 1 < sl_args.size()) {
+                dirs.insert(sl_args[++i]);
+            } else if (a.compare(0, 8, "+incdir+") == 0) {
+                std::string rest = a.substr(8);
+                for (size_t pos = 0; pos <= rest.size();) {
+                    size_t next = rest.find('+', pos);
+                    if (next == std::string::npos) next = rest.size();
+                    if (next > pos)
+                        dirs.insert(rest.substr(pos, next - pos));
+                    pos = next + 1;
+                }
+            } else if (!a.empty() && a[0] != '-' && a[0] != '+' && fs::is_regular_file(a, ec)) {
+                files.insert(a);
+            }
+        }
+    }
+
+    // Files the compile actually read beyond the arguments: every file a
+    // design unit is defined in, and every `include`d file.
+    static void design_deps(const UHDM::design* d, std::set<std::string>& files) {
+        auto add_units = [&](const auto* units) {
+            if (units)
+                for (auto u : *units)
+                    if (!u->VpiFile().empty())
+                        files.insert(std::string(u->VpiFile()));
+        };
+        add_units(d->AllModules());
+        add_units(d->AllInterfaces());
+        add_units(d->AllPackages());
+        add_units(d->AllPrograms());
+        if (d->Include_file_infos())
+            for (auto inc : *d->Include_file_infos()) {
+                if (!inc->VpiFile().empty())
+                    files.insert(std::string(inc->VpiFile()));
+                if (!inc->VpiIncludedFile().empty())
+                    files.insert(std::string(inc->VpiIncludedFile()));
+            }
+    }
+
+    std::map<std::string, std::pair<fs::file_time_type, uintmax_t>> snapshot() const {
+        std::map<std::string, std::pair<fs::file_time_type, uintmax_t>> files;
+        std::error_code ec;
+        for (auto& e : fs::recursive_directory_iterator(dir, ec)) {
+            if (!e.is_regular_file(ec)) continue;
+            std::string name = e.path().filename().string();
+            if (name == ".lock" || name == "manifest") continue;
+            files[e.path().string()] = {e.last_write_time(ec), e.file_size(ec)};
+        }
+        return files;
+    }
+
+    // The first input recorded in the manifest that no longer matches, or
+    // why the cache cannot be checked; empty when it is still valid.  The
+    // hashes checked are kept in input_hashes.
+    std::string stale_input() {
+        std::ifstream mf(dir / "manifest");
+        if (mf.fail())
+            return snapshot().empty() ? "" : "no dependency manifest";
+        std::string kind, h, path;
+        while (mf >> kind >> h && std::getline(mf >> std::ws, path)) {
+            std::string now = kind == "d" ? dir_hash(path) : content_hash(path);
+            input_hashes[kind + " " + path] = now;
+            if (now != h)
+                return path;
+        }
+        return "";
+    }
+
+    // Returns the directory to hand to Surelog's `-cache`.
+    std::string acquire(const std::string& root, const std::vector<std::string>& sl_args) {
+        std::string argkey;
+        for (auto& a : sl_args) { argkey += a; argkey += '\0'; }
+        dir = fs::path(root) / hex(fnv1a(argkey));
+        std::error_code ec;
+        fs::create_directories(dir, ec);
+        if (ec)
+            log_cmd_error("read_sv: cannot create cache directory '%s': %s\n",
+                          dir.string().c_str(), ec.message().c_str());
+#ifndef _WIN32
+        lock_fd = ::open((dir / ".lock").string().c_str(), O_RDWR | O_CREAT, 0644);
+        if (lock_fd >= 0 && flock(lock_fd, LOCK_EX | LOCK_NB) != 0) {
+            log("read_sv: waiting for the Surelog cache lock on %s\n", dir.string().c_str());
+            flock(lock_fd, LOCK_EX);
+        }
+#endif
+        std::string stale = stale_input();
+        if (!stale.empty()) {
+            log("read_sv: Surelog cache invalidated (%s changed since the last run)\n",
+                stale.c_str());
+            for (auto& e : fs::directory_iterator(dir, ec))
+                if (e.path().filename() != ".lock")
+                    fs::remove_all(e.path(), ec);
+        }
+        // Everything named on the command line is hashed now; files found
+        // only through the design (includes, units in `-y` libraries) were
+        // hashed above if the previous manifest listed them.
+        std::set<std::string> files, dirs;
+        argument_deps(sl_args, files, dirs);
+        for (auto& f : files)
+            if (!input_hashes.count("f " + f))
+                input_hashes["f " + f] = content_hash(f);
+        for (auto& dd : dirs)
+            if (!input_hashes.count("d " + dd))
+                input_hashes["d " + dd] = dir_hash(dd);
+        before = snapshot();
+        return dir.string();
+    }
+
+    // Hash of `path` as of acquire(), or now for an input first seen after
+    // the compile.
+    std::string input_hash(const char* kind, const std::string& path) const {
+        auto it = input_hashes.find(std::string(kind) + " " + path);
+        if (it != input_hashes.end())
+            return it->second;
+        return kind[0] == 'd' ? dir_hash(path) : content_hash(path);
+    }
+
+    // Records the dependency manifest for the next run and reports the hit
+    // rate, then releases the lock (the import that follows does not touch
+    // the cache).  Surelog names a cache entry after its source file
+    // (`<source file name>.<ext>`); only entries of a source this compile read
+    // are counted -- reused if left untouched, missed if new or rewritten --
+    // so leftovers for sources no longer in the design do not count as hits.
+    std::string summary;
+    void report(const std::vector<std::string>& sl_args, const UHDM::design* d) {
+        std::set<std::string> files, dirs;
+        argument_deps(sl_args, files, dirs);
+        if (d)
+            design_deps(d, files);
+
+        std::set<std::string> sources;
+        for (auto& f : files)
+            sources.insert(fs::path(f).filename().string());
+        int hits = 0, total = 0;
+        for (auto& f : snapshot()) {
+            if (!sources.count(fs::path(f.first).stem().string()))
+                continue;
+            total++;
+            auto it = before.find(f.first);
+            if (it != before.end() && it->second == f.second)
+                hits++;
+        }
+        summary = stringf("Surelog cache %s: %d/%d entries for %d input files reused (%.1f%% hit rate)",
+                          dir.string().c_str(), hits, total, GetSize(files),
+                          total ? 100.0 * hits / total : 0.0);
+        {
+            std::ofstream mf(dir / "manifest");
+            for (auto& f : files)
+                mf << "f " << input_hash("f", f) << " " << f << "\n";
+            for (auto& dd : dirs)
+                mf << "d " << input_hash("d", dd) << " " << dd << "\n";
+        }
+        release();
+    }
+
+    void release() {
+#ifndef _WIN32
+        if (lock_fd >= 0) ::close(lock_fd);
+#endif
+        lock_fd = -1;
+    }
+
+    ~SvCache() { release(); }
+};
+
+// Process high-water RSS in MB (0 where unavailable).
+static double peak_rss_mb() {
+#ifndef _WIN32
+    struct rusage ru;
+    if (getrusage(RUSAGE_SELF, &ru) == 0)
+#ifdef __APPLE__
+        return ru.ru_maxrss / (1024.0 * 1024.0);  // bytes
+#else
+        return ru.ru_maxrss / 1024.0;             // KB
+#endif
+#endif
+    return 0;
+}
+
+// Current process RSS in MB (0 where unavailable).  Unlike the high-water
+// mark it drops when memory is returned, e.g. after Surelog shuts down.
+static double current_rss_mb() {
+#ifdef __linux__
+    std::ifstream statm("/proc/self/statm");
+    long pages = 0, resident = 0;
+    if (statm >> pages >> resident)
+        return resident * (double)sysconf(_SC_PAGESIZE) / (1024.0 * 1024.0);
+#endif
+    return 0;
+}
+
 // read_sv: compile SystemVerilog with Surelog (in-process) and import the
 // resulting in-memory UHDM design directly to RTLIL — no intermediate .uhdm
 // file.  All command arguments are forwarded to Surelog exactly as if it were
@@ -139,6 +656,26 @@ struct ReadSVPass : public Pass {
         log("    -uhdm_debug      enable importer debug output\n");
         log("    -formal          enable formal verification constructs\n");
         log("    -keep_names      keep original signal names\n");
+        log("    -batch <manifest>\n");
+        log("                     run one Surelog compile + import per manifest line\n");
+        log("                         <output> <surelog args...>\n");
+        log("                     each into a fresh design written to <output> (.il,\n");
+        log("                     .json or .v; `@name` saves it for `design -load`).\n");
+        log("                     The other read_sv arguments apply to every line.\n");
+        log("                     Each line is a separate compile and import; no\n");
+        log("                     Surelog or package state is shared between lines.\n");
+        log("    -j <N>           parse with N Surelog threads (Surelog `-mt N`)\n");
+        log("    -lowmem          free all Surelog state before the import: Surelog\n");
+        log("                     writes the elaborated UHDM to a temporary file and\n");
+        log("                     shuts down, and the import runs on the design\n");
+        log("                     restored from that file.  Costs one UHDM write and\n");
+        log("                     restore; the RSS after the handoff is reported\n");
+        log("    -sv_cache <dir>  keep Surelog's parse cache in <dir> across runs\n");
+        log("                     (keyed by the Surelog arguments and the contents\n");
+        log("                     of every file the compile read, safe to share\n");
+        log("                     between concurrent read_sv runs) and report its\n");
+        log("                     hit rate\n");
+        UhdmImportOptions::help();
         log("\n");
     }
 
@@ -146,6 +683,11 @@ struct ReadSVPass : public Pass {
         log_header(design, "Executing read_sv (Surelog + UHDM frontend, in-memory).\n");
 
         bool keep_names = false, debug = false, formal = false;
+        std::string sv_cache_root;
+        int jobs = 1;
+        bool lowmem = false;
+        std::string batch_file;
+        UhdmImportOptions opts;
 
         // argv[0] is the program name Surelog expects; the rest are forwarded
         // verbatim, except for the few plugin-only options we consume here.
@@ -169,15 +711,77 @@ struct ReadSVPass : public Pass {
             if (args[i] == "-uhdm_debug") { debug = true; continue; }
             if (args[i] == "-formal")     { formal = true; continue; }
             if (args[i] == "-keep_names") { keep_names = true; continue; }
+            if (args[i] == "-sv_cache" && i + 1 < args.size()) { sv_cache_root = args[++i]; continue; }
+            if (args[i] == "-lowmem") { lowmem = true; continue; }
+            if (args[i] == "-batch" && i + 1 < args.size()) { batch_file = args[++i]; continue; }
+            if (args[i] == "-j" && i + 1 < args.size()) { jobs = std::max(1, atoi(args[++i].c_str())); continue; }
+            if (opts.parse(args, i)) continue;
             if (args[i] == "-help" || args[i] == "--help") { help(); return; }
             sl_args.push_back(args[i]);
         }
+
+        // One in-process Surelog session per manifest line, each into its own
+        // design; the plugin and Yosys start once for the whole batch.
+        if (!batch_file.empty()) {
+            // One trace session spans the batch; the entries must not open
+            // their own on the same file.  Each entry writes its own heatmap
+            // to <file>.<line>.
+            std::vector<std::string> common;
+            for (size_t i = 0; i < args.size(); i++) {
+                if (args[i] == "-batch" || args[i] == "-trace" || args[i] == "-heatmap") { i++; continue; }
+                common.push_back(args[i]);
+            }
+            UhdmTraceSession trace(opts.trace_file);
+            auto entries = read_batch_manifest(batch_file);
+            for (int i = 0; i < GetSize(entries); i++) {
+                auto& entry = entries[i];
+                if (entry.size() < 2)
+                    log_cmd_error("read_sv -batch: line %d: expected `<output> <surelog args...>`\n", i + 1);
+                log("read_sv -batch [%d/%d]: -> %s\n", i + 1, GetSize(entries), entry[0].c_str());
+                std::vector<std::string> entry_args = common;
+                if (!opts.heatmap_file.empty()) {
+                    entry_args.push_back("-heatmap");
+                    entry_args.push_back(opts.heatmap_file + "." + std::to_string(i + 1));
+                }
+                entry_args.insert(entry_args.end(), entry.begin() + 1, entry.end());
+                RTLIL::Design* d = new RTLIL::Design;
+                {
+                    UhdmTraceSpan span("batch_entry", entry[0]);
+                    execute(entry_args, d);
+                }
+                write_batch_result(d, entry[0]);
+                delete d;
+            }
+            return;
+        }
+
         if (sl_args.size() <= 1)
             log_cmd_error("read_sv: no input files / Surelog arguments given\n");
 
+        // Options that must not feed the -sv_cache key go in extra_args.
+        SvCache sv_cache;
+        std::vector<std::string> extra_args;
+        if (!sv_cache_root.empty())
+            extra_args = {"-cache", sv_cache.acquire(sv_cache_root, sl_args)};
+        if (jobs > 1) {
+            extra_args.push_back("-mt");
+            extra_args.push_back(std::to_string(jobs));
+        }
+        // -lowmem: Surelog writes the elaborated UHDM here and is shut down
+        // before the import, which restores the design from this file.
+        std::string handoff_dir;
+        if (lowmem) {
+            handoff_dir = make_temp_dir(get_base_tmpdir() + "/uhdm2rtlil_XXXXXX");
+            extra_args.push_back("-o");
+            extra_args.push_back(handoff_dir);
+        }
+
         std::vector<const char*> argv;
-        argv.reserve(sl_args.size());
+        argv.reserve(sl_args.size() + extra_args.size());
         for (auto &s : sl_args) argv.push_back(s.c_str());
+        for (auto &s : extra_args) argv.push_back(s.c_str());
+
+        UhdmTraceSession trace(opts.trace_file);
 
         // Set up a Surelog session (mirrors the surelog executable's main()).
         SURELOG::SymbolTable*   symbolTable = new SURELOG::SymbolTable();
@@ -194,41 +798,115 @@ struct ReadSVPass : public Pass {
         }
 
         // Force a full parse + elaborate with an ELABORATED in-memory UHDM, and
-        // make sure no .uhdm file is written (pure in-memory conversion).
+        // make sure no .uhdm file is written (pure in-memory conversion) unless
+        // -lowmem hands the design over through one.
         clp->setParse(true);
         clp->setCompile(true);
         clp->setElaborate(true);
         clp->setElabUhdm(true);
-        clp->setWriteUhdm(false);
-
-        SURELOG::scompiler* compiler = SURELOG::start_compiler(clp);
+        clp->setWriteUhdm(lowmem);
+
+        // Surelog parse, compile, elaborate and UHDM elaboration all run
+        // inside start_compiler; it is one span on the timeline.  The import
+        // starts on the in-memory design as soon as it returns.
+        auto t_start = std::chrono::steady_clock::now();
+        auto secs_since = [](std::chrono::steady_clock::time_point t) {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - t).count();
+        };
+        SURELOG::scompiler* compiler = nullptr;
+        {
+            UhdmTraceSpan span("start_compiler");
+            compiler = SURELOG::start_compiler(clp);
+        }
+        double t_surelog = secs_since(t_start);
+        double rss_surelog = peak_rss_mb();
         if (!compiler) {
             errors->printMessages(clp->muteStdout());
             delete clp; delete errors; delete symbolTable;
+            if (lowmem) remove_directory(handoff_dir);
             log_cmd_error("read_sv: Surelog compilation failed\n");
         }
 
-        vpiHandle vpi_design = SURELOG::get_uhdm_design(compiler);
-        UHDM::design* uhdm_design =
-            vpi_design ? UhdmDesignFromVpiHandle(vpi_design) : nullptr;
+        UHDM::design* uhdm_design = nullptr;
+        std::unique_ptr<Serializer> handoff;
+        double rss_released = 0;
+        if (lowmem) {
+            // Free all of Surelog -- parse trees, preprocessor, symbol tables
+            // and its copy of the UHDM -- and keep only the restored design.
+            std::string uhdm_file;
+            std::error_code ec;
+            for (auto& e : fs::recursive_directory_iterator(handoff_dir, ec))
+                if (e.path().extension() == ".uhdm") {
+                    uhdm_file = e.path().string();
+                    break;
+                }
+            {
+                UhdmTraceSpan span("shutdown_compiler");
+                SURELOG::shutdown_compiler(compiler);
+            }
+            compiler = nullptr;
+            delete clp; delete errors; delete symbolTable;
+            clp = nullptr; errors = nullptr; symbolTable = nullptr;
+            if (uhdm_file.empty()) {
+                remove_directory(handoff_dir);
+                log_cmd_error("read_sv: Surelog wrote no UHDM file (check Surelog errors above)\n");
+            }
+            handoff.reset(new Serializer);
+            uhdm_design = restore_uhdm(*handoff, uhdm_file, debug, false);
+            remove_directory(handoff_dir);
+            if (!uhdm_design)
+                log_cmd_error("read_sv: cannot restore the UHDM design Surelog wrote to %s\n",
+                              uhdm_file.c_str());
+            rss_released = current_rss_mb();
+        } else {
+            vpiHandle vpi_design = SURELOG::get_uhdm_design(compiler);
+            uhdm_design = vpi_design ? UhdmDesignFromVpiHandle(vpi_design) : nullptr;
+        }
+
+        if (!sv_cache_root.empty() && uhdm_design)
+            sv_cache.report(sl_args, uhdm_design);
 
         if (!uhdm_design || !uhdm_design->AllModules()) {
-            SURELOG::shutdown_compiler(compiler);
+            if (compiler) SURELOG::shutdown_compiler(compiler);
             delete clp; delete errors; delete symbolTable;
             log_cmd_error("read_sv: no UHDM design produced (check Surelog errors above)\n");
         }
 
         size_t nmods = uhdm_design->AllModules()->size();
 
-        // Import BEFORE shutdown — shutdown_compiler purges UHDM/VPI memory.
+        // Import BEFORE shutdown — shutdown_compiler purges UHDM/VPI memory
+        // (-lowmem imports the restored copy, Surelog is already gone).
         UhdmImporter importer(design, keep_names, debug);
         importer.mode_formal = formal;
-        importer.import_design(uhdm_design);
+        opts.apply(importer);
+        auto t_import = std::chrono::steady_clock::now();
+        {
+            UhdmTraceSpan span("import_design");
+            importer.import_design(uhdm_design);
+        }
+        double t_imported = secs_since(t_import);
 
-        SURELOG::shutdown_compiler(compiler);
+        auto t_shutdown = std::chrono::steady_clock::now();
+        if (compiler) {
+            UhdmTraceSpan span("shutdown_compiler");
+            SURELOG::shutdown_compiler(compiler);
+        }
         delete clp; delete errors; delete symbolTable;
-
-        log("read_sv: imported %zu modules from Surelog (in-memory UHDM).\n", nmods);
+        handoff.reset();
+
+        log("read_sv: imported %zu modules from Surelog (%s UHDM).\n", nmods,
+            lowmem ? "handed-off" : "in-memory");
+        log("read_sv: Surelog %.2fs (%d thread%s), import %.2fs, shutdown %.2fs, total %.2fs\n",
+            t_surelog, jobs, jobs > 1 ? "s" : "", t_imported, secs_since(t_shutdown),
+            secs_since(t_start));
+        if (rss_surelog > 0)
+            log("read_sv: peak RSS %.0f MB after Surelog, %.0f MB after import\n",
+                rss_surelog, peak_rss_mb());
+        if (rss_released > 0)
+            log("read_sv: -lowmem: RSS %.0f MB with Surelog released and the UHDM restored\n",
+                rss_released);
+        if (!sv_cache.summary.empty())
+            log("read_sv: %s\n", sv_cache.summary.c_str());
     }
 } ReadSVPass;
 
@@ -294,17 +972,58 @@ std::string UhdmImporter::encode_param_bits32(const std::string& value_type,
     return s;
 }
 
+UhdmLogLevel uhdm_log_level = UhdmLogLevel::Info;
+
 // UhdmImporter constructor
 UhdmImporter::UhdmImporter(RTLIL::Design *design, bool keep_names, bool debug) :
     design(design), module(nullptr), mode_keep_names(keep_names), mode_debug(debug) {
 }
 
+// Index every elaborated module instance by definition, so the importer's
+// "find an elaborated copy of this def" searches are one hash lookup plus a
+// scan of that def's instances instead of a walk of the whole hierarchy.
+void UhdmImporter::index_instance_hierarchy() {
+    hier_insts_by_def.clear();
+    if (!uhdm_design || !uhdm_design->TopModules())
+        return;
+    std::function<void(const any*, bool)> walk = [&](const any* s, bool in_gen) {
+        const std::vector<module_inst*>* mods = nullptr;
+        const std::vector<gen_scope_array*>* gsa = nullptr;
+        if (s->UhdmType() == uhdmmodule_inst) {
+            auto m = any_cast<const module_inst*>(s);
+            hier_insts_by_def[std::string(m->VpiDefName())].push_back({m, in_gen});
+            mods = m->Modules(); gsa = m->Gen_scope_arrays();
+        } else if (s->UhdmType() == uhdmgen_scope) {
+            auto g = any_cast<const gen_scope*>(s);
+            mods = g->Modules(); gsa = g->Gen_scope_arrays();
+        }
+        if (mods) for (auto c : *mods) walk(c, in_gen);
+        if (gsa) for (auto ga : *gsa) if (ga->Gen_scopes())
+            for (auto gs : *ga->Gen_scopes()) walk(gs, true);
+    };
+    for (auto t : *uhdm_design->TopModules())
+        walk(t, false);
+}
+
+const module_inst* UhdmImporter::find_elaborated_instance(const std::string& def, bool through_gen_scopes,
+                                                          const std::function<bool(const module_inst*)>& pred) {
+    auto it = hier_insts_by_def.find(def);
+    if (it == hier_insts_by_def.end())
+        return nullptr;
+    for (auto& hi : it->second)
+        if ((through_gen_scopes || !hi.in_gen_scope) && pred(hi.inst))
+            return hi.inst;
+    return nullptr;
+}
+
 // Import entire UHDM design
 void UhdmImporter::import_design(UHDM::design* uhdm_design) {
-    log("UHDM: Starting import_design\n");
+    log_uhdm("UHDM: Starting import_design\n");
     
     // Store the design for later access
     this->uhdm_design = uhdm_design;
+    // Views into a previous design's symbol table may have been freed.
+    src_file_views.clear();
     
     // First, identify top-level modules by checking vpiTop property
     std::set<std::string> top_level_module_names;
@@ -316,7 +1035,7 @@ void UhdmImporter::import_design(UHDM::design* uhdm_design) {
                     mod_name = mod_name.substr(5);
                 }
                 top_level_module_names.insert(mod_name);
-                log("UHDM: Identified top-level module: %s\n", mod_name.c_str());
+                log_uhdm_debug("UHDM: Identified top-level module: %s\n", mod_name.c_str());
             }
         }
     }
@@ -343,7 +1062,7 @@ void UhdmImporter::import_design(UHDM::design* uhdm_design) {
             if (!m) return;
             std::string nm = std::string(m->VpiDefName());
             if (nm.find("work@") == 0) nm = nm.substr(5);
-            elab_inst_by_def.emplace(nm, m);  // first-seen elaborated instance
+            elab_inst_by_def.insert({nm, m});  // first-seen elaborated instance
             if (!hierarchy_reachable_modules.insert(nm).second) return; // already visited
             if (m->Modules()) {
                 for (auto child : *m->Modules()) walk(child);
@@ -351,107 +1070,41 @@ void UhdmImporter::import_design(UHDM::design* uhdm_design) {
         };
         for (auto top_mod : *uhdm_design->TopModules()) walk(top_mod);
     }
+    index_instance_hierarchy();
 
     // First, import all packages (prefer TopPackages for resolved values)
     auto* packages = uhdm_design->TopPackages();
     if (!packages) packages = uhdm_design->AllPackages();
     if (packages) {
-        log("UHDM: Found %d packages in design\n", (int)packages->size());
+        log_uhdm("UHDM: Found %d packages in design\n", (int)packages->size());
         for (const package* uhdm_package : *packages) {
-            log("UHDM: About to import package: %s\n", uhdm_package->VpiDefName().data());
+            log_uhdm_debug("UHDM: About to import package: %s\n", uhdm_package->VpiDefName().data());
             import_package(uhdm_package);
         }
     }
     
-    // Then, import all interfaces
+    // Then, import the interfaces: register every distinct (interface,
+    // parameter set) -- definitions with their defaults, then the instances
+    // of the elaborated hierarchy -- and build one module per specialization.
+    // Instance cells and modport users look the specialization up by name.
     if (uhdm_design->AllInterfaces()) {
-        log("UHDM: Found %d interfaces in design\n", (int)uhdm_design->AllInterfaces()->size());
+        log_uhdm("UHDM: Found %d interfaces in design\n", (int)uhdm_design->AllInterfaces()->size());
         for (const interface_inst* uhdm_interface : *uhdm_design->AllInterfaces()) {
-            log("UHDM: About to import interface\n");
-            // Import interface with default WIDTH=8
-            import_interface(uhdm_interface);
-            
-            // Also create a WIDTH=16 version for bus3
-            // This is a temporary solution - ideally we should discover all parameter values
-            // Create a copy of the interface with WIDTH=16
-            if (std::string(uhdm_interface->VpiDefName()).find("data_bus_if") != std::string::npos) {
-                // Create WIDTH=16 version
-                create_interface_module_with_width("data_bus_if", 16);
-            }
+            std::string def_name = std::string(uhdm_interface->VpiDefName());
+            if (def_name.find("work@") == 0)
+                def_name = def_name.substr(5);
+            if (!interface_definitions.count(def_name))
+                interface_definitions[def_name] = uhdm_interface;
+            register_interface_specialization(uhdm_interface);
         }
     }
-    
-    // Also need to create interface modules for all parameter combinations found in the design
-    // Collect all unique interface instances with their parameters
-    std::set<std::string> interface_module_names;
-    
-    // Function to collect interface instances from a module
-    std::function<void(const UHDM::module_inst*)> collect_interfaces;
-    collect_interfaces = [&](const UHDM::module_inst* mod) {
-        if (mod->Interfaces()) {
-            for (auto interface : *mod->Interfaces()) {
-                std::string interface_type = std::string(interface->VpiDefName());
-                if (interface_type.find("work@") == 0) {
-                    interface_type = interface_type.substr(5);
-                }
-                
-                // Build parameterized module name
-                std::string param_module_name = "$paramod\\" + interface_type;
-                
-                if (interface->Param_assigns()) {
-                    for (auto param_assign : *interface->Param_assigns()) {
-                        if (param_assign->Lhs() && param_assign->Rhs()) {
-                            std::string param_name;
-                            if (auto param = dynamic_cast<const parameter*>(param_assign->Lhs())) {
-                                param_name = std::string(param->VpiName());
-                            }
-                            
-                            if (!param_name.empty()) {
-                                if (auto const_val = dynamic_cast<const constant*>(param_assign->Rhs())) {
-                                    std::string val_str = std::string(const_val->VpiValue());
-                                    size_t colon_pos = val_str.find(':');
-                                    std::string value_type = "";
-                                    if (colon_pos != std::string::npos) {
-                                        value_type = val_str.substr(0, colon_pos);
-                                        val_str = val_str.substr(colon_pos + 1);
-                                    }
-                                    
-                                    if (value_type == "STRING") {
-                                        // Handle string parameters
-                                        param_module_name += "\\" + param_name + "=\"" + val_str + "\"";
-                                    } else {
-                                        // Handle numeric parameters (x/z-safe)
-                                        param_module_name += "\\" + param_name + "=s32'"
-                                            + encode_param_bits32(value_type, val_str);
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-                
-                // Check if we need to create this interface module
-                if (!design->module(RTLIL::escape_id(param_module_name))) {
-                    interface_module_names.insert(param_module_name);
-                    import_interface(interface);
-                }
-            }
-        }
-        
-        // Recursively check child modules
-        if (mod->Modules()) {
-            for (auto child : *mod->Modules()) {
-                collect_interfaces(child);
-            }
-        }
-    };
-    
-    // Collect interfaces from all top modules
     if (uhdm_design->TopModules()) {
-        for (auto top_mod : *uhdm_design->TopModules()) {
-            collect_interfaces(top_mod);
-        }
+        for (auto top_mod : *uhdm_design->TopModules())
+            collect_interface_specializations(top_mod);
     }
+    for (auto& it : interface_specializations)
+        import_interface(it.second);
+    log_uhdm_debug("UHDM: %d interface specializations\n", GetSize(interface_specializations));
     
     // Import non-top-level module definitions from AllModules for structural info
     // (port directions, etc.). Top-level modules are skipped here and imported
@@ -459,7 +1112,7 @@ void UhdmImporter::import_design(UHDM::design* uhdm_design) {
     // NOTE: AllModules signal types (signedness) may be incorrect; when modules
     // are re-encountered in the elaborated hierarchy, signedness will be updated.
     if (uhdm_design->AllModules()) {
-        log("UHDM: Found %d module definitions in AllModules\n",
+        log_uhdm("UHDM: Found %d module definitions in AllModules\n",
             (int)uhdm_design->AllModules()->size());
         for (auto module_def : *uhdm_design->AllModules()) {
             std::string mod_name = std::string(module_def->VpiDefName());
@@ -469,7 +1122,7 @@ void UhdmImporter::import_design(UHDM::design* uhdm_design) {
             // Skip top-level modules - they must be imported from the elaborated
             // hierarchy to get complete module body (processes, assigns, etc.)
             if (top_level_module_names.find(mod_name) != top_level_module_names.end()) {
-                log("UHDM: Skipping top module %s from AllModules (will import from hierarchy)\n", mod_name.c_str());
+                log_uhdm_debug("UHDM: Skipping top module %s from AllModules (will import from hierarchy)\n", mod_name.c_str());
                 continue;
             }
             // Skip modules that are never instantiated in the elaborated top
@@ -484,7 +1137,7 @@ void UhdmImporter::import_design(UHDM::design* uhdm_design) {
             if (!hierarchy_reachable_modules.empty() &&
                 hierarchy_reachable_modules.find(mod_name) ==
                     hierarchy_reachable_modules.end()) {
-                log("UHDM: Skipping %s from AllModules (not instantiated in top "
+                log_uhdm_debug("UHDM: Skipping %s from AllModules (not instantiated in top "
                     "hierarchy)\n",
                     mod_name.c_str());
                 continue;
@@ -495,7 +1148,7 @@ void UhdmImporter::import_design(UHDM::design* uhdm_design) {
             // wires that don't exist yet. Defer to the elaborated walk, where
             // each gen_scope_array is materialized with its iteration index.
             if (module_def->Gen_stmts() && !module_def->Gen_stmts()->empty()) {
-                log("UHDM: Skipping %s from AllModules (has gen_stmts; will import from elaborated form)\n", mod_name.c_str());
+                log_uhdm_debug("UHDM: Skipping %s from AllModules (has gen_stmts; will import from elaborated form)\n", mod_name.c_str());
                 continue;
             }
             // AllModules represents an unpacked memory array as a scalar net
@@ -519,7 +1172,7 @@ void UhdmImporter::import_design(UHDM::design* uhdm_design) {
             auto eit = elab_inst_by_def.find(mod_name);
             if (eit != elab_inst_by_def.end() && has_unpacked_array(eit->second) &&
                 !has_unpacked_array(module_def)) {
-                log("UHDM: Importing %s from elaborated instance (has memory array lost in AllModules)\n",
+                log_uhdm_debug("UHDM: Importing %s from elaborated instance (has memory array lost in AllModules)\n",
                     mod_name.c_str());
                 to_import = eit->second;
             }
@@ -529,16 +1182,16 @@ void UhdmImporter::import_design(UHDM::design* uhdm_design) {
     
     // Then import from TopModules which contains the elaborated hierarchy with instances
     if (uhdm_design->TopModules()) {
-        log("UHDM: Found %d top modules in design\n", (int)uhdm_design->TopModules()->size());
+        log_uhdm("UHDM: Found %d top modules in design\n", (int)uhdm_design->TopModules()->size());
         
         // Recursively import the instantiation tree starting from top modules
         for (const module_inst* top_mod : *uhdm_design->TopModules()) {
-            log("UHDM: Importing top module hierarchy starting from: %s\n", 
+            log_uhdm("UHDM: Importing top module hierarchy starting from: %s\n", 
                 !top_mod->VpiName().empty() ? top_mod->VpiName().data() : top_mod->VpiDefName().data());
             import_module_hierarchy(top_mod);
         }
     } else {
-        log("UHDM: No top modules found in design\n");
+        log_uhdm_debug("UHDM: No top modules found in design\n");
     }
 
     // Resolve undefined-module stubs.  Surelog names a module that has no
@@ -565,7 +1218,7 @@ void UhdmImporter::import_design(UHDM::design* uhdm_design) {
                 for (auto cell : mod->cells())
                     if (cell->type == stub->name)
                         cell->type = bare_id;
-            log("UHDM: Resolved undefined-module stub %s -> blackbox %s\n",
+            log_uhdm_debug("UHDM: Resolved undefined-module stub %s -> blackbox %s\n",
                 sname.c_str(), bare.c_str());
             design->remove(stub);
         }
@@ -575,7 +1228,7 @@ void UhdmImporter::import_design(UHDM::design* uhdm_design) {
     // as we handle parameterization during hierarchy traversal
     
     // Post-process: Mark interface connection wires with is_interface attribute
-    log("UHDM: Post-processing to mark interface connection wires\n");
+    log_uhdm_debug("UHDM: Post-processing to mark interface connection wires\n");
     for (auto module : design->modules()) {
         for (auto cell : module->cells()) {
             // Check if this is an interface cell by looking at the module it references
@@ -593,7 +1246,7 @@ void UhdmImporter::import_design(UHDM::design* uhdm_design) {
                 RTLIL::Wire* conn_wire = module->wire(RTLIL::escape_id(conn_wire_name));
                 if (conn_wire && !conn_wire->attributes.count(RTLIL::escape_id("is_interface"))) {
                     conn_wire->attributes[RTLIL::escape_id("is_interface")] = RTLIL::Const(1);
-                    log("UHDM: Marked wire '%s' as interface connection in module %s\n", 
+                    log_uhdm_debug("UHDM: Marked wire '%s' as interface connection in module %s\n", 
                         conn_wire_name.c_str(), module->name.c_str());
                 }
             }
@@ -601,13 +1254,13 @@ void UhdmImporter::import_design(UHDM::design* uhdm_design) {
     }
     
     // Expand interfaces - replace interface instances with their signals
-    log("UHDM: Starting interface expansion\n");
+    log_uhdm_debug("UHDM: Starting interface expansion\n");
     expand_interfaces();
     
     // Post-process: Remove \reg attribute from wires driven by cell output ports.
     // In SystemVerilog, 'reg' variables connected to module instance outputs are
     // continuously driven and should not be treated as registers.
-    log("UHDM: Removing \\reg from wires driven by cell outputs\n");
+    log_uhdm_debug("UHDM: Removing \\reg from wires driven by cell outputs\n");
     for (auto mod : design->modules()) {
         for (auto cell : mod->cells()) {
             RTLIL::Module* cell_module = design->module(cell->type);
@@ -618,7 +1271,7 @@ void UhdmImporter::import_design(UHDM::design* uhdm_design) {
                     // This connection drives signals from a cell output port
                     for (auto &bit : conn.second) {
                         if (bit.wire && bit.wire->attributes.count(ID::reg)) {
-                            log("UHDM: Removing \\reg from wire '%s' in module %s (driven by cell %s port %s)\n",
+                            log_uhdm_debug("UHDM: Removing \\reg from wire '%s' in module %s (driven by cell %s port %s)\n",
                                 bit.wire->name.c_str(), mod->name.c_str(),
                                 cell->name.c_str(), conn.first.c_str());
                             bit.wire->attributes.erase(ID::reg);
@@ -631,7 +1284,7 @@ void UhdmImporter::import_design(UHDM::design* uhdm_design) {
 
     // Post-process: Detect and mark blackbox modules
     // This must be done after all instances are created
-    log("UHDM: Detecting blackbox modules\n");
+    log_uhdm_debug("UHDM: Detecting blackbox modules\n");
     for (auto module : design->modules()) {
         // A module is considered blackbox if it has no implementation:
         // no processes, no cells, no memories, and no connections (continuous assignments)
@@ -644,7 +1297,7 @@ void UhdmImporter::import_design(UHDM::design* uhdm_design) {
         // (e.g., parameter-only top module) is not a blackbox
         if (is_empty && !module->ports.empty()) {
             module->set_bool_attribute(ID::blackbox);
-            log("UHDM: Module %s has no implementation, marking as blackbox\n", module->name.c_str());
+            log_uhdm_debug("UHDM: Module %s has no implementation, marking as blackbox\n", module->name.c_str());
         }
     }
     
@@ -656,11 +1309,13 @@ void UhdmImporter::import_design(UHDM::design* uhdm_design) {
         const std::string& sig = std::get<2>(xr);
         if (RTLIL::Cell* cell = mod->cell(RTLIL::escape_id(inst))) {
             resolve_xmr_read(mod, cell, sig);
-            log("UHDM: resolved deferred XMR read %s.%s\n", inst.c_str(), sig.c_str());
+            log_uhdm_debug("UHDM: resolved deferred XMR read %s.%s\n", inst.c_str(), sig.c_str());
         }
     }
     pending_xmr_reads_.clear();
 
+    prune_unread_row_aliases();
+
     // Final safety pass: every process action's RHS must be exactly as wide as
     // its LHS, or yosys `proc_prune` dereferences rhs[i] out of range and
     // aborts.  An unresolved sub-expression can leave a short/empty RHS, and
@@ -674,35 +1329,37 @@ void UhdmImporter::import_design(UHDM::design* uhdm_design) {
     // `mask`) with X so proc_dlatch doesn't infer dead latches.
     finalize_dead_selfhold_defaults();
 
-    log("UHDM: Finished import_design\n");
-    log_flush();
+    if (int lookups = iface_param_memo_hits + iface_param_memo_misses) {
+        log_uhdm_debug("UHDM: Interface/struct parameter memo: %d lookups, %d hits (%.1f%%)\n",
+                       lookups, iface_param_memo_hits, 100.0 * iface_param_memo_hits / lookups);
+        uhdm_trace_counter("iface_param_memo", {{"hits", iface_param_memo_hits},
+                                                {"misses", iface_param_memo_misses}});
+    }
+
+    if (!heatmap_file.empty())
+        report_heatmap();
 
-    // Debug: Log all created wires and memories
-    log("UHDM: Final debug - listing all created objects\n");
+    log_uhdm("UHDM: Finished import_design\n");
     log_flush();
-    for (auto mod : design->modules()) {
-        log("  Module: %s\n", log_id(mod->name));
-        log_flush();
-        for (auto wire : mod->wires()) {
-            log("    Wire: %s (width=%d) [raw name: %s]\n", log_id(wire->name), wire->width, wire->name.c_str());
-            log_flush();
-        }
-        for (auto &mem_pair : mod->memories) {
-            log("    Memory: %s (width=%d, size=%d)\n", log_id(mem_pair.first), 
-                mem_pair.second->width, mem_pair.second->size);
-            log_flush();
-        }
-        for (auto cell : mod->cells()) {
-            log("    Cell: %s (type=%s) [raw name: %s]\n", log_id(cell->name), log_id(cell->type), cell->name.c_str());
-            log_flush();
-        }
-        for (auto &proc_pair : mod->processes) {
-            log("    Process: %s\n", log_id(proc_pair.first));
-            log_flush();
+
+    // Trace: list every created wire, memory, cell and process
+    if (uhdm_log_level >= UhdmLogLevel::Trace) {
+        log("UHDM: Final debug - listing all created objects\n");
+        for (auto mod : design->modules()) {
+            log("  Module: %s\n", log_id(mod->name));
+            for (auto wire : mod->wires())
+                log("    Wire: %s (width=%d) [raw name: %s]\n", log_id(wire->name), wire->width, wire->name.c_str());
+            for (auto &mem_pair : mod->memories)
+                log("    Memory: %s (width=%d, size=%d)\n", log_id(mem_pair.first),
+                    mem_pair.second->width, mem_pair.second->size);
+            for (auto cell : mod->cells())
+                log("    Cell: %s (type=%s) [raw name: %s]\n", log_id(cell->name), log_id(cell->type), cell->name.c_str());
+            for (auto &proc_pair : mod->processes)
+                log("    Process: %s\n", log_id(proc_pair.first));
         }
+        log("UHDM: End of debug listing\n");
+        log_flush();
     }
-    log("UHDM: End of debug listing\n");
-    log_flush();
 
     // Consistency check: every SigSpec in a module's connections, cells and
     // processes must only reference wires OWNED by that module.  A cross-module
@@ -778,21 +1435,16 @@ static const expr* find_tagged_field(const expr* val, const std::string& field)
 // Index of member `field` in a struct typespec (= its assignment-pattern operand
 // position, declaration order); -1 if absent.  *member_ts gets the member's own
 // typespec for descending into nested structs.
-static int struct_member_index(const typespec* ts, const std::string& field,
-                               const typespec** member_ts) {
+int UhdmImporter::struct_member_index(const typespec* ts, const std::string& field,
+                                      const typespec** member_ts) {
     if (!ts || ts->UhdmType() != uhdmstruct_typespec) return -1;
-    auto st = any_cast<const struct_typespec*>(ts);
-    if (!st->Members()) return -1;
-    int i = 0;
-    for (auto m : *st->Members()) {
-        if (std::string(m->VpiName()) == field) {
-            if (member_ts && m->Typespec())
-                *member_ts = m->Typespec()->Actual_typespec();
-            return i;
-        }
-        i++;
-    }
-    return -1;
+    const dict<std::string, int>* names = struct_member_names(ts);
+    if (!names || !names->count(field)) return -1;
+    int i = names->at(field);
+    auto m = (*any_cast<const struct_typespec*>(ts)->Members())[i];
+    if (member_ts && m->Typespec())
+        *member_ts = m->Typespec()->Actual_typespec();
+    return i;
 }
 
 // Evaluate an interface struct-PARAMETER field referenced in a child instance's
@@ -960,31 +1612,16 @@ bool UhdmImporter::resolve_iface_param(const hier_path* hp,
         if (child_inst->Ports())
             for (auto p : *child_inst->Ports())
                 if (std::string(p->VpiName()) == base) { has_hc = p->High_conn() != nullptr; break; }
-        if (!has_hc && uhdm_design && uhdm_design->TopModules()) {
-            std::string def = std::string(child_inst->VpiDefName());
-            std::function<const module_inst*(const any*)> find_elab =
-                [&](const any* s) -> const module_inst* {
-                if (!s) return nullptr;
-                const std::vector<module_inst*>* mods = nullptr;
-                const std::vector<gen_scope_array*>* gsa = nullptr;
-                if (s->UhdmType() == uhdmmodule_inst) {
-                    auto m = any_cast<const module_inst*>(s);
-                    if (std::string(m->VpiDefName()) == def && m != child_inst && m->Ports())
-                        for (auto p : *m->Ports())
-                            if (std::string(p->VpiName()) == base && p->High_conn())
-                                return m;
-                    mods = m->Modules(); gsa = m->Gen_scope_arrays();
-                } else if (s->UhdmType() == uhdmgen_scope) {
-                    auto g = any_cast<const gen_scope*>(s);
-                    mods = g->Modules(); gsa = g->Gen_scope_arrays();
-                }
-                if (mods) for (auto c : *mods) if (auto r = find_elab(c)) return r;
-                if (gsa) for (auto ga : *gsa) if (ga->Gen_scopes())
-                    for (auto gs : *ga->Gen_scopes()) if (auto r = find_elab(gs)) return r;
-                return nullptr;
-            };
-            for (auto t : *uhdm_design->TopModules())
-                if (auto r = find_elab(t)) { eff_inst = r; break; }
+        if (!has_hc) {
+            auto r = find_elaborated_instance(std::string(child_inst->VpiDefName()), true,
+                [&](const module_inst* m) {
+                    if (m == child_inst || !m->Ports()) return false;
+                    for (auto p : *m->Ports())
+                        if (std::string(p->VpiName()) == base && p->High_conn())
+                            return true;
+                    return false;
+                });
+            if (r) eff_inst = r;
         }
     }
     if (eff_inst->Ports())
@@ -1075,8 +1712,108 @@ bool UhdmImporter::resolve_iface_param(const hier_path* hp,
     return val != nullptr;
 }
 
-// Scalar int value of an interface struct-parameter field ("" on failure).
+// Interface / struct-parameter resolution memo.  The resolvers only read the
+// UHDM tree, so a result is fixed by the resolver, the hier_path text with the
+// binding of each element, the child instance and the instance/module being
+// imported -- config-struct IP references the same `CFG.BUS.DAT` field from
+// hundreds of places.
+std::string UhdmImporter::iface_param_memo_key(char kind, const hier_path* hp,
+                                               const module_inst* child_inst) {
+    std::string key = stringf("%c|%p|%p|%p", kind, (const void*)child_inst,
+                              (const void*)current_instance, (const void*)module);
+    if (hp && hp->Path_elems())
+        for (auto e : *hp->Path_elems()) {
+            const any* bound = nullptr;
+            const any* ts = nullptr;
+            if (auto r = dynamic_cast<const ref_obj*>(e)) {
+                bound = r->Actual_group();
+                if (r->Typespec()) ts = r->Typespec()->Actual_typespec();
+            }
+            key += stringf("|%s@%p:%p", std::string(e->VpiName()).c_str(),
+                           (const void*)bound, (const void*)ts);
+        }
+    return key;
+}
+
+// A filled memo entry for `key`, or null.  Entries are only inserted once
+// computed: a resolver may recurse into another one and grow the memo.
+const UhdmImporter::IfaceParamMemo* UhdmImporter::iface_param_memo_find(const std::string& key) {
+    auto it = iface_param_memo.find(key);
+    if (it == iface_param_memo.end()) {
+        iface_param_memo_misses++;
+        return nullptr;
+    }
+    iface_param_memo_hits++;
+    return &it->second;
+}
+
 RTLIL::SigSpec UhdmImporter::fold_iface_param_via_chain(const hier_path* hp) {
+    std::string key = iface_param_memo_key('c', hp, nullptr);
+    if (auto m = iface_param_memo_find(key)) return m->sig;
+    IfaceParamMemo m;
+    m.sig = fold_iface_param_via_chain_walk(hp);
+    return (iface_param_memo[key] = m).sig;
+}
+
+std::string UhdmImporter::eval_iface_param_field(const hier_path* hp,
+                                                 const module_inst* child_inst) {
+    std::string key = iface_param_memo_key('f', hp, child_inst);
+    if (auto m = iface_param_memo_find(key)) return m->str;
+    IfaceParamMemo m;
+    m.str = eval_iface_param_field_walk(hp, child_inst);
+    return (iface_param_memo[key] = m).str;
+}
+
+RTLIL::SigSpec UhdmImporter::eval_iface_param_struct(const hier_path* hp,
+                                                     const module_inst* child_inst) {
+    std::string key = iface_param_memo_key('s', hp, child_inst);
+    if (auto m = iface_param_memo_find(key)) return m->sig;
+    IfaceParamMemo m;
+    m.sig = eval_iface_param_struct_walk(hp, child_inst);
+    return (iface_param_memo[key] = m).sig;
+}
+
+std::string UhdmImporter::eval_bare_iface_param_field(const hier_path* hp,
+                                                      const module_inst* child_inst) {
+    std::string key = iface_param_memo_key('b', hp, child_inst);
+    if (auto m = iface_param_memo_find(key)) return m->str;
+    IfaceParamMemo m;
+    m.str = eval_bare_iface_param_field_walk(hp, child_inst);
+    return (iface_param_memo[key] = m).str;
+}
+
+std::string UhdmImporter::eval_param_struct_field(const hier_path* hp, int* width_out) {
+    std::string key = iface_param_memo_key('p', hp, nullptr);
+    const IfaceParamMemo* found = iface_param_memo_find(key);
+    IfaceParamMemo m;
+    if (found) {
+        m = *found;
+    } else {
+        m.str = eval_param_struct_field_walk(hp, &m.width);
+        iface_param_memo[key] = m;
+    }
+    if (width_out && m.width > 0) *width_out = m.width;
+    return m.str;
+}
+
+bool UhdmImporter::eval_iface_local_const(const interface_inst* iface,
+                                          const UHDM::any* ve, long& out) {
+    std::string key = stringf("l|%p|%p|%p|%p", (const void*)iface, (const void*)ve,
+                              (const void*)current_instance, (const void*)module);
+    const IfaceParamMemo* found = iface_param_memo_find(key);
+    IfaceParamMemo m;
+    if (found) {
+        m = *found;
+    } else {
+        m.ok = eval_iface_local_const_walk(iface, ve, m.value);
+        iface_param_memo[key] = m;
+    }
+    if (m.ok) out = m.value;
+    return m.ok;
+}
+
+// Scalar int value of an interface struct-parameter field ("" on failure).
+RTLIL::SigSpec UhdmImporter::fold_iface_param_via_chain_walk(const hier_path* hp) {
     if (!hp || !hp->Path_elems() || hp->Path_elems()->size() < 2)
         return RTLIL::SigSpec();
     auto& pe = *hp->Path_elems();
@@ -1127,7 +1864,7 @@ RTLIL::SigSpec UhdmImporter::fold_iface_param_via_chain(const hier_path* hp) {
     return RTLIL::SigSpec();
 }
 
-std::string UhdmImporter::eval_iface_param_field(const hier_path* hp,
+std::string UhdmImporter::eval_iface_param_field_walk(const hier_path* hp,
                                           const module_inst* child_inst) {
     const interface_inst* iface = nullptr;
     const expr* val = nullptr;
@@ -1187,7 +1924,7 @@ RTLIL::SigSpec UhdmImporter::struct_param_to_sig(const expr* val,
 // Whole-struct interface parameter field (`man.CFG.BUS`, `man.CFG`): a constant
 // SigSpec built from the struct's field values.  Used by the interface
 // parameter-consistency assertions (`assert (man.CFG.BUS == sub.CFG.BUS)`).
-RTLIL::SigSpec UhdmImporter::eval_iface_param_struct(const hier_path* hp,
+RTLIL::SigSpec UhdmImporter::eval_iface_param_struct_walk(const hier_path* hp,
                                           const module_inst* child_inst) {
     const interface_inst* iface = nullptr;
     const expr* val = nullptr;
@@ -1201,7 +1938,7 @@ RTLIL::SigSpec UhdmImporter::eval_iface_param_struct(const hier_path* hp,
 // parameter into a signal width (`logic [CFG.HSK.DLY-1:0] ...` in tcb_lite_if)
 // WITHOUT a modport prefix, and leaves pe[0]=`CFG`'s Actual_group null.  Find the
 // interface via any of child_inst's interface ports and walk the field chain.
-std::string UhdmImporter::eval_bare_iface_param_field(const hier_path* hp,
+std::string UhdmImporter::eval_bare_iface_param_field_walk(const hier_path* hp,
                                           const module_inst* child_inst) {
     if (!hp || !hp->Path_elems() || hp->Path_elems()->size() < 2 || !child_inst)
         return "";
@@ -1301,7 +2038,7 @@ std::string UhdmImporter::eval_bare_iface_param_field(const hier_path* hp,
 }
 
 // Recursively fold a scalar interface-localparam value expression (see header).
-bool UhdmImporter::eval_iface_local_const(const interface_inst* iface,
+bool UhdmImporter::eval_iface_local_const_walk(const interface_inst* iface,
                                           const UHDM::any* ve, long& out) {
     if (!ve || !iface) return false;
     switch (ve->UhdmType()) {
@@ -1435,7 +2172,7 @@ bool UhdmImporter::eval_iface_local_const(const interface_inst* iface,
 // substitutes `sub.CFG` with the connected interface's `CFG` parameter directly,
 // so the elaborated range reads `[CFG.BUS.DAT-1:0]`.  Resolves via pe[0]'s own
 // Actual_group (no current_instance needed).  "" on failure.
-std::string UhdmImporter::eval_param_struct_field(const hier_path* hp,
+std::string UhdmImporter::eval_param_struct_field_walk(const hier_path* hp,
                                                   int* width_out) {
     if (!hp || !hp->Path_elems() || hp->Path_elems()->size() < 2) return "";
     auto& pe = *hp->Path_elems();
@@ -1753,7 +2490,7 @@ void UhdmImporter::import_module_hierarchy(const module_inst* uhdm_module, bool
                 if (ns_pos != std::string::npos)
                     cell_type = cell_type.substr(ns_pos + 2);
 
-                log("UHDM: Creating techmap cell %s of type %s in parent %s\n",
+                log_uhdm_debug("UHDM: Creating techmap cell %s of type %s in parent %s\n",
                     inst_name.c_str(), cell_type.c_str(), parent_name.c_str());
 
                 // Save/set context for expression evaluation
@@ -1820,7 +2557,7 @@ void UhdmImporter::import_module_hierarchy(const module_inst* uhdm_module, bool
     // Build parameter signature
     std::string param_signature = module_name;
     if (uhdm_module->Param_assigns()) {
-        log("UHDM: Found param_assigns for %s\n", module_name.c_str());
+        log_uhdm_debug("UHDM: Found param_assigns for %s\n", module_name.c_str());
         for (auto param_assign : *uhdm_module->Param_assigns()) {
             if (param_assign->Lhs() && param_assign->Rhs()) {
                 std::string param_name;
@@ -1840,9 +2577,9 @@ void UhdmImporter::import_module_hierarchy(const module_inst* uhdm_module, bool
                     if (auto const_val = dynamic_cast<const constant*>(param_assign->Rhs())) {
                         // Get the actual integer value
                         std::string val_str;
-                        log("UHDM: Constant type: %d\n", const_val->VpiConstType());
-                        log("UHDM: VpiDecompile: '%s'\n", std::string(const_val->VpiDecompile()).c_str());
-                        log("UHDM: VpiValue: '%s'\n", const_val->VpiValue().data());
+                        log_uhdm_debug("UHDM: Constant type: %d\n", const_val->VpiConstType());
+                        log_uhdm_debug("UHDM: VpiDecompile: '%s'\n", std::string(const_val->VpiDecompile()).c_str());
+                        log_uhdm_debug("UHDM: VpiValue: '%s'\n", const_val->VpiValue().data());
                         
                         if (const_val->VpiConstType() == vpiUIntConst || const_val->VpiConstType() == vpiIntConst) {
                             // Use VpiDecompile which contains the actual value
@@ -1853,7 +2590,7 @@ void UhdmImporter::import_module_hierarchy(const module_inst* uhdm_module, bool
                         
                         // If val_str is empty, try to use import_expression
                         if (val_str.empty()) {
-                            log("UHDM: VpiDecompile/VpiValue empty, trying import_expression\n");
+                            log_uhdm_debug("UHDM: VpiDecompile/VpiValue empty, trying import_expression\n");
                             // Save current module context
                             RTLIL::Module* saved_module = this->module;
                             // Create a temporary module for expression evaluation
@@ -1862,7 +2599,7 @@ void UhdmImporter::import_module_hierarchy(const module_inst* uhdm_module, bool
                             RTLIL::SigSpec val_spec = this->import_expression(any_cast<const expr*>(param_assign->Rhs()));
                             if (val_spec.is_fully_const()) {
                                 val_str = std::to_string(val_spec.as_int());
-                                log("UHDM: Got value from import_expression: %s\n", val_str.c_str());
+                                log_uhdm_debug("UHDM: Got value from import_expression: %s\n", val_str.c_str());
                             }
                             
                             // Remove temporary module and restore context
@@ -1871,7 +2608,7 @@ void UhdmImporter::import_module_hierarchy(const module_inst* uhdm_module, bool
                         }
                         
                         param_signature += val_str;
-                        log("UHDM: Added parameter %s=%s to signature\n", param_name.c_str(), val_str.c_str());
+                        log_uhdm_debug("UHDM: Added parameter %s=%s to signature\n", param_name.c_str(), val_str.c_str());
                     } else if (param_assign->Rhs()->UhdmType() == uhdmhier_path) {
                         // Non-constant RHS that's an interface struct-parameter
                         // field (`sub.CFG.BUS.DAT`).  Surelog leaves it as an
@@ -1884,14 +2621,14 @@ void UhdmImporter::import_module_hierarchy(const module_inst* uhdm_module, bool
                             any_cast<const hier_path*>(param_assign->Rhs()),
                             uhdm_module);
                         param_signature += val_str;
-                        log("UHDM: Added hier_path parameter %s=%s to signature\n",
+                        log_uhdm_debug("UHDM: Added hier_path parameter %s=%s to signature\n",
                             param_name.c_str(), val_str.c_str());
                     }
                 }
             }
         }
     } else {
-        log("UHDM: No param_assigns found for %s\n", module_name.c_str());
+        log_uhdm_debug("UHDM: No param_assigns found for %s\n", module_name.c_str());
     }
     
     // Update param_signature to include interface information if needed
@@ -1905,8 +2642,8 @@ void UhdmImporter::import_module_hierarchy(const module_inst* uhdm_module, bool
         imported_module_signatures.insert(param_signature);
 
         // Import the module definition
-        log("UHDM: Final param_signature: %s\n", param_signature.c_str());
-        log("UHDM: Importing module from hierarchy: %s\n", param_signature.c_str());
+        log_uhdm_debug("UHDM: Final param_signature: %s\n", param_signature.c_str());
+        log_uhdm("UHDM: Importing module from hierarchy: %s\n", param_signature.c_str());
         log_flush();
 
         // Save current context before importing child module
@@ -1942,7 +2679,7 @@ void UhdmImporter::import_module_hierarchy(const module_inst* uhdm_module, bool
             module = new_mod;
         }
     } else {
-        log("UHDM: Module definition %s already imported, but will still create instance\n", param_signature.c_str());
+        log_uhdm_debug("UHDM: Module definition %s already imported, but will still create instance\n", param_signature.c_str());
         
         // Look up the existing module so we can create cells
         // First try the parameterized Yosys format
@@ -2009,28 +2746,28 @@ void UhdmImporter::import_module_hierarchy(const module_inst* uhdm_module, bool
         }
         
         if (module) {
-            log("UHDM: Found existing module %s for instance\n", module->name.c_str());
+            log_uhdm_debug("UHDM: Found existing module %s for instance\n", module->name.c_str());
         } else {
-            log("UHDM: WARNING: Could not find module for %s (tried %s)\n", param_signature.c_str(), yosys_modname.c_str());
+            log_uhdm_debug("UHDM: WARNING: Could not find module for %s (tried %s)\n", param_signature.c_str(), yosys_modname.c_str());
         }
     }
     
     // Recursively import child modules through Modules() which contains elaborated instances
     if (uhdm_module->Modules()) {
-        log("UHDM: Found %d child module instances in %s\n", (int)uhdm_module->Modules()->size(), param_signature.c_str());
+        log_uhdm_debug("UHDM: Found %d child module instances in %s\n", (int)uhdm_module->Modules()->size(), param_signature.c_str());
         int child_index = 0;
         for (auto child : *uhdm_module->Modules()) {
-            log("UHDM: Processing child %d: %s (def: %s)\n", child_index++, 
+            log_uhdm_debug("UHDM: Processing child %d: %s (def: %s)\n", child_index++, 
                 child->VpiName().data(), child->VpiDefName().data());
             import_module_hierarchy(child);
         }
     } else {
-        log("UHDM: No child modules found in %s\n", param_signature.c_str());
+        log_uhdm_debug("UHDM: No child modules found in %s\n", param_signature.c_str());
     }
     
     // Also need to import the actual instantiations through RefModule
     // This happens after we've imported all the module definitions
-    log("UHDM: Checking if we should create cell: module=%p, has_parent=%d, create_instances=%d\n", 
+    log_uhdm_debug("UHDM: Checking if we should create cell: module=%p, has_parent=%d, create_instances=%d\n", 
         module, (uhdm_module->VpiParent() != nullptr), create_instances);
     if (create_instances && module && uhdm_module->VpiParent()) {
         // This is a child module instance - we need to create a cell in the parent
@@ -2111,7 +2848,7 @@ void UhdmImporter::import_module_hierarchy(const module_inst* uhdm_module, bool
                                 cell->setPort(RTLIL::escape_id(port_name), conn);
                             }
                         }
-                        log("UHDM: Created internal-cell-type instance '%s' of '%s'\n",
+                        log_uhdm_debug("UHDM: Created internal-cell-type instance '%s' of '%s'\n",
                             inst_name.c_str(), def_base.c_str());
                         this->module = saved_module;
                         this->name_map = saved_name_map;
@@ -2221,7 +2958,7 @@ void UhdmImporter::import_module_hierarchy(const module_inst* uhdm_module, bool
                             real = real.substr(1);
                         if (!real.empty() &&
                             design->module(RTLIL::escape_id(real))) {
-                            log("UHDM: cell_type %s has no module; using resolved "
+                            log_uhdm_debug("UHDM: cell_type %s has no module; using resolved "
                                 "module name %s instead\n", cell_type.c_str(),
                                 real.c_str());
                             cell_type = real;
@@ -2230,7 +2967,7 @@ void UhdmImporter::import_module_hierarchy(const module_inst* uhdm_module, bool
                     }
                 }
 
-                log("UHDM: Creating cell %s of type %s in parent %s\n",
+                log_uhdm_debug("UHDM: Creating cell %s of type %s in parent %s\n",
                     inst_name.c_str(), cell_type.c_str(), parent_name.c_str());
 
                 // If a `bind` causes the same parent module to appear twice in
@@ -2240,7 +2977,7 @@ void UhdmImporter::import_module_hierarchy(const module_inst* uhdm_module, bool
                 // first walk already has its ports wired.
                 RTLIL::IdString cell_id = RTLIL::escape_id(inst_name);
                 if (parent_rtlil_module->cell(cell_id)) {
-                    log("UHDM: Cell %s already exists in %s — skipping duplicate "
+                    log_uhdm_debug("UHDM: Cell %s already exists in %s — skipping duplicate "
                         "creation (likely a second hierarchy view introduced by `bind`)\n",
                         inst_name.c_str(), parent_name.c_str());
                 } else {
@@ -2331,7 +3068,7 @@ void UhdmImporter::import_module_hierarchy(const module_inst* uhdm_module, bool
                                             }
                                         }
                                     }
-                                    if (any) { log("UHDM: Connected whole interface array %s -> port %s[]\n",
+                                    if (any) { log_uhdm_debug("UHDM: Connected whole interface array %s -> port %s[]\n",
                                                    src_base.c_str(), port_name.c_str()); continue; }
                                 }
                             }
@@ -2365,7 +3102,7 @@ void UhdmImporter::import_module_hierarchy(const module_inst* uhdm_module, bool
                                         if (src_w) {
                                             cell->setPort(RTLIL::escape_id(dst_port),
                                                           RTLIL::SigSpec(src_w));
-                                            log("UHDM: Connected interface port %s to wire %s\n",
+                                            log_uhdm_debug("UHDM: Connected interface port %s to wire %s\n",
                                                 dst_port.c_str(), src_full.c_str());
                                         }
                                     }
@@ -2409,7 +3146,7 @@ void UhdmImporter::import_module_hierarchy(const module_inst* uhdm_module, bool
                                         if (src_w) {
                                             cell->setPort(RTLIL::escape_id(dst_port),
                                                           RTLIL::SigSpec(src_w));
-                                            log("UHDM: Connected interface-array element %s -> %s\n",
+                                            log_uhdm_debug("UHDM: Connected interface-array element %s -> %s\n",
                                                 src_full.c_str(), dst_port.c_str());
                                         }
                                     }
@@ -2474,7 +3211,7 @@ void UhdmImporter::import_module_hierarchy(const module_inst* uhdm_module, bool
                                         if (src_w) {
                                             cell->setPort(RTLIL::escape_id(dst_port),
                                                           RTLIL::SigSpec(src_w));
-                                            log("UHDM: Connected interface modport port %s to wire %s\n",
+                                            log_uhdm_debug("UHDM: Connected interface modport port %s to wire %s\n",
                                                 dst_port.c_str(), src_full.c_str());
                                         }
                                     }
@@ -2488,7 +3225,7 @@ void UhdmImporter::import_module_hierarchy(const module_inst* uhdm_module, bool
                             // rp32 SoC: r5p_mouse's unused `tcb_xen` output.
                             if (port->High_conn()->UhdmType() == uhdmoperation &&
                                 any_cast<const operation*>(port->High_conn())->VpiOpType() == vpiNullOp) {
-                                log("UHDM: Port %s has an empty connection (.%s()); leaving unconnected\n",
+                                log_uhdm_debug("UHDM: Port %s has an empty connection (.%s()); leaving unconnected\n",
                                     port_name.c_str(), port_name.c_str());
                                 continue;
                             }
@@ -2520,7 +3257,7 @@ void UhdmImporter::import_module_hierarchy(const module_inst* uhdm_module, bool
                                 }
                                 if (found && nmatch == 1) {
                                     conn = RTLIL::SigSpec(found);
-                                    log("UHDM: interface-signal port %s -> %s\n",
+                                    log_uhdm_debug("UHDM: interface-signal port %s -> %s\n",
                                         port_name.c_str(), found->name.c_str());
                                 }
                             }
@@ -2549,7 +3286,7 @@ void UhdmImporter::import_module_hierarchy(const module_inst* uhdm_module, bool
                                     conn.size() < pw->width &&
                                     ch.wire->width >= pw->width) {
                                     conn = RTLIL::SigSpec(ch.wire, 0, pw->width);
-                                    log("UHDM: port %s part-select under-resolved "
+                                    log_uhdm_debug("UHDM: port %s part-select under-resolved "
                                         "(%d bits); using base %s[%d:0]\n",
                                         port_name.c_str(), ch.width,
                                         ch.wire->name.c_str(), pw->width - 1);
@@ -2573,7 +3310,7 @@ void UhdmImporter::import_module_hierarchy(const module_inst* uhdm_module, bool
                                     signed_wire->is_signed = true;
                                     module->connect(RTLIL::SigSpec(signed_wire), conn);
                                     conn = RTLIL::SigSpec(signed_wire);
-                                    log("UHDM: Created signed intermediate wire for signed constant on port %s\n", port_name.c_str());
+                                    log_uhdm_debug("UHDM: Created signed intermediate wire for signed constant on port %s\n", port_name.c_str());
                                 }
                             }
 
@@ -2589,7 +3326,7 @@ void UhdmImporter::import_module_hierarchy(const module_inst* uhdm_module, bool
                                             RTLIL::State bit_val = conn.as_const()[0];
                                             int port_width = port_wire->width;
                                             conn = RTLIL::SigSpec(RTLIL::Const(bit_val, port_width));
-                                            log("UHDM: Extended unbased unsized literal to port width %d\n", port_width);
+                                            log_uhdm_debug("UHDM: Extended unbased unsized literal to port width %d\n", port_width);
                                         }
                                     }
                                 }
@@ -2625,7 +3362,7 @@ void UhdmImporter::import_module_hierarchy(const module_inst* uhdm_module, bool
                                         if (!has_other_driver)
                                             module->connect(conn, RTLIL::SigSpec(wide).extract(0, n));
                                         conn = RTLIL::SigSpec(wide);
-                                        log("UHDM: Widened narrow output-port connection on '%s' to %d bits%s\n",
+                                        log_uhdm_debug("UHDM: Widened narrow output-port connection on '%s' to %d bits%s\n",
                                             port_name.c_str(), port_wire->width,
                                             has_other_driver ? " (skipping multi-driver back-connect)" : "");
                                     }
@@ -2633,7 +3370,7 @@ void UhdmImporter::import_module_hierarchy(const module_inst* uhdm_module, bool
                             }
 
                             cell->setPort(RTLIL::escape_id(port_name), conn);
-                            log("UHDM: Connected port %s\n", port_name.c_str());
+                            log_uhdm_debug("UHDM: Connected port %s\n", port_name.c_str());
                         }
                     }
                 }
@@ -2667,7 +3404,7 @@ void UhdmImporter::create_parameterized_modules() {
                 module_widths[base_module].insert(width);
                 
                 if (mode_debug)
-                    log("    Found parameterized cell %s/%s: %s with WIDTH=%d\n", 
+                    log_uhdm_debug("    Found parameterized cell %s/%s: %s with WIDTH=%d\n", 
                         mod->name.c_str(), cell->name.c_str(), base_module.c_str(), width);
             }
         }
@@ -2696,7 +3433,7 @@ void UhdmImporter::create_parameterized_modules() {
             }
             
             if (mode_debug)
-                log("    Creating parameterized module: %s\n", param_module_name.c_str());
+                log_uhdm_debug("    Creating parameterized module: %s\n", param_module_name.c_str());
             
             RTLIL::Module* param_mod = design->addModule(param_mod_id);
             
@@ -2704,6 +3441,7 @@ void UhdmImporter::create_parameterized_modules() {
             param_mod->attributes = base_mod->attributes;
             param_mod->avail_parameters = base_mod->avail_parameters;
             param_mod->parameter_default_values = base_mod->parameter_default_values;
+            parameter_version++;
             
             // Add hdlname attribute with the original module name
             param_mod->attributes[RTLIL::escape_id("hdlname")] = RTLIL::Const(base_module_name);
@@ -2712,6 +3450,7 @@ void UhdmImporter::create_parameterized_modules() {
             // Update the WIDTH parameter
             RTLIL::IdString width_param = RTLIL::escape_id("WIDTH");
             param_mod->parameter_default_values[width_param] = RTLIL::Const(width, 32);
+            parameter_version++;
             
             // Wire mapping for connection updates
             std::map<RTLIL::Wire*, RTLIL::Wire*> wire_map;
@@ -2836,7 +3575,7 @@ void UhdmImporter::create_parameterized_modules() {
                 cell->parameters.erase(RTLIL::escape_id("WIDTH"));
                 
                 if (mode_debug)
-                    log("    Updated cell %s/%s to use module %s\n", 
+                    log_uhdm_debug("    Updated cell %s/%s to use module %s\n", 
                         mod->name.c_str(), cell->name.c_str(), param_module_name.c_str());
             }
         }
@@ -2879,14 +3618,14 @@ RTLIL::Wire* UhdmImporter::materialize_flat_struct_array(
     if (elem_w <= 0) return nullptr;
     int row_w = elem_w * inner_count;
     int total_w = row_w * array_size;
-    log("UHDM: flat struct-array '%s': rows=%d row_w=%d total=%d\n",
+    log_uhdm_debug("UHDM: flat struct-array '%s': rows=%d row_w=%d total=%d\n",
         name.c_str(), array_size, row_w, total_w);
     RTLIL::IdString flat_id = RTLIL::escape_id(name);
     RTLIL::Wire* flat_wire = module->wire(flat_id);
     if (flat_wire && flat_wire->width != total_w) {
         // An on-demand reference created a placeholder (1-bit) wire before
         // the array was materialized (CVA6 btb_q) — resize it in place.
-        log("UHDM: flat struct-array '%s': resizing placeholder %d -> %d\n",
+        log_uhdm_debug("UHDM: flat struct-array '%s': resizing placeholder %d -> %d\n",
             name.c_str(), flat_wire->width, total_w);
         flat_wire->width = total_w;
         name_map[name] = flat_wire;
@@ -2905,18 +3644,246 @@ RTLIL::Wire* UhdmImporter::materialize_flat_struct_array(
         flat_wire->attributes[RTLIL::escape_id("unpacked_inner_low")]  = RTLIL::Const(inner_low);
         flat_wire->attributes[RTLIL::escape_id("unpacked_inner_size")] = RTLIL::Const(inner_count);
     }
+    emit_flat_array_rows(name, flat_wire, array_low, array_size, row_w, src_obj);
+    return flat_wire;
+}
+
+void UhdmImporter::emit_flat_array_rows(const std::string& name,
+                                        RTLIL::Wire* flat_wire,
+                                        int array_low, int array_size, int row_w,
+                                        const UHDM::any* src_obj) {
+    // Every row is built: the importer reaches rows by name from many places
+    // (constant and dynamic selects, hier paths, XMRs).  The ones nothing
+    // ended up reading are removed by prune_unread_row_aliases.
+    auto& aliases = flat_array_row_aliases[module];
     for (int i = 0; i < array_size; i++) {
         std::string ename = name + "[" + std::to_string(array_low + i) + "]";
         RTLIL::IdString eid = RTLIL::escape_id(ename);
-        if (!module->wire(eid)) {
-            RTLIL::Wire* ew = module->addWire(eid, row_w);
-            add_src_attribute(ew->attributes, src_obj);
-            module->connect(RTLIL::SigSpec(ew),
-                RTLIL::SigSpec(flat_wire).extract(i * row_w, row_w));
-            name_map[ename] = ew;
+        if (module->wire(eid)) continue;
+        RTLIL::Wire* ew = module->addWire(eid, row_w);
+        add_src_attribute(ew->attributes, src_obj);
+        module->connect(RTLIL::SigSpec(ew),
+            RTLIL::SigSpec(flat_wire).extract(i * row_w, row_w));
+        name_map[ename] = ew;
+        aliases.push_back(eid);
+    }
+}
+
+// Remove the flat-array row aliases that nothing in their module reads or
+// drives.  Runs once every module is imported, so no later by-name lookup
+// (XMR resolution included) can miss a row.  A row counts as used when it
+// appears anywhere but its own alias connection: another connection, a cell
+// port, a process, or a port flag set by an XMR.
+void UhdmImporter::prune_unread_row_aliases() {
+    int pruned = 0, total = 0;
+    for (auto mod : design->modules()) {
+        auto it = flat_array_row_aliases.find(mod);
+        if (it == flat_array_row_aliases.end()) continue;
+        pool<RTLIL::Wire*> rows;
+        for (auto& id : it->second)
+            if (RTLIL::Wire* w = mod->wire(id))
+                if (!w->port_id && !w->port_input && !w->port_output)
+                    rows.insert(w);
+        total += GetSize(it->second);
+        if (rows.empty()) continue;
+
+        pool<RTLIL::Wire*> used;
+        auto mark = [&](const RTLIL::SigSpec& sig) {
+            for (auto& c : sig.chunks())
+                if (c.wire && rows.count(c.wire))
+                    used.insert(c.wire);
+        };
+        auto is_alias = [&](const RTLIL::SigSig& conn) {
+            return conn.first.is_wire() && rows.count(conn.first.as_wire()) &&
+                   !conn.second.is_wire() && conn.second.is_chunk() &&
+                   conn.second.as_chunk().wire && !rows.count(conn.second.as_chunk().wire);
+        };
+        for (auto& conn : mod->connections()) {
+            if (is_alias(conn)) continue;
+            mark(conn.first);
+            mark(conn.second);
+        }
+        for (auto cell : mod->cells())
+            for (auto& conn : cell->connections())
+                mark(conn.second);
+        for (auto& pp : mod->processes) {
+            std::function<void(RTLIL::CaseRule*)> scan_case = [&](RTLIL::CaseRule* cs) {
+                for (auto& a : cs->actions) { mark(a.first); mark(a.second); }
+                for (auto sw : cs->switches) {
+                    mark(sw->signal);
+                    for (auto sc : sw->cases) {
+                        for (auto& cmp : sc->compare) mark(cmp);
+                        scan_case(sc);
+                    }
+                }
+            };
+            scan_case(&pp.second->root_case);
+            for (auto sync : pp.second->syncs) {
+                mark(sync->signal);
+                for (auto& a : sync->actions) { mark(a.first); mark(a.second); }
+                for (auto& mw : sync->mem_write_actions) {
+                    mark(mw.address);
+                    mark(mw.data);
+                    mark(mw.enable);
+                }
+            }
+        }
+
+        pool<RTLIL::Wire*> unread;
+        for (auto w : rows)
+            if (!used.count(w))
+                unread.insert(w);
+        if (unread.empty()) continue;
+        std::vector<RTLIL::SigSig> kept;
+        for (auto& conn : mod->connections())
+            if (!(is_alias(conn) && unread.count(conn.first.as_wire())))
+                kept.push_back(conn);
+        mod->new_connections(kept);
+        mod->remove(unread);
+        pruned += GetSize(unread);
+        if (mod == module) {
+            std::vector<std::string> names;
+            for (auto& it : name_map)
+                if (unread.count(it.second))
+                    names.push_back(it.first);
+            for (auto& n : names)
+                name_map.erase(n);
+            std::vector<const any*> objs;
+            for (auto& it : wire_map)
+                if (unread.count(it.second))
+                    objs.push_back(it.first);
+            for (auto o : objs)
+                wire_map.erase(o);
         }
     }
-    return flat_wire;
+    flat_array_row_aliases.clear();
+    if (pruned)
+        log_uhdm_debug("UHDM: removed %d of %d flat-array row aliases nothing reads\n",
+            pruned, total);
+}
+
+// Remove scratch wires and combinational cells the importer created for this
+// module that nothing reads.  Only `$`-named objects are candidates: ports,
+// user-named signals, `keep` wires and anything the name/wire maps still hand
+// out stay.  Every signal a process touches counts as read (proc lowers those
+// later), and so does every port of a non-internal cell.  Cells are swept
+// only when they are side-effect-free internal cells whose outputs all land
+// on removable wires, which may in turn free their inputs — iterate.
+void UhdmImporter::sweep_import_scratch() {
+    if (!module || !mode_import_sweep) return;
+
+    pool<RTLIL::Wire*> pinned;
+    for (auto& kv : name_map) if (kv.second) pinned.insert(kv.second);
+    for (auto& kv : wire_map) if (kv.second) pinned.insert(kv.second);
+    for (auto& kv : comb_signal_temp_map) if (kv.second) pinned.insert(kv.second);
+    for (auto& kv : sync_assignment_targets) if (kv.second) pinned.insert(kv.second);
+
+    auto add_sig = [](pool<RTLIL::Wire*>& out, const RTLIL::SigSpec& sig) {
+        for (auto& chunk : sig.chunks())
+            if (chunk.wire) out.insert(chunk.wire);
+    };
+    std::function<void(const RTLIL::CaseRule*)> pin_case = [&](const RTLIL::CaseRule* cr) {
+        for (auto& c : cr->compare) add_sig(pinned, c);
+        for (auto& act : cr->actions) { add_sig(pinned, act.first); add_sig(pinned, act.second); }
+        for (auto sw : cr->switches) {
+            add_sig(pinned, sw->signal);
+            for (auto child : sw->cases) pin_case(child);
+        }
+    };
+    for (auto& kv : module->processes) {
+        pin_case(&kv.second->root_case);
+        for (auto sync : kv.second->syncs) {
+            add_sig(pinned, sync->signal);
+            for (auto& act : sync->actions) { add_sig(pinned, act.first); add_sig(pinned, act.second); }
+            for (auto& mw : sync->mem_write_actions) {
+                add_sig(pinned, mw.address);
+                add_sig(pinned, mw.data);
+                add_sig(pinned, mw.enable);
+            }
+        }
+    }
+
+    auto removable_wire = [&](RTLIL::Wire* w) {
+        return !w->name.isPublic() && w->port_id == 0 &&
+               !w->get_bool_attribute(ID::keep) && !pinned.count(w);
+    };
+
+    CellTypes ct;
+    ct.setup_internals_eval();
+
+    int removed_wires = 0, removed_cells = 0;
+    for (bool changed = true; changed;) {
+        changed = false;
+
+        // Reader index: wires with a bit read by a cell input, a connection
+        // RHS, or any port of a cell we don't model.
+        pool<RTLIL::Wire*> read;
+        for (auto cell : module->cells()) {
+            bool known = ct.cell_known(cell->type);
+            for (auto& conn : cell->connections())
+                if (!known || ct.cell_input(cell->type, conn.first))
+                    add_sig(read, conn.second);
+        }
+        for (auto& conn : module->connections())
+            add_sig(read, conn.second);
+
+        auto dead_wire = [&](RTLIL::Wire* w) {
+            return removable_wire(w) && !read.count(w);
+        };
+        auto all_dead = [&](const RTLIL::SigSpec& sig) {
+            for (auto& chunk : sig.chunks())
+                if (chunk.wire && !dead_wire(chunk.wire)) return false;
+            return true;
+        };
+
+        std::vector<RTLIL::Cell*> dead_cells;
+        for (auto cell : module->cells()) {
+            if (cell->name.isPublic() || !ct.cell_known(cell->type)) continue;
+            bool dead = true;
+            for (auto& conn : cell->connections())
+                if (ct.cell_output(cell->type, conn.first) && !all_dead(conn.second)) {
+                    dead = false;
+                    break;
+                }
+            if (dead) dead_cells.push_back(cell);
+        }
+        for (auto cell : dead_cells) module->remove(cell);
+        removed_cells += GetSize(dead_cells);
+
+        // Connections that only drive dead wires go too.
+        std::vector<RTLIL::SigSig> kept_conns;
+        bool dropped_conn = false;
+        for (auto& conn : module->connections()) {
+            if (all_dead(conn.first)) { dropped_conn = true; continue; }
+            kept_conns.push_back(conn);
+        }
+        if (dropped_conn) module->new_connections(kept_conns);
+
+        // Wires: dead, and no longer driven by a surviving cell.
+        pool<RTLIL::Wire*> driven;
+        for (auto cell : module->cells())
+            for (auto& conn : cell->connections())
+                if (!ct.cell_known(cell->type) || ct.cell_output(cell->type, conn.first))
+                    add_sig(driven, conn.second);
+        for (auto& conn : module->connections())
+            add_sig(driven, conn.first);
+        pool<RTLIL::Wire*> dead_wires;
+        for (auto w : module->wires())
+            if (dead_wire(w) && !driven.count(w)) dead_wires.insert(w);
+        if (!dead_wires.empty()) {
+            module->remove(dead_wires);
+            removed_wires += GetSize(dead_wires);
+        }
+
+        changed = !dead_cells.empty() || dropped_conn || !dead_wires.empty();
+    }
+
+    // Cached decoders and expressions may have been swept with their readers.
+    dyn_index_decoders.clear();
+    expr_cache.clear();
+    if (removed_wires || removed_cells)
+        log_uhdm_debug("UHDM: import sweep of %s removed %d scratch wires, %d dead cells\n",
+            log_id(module), removed_wires, removed_cells);
 }
 
 // Import a single module
@@ -2952,6 +3919,8 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
         return;
     }
     
+    UhdmTraceSpan span("import_module", uhdm_trace_on ? std::string(uhdm_module->VpiDefName()) : std::string());
+
     // Set current instance context for expression evaluation
     const module_inst* saved_instance = current_instance;
     current_instance = uhdm_module;
@@ -2962,7 +3931,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
     }
     
     // Debug and validation
-    log("UHDM: Processing module, VpiDefName() returns: '%s', VpiName() returns: '%s'\n", 
+    log_uhdm_debug("UHDM: Processing module, VpiDefName() returns: '%s', VpiName() returns: '%s'\n", 
         base_modname.c_str(), 
         uhdm_module->VpiName().data() ? uhdm_module->VpiName().data() : "<null>");
     
@@ -2970,7 +3939,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
     if (base_modname.empty()) {
         base_modname = std::string(uhdm_module->VpiName());
         if (!base_modname.empty()) {
-            log("UHDM: Using VpiName: '%s'\n", base_modname.c_str());
+            log_uhdm_debug("UHDM: Using VpiName: '%s'\n", base_modname.c_str());
         } else {
             log_warning("UHDM: Module has empty name, using default name 'unnamed_module'\n");
             base_modname = "unnamed_module";
@@ -2980,7 +3949,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
     // Strip work@ prefix if present
     if (base_modname.find("work@") == 0) {
         base_modname = base_modname.substr(5); // Remove "work@"
-        log("UHDM: Stripped work@ prefix, using: '%s'\n", base_modname.c_str());
+        log_uhdm_debug("UHDM: Stripped work@ prefix, using: '%s'\n", base_modname.c_str());
     }
     
     // Build parameterized module name if parameters exist
@@ -3081,7 +4050,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
     RTLIL::IdString mod_id = RTLIL::escape_id(modname);
     
     if (mode_debug)
-        log("Importing module: %s (ID: %s)\n", modname.c_str(), mod_id.c_str());
+        log_uhdm_debug("Importing module: %s (ID: %s)\n", modname.c_str(), mod_id.c_str());
     
     // Check if module already exists (e.g., from AllModules import)
     if (design->module(mod_id)) {
@@ -3094,18 +4063,23 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                 std::string netname = std::string(net->VpiName());
                 RTLIL::Wire* w = existing_mod->wire(RTLIL::escape_id(netname));
                 if (w && !w->is_signed && net->VpiSigned()) {
-                    log("UHDM: Updating wire '%s' signedness in existing module %s from elaborated net\n",
+                    log_uhdm_debug("UHDM: Updating wire '%s' signedness in existing module %s from elaborated net\n",
                         netname.c_str(), modname.c_str());
                     w->is_signed = true;
                 }
             }
         }
         if (mode_debug)
-            log("Module %s already exists, updated signedness from elaborated nets\n", modname.c_str());
+            log_uhdm_debug("Module %s already exists, updated signedness from elaborated nets\n", modname.c_str());
         return;
     }
     
     module = design->addModule(mod_id);
+    dyn_index_decoders.clear();
+    expr_cache.clear();
+    expr_cache_proc = nullptr;
+    expr_cache_pure.clear();
+    HeatmapScope heat(this, uhdm_module);
     
     // Mark that cells have not been processed yet (similar to AST frontend)
     module->set_bool_attribute(ID::cells_not_processed);
@@ -3121,17 +4095,17 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
     
     // Import parameters
     if (uhdm_module->Parameters()) {
-        log("UHDM: Found %d parameters to import\n", (int)uhdm_module->Parameters()->size());
+        log_uhdm_debug("UHDM: Found %d parameters to import\n", (int)uhdm_module->Parameters()->size());
         for (auto param : *uhdm_module->Parameters()) {
             std::string param_name = std::string(param->VpiName());
-            log("UHDM: About to import parameter: '%s'\n", param_name.c_str());
+            log_uhdm_debug("UHDM: About to import parameter: '%s'\n", param_name.c_str());
             import_parameter(param);
         }
     }
 
     // Import parameter overrides (param_assigns)
     if (uhdm_module->Param_assigns()) {
-        log("UHDM: Found %d parameter assignments to import\n", (int)uhdm_module->Param_assigns()->size());
+        log_uhdm_debug("UHDM: Found %d parameter assignments to import\n", (int)uhdm_module->Param_assigns()->size());
         for (auto param_assign : *uhdm_module->Param_assigns()) {
             if (param_assign->Lhs() && param_assign->Rhs()) {
                 std::string param_name;
@@ -3141,7 +4115,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                 }
                 
                 if (!param_name.empty()) {
-                    log("UHDM: Processing parameter assignment for '%s'\n", param_name.c_str());
+                    log_uhdm_debug("UHDM: Processing parameter assignment for '%s'\n", param_name.c_str());
 
                     // Get the assigned value
                     auto rhs_expr = any_cast<const expr*>(param_assign->Rhs());
@@ -3188,7 +4162,8 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                             module->avail_parameters(param_id);
                         }
                         module->parameter_default_values[param_id] = param_value;
-                        log("UHDM: Updated parameter '%s' to value %s\n",
+                        parameter_version++;
+                        log_uhdm_debug("UHDM: Updated parameter '%s' to value %s\n",
                             param_name.c_str(), param_value.as_string().c_str());
                     } else {
                         log_warning("UHDM: Parameter assignment for '%s' has non-constant value\n",
@@ -3201,7 +4176,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
     
     // Import ports
     if (uhdm_module->Ports()) {
-        log("UHDM: Found %d ports to import\n", (int)uhdm_module->Ports()->size());
+        log_uhdm_debug("UHDM: Found %d ports to import\n", (int)uhdm_module->Ports()->size());
         int import_port_idx = 0;
         for (auto port : *uhdm_module->Ports()) {
             import_port_idx++;
@@ -3213,13 +4188,13 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                 any* actual = ref->Actual_group();
                 if (actual) {
                     if (actual->UhdmType() == uhdminterface_inst) {
-                        //log("UHDM: Skip importing port as it is an interface: '%s'\n", port_name.c_str());
+                        //log_uhdm_debug("UHDM: Skip importing port as it is an interface: '%s'\n", port_name.c_str());
                         //continue;
                     }
                 }
               }
             }
-            log("UHDM: About to import port: '%s'\n", port_name.c_str());
+            log_uhdm_debug("UHDM: About to import port: '%s'\n", port_name.c_str());
             import_port(port, import_port_idx);
         }
     }
@@ -3257,7 +4232,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                 if (c.size() != w->width)
                     c = c.extract(0, w->width, RTLIL::State::S0);  // zero-extend/truncate
                 w->attributes[RTLIL::ID::init] = c;
-                log("UHDM: Set \\init on output port '%s' = %s\n",
+                log_uhdm_debug("UHDM: Set \\init on output port '%s' = %s\n",
                     std::string(dp->VpiName()).c_str(), c.as_string().c_str());
             }
             break;
@@ -3437,7 +4412,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
         for (const auto& name : any_access) {
             if (!clocked_access.count(name)) {
                 comb_only_arrays.insert(name);
-                log("UHDM: Array '%s' used only in combinational always blocks -> expand to wires\n", name.c_str());
+                log_uhdm_debug("UHDM: Array '%s' used only in combinational always blocks -> expand to wires\n", name.c_str());
             }
         }
     }
@@ -3540,7 +4515,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
     std::vector<std::pair<const UHDM::any*, RTLIL::Wire*>> vars_with_init_expr;
 
     if (uhdm_module->Variables()) {
-        log("UHDM: Found %d variables to import\n", (int)uhdm_module->Variables()->size());
+        log_uhdm_debug("UHDM: Found %d variables to import\n", (int)uhdm_module->Variables()->size());
         
         // First pass: Create all wires without initial values
         for (auto var : *uhdm_module->Variables()) {
@@ -3548,20 +4523,20 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
             if (var->UhdmType() == uhdmarray_var) {
                 auto array_var = any_cast<const UHDM::array_var*>(var);
                 std::string array_name = std::string(array_var->VpiName());
-                log("UHDM: Found array_var: '%s'\n", array_name.c_str());
+                log_uhdm_debug("UHDM: Found array_var: '%s'\n", array_name.c_str());
                 
                 // Check if it should be imported as memory
                 // An array should be a memory if:
                 // 1. It has both packed and unpacked dimensions (checked by is_memory_array), AND
                 // 2. It has at least one non-constant array access
-                log("UHDM: Checking if array_var '%s' should be memory...\n", array_name.c_str());
+                log_uhdm_debug("UHDM: Checking if array_var '%s' should be memory...\n", array_name.c_str());
                 bool is_mem = is_memory_array(array_var);
-                log("UHDM: is_memory_array returned %s for '%s'\n", is_mem ? "true" : "false", array_name.c_str());
+                log_uhdm_debug("UHDM: is_memory_array returned %s for '%s'\n", is_mem ? "true" : "false", array_name.c_str());
                 bool has_const_only = true;
                 if (is_mem) {
-                    log("UHDM: Checking access patterns for '%s'...\n", array_name.c_str());
+                    log_uhdm_debug("UHDM: Checking access patterns for '%s'...\n", array_name.c_str());
                     has_const_only = has_only_constant_array_accesses(array_name);
-                    log("UHDM: has_only_constant_array_accesses returned %s for '%s'\n", has_const_only ? "true" : "false", array_name.c_str());
+                    log_uhdm_debug("UHDM: has_only_constant_array_accesses returned %s for '%s'\n", has_const_only ? "true" : "false", array_name.c_str());
                 }
                 // Arrays that are only accessed from combinational always blocks must NOT
                 // be $memory objects: they need individual element wires so that
@@ -3578,7 +4553,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                 bool should_be_memory = is_mem && !has_const_only && !is_comb_only && !whole_accessed_var;
 
                 if (should_be_memory) {
-                    log("UHDM: Array_var '%s' detected as memory array (has dynamic indexing)\n", array_name.c_str());
+                    log_uhdm_debug("UHDM: Array_var '%s' detected as memory array (has dynamic indexing)\n", array_name.c_str());
                     create_memory_from_array(array_var);
                 } else if (is_memory_array(array_var) &&
                            (whole_array_accessed_names.count(array_name) ||
@@ -3628,7 +4603,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                     if (dims_ok && elem_w > 0) {
                         int row_w = elem_w * inner_count;
                         int total_w = row_w * array_size;
-                        log("UHDM: Array_var '%s' whole/multi-dim — flat wire "
+                        log_uhdm_debug("UHDM: Array_var '%s' whole/multi-dim — flat wire "
                             "(rows=%d, row_w=%d, total=%d) + per-row slices\n",
                             array_name.c_str(), array_size, row_w, total_w);
                         RTLIL::IdString flat_id = RTLIL::escape_id(array_name);
@@ -3646,18 +4621,8 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                                 flat_wire->attributes[RTLIL::escape_id("unpacked_inner_size")] = RTLIL::Const(inner_count);
                             }
                         }
-                        for (int i = 0; i < array_size; i++) {
-                            std::string ename =
-                                array_name + "[" + std::to_string(array_low + i) + "]";
-                            RTLIL::IdString eid = RTLIL::escape_id(ename);
-                            if (!module->wire(eid)) {
-                                RTLIL::Wire* ew = module->addWire(eid, row_w);
-                                add_src_attribute(ew->attributes, array_var);
-                                module->connect(RTLIL::SigSpec(ew),
-                                    RTLIL::SigSpec(flat_wire).extract(i * row_w, row_w));
-                                name_map[ename] = ew;
-                            }
-                        }
+                        emit_flat_array_rows(array_name, flat_wire, array_low,
+                                             array_size, row_w, array_var);
                     } else {
                         log_warning("UHDM: Array_var '%s' whole/multi-dim with "
                                     "non-constant dims — left unmaterialized\n",
@@ -3667,9 +4632,9 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                     // Has both packed and unpacked dimensions but only constant accesses,
                     // OR is a comb-only array with dynamic access — create individual element wires.
                     if (is_comb_only)
-                        log("UHDM: Array_var '%s' is comb-only, creating individual registers\n", array_name.c_str());
+                        log_uhdm_debug("UHDM: Array_var '%s' is comb-only, creating individual registers\n", array_name.c_str());
                     else
-                        log("UHDM: Array_var '%s' has only constant accesses, creating individual registers\n", array_name.c_str());
+                        log_uhdm_debug("UHDM: Array_var '%s' has only constant accesses, creating individual registers\n", array_name.c_str());
 
                     // Get the array dimensions
                     auto ranges = array_var->Ranges();
@@ -3717,7 +4682,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                                 RTLIL::Wire* wire = module->addWire(wire_id, element_width);
                                 add_src_attribute(wire->attributes, array_var);
                                 name_map[element_name] = wire;
-                                log("UHDM: Created wire '%s' (width=%d) for array element\n", wire->name.c_str(), element_width);
+                                log_uhdm_debug("UHDM: Created wire '%s' (width=%d) for array element\n", wire->name.c_str(), element_width);
                             }
                         }
                     }
@@ -3733,7 +4698,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                     bool is_1d = ranges && ranges->size() == 1;
                     bool whole_accessed = whole_array_accessed_names.count(array_name) > 0;
                     if (is_1d && !whole_accessed) {
-                        log("UHDM: Array_var '%s' is 1D unpacked with bit-select-only access, creating individual wires\n", array_name.c_str());
+                        log_uhdm_debug("UHDM: Array_var '%s' is 1D unpacked with bit-select-only access, creating individual wires\n", array_name.c_str());
                         int array_size = 1;
                         int array_low = 0;
                         bool array_ascending = false;  // left < right, e.g. [1:6]
@@ -3769,7 +4734,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                                 add_src_attribute(wire->attributes, var);
                                 name_map[element_name] = wire;
                                 element_wires[i] = wire;
-                                log("UHDM: Created wire '%s' (width=%d) for unpacked-array_var element\n",
+                                log_uhdm_debug("UHDM: Created wire '%s' (width=%d) for unpacked-array_var element\n",
                                     wire->name.c_str(), element_width);
                             } else {
                                 element_wires[i] = module->wire(wire_id);
@@ -3781,10 +4746,10 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                         // Pattern values follow SV ordering: first
                         // operand drives the HIGH index, last operand
                         // the LOW index (`a[1] = 8'h12`, `a[0] = 8'h34`).
-                        log("UHDM: Array_var '%s' init check: Expr=%p\n",
+                        log_uhdm_debug("UHDM: Array_var '%s' init check: Expr=%p\n",
                             array_name.c_str(), (void*)array_var->Expr());
                         if (auto init_any = array_var->Expr()) {
-                            log("UHDM: Init type: %s op_type=%d\n",
+                            log_uhdm_debug("UHDM: Init type: %s op_type=%d\n",
                                 UhdmName(init_any->UhdmType()).c_str(),
                                 init_any->UhdmType() == uhdmoperation
                                     ? any_cast<const UHDM::operation*>(init_any)->VpiOpType() : -1);
@@ -3875,7 +4840,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                             }
                             if (total > width) width = total;
                         }
-                        log("UHDM: Array_var '%s' has whole-array or multi-dim access, creating %d-bit wire (from typespec)\n",
+                        log_uhdm_debug("UHDM: Array_var '%s' has whole-array or multi-dim access, creating %d-bit wire (from typespec)\n",
                             array_name.c_str(), width);
                         RTLIL::IdString wire_id = RTLIL::escape_id(array_name);
                         if (!module->wire(wire_id)) {
@@ -3883,7 +4848,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                             wire_map[var] = wire;
                             name_map[array_name] = wire;
                             add_src_attribute(wire->attributes, var);
-                            log("UHDM: Created wire '%s' (width=%d) for array_var\n",
+                            log_uhdm_debug("UHDM: Created wire '%s' (width=%d) for array_var\n",
                                 wire->name.c_str(), width);
 
                             // Stash multi-dim metadata on the wire so
@@ -4004,7 +4969,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                 // Regular variable
                 std::string var_name = std::string(var->VpiName());
                 int width = get_width(var, uhdm_module);
-                log("UHDM: Importing variable '%s' (width=%d)\n", var_name.c_str(), width);
+                log_uhdm_debug("UHDM: Importing variable '%s' (width=%d)\n", var_name.c_str(), width);
                 
                 // Check if this wire already exists (might have been created as a port)
                 RTLIL::IdString wire_id = RTLIL::escape_id(var_name);
@@ -4055,7 +5020,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                             wire->attributes[RTLIL::escape_id("packed_elem_width")] = RTLIL::Const(elem_w);
                             wire->attributes[RTLIL::escape_id("packed_outer_left")] = RTLIL::Const(outer_l);
                             wire->attributes[RTLIL::escape_id("packed_outer_right")] = RTLIL::Const(outer_r);
-                            log("UHDM: packed_array_var '%s' elem_width=%d outer=[%d:%d]\n",
+                            log_uhdm_debug("UHDM: packed_array_var '%s' elem_width=%d outer=[%d:%d]\n",
                                 var_name.c_str(), elem_w, outer_l, outer_r);
                         }
                     }
@@ -4093,7 +5058,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                                 // Set the attribute value using import_attribute_value
                                 wire->attributes[RTLIL::escape_id(attr_name)] = import_attribute_value(attr);
                                 if (mode_debug)
-                                    log("UHDM: Added attribute '%s' to variable '%s'\n", attr_name.c_str(), var_name.c_str());
+                                    log_uhdm_debug("UHDM: Added attribute '%s' to variable '%s'\n", attr_name.c_str(), var_name.c_str());
                             }
                             if (!formal_cell.empty()) {
                                 std::string cell_name = formal_cell + "$" +
@@ -4110,7 +5075,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                                 cell->attributes[RTLIL::escape_id("reg")] =
                                     RTLIL::Const(var_name);
                                 if (mode_debug)
-                                    log("UHDM: Created %s cell '%s' driving wire '%s' (WIDTH=%d)\n",
+                                    log_uhdm_debug("UHDM: Created %s cell '%s' driving wire '%s' (WIDTH=%d)\n",
                                         formal_cell.c_str(), cell_name.c_str(),
                                         var_name.c_str(), width);
                             }
@@ -4138,7 +5103,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                                         
                                         if (!type_name.empty()) {
                                             wire->attributes[RTLIL::escape_id("wiretype")] = RTLIL::escape_id(type_name);
-                                            log("UHDM: Added wiretype attribute '\\%s' to enum variable '%s'\n", type_name.c_str(), wire->name.c_str());
+                                            log_uhdm_debug("UHDM: Added wiretype attribute '\\%s' to enum variable '%s'\n", type_name.c_str(), wire->name.c_str());
                                         }
                                         
                                         // Add enum_type attribute
@@ -4164,7 +5129,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                                                 
                                                 // Set the attribute value to the enum constant name
                                                 wire->attributes[RTLIL::escape_id(attr_name)] = RTLIL::Const("\\" + const_name);
-                                                log("UHDM: Added enum attribute %s = \\%s to enum variable '%s'\n", 
+                                                log_uhdm_debug("UHDM: Added enum attribute %s = \\%s to enum variable '%s'\n", 
                                                     attr_name.c_str(), const_name.c_str(), wire->name.c_str());
                                             }
                                         }
@@ -4175,7 +5140,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                             // Skip initial expression processing here - will be handled in module import
                             // The enum constants don't exist yet at this point
                             if (enum_var->Expr()) {
-                                log("UHDM: Enum variable '%s' has initial expression - will be handled in module import\n", var_name.c_str());
+                                log_uhdm_debug("UHDM: Enum variable '%s' has initial expression - will be handled in module import\n", var_name.c_str());
                                 // Don't add to vars_with_init_expr - we can't process it here
                                 // vars_with_init_expr.push_back(std::make_pair(var, wire));
                             }
@@ -4196,7 +5161,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                                 // Add wiretype attribute for any typedef'd type
                                 if (!wiretype_name.empty()) {
                                     wire->attributes[RTLIL::escape_id("wiretype")] = RTLIL::escape_id(wiretype_name);
-                                    log("UHDM: Added wiretype attribute '\\%s' to wire '%s'\n", wiretype_name.c_str(), wire->name.c_str());
+                                    log_uhdm_debug("UHDM: Added wiretype attribute '\\%s' to wire '%s'\n", wiretype_name.c_str(), wire->name.c_str());
                                 }
                                 
                                 // Check for signed attribute
@@ -4205,13 +5170,13 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                                     case uhdmlogic_typespec:
                                         if (auto logic_ts = dynamic_cast<const UHDM::logic_typespec*>(actual_typespec)) {
                                             is_signed = logic_ts->VpiSigned();
-                                            log("UHDM: Variable '%s' logic_typespec VpiSigned=%d\n", var_name.c_str(), is_signed);
+                                            log_uhdm_debug("UHDM: Variable '%s' logic_typespec VpiSigned=%d\n", var_name.c_str(), is_signed);
                                         }
                                         break;
                                     case uhdmint_typespec:
                                         if (auto int_ts = dynamic_cast<const UHDM::int_typespec*>(actual_typespec)) {
                                             is_signed = int_ts->VpiSigned();
-                                            log("UHDM: Variable '%s' int_typespec VpiSigned=%d\n", var_name.c_str(), is_signed);
+                                            log_uhdm_debug("UHDM: Variable '%s' int_typespec VpiSigned=%d\n", var_name.c_str(), is_signed);
                                         }
                                         break;
                                     default:
@@ -4220,27 +5185,27 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                                 
                                 if (is_signed) {
                                     wire->is_signed = true;
-                                    log("UHDM: Variable '%s' is signed, setting is_signed=true\n", var_name.c_str());
+                                    log_uhdm_debug("UHDM: Variable '%s' is signed, setting is_signed=true\n", var_name.c_str());
                                 }
                             }
                         }
                         
                         // Defer initial expression processing to second pass
                         if (logic_var->Expr()) {
-                            log("UHDM: Variable '%s' has initial expression - deferring to second pass\n", var_name.c_str());
+                            log_uhdm_debug("UHDM: Variable '%s' has initial expression - deferring to second pass\n", var_name.c_str());
                             vars_with_init_expr.push_back(std::make_pair(var, wire));
                         }
                     } else if (auto struct_v = dynamic_cast<const UHDM::struct_var*>(var)) {
                         // Handle signedness for struct packed signed
                         if (struct_v->VpiSigned()) {
                             wire->is_signed = true;
-                            log("UHDM: struct_var '%s' VpiSigned=1, setting is_signed=true\n", var_name.c_str());
+                            log_uhdm_debug("UHDM: struct_var '%s' VpiSigned=1, setting is_signed=true\n", var_name.c_str());
                         }
                         // Packed struct with an aggregate initializer
                         // (`hw2reg_wrap_t hw2reg_wrap = {c, d}`): drive the
                         // flattened wire with the (constant) init expression.
                         if (struct_v->Expr()) {
-                            log("UHDM: struct_var '%s' has initializer - deferring to second pass\n", var_name.c_str());
+                            log_uhdm_debug("UHDM: struct_var '%s' has initializer - deferring to second pass\n", var_name.c_str());
                             vars_with_init_expr.push_back(std::make_pair(var, wire));
                         }
                     } else if (auto union_v = dynamic_cast<const UHDM::union_var*>(var)) {
@@ -4255,12 +5220,12 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                             }
                             if (!wiretype_name.empty()) {
                                 wire->attributes[RTLIL::escape_id("wiretype")] = RTLIL::escape_id(wiretype_name);
-                                log("UHDM: Added wiretype attribute '\\%s' to union_var '%s'\n", wiretype_name.c_str(), var_name.c_str());
+                                log_uhdm_debug("UHDM: Added wiretype attribute '\\%s' to union_var '%s'\n", wiretype_name.c_str(), var_name.c_str());
                             }
                         }
                         if (union_v->VpiSigned()) {
                             wire->is_signed = true;
-                            log("UHDM: union_var '%s' VpiSigned=1, setting is_signed=true\n", var_name.c_str());
+                            log_uhdm_debug("UHDM: union_var '%s' VpiSigned=1, setting is_signed=true\n", var_name.c_str());
                         }
                     } else if (var->UhdmType() == uhdminteger_var ||
                                var->UhdmType() == uhdmint_var ||
@@ -4269,11 +5234,11 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                                var->UhdmType() == uhdmlong_int_var) {
                         // Built-in signed types: integer, int, byte, shortint, longint
                         wire->is_signed = true;
-                        log("UHDM: Variable '%s' is built-in signed type, setting is_signed=true\n", var_name.c_str());
+                        log_uhdm_debug("UHDM: Variable '%s' is built-in signed type, setting is_signed=true\n", var_name.c_str());
                         // Defer initial expression to second pass
                         if (auto v = dynamic_cast<const UHDM::variables*>(var)) {
                             if (v->Expr()) {
-                                log("UHDM: Variable '%s' has initial expression - deferring to second pass\n", var_name.c_str());
+                                log_uhdm_debug("UHDM: Variable '%s' has initial expression - deferring to second pass\n", var_name.c_str());
                                 vars_with_init_expr.push_back(std::make_pair(var, wire));
                             }
                         }
@@ -4283,13 +5248,13 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                         // continuous assignment.  Defer driving it.
                         if (auto pav = dynamic_cast<const UHDM::packed_array_var*>(var)) {
                             if (pav->Expr()) {
-                                log("UHDM: packed_array_var '%s' has initializer - deferring to second pass\n", var_name.c_str());
+                                log_uhdm_debug("UHDM: packed_array_var '%s' has initializer - deferring to second pass\n", var_name.c_str());
                                 vars_with_init_expr.push_back(std::make_pair(var, wire));
                             }
                         }
                     }
 
-                    log("UHDM: Created wire '%s' for variable\n", wire->name.c_str());
+                    log_uhdm_debug("UHDM: Created wire '%s' for variable\n", wire->name.c_str());
                 } else {
                     // Wire already exists, but check if we need to handle initial expression
                     RTLIL::Wire* existing_wire = module->wire(wire_id);
@@ -4300,12 +5265,12 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                         // Defer initial expression processing for existing wire to second pass
                         if (auto logic_var = dynamic_cast<const UHDM::logic_var*>(var)) {
                             if (logic_var->Expr()) {
-                                log("UHDM: Existing variable '%s' has initial expression - deferring to second pass\n", var_name.c_str());
+                                log_uhdm_debug("UHDM: Existing variable '%s' has initial expression - deferring to second pass\n", var_name.c_str());
                                 vars_with_init_expr.push_back(std::make_pair(var, existing_wire));
                             }
                         }
                     }
-                    log("UHDM: Variable '%s' already exists as wire, skipping\n", var_name.c_str());
+                    log_uhdm_debug("UHDM: Variable '%s' already exists as wire, skipping\n", var_name.c_str());
                 }
             }
         }
@@ -4320,14 +5285,14 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                 RTLIL::IdString wid = RTLIL::escape_id(std::string(uhdm_net->VpiName()));
                 RTLIL::Wire* w = module->wire(wid);
                 if (w && !w->is_signed) {
-                    log("UHDM: Pre-pass: setting is_signed on '%s' from net VpiSigned\n", wid.c_str());
+                    log_uhdm_debug("UHDM: Pre-pass: setting is_signed on '%s' from net VpiSigned\n", wid.c_str());
                     w->is_signed = true;
                 }
             }
         }
 
         // Second pass: Process initial expressions now that all variables exist
-        log("UHDM: Processing %d deferred initial expressions\n", (int)vars_with_init_expr.size());
+        log_uhdm_debug("UHDM: Processing %d deferred initial expressions\n", (int)vars_with_init_expr.size());
         for (const auto& [var, wire] : vars_with_init_expr) {
             std::string var_name = std::string(var->VpiName());
             
@@ -4339,7 +5304,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
             if (false) { // Keep this code for reference but disabled
                 if (auto enum_var = any_cast<const UHDM::enum_var*>(var)) {
                     if (enum_var->Expr()) {
-                        log("UHDM: Processing initial expression for enum variable '%s'\n", var_name.c_str());
+                        log_uhdm_debug("UHDM: Processing initial expression for enum variable '%s'\n", var_name.c_str());
                         RTLIL::SigSpec init_value = import_expression(enum_var->Expr());
                         if (init_value.size() > 0) {
                             // Check if this is a reference to another wire with an init value
@@ -4348,7 +5313,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                                 RTLIL::Wire* ref_wire = init_value.as_wire();
                                 if (ref_wire && ref_wire->attributes.count(RTLIL::escape_id("init"))) {
                                     init_value = RTLIL::SigSpec(ref_wire->attributes.at(RTLIL::escape_id("init")));
-                                    log("UHDM: Resolved initial value from referenced wire '%s'\n", ref_wire->name.c_str());
+                                    log_uhdm_debug("UHDM: Resolved initial value from referenced wire '%s'\n", ref_wire->name.c_str());
                                 }
                             }
                             
@@ -4371,13 +5336,13 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                                 } else {
                                     init_value.extend_u0(lhs.size(), false);
                                 }
-                                log("UHDM: Resized initial value from %d bits to %d bits for enum variable '%s'\n", 
+                                log_uhdm_debug("UHDM: Resized initial value from %d bits to %d bits for enum variable '%s'\n", 
                                     orig_size, lhs.size(), var_name.c_str());
                             }
                             
                             if (init_value.is_fully_const()) {
                                 wire->attributes[RTLIL::escape_id("init")] = init_value.as_const();
-                                log("UHDM: Set init attribute for enum variable '%s' to %s\n", 
+                                log_uhdm_debug("UHDM: Set init attribute for enum variable '%s' to %s\n", 
                                     var_name.c_str(), init_value.as_const().as_string().c_str());
                             } else {
                                 log_warning("Initial value for enum variable '%s' is not constant after resolution, skipping\n", var_name.c_str());
@@ -4387,7 +5352,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                 }
             } else if (auto logic_var = dynamic_cast<const UHDM::logic_var*>(var)) {
                 if (logic_var->Expr()) {
-                    log("UHDM: Processing initial expression for variable '%s'\n", var_name.c_str());
+                    log_uhdm_debug("UHDM: Processing initial expression for variable '%s'\n", var_name.c_str());
 
                     // Pre-check the UHDM expression's signedness before importing,
                     // because the referenced wire may not have VpiSigned applied yet
@@ -4442,14 +5407,14 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                             } else {
                                 init_value = init_value.extract(0, lhs.size());
                             }
-                            log("UHDM: Resized initial value from %d bits to %d bits for variable '%s'\n",
+                            log_uhdm_debug("UHDM: Resized initial value from %d bits to %d bits for variable '%s'\n",
                                 orig_size, lhs.size(), var_name.c_str());
                         }
 
                         if (init_value.is_fully_const()) {
                             // Set \init attribute for simulation/FF initial value
                             wire->attributes[RTLIL::escape_id("init")] = init_value.as_const();
-                            log("UHDM: Set init attribute for variable '%s' to %s\n",
+                            log_uhdm_debug("UHDM: Set init attribute for variable '%s' to %s\n",
                                 var_name.c_str(), init_value.as_const().as_string().c_str());
                             // Also create a sync-always process so the wire has a constant
                             // driver for combinational contexts (formal verification, opt, etc.)
@@ -4460,12 +5425,12 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                             sync_always->type = RTLIL::SyncType::STa;
                             sync_always->actions.push_back(RTLIL::SigSig(lhs, init_value));
                             proc->syncs.push_back(sync_always);
-                            log("UHDM: Created sync-always process for variable '%s'\n", var_name.c_str());
+                            log_uhdm_debug("UHDM: Created sync-always process for variable '%s'\n", var_name.c_str());
                         } else {
                             // Non-constant RHS (e.g. `logic [127:0] a = x` where x is a wire).
                             // Create a continuous connection, possibly sign-extended.
                             module->connect(lhs, init_value);
-                            log("UHDM: Created continuous connection for variable '%s'\n", var_name.c_str());
+                            log_uhdm_debug("UHDM: Created continuous connection for variable '%s'\n", var_name.c_str());
                         }
                     }
                 }
@@ -4476,7 +5441,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                        var->UhdmType() == uhdmlong_int_var) {
                 if (auto v = dynamic_cast<const UHDM::variables*>(var)) {
                     if (v->Expr()) {
-                        log("UHDM: Processing initial expression for variable '%s'\n", var_name.c_str());
+                        log_uhdm_debug("UHDM: Processing initial expression for variable '%s'\n", var_name.c_str());
                         RTLIL::SigSpec init_val = import_expression(v->Expr());
                         if (init_val.size() > 0) {
                             // Extend to wire width; sign-extend since all these types are signed
@@ -4493,7 +5458,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                             sync_always->actions.push_back(
                                 RTLIL::SigSig(RTLIL::SigSpec(wire), init_val));
                             proc->syncs.push_back(sync_always);
-                            log("UHDM: Created init process for variable '%s'\n", var_name.c_str());
+                            log_uhdm_debug("UHDM: Created init process for variable '%s'\n", var_name.c_str());
                         }
                     }
                 }
@@ -4504,7 +5469,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                 // flattened wire with its (constant) aggregate initializer.
                 if (auto v = dynamic_cast<const UHDM::variables*>(var)) {
                     if (v->Expr()) {
-                        log("UHDM: Processing initializer for %s\n", var_name.c_str());
+                        log_uhdm_debug("UHDM: Processing initializer for %s\n", var_name.c_str());
                         RTLIL::SigSpec init_val = import_expression(v->Expr());
                         if (init_val.size() > 0) {
                             if (init_val.size() < wire->width)
@@ -4512,7 +5477,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                             else if (init_val.size() > wire->width)
                                 init_val = init_val.extract(0, wire->width);
                             module->connect(RTLIL::SigSpec(wire), init_val);
-                            log("UHDM: Connected '%s' to its initializer\n", var_name.c_str());
+                            log_uhdm_debug("UHDM: Connected '%s' to its initializer\n", var_name.c_str());
                         }
                     }
                 }
@@ -4535,7 +5500,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                             std::string name = std::string(ref->VpiName());
                             if (!name.empty()) {
                                 instance_output_driven_nets.insert(name);
-                                log("UHDM: Pre-scan: net '%s' is driven by output port '%s' of instance '%s'\n",
+                                log_uhdm_debug("UHDM: Pre-scan: net '%s' is driven by output port '%s' of instance '%s'\n",
                                     name.c_str(), std::string(port->VpiName()).c_str(),
                                     std::string(child_inst->VpiName()).c_str());
                             }
@@ -4548,17 +5513,17 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
 
     // Import nets
     if (uhdm_module->Nets()) {
-        log("UHDM: Found %d nets to import\n", (int)uhdm_module->Nets()->size());
+        log_uhdm_debug("UHDM: Found %d nets to import\n", (int)uhdm_module->Nets()->size());
         log_flush();
         int net_index = 0;
         for (auto net : *uhdm_module->Nets()) {
             std::string net_name = std::string(net->VpiName());
-            log("UHDM: About to import net %d/%d: '%s'\n", net_index+1, (int)uhdm_module->Nets()->size(), net_name.c_str());
+            log_uhdm_debug("UHDM: About to import net %d/%d: '%s'\n", net_index+1, (int)uhdm_module->Nets()->size(), net_name.c_str());
             log_flush();
             import_net(net, uhdm_module);
             net_index++;
         }
-        log("UHDM: Finished importing all nets\n");
+        log_uhdm_debug("UHDM: Finished importing all nets\n");
         log_flush();
     }
     
@@ -4566,14 +5531,14 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
     // This must be done BEFORE creating memories or importing array_nets
     std::set<std::string> shift_register_arrays;
     if (uhdm_module->Process()) {
-        log("UHDM: Pre-scanning %zu processes for shift registers\n", uhdm_module->Process()->size());
+        log_uhdm_debug("UHDM: Pre-scanning %zu processes for shift registers\n", uhdm_module->Process()->size());
         for (auto proc : *uhdm_module->Process()) {
             // Check for always blocks that may contain shift registers
-            log("  Checking process type: %d\n", proc->VpiType());
+            log_uhdm_debug("  Checking process type: %d\n", proc->VpiType());
             if (proc->VpiType() == vpiAlways) {
                 // Cast to always to get the type
                 const always* always_obj = any_cast<const always*>(proc);
-                log("    Found always block\n");
+                log_uhdm_debug("    Found always block\n");
                 auto stmt = always_obj->Stmt();
                 if (stmt && stmt->VpiType() == vpiEventControl) {
                     auto event_ctrl = any_cast<const event_control*>(stmt);
@@ -4589,20 +5554,20 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                                     if (for_loop->VpiStmt() && for_loop->VpiStmt()->VpiType() == vpiAssignment) {
                                         const assignment* assign = any_cast<const assignment*>(for_loop->VpiStmt());
                                         // Check for M[i+1] <= M[i] pattern
-                                        log("        Checking assignment in for loop\n");
+                                        log_uhdm_debug("        Checking assignment in for loop\n");
                                         if (assign->Lhs() && assign->Rhs()) {
-                                            log("          LHS type: %d, RHS type: %d\n", 
+                                            log_uhdm_debug("          LHS type: %d, RHS type: %d\n", 
                                                 assign->Lhs()->VpiType(), assign->Rhs()->VpiType());
                                             if (assign->Lhs()->VpiType() == vpiBitSelect &&
                                                 assign->Rhs()->VpiType() == vpiBitSelect) {
                                                 const bit_select* lhs_bs = any_cast<const bit_select*>(assign->Lhs());
                                                 const bit_select* rhs_bs = any_cast<const bit_select*>(assign->Rhs());
-                                                log("          LHS name: '%s', RHS name: '%s'\n",
+                                                log_uhdm_debug("          LHS name: '%s', RHS name: '%s'\n",
                                                     std::string(lhs_bs->VpiName()).c_str(),
                                                     std::string(rhs_bs->VpiName()).c_str());
                                                 if (!lhs_bs->VpiName().empty() && lhs_bs->VpiName() == rhs_bs->VpiName()) {
                                                     shift_register_arrays.insert(std::string(lhs_bs->VpiName()));
-                                                    log("UHDM: Pre-scan detected shift register array '%s'\n", 
+                                                    log_uhdm_debug("UHDM: Pre-scan detected shift register array '%s'\n", 
                                                         std::string(lhs_bs->VpiName()).c_str());
                                                 }
                                             }
@@ -4619,14 +5584,14 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
     
     // Now import array_nets, but skip memory creation for shift registers
     if (uhdm_module->Array_nets()) {
-        log("UHDM: Found %d array_nets to import\n", (int)uhdm_module->Array_nets()->size());
+        log_uhdm_debug("UHDM: Found %d array_nets to import\n", (int)uhdm_module->Array_nets()->size());
         for (auto array : *uhdm_module->Array_nets()) {
             std::string array_name = std::string(array->VpiName());
-            log("UHDM: Found array_net: '%s'\n", array_name.c_str());
+            log_uhdm_debug("UHDM: Found array_net: '%s'\n", array_name.c_str());
             
             // Check if this is a shift register first
             if (shift_register_arrays.count(array_name)) {
-                log("UHDM: Array net '%s' is a shift register, creating individual wires\n", array_name.c_str());
+                log_uhdm_debug("UHDM: Array net '%s' is a shift register, creating individual wires\n", array_name.c_str());
                 // Create individual wires for the shift register array
                 // Get array dimensions
                 int array_size = 4; // Default for M[3:0]
@@ -4649,7 +5614,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                                 int left = left_const_val.size() > 0 ? left_const_val.as_int() : 3;  // Default for M[3:0]
                                 int right = right_const_val.size() > 0 ? right_const_val.as_int() : 0;
                                 array_size = std::abs(left - right) + 1;
-                                log("UHDM:   Array size determined: %d (from [%d:%d])\n", array_size, left, right);
+                                log_uhdm_debug("UHDM:   Array size determined: %d (from [%d:%d])\n", array_size, left, right);
                                 break;
                             }
                         }
@@ -4663,21 +5628,18 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                 for (int i = 0; i < array_size; i++) {
                     std::string wire_name = stringf("\\%s[%d]", array_name.c_str(), i);
                     RTLIL::Wire* wire = module->addWire(wire_name, element_width);
-                    wire->attributes[ID::src] = stringf("%s:%d.%d-%d.%d", 
-                        std::string(array->VpiFile()).c_str(), 
-                        array->VpiLineNo(), array->VpiColumnNo(),
-                        array->VpiEndLineNo(), array->VpiEndColumnNo());
-                    log("UHDM:   Created wire %s (width=%d)\n", wire_name.c_str(), element_width);
+                    add_src_attribute(wire->attributes, array);
+                    log_uhdm_debug("UHDM:   Created wire %s (width=%d)\n", wire_name.c_str(), element_width);
                 }
             } else if (is_memory_array(array)) {
                 // Check if it should be imported as memory
                 // An array should be a memory if:
                 // 1. It has both packed and unpacked dimensions (checked by is_memory_array), AND
                 // 2. It has at least one non-constant array access
-                log("UHDM: is_memory_array returned true for '%s'\n", array_name.c_str());
-                log("UHDM: Checking access patterns for '%s'...\n", array_name.c_str());
+                log_uhdm_debug("UHDM: is_memory_array returned true for '%s'\n", array_name.c_str());
+                log_uhdm_debug("UHDM: Checking access patterns for '%s'...\n", array_name.c_str());
                 bool has_const_only = has_only_constant_array_accesses(array_name);
-                log("UHDM: has_only_constant_array_accesses returned %s for '%s'\n", 
+                log_uhdm_debug("UHDM: has_only_constant_array_accesses returned %s for '%s'\n", 
                     has_const_only ? "true" : "false", array_name.c_str());
                 bool is_comb_only_net = comb_only_arrays.count(array_name) > 0;
 
@@ -4709,7 +5671,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                 bool should_be_memory = !has_const_only && !is_comb_only_net && !has_mem2reg_attr;
 
                 if (should_be_memory) {
-                    log("UHDM: Array net '%s' detected as memory array (has dynamic indexing)\n", array_name.c_str());
+                    log_uhdm_debug("UHDM: Array net '%s' detected as memory array (has dynamic indexing)\n", array_name.c_str());
                     create_memory_from_array(array);
                 } else if ((array->Ranges() && array->Ranges()->size() > 1) &&
                            array->Nets() && !array->Nets()->empty() &&
@@ -4721,16 +5683,16 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                     // canonical wire + per-ROW aliases; the per-element path
                     // below consumed only Ranges()[0] and sized rows at
                     // ELEMENT width.
-                    log("UHDM: Array net '%s' multi-dim — flat representation\n",
+                    log_uhdm_debug("UHDM: Array net '%s' multi-dim — flat representation\n",
                         array_name.c_str());
                 } else {
                     // Has only constant accesses, is comb-only, or has (* mem2reg *) attr
                     if (has_mem2reg_attr)
-                        log("UHDM: Array net '%s' has mem2reg attribute, expanding to individual registers\n", array_name.c_str());
+                        log_uhdm_debug("UHDM: Array net '%s' has mem2reg attribute, expanding to individual registers\n", array_name.c_str());
                     else if (is_comb_only_net)
-                        log("UHDM: Array net '%s' is comb-only, creating individual registers\n", array_name.c_str());
+                        log_uhdm_debug("UHDM: Array net '%s' is comb-only, creating individual registers\n", array_name.c_str());
                     else
-                        log("UHDM: Array net '%s' has only constant accesses, creating individual registers\n", array_name.c_str());
+                        log_uhdm_debug("UHDM: Array net '%s' has only constant accesses, creating individual registers\n", array_name.c_str());
                     
                     // Get the array dimensions
                     int array_size = 4; // Default for cases like M[3:0]
@@ -4780,7 +5742,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                                 wire->is_signed = true;
                             add_src_attribute(wire->attributes, array);
                             name_map[element_name] = wire;
-                            log("UHDM: Created wire '%s' (width=%d, signed=%d) for array element\n", wire->name.c_str(), element_width, element_signed);
+                            log_uhdm_debug("UHDM: Created wire '%s' (width=%d, signed=%d) for array element\n", wire->name.c_str(), element_width, element_signed);
                         }
                     }
                 }
@@ -4793,7 +5755,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                 // (is_memory_array doesn't recognize struct elements — CVA6
                 // bht/btb `bht_q[NR_ROWS-1:0][IPF-1:0]` with an anonymous
                 // packed struct): flat canonical wire + per-ROW aliases.
-                log("UHDM: Array net '%s' multi-dim — flat representation\n",
+                log_uhdm_debug("UHDM: Array net '%s' multi-dim — flat representation\n",
                     array_name.c_str());
             } else {
                 // Pure unpacked array of wires (e.g. `wire mw1[0:1]`).  When
@@ -4805,7 +5767,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                 // single-1-bit-wire shape (matches the prior behaviour).
                 bool whole_accessed = whole_array_accessed_names.count(array_name) > 0;
                 if (!whole_accessed) {
-                    log("UHDM: Array net '%s' has only unpacked dimensions and bit-select-only access, creating individual wires\n", array_name.c_str());
+                    log_uhdm_debug("UHDM: Array net '%s' has only unpacked dimensions and bit-select-only access, creating individual wires\n", array_name.c_str());
 
                     int array_size = 1;
                     int array_low = 0;
@@ -4844,7 +5806,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                             if (element_signed) wire->is_signed = true;
                             add_src_attribute(wire->attributes, array);
                             name_map[element_name] = wire;
-                            log("UHDM: Created wire '%s' (width=%d) for unpacked-array element\n",
+                            log_uhdm_debug("UHDM: Created wire '%s' (width=%d) for unpacked-array element\n",
                                 wire->name.c_str(), element_width);
                         }
                     }
@@ -4901,7 +5863,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                     element_width *= inner_count;
 
                     int total_width = array_size * element_width;
-                    log("UHDM: Array net '%s' has whole-array access — creating flat "
+                    log_uhdm_debug("UHDM: Array net '%s' has whole-array access — creating flat "
                         "wire (size=%d, elem_w=%d, total=%d) + per-element slices\n",
                         array_name.c_str(), array_size, element_width, total_width);
 
@@ -4952,20 +5914,20 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                 }
             }
         }
-        log("UHDM: Finished importing all array_nets\n");
+        log_uhdm_debug("UHDM: Finished importing all array_nets\n");
     }
     
     // Import interface instances
     if (module) {
-        log("UHDM: About to import interface instances for module %s\n", log_id(module->name));
+        log_uhdm_debug("UHDM: About to import interface instances for module %s\n", log_id(module->name));
         log_flush();
     } else {
-        log("UHDM: ERROR - module is null!\n");
+        log_uhdm_debug("UHDM: ERROR - module is null!\n");
         log_flush();
         return;
     }
     import_interface_instances(uhdm_module);
-    log("UHDM: Finished importing interface instances\n");
+    log_uhdm_debug("UHDM: Finished importing interface instances\n");
     log_flush();
     
     // Pre-create the implicit nets that are the LHS of module-level continuous
@@ -4986,16 +5948,16 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
             if (w <= 0) w = 1;
             RTLIL::Wire* iw = module->addWire(RTLIL::escape_id(lname), w);
             name_map[lname] = iw;
-            log("UHDM: Pre-created implicit cont-assign net '%s' (width=%d) for "
+            log_uhdm_debug("UHDM: Pre-created implicit cont-assign net '%s' (width=%d) for "
                 "generate-scope visibility\n", lname.c_str(), w);
         }
     }
 
     // Import generate scopes (generate blocks)
-    log("UHDM: About to import generate scopes for module %s\n", log_id(module->name));
+    log_uhdm_debug("UHDM: About to import generate scopes for module %s\n", log_id(module->name));
     log_flush();
     import_generate_scopes(uhdm_module);
-    log("UHDM: Finished importing generate scopes\n");
+    log_uhdm_debug("UHDM: Finished importing generate scopes\n");
     log_flush();
     
     // Import memory objects using analysis pass
@@ -5003,13 +5965,13 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
     
     // Process initial expressions for enum variables now that enum constants are available
     if (uhdm_module->Variables()) {
-        log("UHDM: Processing initial expressions for enum variables in module\n");
+        log_uhdm_debug("UHDM: Processing initial expressions for enum variables in module\n");
         for (auto var : *uhdm_module->Variables()) {
             if (var->UhdmType() == uhdmenum_var) {
                 if (auto enum_var = any_cast<const UHDM::enum_var*>(var)) {
                     std::string var_name = std::string(enum_var->VpiName());
                     if (enum_var->Expr()) {
-                        log("UHDM: Processing initial expression for enum variable '%s'\n", var_name.c_str());
+                        log_uhdm_debug("UHDM: Processing initial expression for enum variable '%s'\n", var_name.c_str());
                         
                         // Look up the wire we already created
                         RTLIL::Wire* wire = nullptr;
@@ -5026,16 +5988,16 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                                 RTLIL::SigSpec lhs(wire);
                                 if (init_value.size() != lhs.size()) {
                                     init_value.extend_u0(lhs.size(), false);
-                                    log("UHDM: Resized initial value from %d bits to %d bits for enum variable '%s'\n", 
+                                    log_uhdm_debug("UHDM: Resized initial value from %d bits to %d bits for enum variable '%s'\n", 
                                         init_value.size(), lhs.size(), var_name.c_str());
                                 }
                                 
                                 if (init_value.is_fully_const()) {
                                     wire->attributes[RTLIL::escape_id("init")] = init_value.as_const();
-                                    log("UHDM: Set init attribute for enum variable '%s' to %s\n", 
+                                    log_uhdm_debug("UHDM: Set init attribute for enum variable '%s' to %s\n", 
                                         var_name.c_str(), init_value.as_const().as_string().c_str());
                                 } else {
-                                    log("UHDM: Initial expression for enum variable '%s' is not constant\n", var_name.c_str());
+                                    log_uhdm_debug("UHDM: Initial expression for enum variable '%s' is not constant\n", var_name.c_str());
                                 }
                             }
                         } else {
@@ -5049,32 +6011,32 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
     
         // Import continuous assignments
     if (uhdm_module->Cont_assigns()) {
-        log("UHDM: Found %d continuous assignments to import\n", (int)uhdm_module->Cont_assigns()->size());
+        log_uhdm_debug("UHDM: Found %d continuous assignments to import\n", (int)uhdm_module->Cont_assigns()->size());
         int assign_idx = 0;
         for (auto cont_assign : *uhdm_module->Cont_assigns()) {
-            log("UHDM: About to import continuous assignment %d (line:%d-%d)\n",
+            log_uhdm_debug("UHDM: About to import continuous assignment %d (line:%d-%d)\n",
                 assign_idx++, cont_assign->VpiLineNo(), cont_assign->VpiEndLineNo());
 
             // Debug: Check what the LHS is
             if (cont_assign->Lhs()) {
                 const expr* lhs = cont_assign->Lhs();
-                log("UHDM:   LHS type: %s (VpiType=%d)\n",
+                log_uhdm_debug("UHDM:   LHS type: %s (VpiType=%d)\n",
                     UHDM::UhdmName(lhs->UhdmType()).c_str(), lhs->VpiType());
                 if (lhs->VpiType() == vpiHierPath) {
                     const hier_path* hp = any_cast<const hier_path*>(lhs);
-                    log("UHDM:   LHS is hier_path: %s\n", std::string(hp->VpiName()).c_str());
+                    log_uhdm_debug("UHDM:   LHS is hier_path: %s\n", std::string(hp->VpiName()).c_str());
                 } else if (lhs->UhdmType() == uhdmlogic_net) {
                     const logic_net* net = any_cast<const logic_net*>(lhs);
-                    log("UHDM:   LHS is logic_net: %s\n", std::string(net->VpiName()).c_str());
+                    log_uhdm_debug("UHDM:   LHS is logic_net: %s\n", std::string(net->VpiName()).c_str());
                 } else if (lhs->UhdmType() == uhdmref_obj) {
                     const ref_obj* ref = any_cast<const ref_obj*>(lhs);
-                    log("UHDM:   LHS is ref_obj: %s\n", std::string(ref->VpiName()).c_str());
+                    log_uhdm_debug("UHDM:   LHS is ref_obj: %s\n", std::string(ref->VpiName()).c_str());
                 }
             }
 
             try {
                 import_continuous_assign(cont_assign);
-                log("UHDM: Successfully imported continuous assignment\n");
+                log_uhdm_debug("UHDM: Successfully imported continuous assignment\n");
             } catch (const std::exception& e) {
                 log_error("UHDM: Exception in continuous assignment import: %s\n", e.what());
             } catch (...) {
@@ -5178,7 +6140,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
                 } else {
                     module->connect(lhs, rhs);
                 }
-                log("UHDM: Lowered port-initialiser '%s = <expr>' to "
+                log_uhdm_debug("UHDM: Lowered port-initialiser '%s = <expr>' to "
                     "init+sync process\n", port_name.c_str());
             } catch (...) {
                 log_warning("UHDM: Failed to lower port-initialiser for '%s'\n",
@@ -5189,17 +6151,17 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
 
 
     // Import processes (always blocks) - re-enabled with debugging
-    log("UHDM: Checking for processes...\n");
+    log_uhdm_debug("UHDM: Checking for processes...\n");
     log_flush();
     if (uhdm_module->Process()) {
-        log("UHDM: Found %d processes to import\n", (int)uhdm_module->Process()->size());
+        log_uhdm_debug("UHDM: Found %d processes to import\n", (int)uhdm_module->Process()->size());
         log_flush();
         for (auto process : *uhdm_module->Process()) {
-            log("UHDM: About to import process\n");
+            log_uhdm_debug("UHDM: About to import process\n");
             log_flush();
             try {
                 import_process(process);
-                log("UHDM: Successfully imported process\n");
+                log_uhdm_debug("UHDM: Successfully imported process\n");
                 log_flush();
             } catch (const std::exception& e) {
                 log_error("UHDM: Exception in process import: %s\n", e.what());
@@ -5208,13 +6170,13 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
             }
         }
     } else {
-        log("UHDM: No processes found\n");
+        log_uhdm_debug("UHDM: No processes found\n");
         log_flush();
     }
 
     // Import concurrent assertions (assert property (...))
     if (uhdm_module->Assertions()) {
-        log("UHDM: Found %d assertions to import\n", (int)uhdm_module->Assertions()->size());
+        log_uhdm_debug("UHDM: Found %d assertions to import\n", (int)uhdm_module->Assertions()->size());
         for (auto assertion : *uhdm_module->Assertions()) {
             if (!assertion) continue;
             // Only handle assert_stmt (not assume/cover/restrict)
@@ -5261,7 +6223,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
             check_cell->setPort(ID(A), cond);
             check_cell->setPort(ID(ARGS), RTLIL::SigSpec());
             check_cell->attributes[ID::keep] = RTLIL::Const(1);
-            log("UHDM: Imported assert_stmt as $check cell\n");
+            log_uhdm_debug("UHDM: Imported assert_stmt as $check cell\n");
         }
     }
 
@@ -5325,7 +6287,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
             }
             if (w && other_driven_wires.count(w)) {
                 if (mode_debug)
-                    log("  Removing init-only STa process for '%s' (also driven by another process)\n",
+                    log_uhdm_debug("  Removing init-only STa process for '%s' (also driven by another process)\n",
                         w->name.c_str());
                 to_remove.push_back(kv.first);
             }
@@ -5413,8 +6375,20 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
         }
     }
 
+    // Drop scratch wires / dead cells nobody reads before handing the module on
+    sweep_import_scratch();
+
     // Finalize module
     module->fixup_ports();
+
+    if (uhdm_trace_on) {
+        long long wires = 0, cells = 0;
+        for (auto mod : design->modules()) {
+            wires += GetSize(mod->wires_);
+            cells += GetSize(mod->cells_);
+        }
+        uhdm_trace_counter("rtlil", {{"wires", wires}, {"cells", cells}});
+    }
     
     // NOTE: Blackbox detection is done after hierarchy import in import_design()
     // We don't mark modules as blackbox here because cells may be added later
@@ -5427,7 +6401,7 @@ void UhdmImporter::import_module(const module_inst* uhdm_module) {
 // Create a parameterized module based on parameter values in the base module
 std::string UhdmImporter::create_parameterized_module(const std::string& base_name, RTLIL::Module* base_module) {
     if (mode_debug)
-        log("  Creating parameterized module for base: %s\n", base_name.c_str());
+        log_uhdm_debug("  Creating parameterized module for base: %s\n", base_name.c_str());
     
     // Build parameter string like Yosys does
     std::string param_string = "";
@@ -5465,7 +6439,7 @@ std::string UhdmImporter::create_parameterized_module(const std::string& base_na
     RTLIL::IdString param_module_id = RTLIL::escape_id(param_module_name);
     if (!design->module(param_module_id)) {
         if (mode_debug)
-            log("    Creating new parameterized module: %s\n", param_module_name.c_str());
+            log_uhdm_debug("    Creating new parameterized module: %s\n", param_module_name.c_str());
         
         // Clone the base module
         RTLIL::Module* param_module = design->addModule(param_module_id);
@@ -5493,6 +6467,7 @@ std::string UhdmImporter::create_parameterized_module(const std::string& base_na
         for (const auto& [param_name, param_value] : base_module->parameter_default_values) {
             param_module->avail_parameters(param_name);
             param_module->parameter_default_values[param_name] = param_value;
+            parameter_version++;
         }
         
         // Copy attributes
@@ -5511,7 +6486,7 @@ std::string UhdmImporter::create_parameterized_module(const std::string& base_na
 
 // Expand interfaces - replace interface instances with their signals
 void UhdmImporter::expand_interfaces() {
-    log("UHDM: Expanding interfaces in design\n");
+    log_uhdm_debug("UHDM: Expanding interfaces in design\n");
     
     // First, collect all interface modules and interface cells
     std::set<RTLIL::Module*> interface_modules;
@@ -5524,7 +6499,7 @@ void UhdmImporter::expand_interfaces() {
     for (auto module : design->modules()) {
         if (module->attributes.count(RTLIL::escape_id("is_interface"))) {
             interface_modules.insert(module);
-            log("UHDM: Found interface module: %s\n", module->name.c_str());
+            log_uhdm_debug("UHDM: Found interface module: %s\n", module->name.c_str());
         }
         
         // Find interface cells in this module
@@ -5532,7 +6507,7 @@ void UhdmImporter::expand_interfaces() {
             RTLIL::Module* cell_module = design->module(cell->type);
             if (cell_module && cell_module->attributes.count(RTLIL::escape_id("is_interface"))) {
                 interface_cells_to_remove.push_back(std::make_pair(module, cell));
-                log("UHDM: Found interface cell %s of type %s in module %s\n", 
+                log_uhdm_debug("UHDM: Found interface cell %s of type %s in module %s\n", 
                     cell->name.c_str(), cell->type.c_str(), module->name.c_str());
                 
                 // Map dummy wires to interface names
@@ -5545,7 +6520,7 @@ void UhdmImporter::expand_interfaces() {
                 for (auto wire : module->wires()) {
                     if (wire->name.str().find("$dummywireforinterface\\" + interface_name) == 0) {
                         dummy_wire_to_interface[wire->name] = interface_name;
-                        log("UHDM: Mapped dummy wire %s to interface %s\n", 
+                        log_uhdm_debug("UHDM: Mapped dummy wire %s to interface %s\n", 
                             wire->name.c_str(), interface_name.c_str());
                     }
                 }
@@ -5560,7 +6535,7 @@ void UhdmImporter::expand_interfaces() {
             continue;
         }
         
-        log("UHDM: Processing module %s for interface expansion\n", module->name.c_str());
+        log_uhdm_debug("UHDM: Processing module %s for interface expansion\n", module->name.c_str());
         
         // Find cells with interface ports
         std::vector<RTLIL::Cell*> cells_to_update;
@@ -5581,7 +6556,7 @@ void UhdmImporter::expand_interfaces() {
             
             if (has_interface_port) {
                 cells_to_update.push_back(cell);
-                log("UHDM: Cell %s has interface ports (module %s has interface ports)\n", 
+                log_uhdm_debug("UHDM: Cell %s has interface ports (module %s has interface ports)\n", 
                     cell->name.c_str(), cell->type.c_str());
             }
         }
@@ -5598,7 +6573,7 @@ void UhdmImporter::expand_interfaces() {
                     std::string wire_name = wire->name.str();
                     if (wire_name.find("\\bus.") == 0) {
                         cell_interface_signals.insert(wire_name);
-                        log("UHDM: Cell module %s has interface signal %s\n", 
+                        log_uhdm_debug("UHDM: Cell module %s has interface signal %s\n", 
                             cell->type.c_str(), wire_name.c_str());
                     }
                 }
@@ -5615,7 +6590,7 @@ void UhdmImporter::expand_interfaces() {
                 }
                 
                 if (port_wire && port_wire->attributes.count(RTLIL::escape_id("is_interface"))) {
-                    log("UHDM: Expanding interface port %s on cell %s\n", 
+                    log_uhdm_debug("UHDM: Expanding interface port %s on cell %s\n", 
                         port_name.c_str(), cell->name.c_str());
                     
                     // Find which interface this dummy wire corresponds to
@@ -5624,13 +6599,13 @@ void UhdmImporter::expand_interfaces() {
                     // First check if it's in our dummy wire map
                     if (dummy_wire_to_interface.count(port_wire->name)) {
                         interface_name = dummy_wire_to_interface[port_wire->name];
-                        log("UHDM: Found interface %s from dummy wire map\n", interface_name.c_str());
+                        log_uhdm_debug("UHDM: Found interface %s from dummy wire map\n", interface_name.c_str());
                     } else {
                         // Try to extract from the wire name itself
                         std::string wire_name = port_wire->name.str();
                         if (wire_name.find("$dummywireforinterface\\") == 0) {
                             interface_name = wire_name.substr(23); // Skip "$dummywireforinterface\"
-                            log("UHDM: Extracted interface %s from wire name\n", interface_name.c_str());
+                            log_uhdm_debug("UHDM: Extracted interface %s from wire name\n", interface_name.c_str());
                         } else {
                             // The wire might have been renamed by Yosys, try to find it by checking connections
                             // Look for any interface signal wires that exist for this cell
@@ -5649,7 +6624,7 @@ void UhdmImporter::expand_interfaces() {
                                             }
                                             if (cell_interface_name == potential_interface) {
                                                 interface_name = potential_interface;
-                                                log("UHDM: Found interface %s by searching module wires\n", interface_name.c_str());
+                                                log_uhdm_debug("UHDM: Found interface %s by searching module wires\n", interface_name.c_str());
                                                 break;
                                             }
                                         }
@@ -5680,7 +6655,7 @@ void UhdmImporter::expand_interfaces() {
                             // Get the interface module to find its signals
                             RTLIL::Module* interface_module = design->module(interface_cell->type);
                             if (interface_module) {
-                                log("UHDM: Interface module %s has the following signals:\n", interface_module->name.c_str());
+                                log_uhdm_debug("UHDM: Interface module %s has the following signals:\n", interface_module->name.c_str());
                                 
                                 // Get all signals from the interface module
                                 for (auto iface_wire : interface_module->wires()) {
@@ -5697,7 +6672,7 @@ void UhdmImporter::expand_interfaces() {
                                         // Create connection to the expanded signal
                                         RTLIL::IdString expanded_port = RTLIL::escape_id(port_name.str() + "." + signal_name);
                                         new_connections[expanded_port] = parent_wire;
-                                        log("UHDM: Connected port %s to wire %s\n", expanded_port.c_str(), parent_wire->name.c_str());
+                                        log_uhdm_debug("UHDM: Connected port %s to wire %s\n", expanded_port.c_str(), parent_wire->name.c_str());
                                     } else {
                                         log_warning("UHDM: Could not find wire %s in parent module\n", expanded_wire_name.c_str());
                                     }
@@ -5726,7 +6701,7 @@ void UhdmImporter::expand_interfaces() {
                                     std::string parent_name = interface_name + "." + sig;
                                     if (auto pw = module->wire(RTLIL::escape_id(parent_name))) {
                                         new_connections[cw->name] = RTLIL::SigSpec(pw);
-                                        log("UHDM: (fallback) connected %s to wire %s\n",
+                                        log_uhdm_debug("UHDM: (fallback) connected %s to wire %s\n",
                                             cw->name.c_str(), pw->name.c_str());
                                     }
                                 }
@@ -5755,14 +6730,14 @@ void UhdmImporter::expand_interfaces() {
     for (auto &pair : interface_cells_to_remove) {
         RTLIL::Module* module = pair.first;
         RTLIL::Cell* cell = pair.second;
-        log("UHDM: Removing interface cell %s from module %s\n", 
+        log_uhdm_debug("UHDM: Removing interface cell %s from module %s\n", 
             cell->name.c_str(), module->name.c_str());
         module->remove(cell);
     }
     
     // Remove interface modules
     for (auto iface_module : interface_modules) {
-        log("UHDM: Removing interface module %s\n", iface_module->name.c_str());
+        log_uhdm_debug("UHDM: Removing interface module %s\n", iface_module->name.c_str());
         design->remove(iface_module);
     }
     
@@ -5776,7 +6751,7 @@ void UhdmImporter::expand_interfaces() {
         }
         if (!wires_to_remove.empty()) {
             for (auto wire : wires_to_remove) {
-                log("UHDM: Removing dummy interface wire %s\n", wire->name.c_str());
+                log_uhdm_debug("UHDM: Removing dummy interface wire %s\n", wire->name.c_str());
             }
             module->remove(wires_to_remove);
         }
@@ -5794,7 +6769,7 @@ void UhdmImporter::expand_interfaces() {
         for (auto wire : module->wires()) {
             if (wire->attributes.count(RTLIL::escape_id("is_interface")) && wire->port_id > 0) {
                 interface_port_wires.push_back(wire);
-                log("UHDM: Module %s has interface port %s\n", module->name.c_str(), wire->name.c_str());
+                log_uhdm_debug("UHDM: Module %s has interface port %s\n", module->name.c_str(), wire->name.c_str());
             }
         }
         
@@ -5822,7 +6797,7 @@ void UhdmImporter::expand_interfaces() {
                     if (wire_name.find(prefix) == 0 || wire_name.find(escaped_prefix) == 0 ||
                         wire_name.find(arr_prefix) == 0 || wire_name.find(escaped_arr_prefix) == 0) {
                         signal_wires.push_back(wire);
-                        log("UHDM: Found interface signal wire %s\n", wire_name.c_str());
+                        log_uhdm_debug("UHDM: Found interface signal wire %s\n", wire_name.c_str());
                     }
                 }
                 
@@ -5874,7 +6849,7 @@ void UhdmImporter::expand_interfaces() {
                         signal_wire->port_output = interface_wire->port_output;
                     }
                     signal_wire->port_id = ++max_port_id;
-                    log("UHDM: Converted %s to port (id=%d, in=%d, out=%d)\n",
+                    log_uhdm_debug("UHDM: Converted %s to port (id=%d, in=%d, out=%d)\n",
                         signal_wire->name.c_str(), signal_wire->port_id,
                         signal_wire->port_input, signal_wire->port_output);
                 }
@@ -5883,7 +6858,7 @@ void UhdmImporter::expand_interfaces() {
                 interface_wire->port_input = false;
                 interface_wire->port_output = false;
                 interface_wire->port_id = 0;
-                log("UHDM: Removed interface port status from %s\n", interface_wire->name.c_str());
+                log_uhdm_debug("UHDM: Removed interface port status from %s\n", interface_wire->name.c_str());
             }
             
             // Remove interface port wires
@@ -5898,7 +6873,7 @@ void UhdmImporter::expand_interfaces() {
         }
     }
     
-    log("UHDM: Finished expanding interfaces\n");
+    log_uhdm_debug("UHDM: Finished expanding interfaces\n");
 }
 
 YOSYS_NAMESPACE_END
@@ -38,10 +38,102 @@
 #include "kernel/celltypes.h"
 #include "kernel/log.h"
 
+#include <atomic>
+#include <chrono>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
 YOSYS_NAMESPACE_BEGIN
 
 using namespace UHDM;
 
+// Import log verbosity, set per read_uhdm / read_sv call with `-v N` (0 quiet,
+// 1 info, 2 debug, 3 trace; `-debug` implies trace).  The log_uhdm* macros
+// test the level before touching their arguments, so a disabled message
+// costs one compare and no formatting.
+enum class UhdmLogLevel { Quiet = 0, Info = 1, Debug = 2, Trace = 3 };
+extern UhdmLogLevel uhdm_log_level;
+
+#define UHDM_LOG_AT(level, ...) \
+    do { if (uhdm_log_level >= UhdmLogLevel::level) log(__VA_ARGS__); } while (0)
+// Design-level milestones
+#define log_uhdm(...)       UHDM_LOG_AT(Info, __VA_ARGS__)
+// Per-module / per-declaration detail
+#define log_uhdm_debug(...) UHDM_LOG_AT(Debug, __VA_ARGS__)
+// Per-statement / per-expression detail
+#define log_uhdm_trace(...) UHDM_LOG_AT(Trace, __VA_ARGS__)
+
+// `-trace <file>`: Chrome / Perfetto trace-event timeline of one read_sv /
+// read_uhdm call (trace.cpp).  A UhdmTraceSession opens and writes the file;
+// UhdmTraceSpan marks a nested B/E span on the calling thread.  Both are a
+// single flag test when no session is active.
+extern bool uhdm_trace_on;
+void uhdm_trace_event(char phase, const char* name, const std::string& detail = "");
+void uhdm_trace_counter(const char* name, const std::vector<std::pair<std::string, long long>>& values);
+
+struct UhdmTraceSession {
+    explicit UhdmTraceSession(const std::string& file);
+    ~UhdmTraceSession();
+    std::string file;
+};
+
+struct UhdmTraceSpan {
+    UhdmTraceSpan(const char* name, const std::string& detail = "") : on(uhdm_trace_on) {
+        if (on) uhdm_trace_event('B', name, detail);
+    }
+    ~UhdmTraceSpan() { if (on) uhdm_trace_event('E', ""); }
+    bool on;
+};
+
+// Signal-name -> in-flight value map of a comb process (current_comb_values)
+// that carries a version.  Every write takes a fresh epoch; a copy keeps its
+// source's epoch, so restoring a branch/case snapshot restores the version
+// too -- the contents are identical to what that epoch named.  The importer's
+// expression cache (import_expression) keys on it.  Reads go through the const
+// find()/at(), so a lookup never invalidates.
+struct CombValueMap : std::map<std::string, RTLIL::SigSpec> {
+    using Base = std::map<std::string, RTLIL::SigSpec>;
+    uint64_t epoch = fresh_epoch();
+
+    CombValueMap() = default;
+    CombValueMap(const CombValueMap&) = default;
+    CombValueMap& operator=(const CombValueMap& o) {
+        Base::operator=(o);
+        epoch = o.epoch;
+        return *this;
+    }
+    CombValueMap& operator=(const Base& o) {
+        Base::operator=(o);
+        epoch = fresh_epoch();
+        return *this;
+    }
+    RTLIL::SigSpec& operator[](const std::string& k) {
+        epoch = fresh_epoch();
+        return Base::operator[](k);
+    }
+    const RTLIL::SigSpec& at(const std::string& k) const { return Base::at(k); }
+    const_iterator find(const std::string& k) const { return Base::find(k); }
+    iterator begin() {
+        epoch = fresh_epoch();
+        return Base::begin();
+    }
+    const_iterator begin() const { return Base::begin(); }
+    size_t erase(const std::string& k) {
+        epoch = fresh_epoch();
+        return Base::erase(k);
+    }
+    void clear() {
+        epoch = fresh_epoch();
+        Base::clear();
+    }
+
+    static uint64_t fresh_epoch() {
+        static std::atomic<uint64_t> next{0};
+        return ++next;
+    }
+};
+
 // Cast a statement that a case-label assumes is a `vpiAssignment` to `assignment*`.
 //
 // IMPORTANT: `vpiAssignment` (UHDM class `assignment`) and `vpiAssignStmt` (UHDM
@@ -69,6 +161,57 @@ static inline const UHDM::assignment* require_assignment(const UHDM::any* s,
     return nullptr;  // unreachable: log_error() aborts
 }
 
+// Type-tag downcast for LEAF UHDM classes: one UhdmType() compare plus a
+// static_cast instead of an RTTI walk, for the per-node dispatch in
+// import_expression / import_ref_obj / import_hier_path / get_width.  Only
+// classes registered below are accepted, so an abstract group (`net`,
+// `variables`, `expr`, `scope`, ...) fails to compile here and keeps its
+// dynamic_cast.  The tag compare is exact only for a class with no
+// subclasses, so each registration asserts the UHDM class is `final`; a UHDM
+// update that derives from one of them breaks the build here rather than
+// making uhdm_cast silently miss the subclass.
+template <typename T> struct uhdm_leaf_tag;
+#define UHDM_LEAF_TAG(cls) \
+    template <> struct uhdm_leaf_tag<UHDM::cls> { \
+        static_assert(std::is_final<UHDM::cls>::value, \
+                      "uhdm_cast: UHDM::" #cls " has subclasses; use dynamic_cast"); \
+        static constexpr UHDM::UHDM_OBJECT_TYPE value = UHDM::uhdm##cls; \
+    };
+UHDM_LEAF_TAG(logic_net)
+UHDM_LEAF_TAG(logic_var)
+UHDM_LEAF_TAG(struct_var)
+UHDM_LEAF_TAG(struct_net)
+UHDM_LEAF_TAG(union_var)
+UHDM_LEAF_TAG(packed_array_var)
+UHDM_LEAF_TAG(packed_array_net)
+UHDM_LEAF_TAG(array_var)
+UHDM_LEAF_TAG(io_decl)
+UHDM_LEAF_TAG(port)
+UHDM_LEAF_TAG(hier_path)
+UHDM_LEAF_TAG(bit_select)
+UHDM_LEAF_TAG(var_select)
+UHDM_LEAF_TAG(part_select)
+UHDM_LEAF_TAG(indexed_part_select)
+UHDM_LEAF_TAG(constant)
+UHDM_LEAF_TAG(operation)
+UHDM_LEAF_TAG(parameter)
+UHDM_LEAF_TAG(param_assign)
+UHDM_LEAF_TAG(module_inst)
+UHDM_LEAF_TAG(interface_inst)
+UHDM_LEAF_TAG(logic_typespec)
+UHDM_LEAF_TAG(packed_array_typespec)
+UHDM_LEAF_TAG(struct_typespec)
+UHDM_LEAF_TAG(array_typespec)
+UHDM_LEAF_TAG(enum_const)
+UHDM_LEAF_TAG(integer_var)
+#undef UHDM_LEAF_TAG
+
+template <typename T>
+static inline const T* uhdm_cast(const UHDM::any* obj) {
+    return (obj && obj->UhdmType() == uhdm_leaf_tag<T>::value)
+        ? static_cast<const T*>(obj) : nullptr;
+}
+
 // Parse VpiValue format strings ("HEX:BB", "BIN:1010", "UINT:42", etc.) to integer
 static inline int parse_vpi_value_to_int(const std::string& vpi_value) {
     size_t colon_pos = vpi_value.find(':');
@@ -233,10 +376,14 @@ struct UhdmImporter {
     RTLIL::Design *design;
     RTLIL::Module *module;
     
-    // Maps for tracking UHDM objects to RTLIL equivalents
-    std::map<const any*, RTLIL::SigBit> net_map;
+    // Maps for tracking UHDM objects to RTLIL equivalents.  These are hit on
+    // nearly every expression import, so they are hashed (hashlib dict) rather
+    // than ordered; nothing may rely on their iteration order for output.
+    // wire_map is the exception: the wire -> object scans take the first
+    // match, so it stays a std::map and keeps its address order.
+    dict<const any*, RTLIL::SigBit> net_map;
     std::map<const any*, RTLIL::Wire*> wire_map;
-    std::map<std::string, RTLIL::Wire*> name_map;
+    dict<std::string, RTLIL::Wire*> name_map;
     // Per interface-instance name (incl. array index, e.g. "arr[0]") -> the
     // ordered list of its signal names ("vld","dat",...).  Populated when
     // interface instances are imported; used to expand an interface-array
@@ -271,7 +418,7 @@ struct UhdmImporter {
     // imported as — including the `$paramod\...` specialization.  Used when
     // creating a child cell so it lands in the PARENT's specialized module, not
     // the base (EnumParameterInNestedModules: a nested parameterized instance).
-    std::map<const UHDM::module_inst*, std::string> inst_to_modname_;
+    dict<const UHDM::module_inst*, std::string> inst_to_modname_;
 
     // Track nets driven by module instance output ports
     // These should not have the \reg attribute even if declared as reg
@@ -295,16 +442,77 @@ struct UhdmImporter {
     
     // Track package typespecs for type resolution
     // Key: fully qualified name (package::type), Value: typespec
-    std::map<std::string, const UHDM::typespec*> package_typespec_map;
-    
+    dict<std::string, const UHDM::typespec*> package_typespec_map;
+    
+    // Interface specialization registry: one RTLIL module per distinct
+    // (interface, parameter set).  Key: `$paramod\<iface>\P=...` name,
+    // Value: the instance the module's signals are built from.
+    dict<std::string, const UHDM::interface_inst*> interface_specializations;
+    // Key: interface definition name, Value: its AllInterfaces entry
+    dict<std::string, const UHDM::interface_inst*> interface_definitions;
+
     // Track package parameters
     // Key: fully qualified name (package::param), Value: constant value
-    std::map<std::string, RTLIL::Const> package_parameter_map;
+    dict<std::string, RTLIL::Const> package_parameter_map;
+
+    // Package parameters registered by import_package but not folded yet.
+    // Key: fully qualified name (package::param); package_parameter() moves
+    // an entry into package_parameter_map on its first lookup.
+    dict<std::string, std::pair<const UHDM::package*, const UHDM::parameter*>> package_parameter_index;
     
     // Import modes and options
     bool mode_keep_names = false;  // Use uniquify to avoid naming conflicts
     bool mode_debug = true;
     bool mode_formal = false;
+
+    // Constant case-table inference (emit_case_rom): a combinational
+    // `case (idx) K: out = C; ...` whose every arm assigns constants is
+    // emitted as an async-read ROM ($memrd over a $meminit'ed memory) when
+    // it has at least case_rom_threshold words, else as a $bmux over the
+    // packed table.  Selectors wider than case_rom_max_abits keep the
+    // switch-rule lowering.  Disabled by `-no_case_rom`.
+    bool mode_case_rom = true;
+    int case_rom_threshold = 64;
+    int case_rom_max_abits = 12;
+
+    // Sweep unread importer scratch wires / dead internal cells at the end of
+    // import_module (sweep_import_scratch).  Disabled by `-no_import_sweep`.
+    bool mode_import_sweep = true;
+
+    // Import gate arrays as one fine-grained named cell per element instead
+    // of word-level cells over the whole array (`-gate_array_cells`).
+    bool mode_gate_array_cells = false;
+
+    // Precision of `src` attributes: full ranges, start line only
+    // (`-src=line`), or none (`-nosrc`).
+    enum class UhdmSrcMode { Full, Line, None };
+    UhdmSrcMode src_mode = UhdmSrcMode::Full;
+
+    // `-heatmap <file>`: per-source-line RTLIL inflation report (heatmap.cpp).
+    // A HeatmapScope around each module body, process, statement, function
+    // call, continuous assign, instance and gate charges what it added to
+    // `module` -- cells, wires, wire bits, processes and the switch rules of
+    // those new processes -- and its wall time to its source line, exclusive
+    // of nested scopes.  Off (and free) when heatmap_file is empty.
+    struct HeatmapStat {
+        int items = 0, cells = 0, wires = 0, wire_bits = 0, processes = 0, process_switches = 0;
+        double seconds = 0;
+    };
+    struct HeatmapScope {
+        HeatmapScope(UhdmImporter* importer, const UHDM::any* obj);
+        ~HeatmapScope();
+        UhdmImporter* imp = nullptr;
+        HeatmapScope* parent = nullptr;
+        RTLIL::Module* mod = nullptr;
+        std::string key;
+        int cells0 = 0, wires0 = 0, procs0 = 0;
+        std::chrono::steady_clock::time_point t0;
+        HeatmapStat nested;
+    };
+    std::string heatmap_file;
+    std::map<std::string, HeatmapStat> heatmap;
+    HeatmapScope* heatmap_scope = nullptr;
+    void report_heatmap();
     
     // Counter for unique cell names
     int logic_not_counter = 0;
@@ -318,7 +526,23 @@ struct UhdmImporter {
     // DECLARATION-DEFAULT parameter values (e.g. CVA6's `CVA6Cfg =
     // cva6_cfg_empty`), so anything that needs a real parameter VALUE while a
     // def is being imported must consult the elaborated instance instead.
-    std::map<std::string, const UHDM::module_inst*> elab_inst_by_def;
+    dict<std::string, const UHDM::module_inst*> elab_inst_by_def;
+
+    // Hierarchical instance index, built once per import_design: every
+    // elaborated module instance under TopModules (through child instances and
+    // generate scopes), by raw VpiDefName, in depth-first pre-order with child
+    // instances before generate scopes.  `in_gen_scope` marks instances only
+    // reachable through a generate scope.
+    struct HierInstance {
+        const UHDM::module_inst* inst;
+        bool in_gen_scope;
+    };
+    dict<std::string, std::vector<HierInstance>> hier_insts_by_def;
+    void index_instance_hierarchy();
+    // First indexed instance of `def` (in walk order) accepted by `pred`;
+    // generate-scope instances only when `through_gen_scopes`.
+    const UHDM::module_inst* find_elaborated_instance(const std::string& def, bool through_gen_scopes,
+                                                      const std::function<bool(const UHDM::module_inst*)>& pred);
 
     // Current generate scope for naming (deprecated - use gen_scope_stack)
     std::string current_gen_scope;
@@ -362,7 +586,7 @@ struct UhdmImporter {
     std::map<RTLIL::Wire*, RTLIL::Const> interpreter_init_values;
 
     // Loop variable values for unrolling
-    std::map<std::string, int> loop_values;
+    dict<std::string, int> loop_values;
     
     // Track accumulator values across loop iterations
     // Maps variable name to the current accumulated value
@@ -379,7 +603,22 @@ struct UhdmImporter {
 
     // Track current signal values during combinational always block processing
     // Maps signal name to its current SigSpec value (for task/function inlining)
-    std::map<std::string, RTLIL::SigSpec> current_comb_values;
+    CombValueMap current_comb_values;
+
+    // Per-process expression cache.  import_expression returns the SigSpec it
+    // built earlier for the same side-effect-free expression node when the
+    // value map it reads through and the current_comb_values epoch are
+    // unchanged -- e.g. a case selector compared in every arm, or an operand
+    // imported both as a read and as an LHS base.  Only used in comb process
+    // bodies outside unrolled loops and inlined functions, whose value maps
+    // carry no version.  Reset per process and per module.
+    typedef std::tuple<const UHDM::expr*, const void*, uint64_t, int,
+                       const UHDM::typespec*, const UHDM::scope*, int> ExprCacheKey;
+    std::map<ExprCacheKey, RTLIL::SigSpec> expr_cache;
+    const RTLIL::Process* expr_cache_proc = nullptr;
+    dict<const UHDM::any*, bool> expr_cache_pure;
+    int expr_cache_hits = 0, expr_cache_misses = 0;
+    bool expr_cacheable(const UHDM::any* e);
 
     // Maps hierarchical wire name to short VpiName (e.g., "foo.y" → "y") for named begin block variables
     std::map<std::string, std::string> comb_value_aliases;
@@ -487,6 +726,10 @@ struct UhdmImporter {
     // wires (matching the Verilog frontend).
     std::set<std::string> whole_array_accessed_names;
 
+    // Row alias wires `name[k]` of flattened arrays, per module, for
+    // prune_unread_row_aliases at the end of import_design.
+    std::map<RTLIL::Module*, std::vector<RTLIL::IdString>> flat_array_row_aliases;
+
     // Element widths for function-local unpacked array_var instances.
     // Key: variable name (within the function evaluation scope).  Value: width
     // of one array element in bits.  Storage is flattened into the per-name
@@ -512,8 +755,8 @@ struct UhdmImporter {
     std::vector<std::pair<RTLIL::SigSpec, bool>> current_ff_edges;
 
     // Temporary wires for combinational processes
-    std::map<const UHDM::expr*, RTLIL::Wire*> current_temp_wires;
-    std::map<const UHDM::expr*, RTLIL::SigSpec> current_lhs_specs;
+    dict<const UHDM::expr*, RTLIL::Wire*> current_temp_wires;
+    dict<const UHDM::expr*, RTLIL::SigSpec> current_lhs_specs;
     // Per-process temp wires keyed by SIGNAL NAME.  A signal written by
     // several processes gets a dedup-bumped temp ("$1\sig", "$2\sig", …) in
     // the later ones, so a module-wide `module->wire("$0\" + name)` lookup
@@ -540,7 +783,7 @@ struct UhdmImporter {
     // collapses them into one muxed port and silently drops a write.  This map
     // gives each write statement (keyed by its LHS bit_select node) its own
     // addr/data/en wire set; body import prefers it over current_memory_writes.
-    std::map<const UHDM::any*, MemoryWriteInfo> current_memory_writes_by_lhs;
+    dict<const UHDM::any*, MemoryWriteInfo> current_memory_writes_by_lhs;
     // Collect the LHS bit_select node of every memory-write statement, grouped
     // by memory name in source order (mirrors scan_for_memory_writes).
     void collect_memory_write_lhs(const UHDM::any* stmt,
@@ -568,7 +811,8 @@ struct UhdmImporter {
     // Track pending sync assignments to merge multiple updates to same signal
     std::map<RTLIL::SigSpec, RTLIL::SigSpec> pending_sync_assignments;
     
-    // Current loop variable substitutions for unrolling
+    // Current loop variable substitutions for unrolling.  Stays a std::map:
+    // it is handed as-is to the *_with_substitution helpers.
     std::map<std::string, int64_t> current_loop_substitutions;
     
     // Track if we're currently processing an initial block
@@ -669,6 +913,30 @@ struct UhdmImporter {
     // selectors) don't see a 32-bit-inflated constant.
     std::string eval_param_struct_field(const UHDM::hier_path* hp,
                                         int* width_out = nullptr);
+    // The resolvers above are memoized (uhdm2rtlil.cpp); the *_walk variants
+    // do the actual work.
+    struct IfaceParamMemo {
+        std::string str;
+        RTLIL::SigSpec sig;
+        int width = 0;
+        bool ok = false;
+        long value = 0;
+    };
+    dict<std::string, IfaceParamMemo> iface_param_memo;
+    int iface_param_memo_hits = 0, iface_param_memo_misses = 0;
+    std::string iface_param_memo_key(char kind, const UHDM::hier_path* hp,
+                                     const UHDM::module_inst* child_inst);
+    const IfaceParamMemo* iface_param_memo_find(const std::string& key);
+    RTLIL::SigSpec fold_iface_param_via_chain_walk(const UHDM::hier_path* hp);
+    std::string eval_iface_param_field_walk(const UHDM::hier_path* hp,
+                                            const UHDM::module_inst* child_inst);
+    RTLIL::SigSpec eval_iface_param_struct_walk(const UHDM::hier_path* hp,
+                                                const UHDM::module_inst* child_inst);
+    std::string eval_bare_iface_param_field_walk(const UHDM::hier_path* hp,
+                                                 const UHDM::module_inst* child_inst);
+    bool eval_iface_local_const_walk(const UHDM::interface_inst* iface,
+                                     const UHDM::any* ve, long& out);
+    std::string eval_param_struct_field_walk(const UHDM::hier_path* hp, int* width_out);
     // Width of a port from the AllModules DEFINITION's typespec (whose range
     // refers to the module's own parameter, resolvable via the RTLIL module's
     // parameter_default_values); <=0 if not found or not parameter-driven.
@@ -694,9 +962,17 @@ struct UhdmImporter {
 
     // Package support
     void import_package(const UHDM::package* uhdm_package);
+    const RTLIL::Const* package_parameter(const std::string& full_name);
+    void evaluate_package_parameter(const UHDM::package* uhdm_package, const UHDM::parameter* param_obj,
+                                    const std::string& full_name);
     
     // Interface support
     void import_interface(const UHDM::interface_inst* uhdm_interface);
+    std::string interface_specialization_name(const UHDM::interface_inst* iface,
+                                              std::map<std::string, int>* param_values = nullptr);
+    std::string register_interface_specialization(const UHDM::interface_inst* iface);
+    void collect_interface_specializations(const UHDM::module_inst* mod);
+    std::string interface_specialization(const UHDM::interface_inst* iface);
     void import_interface_instances(const UHDM::module_inst* uhdm_module);
     bool module_has_interface_ports(const UHDM::module_inst* uhdm_module);
     std::string build_interface_module_name(const std::string& base_name,
@@ -709,10 +985,18 @@ struct UhdmImporter {
     // so each distinct type binding imports a separately-named module — like
     // Surelog's `$paramod` for value parameters.
     std::string type_param_signature(const UHDM::module_inst* uhdm_module);
-    void create_interface_module_with_width(const std::string& interface_name, int width);
     void expand_interfaces();
     void import_generate_scopes(const UHDM::module_inst* uhdm_module);
     void import_gen_scope(const UHDM::gen_scope* uhdm_scope);
+    // Fast path for the common generate-for of per-bit glue logic: imports
+    // the first two scopes of the array and clones the rest from them, when
+    // every scope holds only nets, variables and continuous assigns of one
+    // shape whose genvar-dependent select offsets are affine in the scope
+    // ordinal.  Scopes with instances, processes or nested generate arrays
+    // are not cloned.  Returns false, having imported nothing, when the
+    // array is not of that form; logs the number of scopes cloned when it
+    // fires.
+    bool import_gen_array_by_cloning(const UHDM::gen_scope_array* gen_array);
     
     // Primitive gate support
     void import_primitives(const UHDM::module_inst* uhdm_module);
@@ -720,6 +1004,8 @@ struct UhdmImporter {
     void import_gate(const UHDM::gate* uhdm_gate, const std::string& instance_name = "");
     void import_gate_array(const UHDM::gate_array* uhdm_gate_array);
     void import_gate_array_element(const UHDM::gate* gate_template, const std::string& instance_name, int bit_index);
+    bool import_gate_array_vectorized(const UHDM::gate* gate_template, const std::string& array_name,
+                                      const std::vector<int>& bit_indices);
     
     // Signal and wire management
     RTLIL::SigBit get_sig_bit(const UHDM::any* uhdm_obj);
@@ -732,6 +1018,7 @@ struct UhdmImporter {
     
     // Expression handling
     RTLIL::SigSpec import_expression(const UHDM::expr* uhdm_expr, const std::map<std::string, RTLIL::SigSpec>* input_mapping = nullptr);
+    RTLIL::SigSpec import_expression_uncached(const UHDM::expr* uhdm_expr, const std::map<std::string, RTLIL::SigSpec>* input_mapping);
     
     RTLIL::SigSpec import_constant(const UHDM::constant* uhdm_const);
     // LRM (IEEE 1800 Table 11-21) self-determined bit-length of an expression.
@@ -784,7 +1071,30 @@ struct UhdmImporter {
                                                       const std::map<std::string, int64_t>& var_substitutions);
     RTLIL::SigSpec import_indexed_part_select_with_substitution(const UHDM::indexed_part_select* ips,
                                                                 const std::map<std::string, int64_t>& var_substitutions);
-    
+
+    // Element-wise loop vectorization.  A LoopVectorizer around an unrolled
+    // comb for-loop records the cells each iteration emits.  When every
+    // iteration emitted the same number of cells, the bitwise cells at each
+    // position ($and/$or/$xor/$xnor/$not, and $mux on a shared select) are
+    // replaced by one wide cell over the concatenated per-iteration slices --
+    // unless a cell of the group reads another one's output (a carried
+    // dependence such as `y[i] = y[i-1] ^ a[i]`).  Relies on statement import
+    // never removing cells, so each iteration's cells are the newest entries
+    // of cells_.  Only the outermost unrolled loop merges; a nested loop's
+    // cells are part of its enclosing iterations.
+    struct LoopVectorizer {
+        LoopVectorizer(UhdmImporter* importer);
+        ~LoopVectorizer();
+        void begin_iteration();
+        void end_iteration();
+        void merge(const UHDM::any* loop);
+        UhdmImporter* imp;
+        bool active = false;
+        int cells0 = 0;
+        std::vector<std::vector<RTLIL::Cell*>> iterations;
+    };
+    int loop_vectorizer_depth = 0;
+
     void create_block_local_wires(const UHDM::any* stmt);
 
     // Process-specific import functions
@@ -858,6 +1168,10 @@ struct UhdmImporter {
     void import_if_stmt_comb(const UHDM::if_stmt* uhdm_if, RTLIL::Process* proc);
     void import_case_stmt_sync(const UHDM::case_stmt* uhdm_case, RTLIL::SyncRule* sync, bool is_reset);
     void import_case_stmt_comb(const UHDM::case_stmt* uhdm_case, RTLIL::Process* proc);
+    // Lower a fully constant case table to a ROM / $bmux and assign its
+    // outputs; false (nothing emitted) when the case is not such a table.
+    bool emit_case_rom(const UHDM::case_stmt* uhdm_case, const RTLIL::SigSpec& case_sig,
+                       RTLIL::Process* proc);
     bool apply_case_qualifier_attrs(const UHDM::case_stmt* uhdm_case, RTLIL::SwitchRule* sw);
     void emit_full_case_default(const UHDM::case_stmt* uhdm_case, RTLIL::SwitchRule* sw);
 
@@ -938,6 +1252,16 @@ struct UhdmImporter {
     void import_memory_objects(const UHDM::module_inst* uhdm_module);
     void add_src_attribute(dict<RTLIL::IdString, RTLIL::Const>& attributes, const UHDM::any* uhdm_obj);
     std::string get_src_attribute(const UHDM::any* uhdm_obj);
+    int src_file_id(std::string_view path);
+    // Interned source file basenames (keyed by a copy of the UHDM VpiFile
+    // text, so the table outlives a released design) and one `src` Const per
+    // distinct (file, line, col, end line, end col) range.
+    dict<std::string, int> src_file_ids;
+    std::vector<std::string> src_files;
+    // VpiFile() view address -> (length, id); valid for the current design
+    // only, cleared by import_design.
+    std::unordered_map<const char*, std::pair<size_t, int>> src_file_views;
+    dict<std::tuple<int, int, int, int, int>, RTLIL::Const> src_consts;
     RTLIL::IdString get_unique_cell_name(const std::string& base_name);
     UHDM::VectorOfany *begin_block_stmts(const any *stmt);
     void extract_assigned_signals(const any* stmt, std::vector<AssignedSignal>& signals);
@@ -1002,7 +1326,15 @@ struct UhdmImporter {
                               int& temp_counter,
                               const std::string& func_call_context,
                               const std::map<std::string, int>& local_var_widths = {});
-    
+    // Accumulator loops in function bodies (`sum += x[i]`, `p = p ^ d[i]`)
+    // reduce their per-iteration terms as a balanced tree.
+    RTLIL::SigSpec build_reduction_tree(int op_type, std::vector<RTLIL::SigSpec> terms, int width);
+    bool import_reduction_loop(const UHDM::any* loop_body, const std::string& loop_var,
+                               int64_t start_value, int64_t loop_end, int64_t increment,
+                               RTLIL::CaseRule* case_rule, RTLIL::Wire* result_wire,
+                               std::map<std::string, RTLIL::SigSpec>& input_mapping,
+                               const std::string& func_name);
+
     RTLIL::Process* generate_function_process(const UHDM::function* func_def, const std::string& func_name,
                                               const std::vector<RTLIL::SigSpec>& args, RTLIL::Wire* result_wire, const UHDM::func_call* fc);
     
@@ -1077,6 +1409,16 @@ struct UhdmImporter {
                                                const UHDM::VectorOfrange* ranges,
                                                const UHDM::any* inner_obj,
                                                const UHDM::any* src_obj);
+    // Build the per-row alias wires of a flat array wire.  Shared by
+    // materialize_flat_struct_array and the array_var whole/multi-dim path of
+    // import_module.
+    void emit_flat_array_rows(const std::string& name, RTLIL::Wire* flat_wire,
+                              int array_low, int array_size, int row_w,
+                              const UHDM::any* src_obj);
+    // Drop the row aliases nothing reads, once every module is imported.
+    void prune_unread_row_aliases();
+    // End-of-import_module sweep of unread `$` wires and dead internal cells.
+    void sweep_import_scratch();
     // Geometry of a (possibly multi-dim) unpacked/packed struct array
     // flattened to one wide wire: per-dimension (size, low) outer→inner, the
     // element struct typespec, and the element width.  Resolves via the
@@ -1088,6 +1430,46 @@ struct UhdmImporter {
                                 std::vector<std::pair<int,int>>& dims,
                                 const UHDM::struct_typespec** st_out,
                                 int* elem_w_out);
+    // Packed struct/union member layout, computed once per typespec and
+    // evaluation context by struct_layout() and shared by every field access.
+    // Members are in declaration order: `offset` is the LSB offset (always 0
+    // in a union), summed over the lower members' declared typespecs as
+    // written; `width`/`ts` the member's width and typespec with any
+    // `parameter type` default resolved to the instance-bound type (`has_ts`
+    // false when the member has no typespec).  Members are filled in lazily
+    // from the LSB up, only as far as a lookup reaches: `filled` of them are
+    // valid, and `next_offset` is where the next one starts.  `width` of the
+    // layout is the whole type's, -1 until first asked for.
+    struct StructLayoutMember {
+        int offset = 0;
+        int width = 0;
+        bool has_ts = false;
+        const UHDM::typespec* ts = nullptr;
+    };
+    struct StructLayout {
+        std::vector<StructLayoutMember> members;
+        int filled = 0;
+        int next_offset = 0;
+        int width = -1;
+    };
+    // Both caches hand out pointers that callers hold across width evaluation,
+    // which can recurse into struct_layout() and insert -- hence std::map,
+    // whose entries never move, rather than a hashlib dict.
+    // Member name -> declaration index; context-free, keyed by typespec.
+    std::map<const UHDM::typespec*, dict<std::string, int>> struct_member_names_;
+    // Key: typespec, evaluation scope, current_instance, module and
+    // parameter_version -- member ranges may read module parameters.
+    std::map<std::tuple<const UHDM::typespec*, const UHDM::scope*, const UHDM::module_inst*, RTLIL::Module*, int>,
+             StructLayout> struct_layouts_;
+    // Bumped on every write to a module's parameter_default_values, so
+    // layouts folded under an older value are not reused.
+    int parameter_version = 0;
+    const dict<std::string, int>* struct_member_names(const UHDM::typespec* ts);
+    // Fills the layout's members from the LSB down to `member_idx` (none
+    // for -1).
+    StructLayout* struct_layout(const UHDM::typespec* ts, const UHDM::scope* inst, int member_idx = -1);
+    int struct_member_index(const UHDM::typespec* ts, const std::string& field,
+                            const UHDM::typespec** member_ts);
     // *final_member_ts (optional) gets the FINAL path member's actual typespec
     // (null if the path ended in an explicit packed slice) so callers can read
     // its declared range (e.g. a `logic [24:20]` field's non-zero low bound).
@@ -1108,6 +1490,23 @@ struct UhdmImporter {
     RTLIL::SigSpec create_or_cell(const RTLIL::SigSpec& a, const RTLIL::SigSpec& b, const UHDM::any* src = nullptr);
     RTLIL::SigSpec create_not_cell(const RTLIL::SigSpec& a, const UHDM::any* src = nullptr);
     RTLIL::SigSpec create_mux_cell(const RTLIL::SigSpec& sel, const RTLIL::SigSpec& b, const RTLIL::SigSpec& a, int width = 0);
+    // Dynamic-index access helpers.  dynamic_index_decoder returns a one-hot
+    // vector whose bit k is (idx == k) for every k an index into `span`
+    // elements can name, built as one $demux and shared by every access in
+    // the process through the same index (keyed in dyn_index_decoders).
+    // dynamic_index_read selects element idx (elems[i] holds index low+i) with
+    // one $bmux; emit_element_merge rewrites the masked bits of element idx of
+    // a flat array value with one $bwmux.  All three return an empty SigSpec
+    // when the index is too wide to decode, leaving the caller's compare/shift
+    // lowering in place.
+    std::map<std::pair<RTLIL::SigSpec, int>, RTLIL::SigSpec> dyn_index_decoders;
+    RTLIL::SigSpec dynamic_index_decoder(const RTLIL::SigSpec& idx, int span);
+    RTLIL::SigSpec dynamic_index_read(const RTLIL::SigSpec& idx,
+                                      const std::vector<RTLIL::SigSpec>& elems, int low);
+    RTLIL::SigSpec emit_element_merge(const RTLIL::SigSpec& cur, const RTLIL::SigSpec& idx,
+                                      int low, int n_elems,
+                                      const RTLIL::SigSpec& elem_mask,
+                                      const RTLIL::SigSpec& elem_val);
     bool is_vpi_type(const UHDM::any* obj, int vpi_type);
     void process_assignment_lhs_rhs(const UHDM::assignment* assign, RTLIL::SigSpec& lhs, RTLIL::SigSpec& rhs);
     std::string generate_cell_name(const UHDM::any* uhdm_obj, const std::string& cell_type);
@@ -0,0 +1,101 @@
+// Fully constant combinational case tables (every arm assigns only constants)
+// are lowered to a table read instead of a $eq/$pmux tree: the 16-word nibble
+// substitution below becomes a $bmux over the packed table, the 64-word
+// decoder (at the default -case_rom_threshold) an async-read ROM.  Both must
+// stay equivalent to the Verilog frontend's switch lowering, including the
+// first-match-wins duplicate label and the default-filled holes.
+module dut (
+    input  logic [3:0] nib,
+    input  logic [5:0] op,
+    output logic [3:0] sub,
+    output logic [7:0] ctl,
+    output logic       ill
+);
+    always_comb begin
+        case (nib)
+            4'd0: sub = 4'h3;
+            4'd1: sub = 4'he;
+            4'd2: sub = 4'h7;
+            4'd3: sub = 4'h9;
+            4'd4: sub = 4'hd;
+            4'd5: sub = 4'hb;
+            4'd6: sub = 4'h4;
+            4'd7: sub = 4'h5;
+            4'd8: sub = 4'hc;
+            4'd9: sub = 4'h8;
+            4'd10: sub = 4'h1;
+            4'd11: sub = 4'h0;
+            4'd12: sub = 4'hf;
+            4'd13: sub = 4'h6;
+            4'd14: sub = 4'h2;
+            4'd15: sub = 4'ha;
+            4'd3: sub = 4'h0;  // duplicate label: the first arm wins
+        endcase
+    end
+
+    always_comb begin
+        case (op)
+            6'd0: begin ctl = 8'hde; ill = 1'b0; end
+            6'd1: begin ctl = 8'hd6; ill = 1'b0; end
+            6'd2: begin ctl = 8'h23; ill = 1'b0; end
+            6'd3: begin ctl = 8'h7b; ill = 1'b0; end
+            6'd4: begin ctl = 8'h2e; ill = 1'b0; end
+            6'd6: begin ctl = 8'hd9; ill = 1'b0; end
+            6'd7: begin ctl = 8'h1e; ill = 1'b0; end
+            6'd8: begin ctl = 8'h3f; ill = 1'b0; end
+            6'd9: begin ctl = 8'h72; ill = 1'b0; end
+            6'd10: begin ctl = 8'h1f; ill = 1'b0; end
+            6'd11: begin ctl = 8'hcb; ill = 1'b0; end
+            6'd12: begin ctl = 8'h19; ill = 1'b0; end
+            6'd13: begin ctl = 8'h71; ill = 1'b0; end
+            6'd14: begin ctl = 8'h17; ill = 1'b0; end
+            6'd15: begin ctl = 8'h44; ill = 1'b0; end
+            6'd16: begin ctl = 8'h94; ill = 1'b0; end
+            6'd18: begin ctl = 8'hd6; ill = 1'b0; end
+            6'd19: begin ctl = 8'h49; ill = 1'b0; end
+            6'd20: begin ctl = 8'h3c; ill = 1'b0; end
+            6'd21: begin ctl = 8'h9d; ill = 1'b0; end
+            6'd22: begin ctl = 8'h5c; ill = 1'b0; end
+            6'd23: begin ctl = 8'h34; ill = 1'b0; end
+            6'd24: begin ctl = 8'h60; ill = 1'b0; end
+            6'd25: begin ctl = 8'hbe; ill = 1'b0; end
+            6'd26: begin ctl = 8'h31; ill = 1'b0; end
+            6'd27: begin ctl = 8'h20; ill = 1'b0; end
+            6'd28: begin ctl = 8'h1e; ill = 1'b0; end
+            6'd29: begin ctl = 8'h69; ill = 1'b0; end
+            6'd30: begin ctl = 8'hfe; ill = 1'b0; end
+            6'd31: begin ctl = 8'hda; ill = 1'b0; end
+            6'd32: begin ctl = 8'ha0; ill = 1'b0; end
+            6'd33: begin ctl = 8'hee; ill = 1'b0; end
+            6'd34: begin ctl = 8'he8; ill = 1'b0; end
+            6'd35: begin ctl = 8'hb9; ill = 1'b0; end
+            6'd36: begin ctl = 8'h99; ill = 1'b0; end
+            6'd37: begin ctl = 8'h7f; ill = 1'b0; end
+            6'd38: begin ctl = 8'h5c; ill = 1'b0; end
+            6'd39: begin ctl = 8'h7c; ill = 1'b0; end
+            6'd40: begin ctl = 8'h29; ill = 1'b0; end
+            6'd41: begin ctl = 8'h99; ill = 1'b0; end
+            6'd43: begin ctl = 8'hfd; ill = 1'b0; end
+            6'd44: begin ctl = 8'haf; ill = 1'b0; end
+            6'd45: begin ctl = 8'he5; ill = 1'b0; end
+            6'd46: begin ctl = 8'h93; ill = 1'b0; end
+            6'd47: begin ctl = 8'h25; ill = 1'b0; end
+            6'd48: begin ctl = 8'h3c; ill = 1'b0; end
+            6'd49: begin ctl = 8'hd6; ill = 1'b0; end
+            6'd50: begin ctl = 8'h54; ill = 1'b0; end
+            6'd51: begin ctl = 8'haf; ill = 1'b0; end
+            6'd52: begin ctl = 8'h4d; ill = 1'b0; end
+            6'd53: begin ctl = 8'hfa; ill = 1'b0; end
+            6'd54: begin ctl = 8'hd7; ill = 1'b0; end
+            6'd55: begin ctl = 8'h14; ill = 1'b0; end
+            6'd56: begin ctl = 8'h27; ill = 1'b0; end
+            6'd57: begin ctl = 8'ha0; ill = 1'b0; end
+            6'd58: begin ctl = 8'hae; ill = 1'b0; end
+            6'd59: begin ctl = 8'hb3; ill = 1'b0; end
+            6'd60: begin ctl = 8'hfe; ill = 1'b0; end
+            6'd61: begin ctl = 8'he9; ill = 1'b0; end
+            6'd62: begin ctl = 8'h23; ill = 1'b0; end
+            default: begin ctl = 8'h00; ill = 1'b1; end
+        endcase
+    end
+endmodule
@@ -0,0 +1,45 @@
+// Dynamic-index reads and writes of arrays inside always_comb: the
+// element select is lowered to one $demux/$bmux per index instead of a
+// per-element compare-and-mux chain.
+module dyn_index_decoder (
+    input  logic [2:0] wr_idx,
+    input  logic [2:0] rd_idx,
+    input  logic [7:0] wr_data,
+    input  logic       wr_en,
+    input  logic [63:0] base,
+    output logic [7:0] rd_data,
+    output logic [63:0] packed_out,
+    output logic [3:0] tag_out
+);
+    typedef struct packed {
+        logic [3:0] tag;
+        logic [3:0] val;
+    } entry_t;
+
+    logic [7:0] regs [0:7];
+    logic [7:0][7:0] packed_regs;
+    entry_t table_q [0:7];
+
+    always_comb begin
+        for (int i = 0; i < 8; i++)
+            regs[i] = base[i*8 +: 8];
+        if (wr_en)
+            regs[wr_idx] = wr_data;
+        rd_data = regs[rd_idx];
+    end
+
+    always_comb begin
+        packed_regs = base;
+        if (wr_en)
+            packed_regs[wr_idx] = wr_data;
+        packed_out = packed_regs;
+    end
+
+    always_comb begin
+        for (int i = 0; i < 8; i++)
+            table_q[i] = base[i*8 +: 8];
+        if (wr_en)
+            table_q[wr_idx].tag = wr_data[3:0];
+        tag_out = table_q[rd_idx].tag;
+    end
+endmodule
@@ -0,0 +1,33 @@
+// A large multi-dimensional struct table of which only two rows are read by
+// constant index: only those rows get `tbl_q[k]` alias wires, the rest stay
+// slices of the flat canonical wire.
+module flat_struct_array_lazy (
+    input  logic        clk,
+    input  logic        we,
+    input  logic [63:0] wdata,
+    output logic [7:0]  cfg0,
+    output logic [7:0]  cfg5
+);
+    typedef struct packed {
+        logic       valid;
+        logic [2:0] mode;
+        logic [3:0] prio;
+    } cfg_t;
+
+    cfg_t tbl_q [0:31][0:1];
+    cfg_t tbl_d [0:31][0:1];
+
+    always_comb begin
+        tbl_d = tbl_q;
+        if (we) begin
+            tbl_d[0][0] = wdata[7:0];
+            tbl_d[5][1] = wdata[15:8];
+        end
+    end
+
+    always_ff @(posedge clk)
+        tbl_q <= tbl_d;
+
+    assign cfg0 = tbl_q[0][0];
+    assign cfg5 = tbl_q[5][1];
+endmodule
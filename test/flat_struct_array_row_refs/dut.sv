@@ -0,0 +1,47 @@
+// Rows of a flattened multi-dim struct table reached other than by a constant
+// index in their own module: a dynamic index, and a cross-module reference
+// from the parent.  Both must find the `tbl_q[k]` row aliases; the rows
+// nothing reads are removed once the whole design is imported.
+module row_table (
+    input  logic       clk,
+    input  logic       we,
+    input  logic [4:0] waddr,
+    input  logic [4:0] raddr,
+    input  logic [7:0] wdata,
+    output logic [7:0] rdata
+);
+    typedef struct packed {
+        logic       valid;
+        logic [2:0] mode;
+        logic [3:0] prio;
+    } cfg_t;
+
+    cfg_t tbl_q [0:31][0:1];
+    cfg_t tbl_d [0:31][0:1];
+
+    always_comb begin
+        tbl_d = tbl_q;
+        if (we) tbl_d[waddr][0] = wdata;
+    end
+
+    always_ff @(posedge clk)
+        tbl_q <= tbl_d;
+
+    assign rdata = tbl_q[raddr][0];
+endmodule
+
+module dut (
+    input  logic       clk,
+    input  logic       we,
+    input  logic [4:0] waddr,
+    input  logic [4:0] raddr,
+    input  logic [7:0] wdata,
+    output logic [7:0] rdata,
+    output logic [7:0] row7
+);
+    row_table u_tbl (
+        .clk(clk), .we(we), .waddr(waddr), .raddr(raddr),
+        .wdata(wdata), .rdata(rdata)
+    );
+    assign row7 = u_tbl.tbl_q[7][1];
+endmodule
@@ -0,0 +1,49 @@
+// Accumulator loops inside functions reduce as balanced trees: the
+// per-iteration terms are combined pairwise (or by one $reduce_* cell for a
+// 1-bit accumulator) instead of a chain as deep as the loop.
+module function_reduction_loop (
+    input  logic [15:0] d,
+    input  logic [7:0]  w0,
+    input  logic [7:0]  w1,
+    output logic [4:0]  ones,
+    output logic        parity,
+    output logic        any_set,
+    output logic [7:0]  sum
+);
+    function automatic logic [4:0] popcount(input logic [15:0] v);
+        logic [4:0] n;
+        n = '0;
+        for (int i = 0; i < 16; i++)
+            n += v[i];
+        return n;
+    endfunction
+
+    function automatic logic xor_all(input logic [15:0] v);
+        logic p;
+        p = 1'b0;
+        for (int i = 0; i < 16; i++)
+            p = p ^ v[i];
+        return p;
+    endfunction
+
+    function automatic logic or_all(input logic [15:0] v);
+        logic r;
+        r = 1'b0;
+        for (int i = 0; i < 16; i++)
+            r |= v[i];
+        return r;
+    endfunction
+
+    function automatic logic [7:0] add_bytes(input logic [7:0] a, input logic [7:0] b);
+        logic [7:0] s;
+        s = a;
+        for (int i = 0; i < 4; i++)
+            s += b;
+        return s;
+    endfunction
+
+    assign ones    = popcount(d);
+    assign parity  = xor_all(d);
+    assign any_set = or_all(d);
+    assign sum     = add_bytes(w0, w1);
+endmodule
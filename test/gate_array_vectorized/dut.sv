@@ -0,0 +1,20 @@
+// Gate instance arrays with array-aligned terminals import as word-level
+// cells: bit i of each vector terminal belongs to element i, and a scalar
+// terminal is broadcast to every element.
+module gate_array_vectorized (
+    input  wire [15:0] a,
+    input  wire [15:0] b,
+    input  wire [15:0] c,
+    input  wire        en,
+    output wire [15:0] y_nand,
+    output wire [15:0] y_or3,
+    output wire [15:0] y_xnor,
+    output wire [15:0] y_gate,
+    output wire [15:0] y_not
+);
+    nand g_nand [15:0] (y_nand, a, b);
+    or   g_or3  [15:0] (y_or3, a, b, c);
+    xnor g_xnor [15:0] (y_xnor, a, c);
+    and  g_gate [15:0] (y_gate, a, en);
+    not  g_not  [15:0] (y_not, b);
+endmodule
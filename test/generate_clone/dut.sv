@@ -0,0 +1,30 @@
+// The scopes of a generate-for differ only in their genvar-indexed select
+// offsets: lane[0] and lane[1] are imported, the other lanes are cloned from
+// them with their own hierarchical wire names (the import logs "Cloned 6 of
+// 8 scopes of generate block lane").  In sq the scope-local K shadows the
+// module parameter K and is not affine in g, so its scopes must not be
+// cloned: v[g] reads d[(g*g) % 8], never d[g].
+module generate_clone #(parameter int N = 8, parameter int K = 2) (
+    input  logic [N-1:0]   a,
+    input  logic [N-1:0]   b,
+    input  logic [N-1:0]   c,
+    input  logic [2*N-1:0] d,
+    input  logic           sel,
+    output logic [N-1:0]   y,
+    output logic [N-1:0]   z,
+    output logic [N-1:0]   w,
+    output logic [N-1:0]   v
+);
+    for (genvar g = 0; g < N; g++) begin : lane
+        logic t;
+        assign t    = a[g] ^ b[g];
+        assign y[g] = t & ~c[g];
+        assign z[g] = sel ? t : c[g];
+        assign w[g] = ^d[2*g +: 2];
+    end
+
+    for (genvar g = 0; g < N; g++) begin : sq
+        localparam int K = (g * g) % 8;
+        assign v[g] = d[K];
+    end
+endmodule
@@ -0,0 +1,51 @@
+// Element-wise for loops import as word-level cells: every iteration emits
+// the same bitwise operators on its own slice, so each operator becomes one
+// wide cell.  The prefix chain and the ripple-carry adder carry a dependence
+// between iterations: every operator on the carry path stays bit-sliced (the
+// adder's $and/$or groups would otherwise read each other's wide outputs), and
+// only the carry-free a^b / a&b terms are merged.
+module loop_vectorize (
+    input  logic [15:0] a,
+    input  logic [15:0] b,
+    input  logic [15:0] c,
+    input  logic        sel,
+    input  logic        cin,
+    output logic [15:0] y_logic,
+    output logic [15:0] y_mux,
+    output logic [15:0] y_down,
+    output logic [15:0] y_prefix,
+    output logic [15:0] y_sum,
+    output logic        y_cout
+);
+    logic [16:0] carry;
+
+    always_comb begin
+        for (int i = 0; i < 16; i++)
+            y_logic[i] = a[i] & b[i] ^ ~c[i];
+    end
+
+    always_comb begin
+        for (int i = 0; i < 16; i++)
+            y_mux[i] = sel ? a[i] : b[i] | c[i];
+    end
+
+    always_comb begin
+        for (int i = 15; i >= 0; i--)
+            y_down[i] = a[i] ^ b[15-i];
+    end
+
+    always_comb begin
+        y_prefix[0] = a[0];
+        for (int i = 1; i < 16; i++)
+            y_prefix[i] = y_prefix[i-1] ^ a[i];
+    end
+
+    always_comb begin
+        carry[0] = cin;
+        for (int i = 0; i < 16; i++) begin
+            y_sum[i] = a[i] ^ b[i] ^ carry[i];
+            carry[i+1] = a[i] & b[i] | carry[i] & (a[i] ^ b[i]);
+        end
+        y_cout = carry[16];
+    end
+endmodule
@@ -0,0 +1,36 @@
+// Two instances of one module override the parameter that sizes its packed
+// struct differently, so every field offset above `tag` depends on W.  The
+// cached member layout of the first instance must not be reused for the
+// second: u_wide's hi is in[18:11], not u_narrow's in[10:7].
+module entry_split #(parameter int W = 4) (
+    input  logic [2*W+2:0] in,
+    output logic [W-1:0]   hi,
+    output logic [W-1:0]   lo,
+    output logic [2:0]     tag
+);
+    typedef struct packed {
+        logic [W-1:0] hi;
+        logic [W-1:0] lo;
+        logic [2:0]   tag;
+    } entry_t;
+
+    entry_t e;
+    assign e   = in;
+    assign hi  = e.hi;
+    assign lo  = e.lo;
+    assign tag = e.tag;
+endmodule
+
+module dut (
+    input  logic [10:0] in_narrow,
+    input  logic [18:0] in_wide,
+    output logic [3:0]  hi_narrow,
+    output logic [3:0]  lo_narrow,
+    output logic [2:0]  tag_narrow,
+    output logic [7:0]  hi_wide,
+    output logic [7:0]  lo_wide,
+    output logic [2:0]  tag_wide
+);
+    entry_split #(.W(4)) u_narrow (.in(in_narrow), .hi(hi_narrow), .lo(lo_narrow), .tag(tag_narrow));
+    entry_split #(.W(8)) u_wide   (.in(in_wide),   .hi(hi_wide),   .lo(lo_wide),   .tag(tag_wide));
+endmodule